@@ -7,8 +7,23 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
+/**
+ * Command line options, set before the first game_run
+ */
+typedef struct GameOptions {
+    bool benchmark_flythrough;  // Scripted camera path, no input; writes a report and exits
+    int view_distance;          // Chunks (0 = default)
+    int lod_distance;           // Chunks (0 = default)
+    const char* report_path;    // Flythrough report (NULL = FLYTHROUGH_REPORT_PATH)
+    int heap_budget_mb;         // Tracked heap budget (0 = MEMORY_HEAP_BUDGET_MB)
+    int gpu_budget_mb;          // Tracked GPU budget (0 = MEMORY_GPU_BUDGET_MB)
+} GameOptions;
+
+void game_set_options(const GameOptions* options);
+
 /**
  * Game Entry Point - Love2D-style lifecycle
  *
@@ -24,6 +39,11 @@
  */
 void game_run(void);
 
+/**
+ * Whether the game asked to quit (pause menu, finished flythrough)
+ */
+bool game_should_exit(void);
+
 /**
  * Clean up all game resources
  * Call this BEFORE CloseWindow() to free GPU resources
@@ -27,4 +27,17 @@
 // Crack overlay stages
 #define CRACK_STAGE_COUNT 10           // Number of crack overlay stages (0-9)
 
+// Simulation
+#define GAME_TICK_DT (1.0f / WORLD_TICK_RATE)  // Fixed simulation step (seconds)
+#define GAME_MAX_TICKS_PER_FRAME 5     // Ticks behind before the backlog is dropped
+
+// Startup
+#define SPAWN_READY_RADIUS 1           // Chunks around the spawn finished before play starts
+
+// Persistence
+#define SAVE_DIRECTORY "saves/world"   // Region files and level.dat
+#define MESH_CACHE_ENABLED 1           // Keep chunk meshes next to the saved blocks for fast reloads
+#define TERRAIN_CACHE_ENABLED 0        // Reuse generated terrain across runs (development)
+#define TERRAIN_CACHE_DIRECTORY "cache/terrain"  // One subdirectory per seed and parameter set
+
 #endif // GAME_CONSTANTS_H
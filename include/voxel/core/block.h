@@ -94,8 +94,29 @@ typedef struct {
     float hardness;           // Base dig time in seconds (0 = instant, -1 = unbreakable)
     ToolType preferred_tool;  // Which tool speeds this up
     bool requires_tool;       // Must use correct tool to drop item
+    // Lighting
+    uint8_t light_emission;   // Block light given off (0 = none, up to 15)
 } BlockProperties;
 
+// ============================================================================
+// BLOCK FLAGS
+// ============================================================================
+
+#define BLOCK_FLAG_SOLID         0x01   // Blocks movement, meshed
+#define BLOCK_FLAG_TRANSPARENT   0x02   // Light passes through
+#define BLOCK_FLAG_FLUID         0x04   // Water-like behavior
+#define BLOCK_FLAG_OPAQUE        0x08   // Solid and not transparent: hides neighbor faces
+#define BLOCK_FLAG_PASSES_LIGHT  0x10   // Air or transparent
+
+/**
+ * Per-type flags and light emission, filled from the properties table by
+ * block_system_init (call it before any chunk work starts)
+ * 256 entries, so any stored type byte indexes them without a bounds check;
+ * unknown types behave like air
+ */
+extern uint8_t g_block_flags[256];
+extern uint8_t g_block_light_emission[256];
+
 // ============================================================================
 // API
 // ============================================================================
@@ -113,17 +134,44 @@ const BlockProperties* block_get_properties(BlockType type);
 /**
  * Check if block is solid (blocks movement)
  */
-bool block_is_solid(Block block);
+static inline bool block_is_solid(Block block) {
+    return (g_block_flags[block.type] & BLOCK_FLAG_SOLID) != 0;
+}
 
 /**
  * Check if block is transparent (light passes through)
  */
-bool block_is_transparent(Block block);
+static inline bool block_is_transparent(Block block) {
+    return (g_block_flags[block.type] & BLOCK_FLAG_TRANSPARENT) != 0;
+}
 
 /**
  * Check if block is fluid (water-like)
  */
-bool block_is_fluid(Block block);
+static inline bool block_is_fluid(Block block) {
+    return (g_block_flags[block.type] & BLOCK_FLAG_FLUID) != 0;
+}
+
+/**
+ * Check if block hides the faces of its neighbors (solid, not transparent)
+ */
+static inline bool block_is_opaque(Block block) {
+    return (g_block_flags[block.type] & BLOCK_FLAG_OPAQUE) != 0;
+}
+
+/**
+ * Check if light spreads into a block type (air or transparent)
+ */
+static inline bool block_type_passes_light(uint8_t type) {
+    return (g_block_flags[type] & BLOCK_FLAG_PASSES_LIGHT) != 0;
+}
+
+/**
+ * Light level a block type emits (0 for non-emitters)
+ */
+static inline uint8_t block_get_light_emission(BlockType type) {
+    return g_block_light_emission[(uint8_t)type];
+}
 
 /**
  * Get block name for debugging
@@ -0,0 +1,115 @@
+/**
+ * Memory - Per-subsystem accounting of heap and GPU memory
+ *
+ * Allocation sites report what they allocate and free with memory_track,
+ * from any thread. The counters cover the large, long-lived structures
+ * (chunk storage, staged meshes, vertex buffers, LOD, entities, ...), not
+ * every small allocation, so the totals are a floor of what the process
+ * uses; the resident set is sampled separately for comparison.
+ *
+ * Budgets are set for the heap and the GPU totals. Above a budget the world
+ * evicts chunks past its view and the quality governor pulls in the view
+ * and LOD distances until the totals fit again.
+ */
+
+#ifndef VOXEL_MEMORY_H
+#define VOXEL_MEMORY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define MEMORY_HEAP_BUDGET_MB 0             // Default heap budget (0 = none)
+#define MEMORY_GPU_BUDGET_MB 0              // Default GPU budget (0 = none)
+#define MEMORY_HIGH_WATER 0.9f              // Budget fraction that stops quality from growing
+#define MEMORY_LOW_WATER 0.75f              // Budget fraction under which lost quality may return
+
+// ============================================================================
+// CATEGORIES
+// ============================================================================
+
+typedef enum {
+    // Heap
+    MEMORY_CHUNK_STORAGE,               // Chunk structs, block, light and metadata sections, LOD cells
+    MEMORY_CPU_MESH,                    // Vertices waiting for upload, arena caches and scratch
+    MEMORY_WORKER,                      // Task queues, finished chunk nodes, captured borders
+    MEMORY_BATCHER,                     // Batch nodes and sort buffers
+    MEMORY_LOD,                         // LOD builder volumes, vertices and draw lists
+    MEMORY_CHESTS,
+    MEMORY_WATER,                       // Update nodes and edit lists
+    MEMORY_ENTITIES,                    // Entities, type pools and the spatial grid
+    // GPU
+    MEMORY_GPU_CHUNK,                   // Chunk meshes, the pool arena and the shared quad indices
+    MEMORY_GPU_BATCH,
+    MEMORY_GPU_LOD,
+    MEMORY_CATEGORY_COUNT
+} MemoryCategory;
+
+#define MEMORY_FIRST_GPU MEMORY_GPU_CHUNK
+
+typedef enum {
+    MEMORY_HEAP,
+    MEMORY_GPU,
+    MEMORY_KIND_COUNT
+} MemoryKind;
+
+/**
+ * How close a kind's total is to its budget
+ */
+typedef enum {
+    MEMORY_PRESSURE_NONE,               // No budget, or under MEMORY_LOW_WATER
+    MEMORY_PRESSURE_MODERATE,
+    MEMORY_PRESSURE_HIGH,               // At or over MEMORY_HIGH_WATER
+    MEMORY_PRESSURE_OVER,               // At or over the budget
+} MemoryPressure;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * Count bytes allocated (positive) or freed (negative) in a category
+ */
+void memory_track(MemoryCategory category, ptrdiff_t bytes);
+
+size_t memory_get_bytes(MemoryCategory category);
+
+/**
+ * Highest value the category reached
+ */
+size_t memory_get_peak(MemoryCategory category);
+
+const char* memory_category_name(MemoryCategory category);
+
+static inline MemoryKind memory_category_kind(MemoryCategory category) {
+    return category >= MEMORY_FIRST_GPU ? MEMORY_GPU : MEMORY_HEAP;
+}
+
+/**
+ * Sum of a kind's categories
+ */
+size_t memory_get_total(MemoryKind kind);
+
+/**
+ * Set a kind's budget in bytes (0 = none)
+ */
+void memory_set_budget(MemoryKind kind, size_t bytes);
+
+size_t memory_get_budget(MemoryKind kind);
+
+MemoryPressure memory_get_pressure(MemoryKind kind);
+
+/**
+ * Highest pressure of both kinds
+ */
+MemoryPressure memory_get_max_pressure(void);
+
+/**
+ * Resident set size of the process in KB (0 = unknown)
+ */
+long memory_get_resident_kb(void);
+
+#endif // VOXEL_MEMORY_H
@@ -0,0 +1,154 @@
+/**
+ * Profiler - Scoped timers for the frame and the worker threads
+ *
+ * Code brackets a subsystem with PROFILE_BEGIN / PROFILE_END. While the
+ * profiler is off, a scope costs one relaxed atomic load; with
+ * PROFILER_COMPILED 0 it costs nothing at all.
+ *
+ * While on, every scope adds its time to its zone's total for the frame
+ * (any thread). profiler_frame_end, called once per frame by the main
+ * thread, moves those totals into a history that the overlay draws. A
+ * capture additionally records every scope as an event and writes them out
+ * as Chrome trace JSON (chrome://tracing, Perfetto) when it ends.
+ */
+
+#ifndef VOXEL_PROFILER_H
+#define VOXEL_PROFILER_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#ifndef PROFILER_COMPILED
+#define PROFILER_COMPILED 1             // 0 compiles every scope out
+#endif
+#define PROFILER_HISTORY 240            // Frames kept for the overlay
+#define PROFILER_TRACE_EVENTS (1 << 17) // Events one capture can hold
+#define PROFILER_CAPTURE_FRAMES 300     // Frames one capture covers
+#define PROFILER_MAX_THREADS 32         // Named threads in a trace
+#define PROFILER_TRACE_PATH "profile_trace.json"
+
+// ============================================================================
+// ZONES
+// ============================================================================
+
+/**
+ * Timed subsystems
+ * Main thread zones nest in the order listed (see profiler_zone_depth)
+ */
+typedef enum {
+    PROFILE_GAME_UPDATE,
+    PROFILE_NETWORK_POLL,
+    PROFILE_WORLD_UPDATE,
+    PROFILE_WORLD_UPLOADS,
+    PROFILE_WORLD_EVICT,
+    PROFILE_WORLD_COLD,
+    PROFILE_WORLD_STREAMING,
+    PROFILE_WORLD_REMESH,
+    PROFILE_BATCH_REBUILD,
+    PROFILE_LOD_UPDATE,
+    PROFILE_GAME_TICK,
+    PROFILE_ENTITY_UPDATE,
+    PROFILE_GAME_DRAW,
+    PROFILE_RENDER_OPAQUE,
+    PROFILE_RENDER_ENTITIES,
+    PROFILE_RENDER_TRANSPARENT,
+    PROFILE_RENDER_UI,
+    // Other threads
+    PROFILE_WATER_TICK,
+    PROFILE_WORKER_TERRAIN,             // Worker zones follow ChunkStage
+    PROFILE_WORKER_DECORATE,
+    PROFILE_WORKER_LIGHT,
+    PROFILE_WORKER_MESH,
+    PROFILE_WORKER_REMESH,
+    PROFILE_ZONE_COUNT
+} ProfileZone;
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+/**
+ * Totals of one finished frame
+ */
+typedef struct ProfileFrame {
+    float frame_ms;                     // Wall time since the previous frame
+    float zone_ms[PROFILE_ZONE_COUNT];  // Summed over all threads
+    uint16_t zone_calls[PROFILE_ZONE_COUNT];
+} ProfileFrame;
+
+// ============================================================================
+// API
+// ============================================================================
+
+extern atomic_bool g_profiler_active;
+
+uint64_t profiler_now_ns(void);
+
+/**
+ * Start a scope: its start time, or 0 while the profiler is off
+ */
+static inline uint64_t profiler_begin(void) {
+    return atomic_load_explicit(&g_profiler_active, memory_order_relaxed) ? profiler_now_ns() : 0;
+}
+
+/**
+ * Finish a scope started by profiler_begin (no-op for 0)
+ */
+void profiler_end(ProfileZone zone, uint64_t start_ns);
+
+#if PROFILER_COMPILED
+#define PROFILE_BEGIN(zone) uint64_t profile_start_##zone = profiler_begin()
+#define PROFILE_END(zone) profiler_end(zone, profile_start_##zone)
+#else
+#define PROFILE_BEGIN(zone) ((void)0)
+#define PROFILE_END(zone) ((void)0)
+#endif
+
+/**
+ * Turn frame totals on or off (a running capture keeps them on)
+ */
+void profiler_set_enabled(bool enabled);
+
+bool profiler_is_enabled(void);
+
+/**
+ * Name the calling thread in traces (once per thread)
+ */
+void profiler_set_thread_name(const char* name);
+
+/**
+ * Record every scope for the next PROFILER_CAPTURE_FRAMES frames, then
+ * write them to PROFILER_TRACE_PATH
+ */
+void profiler_start_capture(void);
+
+bool profiler_is_capturing(void);
+
+/**
+ * Close the frame (main thread, once per frame)
+ */
+void profiler_frame_end(void);
+
+/**
+ * Frame age frames ago (0 = last finished), or NULL past the history
+ */
+const ProfileFrame* profiler_get_frame(int age);
+
+const char* profiler_zone_name(ProfileZone zone);
+
+/**
+ * Nesting depth of a zone (0 = top level; other threads' zones are 0)
+ */
+int profiler_zone_depth(ProfileZone zone);
+
+/**
+ * Free the capture buffer (after all threads stopped)
+ */
+void profiler_shutdown(void);
+
+#endif // VOXEL_PROFILER_H
@@ -9,6 +9,7 @@
 #define VOXEL_TEXTURE_ATLAS_H
 
 #include <raylib.h>
+#include <stdint.h>
 #include "block.h"
 
 // ============================================================================
@@ -18,6 +19,12 @@
 #define ATLAS_SIZE 512          // Atlas texture size (512x512)
 #define TILE_SIZE 16            // Each tile is 16x16 pixels
 #define TILES_PER_ROW 32        // 32 tiles per row (512/16)
+#define ATLAS_TILE_LAYERS (TILES_PER_ROW * TILES_PER_ROW)  // Tile array layers (layer = row * 32 + column)
+#define ATLAS_TILE_MIP_LEVELS 5 // 16, 8, 4, 2, 1 pixel mips per layer
+
+#define ATLAS_GENERATOR_VERSION 2          // Bump whenever generate_atlas_image changes (invalidates the cache)
+#define ATLAS_CACHE_DIRECTORY "cache"
+#define ATLAS_CACHE_PATH "cache/atlas.bin" // Generated atlas pixels, reused while the version matches
 
 // ============================================================================
 // TEXTURE COORDINATES
@@ -30,6 +37,14 @@ typedef struct {
     float v_max;  // Bottom V coordinate (0.0 to 1.0)
 } TextureCoords;
 
+/**
+ * Tile position in the atlas grid (column, row)
+ */
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+} AtlasTile;
+
 // Face indices for texture coordinates
 typedef enum {
     FACE_TOP = 0,
@@ -46,7 +61,9 @@ typedef enum {
 
 /**
  * Initialize texture atlas system
- * Creates a procedurally generated texture atlas
+ * Loads the procedural atlas from ATLAS_CACHE_PATH, or generates and caches
+ * it, then uploads it both as a 2D atlas (items, particles, overlays) and
+ * as a mipmapped tile array for the block shader
  */
 void texture_atlas_init(void);
 
@@ -55,6 +72,11 @@ void texture_atlas_init(void);
  */
 void texture_atlas_destroy(void);
 
+/**
+ * Get atlas tile for a block face
+ */
+AtlasTile texture_atlas_get_tile(BlockType block_type, BlockFace face);
+
 /**
  * Get texture coordinates for a block face
  */
@@ -65,11 +87,22 @@ TextureCoords texture_atlas_get_coords(BlockType block_type, BlockFace face);
  */
 Texture2D texture_atlas_get_texture(void);
 
+/**
+ * GL_TEXTURE_2D_ARRAY with one mipmapped layer per atlas tile
+ * (0 = unsupported, block.fs samples the 2D atlas instead)
+ */
+unsigned int texture_atlas_get_tile_array(void);
+
 /**
  * Get material with texture atlas
  */
 Material texture_atlas_get_material(void);
 
+/**
+ * Get material for the water meshes (water.vs/water.fs, same textures)
+ */
+Material texture_atlas_get_water_material(void);
+
 /**
  * Get texture coordinates for a crack overlay stage (0-9)
  */
@@ -2,38 +2,80 @@
  * Entity Collision System
  *
  * Provides AABB-based collision detection for entities against the voxel world.
- * Uses multi-point sampling (12 points) for accurate collision detection.
+ * A CollisionContext caches the solid bits of the blocks around one entity
+ * once per tick; every query of that tick (stuck check, per-axis sweeps,
+ * ground and jump checks) reads the bits instead of the chunk map.
  */
 
 #ifndef ENTITY_COLLISION_H
 #define ENTITY_COLLISION_H
 
 #include "voxel/entity/entity.h"
+#include "voxel/world/world.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <raylib.h>
 
-// Forward declaration
-struct World;
+// ============================================================================
+// COLLISION CONTEXT
+// ============================================================================
+
+#define COLLISION_CONTEXT_SIZE 8     // Cached blocks per side (one uint64_t per row of 8 x 8)
+#define COLLISION_CONTEXT_MARGIN 2   // Blocks cached around the box (moves, push-out, jump checks)
+
+/**
+ * Solid bits of the blocks around one entity
+ * Queries outside the cached box fall back to the world (fast movers)
+ */
+typedef struct CollisionContext {
+    struct World* world;
+    WorldCursor cursor;                          // Fallback for blocks outside the box
+    int origin_x, origin_y, origin_z;            // World block of bit (0, 0, 0)
+    int size_x, size_y, size_z;                  // Cached extent (at most COLLISION_CONTEXT_SIZE)
+    uint64_t rows[COLLISION_CONTEXT_SIZE];       // Per y: bit z * 8 + x set = solid
+} CollisionContext;
+
+/**
+ * Cache the blocks overlapping a world-space box grown by COLLISION_CONTEXT_MARGIN
+ * Fetch once per tick, before the entity moves
+ */
+void collision_context_fetch(CollisionContext* ctx, struct World* world, Vector3 box_min, Vector3 box_max);
+
+/**
+ * collision_context_fetch around an entity's bounding box
+ */
+void collision_context_fetch_entity(CollisionContext* ctx, struct World* world, const Entity* entity);
+
+/**
+ * Whether the block at world coordinates is solid (cached bit, else the world)
+ */
+bool collision_context_is_solid(CollisionContext* ctx, int x, int y, int z);
+
+/**
+ * Whether the point is inside a solid block
+ */
+bool collision_context_is_solid_at(CollisionContext* ctx, float x, float y, float z);
 
 // ============================================================================
 // COLLISION DETECTION
 // ============================================================================
 
 /**
- * Check if an AABB at the given position collides with any solid blocks
+ * Check if an AABB at the given position overlaps any solid block
  *
- * Uses 12-point sampling: 4 corners at 3 height levels (bottom, middle, top)
+ * Every block the box overlaps is tested; the box is shrunk by a small
+ * epsilon so touching faces do not count
  *
- * @param world The world to check collision against
+ * @param ctx Blocks around the entity
  * @param pos Position of the entity (at feet)
  * @param bbox_min Bounding box minimum (relative to pos)
  * @param bbox_max Bounding box maximum (relative to pos)
  * @return true if collision detected, false otherwise
  */
-bool entity_check_collision(struct World* world, Vector3 pos, Vector3 bbox_min, Vector3 bbox_max);
+bool entity_check_collision(CollisionContext* ctx, Vector3 pos, Vector3 bbox_min, Vector3 bbox_max);
 
 /**
- * Check if a point is inside a solid block
+ * Check if a point is inside a solid block (one-off query, no context)
  *
  * @param world The world to check
  * @param x World X coordinate
@@ -48,17 +90,18 @@ bool entity_is_solid_at(struct World* world, float x, float y, float z);
 // ============================================================================
 
 /**
- * Move an entity with per-axis collision detection
+ * Move an entity with per-axis swept collision
  *
- * Tests X, Z, then Y axes independently to allow wall sliding.
- * Updates entity->position and zeroes velocity on collision axes.
+ * Sweeps X, Z, then Y independently to allow wall sliding; a blocked axis
+ * moves up to the face it hits. Updates entity->position and zeroes
+ * velocity on collision axes.
  *
  * @param entity The entity to move
- * @param world The world for collision detection
+ * @param ctx Blocks around the entity (fetched this tick)
  * @param dt Delta time
  * @return Collision flags: bit 0 = X collision, bit 1 = Z collision, bit 2 = Y collision
  */
-int entity_move_with_collision(Entity* entity, struct World* world, float dt);
+int entity_move_with_collision(Entity* entity, CollisionContext* ctx, float dt);
 
 /**
  * Check if any horizontal (X or Z) collision occurred
@@ -82,10 +125,10 @@ int entity_move_with_collision(Entity* entity, struct World* world, float dt);
  * Checks all 4 bottom corners slightly below the entity
  *
  * @param entity The entity to check
- * @param world The world to check against
+ * @param ctx Blocks around the entity
  * @return true if entity is on solid ground
  */
-bool entity_is_on_ground(Entity* entity, struct World* world);
+bool entity_is_on_ground(Entity* entity, CollisionContext* ctx);
 
 // ============================================================================
 // GRAVITY
@@ -114,10 +157,10 @@ void entity_apply_gravity(Entity* entity, struct World* world, float dt, float g
  * - There's a landing surface on top of the obstacle
  *
  * @param entity The entity to check
- * @param world The world to check against
+ * @param ctx Blocks around the entity
  * @param direction Movement direction (should be normalized XZ)
  * @return true if entity can jump the obstacle
  */
-bool entity_can_jump_obstacle(Entity* entity, struct World* world, Vector3 direction);
+bool entity_can_jump_obstacle(Entity* entity, CollisionContext* ctx, Vector3 direction);
 
 #endif // ENTITY_COLLISION_H
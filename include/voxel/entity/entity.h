@@ -3,6 +3,17 @@
  *
  * Provides a generic entity system for managing game entities (NPCs, mobs, etc.)
  * Uses polymorphic behavior via function pointers for extensibility.
+ *
+ * Entities are stored in one pool per type. Each pool keeps the entity
+ * handles and packed copies of their positions, velocities and world-space
+ * boxes, and a spatial hash over XZ cells is rebuilt from those every tick so
+ * area queries only look at nearby entities.
+ *
+ * A tick has two phases: the update callbacks run in parallel on helper
+ * threads while the world is left untouched, then the main thread commits
+ * the results (pool arrays and spatial hash). Shared navigation jobs (see
+ * nav.h) run on the main thread before the update phase. Entities far from the player
+ * are updated every few ticks with the accumulated time.
  */
 
 #ifndef ENTITY_H
@@ -12,10 +23,12 @@
 #include <raymath.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <pthread.h>
 
 // Forward declarations
 // Note: World typedef is defined in world.h - we just declare the struct here
 struct World;
+struct NavSystem;
 typedef struct Entity Entity;
 
 // ============================================================================
@@ -30,6 +43,7 @@ typedef enum {
     // Future entity types:
     // ENTITY_TYPE_ZOMBIE,
     // ENTITY_TYPE_ITEM_DROP,
+    ENTITY_TYPE_COUNT
 } EntityType;
 
 // ============================================================================
@@ -44,6 +58,8 @@ typedef uint32_t EntityId;
 
 /**
  * Update callback - called every frame for active entities
+ * Runs on helper threads in parallel with other entities: it may change
+ * only its own entity and must treat the world as read-only.
  * @param entity The entity to update
  * @param world World reference (for collision, etc.)
  * @param dt Delta time in seconds
@@ -75,6 +91,8 @@ struct Entity {
     Vector3 position;                   // World position (at feet/base)
     Vector3 rotation;                   // Euler angles (pitch, yaw, roll)
     Vector3 velocity;                   // Physics velocity
+    Vector3 previous_position;          // Position before the last tick (render interpolation)
+    float previous_yaw;                 // rotation.y before the last tick
 
     // Bounding box (for collision)
     Vector3 bbox_min;                   // Relative to position
@@ -88,8 +106,12 @@ struct Entity {
     // Type-specific data
     void* data;                         // Points to BlockHumanData, etc.
 
-    // Linked list management
-    struct Entity* next;                // Next entity in list
+    // Manager bookkeeping
+    int pool_index;                     // Slot in its type's pool (-1 = not in a manager)
+    float pending_dt;                   // Time not yet simulated (far entities tick less often)
+
+    // Replication
+    EntityId remote_id;                 // Host's id of a copied entity (0 = simulated here)
 
     // State
     bool active;                        // Is entity alive/active?
@@ -99,10 +121,71 @@ struct Entity {
 // ENTITY MANAGER
 // ============================================================================
 
+#define ENTITY_GRID_CELL_SIZE 8         // Spatial hash cell size in blocks (XZ)
+#define ENTITY_GRID_BUCKETS 1024        // Spatial hash buckets (power of two)
+#define ENTITY_UPDATE_THREADS_MAX 4     // Helper threads for the update phase
+#define ENTITY_UPDATE_BATCH 16          // Entities claimed per helper batch
+#define ENTITY_PARALLEL_MIN 64          // Fewer updates than this run on the main thread
+#define ENTITY_FAR_DISTANCE 48.0f       // Beyond this from the player, tick at a reduced rate
+#define ENTITY_FAR_TICK_INTERVAL 4      // Far entities update every this many ticks
+#define ENTITY_MAX_TICK_DT 0.1f         // Cap on the time one update simulates
+
+/**
+ * All entities of one type
+ * The packed arrays share indices with entities and are refreshed from the
+ * entities once per tick, so queries read stride-free data.
+ */
+typedef struct EntityPool {
+    Entity** entities;                  // Entity handles
+    Vector3* positions;                 // Packed positions
+    Vector3* velocities;                // Packed velocities
+    BoundingBox* bounds;                // Packed world-space boxes
+    int count;
+    int capacity;
+} EntityPool;
+
+/**
+ * Spatial hash entry of one entity
+ */
+typedef struct EntityGridEntry {
+    int cell_x, cell_z;                 // Cell of the entity's position
+    uint16_t type;                      // Pool of the entity
+    int index;                          // Slot in the pool
+    int next;                           // Next entry in the bucket (-1 = end)
+} EntityGridEntry;
+
 typedef struct EntityManager {
-    Entity* entities;                   // Linked list head
+    EntityPool pools[ENTITY_TYPE_COUNT];    // One pool per entity type
     EntityId next_id;                   // ID counter
     int entity_count;                   // Number of active entities
+
+    // Spatial hash (rebuilt every update, or lazily after adds/removes)
+    int grid_heads[ENTITY_GRID_BUCKETS];    // First entry per bucket (-1 = empty)
+    EntityGridEntry* grid_entries;      // One entry per entity
+    int grid_capacity;
+    float grid_reach;                   // Largest box extent from a position (query margin)
+    bool grid_valid;                    // False when pools changed since the rebuild
+
+    // Update phase work list (rebuilt every tick)
+    Entity** tick_entities;             // Entities due this tick
+    float* tick_dt;                     // Time each one simulates
+    int tick_count;
+    int tick_capacity;
+    uint32_t tick;                      // Tick counter (staggers far entities)
+
+    // Helper threads for the update phase
+    pthread_t threads[ENTITY_UPDATE_THREADS_MAX];
+    int thread_count;                   // 0 = updates always run on the main thread
+    pthread_mutex_t job_mutex;
+    pthread_cond_t job_start;           // Signaled when a tick's work list is ready
+    pthread_cond_t job_done;            // Signaled when the last helper finishes
+    uint32_t job_generation;            // Incremented per parallel tick
+    int job_next;                       // Next unclaimed work list index
+    int job_active;                     // Helpers still running this tick
+    struct World* job_world;
+    bool running;
+
+    struct NavSystem* nav;              // Flee field and path requests shared by all mobs
 } EntityManager;
 
 // ============================================================================
@@ -150,6 +233,8 @@ void entity_manager_remove(EntityManager* manager, Entity* entity);
 
 /**
  * Update all entities
+ * Runs the update callbacks (in parallel when there are many), then
+ * refreshes the pools and the spatial hash. Called once per fixed tick.
  * @param manager Entity manager
  * @param world World reference
  * @param dt Delta time in seconds
@@ -158,9 +243,26 @@ void entity_manager_update(EntityManager* manager, struct World* world, float dt
 
 /**
  * Render all entities
+ * Skips entities outside the view frustum or render distance and draws the
+ * rest instanced (call inside BeginMode3D).
+ * @param manager Entity manager
+ * @param alpha Fraction of the next tick already elapsed (0-1): entities are
+ *              drawn between their previous and current tick positions
+ */
+void entity_manager_render(EntityManager* manager, float alpha);
+
+/**
+ * Find the active entities whose bounding boxes overlap a box
+ * Looks only at spatial hash cells near the box.
  * @param manager Entity manager
+ * @param min Box minimum corner
+ * @param max Box maximum corner
+ * @param out Receives up to max_out entities (may be NULL if max_out is 0)
+ * @param max_out Capacity of out
+ * @return Number of overlapping entities (can exceed max_out)
  */
-void entity_manager_render(EntityManager* manager);
+int entity_manager_query_box(EntityManager* manager, Vector3 min, Vector3 max,
+                             Entity** out, int max_out);
 
 /**
  * Get entity count
@@ -24,6 +24,7 @@
 
 /**
  * Get a random float between min and max
+ * Thread-safe: every thread draws from its own generator
  */
 float entity_random_range(float min, float max);
 
@@ -0,0 +1,226 @@
+/**
+ * Mob Navigation
+ *
+ * Mobs plan on the nav heightfield chunks keep next to their surface map
+ * (one walkable ground height per column, see chunk_update_surface) instead
+ * of probing blocks. A mob may step onto a column one block higher and drop
+ * up to NAV_MAX_DROP blocks; water and columns without standing room are
+ * never entered.
+ *
+ * The heavy queries run once per tick on the main thread, before the
+ * parallel update phase, and are shared:
+ * - A flee field around the player: walking steps from the player to every
+ *   column near it. Every fleeing mob climbs it, so a whole herd costs one
+ *   breadth-first search.
+ * - Wander paths: mobs queue A* requests from their update callbacks and
+ *   the next tick solves them within a shared node budget.
+ */
+
+#ifndef NAV_H
+#define NAV_H
+
+#include "voxel/entity/entity.h"
+#include "voxel/world/world.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <raylib.h>
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define NAV_MAX_DROP 3               // Blocks a mob walks down in one step
+#define NAV_FIELD_SIZE 64            // Flee field side in columns, centered on the player
+#define NAV_FIELD_REFRESH 10         // Ticks a flee field is reused while the player stays in its column
+#define NAV_PATH_WINDOW 32           // A* search area side in columns, centered on the start
+#define NAV_PATH_MAX 24              // Waypoints kept per path (longer paths are cut)
+#define NAV_PATH_NODES 512           // Nodes one request may expand
+#define NAV_NODE_BUDGET 4096         // Nodes expanded per tick over all requests
+#define NAV_MAX_REQUESTS 256         // Queued path requests
+#define NAV_WAYPOINT_RADIUS 0.3f     // Horizontal distance at which a waypoint counts as reached
+
+#define NAV_UNREACHED 0xFFFF
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+typedef enum {
+    NAV_PATH_NONE,                   // No path (never asked, finished or dropped)
+    NAV_PATH_PENDING,                // Request queued, solved next tick
+    NAV_PATH_READY,                  // Following path_x/path_z
+    NAV_PATH_FAILED                  // Not a single step toward the goal was possible
+} NavPathState;
+
+/**
+ * What a mob should do this tick (nav_agent_steer)
+ */
+typedef enum {
+    NAV_STEER_NONE,                  // No path: move on the mob's own
+    NAV_STEER_WAIT,                  // Path not solved yet
+    NAV_STEER_MOVE,                  // Walk in the returned direction
+    NAV_STEER_ARRIVED                // Reached the end of the path this tick
+} NavSteer;
+
+/**
+ * Per-mob path state, kept in the mob's data
+ * Written by the owning mob's update and by nav_update, never at the same time
+ */
+typedef struct NavAgent {
+    NavPathState state;
+    uint32_t request_id;             // Latest request; older answers are ignored
+    int path_x[NAV_PATH_MAX];        // Waypoint columns, start excluded
+    int path_z[NAV_PATH_MAX];
+    int path_length;
+    int path_index;                  // Next waypoint
+} NavAgent;
+
+typedef struct NavRequest {
+    const Entity* entity;
+    NavAgent* agent;
+    uint32_t request_id;
+    int start_x, start_y, start_z;   // Feet block of the mob
+    int goal_x, goal_z;
+} NavRequest;
+
+/**
+ * Steps from the player to the columns around it
+ */
+typedef struct NavFleeField {
+    bool valid;
+    atomic_bool wanted;              // A mob read the field during the last update phase
+    uint32_t built_tick;
+    int threat_x, threat_z;          // Player column the field was built from
+    int origin_x, origin_z;          // World column of cell (0, 0)
+    uint16_t dist[NAV_FIELD_SIZE * NAV_FIELD_SIZE];   // Indexed z * NAV_FIELD_SIZE + x
+    uint8_t height[NAV_FIELD_SIZE * NAV_FIELD_SIZE];
+    uint8_t flags[NAV_FIELD_SIZE * NAV_FIELD_SIZE];
+    uint16_t queue[NAV_FIELD_SIZE * NAV_FIELD_SIZE];
+} NavFleeField;
+
+/**
+ * A* node of the search window
+ */
+typedef struct NavNode {
+    uint32_t stamp;                  // Search that last touched the node
+    uint16_t cost;                   // Best known cost from the start
+    int16_t parent;                  // Window index (-1 = start)
+    uint8_t height;
+    uint8_t flags;                   // CHUNK_NAV_* of the column
+    bool closed;
+} NavNode;
+
+typedef struct NavHeapEntry {
+    uint32_t score;
+    int16_t index;
+} NavHeapEntry;
+
+/**
+ * Shared navigation jobs (one per entity manager)
+ */
+typedef struct NavSystem {
+    uint32_t tick;
+    NavFleeField flee;
+
+    NavRequest requests[NAV_MAX_REQUESTS];
+    atomic_int request_count;        // May run past NAV_MAX_REQUESTS while mobs queue (extra requests fail)
+    atomic_uint next_request_id;
+
+    // A* scratch
+    uint32_t search;
+    NavNode nodes[NAV_PATH_WINDOW * NAV_PATH_WINDOW];
+    NavHeapEntry heap[NAV_PATH_NODES * 8 + 1];  // Up to 8 pushes per expanded node
+    int16_t trail[NAV_PATH_WINDOW * NAV_PATH_WINDOW];
+
+    // Last tick
+    int paths_solved;
+    int nodes_expanded;
+} NavSystem;
+
+// ============================================================================
+// API
+// ============================================================================
+
+NavSystem* nav_create(void);
+void nav_destroy(NavSystem* nav);
+
+/**
+ * Run the shared jobs: rebuild the flee field if a mob used it, then solve
+ * queued path requests up to NAV_NODE_BUDGET nodes
+ * Call on the main thread before the update phase
+ */
+void nav_update(NavSystem* nav, struct World* world);
+
+/**
+ * Drop the queued requests of an entity (call when it leaves the manager)
+ */
+void nav_cancel(NavSystem* nav, const Entity* entity);
+
+/**
+ * Navigation of the world's entity manager (NULL if it has none)
+ */
+NavSystem* nav_get(struct World* world);
+
+/**
+ * Nav entry of world column (x, z): CHUNK_NAV_* flags, 0 if blocked or not loaded
+ */
+uint8_t nav_sample(WorldCursor* cursor, int x, int z, int* out_height);
+
+/**
+ * Direction down the flee field from position, away from the player
+ * Returns false if the field does not cover the position or no neighbor
+ * gets farther; out_dir is then untouched. Safe in update callbacks.
+ */
+bool nav_flee_direction(NavSystem* nav, Vector3 position, Vector3* out_dir);
+
+/**
+ * Pick a walkable column within radius and queue a path to it
+ * Safe in update callbacks. Returns false if no goal was found or the queue is full.
+ */
+bool nav_agent_wander(NavSystem* nav, NavAgent* agent, const Entity* entity,
+                      struct World* world, float radius);
+
+/**
+ * Follow the agent's path from position
+ */
+NavSteer nav_agent_steer(NavAgent* agent, Vector3 position, Vector3* out_dir);
+
+/**
+ * Forget the agent's path (answers to pending requests are ignored)
+ */
+void nav_agent_reset(NavAgent* agent);
+
+/**
+ * Whether the column just ahead along direction is one block up and walkable
+ */
+bool nav_should_jump(struct World* world, Vector3 position, Vector3 direction);
+
+/**
+ * Whether a motionless entity stands right on its column's walkable ground
+ * Such an entity needs no collision this tick; any edit of the column moves
+ * its ground and ends the rest.
+ */
+bool nav_is_resting(struct World* world, const Entity* entity);
+
+/**
+ * Run away from the player: down the flee field, straight along away where
+ * the field has no answer. Drops the agent's path, sets the entity's
+ * horizontal velocity and heading, and returns the run direction.
+ * Safe in update callbacks.
+ */
+Vector3 nav_agent_flee(NavAgent* agent, Entity* entity, struct World* world, Vector3 away, float speed);
+
+/**
+ * Move a walking mob one tick: jump, gravity and collision, with its
+ * horizontal velocity already set along move_dir
+ * Steps up where the heightfield ahead is one block higher (jump_velocity,
+ * then jump_cooldown_time seconds before the next jump; *jump_cooldown is the
+ * mob's timer). Standing still on known ground skips collision entirely.
+ * Returns true if the mob walked into a wall it could not step over; the
+ * agent's path is then dropped and the mob should pick a new goal.
+ */
+bool nav_agent_move(NavAgent* agent, Entity* entity, struct World* world, Vector3 move_dir,
+                    float* jump_cooldown, float jump_velocity, float jump_cooldown_time, float dt);
+
+#endif // NAV_H
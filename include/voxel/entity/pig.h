@@ -7,13 +7,15 @@
  * - Small ears
  * - 4 animated legs
  * - Curly tail
- * - Wandering + flee AI behavior
+ * - Wandering + flee AI behavior on the nav heightfield (nav.h)
  */
 
 #ifndef PIG_H
 #define PIG_H
 
 #include "voxel/entity/entity.h"
+#include "voxel/entity/nav.h"
+#include "voxel/core/item.h"
 #include <raylib.h>
 
 // ============================================================================
@@ -58,6 +60,7 @@
 #define PIG_WANDER_TIME_MAX 6.0f    // Maximum time before direction change
 #define PIG_IDLE_CHANCE 0.4f        // 40% chance to stand idle
 #define PIG_IDLE_TIME 2.5f          // Time spent idle
+#define PIG_WANDER_RADIUS 6.0f      // Farthest wander goal
 
 // ============================================================================
 // PIG DATA
@@ -87,6 +90,7 @@ typedef struct {
     bool is_idle;                   // Currently standing still
     bool is_fleeing;                // Currently fleeing from player
     Vector3 wander_direction;       // Current movement direction (normalized)
+    NavAgent nav;                   // Path to the wander goal
 
     // Lighting (updated each frame)
     Vector3 ambient_light;          // Current ambient light color (0-1)
@@ -103,6 +107,9 @@ typedef struct {
 #define PIG_JUMP_VELOCITY 7.0f      // Enough for ~1.2 block jump
 #define PIG_JUMP_COOLDOWN 0.5f      // Minimum time between jumps
 
+// Drops
+#define PIG_DROP_STACKS 1           // Meat
+
 // ============================================================================
 // PIG API
 // ============================================================================
@@ -123,6 +130,14 @@ Entity* pig_spawn(EntityManager* manager, Vector3 position);
  */
 bool pig_damage(Entity* entity, int damage);
 
+/**
+ * Roll the items a killed pig drops (1-3 meat)
+ * @param entity The dead pig
+ * @param out Receives up to PIG_DROP_STACKS stacks
+ * @return Number of stacks written
+ */
+int pig_get_drops(const Entity* entity, ItemStack* out);
+
 // ============================================================================
 // INTERNAL CALLBACKS (called by entity system)
 // ============================================================================
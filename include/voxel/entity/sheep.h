@@ -5,13 +5,15 @@
  * - Woolly body (cube)
  * - Head with eyes (cube)
  * - 4 animated legs
- * - Wandering + flee AI behavior
+ * - Wandering + flee AI behavior on the nav heightfield (nav.h)
  */
 
 #ifndef SHEEP_H
 #define SHEEP_H
 
 #include "voxel/entity/entity.h"
+#include "voxel/entity/nav.h"
+#include "voxel/core/item.h"
 #include <raylib.h>
 
 // ============================================================================
@@ -48,6 +50,7 @@
 #define SHEEP_WANDER_TIME_MAX 5.0f  // Maximum time before direction change
 #define SHEEP_GRAZE_CHANCE 0.3f     // 30% chance to graze when picking new direction
 #define SHEEP_GRAZE_TIME 2.0f       // Time spent grazing
+#define SHEEP_WANDER_RADIUS 8.0f    // Farthest wander goal
 
 // ============================================================================
 // SHEEP DATA
@@ -74,6 +77,7 @@ typedef struct {
     bool is_grazing;                // Currently grazing (head down, not moving)
     bool is_fleeing;                // Currently fleeing from player
     Vector3 wander_direction;       // Current movement direction (normalized)
+    NavAgent nav;                   // Path to the wander goal
 
     // Lighting (updated each frame)
     Vector3 ambient_light;          // Current ambient light color (0-1)
@@ -90,6 +94,9 @@ typedef struct {
 #define SHEEP_JUMP_VELOCITY 7.0f    // Enough for ~1.2 block jump
 #define SHEEP_JUMP_COOLDOWN 0.5f    // Minimum time between jumps
 
+// Drops
+#define SHEEP_DROP_STACKS 2         // Meat and wool
+
 // ============================================================================
 // SHEEP API
 // ============================================================================
@@ -119,6 +126,14 @@ Entity* sheep_spawn_colored(EntityManager* manager, Vector3 position, Color wool
  */
 bool sheep_damage(Entity* entity, int damage);
 
+/**
+ * Roll the items a killed sheep drops (1-2 meat, 1-3 wool of its color)
+ * @param entity The dead sheep
+ * @param out Receives up to SHEEP_DROP_STACKS stacks
+ * @return Number of stacks written
+ */
+int sheep_get_drops(const Entity* entity, ItemStack* out);
+
 // ============================================================================
 // INTERNAL CALLBACKS (called by entity system)
 // ============================================================================
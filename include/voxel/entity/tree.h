@@ -2,6 +2,8 @@
  * Tree Generation & Leaf Decay System
  *
  * Generates procedural trees. Leaves decay over time when not connected to wood.
+ * Each leaf keeps its distance to the nearest log in metadata, so only the
+ * leaves that lost their support are touched when a log is broken.
  */
 
 #ifndef VOXEL_TREE_H
@@ -9,8 +11,23 @@
 
 #include "voxel/world/chunk.h"
 
-// Forward declaration
+// Forward declarations
 struct World;
+typedef struct ColumnMap ColumnMap;
+typedef struct WorldEdit WorldEdit;
+typedef struct StructureStore StructureStore;
+typedef struct StructureFragment StructureFragment;
+
+// Leaf metadata encoding:
+// Bits 0-2: Distance to the nearest log through leaves (1 = touching a log,
+//           LEAF_DISTANCE_NONE = unsupported, decays)
+// 0 = placed by a player: never decays and supports no other leaf
+#define LEAF_DISTANCE_MASK        0x07
+#define LEAF_DISTANCE_PERSISTENT  0
+#define LEAF_DECAY_RANGE          4                         // Max distance leaves can be from wood
+#define LEAF_DISTANCE_NONE        (LEAF_DECAY_RANGE + 1)
+
+#define TREE_MAX_BLOCKS 128       // Blocks in the largest tree template
 
 // Tree size variations
 typedef enum {
@@ -32,7 +49,8 @@ typedef enum {
 /**
  * Place a tree at the given local chunk coordinates.
  * base_y is where the trunk starts (should be above grass).
- * Tree blocks are placed with metadata=1 to mark as natural.
+ * Logs are placed with metadata=1 to mark them natural; leaves get their
+ * distance to the tree's logs.
  */
 void tree_place_at(Chunk* chunk, int local_x, int base_y, int local_z, TreeSize size);
 
@@ -47,8 +65,25 @@ void tree_place_at_typed(Chunk* chunk, int local_x, int base_y, int local_z,
  * Generate trees for an entire chunk.
  * Uses noise for natural placement on grass blocks.
  * Call this after terrain generation.
+ * columns: the chunk's column map for biomes (NULL = sampled per column)
+ * structures: first places the neighbors' trees that reach into this chunk,
+ * then records the parts of this chunk's trees that reach into neighbors
+ * (NULL = trees are clipped at the chunk border)
+ */
+void tree_generate_for_chunk(Chunk* chunk, const ColumnMap* columns, StructureStore* structures);
+
+/**
+ * Place the tree fragments recorded for this chunk and seal it
+ * (tree_generate_for_chunk does this; call it for chunks loaded from disk)
+ * Returns the number of fragments placed
+ */
+int tree_apply_pending(Chunk* chunk, StructureStore* structures);
+
+/**
+ * Collect the blocks a late fragment places in a live chunk as world edits
+ * Returns the number of edits written (at most max_edits)
  */
-void tree_generate_for_chunk(Chunk* chunk);
+int tree_fragment_edits(Chunk* chunk, const StructureFragment* fragment, WorldEdit* edits, int max_edits);
 
 /**
  * Initialize the leaf decay system.
@@ -56,14 +91,15 @@ void tree_generate_for_chunk(Chunk* chunk);
 void leaf_decay_init(void);
 
 /**
- * Schedule leaves near a removed wood block for decay check.
- * Call this when a wood block is broken.
+ * Update leaf distances after a block was removed and schedule the leaves
+ * that lost their support for decay.
+ * Call this when a log or leaf is broken (other blocks are ignored).
  */
-void leaf_decay_on_wood_removed(struct World* world, int x, int y, int z);
+void leaf_decay_on_block_removed(struct World* world, int x, int y, int z, Block removed);
 
 /**
  * Update leaf decay - call each frame.
- * Processes pending leaves and removes those not connected to wood.
+ * Removes the scheduled leaves whose delay has passed.
  */
 void leaf_decay_update(struct World* world, float dt);
 
@@ -2,6 +2,11 @@
  * Crafting System
  *
  * Implements recipe matching and crafting mechanics with shaped and shapeless recipes.
+ *
+ * crafting_init compiles the recipes into hash indexes: shaped recipes by
+ * their pattern trimmed to its bounding box, shapeless ones by their sorted
+ * inputs. Matching a grid is then two bucket lookups, whatever the number
+ * of recipes.
  */
 
 #ifndef VOXEL_CRAFTING_H
@@ -15,7 +20,8 @@
 // CONSTANTS
 // ============================================================================
 
-#define MAX_RECIPES 32
+#define MAX_RECIPES 512
+#define RECIPE_INDEX_BUCKETS 1024   // Pattern / ingredient hash buckets (power of two)
 
 // ============================================================================
 // DATA STRUCTURES
@@ -44,7 +50,7 @@ typedef struct {
 // ============================================================================
 
 /**
- * Initialize crafting system and load all recipes
+ * Initialize crafting system, load all recipes and build their indexes
  */
 void crafting_init(void);
 
@@ -67,6 +73,14 @@ void crafting_update_output(Inventory* inv);
  */
 bool crafting_try_craft(Inventory* inv);
 
+/**
+ * Take the crafting output into the held stack and consume the inputs
+ * The held stack must be empty or the same item with room for the output.
+ * Reported to the inventory's action func before anything changes.
+ * Returns true if crafting succeeded
+ */
+bool crafting_take_output(Inventory* inv);
+
 /**
  * Calculate how many times we can craft the current recipe
  * Returns 0 if no valid recipe
@@ -19,14 +19,45 @@
 #define CRAFTING_GRID_SIZE 9
 #define CRAFTING_OUTPUT_SIZE 1
 
+// Global slot indices (see inventory_get_slot)
+#define INVENTORY_SLOT_CRAFTING_GRID (HOTBAR_SIZE + MAIN_INVENTORY_SIZE)
+#define INVENTORY_SLOT_CRAFTING_OUTPUT (INVENTORY_SLOT_CRAFTING_GRID + CRAFTING_GRID_SIZE)
+
 // ============================================================================
 // DATA STRUCTURES
 // ============================================================================
 
+// Forward declarations
+typedef struct ChestData ChestData;
+typedef struct Inventory Inventory;
+
+typedef enum {
+    INVENTORY_ACTION_CRAFT,         // Crafting output taken into the held stack
+    INVENTORY_ACTION_CHEST_TAKE,    // Chest slot moved into the inventory
+    INVENTORY_ACTION_CHEST_STORE,   // Inventory slot moved into the chest
+    INVENTORY_ACTION_MINE,          // Drop of a mined block added to the inventory
+} InventoryActionType;
+
+/**
+ * Inventory change that another party has to validate (the multiplayer host)
+ */
+typedef struct {
+    InventoryActionType type;
+    ChestData* chest;               // Chest actions only
+    int slot;                       // Chest slot (take), inventory slot index (store), hotbar slot (mine)
+    int x, y, z;                    // Mined block (mine only)
+    BlockType block;
+} InventoryAction;
+
+/**
+ * Called before an action is applied to the inventory it was set on
+ */
+typedef void (*InventoryActionFunc)(void* user, Inventory* inv, const InventoryAction* action);
+
 /**
  * Inventory structure
  */
-typedef struct Inventory {
+struct Inventory {
     ItemStack hotbar[HOTBAR_SIZE];                    // Quick access slots (1-9 keys)
     ItemStack main_inventory[MAIN_INVENTORY_SIZE];    // 3 rows x 9 columns
     ItemStack crafting_grid[CRAFTING_GRID_SIZE];      // 3x3 crafting input
@@ -37,7 +68,10 @@ typedef struct Inventory {
 
     ItemStack held_item;       // Item being dragged by cursor
     bool is_holding_item;      // Is player holding an item?
-} Inventory;
+
+    InventoryActionFunc action_func;  // Observer of validated actions (NULL = none)
+    void* action_user;
+};
 
 // ============================================================================
 // PUBLIC API
@@ -100,4 +134,33 @@ int inventory_get_total_slots(Inventory* inv);
  */
 void inventory_clear(Inventory* inv);
 
+/**
+ * Fill an empty inventory with the items every player starts with
+ */
+void inventory_give_starting_items(Inventory* inv);
+
+/**
+ * Report actions on this inventory to func before they are applied (NULL = stop)
+ */
+void inventory_set_action_func(Inventory* inv, InventoryActionFunc func, void* user);
+
+/**
+ * Move a chest slot into the inventory with chest_take_item
+ * Nothing moves unless the whole stack fits. Returns true if it moved.
+ */
+bool inventory_take_from_chest(Inventory* inv, ChestData* chest, int chest_slot);
+
+/**
+ * Move an inventory slot (global index) into a chest
+ * Returns true if the chest took the stack
+ */
+bool inventory_store_in_chest(Inventory* inv, int slot_index, ChestData* chest);
+
+/**
+ * Add the drop of block (mined at x, y, z with the selected hotbar item)
+ * Nothing is added unless the tool harvests the block and the whole drop
+ * fits. Returns true if the drop was added.
+ */
+bool inventory_add_block_drop(Inventory* inv, int x, int y, int z, BlockType block);
+
 #endif // VOXEL_INVENTORY_H
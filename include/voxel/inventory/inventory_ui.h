@@ -26,9 +26,15 @@ void inventory_ui_draw_hotbar(Inventory* inv, Texture2D atlas);
 /**
  * Draw the full inventory screen (main inventory + crafting)
  * Only visible when inventory is open (E key)
+ * The panel is cached and only redrawn when slots or guide state change
  */
 void inventory_ui_draw_full_screen(Inventory* inv, Texture2D atlas);
 
+/**
+ * Release the cached inventory and chest panels (before CloseWindow)
+ */
+void inventory_ui_unload(void);
+
 /**
  * Draw an item icon from the texture atlas
  * Used for rendering items in slots
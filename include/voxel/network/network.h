@@ -2,7 +2,15 @@
  * Network - LAN Multiplayer System
  *
  * Provides server/client networking for multiplayer gameplay using raw BSD sockets.
- * Host acts as both server and client. Supports up to 8 players.
+ * Host acts as both server and client. Supports up to NET_MAX_CLIENTS players;
+ * the server watches all sockets with one epoll set.
+ *
+ * Each client has a TCP stream, the reliable ordered channel (connection,
+ * block changes, chunks, inventory, entities). Player states also go over an
+ * unreliable sequenced UDP channel on the same port once the client's UDP
+ * address is confirmed, so a lost segment does not hold them back; datagrams
+ * older than the newest one received are dropped by header sequence. Clients
+ * that cannot reach the host over UDP stay on TCP.
  */
 
 #ifndef VOXEL_NETWORK_H
@@ -11,28 +19,83 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <netinet/in.h>
 #include <raylib.h>
 
 // Include actual types to avoid forward declaration conflicts
 #include "voxel/world/world.h"
 #include "voxel/player/player.h"
 #include "voxel/entity/entity.h"
+#include "voxel/inventory/inventory.h"
+#include "voxel/world/chest.h"
 
 // ============================================================================
 // CONSTANTS
 // ============================================================================
 
 #define NET_PROTOCOL_MAGIC      0x4B41544C  // "KATL"
-#define NET_PROTOCOL_VERSION    1
-#define NET_MAX_CLIENTS         8
+#define NET_PROTOCOL_VERSION    9
+#define NET_MAX_CLIENTS         64
 #define NET_DEFAULT_PORT        7777
 #define NET_MAX_PACKET_SIZE     65535
-#define NET_RECV_BUFFER_SIZE    65536
-#define NET_SEND_BUFFER_SIZE    65536
+#define NET_RECV_BUFFER_SIZE    65536       // Power of two (server receive ring)
+#define NET_SEND_QUEUE_INITIAL  64          // Queued packets per client before the queue grows
+#define NET_PACKET_CLASSES      3           // Packet buffer size classes (see network.c)
+#define NET_PACKET_POOL_KEEP    64          // Free packet buffers kept per size class
+#define NET_EPOLL_EVENTS        64          // Socket events taken per epoll_wait
 #define NET_PLAYER_NAME_MAX     32
 #define NET_HEARTBEAT_INTERVAL  1.0f        // Seconds between heartbeats
 #define NET_TIMEOUT_DURATION    5.0f        // Seconds before disconnect
 
+// UDP channel
+#define NET_UDP_PAYLOAD_MAX     1200        // Larger unreliable packets go over TCP
+#define NET_UDP_HELLO_INTERVAL  0.25f       // Seconds between UDP_HELLO attempts
+#define NET_UDP_HELLO_ATTEMPTS  20          // Attempts before staying on TCP
+
+// Chunk streaming
+#define NET_CHUNK_QUEUE_MAX     1024        // Chunk requests queued per client
+#define NET_CHUNK_REQUEST_BATCH 256         // Coordinates per CHUNK_REQUEST packet
+#define NET_CHUNK_FRAGMENT_SIZE 60000       // Chunk bytes per CHUNK_DATA packet
+#define NET_CHUNK_DATA_MAX      (4 * 1024 * 1024)  // Largest accepted encoded chunk
+#define NET_CHUNKS_PER_UPDATE   4           // Chunks sent to each client per update
+#define NET_CHUNK_SCAN_MAX      16          // Requests checked per client per update
+#define NET_CHUNK_SEND_BACKLOG  (128 * 1024) // Unsent bytes that pause streaming
+#define NET_SEND_QUEUE_MAX      (1024 * 1024) // Unsent bytes before dropping a client
+
+// Block change batching
+#define NET_BLOCK_BATCH_MAX     4096        // Changes coalesced before an early flush
+#define NET_BLOCK_BATCH_SLOTS   8192        // Position table of a batch (power of two)
+#define NET_BLOCK_GROUP_HEADER  10          // Chunk x/z and change count per group
+#define NET_BLOCK_ENTRY_SIZE    4           // Packed position, type, metadata
+
+// Inventory and chest synchronization
+#define NET_INVENTORY_SLOT_COUNT 47         // Global inventory slots plus the held stack
+#define NET_INVENTORY_HELD_SLOT 46          // Held stack (cursor)
+#define NET_INVENTORY_PAYLOAD_MAX 4096      // INVENTORY_SYNC payload before an early send
+#define NET_INVENTORY_RECORD_MAX 400        // Largest record (every inventory slot)
+#define NET_ITEM_DELTA_DURABILITY 0x80      // Slot byte flag: durabilities follow
+#define NET_CHEST_BATCH_MAX     64          // Changed chests coalesced before an early flush
+#define NET_CHEST_REACH         8.0f        // Farthest chest a client can use (blocks)
+#define NET_MINED_BLOCKS_MAX    16          // Broken blocks whose drops a client may still claim
+
+// Player state snapshots
+#define NET_SNAPSHOT_HISTORY    32          // Snapshots kept as delta baselines
+#define NET_SNAPSHOT_MASK_BYTES ((NET_MAX_CLIENTS + 7) / 8)
+
+// Remote player interpolation
+#define NET_INTERP_SAMPLES      16          // States kept per remote player
+#define NET_INTERP_DELAY_MS     120         // Remote players are drawn this far in the past
+#define NET_EXTRAPOLATE_MAX_MS  250         // Longest a missing update is extrapolated over
+
+// Interest management (distances in chunks)
+#define NET_INTEREST_NEAR       4           // Players this close are sent every snapshot
+#define NET_INTEREST_FAR_INTERVAL 4         // Snapshots between updates of farther players
+
+// Entity replication
+#define NET_ENTITY_INTEREST     6           // Animals this close (in chunks) are replicated
+#define NET_ENTITY_VIEW_MAX     1024        // Animals sent to one client per snapshot
+#define NET_ENTITY_MIRROR_SLOTS 2048        // Client's host id -> entity table (power of two)
+
 // ============================================================================
 // PACKET TYPES
 // ============================================================================
@@ -45,6 +108,8 @@ typedef enum {
     NET_PACKET_DISCONNECT       = 0x04,
     NET_PACKET_HEARTBEAT        = 0x05,
     NET_PACKET_HEARTBEAT_ACK    = 0x06,
+    NET_PACKET_UDP_HELLO        = 0x07,  // Client's UDP address (UDP, client -> server)
+    NET_PACKET_UDP_READY        = 0x08,  // UDP address confirmed (server -> client)
 
     // Player synchronization
     NET_PACKET_PLAYER_JOIN      = 0x10,
@@ -53,13 +118,17 @@ typedef enum {
     NET_PACKET_PLAYER_STATES    = 0x13,  // Batch of all player states
 
     // World synchronization
-    NET_PACKET_BLOCK_CHANGE     = 0x20,
+    NET_PACKET_BLOCK_CHANGES    = 0x20,  // Coalesced changes grouped by chunk
     NET_PACKET_CHUNK_REQUEST    = 0x21,
     NET_PACKET_CHUNK_DATA       = 0x22,
 
     // Game state
     NET_PACKET_TIME_SYNC        = 0x30,
-    NET_PACKET_INVENTORY_SYNC   = 0x31,
+    NET_PACKET_INVENTORY_SYNC   = 0x31,  // Changed slots and validated actions
+
+    // Entity synchronization
+    NET_PACKET_ENTITY_STATES    = 0x40,  // Animals near the recipient
+    NET_PACKET_ENTITY_HIT       = 0x41,  // Client attacked a host entity
 } NetPacketType;
 
 // ============================================================================
@@ -80,12 +149,13 @@ typedef struct {
 // PACKET PAYLOADS
 // ============================================================================
 
-// Connection request (client -> server)
+// Connection request (client -> server), followed by a u8 view distance
 typedef struct {
     char player_name[NET_PLAYER_NAME_MAX];
 } NetConnectRequest;
 
-// Connection accepted (server -> client)
+// Connection accepted (server -> client), followed by the host name and the
+// u32 token the client puts in UDP_HELLO (u8 client id, u32 token)
 typedef struct {
     uint8_t  client_id;         // Assigned client ID (1-7, 0 = host)
     uint32_t world_seed;        // World seed for terrain
@@ -113,6 +183,70 @@ typedef struct {
 #define NET_PLAYER_FLAG_FLYING      0x01
 #define NET_PLAYER_FLAG_GROUNDED    0x02
 
+#define NET_PLAYER_STATE_SIZE       35  // Serialized NetPlayerState (client -> server)
+
+/**
+ * Quantized player state, as carried by PLAYER_STATES snapshots
+ * Positions are fixed-point inside their chunk column (1/256 block
+ * horizontally, 1/128 vertically), velocities 1/256 block per second and
+ * angles a full turn per 65536.
+ */
+typedef struct {
+    int32_t  chunk_x, chunk_z;
+    uint16_t pos[3];
+    int16_t  vel[3];
+    uint16_t yaw, pitch;
+    uint8_t  flags;
+    uint8_t  selected_slot;
+} NetQuantState;
+
+// NetQuantState fields sent in a snapshot entry (unchanged ones are left out)
+#define NET_QUANT_CHUNK     0x0001
+#define NET_QUANT_POS_X     0x0002
+#define NET_QUANT_POS_Y     0x0004
+#define NET_QUANT_POS_Z     0x0008
+#define NET_QUANT_VEL_X     0x0010
+#define NET_QUANT_VEL_Y     0x0020
+#define NET_QUANT_VEL_Z     0x0040
+#define NET_QUANT_YAW       0x0080
+#define NET_QUANT_PITCH     0x0100
+#define NET_QUANT_FLAGS     0x0200
+#define NET_QUANT_SLOT      0x0400
+
+/**
+ * States of all players at one broadcast
+ * PLAYER_STATES (server -> client): u16 id, u16 baseline id, u8 has baseline,
+ * u32 host clock (ms), active mask, u8 entry count, then per changed player u8 client id, u16
+ * field mask and the fields. Players absent from the entries are unchanged
+ * since the baseline, the last snapshot the client acknowledged (u16 after
+ * its PLAYER_STATE). The mask only holds players inside the recipient's
+ * interest window; the rest are connected but out of sight.
+ */
+typedef struct {
+    uint16_t      id;
+    bool          valid;
+    uint32_t      time_ms;      // Host clock at the broadcast
+    uint8_t       active[NET_SNAPSHOT_MASK_BYTES];
+    NetQuantState states[NET_MAX_CLIENTS];
+} NetSnapshot;
+
+/**
+ * Timestamped states of one remote player, oldest to newest
+ * Remote players are drawn NET_INTERP_DELAY_MS in the past, between the two
+ * states around that time, so late or lost updates do not show as jumps.
+ * Past the newest state the player is extrapolated along its velocity.
+ */
+typedef struct {
+    uint32_t       time_ms;     // Local clock
+    NetPlayerState state;
+} NetInterpSample;
+
+typedef struct {
+    NetInterpSample samples[NET_INTERP_SAMPLES];
+    int             head;       // Newest sample
+    int             count;
+} NetInterpTrack;
+
 // Player join notification (server -> all)
 typedef struct {
     uint8_t client_id;
@@ -134,6 +268,106 @@ typedef struct {
     uint8_t client_id;          // Who made the change
 } NetBlockChange;
 
+/**
+ * Block changes of one tick, coalesced before sending
+ * A later change to a position replaces the earlier one. BLOCK_CHANGES
+ * carries a u16 group count, then per chunk i32 chunk x/z, u16 change
+ * count and per change a u16 packed position (y << 8 | z << 4 | x, inside
+ * the chunk), u8 block type and u8 metadata.
+ */
+typedef struct {
+    NetBlockChange changes[NET_BLOCK_BATCH_MAX];
+    int            count;
+    uint16_t       slots[NET_BLOCK_BATCH_SLOTS];  // Position hash -> change index + 1 (0 = empty)
+} NetBlockBatch;
+
+// Chunk coordinate (CHUNK_REQUEST carries a u16 count, then x/z pairs)
+typedef struct {
+    int32_t x, z;
+} NetChunkCoord;
+
+// CHUNK_DATA fragment header (server -> client), followed by chunk_codec bytes
+// total = 0 means the host has no data and the client generates the chunk
+typedef struct {
+    int32_t  chunk_x, chunk_z;
+    uint32_t total_size;        // Encoded size of the whole chunk
+    uint32_t offset;            // Position of this fragment
+} NetChunkData;
+
+#define NET_CHUNK_DATA_HEADER_SIZE 16
+
+/**
+ * Animal state, as carried by ENTITY_STATES (server -> client)
+ * ENTITY_STATES is a u16 count, then per animal u32 id, u8 type, u8 flags,
+ * i32 x and z (1/256 block), u16 y (player scale), u16 yaw and u8 hp; the
+ * first time a client is sent an animal, flags has NET_ENTITY_FLAG_SPAWN
+ * and an RGB appearance color follows. The list holds every animal inside
+ * the recipient's entity window: animals left out are gone for it.
+ */
+typedef struct {
+    uint32_t id;                // Host's entity id
+    uint8_t  type;              // EntityType
+    uint8_t  flags;
+    int32_t  pos_x, pos_z;
+    uint16_t pos_y;
+    uint16_t yaw;
+    uint8_t  hp;
+    Color    color;             // Appearance (wool), NET_ENTITY_FLAG_SPAWN only
+} NetEntityState;
+
+#define NET_ENTITY_FLAG_FLEEING     0x01
+#define NET_ENTITY_FLAG_RESTING     0x02    // Idle pig, grazing sheep
+#define NET_ENTITY_FLAG_HURT        0x04    // Damage flash running
+#define NET_ENTITY_FLAG_SPAWN       0x80    // Appearance follows
+
+#define NET_ENTITY_STATE_SIZE       19      // Serialized NetEntityState without appearance
+
+// Entity hit (client -> server): u32 host entity id, u8 damage
+
+/**
+ * INVENTORY_SYNC records
+ * An INVENTORY_SYNC payload is a sequence of records, each a u8 kind then its
+ * fields, sent at most once per update in each direction. Slot entries are
+ * ItemStack deltas: only slots that changed are listed, each as a u8 slot
+ * (NET_ITEM_DELTA_DURABILITY set when u16 durability and max durability
+ * follow), u8 item type and u8 count. Slot NET_INVENTORY_HELD_SLOT is the
+ * held stack.
+ *
+ * The host owns each client's inventory. A client's slot changes may only
+ * move, split or use up what the host holds (no item type gains count or
+ * durability); anything that adds items is an action the host validates
+ * (crafting, chest moves, the drop of a block the client broke) or the host
+ * grants itself (starting items, animal drops). A client applies an action
+ * at once and predicts the host's result; the action carries a hash of the
+ * predicted slots, and the host answers a mismatch or a rejected slot change
+ * with its contents. The host owns every chest: changed chest slots go to
+ * the clients that see the chest's chunk.
+ */
+typedef enum {
+    NET_INVENTORY_SLOTS         = 0,    // u8 count, slot entries
+    NET_INVENTORY_CHEST         = 1,    // i32 x/y/z, u8 count, slot entries (server -> client)
+    NET_INVENTORY_CRAFT         = 2,    // u32 inventory hash (client -> server)
+    NET_INVENTORY_CHEST_OPEN    = 3,    // i32 x/y/z (client -> server, all slots come back)
+    NET_INVENTORY_CHEST_TAKE    = 4,    // i32 x/y/z, u8 chest slot, u32 inventory and chest hashes
+    NET_INVENTORY_CHEST_STORE   = 5,    // i32 x/y/z, u8 inventory slot, u32 inventory and chest hashes
+    NET_INVENTORY_MINE          = 6,    // i32 x/y/z, u8 hotbar slot, u32 inventory hash
+} NetInventoryRecord;
+
+// Chest as it was when it first changed in this update (host)
+typedef struct {
+    int32_t   x, y, z;
+    ItemStack before[CHEST_SLOTS];
+} NetChestChange;
+
+/**
+ * Chests changed during one update, coalesced before sending
+ * Each chest is listed once; the slots that differ from before are sent.
+ */
+typedef struct {
+    NetChestChange chests[NET_CHEST_BATCH_MAX];
+    int            count;
+} NetChestBatch;
+
 // Time synchronization (server -> all)
 typedef struct {
     float time_of_day;
@@ -162,18 +396,99 @@ typedef enum {
 // CLIENT SLOT (for server)
 // ============================================================================
 
+/**
+ * Byte ring buffer (capacity is a power of two)
+ * head and tail only grow; positions are taken modulo the capacity.
+ */
+typedef struct {
+    uint8_t*           data;
+    size_t             capacity;
+    size_t             head;            // Next byte to read
+    size_t             tail;            // Next byte to write
+} NetRing;
+
+/**
+ * Pooled, reference-counted packet (header + payload)
+ * Packets are serialized straight into one of these and sent from it. A
+ * client whose socket does not take a packet whole queues a reference, so a
+ * broadcast is built once and never copied per client. The buffer goes back
+ * to the server's pool when its last reference is released.
+ */
+typedef struct NetPacketBuf {
+    struct NetPacketBuf* next_free;
+    uint32_t           refs;
+    uint32_t           size;            // Header + payload bytes
+    uint32_t           capacity;
+    uint8_t            size_class;
+    uint8_t            data[];
+} NetPacketBuf;
+
+// Block a client broke, as it was on the host
+typedef struct {
+    int32_t            x, y, z;
+    BlockType          type;
+} NetMinedBlock;
+
+// Packet waiting in a client's send queue, sent up to offset
+typedef struct {
+    NetPacketBuf*      packet;
+    uint32_t           offset;
+} NetSendEntry;
+
 typedef struct {
     int                socket_fd;
     uint8_t            client_id;
     char               player_name[NET_PLAYER_NAME_MAX];
     NetPlayerState     last_state;
+    NetInterpTrack     track;           // Received states by arrival time (host rendering)
     float              last_heartbeat;
     bool               connected;
     bool               authenticated;
 
-    // Receive buffer for partial packets
-    uint8_t            recv_buffer[NET_RECV_BUFFER_SIZE];
-    size_t             recv_offset;
+    // Received bytes, parsed in place without shifting
+    NetRing            recv_ring;
+
+    // Packets the socket did not take yet, by reference (sent before
+    // anything new); a ring whose capacity is a power of two
+    NetSendEntry*      send_queue;
+    int                send_queue_capacity;
+    int                send_queue_head;
+    int                send_queue_count;
+    size_t             send_queued;     // Unsent bytes
+    bool               want_write;      // EPOLLOUT registered
+
+    // Requested chunks not sent yet (nearest to the player go first)
+    NetChunkCoord      chunk_queue[NET_CHUNK_QUEUE_MAX];
+    int                chunk_queue_count;
+
+    // UDP channel (player states), used once a UDP_HELLO confirmed the address
+    uint32_t           udp_token;
+    struct sockaddr_in udp_addr;
+    bool               udp_bound;
+    uint32_t           udp_sequence;    // Newest datagram received
+
+    // Newest snapshot the client received (delta baseline)
+    uint16_t           acked_snapshot;
+    bool               has_acked_snapshot;
+
+    // Snapshots as sent to this client (only players in its interest window),
+    // indexed by id % NET_SNAPSHOT_HISTORY
+    NetSnapshot        views[NET_SNAPSHOT_HISTORY];
+
+    // Chunks the client keeps loaded around its player (interest window)
+    int                view_distance;
+    int                load_ticket;     // Host world load ticket around the player (-1 = none)
+
+    // Animals in the last ENTITY_STATES sent, sorted by id
+    uint32_t*          entity_view;
+    int                entity_view_count;
+
+    // The client's inventory as the host validated it
+    Inventory          inventory;
+
+    // Blocks this client broke whose drops it has not claimed yet, oldest first
+    NetMinedBlock      mined[NET_MINED_BLOCKS_MAX];
+    int                mined_count;
 } NetClientSlot;
 
 // ============================================================================
@@ -182,12 +497,20 @@ typedef struct {
 
 typedef struct {
     int                listen_socket;
+    int                udp_socket;      // -1 = TCP only
     uint16_t           port;
     bool               running;
 
-    // Client management
-    NetClientSlot      clients[NET_MAX_CLIENTS];
+    int                epoll_fd;
+
+    // Client management (slots allocated on connect, NULL = free)
+    NetClientSlot*     clients[NET_MAX_CLIENTS];
     uint8_t            client_count;
+    uint8_t            scratch[NET_MAX_PACKET_SIZE];  // Packets split by a ring's end
+
+    // Free packet buffers by size class
+    NetPacketBuf*      packet_pool[NET_PACKET_CLASSES];
+    int                packet_pool_count[NET_PACKET_CLASSES];
 
     // Host info
     char               host_name[NET_PLAYER_NAME_MAX];
@@ -204,12 +527,69 @@ typedef struct {
 
     // Host's own state (client_id = 0)
     NetPlayerState     host_state;
+
+    // All players at the latest broadcast (each client is sent its own view)
+    NetSnapshot        snapshot;
+    uint16_t           snapshot_id;
+
+    // Animals found for one client's ENTITY_STATES
+    Entity*            entity_scratch[NET_ENTITY_VIEW_MAX];
+
+    // Block changes not sent yet (flushed once per update)
+    NetBlockBatch      block_batch;
+
+    // Chests changed since the last update
+    NetChestBatch      chest_batch;
 } NetServer;
 
 // ============================================================================
 // CLIENT
 // ============================================================================
 
+/**
+ * Local copy of a host animal
+ * The host runs its AI; the client moves it toward the last received
+ * position and only animates it.
+ */
+typedef struct {
+    uint32_t           id;              // Host's entity id (0 = free slot)
+    Entity*            entity;
+    Vector3            target;          // Latest received position
+    float              target_yaw;
+    uint16_t           seen;            // ENTITY_STATES that last listed it
+} NetEntityMirror;
+
+/**
+ * Simulated network conditions of a client's link (load tests)
+ * Every packet is held back latency_ms plus up to jitter_ms in each
+ * direction. Datagrams are dropped with probability loss; TCP packets are
+ * never dropped and keep their order, a late one delays those behind it.
+ */
+typedef struct {
+    int                latency_ms;      // One-way delay
+    int                jitter_ms;       // Random extra one-way delay (0..jitter_ms)
+    float              loss;            // Datagram loss per direction (0..1)
+} NetLinkConditions;
+
+// Packet held back by the simulated link (network.c)
+typedef struct NetDelayedPacket NetDelayedPacket;
+
+/**
+ * Bytes and packets through a client's sockets, headers included
+ */
+typedef struct {
+    uint64_t           bytes_sent;
+    uint64_t           bytes_received;
+    uint32_t           packets_sent;
+    uint32_t           packets_received;
+    uint32_t           packets_dropped;   // By the simulated link
+} NetTrafficStats;
+
+/**
+ * Called for every block change the host sends, after it is applied
+ */
+typedef void (*NetBlockChangeFunc)(void* user, const NetBlockChange* change);
+
 typedef struct {
     int                socket_fd;
     NetClientState     state;
@@ -220,11 +600,35 @@ typedef struct {
     uint8_t            recv_buffer[NET_RECV_BUFFER_SIZE];
     size_t             recv_offset;
 
+    // UDP channel (player states)
+    bool               use_udp;         // Try UDP at all (default true)
+    int                udp_socket;      // Connected to the host, -1 = TCP only
+    bool               udp_ready;       // Host confirmed our address
+    uint32_t           udp_token;       // From CONNECT_ACCEPT
+    int                udp_hello_count;
+    float              udp_hello_time;
+    uint32_t           udp_sequence;    // Newest datagram received
+    bool               has_udp_sequence;
+
+    // Received snapshots, indexed by id % NET_SNAPSHOT_HISTORY
+    NetSnapshot        snapshots[NET_SNAPSHOT_HISTORY];
+    uint16_t           last_snapshot;
+    bool               has_snapshot;
+
     // Remote player tracking
     NetPlayerState     remote_players[NET_MAX_CLIENTS];
-    bool               player_active[NET_MAX_CLIENTS];
+    NetInterpTrack     tracks[NET_MAX_CLIENTS];        // Snapshot states on the local clock
+    int32_t            clock_offset_ms;    // Local minus host clock (lowest seen delay)
+    bool               has_clock_offset;
+    bool               player_active[NET_MAX_CLIENTS];     // Connected (join/leave)
+    bool               player_in_view[NET_MAX_CLIENTS];    // In the latest snapshot
     char               player_names[NET_MAX_CLIENTS][NET_PLAYER_NAME_MAX];
 
+    // Host animals (open addressing on the host id)
+    NetEntityMirror    entity_mirrors[NET_ENTITY_MIRROR_SLOTS];
+    int                entity_mirror_count;
+    uint16_t           entity_states_seq;  // ENTITY_STATES received
+
     // Game state references
     World*             world;
     Player*            local_player;
@@ -240,6 +644,38 @@ typedef struct {
     float              last_heartbeat_received;
     uint32_t           send_sequence;
 
+    // Block changes not sent yet (flushed once per update)
+    NetBlockBatch      block_batch;
+
+    // Inventory as last sent to the host (prediction baseline), slots to
+    // send again whatever they hold, and records not sent yet
+    ItemStack          inventory_sent[NET_INVENTORY_SLOT_COUNT];
+    uint64_t           inventory_resend;
+    uint8_t            inventory_out[NET_INVENTORY_PAYLOAD_MAX];
+    size_t             inventory_out_size;
+
+    // Chunk streaming
+    NetChunkCoord      chunk_requests[NET_CHUNK_QUEUE_MAX];  // Not sent to the host yet
+    int                chunk_request_count;
+    uint8_t*           chunk_assembly;      // Fragments of the chunk being received
+    NetChunkCoord      chunk_assembly_coord;
+    uint32_t           chunk_assembly_size;
+    uint32_t           chunk_assembly_received;
+
+    // Simulated link (inactive while all zero), packets held back by it
+    NetLinkConditions  link;
+    uint32_t           link_random;
+    uint32_t           link_stream_due[2];  // Latest TCP release time (received, sent)
+    NetDelayedPacket** delayed;
+    int                delayed_count;
+    int                delayed_capacity;
+
+    NetTrafficStats    traffic;
+
+    // Block changes from the host (NULL = none)
+    NetBlockChangeFunc block_change_func;
+    void*              block_change_user;
+
     // Error handling
     char               error_message[128];
 } NetClient;
@@ -259,7 +695,7 @@ typedef struct NetworkContext {
 
     // Send rate limiting
     float              send_timer;
-    float              send_interval;   // Default 0.05 (20 Hz)
+    float              send_interval;   // Default 1/15 s (15 Hz)
 } NetworkContext;
 
 // ============================================================================
@@ -299,16 +735,36 @@ int net_server_poll(NetServer* server, int timeout_ms);
 void net_server_broadcast_states(NetServer* server);
 
 /**
- * Broadcast a block change to all clients
+ * Queue a block change for the clients that have its chunk loaded
  */
 void net_server_broadcast_block_change(NetServer* server, int x, int y, int z,
                                         uint8_t block_type, uint8_t metadata);
 
+/**
+ * Send the queued block changes, one BLOCK_CHANGES packet per client
+ */
+void net_server_flush_block_changes(NetServer* server);
+
+/**
+ * Send the slots of the chests changed this update to the clients that see them
+ */
+void net_server_flush_inventory(NetServer* server);
+
 /**
  * Broadcast time synchronization
  */
 void net_server_broadcast_time(NetServer* server);
 
+/**
+ * Send each client the animals near its player
+ */
+void net_server_broadcast_entities(NetServer* server);
+
+/**
+ * Send requested chunks to clients, nearest to each player first
+ */
+void net_server_stream_chunks(NetServer* server);
+
 /**
  * Get number of connected clients (not including host)
  */
@@ -350,11 +806,52 @@ int net_client_poll(NetClient* client, int timeout_ms);
 void net_client_send_player_state(NetClient* client);
 
 /**
- * Request a block change (server validates and broadcasts)
+ * Queue a block change request (server validates and broadcasts)
  */
 void net_client_send_block_change(NetClient* client, int x, int y, int z,
                                    uint8_t block_type, uint8_t metadata);
 
+/**
+ * Send the queued block change requests in one BLOCK_CHANGES packet
+ */
+void net_client_flush_block_changes(NetClient* client);
+
+/**
+ * Send the inventory slots changed since the last flush with the queued
+ * crafting and chest actions, in one INVENTORY_SYNC packet
+ */
+void net_client_flush_inventory(NetClient* client);
+
+/**
+ * Ask the host for the contents of a chest the player opened
+ */
+void net_client_open_chest(NetClient* client, int x, int y, int z);
+
+/**
+ * Tell the host a copied entity was hit (the host applies the damage)
+ */
+void net_client_send_entity_hit(NetClient* client, const Entity* entity, uint8_t damage);
+
+/**
+ * Move copied host animals toward their received positions
+ */
+void net_client_update_entities(NetClient* client, float dt);
+
+/**
+ * Send queued chunk requests to the server
+ */
+void net_client_flush_chunk_requests(NetClient* client);
+
+/**
+ * Simulate latency, jitter and loss on the client's link (NULL = none)
+ */
+void net_client_set_link(NetClient* client, const NetLinkConditions* link);
+
+/**
+ * Report the host's block changes to func (NULL = stop)
+ */
+void net_client_set_block_change_func(NetClient* client, NetBlockChangeFunc func, void* user);
+
 /**
  * Get client connection state
  */
@@ -404,11 +901,21 @@ void network_disconnect(NetworkContext* ctx);
 void network_update(NetworkContext* ctx, float dt);
 
 /**
- * Broadcast a block change
+ * Broadcast a block change (sent with the others of this update)
  */
 void network_broadcast_block_change(NetworkContext* ctx, int x, int y, int z,
                                      uint8_t block_type, uint8_t metadata);
 
+/**
+ * Fetch the host's contents of an opened chest (no-op unless connected to a host)
+ */
+void network_open_chest(NetworkContext* ctx, int x, int y, int z);
+
+/**
+ * Report a hit on an entity to the host (no-op unless it is a host copy)
+ */
+void network_entity_hit(NetworkContext* ctx, const Entity* entity, uint8_t damage);
+
 /**
  * Update remote player entities for rendering
  */
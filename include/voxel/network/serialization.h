@@ -17,6 +17,7 @@ void ser_write_u32(uint8_t** buf, uint32_t val);
 void ser_write_i32(uint8_t** buf, int32_t val);
 void ser_write_f32(uint8_t** buf, float val);
 void ser_write_string(uint8_t** buf, const char* str, size_t max_len);
+void ser_write_bytes(uint8_t** buf, const void* data, size_t size);  // Bulk copy, no byte order change
 
 // Read functions - advance buffer pointer after reading
 uint8_t ser_read_u8(const uint8_t** buf);
@@ -25,5 +26,6 @@ uint32_t ser_read_u32(const uint8_t** buf);
 int32_t ser_read_i32(const uint8_t** buf);
 float ser_read_f32(const uint8_t** buf);
 void ser_read_string(const uint8_t** buf, char* out, size_t max_len);
+void ser_read_bytes(const uint8_t** buf, void* out, size_t size);
 
 #endif // SERIALIZATION_H
@@ -0,0 +1,97 @@
+/**
+ * Flythrough - Scripted camera path for end-to-end frame benchmarks
+ *
+ * Replaces player input with a fixed script of segments: standing, a
+ * sprint along the ground, turning on the spot, taking off and cruising,
+ * sweeping turns, fast high flight and a descent. The path advances by a
+ * fixed step per frame rather than by frame time, so every run renders the
+ * same sequence of views whatever the machine; only how long the frames
+ * take differs.
+ *
+ * Every frame's timings and streaming counters are recorded. At the end a
+ * JSON summary (overall and per segment) and a CSV of all frames are
+ * written for comparing settings, machines and releases.
+ */
+
+#ifndef VOXEL_FLYTHROUGH_H
+#define VOXEL_FLYTHROUGH_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct World World;
+typedef struct Player Player;
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define FLYTHROUGH_SEED 20240601u           // World seed of every benchmark run
+#define FLYTHROUGH_STEP (1.0f / 60.0f)      // Scripted seconds per frame
+#define FLYTHROUGH_HEIGHT_EASE 3.0f         // Rate the camera eases toward its target height (1/s)
+#define FLYTHROUGH_PITCH_EASE 2.0f          // Rate the view eases toward its target pitch (1/s)
+#define FLYTHROUGH_REPORT_PATH "flythrough_report.json"
+#define FLYTHROUGH_FRAMES_PATH "flythrough_frames.csv"
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+/**
+ * Measurements of one frame
+ */
+typedef struct FlythroughFrame {
+    int segment;
+    float frame_ms;             // Wall time of the frame (GetFrameTime)
+    float busy_ms;              // Update, ticks and draw, without waiting for the swap
+    float world_update_ms;
+    int uploads;                // Chunk meshes uploaded
+    size_t upload_bytes;
+    int batch_rebuilds;
+    int draw_calls;             // Chunk, batch, LOD and pool draws
+    int chunks_loaded;
+} FlythroughFrame;
+
+typedef struct Flythrough {
+    int segment;                // Current script segment (== count when finished)
+    float segment_time;         // Seconds into the segment
+    Vector3 position;           // Feet position
+    float yaw;                  // Degrees, as Player
+    float pitch;
+    FlythroughFrame* frames;
+    int frame_count;
+    int frame_capacity;
+    size_t peak_gpu_bytes;      // Chunk geometry buffers
+    long peak_rss_kb;           // Resident set high-water mark (0 = unknown)
+} Flythrough;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * Start the script at position (feet), facing yaw 0
+ */
+void flythrough_init(Flythrough* fly, Vector3 start);
+
+void flythrough_destroy(Flythrough* fly);
+
+/**
+ * Advance one FLYTHROUGH_STEP and place the player (flying, no collision)
+ * Returns false once the script has finished
+ */
+bool flythrough_step(Flythrough* fly, Player* player, World* world);
+
+/**
+ * Record the frame just finished; also samples the memory peaks
+ */
+void flythrough_record(Flythrough* fly, const FlythroughFrame* frame);
+
+/**
+ * Write the summary to report_path (NULL: FLYTHROUGH_REPORT_PATH) and
+ * every frame to FLYTHROUGH_FRAMES_PATH
+ */
+void flythrough_write_report(const Flythrough* fly, const char* report_path, World* world);
+
+#endif // VOXEL_FLYTHROUGH_H
@@ -101,6 +101,12 @@ void player_update_physics(Player* player, World* world, float dt);
  */
 void player_set_position(Player* player, Vector3 position);
 
+/**
+ * Place the player and point the camera (scripted cameras; no collision)
+ * yaw and pitch in degrees
+ */
+void player_set_view(Player* player, Vector3 position, float yaw, float pitch);
+
 /**
  * Toggle flying mode
  */
@@ -1,8 +1,17 @@
 /**
  * Chunk Batcher - Combines multiple chunks into single draw calls
  *
- * Reduces draw calls by merging 2x2 chunk groups into single meshes.
- * At view distance 8: ~289 chunks → ~72 batched meshes (75% reduction)
+ * Batches form a quadtree over the 8x8-chunk mesh cells: a level-k batch
+ * merges 2^k x 2^k chunks (2x2, 4x4 or 8x8). Every frame the batcher walks
+ * the tree around the player and picks the level by distance: the chunks
+ * next to the player are drawn on their own, then 2x2, 4x4 and 8x8 batches
+ * further out. Edits near the player therefore rebuild nothing, and the
+ * draw count stays about the same as the view distance grows. A batch that
+ * keeps getting edited is split into its children until it calms down.
+ *
+ * Only selected batches are rebuilt, nearest and most edited first; a
+ * batch that is not built yet is drawn as its built children or single
+ * chunks. Batches that have not been selected for a while drop their meshes.
  */
 
 #ifndef VOXEL_CHUNK_BATCHER_H
@@ -14,35 +23,65 @@
 
 // Forward declarations
 typedef struct World World;
+typedef struct UploadBudget UploadBudget;
 
 // ============================================================================
 // CONFIGURATION
 // ============================================================================
 
-#define BATCH_SIZE 2              // 2x2 chunks per batch
-#define BATCH_MAX_COUNT 512       // Max batches (supports up to 2048 chunks)
+#define BATCH_LEVELS 3               // Merged levels: 2x2, 4x4 and 8x8 chunks
+#define BATCH_MAX_SPAN (1 << BATCH_LEVELS)  // Chunks per side of the largest batch
+#define BATCH_RING_SINGLE 1          // Chebyshev chunk distance drawn as single chunks
+#define BATCH_RING_2X2 4             // ... as 2x2 batches
+#define BATCH_RING_4X4 10            // ... as 4x4 batches, 8x8 beyond
+#define BATCH_BUCKETS 1024           // Batch hash map buckets
 #define BATCH_REBUILDS_PER_FRAME 16  // Max batches to rebuild each frame
+#define BATCH_SPLICE_SLACK 1536      // Spare vertices per chunk in a batch for in-place section splices
+#define BATCH_HOT_EDITS 3.0f         // Recent edits that split a batch into its children
+#define BATCH_EDIT_DECAY 0.99f       // Per-frame decay of a batch's recent edits
+#define BATCH_KEEP_FRAMES 300        // Frames an unselected batch keeps its meshes
+
+_Static_assert(BATCH_MAX_SPAN == CHUNK_MESH_CELL_CHUNKS, "Batches are copied from chunk meshes in cell space");
 
 // ============================================================================
 // DATA STRUCTURES
 // ============================================================================
 
 /**
- * A batch combines 2x2 chunks into a single mesh for fewer draw calls
+ * Vertex range reserved for one chunk inside a combined batch mesh
+ */
+typedef struct BatchSlotRange {
+    int offset;                     // First vertex of the chunk
+    int count;                      // Vertices in use
+    int capacity;                   // Reserved vertices (unused tail is degenerate padding)
+} BatchSlotRange;
+
+/**
+ * A batch combines span x span chunks (span = 2^level) into a single mesh
+ * Per-chunk arrays are indexed z * span + x within the batch
  */
 typedef struct ChunkBatch {
-    int batch_x, batch_z;           // Batch coordinates (chunk coords / 2)
-    Mesh opaque_mesh;               // Combined opaque mesh for all 4 chunks
-    Mesh transparent_mesh;          // Combined transparent mesh
+    int level;                      // 1..BATCH_LEVELS
+    int batch_x, batch_z;           // Batch coordinates (chunk coords / span)
+    ChunkMesh opaque_mesh;          // Combined opaque mesh for all chunks
+    ChunkMesh transparent_mesh;     // Combined transparent mesh
     bool opaque_valid;              // Opaque mesh uploaded to GPU
     bool transparent_valid;         // Transparent mesh uploaded to GPU
+    bool built;                     // Meshes assembled since the batch was created or evicted
     bool dirty;                     // Needs rebuild
-    Chunk* chunks[BATCH_SIZE][BATCH_SIZE];  // References to chunks (may be NULL)
+    Chunk** chunks;                 // References to chunks (may be NULL)
     int chunk_count;                // Number of non-NULL chunks
+    BatchSlotRange* opaque_slots;       // Chunk ranges in opaque_mesh
+    BatchSlotRange* transparent_slots;  // Chunk ranges in transparent_mesh
+    float recent_edits;             // Section edits, decaying by BATCH_EDIT_DECAY per frame
+    unsigned int wanted_frame;      // Last frame the batch was selected at its own level
+    unsigned int used_frame;        // Last frame the batch was selected or drawn in place of a parent
+    int sort_rank;                  // Position in the last transparent draw order
+    unsigned int sort_pass;         // Transparent pass sort_rank belongs to
 } ChunkBatch;
 
 /**
- * Hash map node for batch lookup
+ * Hash map node for batch lookup; the per-chunk arrays follow it
  */
 typedef struct BatchNode {
     ChunkBatch batch;
@@ -66,11 +105,18 @@ typedef struct SortEntry {
  * Chunk batcher system
  */
 typedef struct ChunkBatcher {
-    BatchNode* buckets[BATCH_MAX_COUNT];
+    BatchNode* buckets[BATCH_BUCKETS];
     int batch_count;
     int dirty_count;                // Number of batches needing rebuild
+    unsigned int frame;             // Selections so far
+    SortEntry* draws;               // This frame's selection; the rebuild queue during update
+    int draw_count;
+    int draw_capacity;
     SortEntry* sort_buffer;         // Pre-allocated buffer for transparent sorting
+    SortEntry* sort_scratch;        // Last order restore slots (sort_buffer_capacity entries)
     int sort_buffer_capacity;       // Size of sort buffer
+    int sort_count;                 // Entries drawn by the last transparent pass
+    unsigned int sort_pass;         // Transparent passes so far
 } ChunkBatcher;
 
 // ============================================================================
@@ -88,55 +134,68 @@ ChunkBatcher* chunk_batcher_create(void);
 void chunk_batcher_destroy(ChunkBatcher* batcher);
 
 /**
- * Get or create batch for a chunk at given chunk coordinates
- * Returns the batch that contains this chunk
+ * Get or create the level's batch containing a chunk (NULL on OOM)
  */
-ChunkBatch* chunk_batcher_get_batch(ChunkBatcher* batcher, int chunk_x, int chunk_z);
+ChunkBatch* chunk_batcher_get_batch(ChunkBatcher* batcher, int level, int chunk_x, int chunk_z);
 
 /**
- * Register a chunk with its batch
+ * Register a chunk with its batches
  * Call this when a chunk is created/loaded
  */
 void chunk_batcher_register_chunk(ChunkBatcher* batcher, Chunk* chunk);
 
 /**
- * Unregister a chunk from its batch
+ * Unregister a chunk from its batches
  * Call this when a chunk is destroyed/unloaded
  */
 void chunk_batcher_unregister_chunk(ChunkBatcher* batcher, Chunk* chunk);
 
 /**
- * Mark the batch containing this chunk as needing rebuild
+ * Mark the batches containing this chunk as needing rebuild
  * Call this when a chunk's mesh changes
  */
 void chunk_batcher_invalidate(ChunkBatcher* batcher, int chunk_x, int chunk_z);
 
 /**
- * Rebuild dirty batches (call once per frame)
+ * Patch a chunk's partially remeshed sections into its built batches in place
+ * Uses the range recorded in chunk->mesh_ranges / transparent_ranges and
+ * counts as an edit of those batches.
+ * Returns false if the batches must be rebuilt instead (capacity exceeded,
+ * mesh appeared or vanished); the caller should then invalidate them
+ */
+bool chunk_batcher_splice_chunk(ChunkBatcher* batcher, Chunk* chunk);
+
+/**
+ * Rebuild dirty batches selected by the last render, nearest and most
+ * edited first, and drop meshes unused for BATCH_KEEP_FRAMES (call once per frame)
  * @param max_rebuilds Maximum batches to rebuild per frame (0 = use default)
+ * @param budget Bytes copied per frame, shared with mesh uploads (NULL = count only)
+ * @return Number of batches rebuilt
  */
-void chunk_batcher_update(ChunkBatcher* batcher, int max_rebuilds);
+int chunk_batcher_update(ChunkBatcher* batcher, World* world, int max_rebuilds, UploadBudget* budget);
 
 /**
- * Render all batched opaque meshes
- * camera_pos and center_chunk for frustum/distance culling
+ * Select this frame's batches and single chunks around the world's center,
+ * then render their opaque meshes
+ * Entries are skipped when none of their chunks pass world->culler
  */
 void chunk_batcher_render_opaque(ChunkBatcher* batcher, World* world,
                                   Material material, Vector3 camera_pos);
 
 /**
- * Render all batched transparent meshes (call after opaque, sorted back-to-front)
+ * Render the selection's transparent meshes (call after opaque, sorted back-to-front)
  */
 void chunk_batcher_render_transparent(ChunkBatcher* batcher, World* world,
                                        Material material, Vector3 camera_pos);
 
 /**
- * Get batch coordinates from chunk coordinates
+ * Level a batch should be drawn at for its Chebyshev chunk distance (0 = single chunks)
  */
-static inline void chunk_to_batch_coords(int chunk_x, int chunk_z, int* batch_x, int* batch_z) {
-    // Use floor division to handle negative coordinates correctly
-    *batch_x = (chunk_x >= 0) ? (chunk_x / BATCH_SIZE) : ((chunk_x - BATCH_SIZE + 1) / BATCH_SIZE);
-    *batch_z = (chunk_z >= 0) ? (chunk_z / BATCH_SIZE) : ((chunk_z - BATCH_SIZE + 1) / BATCH_SIZE);
+static inline int chunk_batch_ring_level(int dist) {
+    if (dist <= BATCH_RING_SINGLE) return 0;
+    if (dist <= BATCH_RING_2X2) return 1;
+    if (dist <= BATCH_RING_4X4) return 2;
+    return BATCH_LEVELS;
 }
 
 #endif // VOXEL_CHUNK_BATCHER_H
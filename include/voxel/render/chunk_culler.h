@@ -0,0 +1,110 @@
+/**
+ * Chunk Culler - View frustum and cave occlusion culling
+ *
+ * Once per frame the culler walks outward from the camera's section,
+ * section by section, only crossing from one face to another when the
+ * section's connectivity (chunk->section_visibility) says they see each
+ * other, never turning back toward the camera, and never leaving the
+ * view frustum. Renderers then draw only the sections that were reached.
+ */
+
+#ifndef VOXEL_CHUNK_CULLER_H
+#define VOXEL_CHUNK_CULLER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <raylib.h>
+#include "voxel/world/chunk.h"
+
+// Forward declarations
+typedef struct World World;
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+/**
+ * View frustum planes (a, b, c, d): visible points satisfy ax + by + cz + d >= 0
+ */
+typedef struct Frustum {
+    Vector4 planes[6];
+} Frustum;
+
+/**
+ * Section waiting in the visibility walk
+ */
+typedef struct CullNode {
+    int column;             // Index into the culler window
+    uint8_t section;        // Section y (0-15)
+    uint8_t entry_face;     // Face the walk came in through (6 = start section)
+    uint8_t directions;     // BlockFace bits of every step taken so far
+} CullNode;
+
+/**
+ * Per-frame visible section masks over the square view window
+ */
+typedef struct ChunkCuller {
+    Frustum frustum;
+    int center_x, center_z;     // Window center chunk
+    int radius;                 // Window half size in chunks
+    int size;                   // 2 * radius + 1
+    int capacity;               // Allocated columns
+    Chunk** columns;            // Loaded chunk per column (NULL = not loaded)
+    uint16_t* visible;          // Visible section mask per column
+    uint16_t* visited;          // Sections already reached this frame
+    CullNode* queue;            // Walk queue (capacity * CHUNK_SECTION_COUNT)
+    bool occlusion;             // Cave culling enabled (false = frustum only)
+    int visible_sections;       // Sections reached last frame (stats)
+} ChunkCuller;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * Frustum planes of a view * projection matrix
+ */
+Frustum frustum_from_matrix(Matrix m);
+
+/**
+ * Check an axis aligned box against frustum planes
+ */
+bool frustum_box_visible(const Frustum* f, Vector3 min, Vector3 max);
+
+/**
+ * Create a culler (CPU only)
+ */
+ChunkCuller* chunk_culler_create(void);
+
+/**
+ * Destroy the culler
+ */
+void chunk_culler_destroy(ChunkCuller* culler);
+
+/**
+ * Recompute visibility for this frame
+ * Call inside BeginMode3D: the frustum comes from rlgl's current matrices
+ */
+void chunk_culler_update(ChunkCuller* culler, World* world, Vector3 camera_pos);
+
+/**
+ * Visible section mask of a chunk (0 = skip, all bits outside the window)
+ */
+uint16_t chunk_culler_sections(const ChunkCuller* culler, int chunk_x, int chunk_z);
+
+/**
+ * Clear a chunk's visible sections for this frame (drawn by something else)
+ */
+void chunk_culler_hide_chunk(ChunkCuller* culler, int chunk_x, int chunk_z);
+
+/**
+ * Check an axis aligned box against the frustum
+ */
+bool chunk_culler_box_visible(const ChunkCuller* culler, Vector3 min, Vector3 max);
+
+/**
+ * Frustum test on a chunk's occupied height range (min_block_y/max_block_y)
+ */
+bool chunk_culler_chunk_visible(const ChunkCuller* culler, const Chunk* chunk);
+
+#endif // VOXEL_CHUNK_CULLER_H
@@ -0,0 +1,193 @@
+/**
+ * Chunk LOD - Merged low-detail meshes for distant chunks
+ *
+ * Past the full-detail ring, chunks are drawn as LOD regions: a region of
+ * level k covers 2^k x 2^k chunks with one mesh of 2^k-block cells, built
+ * from the chunks' LOD cells (chunk_build_lod_cells). Every level has
+ * 16 x 16 cell columns per region, so a region costs about as much as one
+ * chunk no matter how much ground it covers. Level-1 regions are the
+ * batcher's 2x2 groups; each coarser level merges four regions of the
+ * level below.
+ *
+ * Rings: chunks within the LOD distance are full detail, then level 1 up
+ * to twice the distance, level 2 up to three times, level 3 beyond. The
+ * choice is a quadtree walk from the level-3 regions down, so regions
+ * never overlap; a region whose mesh is not built yet is replaced by its
+ * four children. Region borders always emit their outer faces (skirts),
+ * which closes the cracks between neighbors of different levels.
+ */
+
+#ifndef VOXEL_CHUNK_LOD_H
+#define VOXEL_CHUNK_LOD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <raylib.h>
+#include "voxel/world/chunk.h"
+#include "voxel/render/chunk_mesh.h"
+
+// Forward declarations
+typedef struct World World;
+typedef struct ChunkCuller ChunkCuller;
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define LOD_REGION_CELLS 16            // Cell columns per region side at every level
+#define LOD_REGION_BUCKETS 1024        // Region hash map buckets
+#define LOD_REGION_KEEP_FRAMES 600     // Frames an unused region mesh is kept (walking back and forth)
+#define LOD_CELL_BUILDS_PER_FRAME 8    // Chunk LOD cell rebuilds per frame
+#define LOD_MESH_BUILDS_PER_FRAME 2    // Region meshes built per frame
+#define LOD_DEMOTE_MARGIN 2            // Rings past full detail before a chunk's full mesh is dropped
+
+#define LOD_TYPE_SOLID 0x01            // type_flags: meshed at all (block_is_solid)
+#define LOD_TYPE_TRANSPARENT 0x02      // type_flags: transparent pass, does not hide neighbors
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+/**
+ * Merged mesh of one region at one level
+ */
+typedef struct LodRegion {
+    int level;                      // 1-3: cells of 2^level blocks
+    int region_x, region_z;         // Chunk coordinates >> level
+    ChunkMesh opaque_mesh;          // Vertices in region space (0 - 16 * 2^level in x/z)
+    ChunkMesh transparent_mesh;
+    bool built;                     // Meshes exist (possibly stale)
+    uint32_t children_hash;         // Child lod_version hash at the last build
+    int min_y, max_y;               // Occupied block rows (frustum test)
+    int last_used;                  // Frame the selection last reached this region
+    int drawn_frame;                // Frame the region was last selected for drawing
+    struct LodRegion* next;         // Bucket chain
+} LodRegion;
+
+/**
+ * Region that needs a (re)build, with its distance for ordering
+ */
+typedef struct LodBuildEntry {
+    LodRegion* region;
+    int dist;
+} LodBuildEntry;
+
+/**
+ * Region ordered for back-to-front transparent drawing
+ */
+typedef struct LodSortEntry {
+    LodRegion* region;
+    float dist_sq;
+} LodSortEntry;
+
+/**
+ * LOD region cache, per-frame selection and scratch buffers
+ */
+typedef struct ChunkLod {
+    LodRegion* buckets[LOD_REGION_BUCKETS];
+    int region_count;
+    int distance;                   // Full-detail ring in chunks
+    int frame;
+
+    LodRegion** draw_list;          // Regions selected this frame
+    int draw_count;
+    int draw_capacity;
+    LodBuildEntry* builds;          // Stale regions reached this frame
+    int build_count;
+    int build_capacity;
+    LodSortEntry* sort_buffer;      // Transparent draw order (draw_capacity entries)
+
+    uint8_t* volume_types;          // Region cell volume (16 x 128 x 16 at most)
+    uint8_t* volume_light;
+    ChunkVertex* vertices;          // Mesh scratch (grows)
+    int vertex_capacity;
+    uint8_t type_flags[256];        // LOD_TYPE_* per BlockType
+    size_t tracked_bytes;           // Heap counted in MEMORY_LOD
+} ChunkLod;
+
+// ============================================================================
+// RINGS
+// ============================================================================
+
+/**
+ * LOD level for a Chebyshev chunk distance (0 = full detail)
+ */
+static inline int chunk_lod_ring_level(int dist, int lod_distance) {
+    if (dist <= lod_distance) return 0;
+    int level = (dist - 1) / lod_distance;
+    return level < CHUNK_LOD_LEVELS ? level : CHUNK_LOD_LEVELS;
+}
+
+/**
+ * Region coordinate of a chunk coordinate at level (floor division by 2^level)
+ */
+static inline int chunk_lod_region_coord(int chunk, int level) {
+    return chunk >= 0 ? chunk >> level : -((-chunk - 1) >> level) - 1;
+}
+
+/**
+ * Chebyshev distance from the center chunk to the nearest chunk of a region
+ */
+static inline int chunk_lod_region_distance(int center_x, int center_z, int level, int region_x, int region_z) {
+    int span = 1 << level;
+    int x0 = region_x * span, z0 = region_z * span;
+    int dx = center_x < x0 ? x0 - center_x : (center_x >= x0 + span ? center_x - (x0 + span - 1) : 0);
+    int dz = center_z < z0 ? z0 - center_z : (center_z >= z0 + span ? center_z - (z0 + span - 1) : 0);
+    return dx > dz ? dx : dz;
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * Create the LOD system (main thread, GL context required for drawing)
+ */
+ChunkLod* chunk_lod_create(int lod_distance);
+
+/**
+ * Destroy all region meshes and scratch buffers
+ */
+void chunk_lod_destroy(ChunkLod* lod);
+
+/**
+ * Set the full-detail ring (chunks); the LOD rings scale with it
+ */
+void chunk_lod_set_distance(ChunkLod* lod, int lod_distance);
+
+/**
+ * Whether a chunk needs its full-detail mesh around the given center
+ * Decided per level-1 region so batches switch as a whole; margin widens
+ * the ring (hysteresis before dropping a mesh)
+ */
+bool chunk_lod_full_detail(const ChunkLod* lod, int center_x, int center_z,
+                           int chunk_x, int chunk_z, int margin);
+
+/**
+ * Whether a region drawn last frame covers the chunk
+ */
+bool chunk_lod_covers(const ChunkLod* lod, int chunk_x, int chunk_z);
+
+/**
+ * Select the regions to draw around world's center and build a few stale
+ * ones (call once per frame from world_update)
+ */
+void chunk_lod_update(ChunkLod* lod, World* world);
+
+/**
+ * Hide chunks covered by selected regions from this frame's culling result,
+ * so the batcher or pool does not draw them a second time
+ */
+void chunk_lod_hide_covered(const ChunkLod* lod, ChunkCuller* culler);
+
+/**
+ * Draw the selected regions' opaque meshes (frustum culled)
+ */
+void chunk_lod_render_opaque(ChunkLod* lod, World* world, Material material);
+
+/**
+ * Draw the selected regions' transparent meshes, farthest first
+ */
+void chunk_lod_render_transparent(ChunkLod* lod, World* world, Material material, Vector3 camera_pos);
+
+#endif // VOXEL_CHUNK_LOD_H
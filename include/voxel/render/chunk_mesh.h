@@ -0,0 +1,172 @@
+/**
+ * Chunk Mesh - Packed vertex format for chunk geometry
+ *
+ * Every chunk vertex is 8 bytes: position in mesh space, face id, atlas
+ * tile, light level and AO. block.vs decodes it; normals, UVs and vertex
+ * brightness are derived in the shader. Chunk, LOD and batch meshes all
+ * use this format, so batches are built with plain vertex copies.
+ *
+ * Meshes hold 4 corner vertices per quad and are drawn through one shared
+ * static index buffer (6 indices per quad) that grows to the largest mesh.
+ *
+ * Vertices live on the GPU only. Chunk meshes are positioned relative to
+ * the corner of their 8x8 cell of chunks (the largest batch), so batches of
+ * every size and the pool arena are assembled by copying between buffers
+ * on the GPU.
+ */
+
+#ifndef VOXEL_CHUNK_MESH_H
+#define VOXEL_CHUNK_MESH_H
+
+#include <raylib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "voxel/core/texture_atlas.h"
+#include "voxel/core/memory.h"
+
+// ============================================================================
+// VERTEX FORMAT
+// ============================================================================
+
+#define CHUNK_VERTEX_ATTRIB_POSITION 0  // Shader location of (x, y, z, face|y_hi)
+#define CHUNK_VERTEX_ATTRIB_SURFACE 1   // Shader location of (tile_x, tile_y, light|ao, unused)
+#define CHUNK_VERTEX_ATTRIB_ORIGIN 2    // Shader location of the per-draw chunk origin (generic value unless instanced)
+#define CHUNK_VERTEX_Y_HIGH_BIT 0x08    // face byte: set when y == 256 (top of the world)
+
+#define CHUNK_QUAD_VERTICES 4           // Corners v1..v4 per quad
+#define CHUNK_QUAD_INDICES 6            // Triangles (v1, v2, v3), (v1, v3, v4)
+#define CHUNK_QUAD_INDEX_INITIAL 65536  // Quads covered by the first shared index buffer
+#define CHUNK_MESH_CELL_CHUNKS 8        // Chunk meshes share a vertex space with their 8x8 cell
+
+/**
+ * Packed chunk vertex (8 bytes)
+ * x/z cover an 8x8 chunk cell (0-128), y covers 0-256 with the high bit in face
+ */
+typedef struct ChunkVertex {
+    uint8_t x;
+    uint8_t y;          // Low 8 bits of y
+    uint8_t z;
+    uint8_t face;       // BlockFace (bits 0-2), CHUNK_VERTEX_Y_HIGH_BIT
+    uint8_t tile_x;     // Atlas tile column
+    uint8_t tile_y;     // Atlas tile row
+    uint8_t light;      // Light level 0-15 (bits 0-3), AO level 0-3 (bits 4-5)
+    uint8_t reserved;
+} ChunkVertex;
+
+_Static_assert(sizeof(ChunkVertex) == 8, "ChunkVertex must stay 8 bytes");
+
+static inline ChunkVertex chunk_vertex_pack(int x, int y, int z, BlockFace face, AtlasTile tile,
+                                            uint8_t light_level, uint8_t ao_level) {
+    ChunkVertex v;
+    v.x = (uint8_t)x;
+    v.y = (uint8_t)(y & 0xFF);
+    v.z = (uint8_t)z;
+    v.face = (uint8_t)((face & 0x07) | (y > 0xFF ? CHUNK_VERTEX_Y_HIGH_BIT : 0));
+    v.tile_x = tile.x;
+    v.tile_y = tile.y;
+    v.light = (uint8_t)((light_level & 0x0F) | ((ao_level & 0x03) << 4));
+    v.reserved = 0;
+    return v;
+}
+
+// ============================================================================
+// GPU MESH
+// ============================================================================
+
+/**
+ * Chunk geometry in GPU buffers (no CPU copy is kept)
+ */
+typedef struct ChunkMesh {
+    int vertex_count;
+    unsigned int vao_id;        // 0 = not uploaded
+    unsigned int vbo_id;
+    uint8_t memory_category;    // MemoryCategory the buffer is counted in
+} ChunkMesh;
+
+/**
+ * Create the mesh's buffers and fill them with vertices (main thread)
+ * The caller keeps ownership of vertices and may free them right after.
+ * vertices may be NULL to leave the contents undefined (written later with
+ * chunk_mesh_write or chunk_mesh_copy).
+ * dynamic: buffer will be patched after creation
+ * category: GPU memory category the buffer counts toward (memory.h)
+ */
+bool chunk_mesh_upload(ChunkMesh* mesh, const ChunkVertex* vertices, int vertex_count, bool dynamic,
+                       MemoryCategory category);
+
+/**
+ * Overwrite count vertices starting at first
+ */
+void chunk_mesh_write(ChunkMesh* mesh, int first, const ChunkVertex* vertices, int count);
+
+/**
+ * Zero count vertices starting at first (degenerate quads)
+ */
+void chunk_mesh_clear(ChunkMesh* mesh, int first, int count);
+
+/**
+ * Copy count vertices of a mesh into a vertex buffer on the GPU
+ * dst_buffer is another mesh's vbo_id or an arena; dst_first counts vertices
+ */
+void chunk_mesh_copy(unsigned int dst_buffer, int dst_first, const ChunkMesh* src, int src_first, int count);
+
+/**
+ * Free GPU buffers, leaving the mesh zeroed
+ */
+void chunk_mesh_unload(ChunkMesh* mesh);
+
+/**
+ * Bind the block shader and the atlas once for a pass of chunk draws
+ * Camera, fog and light come from the frame uniform buffer (frame_uniforms.h)
+ */
+void chunk_mesh_begin(Material material);
+void chunk_mesh_end(void);
+
+/**
+ * Draw a mesh whose vertices are relative to origin (between begin and end)
+ * Only the origin attribute changes per draw; grows the shared quad index
+ * buffer if the mesh is larger than any before
+ */
+void chunk_mesh_draw(const ChunkMesh* mesh, Vector3 origin);
+
+/**
+ * Shared quad index buffer covering at least quads quads (0 on failure)
+ * The id changes when the buffer grows, so bind it again for every draw
+ */
+unsigned int chunk_mesh_quad_indices(int quads);
+
+/**
+ * Free the shared quad index buffer (at shutdown, after all meshes)
+ */
+void chunk_mesh_release_shared(void);
+
+// ============================================================================
+// STATISTICS
+// ============================================================================
+
+/**
+ * Chunk geometry counters (main thread)
+ */
+typedef struct ChunkMeshStats {
+    int draw_calls;             // Since the last chunk_mesh_reset_draw_calls
+    size_t gpu_bytes;           // Tracked GPU memory of all categories (memory.h)
+} ChunkMeshStats;
+
+ChunkMeshStats chunk_mesh_get_stats(void);
+
+void chunk_mesh_reset_draw_calls(void);
+
+/**
+ * Count draws issued without chunk_mesh_draw (the pool's multi-draw)
+ */
+void chunk_mesh_count_draws(int draws);
+
+/**
+ * Check if the mesh has GPU buffers
+ */
+static inline bool chunk_mesh_uploaded(const ChunkMesh* mesh) {
+    return mesh->vao_id != 0;
+}
+
+#endif // VOXEL_CHUNK_MESH_H
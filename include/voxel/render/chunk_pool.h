@@ -0,0 +1,177 @@
+/**
+ * Chunk Pool - One vertex arena for every chunk mesh, drawn with multi-draw indirect
+ *
+ * All chunk meshes live in a single large vertex buffer, filled by GPU
+ * copies from the chunks' own buffers. Each chunk owns one slot per pass,
+ * and a pass is drawn with one glMultiDrawElementsIndirect call whose
+ * per-draw chunk origins come from an instanced vertex attribute.
+ * Rewriting a chunk only touches its slot.
+ *
+ * Requires GL 4.3; chunk_pool_create returns NULL otherwise and the world
+ * keeps using the ChunkBatcher.
+ */
+
+#ifndef VOXEL_CHUNK_POOL_H
+#define VOXEL_CHUNK_POOL_H
+
+#include <stdbool.h>
+#include <raylib.h>
+#include "voxel/world/chunk.h"
+
+// Forward declarations
+typedef struct World World;
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define CHUNK_POOL_VERTICES (8 * 1024 * 1024)  // Arena size (8M vertices = 64 MB)
+#define CHUNK_POOL_SLACK 1536                  // Spare vertices per slot for in-place section splices
+#define CHUNK_POOL_BUCKETS 1024                // Slot hash map buckets
+#define CHUNK_POOL_FENCES 4                    // Frames tracked for deferred slot reuse
+#define CHUNK_POOL_MAX_RUNS (CHUNK_SECTION_COUNT / 2)  // Most draws per slot (alternating visible sections)
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+/**
+ * Vertex range inside the arena
+ */
+typedef struct PoolRange {
+    int offset;                     // First vertex
+    int count;                      // Vertices in use
+    int capacity;                   // Reserved vertices
+} PoolRange;
+
+/**
+ * A chunk's opaque and transparent slots
+ */
+typedef struct PoolEntry {
+    int chunk_x, chunk_z;
+    Chunk* chunk;
+    PoolRange opaque;
+    PoolRange transparent;
+    bool overflow;                  // Arena full: drawn from the chunk's own meshes
+    int sort_rank;                  // Position in the last transparent draw order
+    unsigned int sort_pass;         // Transparent pass sort_rank belongs to
+    struct PoolEntry* next;
+} PoolEntry;
+
+/**
+ * Freed range waiting until the GPU has finished the frames that used it
+ */
+typedef struct PoolRetired {
+    int offset;
+    int capacity;
+    unsigned int frame;             // Fence that must signal before reuse
+} PoolRetired;
+
+/**
+ * Per-draw command, laid out as GL's DrawElementsIndirectCommand
+ */
+typedef struct PoolDrawCommand {
+    unsigned int count;             // Indices (quads * 6)
+    unsigned int instance_count;    // Always 1
+    unsigned int first_index;       // Always 0 (shared quad index buffer)
+    int base_vertex;                // Slot offset in the arena
+    unsigned int base_instance;     // Index of the draw's chunk origin
+} PoolDrawCommand;
+
+/**
+ * Entry for transparent render sorting
+ */
+typedef struct PoolSortEntry {
+    PoolEntry* entry;
+    float dist_sq;
+} PoolSortEntry;
+
+/**
+ * Chunk pool system
+ */
+typedef struct ChunkPool {
+    unsigned int vao_id;
+    unsigned int vertex_buffer;     // Arena
+    unsigned int origin_buffer;     // Per-draw vec3 chunk origins (instanced attribute)
+    unsigned int command_buffer;    // GL_DRAW_INDIRECT_BUFFER
+    int capacity;                   // Arena size in vertices
+    int used;                       // Vertices reserved by slots
+
+    PoolRange* free_ranges;         // Free list sorted by offset (count unused)
+    int free_count;
+    int free_max;
+    PoolRetired* retired;           // Freed, not yet reusable
+    int retired_count;
+    int retired_max;
+
+    PoolEntry* buckets[CHUNK_POOL_BUCKETS];
+    int entry_count;
+
+    // Per-frame draw lists (grown on demand)
+    PoolDrawCommand* commands;
+    float* origins;
+    PoolSortEntry* sort_buffer;
+    PoolSortEntry* sort_scratch;    // Last order restore slots
+    int draw_max;
+    int sort_count;                 // Entries drawn by the last transparent pass
+    unsigned int sort_pass;         // Transparent passes so far
+
+    void* fences[CHUNK_POOL_FENCES];    // GLsync per frame, ring indexed by frame
+    unsigned int frame;                 // Fences inserted so far (one per chunk_pool_update)
+    unsigned int completed_frame;       // Fences before this one have signaled
+} ChunkPool;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * Create the pool (main thread, GL context required)
+ * Returns NULL if the driver lacks multi-draw indirect
+ */
+ChunkPool* chunk_pool_create(void);
+
+/**
+ * Destroy the pool and its GPU buffers
+ */
+void chunk_pool_destroy(ChunkPool* pool);
+
+/**
+ * Copy a chunk's full meshes into its slots (registers the chunk)
+ * Call after every whole-chunk upload
+ */
+void chunk_pool_write_chunk(ChunkPool* pool, Chunk* chunk);
+
+/**
+ * Patch a chunk's partially remeshed sections into its slots in place
+ * Uses the range recorded in chunk->mesh_ranges / transparent_ranges.
+ * Returns false if the slots must be rewritten with chunk_pool_write_chunk
+ */
+bool chunk_pool_splice_chunk(ChunkPool* pool, Chunk* chunk);
+
+/**
+ * Release a chunk's slots (call when the chunk is unloaded)
+ */
+void chunk_pool_release_chunk(ChunkPool* pool, Chunk* chunk);
+
+/**
+ * Fence the frame's draws and recycle slots the GPU no longer reads
+ * Call once per frame
+ */
+void chunk_pool_update(ChunkPool* pool);
+
+/**
+ * Draw every opaque slot in view with one indirect draw
+ * Only sections marked visible by world->culler are submitted
+ */
+void chunk_pool_render_opaque(ChunkPool* pool, World* world,
+                              Material material, Vector3 camera_pos);
+
+/**
+ * Draw every transparent slot in view back-to-front with one indirect draw
+ * Call after the opaque pass
+ */
+void chunk_pool_render_transparent(ChunkPool* pool, World* world,
+                                   Material material, Vector3 camera_pos);
+
+#endif // VOXEL_CHUNK_POOL_H
@@ -0,0 +1,116 @@
+/**
+ * Chunk Water - Per-chunk water surface meshes
+ *
+ * Water is not part of the block meshes. Each chunk keeps its own water
+ * mesh: the faces of its water blocks that border air or other see-through
+ * blocks. A vertex carries the height of the water surface at its corner
+ * (averaged over the water blocks sharing the corner) as an attribute
+ * instead of a baked position, and water.vs raises it and animates the
+ * waves; water.fs scrolls the tile along the flow.
+ *
+ * A flow step that only changes levels rewrites the vertices of the blocks
+ * around it in place (one small buffer write per block). Water appearing
+ * or draining away changes which faces exist and rebuilds the water mesh
+ * of that chunk only; the block meshes never see water at all.
+ */
+
+#ifndef VOXEL_CHUNK_WATER_H
+#define VOXEL_CHUNK_WATER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <raylib.h>
+#include "voxel/core/block.h"
+#include "voxel/render/chunk_mesh.h"
+
+// Forward declarations
+typedef struct World World;
+typedef struct Chunk Chunk;
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define WATER_VERTEX_SURFACE_BIT 0x10  // face byte: corner on the open surface (waves move it)
+#define WATER_SURFACE_FULL 255         // Surface height of a block covered by water (one block)
+#define WATER_FLOW_SCALE 4             // Corner height difference per unit of packed flow
+#define WATER_FLOW_BIAS 128            // Packed flow of still water
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+/**
+ * Packed water vertex (8 bytes, same attribute locations as ChunkVertex)
+ * x/z are chunk-local (0-16), y is the block's own y; water.vs adds
+ * surface / 255 to y
+ */
+typedef struct WaterVertex {
+    uint8_t x;
+    uint8_t y;
+    uint8_t z;
+    uint8_t face;       // BlockFace (bits 0-2), WATER_VERTEX_SURFACE_BIT
+    uint8_t surface;    // Height of the corner above y (0-255 = 0-1 block)
+    uint8_t light;      // Light level of the water block (0-15)
+    uint8_t flow_x;     // Downhill direction of the block's surface, biased by WATER_FLOW_BIAS
+    uint8_t flow_z;
+} WaterVertex;
+
+_Static_assert(sizeof(WaterVertex) == sizeof(ChunkVertex), "Water meshes share the chunk mesh buffers");
+
+/**
+ * Water block with faces in the mesh
+ */
+typedef struct WaterCell {
+    uint16_t index;     // (y << 8) | (z << 4) | x
+    uint8_t faces;      // Bit per BlockFace
+    uint8_t quad_count;
+    int first_quad;
+} WaterCell;
+
+/**
+ * Water mesh of one chunk (main thread)
+ */
+typedef struct ChunkWater {
+    ChunkMesh mesh;     // Chunk-local vertices (empty when no face is visible)
+    WaterCell* cells;   // Sorted by index
+    int cell_count;
+} ChunkWater;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * (Re)build a chunk's water mesh from its blocks and its neighbors'
+ * Frees chunk->water if the chunk has no visible water. Main thread, with
+ * the water simulation synced (reads neighbor chunks).
+ */
+void chunk_water_build(World* world, Chunk* chunk);
+
+/**
+ * Rewrite the vertices of one water block after its level or light changed
+ * Returns false if the block's faces are not the ones in the mesh (water
+ * appeared, drained or got covered): the mesh must be rebuilt.
+ */
+bool chunk_water_refresh_block(World* world, Chunk* chunk, int local_x, int y, int local_z);
+
+/**
+ * Free a chunk's water mesh (NULL is fine)
+ */
+void chunk_water_destroy(ChunkWater* water);
+
+/**
+ * Draw the water meshes of the visible chunks, far to near
+ * Call in the transparent pass, after the block meshes
+ */
+void chunk_water_render(World* world, Material material, Vector3 camera_pos);
+
+/**
+ * Whether a block hides the water face next to it
+ */
+static inline bool chunk_water_hides_face(Block neighbor) {
+    return neighbor.type == BLOCK_WATER || block_is_opaque(neighbor);
+}
+
+#endif // VOXEL_CHUNK_WATER_H
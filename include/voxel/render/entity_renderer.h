@@ -0,0 +1,76 @@
+/**
+ * Entity Renderer - Instanced cubes and spheres for mobs
+ *
+ * Entity render callbacks describe their body parts with
+ * entity_renderer_cube / entity_renderer_sphere in place of DrawCube /
+ * DrawSphere, under the same rlgl matrix stack. The parts are recorded as
+ * instances (transform with the color packed in) and drawn at the end of the
+ * frame with one DrawMeshInstanced per shared mesh, so the draw call count
+ * does not grow with the number of entities.
+ */
+
+#ifndef VOXEL_RENDER_ENTITY_RENDERER_H
+#define VOXEL_RENDER_ENTITY_RENDERER_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define ENTITY_RENDER_DISTANCE 96.0f     // Entities farther from the camera are not drawn
+#define ENTITY_SPHERE_RINGS 8            // Shared sphere mesh detail
+#define ENTITY_SPHERE_SLICES 8
+
+/**
+ * Shared meshes parts are drawn with
+ */
+typedef enum {
+    ENTITY_PART_CUBE,
+    ENTITY_PART_SPHERE,
+    ENTITY_PART_COUNT
+} EntityPartMesh;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * Load the instancing shader and the shared meshes (after the window opens)
+ * Without the shader, parts fall back to immediate DrawCube / DrawSphere.
+ */
+void entity_renderer_init(void);
+
+/**
+ * Free the shader, meshes and instance buffers
+ */
+void entity_renderer_destroy(void);
+
+/**
+ * Start recording a frame's instances
+ * Call inside BeginMode3D: the frustum comes from rlgl's current matrices
+ */
+void entity_renderer_begin(void);
+
+/**
+ * Check a world-space box against the frustum and the render distance
+ */
+bool entity_renderer_box_visible(Vector3 min, Vector3 max);
+
+/**
+ * Record a cube (same parameters as DrawCube) under the current rlgl transform
+ */
+void entity_renderer_cube(Vector3 position, float width, float height, float length, Color color);
+
+/**
+ * Record a sphere (same parameters as DrawSphere) under the current rlgl transform
+ */
+void entity_renderer_sphere(Vector3 center, float radius, Color color);
+
+/**
+ * Draw all recorded instances
+ */
+void entity_renderer_end(void);
+
+#endif // VOXEL_RENDER_ENTITY_RENDERER_H
@@ -0,0 +1,72 @@
+/**
+ * Frame Uniforms - Per-frame constants shared by the world shaders
+ *
+ * Camera, fog, ambient light and time live in one uniform buffer (binding
+ * FRAME_UNIFORMS_BINDING) that is uploaded once per frame. The block,
+ * particle and sky shaders declare the same FrameUniforms block, so a draw
+ * call only sets what is specific to it (the chunk origin attribute).
+ */
+
+#ifndef VOXEL_FRAME_UNIFORMS_H
+#define VOXEL_FRAME_UNIFORMS_H
+
+#include <stdbool.h>
+#include <raylib.h>
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define FRAME_UNIFORMS_BINDING 0          // Uniform buffer binding point
+#define FRAME_UNIFORMS_BLOCK "FrameUniforms"
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+/**
+ * std140 layout of the FrameUniforms block (must match the shaders)
+ */
+typedef struct FrameUniformData {
+    float view_proj[16];      // u_view_proj, column-major
+    float camera_pos[4];      // u_camera_pos.xyz
+    float camera_right[4];    // u_camera_right.xyz
+    float camera_up[4];       // u_camera_up.xyz
+    float camera_forward[4];  // u_camera_forward.xyz
+    float ambient_light[4];   // u_ambient_light.rgb
+    float fog_color[4];       // u_fog_color.rgb
+    float fog[4];             // u_fog: start, end, underwater (0/1), time in seconds
+} FrameUniformData;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * Create the uniform buffer and attach it to FRAME_UNIFORMS_BINDING
+ * (GL context required)
+ */
+bool frame_uniforms_init(void);
+
+/**
+ * Delete the uniform buffer
+ */
+void frame_uniforms_destroy(void);
+
+/**
+ * Point a shader's FrameUniforms block at the shared binding
+ * (no-op for shaders without the block)
+ */
+void frame_uniforms_bind_shader(Shader shader);
+
+/**
+ * Fill the camera fields the way BeginMode3D builds its matrices
+ */
+void frame_uniforms_set_camera(FrameUniformData* data, Camera3D camera);
+
+/**
+ * Upload the frame's constants (once per frame, before the sky pass)
+ */
+void frame_uniforms_upload(const FrameUniformData* data);
+
+#endif // VOXEL_FRAME_UNIFORMS_H
@@ -0,0 +1,62 @@
+/**
+ * GPU Timer - Non-blocking GL_TIME_ELAPSED measurements
+ *
+ * A small ring of timer queries: each timed span uses the next free query,
+ * and results are read back frames later, once the GPU has them, so timing
+ * never stalls the pipeline. Spans of different timers must not overlap
+ * (GL allows one active GL_TIME_ELAPSED query).
+ */
+
+#ifndef VOXEL_GPU_TIMER_H
+#define VOXEL_GPU_TIMER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define GPU_TIMER_FRAMES 4              // Spans in flight before new ones are skipped
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+typedef struct GpuTimer {
+    unsigned int queries[GPU_TIMER_FRAMES];  // 0 = timer queries unavailable
+    size_t tags[GPU_TIMER_FRAMES];           // Caller's value for each finished span
+    bool pending[GPU_TIMER_FRAMES];          // Ended, result not read yet
+    int next;                                // Query the next span uses
+    bool open;                               // A span is begun and not ended
+} GpuTimer;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * Create the queries (GL context required)
+ * Returns false when timer queries are unavailable; the timer is then a no-op
+ */
+bool gpu_timer_init(GpuTimer* timer);
+
+void gpu_timer_destroy(GpuTimer* timer);
+
+/**
+ * Start a span (skipped while its query still awaits readback)
+ */
+void gpu_timer_begin(GpuTimer* timer);
+
+/**
+ * End the span begun last, tagging it for gpu_timer_poll
+ */
+void gpu_timer_end(GpuTimer* timer, size_t tag);
+
+/**
+ * Take one finished span, without waiting for the GPU
+ * Returns false when none is ready
+ */
+bool gpu_timer_poll(GpuTimer* timer, double* ms, size_t* tag);
+
+#endif // VOXEL_GPU_TIMER_H
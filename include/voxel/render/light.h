@@ -1,8 +1,13 @@
 /**
- * Light System - Skylight Propagation
+ * Light System - Skylight and Block Light Propagation
  *
- * Calculates light levels for blocks based on exposure to sky.
- * Caves and underground areas are dark, surface is fully lit.
+ * Calculates light levels for blocks based on exposure to sky and on
+ * light-emitting blocks. Caves and underground areas are dark, surface is
+ * fully lit.
+ *
+ * Light is spread with breadth-first flood fills: a chunk pass on the
+ * workers, and incremental add/removal passes on the main thread that only
+ * visit the cells an edit affects and cross into neighbor chunks.
  */
 
 #ifndef VOXEL_LIGHT_H
@@ -10,21 +15,34 @@
 
 #include "voxel/world/chunk.h"
 
+// Forward declarations
+typedef struct World World;
+
 // Light level constants (0-15 range like Minecraft)
 #define LIGHT_MAX 15
 #define LIGHT_MIN 0
 
 /**
- * Calculate skylight for entire chunk.
- * Light propagates straight down from the sky.
- * Call this after terrain generation is complete.
+ * Calculate skylight and block light for entire chunk.
+ * Light propagates straight down from the sky, then spreads inside the chunk.
+ * Call this after terrain generation is complete (safe on worker threads).
  */
 void light_calculate_chunk(Chunk* chunk);
 
 /**
- * Recalculate light for a single column when a block changes.
- * More efficient than recalculating entire chunk.
+ * Update light after the block at world (x, y, z) replaced old
+ * Call after the block is written (main thread), passing the old block with
+ * its light level. Only the cells whose light depends on the block are
+ * visited, including cells in neighbor chunks; every chunk whose light
+ * changes is queued for a remesh.
+ */
+void light_update_block(World* world, int x, int y, int z, Block old);
+
+/**
+ * Spread light across the borders between a chunk and its 4 neighbors
+ * The chunk pass only sees its own chunk; call once the neighbors have their
+ * blocks and again when the chunk's first mesh is uploaded (main thread).
  */
-void light_update_column(Chunk* chunk, int x, int z);
+void light_stitch_chunk(World* world, Chunk* chunk);
 
 #endif // VOXEL_LIGHT_H
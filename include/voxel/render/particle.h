@@ -2,7 +2,8 @@
  * Particle System
  *
  * Pool-based particle system for visual effects like block breaking,
- * water splashes, and other effects.
+ * water splashes, and other effects. All particles are drawn with one
+ * instanced call; billboarding happens in particle.vs.
  */
 
 #ifndef VOXEL_RENDER_PARTICLE_H
@@ -21,25 +22,38 @@ typedef enum {
     PARTICLE_TYPE_WATER_SPLASH,  // Water entry/exit splash
 } ParticleType;
 
-// Single particle data
+/**
+ * Per-instance data streamed to particle.vs each frame
+ * The vertex shader expands every instance into a camera-facing quad
+ */
 typedef struct {
-    Vector3 position;
-    Vector3 velocity;
-    Color color;
-    float size;
-    float life;           // Remaining lifetime (seconds)
-    float max_life;       // Initial lifetime for fade calculation
-    ParticleType type;
-    bool active;
-    // Texture coordinates for atlas-based particles
-    float u_min, v_min, u_max, v_max;
-} Particle;
+    float x, y, z, size;                  // Center and faded size
+    float u_min, v_min, u_max, v_max;     // Atlas rectangle
+    unsigned char color[4];               // RGBA, alpha faded with age
+} ParticleInstance;
 
-// Particle system state
+/**
+ * Particle system state
+ * Live particles are kept packed in [0, active_count) as parallel arrays:
+ * spawning appends, expiring swaps the last particle into the hole, so
+ * update and render never touch dead slots
+ */
 typedef struct {
-    Particle particles[MAX_PARTICLES];
+    Vector3 position[MAX_PARTICLES];
+    Vector3 velocity[MAX_PARTICLES];
+    Color color[MAX_PARTICLES];
+    float size[MAX_PARTICLES];
+    float life[MAX_PARTICLES];            // Remaining lifetime (seconds)
+    float max_life[MAX_PARTICLES];        // Initial lifetime for fade calculation
+    Rectangle uv[MAX_PARTICLES];          // Atlas rectangle (x = u_min, y = v_min, width, height)
+    unsigned char type[MAX_PARTICLES];    // ParticleType
     int active_count;
-    Shader shader;
+
+    ParticleInstance instances[MAX_PARTICLES];
+    Shader shader;                        // Camera and billboard axes come from FrameUniforms
+    unsigned int vao_id;                  // Instance-only VAO (corners come from gl_VertexID)
+    unsigned int instance_vbo;
+    bool instanced;                       // false: shader missing, quads drawn through rlgl
     bool initialized;
 } ParticleSystem;
 
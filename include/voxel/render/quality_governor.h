@@ -0,0 +1,90 @@
+/**
+ * Quality Governor - Keeps the frame rate by trading view distance
+ *
+ * Watches a rolling window of frame times, the CPU time a frame actually
+ * works (excluding the wait for the frame cap), the GPU time of the world
+ * passes and the worker backlog. Every GOVERNOR_INTERVAL it may move one
+ * step: when the slow percentile misses the target it first pulls in the
+ * full-detail (LOD) ring, then the view distance; when there is headroom
+ * and the workers have caught up it restores them in reverse order, never
+ * past the distances chosen in the settings. Each change is followed by a
+ * cooldown, since the streaming it causes says nothing about the new cost.
+ *
+ * Memory budgets (memory.h) are enforced the same way, also when frame rate
+ * adaptation is off: over the GPU budget the LOD ring goes first, over the
+ * heap budget the view distance (the loaded area). Quality only returns
+ * while both totals stay below MEMORY_HIGH_WATER (MEMORY_LOW_WATER when
+ * only memory is governed).
+ *
+ * Upload work is budgeted per frame by UploadBudget against the same target.
+ */
+
+#ifndef VOXEL_QUALITY_GOVERNOR_H
+#define VOXEL_QUALITY_GOVERNOR_H
+
+#include <stdbool.h>
+#include "voxel/render/gpu_timer.h"
+#include "voxel/render/upload_budget.h"
+
+typedef struct World World;
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define GOVERNOR_TARGET_FRAME_MS UPLOAD_TARGET_FRAME_MS
+#define GOVERNOR_WINDOW 120             // Frames in the rolling window
+#define GOVERNOR_PERCENTILE 0.95f       // Slow frame percentile compared with the target
+#define GOVERNOR_INTERVAL 1.0f          // Seconds between decisions
+#define GOVERNOR_COOLDOWN 4.0f          // Seconds to settle after a change
+#define GOVERNOR_SLOW_FACTOR 1.15f      // Step down when the percentile exceeds target * this
+#define GOVERNOR_FAST_FACTOR 0.7f       // Step up when busy CPU and GPU time stay below target * this
+#define GOVERNOR_MAX_PENDING 64         // Worker backlog that holds back stepping up
+#define GOVERNOR_MIN_VIEW_DISTANCE 4
+#define GOVERNOR_MIN_LOD_DISTANCE 4
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+typedef struct QualityGovernor {
+    float frame_ms[GOVERNOR_WINDOW];    // Wall time between frames
+    float busy_ms[GOVERNOR_WINDOW];     // CPU time spent on update and draw
+    int sample_count;
+    int sample_next;
+    float gpu_ms;                       // Smoothed GPU time of the world passes
+    float wait;                         // Seconds until the next decision
+    GpuTimer gpu_timer;
+} QualityGovernor;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * Set up the governor (GL context required for GPU timing)
+ */
+void quality_governor_init(QualityGovernor* governor);
+
+void quality_governor_destroy(QualityGovernor* governor);
+
+/**
+ * Bracket the world's render passes to measure their GPU time
+ */
+void quality_governor_begin_gpu(QualityGovernor* governor);
+void quality_governor_end_gpu(QualityGovernor* governor);
+
+/**
+ * Record one frame and adjust the world when a decision is due
+ * max_view_distance/max_lod_distance: the user's settings (upper bounds)
+ * frame_rate: also trade distance for frame rate (otherwise memory only)
+ */
+void quality_governor_update(QualityGovernor* governor, World* world, float frame_ms, float busy_ms,
+                             int max_view_distance, int max_lod_distance, bool frame_rate);
+
+/**
+ * Forget the window (after the bounds change or the game was paused)
+ */
+void quality_governor_reset(QualityGovernor* governor);
+
+#endif // VOXEL_QUALITY_GOVERNOR_H
@@ -3,8 +3,15 @@
 
 #include <raylib.h>
 
+// Baked sky lookup textures (latitude-longitude, sampled by sky.fs)
+#define SKY_LUT_WIDTH 512            // Gradient, glow and cloud LUT (full sphere)
+#define SKY_LUT_HEIGHT 256
+#define SKY_STAR_MAP_WIDTH 2048      // Star map (upper hemisphere, baked once)
+#define SKY_STAR_MAP_HEIGHT 512
+#define SKY_REBAKE_HOURS 0.05f       // time_of_day change that re-bakes the LUT (sun moves ~0.75 degrees)
+
 void sky_init(void);
-void sky_render(Camera3D camera, float time_of_day);
+void sky_render(float time_of_day);  // Camera comes from the frame uniforms
 void sky_destroy(void);
 
 #endif // SKY_H
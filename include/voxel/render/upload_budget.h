@@ -0,0 +1,84 @@
+/**
+ * Upload Budget - Per-frame limit on mesh uploads and batch rebuilds
+ *
+ * Counting uploads says little about their cost: a mountain chunk carries
+ * many times the vertices of an ocean chunk. The budget is kept in bytes
+ * instead and adapts to the frame time: it shrinks quickly when frames run
+ * over the target and grows slowly while work is left over and frames are
+ * fast. The measured cost of the bytes (CPU time of the upload calls and
+ * GPU time from a timer query, read back a few frames later without
+ * waiting) additionally caps it to a share of the target frame.
+ *
+ * Mesh uploads always go to freshly created buffers, so the driver never
+ * waits for draws still reading the old ones.
+ */
+
+#ifndef VOXEL_UPLOAD_BUDGET_H
+#define VOXEL_UPLOAD_BUDGET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "voxel/render/gpu_timer.h"
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define UPLOAD_TARGET_FRAME_MS (1000.0f / 60.0f)   // Frame time to hold (main.c targets 60 FPS)
+#define UPLOAD_FRAME_SHARE 0.25f                   // Share of the target frame uploads may take
+#define UPLOAD_BUDGET_MIN_BYTES (256 * 1024)       // Never throttled below this
+#define UPLOAD_BUDGET_MAX_BYTES (32 * 1024 * 1024)
+#define UPLOAD_BUDGET_INITIAL_BYTES (4 * 1024 * 1024)
+#define UPLOAD_BUDGET_STEP_BYTES (256 * 1024)      // Growth per fast, saturated frame
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+typedef struct UploadBudget {
+    size_t frame_bytes;             // Adapted byte budget per frame
+    size_t used_bytes;              // Spent this frame
+    bool saturated;                 // Work was held back this frame
+    double used_ms;                 // CPU time of this frame's upload calls
+    double frame_start;             // GetTime() at upload_budget_begin
+    double op_start;                // GetTime() at the last allowed upload
+    float frame_ms;                 // Time between the last two frames
+    float cpu_ms_per_mb;            // Smoothed upload cost on each side (0 = not measured yet)
+    float gpu_ms_per_mb;
+    GpuTimer gpu_timer;             // Spans tagged with their bytes
+} UploadBudget;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * Create the budget and its timer queries (GL context required)
+ */
+UploadBudget* upload_budget_create(void);
+
+void upload_budget_destroy(UploadBudget* budget);
+
+/**
+ * Start a frame's uploads: adapt to the last frame and start timing
+ */
+void upload_budget_begin(UploadBudget* budget);
+
+/**
+ * Whether another upload of bytes fits this frame
+ * The first upload of a frame always fits, so streaming never stalls;
+ * a refusal marks the frame as saturated. NULL budget: always true
+ */
+bool upload_budget_allows(UploadBudget* budget, size_t bytes);
+
+/**
+ * Record bytes uploaded or copied on the GPU
+ */
+void upload_budget_spend(UploadBudget* budget, size_t bytes);
+
+/**
+ * Finish the frame's uploads and fold their cost into the estimate
+ */
+void upload_budget_end(UploadBudget* budget);
+
+#endif // VOXEL_UPLOAD_BUDGET_H
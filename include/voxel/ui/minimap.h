@@ -35,7 +35,8 @@ void minimap_destroy(Minimap* minimap);
 
 /**
  * Update minimap texture from world data
- * Call this each frame (internally throttles updates)
+ * Call this each frame; rebuilds only chunk tiles that scrolled into view
+ * or whose surface changed, a bounded number per call
  */
 void minimap_update(Minimap* minimap, World* world, Player* player);
 
@@ -0,0 +1,27 @@
+/**
+ * Profiler Overlay
+ *
+ * Draws the profiler's frame history in the top-left corner: a stacked
+ * graph of the main thread's update, tick and draw time against the frame
+ * time, a graph of worker time, a table of every zone and one of tracked
+ * memory per category against the heap and GPU budgets (memory.h).
+ */
+
+#ifndef VOXEL_PROFILER_OVERLAY_H
+#define VOXEL_PROFILER_OVERLAY_H
+
+// Overlay configuration
+#define PROFILER_OVERLAY_MARGIN 10
+#define PROFILER_OVERLAY_GRAPH_HEIGHT 80     // Pixels for PROFILER_OVERLAY_GRAPH_MS
+#define PROFILER_OVERLAY_GRAPH_MS 50.0f
+#define PROFILER_OVERLAY_WORKER_HEIGHT 40    // Pixels for PROFILER_OVERLAY_WORKER_MS
+#define PROFILER_OVERLAY_WORKER_MS 100.0f
+#define PROFILER_OVERLAY_AVERAGE_FRAMES 60   // Frames averaged in the table
+#define PROFILER_OVERLAY_RSS_FRAMES 30       // Frames between resident set samples
+
+/**
+ * Draw the overlay (2D mode)
+ */
+void profiler_overlay_draw(void);
+
+#endif // VOXEL_PROFILER_OVERLAY_H
@@ -41,6 +41,8 @@ typedef struct GameSettings {
     // Performance
     int max_uploads_per_frame;   // 8-128
     bool show_debug_info;
+    bool greedy_meshing;         // Merge coplanar faces into larger quads
+    bool adaptive_quality;       // Lower view/LOD distance below the above to hold 60 FPS
 
     // Input
     float mouse_sensitivity;     // 0.001-0.01
@@ -0,0 +1,98 @@
+/**
+ * UI Cache - Retained render targets for static UI panels
+ *
+ * A panel is drawn into a screen-sized render texture only when its
+ * signature (a hash of everything the panel shows) changes; every other
+ * frame the texture is drawn with one quad. The texture holds premultiplied
+ * alpha so translucent panels composite exactly as if drawn directly.
+ *
+ * Usage:
+ *   if (ui_cache_begin(&cache, signature)) {
+ *       ...draw the panel...
+ *       ui_cache_end(&cache);
+ *   }
+ *   ui_cache_draw(&cache);
+ *
+ * If the render texture cannot be created, begin always returns true and
+ * draws go straight to the screen.
+ */
+
+#ifndef VOXEL_UI_CACHE_H
+#define VOXEL_UI_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <raylib.h>
+
+// ============================================================================
+// SIGNATURES
+// ============================================================================
+
+#define UI_HASH_SEED 2166136261u
+
+/**
+ * Fold bytes into a signature (FNV-1a)
+ */
+static inline uint32_t ui_hash(uint32_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static inline uint32_t ui_hash_int(uint32_t hash, int value) {
+    return ui_hash(hash, &value, sizeof(value));
+}
+
+/**
+ * Fold a string, including its terminator (so "ab","c" != "a","bc")
+ */
+static inline uint32_t ui_hash_str(uint32_t hash, const char* str) {
+    if (!str) return ui_hash_int(hash, -1);
+    const uint8_t* bytes = (const uint8_t*)str;
+    do {
+        hash = (hash ^ *bytes) * 16777619u;
+    } while (*bytes++);
+    return hash;
+}
+
+// ============================================================================
+// CACHE
+// ============================================================================
+
+typedef struct UiCache {
+    RenderTexture2D target;     // Screen-sized, premultiplied alpha
+    int width, height;          // Screen size the target was made for
+    uint32_t signature;         // Signature of the current contents
+    bool valid;                 // Contents match signature
+} UiCache;
+
+/**
+ * Start redrawing the panel if signature or screen size changed
+ * Returns true when the caller must draw the panel and call ui_cache_end
+ */
+bool ui_cache_begin(UiCache* cache, uint32_t signature);
+
+/**
+ * Finish a redraw started by ui_cache_begin
+ */
+void ui_cache_end(UiCache* cache);
+
+/**
+ * Draw the cached panel to the screen
+ */
+void ui_cache_draw(const UiCache* cache);
+
+/**
+ * Force a redraw on the next ui_cache_begin
+ */
+void ui_cache_invalidate(UiCache* cache);
+
+/**
+ * Release the render texture (before CloseWindow)
+ */
+void ui_cache_unload(UiCache* cache);
+
+#endif // VOXEL_UI_CACHE_H
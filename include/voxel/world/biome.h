@@ -59,6 +59,12 @@ void biome_init(void);
  */
 BiomeType biome_get_at(int world_x, int world_z);
 
+/**
+ * Get the biome of every block column in a grid (batched noise)
+ * out[z * size_x + x] is the biome at (x0 + x, z0 + z)
+ */
+void biome_get_grid(BiomeType* out, int x0, int z0, int size_x, int size_z);
+
 /**
  * Get properties for a biome type
  *
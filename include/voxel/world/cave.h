@@ -0,0 +1,61 @@
+/**
+ * Cave Carver - Worm tunnels and cave rooms
+ *
+ * Tunnels and rooms are carved into a per-chunk bitmask before the chunk's
+ * blocks are filled: every tunnel segment is a capsule and every room an
+ * ellipsoid, tested a whole row of CHUNK_SIZE blocks at a time with SIMD.
+ * Terrain generation then writes air wherever the mask is set, so no block
+ * is written twice however many shapes overlap it.
+ *
+ * A tunnel is planned from its origin chunk's seed alone, so a chunk also
+ * replays the tunnels of every chunk within reach and carves the parts that
+ * cross it. Tunnels continue across chunk borders regardless of which chunk
+ * is generated first.
+ */
+
+#ifndef VOXEL_CAVE_H
+#define VOXEL_CAVE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "voxel/world/chunk.h"
+#include "voxel/world/terrain.h"
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define CAVE_BRANCH_MIN_SEGMENTS 15      // Branch tunnel length (segments)
+#define CAVE_BRANCH_EXTRA_SEGMENTS 20    // Up to this many more
+#define CAVE_ORIGIN_CACHE_SIZE 1024      // Origin chunk heights cached per thread
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+/**
+ * Blocks carved out of one chunk: bit x of rows[y][z]
+ */
+typedef struct CaveMask {
+    uint16_t rows[CHUNK_HEIGHT][CHUNK_SIZE];
+    int min_y, max_y;               // Rows that may have bits set (min_y > max_y: none)
+} CaveMask;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * Carve the tunnels and rooms reaching into a chunk
+ * Bits are clipped to each column's cave range (below the surface by
+ * cave_min_depth, not into the bedrock layers)
+ * Returns false if nothing was carved
+ */
+bool cave_build_mask(CaveMask* mask, int chunk_x, int chunk_z,
+                     TerrainParams params, const ColumnMap* columns);
+
+static inline bool cave_mask_test(const CaveMask* mask, int x, int y, int z) {
+    return (mask->rows[y][z] >> x) & 1;
+}
+
+#endif // VOXEL_CAVE_H
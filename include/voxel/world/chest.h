@@ -1,7 +1,10 @@
 /**
  * Chest System
  *
- * Handles chest data storage, loot generation, and registry
+ * Handles chest data storage and loot generation
+ *
+ * Chests live in the list of the chunk that contains them, so they are
+ * saved with the chunk's blocks and freed when it unloads.
  */
 
 #ifndef VOXEL_CHEST_H
@@ -10,12 +13,14 @@
 #include "voxel/core/item.h"
 #include <stdbool.h>
 
+// Forward declarations
+typedef struct Chunk Chunk;
+
 // ============================================================================
 // CONSTANTS
 // ============================================================================
 
 #define CHEST_SLOTS 27          // 3 rows x 9 columns
-#define CHEST_REGISTRY_SIZE 64  // Hash table size
 
 // ============================================================================
 // DATA STRUCTURES
@@ -25,43 +30,39 @@ typedef struct ChestData {
     int x, y, z;                    // World position
     ItemStack slots[CHEST_SLOTS];   // Inventory contents
     bool loot_generated;            // Has initial loot been created
-    struct ChestData* next;         // Hash chain
+    struct ChestData* next;         // Next chest in the same chunk
 } ChestData;
 
-typedef struct ChestRegistry {
-    ChestData* buckets[CHEST_REGISTRY_SIZE];
-    int count;
-} ChestRegistry;
-
 // ============================================================================
 // API
 // ============================================================================
 
 /**
- * Create a new chest registry
+ * Create chest data at world position in the chunk containing it
+ * Returns existing chest if one already exists at position
  */
-ChestRegistry* chest_registry_create(void);
+ChestData* chest_create(Chunk* chunk, int x, int y, int z);
 
 /**
- * Destroy a chest registry and all its data
+ * Get the chest at world position, creating it with its dungeon loot the
+ * first time (the loot only depends on the world seed and the position)
  */
-void chest_registry_destroy(ChestRegistry* registry);
+ChestData* chest_open(Chunk* chunk, int x, int y, int z);
 
 /**
- * Create chest data at world position
- * Returns existing chest if one already exists at position
+ * Get chest at world position (returns NULL if not found)
  */
-ChestData* chest_create(ChestRegistry* registry, int x, int y, int z);
+ChestData* chest_get(Chunk* chunk, int x, int y, int z);
 
 /**
- * Get chest at world position (returns NULL if not found)
+ * Remove chest at world position
  */
-ChestData* chest_get(ChestRegistry* registry, int x, int y, int z);
+void chest_remove(Chunk* chunk, int x, int y, int z);
 
 /**
- * Remove chest at world position
+ * Free a chunk's chest list
  */
-void chest_remove(ChestRegistry* registry, int x, int y, int z);
+void chest_list_free(ChestData* chests);
 
 /**
  * Generate random dungeon loot for a chest
@@ -8,9 +8,12 @@
 #define VOXEL_CHUNK_H
 
 #include "voxel/core/block.h"
+#include "voxel/render/chunk_mesh.h"
 #include <raylib.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
 
 // ============================================================================
 // CHUNK CONSTANTS
@@ -18,6 +21,20 @@
 
 #define CHUNK_SIZE 16       // Width and depth
 #define CHUNK_HEIGHT 256    // Maximum height
+#define CHUNK_VOLUME (CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE)
+
+#define CHUNK_SECTION_HEIGHT 16                                   // Section is 16x16x16
+#define CHUNK_SECTION_COUNT (CHUNK_HEIGHT / CHUNK_SECTION_HEIGHT)
+#define CHUNK_SECTION_VOLUME (CHUNK_SIZE * CHUNK_SECTION_HEIGHT * CHUNK_SIZE)
+#define CHUNK_NIBBLE_BYTES (CHUNK_SECTION_VOLUME / 2)               // 4-bit light/metadata arrays
+#define CHUNK_SECTIONS_ALL 0xFFFF                                 // Dirty mask covering every section
+#define CHUNK_COLD_THAW_SKIP 4                                    // Freeze passes a thawed chunk sits out
+
+#define CHUNK_NAV_WALK 0x01                                       // Column has standing room on its ground
+#define CHUNK_NAV_WATER 0x02                                      // Column's top is water (nav_height = above the water)
+#define CHUNK_NAV_CLEARANCE 2                                     // Free blocks a mob needs above the ground
+
+#define CHUNK_SPAWN_MAX 16                                        // Animals planned per chunk (the biggest herds fit)
 
 // ============================================================================
 // CHUNK STATE (for multi-threaded generation)
@@ -25,34 +42,246 @@
 
 typedef enum {
     CHUNK_STATE_EMPTY,       // Not yet generated
-    CHUNK_STATE_GENERATING,  // Being processed by worker thread
+    CHUNK_STATE_QUEUED,      // Waiting in worker task queue
+    CHUNK_STATE_GENERATING,  // Terrain, decoration or light stage on a worker
+    CHUNK_STATE_GENERATED,   // Blocks and light final, waiting for neighbors to mesh
+    CHUNK_STATE_MESHING,     // Mesh stage queued or running on a worker
     CHUNK_STATE_READY,       // Ready for GPU upload
     CHUNK_STATE_COMPLETE     // Mesh uploaded to GPU
 } ChunkState;
 
+/**
+ * Blocks of the chunk are final (no worker writes them anymore)
+ */
+#define CHUNK_STATE_HAS_BLOCKS(state) ((state) >= CHUNK_STATE_GENERATED)
+
+/**
+ * Mesh generation algorithm (selectable at runtime for comparison)
+ */
+typedef enum {
+    CHUNK_MESHER_SIMPLE,     // One quad per visible face
+    CHUNK_MESHER_GREEDY      // Coplanar faces with equal type/light/AO merged
+} ChunkMesher;
+
+// ============================================================================
+// SECTION STORAGE
+// ============================================================================
+
+/**
+ * Palette-compressed 16x16x16 block storage
+ * Block types are palette indices packed at 1/2/4/8 bits. Single-type sections
+ * (all air, all stone) keep no arrays at all. Light and metadata are 4-bit
+ * nibble arrays, likewise omitted while all values in the section match.
+ */
+typedef struct ChunkSection {
+    uint8_t* indices;         // Packed palette indices (NULL = all uniform_type)
+    uint8_t* palette;         // Block types, capacity 1 << bits
+    uint8_t* light;           // Nibble light levels (NULL = all uniform_light)
+    uint8_t* metadata;        // Nibble metadata (NULL = all uniform_metadata)
+    uint16_t block_count;     // Non-air blocks in section
+    uint16_t palette_size;    // Used palette entries
+    uint8_t bits;             // Bits per index (0 = uniform section)
+    uint8_t uniform_type;
+    uint8_t uniform_light;
+    uint8_t uniform_metadata;
+} ChunkSection;
+
+/**
+ * Dense index used by bulk accessors: Y-major, so each section is a
+ * contiguous CHUNK_SECTION_VOLUME range
+ */
+static inline int chunk_block_index(int x, int y, int z) {
+    return (y << 8) | (z << 4) | x;
+}
+
+/**
+ * Sections whose mesh depends on the block at height y
+ * Faces, AO and face light all sample one block up and down
+ */
+static inline uint16_t chunk_section_mask_for_y(int y) {
+    uint16_t mask = 0;
+    for (int yy = y - 1; yy <= y + 1; yy++) {
+        if (yy >= 0 && yy < CHUNK_HEIGHT) mask |= (uint16_t)(1u << (yy >> 4));
+    }
+    return mask;
+}
+
+/**
+ * Section face connectivity for cave culling: bit (a * 6 + b) is set when
+ * BlockFace a of a section can see face b through non-opaque blocks
+ */
+#define SECTION_VISIBILITY_ALL 0xFFFFFFFFFull                    // All 36 face pairs connected
+
+static inline bool section_faces_connected(uint64_t visibility, int face_a, int face_b) {
+    return (visibility >> (face_a * 6 + face_b)) & 1u;
+}
+
+/**
+ * Blocks in the one-block ring around a chunk, copied from its 8 neighbors
+ * on the main thread so border faces, AO and light can be meshed on a worker
+ * Ring cells: z = -1 row, z = 16 row (x = -1..16 each), then x = -1 and
+ * x = 16 columns (z = 0..15 each)
+ */
+#define CHUNK_BORDER_CELLS (4 * CHUNK_SIZE + 4)
+
+typedef struct ChunkBorder {
+    uint8_t types[CHUNK_HEIGHT][CHUNK_BORDER_CELLS];
+    uint8_t light[CHUNK_HEIGHT][CHUNK_BORDER_CELLS];
+} ChunkBorder;
+
+/**
+ * Ring cell of local position (x, z), which must lie just outside the chunk
+ */
+static inline int chunk_border_index(int x, int z) {
+    if (z < 0) return x + 1;
+    if (z >= CHUNK_SIZE) return (CHUNK_SIZE + 2) + x + 1;
+    if (x < 0) return 2 * (CHUNK_SIZE + 2) + z;
+    return 2 * (CHUNK_SIZE + 2) + CHUNK_SIZE + z;
+}
+
+/**
+ * Vertex ranges of a chunk mesh, grouped by section (vertices are emitted
+ * section by section, bottom to top), so a partial remesh can replace
+ * single sections in place
+ */
+typedef struct ChunkMeshRanges {
+    int start[CHUNK_SECTION_COUNT + 1];   // First vertex of each section, start[16] = total
+    int splice_first;                     // First vertex replaced by the last partial upload
+    int splice_end;                       // End of the replaced range (new layout)
+} ChunkMeshRanges;
+
+_Static_assert(CHUNK_MESH_CELL_CHUNKS * CHUNK_SIZE <= 255, "Cell-space vertex x/z must fit a byte");
+
+/**
+ * Offset of a chunk inside its mesh cell (CHUNK_MESH_CELL_CHUNKS wide), in blocks
+ * Baked into the chunk's mesh vertices
+ */
+static inline int chunk_mesh_cell_offset(int chunk_coord) {
+    return (chunk_coord & (CHUNK_MESH_CELL_CHUNKS - 1)) * CHUNK_SIZE;
+}
+
+/**
+ * World position a chunk's mesh is drawn at: the corner of its cell
+ */
+static inline Vector3 chunk_mesh_origin(int chunk_x, int chunk_z) {
+    return (Vector3){ (float)(chunk_x * CHUNK_SIZE - chunk_mesh_cell_offset(chunk_x)), 0.0f,
+                      (float)(chunk_z * CHUNK_SIZE - chunk_mesh_cell_offset(chunk_z)) };
+}
+
+// ============================================================================
+// LOD CELLS
+// ============================================================================
+
+/**
+ * Downsampled copies of a chunk for distant LOD regions
+ * Level k merges 2^k blocks per axis into one cell: level 1 is built from
+ * the blocks, every further level from the one below. A cell is solid when
+ * at least CHUNK_LOD_SOLID_CHILDREN of its 8 children are, takes the type
+ * of its topmost solid child and the brightest child light.
+ */
+#define CHUNK_LOD_LEVELS 3                 // Cell sizes 2, 4 and 8 blocks
+#define CHUNK_LOD_SOLID_CHILDREN 4         // Solid children (of 8) that make a cell solid
+#define CHUNK_LOD_CELLS (8 * 8 * 128 + 4 * 4 * 64 + 2 * 2 * 32)
+
+typedef struct ChunkLodCells {
+    uint8_t types[CHUNK_LOD_CELLS];        // BlockType per cell, levels 1-3 back to back
+    uint8_t light[CHUNK_LOD_CELLS];
+} ChunkLodCells;
+
+/**
+ * Cells per side of a chunk at LOD level (1-3)
+ */
+static inline int chunk_lod_side(int level) {
+    return CHUNK_SIZE >> level;
+}
+
+/**
+ * Cell rows of a chunk at LOD level (1-3)
+ */
+static inline int chunk_lod_height(int level) {
+    return CHUNK_HEIGHT >> level;
+}
+
+/**
+ * Index of cell (x, y, z) of LOD level (1-3) in ChunkLodCells
+ */
+static inline int chunk_lod_index(int level, int x, int y, int z) {
+    int offset = 0;
+    for (int k = 1; k < level; k++) {
+        offset += chunk_lod_side(k) * chunk_lod_side(k) * chunk_lod_height(k);
+    }
+    int side = chunk_lod_side(level);
+    return offset + (y * side + z) * side + x;
+}
+
 // ============================================================================
 // CHUNK DATA
 // ============================================================================
 
+/**
+ * One animal planned for a chunk by its generation worker (spawn_plan_chunk)
+ */
+typedef struct ChunkSpawn {
+    float x, y, z;                   // Feet position
+    uint8_t type;                    // EntityType
+    uint8_t variant;                 // Looks (sheep wool color index)
+} ChunkSpawn;
+
 typedef struct Chunk {
     int x, z;                                                  // Chunk position in world
-    Block blocks[CHUNK_SIZE][CHUNK_HEIGHT][CHUNK_SIZE];      // Block data (XYZ)
-    Mesh mesh;                                                 // Raylib mesh for opaque blocks
-    Mesh transparent_mesh;                                     // Raylib mesh for transparent blocks (leaves, water)
-    Mesh mesh_lod;                                             // LOD mesh for distant opaque rendering
-    Mesh transparent_mesh_lod;                                 // LOD mesh for distant transparent rendering
+    ChunkSection sections[CHUNK_SECTION_COUNT];                // Block data, bottom to top
+    ChunkMesh mesh;                                            // Packed mesh for opaque blocks
+    ChunkMesh transparent_mesh;                                // Packed mesh for transparent blocks (leaves, water)
     bool needs_remesh;                                         // Dirty flag
     bool is_empty;                                             // Optimization: all air
     bool mesh_generated;                                       // Has mesh been created?
     bool transparent_mesh_generated;                           // Has transparent mesh been created?
-    bool lod_generated;                                        // Has LOD mesh been created?
     bool has_spawned;                                          // Animals already spawned for this chunk
+    ChunkSpawn spawns[CHUNK_SPAWN_MAX];                        // Animals planned by the worker, placed by the main thread
+    uint8_t spawn_count;                                       // Planned animals
+    uint8_t spawn_placed;                                      // Planned animals already in the entity manager
+    bool needs_save;                                           // Generated or edited since last region write
+    bool remesh_pending;                                       // Remesh task in flight on a worker
+    uint16_t dirty_sections;                                   // Sections whose mesh is stale (bit per section)
+    ChunkMeshRanges mesh_ranges;                               // Per-section ranges of mesh
+    ChunkMeshRanges transparent_ranges;                        // Per-section ranges of transparent_mesh
+    int sort_origin[3];                                        // World block transparent quads are ordered back-to-front from
+    uint64_t section_visibility[CHUNK_SECTION_COUNT];          // Face connectivity per section (cave culling)
+    ChunkBorder* border;                                       // Neighbor blocks while meshing (NULL = outside is air)
+    uint8_t* remote_data;                                      // Blocks streamed from a host (chunk_codec), decoded by the terrain stage
+    uint32_t remote_size;
+    _Atomic(uint8_t*) cold_data;                               // Compressed section arrays (NULL = warm, see chunk_freeze)
+    uint32_t cold_size;
+    uint8_t cold_skip;                                         // Freeze passes to sit out after a thaw
+    uint16_t remote_wait;                                      // Frames waited for a requested host chunk (0 = not requested)
+    bool remote_local;                                         // Host had no data or did not answer: generate locally
     int solid_block_count;                                     // Count of non-air blocks (O(1) empty check)
-    ChunkState state;                                          // Generation state for threading
+    _Atomic(ChunkState) state;                                 // Generation state (chunk_get_state / chunk_set_state)
+    atomic_int refs;                                           // Worker tasks and results holding the chunk (chunk_retain)
+    atomic_bool detached;                                      // Unloaded from the world: work still in flight is dropped
     uint8_t min_block_y;                                       // Lowest Y with solid block (for mesh optimization)
     uint8_t max_block_y;                                       // Highest Y with solid block (for mesh optimization)
+    uint8_t surface_height[CHUNK_SIZE * CHUNK_SIZE];           // Topmost non-air Y per column, indexed (z << 4) | x
+    uint8_t surface_type[CHUNK_SIZE * CHUNK_SIZE];             // BlockType at surface_height (BLOCK_AIR = empty column)
+    bool surface_valid;                                        // Surface map computed (kept current by chunk_set_block)
+    uint32_t surface_version;                                  // Incremented whenever the surface map changes
+    uint8_t nav_height[CHUNK_SIZE * CHUNK_SIZE];               // Feet Y on the top walkable ground per column (canopies skipped)
+    uint8_t nav_flags[CHUNK_SIZE * CHUNK_SIZE];                // CHUNK_NAV_* per column (0 = no standing room), valid with the surface map
+    uint32_t nav_version;                                      // Incremented whenever a column's nav entry changes
+    ChunkLodCells* lod_cells;                                  // Downsampled blocks for LOD regions (NULL = not built)
+    uint32_t lod_version;                                      // Incremented on every lod_cells rebuild
+    bool lod_stale;                                            // Blocks changed since lod_cells was built
+    struct ChestData* chests;                                  // Chest contents in this chunk (list, saved with the blocks)
     struct Chunk* dirty_next;                                  // Next chunk in dirty list (for efficient remesh tracking)
     bool in_dirty_list;                                        // Is this chunk in the dirty list?
+    struct Chunk* retired_next;                                // Next unloaded chunk waiting for its references to drop
+    struct Chunk* stream_next;                                 // Next chunk in the world's stream list (not settled yet)
+    bool in_stream_list;
+    struct Chunk* spawn_next;                                  // Next chunk in the world's spawn list (planned animals left to place)
+    bool in_spawn_list;
+    struct ChunkWater* water;                                  // Water surface mesh (main thread, NULL = none, see chunk_water)
+    struct Chunk* water_next;                                  // Next chunk in the world's water list (water mesh to rebuild)
+    bool in_water_list;
 } Chunk;
 
 // ============================================================================
@@ -71,6 +300,7 @@ void chunk_destroy(Chunk* chunk);
 
 /**
  * Set block at local coordinates (0-15, 0-255, 0-15)
+ * Light level and metadata are stored as 4 bits each
  */
 void chunk_set_block(Chunk* chunk, int x, int y, int z, Block block);
 
@@ -79,13 +309,185 @@ void chunk_set_block(Chunk* chunk, int x, int y, int z, Block block);
  */
 Block chunk_get_block(Chunk* chunk, int x, int y, int z);
 
+/**
+ * Light level access without touching type/metadata
+ */
+uint8_t chunk_get_light(Chunk* chunk, int x, int y, int z);
+void chunk_set_light(Chunk* chunk, int x, int y, int z, uint8_t light);
+
+/**
+ * Decode all block types into a dense CHUNK_VOLUME array (chunk_block_index layout)
+ */
+void chunk_decode_types(Chunk* chunk, uint8_t* out_types);
+
+/**
+ * 64-bit hash of the block types, light and metadata
+ * Depends only on the blocks, not on how the sections store them
+ */
+uint64_t chunk_content_hash(Chunk* chunk);
+
+/**
+ * Replace all light levels from a dense CHUNK_VOLUME array (chunk_block_index layout)
+ * Sections with a single light value store no array
+ */
+void chunk_store_light(Chunk* chunk, const uint8_t* light);
+
+/**
+ * Replace all block types from a dense CHUNK_VOLUME array (chunk_block_index layout)
+ * Each section's palette is built in one pass and block counts and Y bounds
+ * are recounted once; light and metadata are kept
+ */
+void chunk_store_types(Chunk* chunk, const uint8_t* types);
+
+/**
+ * Shrink palettes to used entries and drop uniform arrays
+ * Call after bulk edits such as terrain generation
+ */
+void chunk_compact_storage(Chunk* chunk);
+
+/**
+ * Copy block data into a new chunk without meshes
+ * Used to mesh edited chunks on worker threads while the original stays live
+ */
+Chunk* chunk_snapshot(Chunk* chunk);
+
+/**
+ * Bytes used by chunk block storage (struct + section arrays or their
+ * compressed copy)
+ */
+size_t chunk_storage_bytes(const Chunk* chunk);
+
+/**
+ * Compress the section arrays of an idle chunk into one cold buffer
+ * Main thread only, while no other thread reads the chunk (no worker task,
+ * water tick or entity update in flight). Palettes and the per-section
+ * summaries stay, so block counts and raycast skips keep working.
+ * Returns false when there is nothing to gain.
+ */
+bool chunk_freeze(Chunk* chunk);
+
+/**
+ * Restore the section arrays of a frozen chunk (any thread)
+ */
+void chunk_thaw(Chunk* chunk);
+
+/**
+ * Thaw if frozen; every accessor of section arrays calls this first
+ */
+static inline void chunk_ensure_warm(Chunk* chunk) {
+    if (atomic_load_explicit(&chunk->cold_data, memory_order_acquire)) chunk_thaw(chunk);
+}
+
+static inline bool chunk_is_cold(Chunk* chunk) {
+    return atomic_load_explicit(&chunk->cold_data, memory_order_relaxed) != NULL;
+}
+
+/**
+ * Generation state. Workers store a state with release after writing the
+ * blocks it announces, so a reader that loads CHUNK_STATE_HAS_BLOCKS also
+ * sees those blocks without taking a lock
+ */
+static inline ChunkState chunk_get_state(Chunk* chunk) {
+    return atomic_load_explicit(&chunk->state, memory_order_acquire);
+}
+
+static inline void chunk_set_state(Chunk* chunk, ChunkState state) {
+    atomic_store_explicit(&chunk->state, state, memory_order_release);
+}
+
+/**
+ * Worker references: every queued or running task and every finished result
+ * holds one. An unloaded chunk is only freed once the count is back to zero
+ */
+static inline void chunk_retain(Chunk* chunk) {
+    atomic_fetch_add_explicit(&chunk->refs, 1, memory_order_relaxed);
+}
+
+/**
+ * Drop a reference; the chunk's owner frees it, never the releasing thread
+ */
+static inline void chunk_release(Chunk* chunk) {
+    atomic_fetch_sub_explicit(&chunk->refs, 1, memory_order_release);
+}
+
+/**
+ * A reference is held (acquire: a false result sees the releasers' writes)
+ */
+static inline bool chunk_in_use(Chunk* chunk) {
+    return atomic_load_explicit(&chunk->refs, memory_order_acquire) > 0;
+}
+
+/**
+ * Unloaded from the world; workers check it before each stage and drop the work
+ */
+static inline bool chunk_is_detached(Chunk* chunk) {
+    return atomic_load_explicit(&chunk->detached, memory_order_relaxed);
+}
+
+/**
+ * Mark sections in mask as needing a remesh
+ */
+static inline void chunk_mark_sections_dirty(Chunk* chunk, uint16_t mask) {
+    chunk->dirty_sections |= mask;
+    chunk->needs_remesh = true;
+}
+
+/**
+ * Sections from the bottom up to the highest one holding a non-air block
+ * (0 = all air). Everything above is open sky: never meshed, always lit 15
+ */
+static inline int chunk_section_span(const Chunk* chunk) {
+    int span = CHUNK_SECTION_COUNT;
+    while (span > 0 && chunk->sections[span - 1].block_count == 0) span--;
+    return span;
+}
+
+/**
+ * Section sy holds one block everywhere (uniform type, light and metadata,
+ * no arrays); out receives it. Bulk readers copy such sections wholesale
+ */
+bool chunk_section_uniform(Chunk* chunk, int sy, Block* out);
+
+/**
+ * Set every block of section sy to block without allocating arrays
+ * Keeps block counts, Y bounds and the surface map current (bulk loads)
+ */
+void chunk_fill_section(Chunk* chunk, int sy, Block block);
+
 /**
  * Check if coordinates are within chunk bounds
  */
 bool chunk_in_bounds(int x, int y, int z);
 
+/**
+ * Compute face connectivity of the sections in section_mask into out[section]
+ * Flood fills each section's non-opaque blocks (safe on worker threads)
+ */
+void chunk_compute_visibility(Chunk* chunk, uint16_t section_mask, uint64_t* out);
+
+/**
+ * Copy the blocks of neighbor that touch the chunk into border
+ * (dx, dz) is the neighbor's offset (-1..1, not both 0). A NULL neighbor
+ * fills its cells with lit air, the same guess made without a border
+ */
+void chunk_border_capture(ChunkBorder* border, Chunk* neighbor, int dx, int dz);
+
+/**
+ * Allocate and free a border, counted as MEMORY_WORKER while it waits for its task
+ */
+ChunkBorder* chunk_border_alloc(void);
+void chunk_border_free(ChunkBorder* border);
+
+/**
+ * Reorder transparent quads back-to-front from chunk->sort_origin
+ * For cell-space meshes made from another origin (mesh cache entries);
+ * quads stay within their section's range of section_start
+ */
+void chunk_sort_transparent(const Chunk* chunk, ChunkVertex* vertices, int vertex_count, const int* section_start);
+
 /**
  * Generate mesh for chunk (simple per-face meshing)
+ * Faces toward neighbors are culled against chunk->border when set
  */
 void chunk_generate_mesh(Chunk* chunk);
 
@@ -94,8 +496,16 @@ void chunk_generate_mesh(Chunk* chunk);
  */
 void chunk_update_mesh(Chunk* chunk);
 
+/**
+ * Select the mesher used for all subsequent mesh generation
+ * Existing meshes are kept until their chunk is remeshed
+ */
+void chunk_set_mesher(ChunkMesher mesher);
+ChunkMesher chunk_get_mesher(void);
+
 /**
  * Fill chunk with specific block type (for testing)
+ * Resets light and metadata
  */
 void chunk_fill(Chunk* chunk, BlockType type);
 
@@ -110,4 +520,17 @@ bool chunk_is_empty(Chunk* chunk);
  */
 void chunk_update_empty_status(Chunk* chunk);
 
+/**
+ * Build (or rebuild) the chunk's LOD cells from its blocks
+ * Clears lod_stale and increments lod_version; chunk_set_block marks the
+ * cells stale again
+ */
+void chunk_build_lod_cells(Chunk* chunk);
+
+/**
+ * Recompute the surface height/type map and the nav heightfield of every column
+ * Called once the chunk's blocks are final; chunk_set_block keeps both current
+ */
+void chunk_update_surface(Chunk* chunk);
+
 #endif // VOXEL_CHUNK_H
@@ -0,0 +1,32 @@
+/**
+ * Chunk Codec - Compact block encoding for streaming chunks
+ *
+ * Blocks are reduced to their (type, metadata) pairs, collected into a
+ * palette, and run-length encoded in y, x, z order with varint run lengths.
+ * Light is not stored: receivers relight the chunk. Natural terrain is a
+ * few KB per chunk.
+ */
+
+#ifndef VOXEL_CHUNK_CODEC_H
+#define VOXEL_CHUNK_CODEC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "voxel/world/chunk.h"
+
+#define CHUNK_CODEC_VERSION 1
+
+/**
+ * Encode a chunk's blocks into a new buffer (caller frees)
+ * Returns NULL if memory runs out
+ */
+uint8_t* chunk_codec_encode(Chunk* chunk, uint32_t* out_size);
+
+/**
+ * Overwrite every block of chunk with decoded data
+ * Light levels are left stale: run light_calculate_chunk afterwards.
+ * Returns false on malformed data, leaving the chunk untouched
+ */
+bool chunk_codec_decode(Chunk* chunk, const uint8_t* data, uint32_t size);
+
+#endif // VOXEL_CHUNK_CODEC_H
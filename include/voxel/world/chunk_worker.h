@@ -3,59 +3,86 @@
  *
  * Offloads terrain and mesh generation to worker threads
  * to eliminate frame stutters when loading new areas.
+ *
+ * Generation is a pipeline of stages (terrain, decoration, light, mesh),
+ * each its own task, so stages of different chunks overlap across threads.
+ * The first three only touch their own chunk and are chained by the worker;
+ * the mesh stage is submitted by the world once all 8 neighbors are
+ * generated, together with a copy of their border blocks.
+ *
+ * Every queued or running task and every finished result holds a reference
+ * on its chunk (chunk_retain). The world may unload a chunk at any time: it
+ * marks it detached, workers drop the work at the next stage boundary, and
+ * the world frees it once the last reference is gone.
  */
 
 #ifndef VOXEL_CHUNK_WORKER_H
 #define VOXEL_CHUNK_WORKER_H
 
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include "voxel/world/chunk.h"
+#include "voxel/world/mesh_arena.h"
 #include "voxel/world/terrain.h"
 
+typedef struct RegionStorage RegionStorage;
+typedef struct ColumnCache ColumnCache;
+typedef struct StructureStore StructureStore;
+typedef struct TerrainCache TerrainCache;
+typedef struct MeshCache MeshCache;
+
 // ============================================================================
 // CONFIGURATION
 // ============================================================================
 
 #define WORKER_THREAD_COUNT_MIN 2
 #define WORKER_THREAD_COUNT_MAX 16
-#define TASK_QUEUE_SIZE 512
+#define TASK_QUEUE_INITIAL 64     // Initial capacity of each thread's queue (grows on demand)
+#define WORKER_MAX_FOCUS 64       // Load anchors (center, prefetch and tickets) used to prioritize tasks
 #define MAX_UPLOADS_PER_FRAME 32
-#define LOD_DISTANCE_THRESHOLD 8  // Chunks beyond this distance use LOD mesh
+#define LOD_DISTANCE_THRESHOLD 8  // Default full-detail ring; chunks beyond it are drawn as LOD regions
+#define REMESH_TASK_PRIORITY -1   // Edits jump ahead of all generation tasks
+#define REMESH_PARTIAL_MAX_SECTIONS 8  // More dirty sections than this remesh the whole chunk
 
 // ============================================================================
 // DATA STRUCTURES
 // ============================================================================
 
+/**
+ * Generation pipeline stages, in the order they run
+ */
+typedef enum {
+    CHUNK_STAGE_TERRAIN,     // Load from disk or generate base terrain
+    CHUNK_STAGE_DECORATE,    // Trees and cacti
+    CHUNK_STAGE_LIGHT,       // Skylight propagation
+    CHUNK_STAGE_MESH,        // Needs the neighbors' border blocks
+    CHUNK_STAGE_COUNT
+} ChunkStage;
+
+/**
+ * Timing of one stage across all threads
+ */
+typedef struct {
+    int runs;
+    double total_ms;
+    double max_ms;
+} ChunkStageStats;
+
 /**
  * Staged mesh data - generated on worker thread, uploaded on main thread
  */
 typedef struct {
-    // Opaque mesh (full detail)
-    float* vertices;
-    float* texcoords;
-    float* normals;
-    unsigned char* colors;
+    ChunkVertex* vertices;             // Opaque mesh (full detail)
     int vertex_count;
-    // Transparent mesh (full detail)
-    float* trans_vertices;
-    float* trans_texcoords;
-    float* trans_normals;
-    unsigned char* trans_colors;
+    ChunkVertex* trans_vertices;       // Transparent mesh (full detail)
     int trans_vertex_count;
-    // LOD opaque mesh (simplified for distant chunks)
-    float* lod_vertices;
-    float* lod_texcoords;
-    float* lod_normals;
-    unsigned char* lod_colors;
-    int lod_vertex_count;
-    // LOD transparent mesh
-    float* lod_trans_vertices;
-    float* lod_trans_texcoords;
-    float* lod_trans_normals;
-    unsigned char* lod_trans_colors;
-    int lod_trans_vertex_count;
+    // Partial remesh: only these sections were meshed (0 = whole chunk)
+    uint16_t section_mask;
+    int section_start[CHUNK_SECTION_COUNT + 1];        // Opaque vertex range per section
+    int trans_section_start[CHUNK_SECTION_COUNT + 1];  // Transparent vertex range per section
+    uint64_t visibility[CHUNK_SECTION_COUNT];          // Section connectivity (meshed sections only)
     bool valid;
 } StagedMesh;
 
@@ -64,44 +91,85 @@ typedef struct {
  */
 typedef struct {
     Chunk* chunk;
+    Chunk* snapshot;  // Remesh-only task: mesh this block copy, skip generation (NULL = generate)
+    ChunkBorder* border;  // Mesh stage: neighbor blocks, owned by the task (NULL = outside is air)
     TerrainParams terrain_params;
-    bool valid;
-    int priority;  // Lower value = higher priority (distance² from player)
+    ChunkStage stage;
+    int chunk_x, chunk_z;  // Chunk position, for priority without touching the chunk
 } ChunkTask;
 
 /**
- * Thread-safe task queue
+ * One worker thread's task queue
+ * Unordered: the owner takes the task closest to a focus point at dequeue
+ * time, and idle threads steal the same way from the next non-empty queue
  */
 typedef struct {
-    ChunkTask tasks[TASK_QUEUE_SIZE];
-    int head;
-    int tail;
+    ChunkTask* tasks;
     int count;
+    int capacity;
     pthread_mutex_t mutex;
-    pthread_cond_t not_empty;
-    pthread_cond_t not_full;
 } TaskQueue;
 
 /**
- * Completed chunk with staged mesh (linked list node)
+ * Chunk position tasks are prioritized against (the load anchors)
+ */
+typedef struct {
+    int chunk_x, chunk_z;
+    int radius;                   // Square window kept by chunk_worker_cancel_outside
+} WorkerFocus;
+
+/**
+ * Completed chunk with staged mesh (intrusive queue node)
+ * Nodes are recycled: chunk_worker_release_completed hands them back to
+ * the thread that made them
  */
 typedef struct CompletedChunk {
     Chunk* chunk;
     StagedMesh mesh;
-    struct CompletedChunk* next;
+    bool remesh;      // Result of chunk_worker_enqueue_remesh
+    struct WorkerThread* owner;               // NULL: the queue's stub node
+    _Atomic(struct CompletedChunk*) next;     // Completed queue link
+    struct CompletedChunk* pool_next;         // Free list link
 } CompletedChunk;
 
+/**
+ * Per-thread state (thread index selects the owned queue)
+ */
+typedef struct WorkerThread {
+    struct ChunkWorker* worker;
+    int index;
+    MeshArena arena;                          // Vertices of the meshes this thread makes
+    CompletedChunk* free_nodes;               // Owner thread only
+    _Atomic(CompletedChunk*) returned_nodes;  // Released by the main thread, drained by the owner
+} WorkerThread;
+
 /**
  * Worker system
  */
 typedef struct ChunkWorker {
     pthread_t* threads;              // Dynamic array of worker threads
+    WorkerThread* thread_args;
     int thread_count;                // Number of active worker threads
-    TaskQueue pending;
-    CompletedChunk* completed_head;
-    CompletedChunk* completed_tail;
-    pthread_mutex_t completed_mutex;
-    bool running;
+    TaskQueue* queues;               // One per thread
+    int next_queue;                  // Round-robin submission target (main thread only)
+    int pending_count;               // Tasks in all queues (guarded by sleep_mutex)
+    pthread_mutex_t sleep_mutex;
+    pthread_cond_t work_available;
+    WorkerFocus focus[WORKER_MAX_FOCUS];
+    int focus_count;                 // 0 = no focus, tasks run in any order
+    pthread_mutex_t focus_mutex;
+    // Finished meshes: lock-free intrusive queue, pushed by workers, popped by the main thread
+    _Atomic(CompletedChunk*) completed_head;  // Most recently pushed
+    CompletedChunk* completed_tail;           // Next to pop (main thread only)
+    CompletedChunk completed_stub;            // Keeps the queue non-empty
+    RegionStorage* storage;          // Saved chunks are loaded from here before generating (may be NULL)
+    ColumnCache* columns;            // Shared height/biome cache for terrain and decoration (may be NULL)
+    StructureStore* structures;      // Trees crossing chunk borders (may be NULL: clipped)
+    TerrainCache* terrain_cache;     // Generated terrain from earlier runs (may be NULL)
+    MeshCache* mesh_cache;           // Meshes from earlier runs, consulted by the mesh stage (may be NULL)
+    ChunkStageStats stage_stats[CHUNK_STAGE_COUNT];
+    pthread_mutex_t stats_mutex;
+    atomic_bool running;
 } ChunkWorker;
 
 // ============================================================================
@@ -118,34 +186,126 @@ ChunkWorker* chunk_worker_create(void);
  */
 void chunk_worker_destroy(ChunkWorker* worker);
 
+/**
+ * Attach region storage so workers load saved chunks instead of generating
+ * Must be set before chunks are enqueued
+ */
+void chunk_worker_set_storage(ChunkWorker* worker, RegionStorage* storage);
+
+/**
+ * Attach the world's column cache used by the terrain and decoration stages
+ * Must be set before chunks are enqueued
+ */
+void chunk_worker_set_columns(ChunkWorker* worker, ColumnCache* columns);
+
+/**
+ * Attach the world's structure store used by the decoration stage
+ * Must be set before chunks are enqueued
+ */
+void chunk_worker_set_structures(ChunkWorker* worker, StructureStore* structures);
+
+/**
+ * Attach a terrain cache consulted before generating unsaved chunks
+ * Must be set before chunks are enqueued
+ */
+void chunk_worker_set_terrain_cache(ChunkWorker* worker, TerrainCache* cache);
+
+/**
+ * Attach a mesh cache consulted before meshing a chunk
+ * Must be set before chunks are enqueued
+ */
+void chunk_worker_set_mesh_cache(ChunkWorker* worker, MeshCache* cache);
+
 /**
  * Enqueue a chunk for generation (non-blocking)
- * Priority is calculated based on distance from center_chunk position
+ * Runs the terrain, decoration and light stages; the chunk then waits in
+ * CHUNK_STATE_GENERATED for chunk_worker_enqueue_mesh
+ * Priority is the distance to the nearest focus point when a worker picks
+ * the next task, so moving players never leave stale orderings behind
+ * Returns false only if the chunk is not EMPTY or memory ran out
+ */
+bool chunk_worker_enqueue(ChunkWorker* worker, Chunk* chunk, TerrainParams params);
+
+/**
+ * Set the anchor positions that generation is prioritized around
+ */
+void chunk_worker_set_focus(ChunkWorker* worker, const WorkerFocus* focus, int count);
+
+/**
+ * Cancel queued generation of chunks outside every window (a focus and its
+ * radius); cancelled chunks go back to EMPTY (GENERATED if only their mesh
+ * stage was queued)
+ * Returns the number of cancelled tasks
+ */
+int chunk_worker_cancel_outside(ChunkWorker* worker, const WorkerFocus* windows, int count);
+
+/**
+ * Enqueue the mesh stage of a CHUNK_STATE_GENERATED chunk (non-blocking)
+ * Takes ownership of border (from the chunk's 8 neighbors, may be NULL)
+ * Returns true if successfully enqueued; border is freed either way
+ */
+bool chunk_worker_enqueue_mesh(ChunkWorker* worker, Chunk* chunk, ChunkBorder* border);
+
+/**
+ * Enqueue a high-priority remesh of an already generated chunk (non-blocking)
+ * Meshes a snapshot of the block data, so the chunk stays editable meanwhile.
+ * Sets chunk->remesh_pending until the result is polled and uploaded
+ * Takes ownership of border like chunk_worker_enqueue_mesh
  * Returns true if successfully enqueued
  */
-bool chunk_worker_enqueue(ChunkWorker* worker, Chunk* chunk, TerrainParams params,
-                          int center_chunk_x, int center_chunk_z);
+bool chunk_worker_enqueue_remesh(ChunkWorker* worker, Chunk* chunk, ChunkBorder* border);
+
+/**
+ * Cancel a queued chunk before a worker picks it up
+ * Cancelled generation goes back to EMPTY, a cancelled mesh stage to GENERATED
+ * Returns true if a task was still pending (its reference is dropped),
+ * false if none was queued or a worker is running it
+ */
+bool chunk_worker_cancel(ChunkWorker* worker, Chunk* chunk);
 
 /**
  * Poll for completed chunks (non-blocking)
- * Returns NULL if no chunks are ready
- * Caller is responsible for freeing the returned CompletedChunk
+ * Returns NULL if no chunks are ready (main thread only)
+ * Hand the result back with chunk_worker_release_completed
  */
 CompletedChunk* chunk_worker_poll_completed(ChunkWorker* worker);
 
+/**
+ * Free a polled chunk's staged mesh, drop its chunk reference and recycle the node
+ */
+void chunk_worker_release_completed(CompletedChunk* completed);
+
 /**
  * Upload staged mesh to GPU (must be called from main thread)
+ * Partial meshes replace only their sections and record the changed
+ * vertex range in chunk->mesh_ranges / transparent_ranges
  */
 void chunk_worker_upload_mesh(Chunk* chunk, StagedMesh* mesh);
 
 /**
- * Free staged mesh data
+ * Free staged mesh data (returns the vertex blocks to their arena)
  */
 void staged_mesh_free(StagedMesh* mesh);
 
+/**
+ * Mesh a chunk without GPU upload (defined in chunk.c, any thread)
+ * Vertex blocks come from the calling thread's mesh arena, if bound
+ */
+void chunk_generate_mesh_staged(Chunk* chunk, StagedMesh* out);
+
+/**
+ * Mesh only the sections in section_mask (defined in chunk.c, any thread)
+ */
+void chunk_generate_sections_staged(Chunk* chunk, uint16_t section_mask, StagedMesh* out);
+
 /**
  * Get number of pending tasks
  */
 int chunk_worker_pending_count(ChunkWorker* worker);
 
+/**
+ * Copy the per-stage timings accumulated so far
+ */
+void chunk_worker_get_stage_stats(ChunkWorker* worker, ChunkStageStats out[CHUNK_STAGE_COUNT]);
+
 #endif // VOXEL_CHUNK_WORKER_H
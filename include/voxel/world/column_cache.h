@@ -0,0 +1,84 @@
+/**
+ * Column Cache - Shared terrain height and biome per block column
+ *
+ * Terrain height (fBm plus a nine-sample biome blend) and biome are asked
+ * for over and over for the same columns: terrain generation, dungeon and
+ * tree placement, animal spawning, the spawn point and the minimap. The
+ * cache computes them one chunk-sized region at a time with the batched
+ * noise (terrain_compute_column_map) and keeps recently used regions.
+ * Safe to call from worker threads and the main thread alike.
+ */
+
+#ifndef VOXEL_COLUMN_CACHE_H
+#define VOXEL_COLUMN_CACHE_H
+
+#include <stdint.h>
+#include <pthread.h>
+#include "voxel/world/terrain.h"
+#include "voxel/world/biome.h"
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define COLUMN_CACHE_BUCKETS 1024       // Region hash map buckets
+#define COLUMN_CACHE_MAX_REGIONS 4096   // Regions kept before evicting (~3 MB)
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+/**
+ * Cached column map of one chunk-sized region
+ */
+typedef struct ColumnRegion {
+    int region_x, region_z;         // Chunk coordinates
+    ColumnMap map;
+    uint32_t last_used;             // Cache clock at the last lookup
+    struct ColumnRegion* next;      // Bucket chain
+} ColumnRegion;
+
+/**
+ * Column cache for one set of terrain parameters
+ */
+typedef struct ColumnCache {
+    TerrainParams params;
+    ColumnRegion* buckets[COLUMN_CACHE_BUCKETS];
+    int region_count;
+    uint32_t clock;                 // Incremented on every lookup (LRU order)
+    uint64_t hits;
+    uint64_t misses;
+    pthread_mutex_t mutex;          // Guards everything above except params
+} ColumnCache;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * Create an empty cache for the given terrain parameters
+ * The noise seed must not change while the cache is alive
+ */
+ColumnCache* column_cache_create(TerrainParams params);
+
+/**
+ * Destroy the cache and print its hit rate
+ */
+void column_cache_destroy(ColumnCache* cache);
+
+/**
+ * Copy the column map of a chunk into map (computed on a miss)
+ */
+void column_cache_get_map(ColumnCache* cache, int chunk_x, int chunk_z, ColumnMap* map);
+
+/**
+ * Terrain height of one column (same value as terrain_get_height_at)
+ */
+int column_cache_get_height(ColumnCache* cache, int world_x, int world_z);
+
+/**
+ * Biome of one column (same value as biome_get_at)
+ */
+BiomeType column_cache_get_biome(ColumnCache* cache, int world_x, int world_z);
+
+#endif // VOXEL_COLUMN_CACHE_H
@@ -0,0 +1,104 @@
+/**
+ * Mesh Arena - Recycled vertex memory for worker-thread meshing
+ *
+ * Every worker thread owns an arena. Meshing writes into the arena's
+ * worst-case scratch buffer, then copies the result into a block rounded up
+ * to a power-of-two vertex count. The block travels with the staged mesh to
+ * the main thread, which hands it back once the vertices are on the GPU: it
+ * is pushed onto the owning arena's lock-free return list, and the owner
+ * moves returned blocks to its free lists the next time it allocates. After
+ * the first few chunks, streaming meshes allocate nothing.
+ *
+ * Threads without an arena (the main thread's synchronous meshing) get
+ * plain malloc'd blocks; mesh_block_free tells the two apart.
+ */
+
+#ifndef VOXEL_MESH_ARENA_H
+#define VOXEL_MESH_ARENA_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "voxel/render/chunk_mesh.h"
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define MESH_ARENA_MIN_SHIFT 8                         // Smallest block: 256 vertices (2 KB)
+#define MESH_ARENA_CLASSES 14                          // Largest block: 2M vertices (16 MB)
+#define MESH_ARENA_MAX_CACHED_BYTES (64 * 1024 * 1024) // Free blocks kept per arena, the rest is freed
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+/**
+ * Scratch buffers of an arena, used at the same time
+ */
+typedef enum {
+    MESH_SCRATCH_VERTICES,          // Worst-case pass output
+    MESH_SCRATCH_SORT,              // Transparent quad sort keys
+    MESH_SCRATCH_OCCUPANCY,         // Block occupancy bit columns of the chunk being meshed
+    MESH_SCRATCH_COUNT
+} MeshScratch;
+
+/**
+ * Header in front of every block's vertices
+ */
+typedef struct MeshBlock {
+    struct MeshArena* owner;        // NULL: plain malloc, freed directly
+    struct MeshBlock* next;         // Free list or return list link
+    int size_class;
+    int count;                      // Vertices of an unpooled block
+} MeshBlock;
+
+typedef struct MeshArena {
+    MeshBlock* free_blocks[MESH_ARENA_CLASSES];  // Owner thread only
+    size_t cached_bytes;                         // Bytes in free_blocks
+    _Atomic(MeshBlock*) returned;                // Pushed by any thread, drained by the owner
+    void* scratch[MESH_SCRATCH_COUNT];           // Meshing buffers, grown on demand
+    size_t scratch_bytes[MESH_SCRATCH_COUNT];
+    int blocks_created;
+} MeshArena;
+
+// ============================================================================
+// API
+// ============================================================================
+
+void mesh_arena_init(MeshArena* arena);
+
+/**
+ * Free all cached and returned blocks and the scratch buffers
+ * Blocks still held elsewhere must have been freed first
+ */
+void mesh_arena_destroy(MeshArena* arena);
+
+/**
+ * Make arena the calling thread's arena (NULL: none)
+ */
+void mesh_arena_bind(MeshArena* arena);
+
+/**
+ * Calling thread's arena, or NULL
+ */
+MeshArena* mesh_arena_current(void);
+
+/**
+ * Scratch buffer of at least bytes, valid until the next call for the same kind
+ * Owner thread only; returns NULL on OOM
+ */
+void* mesh_arena_scratch(MeshArena* arena, MeshScratch kind, size_t bytes);
+
+/**
+ * Vertex block holding at least count vertices
+ * arena NULL: plain malloc. Returns NULL on OOM
+ */
+ChunkVertex* mesh_block_alloc(MeshArena* arena, int count);
+
+/**
+ * Give a block back to its arena (any thread), or free it; NULL is ignored
+ */
+void mesh_block_free(ChunkVertex* vertices);
+
+#endif // VOXEL_MESH_ARENA_H
@@ -0,0 +1,80 @@
+/**
+ * Mesh Cache - Chunk meshes persisted next to the saved blocks
+ *
+ * Optional store of the meshes the workers build, so returning to a saved
+ * world (or to a chunk that dropped its mesh for an LOD region) reads the
+ * packed vertices instead of meshing again. Saved chunks already carry
+ * their light, so a cache hit leaves the mesh stage with a region read and
+ * a copy.
+ *
+ * Entries live in their own region files under the save directory, one per
+ * chunk. An entry is valid for the blocks it was made from: it holds a hash
+ * of the chunk's blocks, light and metadata, its neighbors' border cells,
+ * the mesher and MESH_CACHE_VERSION. Any edit changes the hash, and the
+ * next full mesh of the chunk replaces the entry. Bump MESH_CACHE_VERSION
+ * whenever the mesher or the vertex format changes its output.
+ *
+ * Transparent quads are reordered for the current camera on load.
+ */
+
+#ifndef VOXEL_MESH_CACHE_H
+#define VOXEL_MESH_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "voxel/world/chunk.h"
+#include "voxel/world/chunk_worker.h"
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define MESH_CACHE_VERSION 1            // Mesher output version, part of every entry's key
+#define MESH_CACHE_SUBDIRECTORY "meshes"
+#define MESH_CACHE_PATH_MAX 256
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+typedef struct MeshCache {
+    RegionStorage* storage;         // Region files holding the entries
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t stores;
+    pthread_mutex_t stats_mutex;    // Guards hits, misses and stores
+} MeshCache;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * Open the mesh cache of a save directory (in MESH_CACHE_SUBDIRECTORY)
+ * Returns NULL if the directory cannot be created
+ */
+MeshCache* mesh_cache_create(const char* save_directory);
+
+/**
+ * Flush pending writes and print the hit rate
+ */
+void mesh_cache_destroy(MeshCache* cache);
+
+/**
+ * Key of the mesh a chunk would get with this border (worker threads)
+ */
+uint64_t mesh_cache_key(Chunk* chunk, const ChunkBorder* border);
+
+/**
+ * Fill out with the cached mesh of chunk if its entry matches key (worker threads)
+ * Returns false on a miss, leaving out empty
+ */
+bool mesh_cache_load(MeshCache* cache, Chunk* chunk, uint64_t key, StagedMesh* out);
+
+/**
+ * Queue a freshly built full mesh for writing under key (worker threads)
+ */
+void mesh_cache_store(MeshCache* cache, Chunk* chunk, uint64_t key, const StagedMesh* mesh);
+
+#endif // VOXEL_MESH_CACHE_H
@@ -18,6 +18,11 @@
  */
 void noise_init(uint32_t seed);
 
+/**
+ * World seed given to noise_init (seeds the generation hashes, see random.h)
+ */
+uint32_t noise_get_seed(void);
+
 /**
  * 2D Perlin noise - returns value between -1.0 and 1.0
  * Used for heightmaps
@@ -46,4 +51,51 @@ float noise_fbm_2d(float x, float y, int octaves, float frequency,
 float noise_fbm_3d(float x, float y, float z, int octaves, float frequency,
                    float amplitude, float lacunarity, float persistence);
 
+// ============================================================================
+// BATCHED NOISE
+// ============================================================================
+
+/*
+ * Same values as the scalar functions above, evaluated several points at a
+ * time with SIMD (SSE2/AVX2 on x86-64, NEON on ARM64, scalar elsewhere).
+ */
+
+/**
+ * out[i] = noise_3d(x[i], y[i], z[i]) for count points
+ */
+void noise_3d_batch(const float* x, const float* y, const float* z, float* out, int count);
+
+/**
+ * out[i] = noise_fbm_2d(x[i], y[i], ...) for count points
+ */
+void noise_fbm_2d_batch(const float* x, const float* y, float* out, int count,
+                        int octaves, float frequency, float amplitude,
+                        float lacunarity, float persistence);
+
+/**
+ * out[i] = noise_fbm_3d(x[i], y[i], z[i], ...) for count points
+ */
+void noise_fbm_3d_batch(const float* x, const float* y, const float* z, float* out, int count,
+                        int octaves, float frequency, float amplitude,
+                        float lacunarity, float persistence);
+
+/**
+ * fBm over a size_x * size_z block grid starting at (x0, z0)
+ * out[z * size_x + x] is the value at block (x0 + x, z0 + z)
+ */
+void noise_fbm_2d_grid(float* out, int x0, int z0, int size_x, int size_z,
+                       int octaves, float frequency, float amplitude,
+                       float lacunarity, float persistence);
+
+/**
+ * fBm over a size_x * size_y * size_z block grid starting at (x0, y0, z0)
+ * out[(y * size_z + z) * size_x + x] is the value at block (x0 + x, y0 + y, z0 + z)
+ *
+ * cell > 1 samples only a lattice every cell blocks and interpolates
+ * trilinearly in between - meant for low-frequency fields (caves)
+ */
+void noise_fbm_3d_grid(float* out, int x0, int y0, int z0, int size_x, int size_y, int size_z,
+                       int cell, int octaves, float frequency, float amplitude,
+                       float lacunarity, float persistence);
+
 #endif // VOXEL_NOISE_H
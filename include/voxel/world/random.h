@@ -0,0 +1,105 @@
+/**
+ * Random - Stateless, seedable randomness for world generation
+ *
+ * Every random choice made while generating the world is a pure function of
+ * the world seed, the feature asking and the coordinates it asks for: a
+ * counter-based hash (Squirrel3 style) instead of rand()'s hidden state.
+ * A chunk therefore comes out the same whichever worker generates it, in
+ * whatever order, on whatever C library. Nothing here touches global state.
+ */
+
+#ifndef VOXEL_RANDOM_H
+#define VOXEL_RANDOM_H
+
+#include <stdint.h>
+
+// ============================================================================
+// FEATURES
+// ============================================================================
+
+/**
+ * Generation features with their own random sequences
+ * Keeps e.g. caves and dungeons of one chunk uncorrelated
+ */
+typedef enum {
+    RANDOM_FEATURE_NOISE = 1,       // Perlin permutation table
+    RANDOM_FEATURE_DUNGEON,
+    RANDOM_FEATURE_TUNNELS,
+    RANDOM_FEATURE_ROOMS,
+    RANDOM_FEATURE_FORMATIONS,
+    RANDOM_FEATURE_WATER_POOLS,
+    RANDOM_FEATURE_TREES,
+    RANDOM_FEATURE_CACTUS,
+    RANDOM_FEATURE_ANIMALS,
+    RANDOM_FEATURE_LOOT,
+} RandomFeature;
+
+// ============================================================================
+// HASHES
+// ============================================================================
+
+/**
+ * Hash a position with a seed (Squirrel3)
+ */
+static inline uint32_t random_hash(uint32_t position, uint32_t seed) {
+    uint32_t h = position * 0xB5297A4Du;
+    h += seed;
+    h ^= h >> 8;
+    h += 0x68E31DA4u;
+    h ^= h << 8;
+    h *= 0x1B56C4E9u;
+    h ^= h >> 8;
+    return h;
+}
+
+static inline uint32_t random_hash_2d(int x, int z, uint32_t seed) {
+    return random_hash((uint32_t)x + 198491317u * (uint32_t)z, seed);
+}
+
+static inline uint32_t random_hash_3d(int x, int y, int z, uint32_t seed) {
+    return random_hash((uint32_t)x + 198491317u * (uint32_t)y + 6542989u * (uint32_t)z, seed);
+}
+
+/**
+ * Seed of one feature in one world
+ */
+static inline uint32_t random_feature_seed(uint32_t world_seed, RandomFeature feature) {
+    return random_hash((uint32_t)feature, world_seed);
+}
+
+// ============================================================================
+// STREAMS
+// ============================================================================
+
+/**
+ * Sequence of values for one place: hashes of a running counter
+ * Lives on the stack of whoever draws from it
+ */
+typedef struct RandomStream {
+    uint32_t seed;
+    uint32_t counter;
+} RandomStream;
+
+static inline RandomStream random_stream(uint32_t seed) {
+    return (RandomStream){seed, 0};
+}
+
+static inline uint32_t random_next(RandomStream* stream) {
+    return random_hash(stream->counter++, stream->seed);
+}
+
+/**
+ * Float in [0, 1)
+ */
+static inline float random_next_float(RandomStream* stream) {
+    return (float)(random_next(stream) >> 8) / (float)(1u << 24);
+}
+
+/**
+ * Integer in [0, range)
+ */
+static inline int random_next_int(RandomStream* stream, int range) {
+    return range > 0 ? (int)(random_next(stream) % (uint32_t)range) : 0;
+}
+
+#endif // VOXEL_RANDOM_H
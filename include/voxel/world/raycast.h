@@ -9,6 +9,7 @@
 
 #include <raylib.h>
 #include <stdbool.h>
+#include <math.h>
 #include "voxel/core/texture_atlas.h"  // For BlockFace enum
 
 // Forward declarations
@@ -16,10 +17,41 @@ typedef struct World World;
 typedef struct Entity Entity;
 typedef struct EntityManager EntityManager;
 
+/**
+ * One ray of a batch
+ */
+typedef struct RaycastRay {
+    Vector3 origin;
+    Vector3 direction;      // Normalized by the cast
+    float max_distance;
+} RaycastRay;
+
+/**
+ * Result of one ray of a batch
+ */
+typedef struct RaycastHit {
+    bool hit;                       // A solid block was hit within max_distance
+    int block_x, block_y, block_z;  // Hit block
+    BlockFace face;                 // Face the ray entered through
+    float distance;                 // Distance to the block hit (max_distance on a miss)
+    Entity* entity;                 // Closest entity before the block, NULL if none
+    float entity_distance;          // Distance to entity
+} RaycastHit;
+
+/**
+ * Ray from one point to another (line-of-sight checks: clear when !hit)
+ */
+static inline RaycastRay raycast_ray_between(Vector3 from, Vector3 to) {
+    Vector3 d = { to.x - from.x, to.y - from.y, to.z - from.z };
+    float len = sqrtf(d.x * d.x + d.y * d.y + d.z * d.z);
+    return (RaycastRay){ from, d, len };
+}
+
 /**
  * Raycast to find the block the player is looking at
  *
- * Uses DDA algorithm for voxel traversal
+ * Uses DDA algorithm for voxel traversal; unloaded chunks, empty sections and
+ * the air above a chunk's highest block are crossed in one step
  *
  * @param world World to raycast in
  * @param origin Ray starting position
@@ -46,4 +78,19 @@ bool raycast_block(World* world, Vector3 origin, Vector3 direction,
 Entity* raycast_entity(EntityManager* manager, Vector3 origin, Vector3 direction,
                        float max_distance);
 
+/**
+ * Cast a batch of rays against blocks and, when manager is set, entities
+ *
+ * Rays share one chunk cursor, so group nearby rays together. The entity
+ * test only considers entities in front of each ray's block hit.
+ *
+ * @param world World to raycast in
+ * @param manager Entity manager, or NULL for blocks only
+ * @param rays Rays to cast
+ * @param count Number of rays
+ * @param hits Output: one result per ray
+ */
+void raycast_batch(World* world, EntityManager* manager, const RaycastRay* rays,
+                   int count, RaycastHit* hits);
+
 #endif // RAYCAST_H
@@ -0,0 +1,136 @@
+/**
+ * Region Storage - Chunk persistence
+ *
+ * Chunks are grouped into 32x32 region files, each with an offset table
+ * header followed by 4 KB sectors of run-length encoded chunk data. A
+ * rewritten chunk goes to free sectors before the table points at it, and
+ * its old sectors are reused by later writes.
+ * Writes are queued to a background I/O thread; reads happen on the
+ * chunk worker threads, so disk access never blocks the render thread.
+ */
+
+#ifndef VOXEL_REGION_H
+#define VOXEL_REGION_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "voxel/world/chunk.h"
+
+// ============================================================================
+// REGION CONSTANTS
+// ============================================================================
+
+#define REGION_SIZE 32                              // Chunks per region side
+#define REGION_CHUNKS (REGION_SIZE * REGION_SIZE)   // Chunks per region file
+#define REGION_SECTOR_SIZE 4096                     // Allocation unit in bytes
+#define REGION_HEADER_SECTORS 2                     // Offset table (1024 * 8 bytes)
+#define REGION_MAX_OPEN 16                          // Cached open region files
+#define REGION_PATH_MAX 256
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+/**
+ * Offset table entry (sector_offset 0 = chunk not stored)
+ */
+typedef struct {
+    uint32_t sector_offset;   // First sector of chunk data
+    uint32_t byte_length;     // Payload size in bytes
+    uint32_t sectors;         // Sectors allocated (not on disk: follows from byte_length)
+} RegionEntry;
+
+/**
+ * Open region file with cached offset table
+ */
+typedef struct RegionFile {
+    int region_x, region_z;
+    int fd;
+    RegionEntry table[REGION_CHUNKS];
+    uint32_t sector_count;    // File size in sectors (append position)
+    uint8_t* sector_map;      // Bit per sector in use (header and chunk data), rebuilt on open
+    uint32_t sector_capacity; // Sectors the map covers (multiple of 8)
+    struct RegionFile* next;  // MRU list
+} RegionFile;
+
+/**
+ * Serialized chunk waiting for the I/O thread
+ */
+typedef struct RegionWrite {
+    int chunk_x, chunk_z;
+    uint8_t* data;
+    uint32_t size;
+    struct RegionWrite* next;
+} RegionWrite;
+
+typedef struct RegionStorage {
+    char directory[REGION_PATH_MAX];
+    RegionFile* open_files;       // MRU list of open regions
+    int open_count;
+    pthread_mutex_t file_mutex;   // Guards open_files and file I/O
+    RegionWrite* write_head;      // Pending writes (FIFO)
+    RegionWrite* write_tail;
+    int write_count;
+    pthread_mutex_t write_mutex;
+    pthread_cond_t write_cond;
+    pthread_t io_thread;
+    bool running;
+} RegionStorage;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * Open (or create) a save directory and start the I/O thread
+ * Returns NULL if the directory cannot be created
+ */
+RegionStorage* region_storage_create(const char* directory);
+
+/**
+ * Flush pending writes, stop the I/O thread and close all region files
+ */
+void region_storage_destroy(RegionStorage* storage);
+
+/**
+ * Serialize chunk and queue it for writing (main thread, non-blocking)
+ * The chunk may be freed immediately after this returns
+ */
+bool region_storage_save_chunk(RegionStorage* storage, Chunk* chunk);
+
+/**
+ * Load chunk blocks from disk (blocking, call from worker threads)
+ * Sees writes that are still queued. Returns false if the chunk was never saved
+ */
+bool region_storage_load_chunk(RegionStorage* storage, Chunk* chunk);
+
+/**
+ * Queue an opaque per-chunk payload for writing (any thread)
+ * Takes ownership of data (malloc'd), also on failure. For stores that
+ * keep their own format in region files, like the terrain cache
+ */
+bool region_storage_write_raw(RegionStorage* storage, int chunk_x, int chunk_z, uint8_t* data, uint32_t size);
+
+/**
+ * Read a chunk's payload as written (blocking, call from worker threads)
+ * Sees writes that are still queued. Returns NULL if none; caller frees
+ */
+uint8_t* region_storage_read_raw(RegionStorage* storage, int chunk_x, int chunk_z, uint32_t* out_size);
+
+/**
+ * Read world seed from level file. Returns false if no level file exists
+ */
+bool region_storage_read_seed(RegionStorage* storage, uint32_t* seed);
+
+/**
+ * Write world seed to level file
+ */
+bool region_storage_write_seed(RegionStorage* storage, uint32_t seed);
+
+/**
+ * Get number of writes waiting for the I/O thread
+ */
+int region_storage_pending_writes(RegionStorage* storage);
+
+#endif // VOXEL_REGION_H
@@ -3,6 +3,10 @@
  *
  * Handles procedural spawning of animals based on biome type.
  * Animals spawn in herds (groups of same species) for natural behavior.
+ *
+ * A chunk's animals are planned by its generation worker (spawn_plan_chunk)
+ * and kept with the chunk; the main thread only places the planned
+ * entities, a few per frame (spawn_place).
  */
 
 #ifndef VOXEL_WORLD_SPAWN_H
@@ -10,11 +14,14 @@
 
 #include "voxel/entity/entity.h"
 #include "voxel/world/biome.h"
+#include "voxel/world/chunk.h"
 #include "voxel/world/terrain.h"
+#include "voxel/world/random.h"
 #include <stdbool.h>
 
 // Forward declarations
 struct World;
+typedef struct ColumnCache ColumnCache;
 
 // ============================================================================
 // SPAWN CONFIGURATION
@@ -52,28 +59,39 @@ typedef struct {
 void spawn_system_init(void);
 
 /**
- * Spawn animals for a newly loaded chunk
- * Uses deterministic seeding for reproducible spawns
+ * Plan the animals of a newly generated chunk
+ * Uses deterministic seeding for reproducible spawns. Only reads the column
+ * cache, so generation workers call it.
  *
- * @param world World containing entity manager
+ * @param columns Column cache for biome and height lookup
  * @param chunk_x Chunk X coordinate
  * @param chunk_z Chunk Z coordinate
- * @param params Terrain parameters for height lookup
+ * @param out Planned animals (herd members may stand past the chunk border)
+ * @param max Capacity of out (herds past it are dropped)
+ * @return Number of animals planned
  */
-void spawn_animals_for_chunk(struct World* world, int chunk_x, int chunk_z, TerrainParams params);
+int spawn_plan_chunk(ColumnCache* columns, int chunk_x, int chunk_z, ChunkSpawn* out, int max);
 
 /**
- * Spawn a herd of animals at a position
+ * Create one planned animal in the entity manager (main thread)
  *
  * @param manager Entity manager to spawn into
- * @param type Animal type to spawn
- * @param center Center position of herd
- * @param count Number of animals to spawn
- * @param radius Spread radius for herd
- * @param params Terrain parameters for height lookup
+ * @param spawn Animal planned by spawn_plan_chunk
+ * @return Pointer to spawned entity, NULL on failure
+ */
+Entity* spawn_place(EntityManager* manager, const ChunkSpawn* spawn);
+
+/**
+ * Despawn the animals standing in a chunk that leaves the world
+ * Reloading the chunk spawns its herds again from the same seed, so the
+ * animal population follows the loaded area instead of growing with it.
+ *
+ * @param world World containing entity manager
+ * @param chunk_x Chunk X coordinate
+ * @param chunk_z Chunk Z coordinate
+ * @return Number of animals removed
  */
-void spawn_herd(EntityManager* manager, EntityType type, Vector3 center,
-                int count, float radius, TerrainParams params);
+int despawn_animals_for_chunk(struct World* world, int chunk_x, int chunk_z);
 
 /**
  * Get spawn rules for a specific biome
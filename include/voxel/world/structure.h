@@ -0,0 +1,101 @@
+/**
+ * Structure Store - Deferred cross-chunk structure placement
+ *
+ * Decoration runs per chunk on the worker threads, so a structure (a tree)
+ * whose blocks reach past the chunk it is rooted in cannot write them there.
+ * Instead the spilling part is recorded as a fragment for the neighbor: the
+ * stamp to place and where its origin lies relative to the neighbor.
+ *
+ * A chunk claims its fragments when it is decorated (or loaded from disk)
+ * and places them together with its own structures. From then on the chunk
+ * is sealed: fragments that arrive later go to a late list, which the main
+ * thread applies as ordinary world edits once the chunk may be written.
+ * Unloading a chunk unseals it, so fragments made while it is away are
+ * placed when it comes back.
+ *
+ * Pending fragments live in memory only. Safe to call from worker threads
+ * and the main thread alike.
+ */
+
+#ifndef VOXEL_STRUCTURE_H
+#define VOXEL_STRUCTURE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define STRUCTURE_BUCKETS 1024            // Chunk entry hash map buckets
+#define STRUCTURE_MAX_FRAGMENTS 65536     // Pending + late fragments before new ones are dropped (clipped)
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+/**
+ * Part of a structure that falls into another chunk
+ */
+typedef struct StructureFragment {
+    int chunk_x, chunk_z;           // Target chunk
+    int16_t origin_x, origin_z;     // Structure origin relative to the target's corner
+    int16_t origin_y;
+    uint16_t stamp;                 // Stamp id of the owning module (tree_fragment_*)
+} StructureFragment;
+
+/**
+ * Fragments waiting for one chunk
+ */
+typedef struct StructureEntry {
+    int chunk_x, chunk_z;
+    bool sealed;                    // Fragments were claimed: new ones go to the late list
+    StructureFragment* fragments;
+    int count;
+    int capacity;
+    struct StructureEntry* next;    // Bucket chain
+} StructureEntry;
+
+typedef struct StructureStore {
+    StructureEntry* buckets[STRUCTURE_BUCKETS];
+    int entry_count;
+    int fragment_count;             // Pending and late
+    StructureFragment* late;        // For sealed chunks, applied by the main thread
+    int late_count;
+    int late_capacity;
+    bool overflow_logged;
+    pthread_mutex_t mutex;          // Guards everything above
+} StructureStore;
+
+// ============================================================================
+// API
+// ============================================================================
+
+StructureStore* structure_store_create(void);
+
+void structure_store_destroy(StructureStore* store);
+
+/**
+ * Record a fragment for its target chunk (pending, or late if sealed)
+ */
+void structure_store_add(StructureStore* store, const StructureFragment* fragment);
+
+/**
+ * Take the pending fragments of a chunk and seal it
+ * Returns the count; *out is malloc'd (caller frees) or NULL when none
+ */
+int structure_store_claim(StructureStore* store, int chunk_x, int chunk_z, StructureFragment** out);
+
+/**
+ * Unseal a chunk that was unloaded (later fragments wait for its reload)
+ */
+void structure_store_release(StructureStore* store, int chunk_x, int chunk_z);
+
+/**
+ * Move up to max late fragments into out (main thread)
+ * Fragments that cannot be applied yet are handed back with structure_store_add
+ */
+int structure_store_take_late(StructureStore* store, StructureFragment* out, int max);
+
+#endif // VOXEL_STRUCTURE_H
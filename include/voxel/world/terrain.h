@@ -102,6 +102,14 @@ typedef struct {
     float water_pool_frequency;  // Chance per low point (default: 0.15)
 } TerrainParams;
 
+/**
+ * Terrain height and biome of every column in one chunk, indexed [z][x]
+ */
+typedef struct ColumnMap {
+    int16_t heights[CHUNK_SIZE][CHUNK_SIZE];
+    uint8_t biomes[CHUNK_SIZE][CHUNK_SIZE];     // BiomeType
+} ColumnMap;
+
 // ============================================================================
 // API
 // ============================================================================
@@ -111,11 +119,20 @@ typedef struct {
  */
 TerrainParams terrain_default_params(void);
 
+/**
+ * Compute the column map of a chunk (batched noise, shared biome blend grid)
+ * Same values as terrain_get_height_at / biome_get_at per column
+ */
+void terrain_compute_column_map(ColumnMap* map, int chunk_x, int chunk_z, TerrainParams params);
+
 /**
  * Generate terrain for a chunk
  * Fills chunk with terrain based on world position and parameters
+ * columns: the chunk's cached column map (NULL = computed here)
+ * Base terrain only: decorate with tree_generate_for_chunk, then light
+ * with light_calculate_chunk
  */
-void terrain_generate_chunk(Chunk* chunk, TerrainParams params);
+void terrain_generate_chunk(Chunk* chunk, TerrainParams params, const ColumnMap* columns);
 
 /**
  * Get terrain height at world coordinates (for preview/debug)
@@ -0,0 +1,74 @@
+/**
+ * Terrain Cache - Generated terrain reused across runs
+ *
+ * Optional development cache of terrain_generate_chunk output, addressed by
+ * everything that output depends on: world seed, terrain parameters,
+ * generator version and chunk coordinates. Every key gets its own
+ * directory of region files, holding chunk codec data. A later run with
+ * the same seed and parameters loads the chunk instead of generating it,
+ * even for a new world.
+ *
+ * Only the terrain stage is cached. Decoration (trees reaching over from
+ * neighbors) depends on load order, so it runs on every load.
+ * Bump TERRAIN_CACHE_VERSION whenever generation changes its output
+ * (terrain, caves, biome tables, noise): the old entries are then never read.
+ */
+
+#ifndef VOXEL_TERRAIN_CACHE_H
+#define VOXEL_TERRAIN_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "voxel/world/chunk.h"
+#include "voxel/world/terrain.h"
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define TERRAIN_CACHE_VERSION 1         // Generator version, part of the key
+#define TERRAIN_CACHE_PATH_MAX 256
+
+// ============================================================================
+// DATA STRUCTURES
+// ============================================================================
+
+typedef struct RegionStorage RegionStorage;
+
+typedef struct TerrainCache {
+    RegionStorage* storage;         // Region files of this key
+    uint64_t key;
+    uint64_t hits;
+    uint64_t misses;
+    pthread_mutex_t stats_mutex;    // Guards hits and misses
+} TerrainCache;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * Open the cache of one seed and parameter set under root
+ * The key hashes every params field, so changed parameters get their own
+ * cache. Returns NULL if the directory cannot be created
+ */
+TerrainCache* terrain_cache_create(const char* root, uint32_t seed, TerrainParams params);
+
+/**
+ * Flush pending writes and print the hit rate
+ */
+void terrain_cache_destroy(TerrainCache* cache);
+
+/**
+ * Fill chunk with cached terrain (worker threads)
+ * Returns false on a miss, leaving the chunk untouched
+ */
+bool terrain_cache_load(TerrainCache* cache, Chunk* chunk);
+
+/**
+ * Queue a freshly generated chunk's terrain for writing (worker threads)
+ */
+void terrain_cache_store(TerrainCache* cache, Chunk* chunk);
+
+#endif // VOXEL_TERRAIN_CACHE_H
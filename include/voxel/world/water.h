@@ -2,6 +2,13 @@
  * Water Flow System
  *
  * Handles dynamic water spreading and flow mechanics
+ *
+ * Updates wait on a timing wheel indexed by tick, and a position set keeps
+ * each block scheduled at most once. A tick runs updates until its time
+ * budget is spent; the rest carry over to the next tick. Block changes are
+ * buffered during the tick (later updates read them back) and written with
+ * one world_set_blocks call, so the simulation can run on its own thread
+ * while the main thread renders.
  */
 
 #ifndef VOXEL_WATER_H
@@ -9,9 +16,11 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <pthread.h>
 
 // Forward declarations
 typedef struct World World;
+typedef struct WorldEdit WorldEdit;
 
 // ============================================================================
 // WATER CONSTANTS
@@ -25,6 +34,11 @@ typedef struct World World;
 #define WATER_MAX_LEVEL     7
 #define WATER_FLOW_DELAY    4    // Ticks between flow updates
 
+#define WATER_WHEEL_SLOTS   64      // Timing wheel slots (power of two; longer delays wrap)
+#define WATER_SET_BUCKETS   4096    // Scheduled position set buckets (power of two)
+#define WATER_EDIT_BUCKETS  1024    // Buffered edit lookup buckets (power of two)
+#define WATER_BUDGET_US     2000    // Default simulation time per tick (microseconds)
+
 // ============================================================================
 // WATER UPDATE QUEUE
 // ============================================================================
@@ -32,14 +46,38 @@ typedef struct World World;
 typedef struct WaterUpdate {
     int x, y, z;
     int scheduled_tick;
-    struct WaterUpdate* next;
+    struct WaterUpdate* next;       // Wheel slot, ready list or free list
+    struct WaterUpdate* prev;       // Wheel slot (NULL at the slot head)
+    struct WaterUpdate* hash_next;  // Position set chain
+    bool ready;                     // Due, waiting in the ready list
 } WaterUpdate;
 
 typedef struct WaterUpdateQueue {
-    WaterUpdate* pending;       // Linked list of pending updates
+    WaterUpdate* wheel[WATER_WHEEL_SLOTS];      // Updates by scheduled_tick % slots
+    WaterUpdate* ready_head;                    // Due updates, oldest first
+    WaterUpdate* ready_tail;
+    WaterUpdate* positions[WATER_SET_BUCKETS];  // Every scheduled update, by position
     WaterUpdate* free_list;     // Pool of reusable nodes
     int count;                  // Number of pending updates
     int current_tick;           // Current game tick
+    int budget_us;              // Simulation time per tick
+
+    // Block changes of the running tick, written by water_sync
+    WorldEdit* edits;
+    int* edit_next;             // Next edit in the same bucket (-1 = end)
+    int edit_count;
+    int edit_capacity;
+    int edit_buckets[WATER_EDIT_BUCKETS];
+
+    // Optional simulation thread (owns everything above while busy)
+    bool threaded;
+    bool running;
+    bool busy;                  // A tick is being simulated on the thread
+    World* world;
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t wake;        // Main thread -> simulation thread: tick started
+    pthread_cond_t done;        // Simulation thread -> main thread: tick finished
 } WaterUpdateQueue;
 
 // ============================================================================
@@ -52,10 +90,22 @@ typedef struct WaterUpdateQueue {
 WaterUpdateQueue* water_queue_create(void);
 
 /**
- * Destroy the water update queue
+ * Destroy the water update queue (stops its thread)
  */
 void water_queue_destroy(WaterUpdateQueue* queue);
 
+/**
+ * Simulate on a dedicated thread from now on
+ * Returns false (and keeps simulating on the caller's thread) if the thread
+ * can't be started
+ */
+bool water_queue_start_thread(WaterUpdateQueue* queue, World* world);
+
+/**
+ * Set the time one tick may spend on updates (leftovers run next tick)
+ */
+void water_queue_set_budget(WaterUpdateQueue* queue, int budget_us);
+
 /**
  * Schedule a water update at position
  * delay: Number of ticks before the update runs
@@ -64,10 +114,18 @@ void water_schedule_update(WaterUpdateQueue* queue, int x, int y, int z, int del
 
 /**
  * Process pending water updates for this tick
- * Call this each game tick
+ * Call this each game tick. With a thread, the tick only starts here and
+ * its block changes are written by the next water_sync.
  */
 void water_process_tick(WaterUpdateQueue* queue, World* world);
 
+/**
+ * Wait for a tick running on the thread and write its block changes
+ * The simulation thread reads chunks, so the main thread must call this
+ * before it changes blocks or loads and unloads chunks. Cheap when idle.
+ */
+void water_sync(WaterUpdateQueue* queue, World* world);
+
 /**
  * Called when a block changes - schedules water updates for neighbors
  */
@@ -11,61 +11,181 @@
 #include "voxel/world/terrain.h"
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 // Forward declarations
 typedef struct ChunkWorker ChunkWorker;
 typedef struct Player Player;
 typedef struct EntityManager EntityManager;
 typedef struct WaterUpdateQueue WaterUpdateQueue;
-typedef struct ChestRegistry ChestRegistry;
 typedef struct ChunkBatcher ChunkBatcher;
+typedef struct ChunkPool ChunkPool;
+typedef struct ChunkCuller ChunkCuller;
+typedef struct ChunkLod ChunkLod;
+typedef struct RegionStorage RegionStorage;
+typedef struct ColumnCache ColumnCache;
+typedef struct StructureStore StructureStore;
+typedef struct TerrainCache TerrainCache;
+typedef struct MeshCache MeshCache;
+typedef struct UploadBudget UploadBudget;
 
 // ============================================================================
 // WORLD CONSTANTS
 // ============================================================================
 
-#define WORLD_MAX_CHUNKS 1024        // Maximum chunks loaded at once
+#define WORLD_INDEX_SIZE 128         // Chunk index side (power of two, > 2 * (max view + margins) + 1)
+#define WORLD_INDEX_MASK (WORLD_INDEX_SIZE - 1)
 #define WORLD_VIEW_DISTANCE 8        // Chunks visible in each direction
+#define WORLD_UNLOAD_MARGIN 2        // Extra rings kept past view distance (hysteresis)
+#define WORLD_SORT_RADIUS 1          // Chunks around the camera whose transparent faces follow it
+#define WORLD_BORDER_RING 1          // Ring past view distance generated but not meshed (neighbors for border faces)
+#define WORLD_MEMORY_BUDGET_MB 768   // Default resident chunk memory budget
+#define WORLD_EVICT_INTERVAL 30      // Ticks between eviction sweeps when stationary
+#define WORLD_COLD_DISTANCE 6        // Chunks farther than this have their blocks compressed (0 = never)
+#define WORLD_COLD_SCAN_PER_FRAME 64 // Index slots the freeze pass visits per frame
+#define WORLD_COLD_PER_FRAME 4       // Chunks frozen per frame at most
+#define WORLD_TICK_RATE 30           // Simulation ticks per second (water, mobs, time of day)
+#define WORLD_REMOTE_CHUNK_TIMEOUT 180  // Frames to wait for a requested host chunk before generating it
+#define WORLD_LATE_STRUCTURES_PER_FRAME 16  // Tree fragments placed into already decorated chunks per frame
+#define WORLD_SPAWNS_PER_FRAME 8     // Planned animals placed into the entity manager per frame
+#define WORLD_WATER_BUILDS_PER_FRAME 8  // Chunk water meshes (re)built per frame
+#define WORLD_MAX_TICKETS 62         // Load tickets besides the center (one per remote player, forced areas)
+#define WORLD_PREFETCH_SECONDS 1.5f  // How far ahead of the center's motion chunks are generated
+#define WORLD_PREFETCH_MAX 6         // Prefetch lead cap (chunks)
 
 // ============================================================================
-// CHUNK HASH MAP
+// CHUNK INDEX
 // ============================================================================
 
-typedef struct ChunkNode {
-    int chunk_x;
-    int chunk_z;
-    Chunk* chunk;
-    struct ChunkNode* next;  // For hash collision chaining
-} ChunkNode;
-
-typedef struct {
-    ChunkNode* buckets[WORLD_MAX_CHUNKS];
+/**
+ * Toroidal chunk index: chunk (x, z) lives in slot (x & mask, z & mask)
+ * Every chunk the loaded window can hold gets its own slot, so a lookup is
+ * one load plus a coordinate check. Chunks left behind one full index width
+ * away (kept by the memory budget) wait in a small overflow list until the
+ * slot frees up.
+ */
+typedef struct ChunkIndex {
+    Chunk* slots[WORLD_INDEX_SIZE * WORLD_INDEX_SIZE];
+    Chunk** overflow;        // Chunks whose slot holds a different chunk
+    int overflow_count;
+    int overflow_capacity;
     int chunk_count;
-} ChunkHashMap;
+} ChunkIndex;
+
+/**
+ * Cached chunk for runs of nearby block queries (collision, raycasts, scans)
+ * Only the first query in each chunk touches the index. Valid until chunks
+ * are unloaded: keep cursors local to one update, never store them.
+ */
+typedef struct WorldCursor {
+    struct World* world;
+    Chunk* chunk;            // Chunk of the last query (NULL = not loaded)
+    int chunk_x, chunk_z;
+    bool has_chunk;          // chunk_x/chunk_z hold a looked-up chunk (even if NULL)
+} WorldCursor;
+
+/**
+ * One block change of a world_set_blocks batch
+ */
+typedef struct WorldEdit {
+    int x, y, z;
+    Block block;
+} WorldEdit;
+
+/**
+ * Ask a host for a chunk (chunk streaming, see world_set_chunk_source)
+ * Returns false if the request could not be queued; the chunk is then generated
+ */
+typedef bool (*WorldChunkRequestFunc)(void* user, int chunk_x, int chunk_z);
+
+/**
+ * Startup progress: ready of total spawn chunks are complete
+ */
+typedef void (*WorldProgressFunc)(void* user, int ready, int total);
+
+/**
+ * Square of chunks kept generated and simulated around an anchor, on top
+ * of the window around world_update's center (see world_add_ticket)
+ */
+typedef struct WorldTicket {
+    int chunk_x, chunk_z;    // Anchor
+    int radius;              // Chunks simulated in each direction (the border ring is generated on top)
+    bool active;
+} WorldTicket;
+
+/**
+ * Streaming work done by the last world_update (benchmarks, overlays)
+ */
+typedef struct WorldFrameStats {
+    int uploads;             // Meshes uploaded, new chunks and remeshes
+    size_t upload_bytes;
+    int batch_rebuilds;
+    int spawns;              // Planned animals placed
+    int water_builds;        // Chunk water meshes (re)built
+} WorldFrameStats;
 
 // ============================================================================
 // WORLD DATA
 // ============================================================================
 
 typedef struct World {
-    ChunkHashMap* chunks;
+    ChunkIndex* chunks;
     ChunkWorker* worker;     // Multi-threaded chunk generation
-    ChunkBatcher* batcher;   // Chunk batching for reduced draw calls
+    ChunkBatcher* batcher;   // Chunk batching for reduced draw calls (NULL when pool is used)
+    ChunkPool* pool;         // Shared vertex arena with indirect draws (NULL = GL < 4.3)
+    ChunkCuller* culler;     // Frustum + cave culling, refreshed every opaque render
+    ChunkLod* lod;           // Merged low-detail regions past the full-detail ring (NULL when headless)
+    bool headless;           // Dedicated server: chunks are never meshed, nothing touches the GPU
+    RegionStorage* storage;  // Chunk persistence (NULL = nothing is saved)
+    TerrainCache* terrain_cache;  // Generated terrain reused across runs (NULL = always generate)
+    MeshCache* mesh_cache;   // Chunk meshes reused across runs (NULL = always mesh)
     int center_chunk_x;      // Center of loaded chunks (camera position)
     int center_chunk_z;
     int view_distance;       // How many chunks to load around center
     TerrainParams terrain_params;  // Terrain generation parameters
+    ColumnCache* columns;    // Terrain height and biome per column, shared with the workers
+    StructureStore* structures;  // Tree parts waiting for neighbor chunks, shared with the workers
     Player* player;          // Reference to player (for entity AI)
     EntityManager* entity_manager;  // Entity manager for mobs
     float time_of_day;       // Current time (0-24 hours) for lighting
     WaterUpdateQueue* water_queue;  // Water flow update system
-    int game_tick;           // Game tick counter for water updates
-    ChestRegistry* chest_registry;  // Chest data storage
+    int game_tick;           // Simulation ticks run (world_tick)
     Chunk* dirty_head;       // Head of dirty chunk linked list (for O(n) remesh tracking)
     int dirty_count;         // Number of chunks in dirty list
     // Runtime settings (from settings menu)
     int batch_rebuilds_per_frame;   // Max batch rebuilds per frame (default: 16)
     int max_uploads_per_frame;      // Max mesh uploads per frame (default: 32)
+    UploadBudget* upload_budget;    // Adaptive bytes per frame for uploads and rebuilds (NULL when headless)
+    // Chunk eviction
+    size_t memory_budget_bytes;     // Resident chunk memory budget
+    size_t resident_bytes;          // Estimated chunk memory at last sweep
+    int last_evict_tick;            // Game tick of last eviction sweep
+    Chunk* retired_head;            // Unloaded chunks a worker task still references
+    int retired_count;
+    // Load tickets (remote players, forced areas)
+    WorldTicket tickets[WORLD_MAX_TICKETS];
+    bool tickets_moved;             // An anchor changed since the worker focus was set
+    // Incremental streaming: world_update visits only listed chunks
+    Chunk* stream_head;             // Window chunks with streaming work left (queue, mesh, release)
+    int stream_count;
+    bool stream_valid;              // The list covers the window around stream_center
+    int stream_center_x, stream_center_z;
+    int stream_view_distance;       // View and LOD distance the list was built for
+    int stream_lod_distance;
+    Chunk* spawn_head;              // Chunks with planned animals left to place
+    Chunk* water_head;              // Meshed chunks whose water mesh must be (re)built
+    float velocity_x, velocity_z;   // Center motion in blocks per second (world_set_velocity)
+    bool prefetch_active;           // A window ahead of the motion is generated
+    int prefetch_x, prefetch_z;     // Its center
+    int cold_distance;              // Freeze ring (WORLD_COLD_DISTANCE, 0 = off)
+    int cold_cursor;                // Next index slot of the freeze pass
+    WorldFrameStats frame_stats;    // Filled by world_update
+    // Chunk streaming
+    WorldChunkRequestFunc chunk_request;  // Fetches new chunks from a host (NULL = generate locally)
+    void* chunk_request_user;
+    // Transparent face sorting
+    int camera_block[3];            // Camera block at the last transparent pass
+    int sorted_block[3];            // Camera block the nearest chunks were last re-sorted for
 } World;
 
 // ============================================================================
@@ -77,6 +197,13 @@ typedef struct World {
  */
 World* world_create(TerrainParams terrain_params);
 
+/**
+ * Create a world for the dedicated server
+ * No batcher, pool or culler is created and chunks skip the mesh stage,
+ * becoming complete once their neighbors are generated.
+ */
+World* world_create_headless(TerrainParams terrain_params);
+
 /**
  * Destroy world and free all chunks
  */
@@ -95,38 +222,212 @@ Chunk* world_get_chunk(World* world, int chunk_x, int chunk_z);
 Chunk* world_get_or_create_chunk(World* world, int chunk_x, int chunk_z);
 
 /**
- * Get block at world coordinates
+ * Get block at world coordinates (air until the chunk's blocks are final)
+ * Lock-free; safe from the water and entity threads
  */
 Block world_get_block(World* world, int x, int y, int z);
 
+/**
+ * Start a cursor for a run of block queries
+ */
+void world_cursor_init(WorldCursor* cursor, World* world);
+
+/**
+ * Same as world_get_block, reusing the cursor's chunk when the block is in it
+ */
+Block world_cursor_get_block(WorldCursor* cursor, int x, int y, int z);
+
+/**
+ * Chunk holding world column (x, z), reusing the cursor's chunk
+ * NULL if not loaded or its blocks are not final yet
+ */
+Chunk* world_cursor_get_chunk(WorldCursor* cursor, int x, int z);
+
 /**
  * Set block at world coordinates
  */
 void world_set_block(World* world, int x, int y, int z, Block block);
 
+/**
+ * Change only a block's metadata (leaf distances)
+ * Metadata is neither meshed nor lit, so nothing is remeshed or relit.
+ * Returns false when the chunk is unloaded or a worker is using it.
+ */
+bool world_set_block_metadata(World* world, int x, int y, int z, uint8_t metadata);
+
+/**
+ * Set many blocks at once (water simulation)
+ * Same as world_set_block except that unloaded chunks are skipped, each chunk
+ * is looked up once per run of edits in it, and no water updates are
+ * scheduled (the caller already knows which blocks changed)
+ */
+void world_set_blocks(World* world, const WorldEdit* edits, int count);
+
+/**
+ * Queue a remesh of everything showing the block at (x, y, z)
+ * Its chunk's sections plus the border faces of meshed neighbors (light updates)
+ */
+void world_mark_block_dirty(World* world, int x, int y, int z);
+
+/**
+ * Copy the border blocks of a chunk's 8 neighbors for meshing (main thread)
+ * Neighbors that are missing or still generating read as lit air
+ * Returns NULL on allocation failure; caller frees
+ */
+ChunkBorder* world_capture_border(World* world, Chunk* chunk);
+
+/**
+ * Mesh a generated chunk on the main thread against its neighbors' borders
+ * (startup path; streaming meshes on worker threads)
+ */
+void world_build_chunk_mesh(World* world, Chunk* chunk);
+
 /**
  * Update world - load/unload chunks based on center position
- * Call this when camera moves to stream chunks
+ * Call this every frame to stream chunks and upload finished meshes
+ * The center is the local view: it alone is meshed and drawn. Load tickets
+ * add windows that are generated and simulated but never meshed.
+ * Only chunks with streaming work left are visited: a moving window adds
+ * the ring it uncovers, an idle one costs nothing
  */
 void world_update(World* world, int center_chunk_x, int center_chunk_z);
 
 /**
- * Render all visible chunks
+ * Report how fast the center moves (blocks per second)
+ * world_update generates the window ahead of the motion as well, first in
+ * line after the chunks around the center, so flying and sprinting find
+ * their chunks ready. Zero (the default) turns the prefetch off
+ */
+void world_set_velocity(World* world, float velocity_x, float velocity_z);
+
+/**
+ * Advance the world simulation by one fixed tick (1 / WORLD_TICK_RATE)
+ * Starts the water tick, which runs on the water thread until the next
+ * world_update or world_tick. Independent of the frame rate.
+ */
+void world_tick(World* world);
+
+/**
+ * Generate the area around a spawn chunk on the worker threads
+ * Runs world_update until the chunks within ready_radius are complete and
+ * returns; the rest of the view keeps streaming in while playing. progress
+ * is called after every update (NULL = none), e.g. to draw a loading screen.
+ */
+void world_prepare_spawn(World* world, int center_chunk_x, int center_chunk_z, int ready_radius,
+                         WorldProgressFunc progress, void* user);
+
+/**
+ * Unload chunks farther than WORLD_UNLOAD_MARGIN past every load window
+ * (the center's view and the tickets), then keep evicting the farthest
+ * chunks beyond the generated border rings while over the memory budget.
+ * Called from world_update; chunks a worker still holds are detached and
+ * freed once it lets go of them.
+ * Returns number of chunks evicted
+ */
+int world_evict_chunks(World* world);
+
+/**
+ * Attach region storage for chunk persistence (world takes ownership)
+ * Evicted chunks are written to it and workers load from it before generating
+ */
+void world_set_storage(World* world, RegionStorage* storage);
+
+/**
+ * Attach a terrain cache for chunks not found in storage (world takes ownership)
+ */
+void world_set_terrain_cache(World* world, TerrainCache* cache);
+
+/**
+ * Attach a mesh cache read by the mesh stage (world takes ownership)
+ */
+void world_set_mesh_cache(World* world, MeshCache* cache);
+
+/**
+ * Fetch new chunks from a host instead of generating them (NULL = generate)
+ * Chunks entering the view are requested once and wait for
+ * world_receive_chunk, falling back to generation after
+ * WORLD_REMOTE_CHUNK_TIMEOUT frames.
+ */
+void world_set_chunk_source(World* world, WorldChunkRequestFunc request, void* user);
+
+/**
+ * Request every loaded chunk again from the chunk source
+ * Used after joining a host, to replace chunks generated before.
+ */
+void world_request_loaded_chunks(World* world);
+
+/**
+ * Deliver a streamed chunk (chunk_codec data, copied)
+ * Waiting chunks are decoded and lit by a worker; chunks that already have
+ * blocks are replaced and relit on the spot. data = NULL means the host has
+ * no data for the chunk and it is generated locally.
+ * Returns false if the chunk is not loaded or busy on a worker
+ */
+bool world_receive_chunk(World* world, int chunk_x, int chunk_z, const uint8_t* data, uint32_t size);
+
+/**
+ * Encode a chunk for streaming to a client (chunk_codec data, caller frees)
+ * Loaded chunks are encoded as they are, unloaded ones are read from storage.
+ * Returns NULL with *pending set while the chunk is still being generated
+ * (or is in a load window and about to be), and with *pending clear when
+ * the world has no data for it.
+ */
+uint8_t* world_encode_chunk(World* world, int chunk_x, int chunk_z, uint32_t* out_size, bool* pending);
+
+/**
+ * Queue all generated chunks with unsaved changes for writing
+ * Returns number of chunks queued
+ */
+int world_save_all(World* world);
+
+/**
+ * Set resident chunk memory budget (in MB, clamped to 64-8192)
+ */
+void world_set_memory_budget(World* world, int budget_mb);
+
+/**
+ * Keep the chunks within radius of (chunk_x, chunk_z) generated and
+ * simulated (water, entities) until the ticket is removed. Generation
+ * favors the nearest anchor; eviction keeps the union of all windows.
+ * Returns the ticket id, or -1 when all WORLD_MAX_TICKETS are taken
+ */
+int world_add_ticket(World* world, int chunk_x, int chunk_z, int radius);
+
+/**
+ * Move a ticket's anchor (e.g. every update for a player)
+ */
+void world_move_ticket(World* world, int ticket, int chunk_x, int chunk_z);
+
+void world_remove_ticket(World* world, int ticket);
+
+/**
+ * Compress idle chunks farther than distance from every anchor (0 = never)
+ * They stay loaded and drawn; the first block access decompresses them
+ */
+void world_set_cold_distance(World* world, int distance);
+
+/**
+ * Render all visible chunks (noon lighting, default camera)
  */
 void world_render(World* world);
 
 /**
- * Render all visible chunks with time-based ambient lighting (opaque blocks only)
- * camera_pos: Camera position for fog calculations
- * underwater: Whether camera is underwater (for underwater fog effect)
+ * Upload the frame's shared shader constants: camera, time-based ambient
+ * light and fog, underwater flag (once per frame, before the sky and world)
+ */
+void world_update_frame_uniforms(World* world, Camera3D camera, float time_of_day, bool underwater);
+
+/**
+ * Render opaque blocks of all visible chunks
+ * camera_pos: Camera position for culling and batch selection
  */
-void world_render_with_time(World* world, float time_of_day, Vector3 camera_pos, bool underwater);
+void world_render_opaque(World* world, Vector3 camera_pos);
 
 /**
- * Render transparent blocks (leaves, water) with time-based ambient lighting
- * Call this AFTER world_render_with_time, with depth write disabled
+ * Render transparent blocks (leaves, water), farthest first
+ * Call this AFTER world_render_opaque, with depth write disabled
  */
-void world_render_transparent_with_time(World* world, float time_of_day, Vector3 camera_pos, bool underwater);
+void world_render_transparent(World* world, Vector3 camera_pos);
 
 /**
  * Convert world coordinates to chunk coordinates
@@ -166,6 +467,16 @@ int world_get_view_distance(World* world);
  */
 void world_set_view_distance(World* world, int distance);
 
+/**
+ * Set the full-detail ring (in chunks); farther chunks are drawn as LOD regions
+ */
+void world_set_lod_distance(World* world, int distance);
+
+/**
+ * Get the full-detail ring (in chunks)
+ */
+int world_get_lod_distance(World* world);
+
 /**
  * Set batch rebuilds per frame (for settings menu)
  */
@@ -1,6 +1,8 @@
 #version 330
 
 in vec2 fragTexCoord;
+in vec2 fragTileCoord;
+flat in float fragTileLayer;
 in vec4 fragColor;
 in vec3 fragNormal;
 in vec3 fragWorldPos;
@@ -8,57 +10,53 @@ in vec3 fragWorldPos;
 out vec4 finalColor;
 
 uniform sampler2D texture0;
-uniform vec3 u_ambient_light;
-
-// Fog uniforms
-uniform vec3 u_camera_pos;
-uniform float u_fog_start;
-uniform float u_fog_end;
-uniform vec3 u_fog_color;
-
-// Underwater effect
-uniform int u_underwater;
-
-// Water animation
-uniform float u_time;
+uniform sampler2DArray u_tile_array;  // One mipmapped layer per tile (layer = row * 32 + column)
+uniform int u_use_tile_array;         // 0 = tile array unsupported, sample the 2D atlas
+// Per-frame constants (must match FrameUniformData in frame_uniforms.h)
+layout(std140) uniform FrameUniforms {
+    mat4 u_view_proj;
+    vec4 u_camera_pos;      // xyz
+    vec4 u_camera_right;    // xyz
+    vec4 u_camera_up;       // xyz
+    vec4 u_camera_forward;  // xyz
+    vec4 u_ambient_light;   // rgb
+    vec4 u_fog_color;       // rgb
+    vec4 u_fog;             // start, end, underwater (0/1), time in seconds
+};
 
 // Atlas constants (must match texture_atlas.h)
 const float TILES_PER_ROW = 32.0;
 const float TILE_UV_SIZE = 1.0 / TILES_PER_ROW;
+const float TILE_UV_PADDING = 0.001;
 
-void main() {
-    vec2 texCoord = fragTexCoord;
-
-    // Water animation: detect if UV is in water row (row 6) and animate
-    // Water is at row 6, columns 0-3 (4 animation frames)
-    float water_row_start = 6.0 * TILE_UV_SIZE;
-    float water_row_end = 7.0 * TILE_UV_SIZE;
-
-    if (texCoord.y >= water_row_start && texCoord.y < water_row_end) {
-        // Calculate current animation frame (4 frames, 4 FPS = 0.25s per frame)
-        float frame = floor(mod(u_time * 4.0, 4.0));
-
-        // Get position within the current tile (0-1 within tile)
-        float tile_local_u = mod(texCoord.x, TILE_UV_SIZE);
+vec4 sample_atlas() {
+    // texCoord is the (inset) tile origin; the tile repeats once per block
+    // via the block-local tile coordinates
+    vec2 texCoord = fragTexCoord + fract(fragTileCoord) * (TILE_UV_SIZE - 2.0 * TILE_UV_PADDING);
+    return texture(texture0, texCoord);
+}
 
-        // Offset U to the correct frame (frames are at columns 0,1,2,3)
-        texCoord.x = frame * TILE_UV_SIZE + tile_local_u;
-    }
+vec4 sample_tile_array() {
+    // Each layer wraps by itself, so block-local coordinates tile directly
+    // and mip selection stays continuous across merged quads
+    return texture(u_tile_array, vec3(fragTileCoord, fragTileLayer));
+}
 
-    vec4 texColor = texture(texture0, texCoord);
+void main() {
+    vec4 texColor = u_use_tile_array == 1 ? sample_tile_array() : sample_atlas();
 
-    // Apply vertex color (from greedy meshing) and ambient light
-    vec3 color = texColor.rgb * fragColor.rgb * u_ambient_light;
+    // Apply vertex color (light and AO) and ambient light
+    vec3 color = texColor.rgb * fragColor.rgb * u_ambient_light.rgb;
 
     // Calculate distance fog
-    float dist = distance(fragWorldPos, u_camera_pos);
-    float fogFactor = clamp((dist - u_fog_start) / (u_fog_end - u_fog_start), 0.0, 1.0);
+    float dist = distance(fragWorldPos, u_camera_pos.xyz);
+    float fogFactor = clamp((dist - u_fog.x) / (u_fog.y - u_fog.x), 0.0, 1.0);
 
     // Smooth quadratic fog curve
     fogFactor = fogFactor * fogFactor;
 
     // Apply underwater effects if submerged
-    if (u_underwater == 1) {
+    if (u_fog.z > 0.5) {
         // Blue tint underwater
         color = mix(color, vec3(0.2, 0.4, 0.8), 0.3);
 
@@ -68,7 +66,7 @@ void main() {
         color = mix(color, vec3(0.1, 0.3, 0.5), underwaterFogFactor);
     } else {
         // Normal fog
-        color = mix(color, u_fog_color, fogFactor);
+        color = mix(color, u_fog_color.rgb, fogFactor);
     }
 
     finalColor = vec4(color, texColor.a);
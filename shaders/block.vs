@@ -1,23 +1,70 @@
 #version 330
 
-in vec3 vertexPosition;
-in vec2 vertexTexCoord;
-in vec3 vertexNormal;
-in vec4 vertexColor;
+// Packed chunk vertex (see chunk_mesh.h), bytes arrive as 0-255 floats
+layout(location = 0) in vec4 vertexPosition;  // x, y low byte, z, face | y high bit << 3
+layout(location = 1) in vec4 vertexSurface;   // tile x, tile y, light | ao << 4, unused
+layout(location = 2) in vec3 chunkOrigin;     // Chunk origin: per-draw array (pool) or generic value
 
 out vec2 fragTexCoord;
+out vec2 fragTileCoord;
+flat out float fragTileLayer;
 out vec4 fragColor;
 out vec3 fragNormal;
 out vec3 fragWorldPos;
 
-uniform mat4 mvp;
-uniform mat4 matModel;
-uniform mat4 matNormal;
+// Per-frame constants (must match FrameUniformData in frame_uniforms.h)
+layout(std140) uniform FrameUniforms {
+    mat4 u_view_proj;
+    vec4 u_camera_pos;      // xyz
+    vec4 u_camera_right;    // xyz
+    vec4 u_camera_up;       // xyz
+    vec4 u_camera_forward;  // xyz
+    vec4 u_ambient_light;   // rgb
+    vec4 u_fog_color;       // rgb
+    vec4 u_fog;             // start, end, underwater (0/1), time in seconds
+};
+
+// Atlas constants (must match texture_atlas.h)
+const float TILES_PER_ROW = 32.0;
+const float TILE_UV_SIZE = 1.0 / TILES_PER_ROW;
+const float TILE_UV_PADDING = 0.001;
+
+// Per face (BlockFace order: top, bottom, front, back, left, right)
+const vec3 FACE_NORMAL[6] = vec3[6](
+    vec3(0.0, 1.0, 0.0), vec3(0.0, -1.0, 0.0),
+    vec3(0.0, 0.0, -1.0), vec3(0.0, 0.0, 1.0),
+    vec3(-1.0, 0.0, 0.0), vec3(1.0, 0.0, 0.0));
+const float FACE_SHADE[6] = float[6](1.0, 0.8, 0.9, 0.9, 0.95, 0.95);
+// Tile U/V axes in block space, signed so v1 of every quad is the tile origin
+const vec3 FACE_U[6] = vec3[6](
+    vec3(1.0, 0.0, 0.0), vec3(1.0, 0.0, 0.0),
+    vec3(1.0, 0.0, 0.0), vec3(-1.0, 0.0, 0.0),
+    vec3(0.0, 0.0, -1.0), vec3(0.0, 0.0, 1.0));
+const vec3 FACE_V[6] = vec3[6](
+    vec3(0.0, 0.0, 1.0), vec3(0.0, 0.0, -1.0),
+    vec3(0.0, 1.0, 0.0), vec3(0.0, 1.0, 0.0),
+    vec3(0.0, 1.0, 0.0), vec3(0.0, 1.0, 0.0));
+
+const float AO_SHADE[4] = float[4](0.4, 0.6, 0.8, 1.0);
+const float MIN_AMBIENT = 0.10;  // Caves are never pitch black
 
 void main() {
-    fragTexCoord = vertexTexCoord;
-    fragColor = vertexColor;
-    fragNormal = normalize(vec3(matNormal * vec4(vertexNormal, 1.0)));
-    fragWorldPos = vec3(matModel * vec4(vertexPosition, 1.0));
-    gl_Position = mvp * vec4(vertexPosition, 1.0);
+    int face = int(mod(vertexPosition.w, 8.0));
+    float y_high = floor(vertexPosition.w / 8.0);
+    vec3 position = chunkOrigin + vec3(vertexPosition.x, vertexPosition.y + y_high * 256.0, vertexPosition.z);
+
+    float light = mod(vertexSurface.z, 16.0);
+    int ao = int(floor(vertexSurface.z / 16.0));
+    float light_factor = MIN_AMBIENT + (light / 15.0) * (1.0 - MIN_AMBIENT);
+    float brightness = FACE_SHADE[face] * light_factor * AO_SHADE[ao];
+
+    // Tile origin plus block-local tile coordinates; block.fs repeats the
+    // tile with fract(), so merged quads span many blocks
+    fragTexCoord = vertexSurface.xy * TILE_UV_SIZE + TILE_UV_PADDING;
+    fragTileLayer = vertexSurface.y * TILES_PER_ROW + vertexSurface.x;
+    fragTileCoord = vec2(dot(position, FACE_U[face]), dot(position, FACE_V[face]));
+    fragColor = vec4(vec3(brightness), 1.0);
+    fragNormal = FACE_NORMAL[face];
+    fragWorldPos = position;
+    gl_Position = u_view_proj * vec4(position, 1.0);
 }
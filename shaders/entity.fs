@@ -0,0 +1,11 @@
+#version 330
+
+// Input from vertex shader
+in vec4 fragColor;
+
+// Output
+out vec4 finalColor;
+
+void main() {
+    finalColor = fragColor;
+}
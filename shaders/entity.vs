@@ -0,0 +1,27 @@
+#version 330
+
+// Input vertex attributes
+in vec3 vertexPosition;
+
+// Per-instance transform; its bottom row carries the part color
+in mat4 instanceTransform;
+
+// Output to fragment shader
+out vec4 fragColor;
+
+// Uniforms
+uniform mat4 mvp;
+
+void main() {
+    fragColor = vec4(instanceTransform[0][3], instanceTransform[1][3],
+                     instanceTransform[2][3], instanceTransform[3][3]);
+
+    // Restore the affine bottom row before transforming
+    mat4 model = instanceTransform;
+    model[0][3] = 0.0;
+    model[1][3] = 0.0;
+    model[2][3] = 0.0;
+    model[3][3] = 1.0;
+
+    gl_Position = mvp * model * vec4(vertexPosition, 1.0);
+}
@@ -1,19 +1,42 @@
 #version 330
 
-// Input vertex attributes
-in vec3 vertexPosition;
-in vec2 vertexTexCoord;
-in vec4 vertexColor;
+// Per-instance attributes (one instance per particle)
+in vec4 instancePosition;   // xyz = center, w = size
+in vec4 instanceTexRect;    // u_min, v_min, u_max, v_max
+in vec4 instanceColor;
 
 // Output to fragment shader
 out vec2 fragTexCoord;
 out vec4 fragColor;
 
-// Uniforms
-uniform mat4 mvp;
+// Per-frame constants (must match FrameUniformData in frame_uniforms.h)
+layout(std140) uniform FrameUniforms {
+    mat4 u_view_proj;
+    vec4 u_camera_pos;      // xyz
+    vec4 u_camera_right;    // xyz
+    vec4 u_camera_up;       // xyz
+    vec4 u_camera_forward;  // xyz
+    vec4 u_ambient_light;   // rgb
+    vec4 u_fog_color;       // rgb
+    vec4 u_fog;             // start, end, underwater (0/1), time in seconds
+};
+
+// Quad corners of the two triangles (counter-clockwise)
+const vec2 corners[6] = vec2[6](
+    vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0),
+    vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0)
+);
 
 void main() {
-    fragTexCoord = vertexTexCoord;
-    fragColor = vertexColor;
-    gl_Position = mvp * vec4(vertexPosition, 1.0);
+    vec2 corner = corners[gl_VertexID];
+
+    // Billboard: offset the center along the camera axes
+    vec2 offset = (corner - 0.5) * instancePosition.w;
+    vec3 position = instancePosition.xyz + u_camera_right.xyz * offset.x + u_camera_up.xyz * offset.y;
+
+    // Bottom of the quad samples v_max (atlas v grows downward)
+    fragTexCoord = vec2(mix(instanceTexRect.x, instanceTexRect.z, corner.x),
+                        mix(instanceTexRect.w, instanceTexRect.y, corner.y));
+    fragColor = instanceColor;
+    gl_Position = u_view_proj * vec4(position, 1.0);
 }
@@ -0,0 +1,150 @@
+#version 330
+
+// Bakes the sky gradient, sun/moon glow and cloud layer into the
+// latitude-longitude sky LUT (sky.c re-runs it when time_of_day moves)
+
+in vec2 fragTexCoord;
+
+out vec4 finalColor;
+
+uniform vec3 u_sun_direction;
+uniform float u_time_of_day;
+
+const float PI = 3.14159265;
+
+// Hash function for cloud noise
+float hash(vec2 p) {
+    return fract(sin(dot(p, vec2(127.1, 311.7))) * 43758.5453);
+}
+
+// Smooth noise for clouds
+float noise(vec2 p) {
+    vec2 i = floor(p);
+    vec2 f = fract(p);
+    f = f * f * (3.0 - 2.0 * f);  // Smoothstep
+
+    float a = hash(i);
+    float b = hash(i + vec2(1.0, 0.0));
+    float c = hash(i + vec2(0.0, 1.0));
+    float d = hash(i + vec2(1.0, 1.0));
+
+    return mix(mix(a, b, f.x), mix(c, d, f.x), f.y);
+}
+
+// Fractal Brownian Motion for natural cloud shapes
+float fbm(vec2 p) {
+    float value = 0.0;
+    float amplitude = 0.5;
+    float frequency = 1.0;
+
+    for (int i = 0; i < 4; i++) {
+        value += amplitude * noise(p * frequency);
+        amplitude *= 0.5;
+        frequency *= 2.0;
+    }
+
+    return value;
+}
+
+void main() {
+    // Texel to direction: u = longitude (atan(z, x)), v = latitude (asin(y))
+    float lon = (fragTexCoord.x - 0.5) * 2.0 * PI;
+    float lat = (fragTexCoord.y - 0.5) * PI;
+    vec3 rayDir = vec3(cos(lat) * cos(lon), sin(lat), cos(lat) * sin(lon));
+
+    // Use ray Y component for vertical gradient (0 = horizon, 1 = zenith)
+    float y = rayDir.y * 0.5 + 0.5;
+    y = clamp(y, 0.0, 1.0);
+
+    // Sun height factor (0 = below horizon, 1 = directly overhead)
+    float sunHeight = u_sun_direction.y * 0.5 + 0.5;
+
+    // Zenith color (top of sky)
+    vec3 zenithDay = vec3(0.4, 0.6, 1.0);      // Bright blue
+    vec3 zenithNight = vec3(0.02, 0.02, 0.08); // Dark blue
+    vec3 zenithColor = mix(zenithNight, zenithDay, sunHeight);
+
+    // Horizon color
+    vec3 horizonDay = vec3(0.8, 0.85, 0.95);   // Light blue/white
+    vec3 horizonNight = vec3(0.05, 0.05, 0.1); // Dark
+    vec3 horizonSunset = vec3(1.0, 0.5, 0.2);  // Orange
+
+    // Blend horizon color based on sun position
+    vec3 horizonColor = mix(horizonNight, horizonDay, sunHeight);
+
+    // Add sunset/sunrise colors when sun is near horizon
+    float sunsetFactor = 1.0 - abs(u_sun_direction.y);
+    sunsetFactor = sunsetFactor * sunsetFactor * sunsetFactor;  // Make it more concentrated
+    horizonColor = mix(horizonColor, horizonSunset, sunsetFactor * 0.7);
+
+    // Blend between horizon and zenith based on vertical position
+    // Use a curve to make horizon color extend higher
+    float blend = pow(y, 0.5);  // Square root for smoother gradient
+    vec3 skyColor = mix(horizonColor, zenithColor, blend);
+
+    // Sun glow (the disc itself is drawn sharp by sky.fs)
+    if (u_sun_direction.y > -0.1) {
+        float sunDist = acos(clamp(dot(rayDir, u_sun_direction), -1.0, 1.0));
+
+        // Sun color - white/yellow core
+        vec3 sunColor = vec3(1.0, 0.95, 0.8);
+
+        // Make sun more orange near horizon
+        if (u_sun_direction.y < 0.3) {
+            float horizonFactor = 1.0 - (u_sun_direction.y / 0.3);
+            sunColor = mix(sunColor, vec3(1.0, 0.6, 0.2), horizonFactor * 0.7);
+        }
+
+        float sunGlow = exp(-sunDist * 8.0) * 0.4;
+        skyColor += sunColor * sunGlow * max(0.0, u_sun_direction.y + 0.1);
+    }
+
+    // Moon glow (visible when sun is below horizon)
+    if (u_sun_direction.y < 0.2) {
+        // Moon is opposite to sun
+        vec3 moonDir = -u_sun_direction;
+        float moonDist = acos(clamp(dot(rayDir, moonDir), -1.0, 1.0));
+
+        // Moon visibility increases as sun goes down
+        float moonVisibility = smoothstep(0.2, -0.1, u_sun_direction.y);
+
+        float moonGlow = exp(-moonDist * 10.0) * 0.15 * moonVisibility;
+        skyColor += vec3(0.7, 0.75, 0.9) * moonGlow;
+    }
+
+    // Add sun glow near horizon during sunset/sunrise
+    if (sunHeight < 0.5 && sunHeight > 0.1) {
+        float glowIntensity = (0.5 - sunHeight) * 2.0;
+        float horizonGlow = (1.0 - y) * glowIntensity;
+        skyColor += vec3(1.0, 0.4, 0.1) * horizonGlow * 0.5;
+    }
+
+    // Procedural clouds (daytime, above horizon)
+    if (sunHeight > 0.2 && rayDir.y > 0.1) {
+        // Project ray onto cloud plane at fixed height
+        vec2 cloudUV = rayDir.xz / max(rayDir.y, 0.1) * 2.0 + vec2(u_time_of_day * 0.01, 0.0);
+
+        // Generate cloud density using FBM
+        float cloudDensity = fbm(cloudUV);
+
+        // Threshold for cloud visibility
+        cloudDensity = smoothstep(0.4, 0.7, cloudDensity);
+
+        // Fade clouds near horizon
+        float cloudFade = smoothstep(0.1, 0.3, rayDir.y);
+
+        // Cloud color (white, lit by sun)
+        vec3 cloudColor = vec3(1.0);
+
+        // Add subtle orange tint during sunset
+        if (sunHeight < 0.4) {
+            float sunsetTint = 1.0 - (sunHeight / 0.4);
+            cloudColor = mix(cloudColor, vec3(1.0, 0.8, 0.6), sunsetTint * 0.5);
+        }
+
+        // Blend clouds into sky
+        skyColor = mix(skyColor, cloudColor, cloudDensity * cloudFade * 0.5 * sunHeight);
+    }
+
+    finalColor = vec4(skyColor, 1.0);
+}
@@ -0,0 +1,54 @@
+#version 330
+
+// Bakes the star field into the upper-hemisphere star map once at startup
+// rgb = star color * shape, a = twinkle phase (sky.fs animates it)
+
+in vec2 fragTexCoord;
+
+out vec4 finalColor;
+
+const float PI = 3.14159265;
+
+// Hash function for procedural stars
+float hash(vec2 p) {
+    return fract(sin(dot(p, vec2(127.1, 311.7))) * 43758.5453);
+}
+
+// Second hash for twinkle variation
+float hash2(vec2 p) {
+    return fract(sin(dot(p, vec2(269.5, 183.3))) * 43758.5453);
+}
+
+void main() {
+    // Texel to spherical star UV: u = longitude (atan(z, x)), v = elevation 0 - 90 degrees
+    vec2 starUV = vec2((fragTexCoord.x - 0.5) * 2.0 * PI, fragTexCoord.y * 0.5 * PI) * 25.0;
+    vec2 starCell = floor(starUV);
+    vec2 starPos = fract(starUV);
+
+    // Random star position within cell
+    float starRand = hash(starCell);
+    vec2 starOffset = vec2(hash(starCell + vec2(1.0, 0.0)), hash(starCell + vec2(0.0, 1.0)));
+
+    // Distance from star center
+    float dist = length(starPos - starOffset);
+
+    vec4 star = vec4(0.0);
+
+    // Star threshold (fewer stars = more sparse)
+    if (starRand > 0.95) {
+        float starBrightness = 1.0 - smoothstep(0.0, 0.1, dist);
+
+        // Vary star colors slightly
+        vec3 starColor = vec3(1.0);
+        float colorVar = hash2(starCell + vec2(5.0, 7.0));
+        if (colorVar > 0.8) {
+            starColor = vec3(1.0, 0.9, 0.8);  // Warm star
+        } else if (colorVar < 0.2) {
+            starColor = vec3(0.8, 0.9, 1.0);  // Cool star
+        }
+
+        star = vec4(starColor * starBrightness, starBrightness > 0.0 ? hash2(starCell) : 0.0);
+    }
+
+    finalColor = star;
+}
@@ -0,0 +1,75 @@
+#version 330
+
+in vec2 fragTileCoord;
+in vec4 fragColor;
+in vec3 fragWorldPos;
+in float fragSurface;
+
+out vec4 finalColor;
+
+uniform sampler2D texture0;
+uniform sampler2DArray u_tile_array;  // One mipmapped layer per tile (layer = row * 32 + column)
+uniform int u_use_tile_array;         // 0 = tile array unsupported, sample the 2D atlas
+// Per-frame constants (must match FrameUniformData in frame_uniforms.h)
+layout(std140) uniform FrameUniforms {
+    mat4 u_view_proj;
+    vec4 u_camera_pos;      // xyz
+    vec4 u_camera_right;    // xyz
+    vec4 u_camera_up;       // xyz
+    vec4 u_camera_forward;  // xyz
+    vec4 u_ambient_light;   // rgb
+    vec4 u_fog_color;       // rgb
+    vec4 u_fog;             // start, end, underwater (0/1), time in seconds
+};
+
+// Atlas constants (must match texture_atlas.h)
+const float TILES_PER_ROW = 32.0;
+const float TILE_UV_SIZE = 1.0 / TILES_PER_ROW;
+const float TILE_UV_PADDING = 0.001;
+
+// Water tile: row 6, column 0
+const vec2 WATER_TILE = vec2(0.0, 6.0);
+
+vec4 sample_water() {
+    if (u_use_tile_array == 1) {
+        return texture(u_tile_array, vec3(fragTileCoord, WATER_TILE.y * TILES_PER_ROW + WATER_TILE.x));
+    }
+    vec2 texCoord = WATER_TILE * TILE_UV_SIZE + TILE_UV_PADDING +
+                    fract(fragTileCoord) * (TILE_UV_SIZE - 2.0 * TILE_UV_PADDING);
+    return texture(texture0, texCoord);
+}
+
+void main() {
+    vec4 texColor = sample_water();
+
+    // Moving highlights on the open surface, replacing the old animation frames
+    float time = u_fog.w;
+    float shimmer = sin(fragWorldPos.x * 2.3 + time * 1.9) * sin(fragWorldPos.z * 2.1 - time * 1.4);
+    vec3 color = texColor.rgb * (1.0 + 0.08 * shimmer * fragSurface);
+
+    // Apply vertex color (light) and ambient light
+    color *= fragColor.rgb * u_ambient_light.rgb;
+
+    // Calculate distance fog
+    float dist = distance(fragWorldPos, u_camera_pos.xyz);
+    float fogFactor = clamp((dist - u_fog.x) / (u_fog.y - u_fog.x), 0.0, 1.0);
+
+    // Smooth quadratic fog curve
+    fogFactor = fogFactor * fogFactor;
+
+    // Apply underwater effects if submerged
+    if (u_fog.z > 0.5) {
+        // Blue tint underwater
+        color = mix(color, vec3(0.2, 0.4, 0.8), 0.3);
+
+        // Much shorter fog distance underwater
+        float underwaterFogFactor = clamp(dist / 32.0, 0.0, 1.0);
+        underwaterFogFactor = underwaterFogFactor * underwaterFogFactor;
+        color = mix(color, vec3(0.1, 0.3, 0.5), underwaterFogFactor);
+    } else {
+        // Normal fog
+        color = mix(color, u_fog_color.rgb, fogFactor);
+    }
+
+    finalColor = vec4(color, texColor.a);
+}
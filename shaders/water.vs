@@ -0,0 +1,71 @@
+#version 330
+
+// Packed water vertex (see chunk_water.h), bytes arrive as 0-255 floats
+layout(location = 0) in vec4 vertexPosition;  // x, y, z, face | surface bit << 4
+layout(location = 1) in vec4 vertexSurface;   // surface height, light, flow x, flow z
+layout(location = 2) in vec3 chunkOrigin;     // Chunk origin (generic value per draw)
+
+out vec2 fragTileCoord;
+out vec4 fragColor;
+out vec3 fragWorldPos;
+out float fragSurface;
+
+// Per-frame constants (must match FrameUniformData in frame_uniforms.h)
+layout(std140) uniform FrameUniforms {
+    mat4 u_view_proj;
+    vec4 u_camera_pos;      // xyz
+    vec4 u_camera_right;    // xyz
+    vec4 u_camera_up;       // xyz
+    vec4 u_camera_forward;  // xyz
+    vec4 u_ambient_light;   // rgb
+    vec4 u_fog_color;       // rgb
+    vec4 u_fog;             // start, end, underwater (0/1), time in seconds
+};
+
+// Per face (BlockFace order: top, bottom, front, back, left, right)
+const float FACE_SHADE[6] = float[6](1.0, 0.8, 0.9, 0.9, 0.95, 0.95);
+const vec3 FACE_U[6] = vec3[6](
+    vec3(1.0, 0.0, 0.0), vec3(1.0, 0.0, 0.0),
+    vec3(1.0, 0.0, 0.0), vec3(-1.0, 0.0, 0.0),
+    vec3(0.0, 0.0, -1.0), vec3(0.0, 0.0, 1.0));
+const vec3 FACE_V[6] = vec3[6](
+    vec3(0.0, 0.0, 1.0), vec3(0.0, 0.0, -1.0),
+    vec3(0.0, 1.0, 0.0), vec3(0.0, 1.0, 0.0),
+    vec3(0.0, 1.0, 0.0), vec3(0.0, 1.0, 0.0));
+
+const float MIN_AMBIENT = 0.10;   // Caves are never pitch black
+const float WAVE_DEPTH = 0.12;    // Waves only lower the surface, so it never pokes through blocks above
+const float FLOW_BIAS = 128.0;    // WATER_FLOW_BIAS
+const float FLOW_SPEED = 0.02;    // Tile scroll per second per unit of packed flow
+const float STILL_DRIFT = 0.05;   // Tile scroll per second of still water
+
+void main() {
+    int face = int(mod(vertexPosition.w, 8.0));
+    bool surface = vertexPosition.w >= 16.0;
+    float time = u_fog.w;
+
+    vec3 position = chunkOrigin + vec3(vertexPosition.x, vertexPosition.y + vertexSurface.x / 255.0,
+                                       vertexPosition.z);
+
+    // Waves are a function of the world position alone: corners shared by
+    // neighboring blocks (and chunks) move together
+    if (surface) {
+        float wave = sin(position.x * 0.8 + time * 1.7) + sin(position.z * 0.7 + time * 1.3) +
+                     sin((position.x + position.z) * 0.45 + time * 2.1);
+        position.y -= WAVE_DEPTH * (wave / 6.0 + 0.5);
+    }
+
+    // Tile scrolls downhill along the flow, still water drifts slowly
+    vec2 flow = vec2(vertexSurface.z, vertexSurface.w) - FLOW_BIAS;
+    vec2 scroll = face < 2 ? flow * FLOW_SPEED * time : vec2(0.0, -length(flow) * FLOW_SPEED * time);
+    scroll += vec2(STILL_DRIFT * time, 0.0);
+
+    float light = vertexSurface.y;
+    float light_factor = MIN_AMBIENT + (light / 15.0) * (1.0 - MIN_AMBIENT);
+
+    fragTileCoord = vec2(dot(position, FACE_U[face]), dot(position, FACE_V[face])) - scroll;
+    fragColor = vec4(vec3(FACE_SHADE[face] * light_factor), 1.0);
+    fragWorldPos = position;
+    fragSurface = surface ? 1.0 : 0.0;
+    gl_Position = u_view_proj * vec4(position, 1.0);
+}
@@ -0,0 +1,475 @@
+#define _POSIX_C_SOURCE 200112L
+/**
+ * Katalis Chunk Benchmark
+ *
+ * Headless: generates chunks for fixed seeds and times the terrain,
+ * decoration, light and mesh stages, first one chunk at a time on this
+ * thread (per-chunk percentiles, vertex and byte counts per mesher), then
+ * through the worker pool the game uses (throughput). No window or GPU is
+ * needed; meshes are staged and freed, never uploaded.
+ *
+ * Results go to stdout and, as JSON, to the output file so runs before and
+ * after an engine change can be compared.
+ *
+ * Usage: benchmark [chunks per seed] [output path]
+ */
+
+#include "voxel/core/block.h"
+#include "voxel/core/item.h"
+#include "voxel/world/chunk.h"
+#include "voxel/world/chunk_worker.h"
+#include "voxel/world/mesh_arena.h"
+#include "voxel/world/noise.h"
+#include "voxel/world/terrain.h"
+#include "voxel/entity/tree.h"
+#include "voxel/render/light.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define BENCH_DEFAULT_CHUNKS 256         // Meshed chunks per seed (rounded up to a square)
+#define BENCH_MAX_CHUNKS 4096
+#define BENCH_OUTPUT_PATH "bench_results.json"
+#define BENCH_POLL_NS 200000             // Sleep between worker pool polls (0.2 ms)
+
+// Fixed, so every run measures the same terrain
+static const uint32_t g_seeds[] = { 1, 1337, 20240601 };
+#define BENCH_SEED_COUNT ((int)(sizeof(g_seeds) / sizeof(g_seeds[0])))
+
+static const char* g_mesher_names[] = { "simple", "greedy" };
+#define BENCH_MESHER_COUNT 2
+
+// ============================================================================
+// SERIES
+// ============================================================================
+
+/**
+ * One measured quantity, a sample per chunk
+ */
+typedef struct {
+    const char* name;
+    const char* unit;
+    double* values;
+    int count;
+} BenchSeries;
+
+typedef struct {
+    int count;
+    double mean, p50, p90, p99, max, total;
+} BenchSummary;
+
+static bool series_init(BenchSeries* series, const char* name, const char* unit, int capacity) {
+    series->name = name;
+    series->unit = unit;
+    series->count = 0;
+    series->values = (double*)malloc((size_t)capacity * sizeof(double));
+    return series->values != NULL;
+}
+
+static void series_add(BenchSeries* series, double value) {
+    series->values[series->count++] = value;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Nearest-rank percentile of sorted values
+ */
+static double percentile(const double* sorted, int count, double p) {
+    int rank = (int)ceil(p * count);
+    if (rank < 1) rank = 1;
+    return sorted[rank - 1];
+}
+
+static BenchSummary series_summarize(BenchSeries* series) {
+    BenchSummary summary = {0};
+    summary.count = series->count;
+    if (series->count == 0) return summary;
+
+    qsort(series->values, (size_t)series->count, sizeof(double), compare_doubles);
+    for (int i = 0; i < series->count; i++) {
+        summary.total += series->values[i];
+    }
+    summary.mean = summary.total / series->count;
+    summary.p50 = percentile(series->values, series->count, 0.50);
+    summary.p90 = percentile(series->values, series->count, 0.90);
+    summary.p99 = percentile(series->values, series->count, 0.99);
+    summary.max = series->values[series->count - 1];
+    return summary;
+}
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+}
+
+static void sleep_poll(void) {
+    struct timespec ts = { 0, BENCH_POLL_NS };
+    nanosleep(&ts, NULL);
+}
+
+/**
+ * Grid of side + 2 chunks: the inner side x side are meshed, the ring
+ * around them only provides their borders
+ */
+static Chunk** grid_create(int side) {
+    int grid = side + 2;
+    Chunk** chunks = (Chunk**)calloc((size_t)(grid * grid), sizeof(Chunk*));
+    if (!chunks) return NULL;
+    for (int z = 0; z < grid; z++) {
+        for (int x = 0; x < grid; x++) {
+            chunks[z * grid + x] = chunk_create(x - 1, z - 1);
+            if (!chunks[z * grid + x]) return chunks;  // Caller checks every cell
+        }
+    }
+    return chunks;
+}
+
+static void grid_destroy(Chunk** chunks, int side) {
+    if (!chunks) return;
+    int grid = side + 2;
+    for (int i = 0; i < grid * grid; i++) {
+        chunk_destroy(chunks[i]);
+    }
+    free(chunks);
+}
+
+static bool grid_complete(Chunk** chunks, int side) {
+    if (!chunks) return false;
+    int grid = side + 2;
+    for (int i = 0; i < grid * grid; i++) {
+        if (!chunks[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * Border of the inner chunk at grid cell (x, z), from its 8 neighbors
+ */
+static ChunkBorder* grid_capture_border(Chunk** chunks, int side, int x, int z) {
+    int grid = side + 2;
+    ChunkBorder* border = chunk_border_alloc();
+    if (!border) return NULL;
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if (dx == 0 && dz == 0) continue;
+            chunk_border_capture(border, chunks[(z + dz) * grid + (x + dx)], dx, dz);
+        }
+    }
+    return border;
+}
+
+// ============================================================================
+// SINGLE THREAD
+// ============================================================================
+
+enum {
+    SERIES_TERRAIN,
+    SERIES_DECORATE,
+    SERIES_LIGHT,
+    SERIES_STORAGE_BYTES,
+    SERIES_MESH_MS,                                          // Then per mesher: ms, vertices, bytes
+    SERIES_COUNT = SERIES_MESH_MS + 3 * BENCH_MESHER_COUNT
+};
+
+static char g_mesh_series_names[3 * BENCH_MESHER_COUNT][64];
+
+static bool single_thread_init(BenchSeries series[SERIES_COUNT], int capacity) {
+    bool ok = series_init(&series[SERIES_TERRAIN], "terrain_generate_chunk", "ms", capacity) &&
+              series_init(&series[SERIES_DECORATE], "tree_generate_for_chunk", "ms", capacity) &&
+              series_init(&series[SERIES_LIGHT], "light_calculate_chunk", "ms", capacity) &&
+              series_init(&series[SERIES_STORAGE_BYTES], "storage_bytes_per_chunk", "bytes", capacity);
+    for (int m = 0; ok && m < BENCH_MESHER_COUNT; m++) {
+        static const char* kinds[3] = { "chunk_generate_mesh_staged", "vertices_per_chunk", "mesh_bytes_per_chunk" };
+        static const char* units[3] = { "ms", "vertices", "bytes" };
+        for (int k = 0; ok && k < 3; k++) {
+            char* name = g_mesh_series_names[m * 3 + k];
+            snprintf(name, sizeof(g_mesh_series_names[0]), "%s.%s", kinds[k], g_mesher_names[m]);
+            ok = series_init(&series[SERIES_MESH_MS + m * 3 + k], name, units[k], capacity);
+        }
+    }
+    return ok;
+}
+
+/**
+ * Generate and mesh one seed's grid on this thread, timing every call
+ */
+static bool single_thread_run(BenchSeries series[SERIES_COUNT], int side, TerrainParams params) {
+    Chunk** chunks = grid_create(side);
+    if (!grid_complete(chunks, side)) {
+        grid_destroy(chunks, side);
+        return false;
+    }
+
+    int grid = side + 2;
+    for (int i = 0; i < grid * grid; i++) {
+        Chunk* chunk = chunks[i];
+        double start = now_ms();
+        terrain_generate_chunk(chunk, params, NULL);
+        double terrain_end = now_ms();
+        tree_generate_for_chunk(chunk, NULL, NULL);
+        double decorate_end = now_ms();
+        light_calculate_chunk(chunk);
+        double light_end = now_ms();
+        chunk_update_empty_status(chunk);
+        chunk_update_surface(chunk);
+        chunk_set_state(chunk, CHUNK_STATE_GENERATED);
+
+        series_add(&series[SERIES_TERRAIN], terrain_end - start);
+        series_add(&series[SERIES_DECORATE], decorate_end - terrain_end);
+        series_add(&series[SERIES_LIGHT], light_end - decorate_end);
+        series_add(&series[SERIES_STORAGE_BYTES], (double)chunk_storage_bytes(chunk));
+    }
+
+    ChunkMesher original = chunk_get_mesher();
+    for (int m = 0; m < BENCH_MESHER_COUNT; m++) {
+        chunk_set_mesher((ChunkMesher)m);
+        for (int z = 1; z <= side; z++) {
+            for (int x = 1; x <= side; x++) {
+                Chunk* chunk = chunks[z * grid + x];
+                chunk->border = grid_capture_border(chunks, side, x, z);
+
+                StagedMesh mesh = {0};
+                double start = now_ms();
+                chunk_generate_mesh_staged(chunk, &mesh);
+                double elapsed = now_ms() - start;
+
+                int vertices = mesh.vertex_count + mesh.trans_vertex_count;
+                series_add(&series[SERIES_MESH_MS + m * 3], elapsed);
+                series_add(&series[SERIES_MESH_MS + m * 3 + 1], (double)vertices);
+                series_add(&series[SERIES_MESH_MS + m * 3 + 2], (double)vertices * sizeof(ChunkVertex));
+
+                staged_mesh_free(&mesh);
+                chunk_border_free(chunk->border);
+                chunk->border = NULL;
+            }
+        }
+    }
+    chunk_set_mesher(original);
+
+    grid_destroy(chunks, side);
+    return true;
+}
+
+// ============================================================================
+// WORKER POOL
+// ============================================================================
+
+typedef struct {
+    int threads;
+    int generated;
+    int meshed;
+    double generate_ms;     // Wall time: enqueue to all chunks GENERATED
+    double mesh_ms;         // Wall time: enqueue to all meshes polled
+    ChunkStageStats stages[CHUNK_STAGE_COUNT];
+} PoolResult;
+
+/**
+ * Push one seed's grid through the worker pool, as world streaming does
+ */
+static bool pool_run(ChunkWorker* worker, PoolResult* result, int side, TerrainParams params) {
+    Chunk** chunks = grid_create(side);
+    if (!grid_complete(chunks, side)) {
+        grid_destroy(chunks, side);
+        return false;
+    }
+
+    int grid = side + 2;
+    int total = grid * grid;
+    double start = now_ms();
+    for (int i = 0; i < total; i++) {
+        if (!chunk_worker_enqueue(worker, chunks[i], params)) {
+            printf("[BENCH] Failed to enqueue chunk (%d, %d)\n", chunks[i]->x, chunks[i]->z);
+            chunk_set_state(chunks[i], CHUNK_STATE_GENERATED);  // Counted as done, meshed against lit air
+        }
+    }
+    for (int done = 0; done < total; ) {
+        sleep_poll();
+        done = 0;
+        for (int i = 0; i < total; i++) {
+            if (chunk_get_state(chunks[i]) == CHUNK_STATE_GENERATED && !chunk_in_use(chunks[i])) done++;
+        }
+    }
+    double generated = now_ms();
+
+    int expected = 0;
+    for (int z = 1; z <= side; z++) {
+        for (int x = 1; x <= side; x++) {
+            ChunkBorder* border = grid_capture_border(chunks, side, x, z);
+            if (chunk_worker_enqueue_mesh(worker, chunks[z * grid + x], border)) expected++;
+        }
+    }
+    for (int polled = 0; polled < expected; ) {
+        CompletedChunk* completed = chunk_worker_poll_completed(worker);
+        if (!completed) {
+            sleep_poll();
+            continue;
+        }
+        chunk_worker_release_completed(completed);
+        polled++;
+    }
+    double meshed = now_ms();
+
+    result->generated += total;
+    result->meshed += expected;
+    result->generate_ms += generated - start;
+    result->mesh_ms += meshed - generated;
+
+    grid_destroy(chunks, side);
+    return true;
+}
+
+// ============================================================================
+// OUTPUT
+// ============================================================================
+
+static void print_series(BenchSeries* series, const BenchSummary* s) {
+    if (strcmp(series->unit, "ms") == 0) {
+        printf("[BENCH] %-42s mean %7.3f  p50 %7.3f  p90 %7.3f  p99 %7.3f  max %7.3f ms  (%.0f chunks/s)\n",
+               series->name, s->mean, s->p50, s->p90, s->p99, s->max,
+               s->total > 0.0 ? 1000.0 * s->count / s->total : 0.0);
+    } else {
+        printf("[BENCH] %-42s mean %9.0f  p50 %9.0f  p90 %9.0f  p99 %9.0f  max %9.0f %s\n",
+               series->name, s->mean, s->p50, s->p90, s->p99, s->max, series->unit);
+    }
+}
+
+static void write_json(const char* path, int chunks_per_seed, BenchSeries series[SERIES_COUNT],
+                       const BenchSummary summaries[SERIES_COUNT], const PoolResult* pool) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        printf("[BENCH] Failed to open %s\n", path);
+        return;
+    }
+
+    fprintf(file, "{\n  \"chunks_per_seed\": %d,\n  \"seeds\": [", chunks_per_seed);
+    for (int i = 0; i < BENCH_SEED_COUNT; i++) {
+        fprintf(file, "%s%u", i ? ", " : "", g_seeds[i]);
+    }
+    fprintf(file, "],\n  \"vertex_bytes\": %zu,\n", sizeof(ChunkVertex));
+
+    fprintf(file, "  \"single_thread\": {\n");
+    for (int i = 0; i < SERIES_COUNT; i++) {
+        const BenchSummary* s = &summaries[i];
+        fprintf(file, "    \"%s\": {\"unit\": \"%s\", \"count\": %d, \"mean\": %.4f, \"p50\": %.4f, "
+                      "\"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f}%s\n",
+                series[i].name, series[i].unit, s->count, s->mean, s->p50, s->p90, s->p99, s->max,
+                i + 1 < SERIES_COUNT ? "," : "");
+    }
+    fprintf(file, "  },\n");
+
+    static const char* stage_names[CHUNK_STAGE_COUNT] = { "terrain", "decorate", "light", "mesh" };
+    fprintf(file, "  \"worker_pool\": {\n    \"threads\": %d,\n    \"mesher\": \"%s\",\n", pool->threads,
+            g_mesher_names[chunk_get_mesher()]);
+    fprintf(file, "    \"generated_chunks\": %d,\n    \"generate_ms\": %.3f,\n    \"generate_chunks_per_sec\": %.1f,\n",
+            pool->generated, pool->generate_ms,
+            pool->generate_ms > 0.0 ? 1000.0 * pool->generated / pool->generate_ms : 0.0);
+    fprintf(file, "    \"meshed_chunks\": %d,\n    \"mesh_ms\": %.3f,\n    \"mesh_chunks_per_sec\": %.1f,\n",
+            pool->meshed, pool->mesh_ms, pool->mesh_ms > 0.0 ? 1000.0 * pool->meshed / pool->mesh_ms : 0.0);
+    fprintf(file, "    \"stages\": {\n");
+    for (int i = 0; i < CHUNK_STAGE_COUNT; i++) {
+        const ChunkStageStats* stats = &pool->stages[i];
+        fprintf(file, "      \"%s\": {\"runs\": %d, \"mean_ms\": %.4f, \"max_ms\": %.4f}%s\n", stage_names[i],
+                stats->runs, stats->runs ? stats->total_ms / stats->runs : 0.0, stats->max_ms,
+                i + 1 < CHUNK_STAGE_COUNT ? "," : "");
+    }
+    fprintf(file, "    }\n  }\n}\n");
+    fclose(file);
+    printf("[BENCH] Results written to %s\n", path);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char** argv) {
+    int chunks = argc > 1 ? atoi(argv[1]) : BENCH_DEFAULT_CHUNKS;
+    if (chunks < 1) chunks = BENCH_DEFAULT_CHUNKS;
+    if (chunks > BENCH_MAX_CHUNKS) chunks = BENCH_MAX_CHUNKS;
+    const char* output_path = argc > 2 ? argv[2] : BENCH_OUTPUT_PATH;
+
+    int side = (int)ceil(sqrt((double)chunks));
+    int per_seed = side * side;
+    int generated_per_seed = (side + 2) * (side + 2);
+    printf("[BENCH] %d meshed chunks per seed (%d generated), %d seeds\n",
+           per_seed, generated_per_seed, BENCH_SEED_COUNT);
+
+    block_system_init();
+    item_system_init();
+    TerrainParams params = terrain_default_params();
+
+    // === Single thread: per-call timings ===
+    BenchSeries series[SERIES_COUNT];
+    memset(series, 0, sizeof(series));
+    if (!single_thread_init(series, BENCH_SEED_COUNT * generated_per_seed)) {
+        printf("[BENCH] Out of memory\n");
+        return 1;
+    }
+
+    // Same arena use as a worker thread, so allocation cost matches
+    MeshArena arena;
+    mesh_arena_init(&arena);
+    mesh_arena_bind(&arena);
+    for (int i = 0; i < BENCH_SEED_COUNT; i++) {
+        noise_init(g_seeds[i]);
+        if (!single_thread_run(series, side, params)) {
+            printf("[BENCH] Out of memory generating seed %u\n", g_seeds[i]);
+            return 1;
+        }
+    }
+    mesh_arena_bind(NULL);
+    mesh_arena_destroy(&arena);
+
+    BenchSummary summaries[SERIES_COUNT];
+    printf("[BENCH] Single thread:\n");
+    for (int i = 0; i < SERIES_COUNT; i++) {
+        summaries[i] = series_summarize(&series[i]);
+        print_series(&series[i], &summaries[i]);
+    }
+
+    // === Worker pool: throughput ===
+    ChunkWorker* worker = chunk_worker_create();
+    if (!worker) return 1;
+
+    PoolResult pool = {0};
+    pool.threads = worker->thread_count;
+    for (int i = 0; i < BENCH_SEED_COUNT; i++) {
+        noise_init(g_seeds[i]);  // Workers are idle between seeds
+        if (!pool_run(worker, &pool, side, params)) {
+            printf("[BENCH] Out of memory generating seed %u\n", g_seeds[i]);
+            chunk_worker_destroy(worker);
+            return 1;
+        }
+    }
+    chunk_worker_get_stage_stats(worker, pool.stages);
+    chunk_worker_destroy(worker);
+
+    printf("[BENCH] Worker pool (%d threads, %s mesher):\n", pool.threads, g_mesher_names[chunk_get_mesher()]);
+    printf("[BENCH] generate %6d chunks in %8.1f ms (%.0f chunks/s)\n", pool.generated, pool.generate_ms,
+           pool.generate_ms > 0.0 ? 1000.0 * pool.generated / pool.generate_ms : 0.0);
+    printf("[BENCH] mesh     %6d chunks in %8.1f ms (%.0f chunks/s)\n", pool.meshed, pool.mesh_ms,
+           pool.mesh_ms > 0.0 ? 1000.0 * pool.meshed / pool.mesh_ms : 0.0);
+
+    write_json(output_path, per_seed, series, summaries, &pool);
+
+    for (int i = 0; i < SERIES_COUNT; i++) {
+        free(series[i].values);
+    }
+    return 0;
+}
@@ -10,8 +10,10 @@
 #include "voxel/world/world.h"
 #include "voxel/world/noise.h"
 #include "voxel/world/terrain.h"
+#include "voxel/world/column_cache.h"
 #include "voxel/world/raycast.h"
 #include "voxel/player/player.h"
+#include "voxel/player/flythrough.h"
 #include "voxel/core/texture_atlas.h"
 #include "voxel/core/item.h"
 #include "voxel/inventory/inventory_ui.h"
@@ -24,13 +26,25 @@
 #include "voxel/entity/pig.h"
 #include "voxel/render/sky.h"
 #include "voxel/render/particle.h"
+#include "voxel/render/entity_renderer.h"
+#include "voxel/render/light.h"
+#include "voxel/render/frame_uniforms.h"
 #include "voxel/entity/tree.h"
 #include "voxel/network/network.h"
 #include "voxel/ui/minimap.h"
 #include "voxel/world/chest.h"
+#include "voxel/world/region.h"
+#include "voxel/world/terrain_cache.h"
+#include "voxel/world/mesh_cache.h"
 #include "voxel/render/chunk_batcher.h"
+#include "voxel/render/chunk_pool.h"
+#include "voxel/render/chunk_mesh.h"
+#include "voxel/render/quality_governor.h"
+#include "voxel/core/memory.h"
 #include "voxel/core/settings_constants.h"
+#include "voxel/core/profiler.h"
 #include "voxel/ui/settings_menu.h"
+#include "voxel/ui/profiler_overlay.h"
 #include <raylib.h>
 #include <raymath.h>
 #include <rlgl.h>
@@ -51,6 +65,7 @@
 // ============================================================================
 
 static bool g_initialized = false;
+static GameOptions g_options = {0};
 
 typedef struct {
     World* world;
@@ -79,6 +94,13 @@ typedef struct {
     bool was_underwater;         // Previous underwater state for splash detection
     // Tunable settings
     GameSettings settings;       // In-game tunable parameters
+    // Fixed timestep
+    float tick_accumulator;      // Frame time not yet simulated (seconds)
+    // Adaptive quality
+    QualityGovernor governor;    // Trades view distance for frame rate (settings.adaptive_quality) and memory
+    // Flythrough benchmark (g_options.benchmark_flythrough)
+    Flythrough flythrough;       // Scripted camera and recorded frames
+    FlythroughFrame bench_frame; // Measurements of the frame in progress
 } GameState;
 
 static GameState g_state;
@@ -98,6 +120,27 @@ static MiningState g_mining = {0};
 // LIFECYCLE HOOKS (Internal)
 // ============================================================================
 
+/**
+ * Show spawn generation progress (WorldProgressFunc)
+ * Called inside the first frame, so each call presents one loading frame.
+ */
+static void draw_loading_screen(void* user, int ready, int total) {
+    (void)user;
+    int width = GetScreenWidth();
+    int height = GetScreenHeight();
+    int bar_width = width / 2;
+    int bar_x = (width - bar_width) / 2;
+    int bar_y = height / 2 + 10;
+
+    ClearBackground((Color){20, 20, 28, 255});
+    const char* text = "Generating world...";
+    DrawText(text, (width - MeasureText(text, 20)) / 2, height / 2 - 20, 20, RAYWHITE);
+    DrawRectangle(bar_x, bar_y, bar_width, 12, (Color){60, 60, 70, 255});
+    DrawRectangle(bar_x, bar_y, total > 0 ? bar_width * ready / total : 0, 12, (Color){100, 200, 100, 255});
+    EndDrawing();
+    BeginDrawing();
+}
+
 /**
  * Initialize game - called once on first frame
  */
@@ -113,20 +156,40 @@ static void game_init(void) {
     // Initialize block system
     block_system_init();
 
+    // Shared per-frame shader constants (shaders attach to it as they load)
+    frame_uniforms_init();
+
+    profiler_set_thread_name("main");
+
+    // Frame time and GPU time watch for the adaptive view distance
+    quality_governor_init(&g_state.governor);
+
     // Initialize texture atlas
     texture_atlas_init();
 
     // Initialize particle system (must be after texture atlas)
     particle_system_init();
 
+    // Initialize instanced entity rendering
+    entity_renderer_init();
+
     // Initialize item system
     item_system_init();
 
     // Initialize crafting system
     crafting_init();
 
-    // Initialize noise with random seed
-    uint32_t seed = (uint32_t)time(NULL);
+    // Open save directory; reuse its seed so saved chunks line up with new terrain.
+    // Benchmarks use a fixed seed and neither load nor save, so runs match
+    RegionStorage* storage = NULL;
+    uint32_t seed = FLYTHROUGH_SEED;
+    if (!g_options.benchmark_flythrough) {
+        storage = region_storage_create(SAVE_DIRECTORY);
+        if (!region_storage_read_seed(storage, &seed)) {
+            seed = (uint32_t)time(NULL);
+            region_storage_write_seed(storage, seed);
+        }
+    }
     noise_init(seed);
     printf("[GAME] Using world seed: %u\n", seed);
 
@@ -135,48 +198,28 @@ static void game_init(void) {
 
     // Create world with terrain parameters
     g_state.world = world_create(terrain_params);
-
-    // Generate procedural terrain
-    printf("[GAME] Generating procedural terrain...\n");
-    int chunks_generated = 0;
-    int chunks_empty = 0;
-    for (int cx = -3; cx <= 3; cx++) {
-        for (int cz = -3; cz <= 3; cz++) {
-            // Get or create chunk
-            Chunk* chunk = world_get_or_create_chunk(g_state.world, cx, cz);
-
-            // Generate terrain using noise
-            terrain_generate_chunk(chunk, terrain_params);
-
-            // Update empty status after terrain generation
-            chunk_update_empty_status(chunk);
-
-            // Generate mesh for this chunk
-            chunk_generate_mesh(chunk);
-
-            // Mark as complete so world_update() won't re-enqueue to worker
-            chunk->state = CHUNK_STATE_COMPLETE;
-
-            // Register with batcher for batched rendering
-            if (g_state.world->batcher) {
-                chunk_batcher_register_chunk(g_state.world->batcher, chunk);
-            }
-
-            chunks_generated++;
-            if (chunk->is_empty) {
-                chunks_empty++;
-            } else {
-                printf("[GAME] Chunk (%d, %d): mesh has %d vertices\n",
-                       cx, cz, chunk->mesh.vertexCount);
-            }
-        }
+    world_set_storage(g_state.world, storage);
+#if MESH_CACHE_ENABLED
+    if (storage) {
+        world_set_mesh_cache(g_state.world, mesh_cache_create(SAVE_DIRECTORY));
+    }
+#endif
+#if TERRAIN_CACHE_ENABLED
+    if (!g_options.benchmark_flythrough) {
+        world_set_terrain_cache(g_state.world, terrain_cache_create(TERRAIN_CACHE_DIRECTORY, seed, terrain_params));
     }
-    printf("[GAME] Generated %d chunks (%d empty, %d with blocks)\n",
-           chunks_generated, chunks_empty, chunks_generated - chunks_empty);
+#endif
+
+    // Generate the spawn area on the worker threads; play starts once the
+    // chunks around the player's feet are done, the rest streams in
+    printf("[GAME] Generating spawn area...\n");
+    double gen_start = GetTime();
+    world_prepare_spawn(g_state.world, 0, 0, SPAWN_READY_RADIUS, draw_loading_screen, NULL);
+    printf("[GAME] Spawn area ready in %.2f s\n", GetTime() - gen_start);
 
     // Get terrain height at spawn position and spawn player on surface
     int spawn_x = 0, spawn_z = 0;
-    int surface_height = terrain_get_height_at(spawn_x, spawn_z, terrain_params);
+    int surface_height = column_cache_get_height(g_state.world->columns, spawn_x, spawn_z);
     Vector3 spawn_position = {(float)spawn_x, (float)(surface_height + 2), (float)spawn_z};
     g_state.player = player_create(spawn_position);
 
@@ -188,21 +231,8 @@ static void game_init(void) {
     printf("[GAME] Player spawned at (%.1f, %.1f, %.1f)\n",
            spawn_position.x, spawn_position.y, spawn_position.z);
 
-    // Give player starting items for testing - stone tools in hotbar slots 0-2
-    Inventory* inv = g_state.player->inventory;
-    inv->hotbar[0] = (ItemStack){ITEM_STONE_PICKAXE, 1, 132, 132};
-    inv->hotbar[1] = (ItemStack){ITEM_STONE_SHOVEL, 1, 132, 132};
-    inv->hotbar[2] = (ItemStack){ITEM_STONE_AXE, 1, 132, 132};
-    // Blocks in slots 3-5
-    inv->hotbar[3] = (ItemStack){ITEM_WOOD_LOG, 16, 0, 0};
-    inv->hotbar[4] = (ItemStack){ITEM_DIRT, 64, 0, 0};
-    inv->hotbar[5] = (ItemStack){ITEM_COBBLESTONE, 32, 0, 0};
-    // New items for testing
-    inv->hotbar[6] = (ItemStack){ITEM_STONE_SWORD, 1, 132, 132};  // Sword for combat
-    inv->hotbar[7] = (ItemStack){ITEM_WOOL_WHITE, 16, 0, 0};   // Wool for bed crafting
-    inv->hotbar[8] = (ItemStack){ITEM_WOOD_PLANKS, 32, 0, 0};  // Planks for crafting
-    // Add some iron blocks for crafting (in main inventory)
-    inventory_add_item(inv, ITEM_IRON_BLOCK, 8);
+    // Give player starting items for testing
+    inventory_give_starting_items(g_state.player->inventory);
     printf("[GAME] Added starting items to inventory\n");
 
     // Initialize target block state
@@ -232,8 +262,35 @@ static void game_init(void) {
     g_state.settings.time_paused = false;
     g_state.settings.max_uploads_per_frame = SETTING_MAX_UPLOADS_DEFAULT;
     g_state.settings.show_debug_info = false;
+    g_state.settings.greedy_meshing = chunk_get_mesher() == CHUNK_MESHER_GREEDY;
+    g_state.settings.adaptive_quality = true;
     g_state.settings.mouse_sensitivity = SETTING_MOUSE_SENSITIVITY_DEFAULT;
 
+    // Distances from the command line
+    if (g_options.view_distance > 0) {
+        world_set_view_distance(g_state.world, g_options.view_distance);
+        g_state.settings.view_distance = world_get_view_distance(g_state.world);
+    }
+    if (g_options.lod_distance > 0) {
+        world_set_lod_distance(g_state.world, g_options.lod_distance);
+        g_state.settings.lod_distance = world_get_lod_distance(g_state.world);
+    }
+
+    // Memory budgets from the command line (the governor and eviction hold them)
+    if (g_options.heap_budget_mb > 0) {
+        memory_set_budget(MEMORY_HEAP, (size_t)g_options.heap_budget_mb * 1024 * 1024);
+    }
+    if (g_options.gpu_budget_mb > 0) {
+        memory_set_budget(MEMORY_GPU, (size_t)g_options.gpu_budget_mb * 1024 * 1024);
+    }
+
+    // Benchmark: fixed distances and lighting, the script drives the camera
+    if (g_options.benchmark_flythrough) {
+        g_state.settings.adaptive_quality = false;
+        g_state.settings.time_paused = true;
+        flythrough_init(&g_state.flythrough, spawn_position);
+    }
+
     // Create settings menu and link to pause menu
     SettingsMenu* settings_menu = settings_menu_create(&g_state.settings);
     pause_menu_set_settings(g_state.pause_menu, settings_menu, g_state.world);
@@ -280,6 +337,15 @@ static void place_bed(GameState* game, int x, int y, int z, BlockType bed_type)
     world_set_block(game->world, x + dx, y, z, (Block){BLOCK_BED_HEAD, 0, 0});
 }
 
+/**
+ * Loaded chunk containing a world block column (NULL if not loaded)
+ */
+static Chunk* get_block_chunk(int x, int z) {
+    int chunk_x, chunk_z;
+    world_to_chunk_coords(x, z, &chunk_x, &chunk_z);
+    return world_get_chunk(g_state.world, chunk_x, chunk_z);
+}
+
 /**
  * Try to sleep in a bed (skip to daytime if night)
  */
@@ -337,10 +403,48 @@ static void toggle_door(GameState* game, int x, int y, int z) {
     printf("[GAME] Door %s at (%d, %d, %d)\n", is_open ? "closed" : "opened", x, y, z);
 }
 
+/**
+ * Benchmark update: the flythrough script moves the player, input is ignored
+ */
+static void game_update_flythrough(float dt) {
+    g_state.bench_frame.segment = g_state.flythrough.segment;
+    Vector3 before = g_state.player->position;
+    if (!flythrough_step(&g_state.flythrough, g_state.player, g_state.world)) {
+        flythrough_write_report(&g_state.flythrough, g_options.report_path, g_state.world);
+        g_state.should_exit = true;
+        return;
+    }
+
+    int player_chunk_x, player_chunk_z;
+    world_to_chunk_coords((int)floorf(g_state.player->position.x), (int)floorf(g_state.player->position.z),
+                          &player_chunk_x, &player_chunk_z);
+    // The script moves the player directly; its velocity stays zero
+    if (dt > 0.0f) {
+        world_set_velocity(g_state.world, (g_state.player->position.x - before.x) / dt,
+                           (g_state.player->position.z - before.z) / dt);
+    }
+    double update_start = GetTime();
+    world_update(g_state.world, player_chunk_x, player_chunk_z);
+    g_state.bench_frame.world_update_ms = (float)((GetTime() - update_start) * 1000.0);
+
+    particle_system_update(dt);
+    minimap_update(g_state.minimap, g_state.world, g_state.player);
+    g_state.has_target_block = false;
+    g_state.target_entity = NULL;
+}
+
 /**
  * Update game logic - called every frame with delta time
  */
 static void game_update(float dt) {
+    PROFILE_BEGIN(PROFILE_GAME_UPDATE);
+
+    if (g_options.benchmark_flythrough) {
+        game_update_flythrough(dt);
+        PROFILE_END(PROFILE_GAME_UPDATE);
+        return;
+    }
+
     // Block ALL input when window is not focused
     bool window_focused = IsWindowFocused();
 
@@ -404,14 +508,6 @@ static void game_update(float dt) {
         g_state.view_mode_message_timer -= dt;
     }
 
-    // Update time of day
-    if (!g_state.settings.time_paused) {
-        g_state.time_of_day += g_state.settings.day_speed * dt;
-        if (g_state.time_of_day >= 24.0f) {
-            g_state.time_of_day -= 24.0f;
-        }
-    }
-
     // Debug: Toggle time pause with T key - only when pause menu closed
     if (!menu_blocking_input && IsKeyPressed(KEY_T)) {
         g_state.settings.time_paused = !g_state.settings.time_paused;
@@ -431,15 +527,27 @@ static void game_update(float dt) {
         printf("[TIME] Speed decreased to %.1fx\n", g_state.settings.day_speed);
     }
 
+    // Profiler overlay (F3) and a trace capture of the next frames (F4)
+    if (!menu_blocking_input && IsKeyPressed(KEY_F3)) {
+        g_state.settings.show_debug_info = !g_state.settings.show_debug_info;
+    }
+    if (!menu_blocking_input && IsKeyPressed(KEY_F4)) {
+        profiler_start_capture();
+    }
+
     // View distance controls with [ and ] keys (like Luanti)
     if (!menu_blocking_input && IsKeyPressed(KEY_RIGHT_BRACKET)) {  // ] key - increase
         int current = world_get_view_distance(g_state.world);
         world_set_view_distance(g_state.world, current + 1);
+        g_state.settings.view_distance = world_get_view_distance(g_state.world);  // New bound for the governor
+        quality_governor_reset(&g_state.governor);
         g_state.view_dist_message_timer = MESSAGE_DISPLAY_TIME;
     }
     if (!menu_blocking_input && IsKeyPressed(KEY_LEFT_BRACKET)) {  // [ key - decrease
         int current = world_get_view_distance(g_state.world);
         world_set_view_distance(g_state.world, current - 1);
+        g_state.settings.view_distance = world_get_view_distance(g_state.world);
+        quality_governor_reset(&g_state.governor);
         g_state.view_dist_message_timer = MESSAGE_DISPLAY_TIME;
     }
 
@@ -482,20 +590,12 @@ static void game_update(float dt) {
     int player_chunk_x, player_chunk_z;
     world_to_chunk_coords((int)g_state.player->position.x, (int)g_state.player->position.z,
                           &player_chunk_x, &player_chunk_z);
+    world_set_velocity(g_state.world, g_state.player->velocity.x, g_state.player->velocity.z);
     world_update(g_state.world, player_chunk_x, player_chunk_z);
 
-    // Sync time of day to world for entity lighting
-    g_state.world->time_of_day = g_state.time_of_day;
-
-    // Update all entities
-    entity_manager_update(g_state.entity_manager, (struct World*)g_state.world, dt);
-
     // Update particle system
     particle_system_update(dt);
 
-    // Update leaf decay
-    leaf_decay_update(g_state.world, dt);
-
     // Update minimap
     minimap_update(g_state.minimap, g_state.world, g_state.player);
 
@@ -527,48 +627,29 @@ static void game_update(float dt) {
             // Swing animation for attack
             player_start_swing(g_state.player);
 
-            // Damage the sheep
+            // Damage the sheep (a host's sheep is damaged by the host too)
+            network_entity_hit(g_state.network, g_state.target_entity, 1);
             bool died = sheep_damage(g_state.target_entity, 1);
 
             if (died) {
-                // Drop 1-2 meat
-                int meat_count = 1 + (rand() % 2);
-                inventory_add_item(g_state.player->inventory, ITEM_MEAT, meat_count);
-
-                // Drop 1-3 wool (based on sheep's wool color)
-                SheepData* sheep_data = (SheepData*)g_state.target_entity->data;
-                if (sheep_data) {
-                    int wool_count = 1 + (rand() % 3);
-                    Color wool_color = sheep_data->wool_color;
-
-                    // Map wool color to wool item type
-                    ItemType wool_item = ITEM_WOOL_WHITE;  // Default
-
-                    // Simple color matching (based on RGB values)
-                    if (wool_color.r > 230 && wool_color.g > 230 && wool_color.b > 230) {
-                        wool_item = ITEM_WOOL_WHITE;
-                    } else if (wool_color.r < 60 && wool_color.g < 60 && wool_color.b < 60) {
-                        wool_item = ITEM_WOOL_BLACK;
-                    } else if (wool_color.r > 180 && wool_color.g < 80 && wool_color.b < 80) {
-                        wool_item = ITEM_WOOL_RED;
-                    } else if (wool_color.r < 100 && wool_color.g > 100 && wool_color.b < 100) {
-                        wool_item = ITEM_WOOL_GREEN;
-                    } else if (wool_color.r < 100 && wool_color.g < 100 && wool_color.b > 150) {
-                        wool_item = ITEM_WOOL_BLUE;
-                    } else {
-                        // Default to light gray for other colors
-                        wool_item = ITEM_WOOL_LIGHT_GRAY;
+                // Our own sheep drop here; a host's go to the inventory it keeps for us
+                if (g_state.target_entity->remote_id == 0) {
+                    ItemStack drops[SHEEP_DROP_STACKS];
+                    int drop_count = sheep_get_drops(g_state.target_entity, drops);
+                    for (int i = 0; i < drop_count; i++) {
+                        inventory_add_item(g_state.player->inventory, drops[i].type, drops[i].count);
                     }
+                }
+                printf("[GAME] Sheep killed!\n");
 
-                    inventory_add_item(g_state.player->inventory, wool_item, wool_count);
-                    printf("[GAME] Sheep killed! Dropped %d meat and %d wool\n", meat_count, wool_count);
+                // Remove entity from manager and destroy; a host's copy is
+                // hidden until the host's removal reaches us
+                if (g_state.target_entity->remote_id == 0) {
+                    entity_manager_remove(g_state.entity_manager, g_state.target_entity);
+                    entity_destroy(g_state.target_entity);
                 } else {
-                    printf("[GAME] Sheep killed! Dropped %d meat\n", meat_count);
+                    g_state.target_entity->active = false;
                 }
-
-                // Remove entity from manager and destroy
-                entity_manager_remove(g_state.entity_manager, g_state.target_entity);
-                entity_destroy(g_state.target_entity);
                 g_state.target_entity = NULL;
             }
         }
@@ -576,18 +657,29 @@ static void game_update(float dt) {
             // Swing animation for attack
             player_start_swing(g_state.player);
 
-            // Damage the pig
+            // Damage the pig (a host's pig is damaged by the host too)
+            network_entity_hit(g_state.network, g_state.target_entity, 1);
             bool died = pig_damage(g_state.target_entity, 1);
 
             if (died) {
-                // Drop 1-3 meat (pigs drop more)
-                int meat_count = 1 + (rand() % 3);
-                inventory_add_item(g_state.player->inventory, ITEM_MEAT, meat_count);
-                printf("[GAME] Pig killed! Dropped %d meat\n", meat_count);
-
-                // Remove entity from manager and destroy
-                entity_manager_remove(g_state.entity_manager, g_state.target_entity);
-                entity_destroy(g_state.target_entity);
+                // Our own pigs drop here; a host's go to the inventory it keeps for us
+                if (g_state.target_entity->remote_id == 0) {
+                    ItemStack drops[PIG_DROP_STACKS];
+                    int drop_count = pig_get_drops(g_state.target_entity, drops);
+                    for (int i = 0; i < drop_count; i++) {
+                        inventory_add_item(g_state.player->inventory, drops[i].type, drops[i].count);
+                    }
+                }
+                printf("[GAME] Pig killed!\n");
+
+                // Remove entity from manager and destroy; a host's copy is
+                // hidden until the host's removal reaches us
+                if (g_state.target_entity->remote_id == 0) {
+                    entity_manager_remove(g_state.entity_manager, g_state.target_entity);
+                    entity_destroy(g_state.target_entity);
+                } else {
+                    g_state.target_entity->active = false;
+                }
                 g_state.target_entity = NULL;
             }
         }
@@ -664,17 +756,15 @@ static void game_update(float dt) {
                     ItemStack drop = item_get_block_drop(block.type);
 
                     if (drop.type != ITEM_NONE) {
-                        // Try to add to inventory
-                        if (inventory_add_item(g_state.player->inventory, drop.type, drop.count)) {
+                        // Try to add to inventory (a host validates the drop)
+                        if (inventory_add_block_drop(g_state.player->inventory, x, y, z, block.type)) {
                             // Success - remove block
                             Block air_block = {BLOCK_AIR, 0, 0};
                             world_set_block(g_state.world, x, y, z, air_block);
                             network_broadcast_block_change(g_state.network, x, y, z, BLOCK_AIR, 0);
 
-                            // If wood was removed, trigger leaf decay
-                            if (block.type == BLOCK_WOOD) {
-                                leaf_decay_on_wood_removed(g_state.world, x, y, z);
-                            }
+                            // Leaves that depended on a removed log or leaf decay
+                            leaf_decay_on_block_removed(g_state.world, x, y, z, block);
 
                             // Consume tool durability
                             if (held && held->type != ITEM_NONE) {
@@ -727,17 +817,13 @@ static void game_update(float dt) {
 
             if (target_block.type == BLOCK_CHEST) {
                 // Open the chest
-                ChestData* chest = chest_get(g_state.world->chest_registry, target_x, target_y, target_z);
-                if (!chest) {
-                    // First time opening - create chest data and generate loot
-                    chest = chest_create(g_state.world->chest_registry, target_x, target_y, target_z);
-                    if (chest) {
-                        unsigned int loot_seed = (unsigned int)(target_x * 73856093 ^ target_y * 19349663 ^ target_z * 83492791);
-                        chest_generate_dungeon_loot(chest, loot_seed);
-                    }
-                }
+                // First time opening creates the chest data and its loot
+                Chunk* chest_chunk = get_block_chunk(target_x, target_z);
+                ChestData* chest = chest_open(chest_chunk, target_x, target_y, target_z);
 
                 if (chest) {
+                    // A client is sent the host's contents
+                    network_open_chest(g_state.network, target_x, target_y, target_z);
                     g_state.open_chest = chest;
                     EnableCursor();
                     printf("[GAME] Opened chest at (%d, %d, %d)\n", target_x, target_y, target_z);
@@ -848,6 +934,10 @@ static void game_update(float dt) {
 
         if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
             inventory_ui_handle_chest_click(g_state.open_chest, g_state.player->inventory, mouse_x, mouse_y);
+
+            // Chest contents are saved with their chunk
+            Chunk* chest_chunk = get_block_chunk(g_state.open_chest->x, g_state.open_chest->z);
+            if (chest_chunk) chest_chunk->needs_save = true;
         }
     }
 
@@ -904,7 +994,9 @@ static void game_update(float dt) {
     pause_menu_update(g_state.pause_menu, dt);
 
     // Update network (always, even when paused)
+    PROFILE_BEGIN(PROFILE_NETWORK_POLL);
     network_update(g_state.network, dt);
+    PROFILE_END(PROFILE_NETWORK_POLL);
 
     // Pause menu interaction (only when pause menu is open and window focused)
     if (pause_menu_is_open(g_state.pause_menu) && window_focused) {
@@ -1009,6 +1101,41 @@ static void game_update(float dt) {
             EnableCursor();
         }
     }
+
+    PROFILE_END(PROFILE_GAME_UPDATE);
+}
+
+/**
+ * Advance the simulation by one fixed tick (GAME_TICK_DT)
+ * Water, mobs, leaf decay and the clock run here, so their speed does not
+ * depend on the frame rate. Input, the player and the UI stay per frame.
+ */
+static void game_tick(float dt) {
+    PROFILE_BEGIN(PROFILE_GAME_TICK);
+
+    // Update time of day
+    if (!g_state.settings.time_paused) {
+        g_state.time_of_day += g_state.settings.day_speed * dt;
+        if (g_state.time_of_day >= 24.0f) {
+            g_state.time_of_day -= 24.0f;
+        }
+    }
+
+    // Sync time of day to world for entity lighting
+    g_state.world->time_of_day = g_state.time_of_day;
+
+    // Update all entities
+    PROFILE_BEGIN(PROFILE_ENTITY_UPDATE);
+    entity_manager_update(g_state.entity_manager, (struct World*)g_state.world, dt);
+    PROFILE_END(PROFILE_ENTITY_UPDATE);
+
+    // Update leaf decay
+    leaf_decay_update(g_state.world, dt);
+
+    // Water flow
+    world_tick(g_state.world);
+
+    PROFILE_END(PROFILE_GAME_TICK);
 }
 
 /**
@@ -1025,7 +1152,9 @@ static bool is_camera_underwater(Vector3 camera_pos, World* world) {
     return block.type == BLOCK_WATER;
 }
 
-static void game_draw(void) {
+static void game_draw(float alpha) {
+    PROFILE_BEGIN(PROFILE_GAME_DRAW);
+
     // 3D rendering with player camera
     Camera3D camera = player_get_camera(g_state.player);
 
@@ -1035,8 +1164,11 @@ static void game_draw(void) {
     // Clear background
     ClearBackground(BLACK);  // Clear to black first
 
+    // Camera, fog and light for the sky, block and particle shaders
+    world_update_frame_uniforms(g_state.world, camera, g_state.time_of_day, underwater);
+
     // Render sky BEFORE 3D scene
-    sky_render(camera, g_state.time_of_day);
+    sky_render(g_state.time_of_day);
 
     BeginMode3D(camera);
 
@@ -1044,18 +1176,26 @@ static void game_draw(void) {
     rlDisableBackfaceCulling();
 
     // === PASS 1: Draw all OPAQUE chunks (with depth write ON) ===
-    world_render_with_time(g_state.world, g_state.time_of_day, camera.position, underwater);
+    quality_governor_begin_gpu(&g_state.governor);
+    PROFILE_BEGIN(PROFILE_RENDER_OPAQUE);
+    world_render_opaque(g_state.world, camera.position);
+    PROFILE_END(PROFILE_RENDER_OPAQUE);
 
     // === PASS 2: Draw all entities (before transparent blocks) ===
     // Entities are opaque and need to be in depth buffer before transparent pass
-    entity_manager_render(g_state.entity_manager);
+    PROFILE_BEGIN(PROFILE_RENDER_ENTITIES);
+    entity_manager_render(g_state.entity_manager, alpha);
     player_render_model(g_state.player);
+    PROFILE_END(PROFILE_RENDER_ENTITIES);
 
     // === PASS 3: Draw all TRANSPARENT chunks (with depth write OFF) ===
     // This ensures blocks behind leaves are visible, and entities behind leaves are occluded
+    PROFILE_BEGIN(PROFILE_RENDER_TRANSPARENT);
     rlDisableDepthMask();  // Disable depth write
-    world_render_transparent_with_time(g_state.world, g_state.time_of_day, camera.position, underwater);
+    world_render_transparent(g_state.world, camera.position);
     rlEnableDepthMask();   // Re-enable depth write
+    PROFILE_END(PROFILE_RENDER_TRANSPARENT);
+    quality_governor_end_gpu(&g_state.governor);
 
     // Draw wireframe around targeted block
     if (g_state.has_target_block) {
@@ -1129,6 +1269,8 @@ static void game_draw(void) {
 
     EndMode3D();
 
+    PROFILE_BEGIN(PROFILE_RENDER_UI);
+
     // === HUD LAYER: Clear depth buffer so HUD is ALWAYS on top ===
     glClear(GL_DEPTH_BUFFER_BIT);
 
@@ -1330,10 +1472,18 @@ static void game_draw(void) {
         }
     }
 
+    // Frame and worker timings (F3)
+    if (g_state.settings.show_debug_info) {
+        profiler_overlay_draw();
+    }
+
     // Draw pause menu if open (rendered on top of everything)
     if (pause_menu_is_open(g_state.pause_menu)) {
         pause_menu_draw(g_state.pause_menu);
     }
+
+    PROFILE_END(PROFILE_RENDER_UI);
+    PROFILE_END(PROFILE_GAME_DRAW);
 }
 
 // ============================================================================
@@ -1355,6 +1505,8 @@ void game_shutdown(void) {
         g_state.network = NULL;
     }
 
+    quality_governor_destroy(&g_state.governor);
+
     // Destroy minimap (has RenderTexture)
     if (g_state.minimap) {
         minimap_destroy(g_state.minimap);
@@ -1379,6 +1531,9 @@ void game_shutdown(void) {
         g_state.pause_menu = NULL;
     }
 
+    // Release cached inventory panels
+    inventory_ui_unload();
+
     // Destroy player
     if (g_state.player) {
         player_destroy(g_state.player);
@@ -1394,9 +1549,20 @@ void game_shutdown(void) {
     // Destroy sky shader
     sky_destroy();
 
+    // Destroy entity renderer
+    entity_renderer_destroy();
+
     // Destroy texture atlas
     texture_atlas_destroy();
 
+    // Destroy frame uniform buffer
+    frame_uniforms_destroy();
+
+    // Capture buffer (worker and water threads stopped with the world)
+    profiler_shutdown();
+
+    flythrough_destroy(&g_state.flythrough);
+
     g_initialized = false;
     printf("[GAME] Shutdown complete\n");
 }
@@ -1405,6 +1571,14 @@ void game_shutdown(void) {
 // MAIN ENTRY POINT (Public)
 // ============================================================================
 
+void game_set_options(const GameOptions* options) {
+    if (options) g_options = *options;
+}
+
+bool game_should_exit(void) {
+    return g_state.should_exit;
+}
+
 /**
  * Game entry point - called every frame by main loop
  *
@@ -1429,8 +1603,45 @@ void game_run(void) {
         return;
     }
 
-    // Every frame: update then draw
+    // Every frame: input and streaming, then as many fixed ticks as the
+    // frame time covers, then draw between the last two ticks
     float dt = GetFrameTime(); // Delta time in seconds
+    double frame_start = GetTime();
+    profiler_set_enabled(g_state.settings.show_debug_info);
     game_update(dt);
-    game_draw();
+
+    g_state.tick_accumulator += dt;
+    int ticks = 0;
+    while (g_state.tick_accumulator >= GAME_TICK_DT) {
+        if (ticks == GAME_MAX_TICKS_PER_FRAME) {
+            g_state.tick_accumulator = 0.0f;  // Far behind (loading, window drag): drop the backlog
+            break;
+        }
+        game_tick(GAME_TICK_DT);
+        g_state.tick_accumulator -= GAME_TICK_DT;
+        ticks++;
+    }
+
+    chunk_mesh_reset_draw_calls();
+    game_draw(g_state.tick_accumulator / GAME_TICK_DT);
+    profiler_frame_end();
+
+    if (g_options.benchmark_flythrough && !g_state.should_exit) {
+        FlythroughFrame* frame = &g_state.bench_frame;
+        frame->frame_ms = dt * 1000.0f;
+        frame->busy_ms = (float)((GetTime() - frame_start) * 1000.0);
+        frame->uploads = g_state.world->frame_stats.uploads;
+        frame->upload_bytes = g_state.world->frame_stats.upload_bytes;
+        frame->batch_rebuilds = g_state.world->frame_stats.batch_rebuilds;
+        frame->draw_calls = chunk_mesh_get_stats().draw_calls;
+        frame->chunks_loaded = g_state.world->chunks->chunk_count;
+        flythrough_record(&g_state.flythrough, frame);
+    }
+
+    // Within the settings' distances, which stay the upper bounds; memory
+    // budgets are held even without adaptive quality
+    float busy_ms = (float)((GetTime() - frame_start) * 1000.0);
+    quality_governor_update(&g_state.governor, g_state.world, dt * 1000.0f, busy_ms,
+                            g_state.settings.view_distance, g_state.settings.lod_distance,
+                            g_state.settings.adaptive_quality);
 }
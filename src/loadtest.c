@@ -0,0 +1,712 @@
+#define _POSIX_C_SOURCE 200112L
+/**
+ * Katalis Network Load Test
+ *
+ * Headless bot clients: N NetClients connect to a host and fly scripted
+ * circles around spawn, sending their state at the game's rate and placing
+ * and clearing a block above their heads at a fixed interval. Each client's
+ * link can be given latency, jitter and datagram loss.
+ *
+ * Measured over the run:
+ * - bandwidth and packet rates per client, both directions
+ * - end-to-end state latency: a bot changes its hotbar slot and the other
+ *   bots time until they see the change in a snapshot
+ * - block edit latency: from a bot sending an edit until another bot
+ *   receives it from the host
+ * - with the embedded host (no --connect), the host's tick time and the
+ *   network share of it
+ *
+ * All bots run in this process on one clock, so latencies need no clock
+ * sync. They include this loop's polling interval (1 / LOADTEST_RATE).
+ *
+ * Usage: loadtest [--bots N] [--duration S] [--connect HOST] [--port P]
+ *                 [--latency MS] [--jitter MS] [--loss PERCENT]
+ *                 [--spread BLOCKS] [--edit-interval S] [--report PATH]
+ */
+
+#include "voxel/core/block.h"
+#include "voxel/core/item.h"
+#include "voxel/world/world.h"
+#include "voxel/world/noise.h"
+#include "voxel/world/terrain.h"
+#include "voxel/entity/entity.h"
+#include "voxel/entity/tree.h"
+#include "voxel/inventory/inventory.h"
+#include "voxel/inventory/crafting.h"
+#include "voxel/player/player.h"
+#include "voxel/network/network.h"
+#include <math.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define LOADTEST_DEFAULT_BOTS 16
+#define LOADTEST_DEFAULT_DURATION 60.0f     // Measured seconds, after every bot connected
+#define LOADTEST_RATE 100                   // Bot polls per second
+#define LOADTEST_STATE_INTERVAL (1.0f / 15.0f)  // Same state rate as the game (network_create)
+#define LOADTEST_CONNECT_TIMEOUT 10.0f      // Seconds for all bots to connect
+#define LOADTEST_SPREAD 96.0f               // Radius the bots' circles spread over (blocks)
+#define LOADTEST_HEIGHT 100.0f              // Flying height (feet)
+#define LOADTEST_SPEED 5.6f                 // Blocks per second
+#define LOADTEST_EDIT_INTERVAL 1.0f         // Seconds between a bot's block edits
+#define LOADTEST_EDIT_CLEAR 0.2f            // Seconds a placed block stays
+#define LOADTEST_EDIT_HEIGHT 3              // Edits this far above the feet (host allows 8)
+#define LOADTEST_PROBE_INTERVAL 0.5f        // Seconds between hotbar slot changes
+#define LOADTEST_EDIT_HISTORY 4096          // Recent edits matched against received ones
+#define LOADTEST_SEED 20240601u             // Embedded host's world seed
+#define LOADTEST_REPORT_PATH "loadtest_report.json"
+
+#define LOADTEST_MAX_BOTS (NET_MAX_CLIENTS - 1)  // Slot 0 is the host
+#define LOADTEST_NO_SLOT 0xFF
+
+// ============================================================================
+// SERIES
+// ============================================================================
+
+/**
+ * Samples of one measured quantity (grows as needed)
+ */
+typedef struct {
+    const char* name;
+    const char* unit;
+    double* values;
+    int count;
+    int capacity;
+} LoadSeries;
+
+typedef struct {
+    int count;
+    double mean, p50, p90, p99, max;
+} LoadSummary;
+
+static void series_add(LoadSeries* series, double value) {
+    if (series->count == series->capacity) {
+        int capacity = series->capacity ? series->capacity * 2 : 1024;
+        double* grown = (double*)realloc(series->values, (size_t)capacity * sizeof(double));
+        if (!grown) return;
+        series->values = grown;
+        series->capacity = capacity;
+    }
+    series->values[series->count++] = value;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Nearest-rank percentile of sorted values
+ */
+static double percentile(const double* sorted, int count, double p) {
+    int rank = (int)ceil(p * count);
+    if (rank < 1) rank = 1;
+    return sorted[rank - 1];
+}
+
+static LoadSummary series_summarize(LoadSeries* series) {
+    LoadSummary summary = {0};
+    summary.count = series->count;
+    if (series->count == 0) return summary;
+
+    qsort(series->values, (size_t)series->count, sizeof(double), compare_doubles);
+    double total = 0.0;
+    for (int i = 0; i < series->count; i++) {
+        total += series->values[i];
+    }
+    summary.mean = total / series->count;
+    summary.p50 = percentile(series->values, series->count, 0.50);
+    summary.p90 = percentile(series->values, series->count, 0.90);
+    summary.p99 = percentile(series->values, series->count, 0.99);
+    summary.max = series->values[series->count - 1];
+    return summary;
+}
+
+enum {
+    SERIES_CONNECT,
+    SERIES_STATE_LATENCY,
+    SERIES_EDIT_LATENCY,
+    SERIES_KBPS_IN,
+    SERIES_KBPS_OUT,
+    SERIES_PACKETS_IN,
+    SERIES_PACKETS_OUT,
+    SERIES_HOST_TICK,
+    SERIES_HOST_NETWORK,
+    SERIES_COUNT
+};
+
+static LoadSeries g_series[SERIES_COUNT] = {
+    [SERIES_CONNECT]       = { "connect", "ms", NULL, 0, 0 },
+    [SERIES_STATE_LATENCY] = { "state_latency", "ms", NULL, 0, 0 },
+    [SERIES_EDIT_LATENCY]  = { "block_edit_latency", "ms", NULL, 0, 0 },
+    [SERIES_KBPS_IN]       = { "client_bandwidth_in", "kbit/s", NULL, 0, 0 },
+    [SERIES_KBPS_OUT]      = { "client_bandwidth_out", "kbit/s", NULL, 0, 0 },
+    [SERIES_PACKETS_IN]    = { "client_packets_in", "packets/s", NULL, 0, 0 },
+    [SERIES_PACKETS_OUT]   = { "client_packets_out", "packets/s", NULL, 0, 0 },
+    [SERIES_HOST_TICK]     = { "host_tick", "ms", NULL, 0, 0 },
+    [SERIES_HOST_NETWORK]  = { "host_network_update", "ms", NULL, 0, 0 },
+};
+
+// ============================================================================
+// OPTIONS
+// ============================================================================
+
+typedef struct {
+    int bots;
+    float duration;
+    const char* connect;                // NULL = embedded host
+    uint16_t port;
+    NetLinkConditions link;
+    float spread;
+    float edit_interval;
+    const char* report_path;
+} LoadOptions;
+
+static bool parse_options(int argc, char** argv, LoadOptions* options) {
+    options->bots = LOADTEST_DEFAULT_BOTS;
+    options->duration = LOADTEST_DEFAULT_DURATION;
+    options->connect = NULL;
+    options->port = NET_DEFAULT_PORT;
+    memset(&options->link, 0, sizeof(options->link));
+    options->spread = LOADTEST_SPREAD;
+    options->edit_interval = LOADTEST_EDIT_INTERVAL;
+    options->report_path = LOADTEST_REPORT_PATH;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!value) {
+            printf("[LOADTEST] Missing value for %s\n", arg);
+            return false;
+        }
+        if (strcmp(arg, "--bots") == 0) options->bots = atoi(value);
+        else if (strcmp(arg, "--duration") == 0) options->duration = (float)atof(value);
+        else if (strcmp(arg, "--connect") == 0) options->connect = value;
+        else if (strcmp(arg, "--port") == 0) options->port = (uint16_t)atoi(value);
+        else if (strcmp(arg, "--latency") == 0) options->link.latency_ms = atoi(value);
+        else if (strcmp(arg, "--jitter") == 0) options->link.jitter_ms = atoi(value);
+        else if (strcmp(arg, "--loss") == 0) options->link.loss = (float)atof(value) / 100.0f;
+        else if (strcmp(arg, "--spread") == 0) options->spread = (float)atof(value);
+        else if (strcmp(arg, "--edit-interval") == 0) options->edit_interval = (float)atof(value);
+        else if (strcmp(arg, "--report") == 0) options->report_path = value;
+        else {
+            printf("[LOADTEST] Unknown option %s\n", arg);
+            return false;
+        }
+        i++;
+    }
+
+    if (options->bots < 1) options->bots = 1;
+    if (options->bots > LOADTEST_MAX_BOTS) options->bots = LOADTEST_MAX_BOTS;
+    if (options->duration <= 0.0f) options->duration = LOADTEST_DEFAULT_DURATION;
+    if (options->spread < 0.0f) options->spread = 0.0f;
+    if (options->edit_interval <= LOADTEST_EDIT_CLEAR) options->edit_interval = LOADTEST_EDIT_INTERVAL;
+    return true;
+}
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static volatile sig_atomic_t g_running = 1;
+
+static void handle_signal(int sig) {
+    (void)sig;
+    g_running = 0;
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+}
+
+static void sleep_until_ms(double when) {
+    struct timespec ts;
+    ts.tv_sec = (time_t)(when / 1000.0);
+    ts.tv_nsec = (long)((when - (double)ts.tv_sec * 1000.0) * 1000000.0);
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+}
+
+// ============================================================================
+// EMBEDDED HOST
+// ============================================================================
+
+/**
+ * Dedicated server loop on its own thread (as server.c, without saves)
+ * The ticks are timed only while the bots measure.
+ */
+typedef struct {
+    uint16_t port;
+    pthread_t thread;
+    atomic_bool ready;                  // Listening (or failed, see failed)
+    atomic_bool failed;
+    atomic_bool stop;
+    atomic_bool measuring;
+} LoadHost;
+
+static void* host_thread(void* arg) {
+    LoadHost* host = (LoadHost*)arg;
+
+    TerrainParams terrain_params = terrain_default_params();
+    World* world = world_create_headless(terrain_params);
+    EntityManager* entities = entity_manager_create();
+    world_set_entity_manager(world, entities);
+
+    float time_of_day = 12.0f;
+    float day_speed = 0.5f;
+    world->time_of_day = time_of_day;
+
+    NetworkContext* network = network_create();
+    if (!network_host(network, host->port, "LoadTestHost", world, NULL, entities, &time_of_day, &day_speed)) {
+        network_destroy(network);
+        entity_manager_destroy(entities);
+        world_destroy(world);
+        atomic_store(&host->failed, true);
+        atomic_store(&host->ready, true);
+        return NULL;
+    }
+    atomic_store(&host->ready, true);
+
+    const float dt = 1.0f / WORLD_TICK_RATE;
+    double next_tick = now_ms();
+    while (!atomic_load(&host->stop)) {
+        double tick_start = now_ms();
+        network_update(network, dt);
+        double network_end = now_ms();
+
+        world_update(world, 0, 0);
+        world->time_of_day = time_of_day;
+        entity_manager_update(entities, (struct World*)world, dt);
+        leaf_decay_update(world, dt);
+        world_tick(world);
+        time_of_day = fmodf(time_of_day + day_speed * dt, 24.0f);
+
+        double tick_end = now_ms();
+        if (atomic_load(&host->measuring)) {
+            series_add(&g_series[SERIES_HOST_TICK], tick_end - tick_start);
+            series_add(&g_series[SERIES_HOST_NETWORK], network_end - tick_start);
+        }
+
+        next_tick += 1000.0 * dt;
+        if (tick_end - next_tick > 5000.0 * dt) next_tick = tick_end;
+        sleep_until_ms(next_tick);
+    }
+
+    network_destroy(network);
+    entity_manager_destroy(entities);
+    world_destroy(world);
+    return NULL;
+}
+
+// ============================================================================
+// BOTS
+// ============================================================================
+
+typedef struct {
+    NetClient* client;
+    Player player;
+    Inventory inventory;
+
+    // Scripted flight: a circle around spawn
+    float radius;
+    float angle;                        // Radians
+    float direction;                    // +1 or -1
+
+    float state_timer;
+    float edit_timer;
+    float probe_timer;
+
+    // Block above the head until LOADTEST_EDIT_CLEAR has passed
+    bool edit_placed;
+    int edit_x, edit_y, edit_z;
+
+    // State latency probe: when our state first carried each slot
+    bool probe_pending;
+    double slot_sent_ms[HOTBAR_SIZE];
+    uint8_t seen_slot[NET_MAX_CLIENTS]; // Last slot seen per remote client id
+
+    double connect_start_ms;
+    bool connected;
+    bool lost;
+    NetTrafficStats traffic_start;      // At the start of the measurement
+} Bot;
+
+/**
+ * Edit sent by a bot, matched against the ones other bots receive
+ */
+typedef struct {
+    int32_t x, y, z;
+    uint8_t block_type;
+    int bot;
+    double sent_ms;
+} LoadEdit;
+
+static Bot* g_bots = NULL;
+static int g_bot_count = 0;
+static int g_bot_by_id[NET_MAX_CLIENTS];    // Client id -> bot index (-1 = none)
+static LoadEdit g_edits[LOADTEST_EDIT_HISTORY];
+static int g_edit_next = 0;
+static bool g_measuring = false;
+
+static void record_edit(int bot, int x, int y, int z, uint8_t block_type) {
+    LoadEdit* edit = &g_edits[g_edit_next];
+    edit->x = x;
+    edit->y = y;
+    edit->z = z;
+    edit->block_type = block_type;
+    edit->bot = bot;
+    edit->sent_ms = now_ms();
+    g_edit_next = (g_edit_next + 1) % LOADTEST_EDIT_HISTORY;
+}
+
+/**
+ * A bot received a block change from the host (NetBlockChangeFunc)
+ */
+static void bot_on_block_change(void* user, const NetBlockChange* change) {
+    int observer = (int)((Bot*)user - g_bots);
+    if (!g_measuring) return;
+
+    // Newest first: the same position is edited again by later passes
+    for (int i = 1; i <= LOADTEST_EDIT_HISTORY; i++) {
+        const LoadEdit* edit = &g_edits[(g_edit_next - i + LOADTEST_EDIT_HISTORY) % LOADTEST_EDIT_HISTORY];
+        if (edit->sent_ms == 0.0) break;
+        if (edit->x != change->x || edit->y != change->y || edit->z != change->z ||
+            edit->block_type != change->block_type) {
+            continue;
+        }
+        if (edit->bot != observer) {
+            series_add(&g_series[SERIES_EDIT_LATENCY], now_ms() - edit->sent_ms);
+        }
+        return;
+    }
+}
+
+static bool bot_init(Bot* bot, int index, int count, const LoadOptions* options) {
+    char name[NET_PLAYER_NAME_MAX];
+    snprintf(name, sizeof(name), "bot%03d", index);
+
+    memset(bot, 0, sizeof(*bot));
+    bot->player.inventory = &bot->inventory;
+    bot->player.is_flying = true;
+    memset(bot->seen_slot, LOADTEST_NO_SLOT, sizeof(bot->seen_slot));
+
+    // Even area density: radius grows with the square root of the index
+    bot->radius = options->spread * sqrtf(((float)index + 0.5f) / (float)count);
+    bot->angle = (float)index * 2.39996f;  // Golden angle
+    bot->direction = index % 2 ? -1.0f : 1.0f;
+
+    // Staggered so the bots' packets do not all go out on the same poll
+    float phase = (float)index / (float)count;
+    bot->state_timer = phase * LOADTEST_STATE_INTERVAL;
+    bot->edit_timer = phase * options->edit_interval;
+    bot->probe_timer = phase * LOADTEST_PROBE_INTERVAL;
+
+    bot->client = net_client_create(name, NULL, &bot->player, NULL, NULL);
+    if (!bot->client) return false;
+    net_client_set_link(bot->client, &options->link);
+    net_client_set_block_change_func(bot->client, bot_on_block_change, bot);
+
+    bot->connect_start_ms = now_ms();
+    const char* host = options->connect ? options->connect : "127.0.0.1";
+    return net_client_connect(bot->client, host, options->port);
+}
+
+static void bot_move(Bot* bot, float dt) {
+    if (bot->radius > 0.5f) {
+        bot->angle += bot->direction * LOADTEST_SPEED / bot->radius * dt;
+    }
+    Vector3 previous = bot->player.position;
+    bot->player.position = (Vector3){
+        bot->radius * cosf(bot->angle), LOADTEST_HEIGHT, bot->radius * sinf(bot->angle)
+    };
+    bot->player.velocity = (Vector3){
+        (bot->player.position.x - previous.x) / dt, 0.0f, (bot->player.position.z - previous.z) / dt
+    };
+    bot->player.yaw = fmodf(bot->angle * 57.29578f + bot->direction * 90.0f + 360.0f, 360.0f);
+}
+
+static void bot_edit(Bot* bot, int index, float dt, float edit_interval) {
+    NetClient* client = bot->client;
+    if (bot->edit_placed) {
+        bot->edit_timer += dt;
+        if (bot->edit_timer < LOADTEST_EDIT_CLEAR) return;
+        net_client_send_block_change(client, bot->edit_x, bot->edit_y, bot->edit_z, BLOCK_AIR, 0);
+        record_edit(index, bot->edit_x, bot->edit_y, bot->edit_z, BLOCK_AIR);
+        bot->edit_placed = false;
+        return;
+    }
+
+    bot->edit_timer += dt;
+    if (bot->edit_timer < edit_interval) return;
+    bot->edit_timer = 0.0f;
+    bot->edit_x = (int)floorf(bot->player.position.x);
+    bot->edit_y = (int)floorf(bot->player.position.y) + LOADTEST_EDIT_HEIGHT;
+    bot->edit_z = (int)floorf(bot->player.position.z);
+    net_client_send_block_change(client, bot->edit_x, bot->edit_y, bot->edit_z, BLOCK_STONE, 0);
+    record_edit(index, bot->edit_x, bot->edit_y, bot->edit_z, BLOCK_STONE);
+    bot->edit_placed = true;
+}
+
+/**
+ * Time the slot changes of the other bots seen in this bot's snapshots
+ */
+static void bot_observe(Bot* bot) {
+    NetClient* client = bot->client;
+    double now = now_ms();
+    for (int id = 1; id < NET_MAX_CLIENTS; id++) {
+        int sender = g_bot_by_id[id];
+        if (sender < 0 || id == client->my_client_id || !client->player_in_view[id]) continue;
+
+        uint8_t slot = client->remote_players[id].selected_slot;
+        if (slot == bot->seen_slot[id] || slot >= HOTBAR_SIZE) continue;
+        if (bot->seen_slot[id] != LOADTEST_NO_SLOT && g_measuring && g_bots[sender].slot_sent_ms[slot] > 0.0) {
+            series_add(&g_series[SERIES_STATE_LATENCY], now - g_bots[sender].slot_sent_ms[slot]);
+        }
+        bot->seen_slot[id] = slot;
+    }
+}
+
+static void bot_update(Bot* bot, int index, float dt, float edit_interval) {
+    NetClient* client = bot->client;
+    net_client_poll(client, 0);
+
+    NetClientState state = net_client_get_state(client);
+    if (state != NET_STATE_CONNECTED) {
+        if (bot->connected && !bot->lost) {
+            printf("[LOADTEST] %s lost its connection: %s\n", client->player_name, net_client_get_error(client));
+            bot->lost = true;
+        }
+        return;
+    }
+    if (!bot->connected) {
+        bot->connected = true;
+        g_bot_by_id[client->my_client_id] = index;
+        series_add(&g_series[SERIES_CONNECT], now_ms() - bot->connect_start_ms);
+    }
+
+    bot_observe(bot);
+    bot_move(bot, dt);
+    bot_edit(bot, index, dt, edit_interval);
+    net_client_flush_block_changes(client);
+
+    bot->probe_timer += dt;
+    if (bot->probe_timer >= LOADTEST_PROBE_INTERVAL) {
+        bot->probe_timer -= LOADTEST_PROBE_INTERVAL;
+        bot->inventory.selected_hotbar_slot = (bot->inventory.selected_hotbar_slot + 1) % HOTBAR_SIZE;
+        bot->probe_pending = true;
+    }
+
+    bot->state_timer += dt;
+    if (bot->state_timer >= LOADTEST_STATE_INTERVAL) {
+        bot->state_timer -= LOADTEST_STATE_INTERVAL;
+        net_client_send_player_state(client);
+        if (bot->probe_pending) {
+            bot->slot_sent_ms[bot->inventory.selected_hotbar_slot] = now_ms();
+            bot->probe_pending = false;
+        }
+    }
+}
+
+// ============================================================================
+// REPORT
+// ============================================================================
+
+static void print_summary(const LoadSeries* series, const LoadSummary* s) {
+    if (s->count == 0) {
+        printf("[LOADTEST] %-22s no samples\n", series->name);
+        return;
+    }
+    printf("[LOADTEST] %-22s mean %9.2f  p50 %9.2f  p90 %9.2f  p99 %9.2f  max %9.2f %s  (%d samples)\n",
+           series->name, s->mean, s->p50, s->p90, s->p99, s->max, series->unit, s->count);
+}
+
+static void write_report(const char* path, const LoadOptions* options, double measured_s,
+                         int connected, int lost, const NetTrafficStats* total,
+                         const LoadSummary summaries[SERIES_COUNT]) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        printf("[LOADTEST] Failed to open %s\n", path);
+        return;
+    }
+
+    fprintf(file, "{\n  \"bots\": %d,\n  \"connected\": %d,\n  \"lost\": %d,\n", options->bots, connected, lost);
+    fprintf(file, "  \"host\": \"%s\",\n", options->connect ? options->connect : "embedded");
+    fprintf(file, "  \"measured_s\": %.3f,\n", measured_s);
+    fprintf(file, "  \"link\": {\"latency_ms\": %d, \"jitter_ms\": %d, \"loss_percent\": %.2f},\n",
+            options->link.latency_ms, options->link.jitter_ms, 100.0f * options->link.loss);
+    fprintf(file, "  \"spread_blocks\": %.1f,\n  \"edit_interval_s\": %.3f,\n", options->spread, options->edit_interval);
+    fprintf(file, "  \"totals\": {\"bytes_sent\": %llu, \"bytes_received\": %llu, \"packets_sent\": %u, "
+                  "\"packets_received\": %u, \"packets_dropped\": %u},\n",
+            (unsigned long long)total->bytes_sent, (unsigned long long)total->bytes_received,
+            total->packets_sent, total->packets_received, total->packets_dropped);
+    fprintf(file, "  \"series\": {\n");
+    for (int i = 0; i < SERIES_COUNT; i++) {
+        const LoadSummary* s = &summaries[i];
+        fprintf(file, "    \"%s\": {\"unit\": \"%s\", \"count\": %d, \"mean\": %.4f, \"p50\": %.4f, "
+                      "\"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f}%s\n",
+                g_series[i].name, g_series[i].unit, s->count, s->mean, s->p50, s->p90, s->p99, s->max,
+                i + 1 < SERIES_COUNT ? "," : "");
+    }
+    fprintf(file, "  }\n}\n");
+    fclose(file);
+    printf("[LOADTEST] Report written to %s\n", path);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char** argv) {
+    LoadOptions options;
+    if (!parse_options(argc, argv, &options)) {
+        printf("Usage: loadtest [--bots N] [--duration S] [--connect HOST] [--port P]\n"
+               "                [--latency MS] [--jitter MS] [--loss PERCENT]\n"
+               "                [--spread BLOCKS] [--edit-interval S] [--report PATH]\n");
+        return 1;
+    }
+
+    signal(SIGINT, handle_signal);
+    signal(SIGTERM, handle_signal);
+    signal(SIGPIPE, SIG_IGN);
+
+    LoadHost host;
+    memset(&host, 0, sizeof(host));
+    host.port = options.port;
+
+    // Bots validate and craft against the same tables as the host
+    block_system_init();
+    item_system_init();
+    crafting_init();
+
+    if (!options.connect) {
+        noise_init(LOADTEST_SEED);
+        leaf_decay_init();
+        if (pthread_create(&host.thread, NULL, host_thread, &host) != 0) {
+            printf("[LOADTEST] Failed to start the embedded host\n");
+            return 1;
+        }
+        while (!atomic_load(&host.ready)) {
+            sleep_until_ms(now_ms() + 10.0);
+        }
+        if (atomic_load(&host.failed)) {
+            printf("[LOADTEST] Embedded host failed to listen on port %d\n", options.port);
+            pthread_join(host.thread, NULL);
+            return 1;
+        }
+    }
+
+    printf("[LOADTEST] %d bots -> %s:%d, latency %d ms, jitter %d ms, loss %.1f%%\n",
+           options.bots, options.connect ? options.connect : "embedded host", options.port,
+           options.link.latency_ms, options.link.jitter_ms, 100.0f * options.link.loss);
+
+    for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+        g_bot_by_id[i] = -1;
+    }
+    g_bots = (Bot*)calloc((size_t)options.bots, sizeof(Bot));
+    if (!g_bots) return 1;
+    g_bot_count = options.bots;
+    for (int i = 0; i < g_bot_count; i++) {
+        if (!bot_init(&g_bots[i], i, g_bot_count, &options)) {
+            printf("[LOADTEST] bot%03d could not connect: %s\n", i, net_client_get_error(g_bots[i].client));
+        }
+    }
+
+    // Connect, then measure for the duration
+    const float dt = 1.0f / LOADTEST_RATE;
+    double start = now_ms();
+    double measure_start = 0.0;
+    double next_poll = start;
+    while (g_running) {
+        for (int i = 0; i < g_bot_count; i++) {
+            if (g_bots[i].client) bot_update(&g_bots[i], i, dt, options.edit_interval);
+        }
+
+        double now = now_ms();
+        if (!g_measuring) {
+            int connected = 0;
+            for (int i = 0; i < g_bot_count; i++) {
+                connected += g_bots[i].connected;
+            }
+            bool timed_out = now - start > 1000.0 * LOADTEST_CONNECT_TIMEOUT;
+            if (connected == g_bot_count || (timed_out && connected > 0)) {
+                printf("[LOADTEST] %d of %d bots connected, measuring for %.0f s\n",
+                       connected, g_bot_count, options.duration);
+                for (int i = 0; i < g_bot_count; i++) {
+                    if (g_bots[i].client) g_bots[i].traffic_start = g_bots[i].client->traffic;
+                }
+                g_measuring = true;
+                atomic_store(&host.measuring, true);
+                measure_start = now;
+            } else if (timed_out) {
+                printf("[LOADTEST] No bot connected within %.0f s\n", LOADTEST_CONNECT_TIMEOUT);
+                break;
+            }
+        } else if (now - measure_start >= 1000.0 * options.duration) {
+            break;
+        }
+
+        next_poll += 1000.0 * dt;
+        if (now - next_poll > 100.0) next_poll = now;  // Fell behind: do not burst
+        sleep_until_ms(next_poll);
+    }
+    atomic_store(&host.measuring, false);
+    double measured_s = g_measuring ? (now_ms() - measure_start) / 1000.0 : 0.0;
+
+    // Per-client rates over the measurement
+    NetTrafficStats total = {0};
+    int connected = 0, lost = 0;
+    for (int i = 0; i < g_bot_count; i++) {
+        Bot* bot = &g_bots[i];
+        if (!bot->client) continue;
+        const NetTrafficStats* end = &bot->client->traffic;
+        total.bytes_sent += end->bytes_sent;
+        total.bytes_received += end->bytes_received;
+        total.packets_sent += end->packets_sent;
+        total.packets_received += end->packets_received;
+        total.packets_dropped += end->packets_dropped;
+        connected += bot->connected;
+        lost += bot->lost;
+        if (!bot->connected || measured_s <= 0.0) continue;
+
+        const NetTrafficStats* begin = &bot->traffic_start;
+        series_add(&g_series[SERIES_KBPS_IN], 8.0 * (double)(end->bytes_received - begin->bytes_received) / 1000.0 / measured_s);
+        series_add(&g_series[SERIES_KBPS_OUT], 8.0 * (double)(end->bytes_sent - begin->bytes_sent) / 1000.0 / measured_s);
+        series_add(&g_series[SERIES_PACKETS_IN], (double)(end->packets_received - begin->packets_received) / measured_s);
+        series_add(&g_series[SERIES_PACKETS_OUT], (double)(end->packets_sent - begin->packets_sent) / measured_s);
+    }
+
+    for (int i = 0; i < g_bot_count; i++) {
+        net_client_destroy(g_bots[i].client);
+    }
+    if (!options.connect) {
+        atomic_store(&host.stop, true);
+        pthread_join(host.thread, NULL);
+    }
+
+    LoadSummary summaries[SERIES_COUNT];
+    printf("[LOADTEST] %.1f s measured, %d bots connected, %d lost, %u datagrams dropped by the link\n",
+           measured_s, connected, lost, total.packets_dropped);
+    for (int i = 0; i < SERIES_COUNT; i++) {
+        summaries[i] = series_summarize(&g_series[i]);
+        if (options.connect && (i == SERIES_HOST_TICK || i == SERIES_HOST_NETWORK)) continue;  // Not measurable remotely
+        print_summary(&g_series[i], &summaries[i]);
+    }
+    write_report(options.report_path, &options, measured_s, connected, lost, &total, summaries);
+
+    for (int i = 0; i < SERIES_COUNT; i++) {
+        free(g_series[i].values);
+    }
+    free(g_bots);
+    return measured_s > 0.0 ? 0 : 1;
+}
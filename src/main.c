@@ -7,20 +7,50 @@
 
 #include <raylib.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "game.h"
 
-int main(void) {
+/**
+ * Usage: main [--benchmark-flythrough] [--view-distance N] [--lod-distance N] [--report PATH]
+ *             [--heap-budget MB] [--vram-budget MB]
+ */
+static void parse_options(int argc, char** argv, GameOptions* options) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--benchmark-flythrough") == 0) {
+            options->benchmark_flythrough = true;
+        } else if (strcmp(argv[i], "--view-distance") == 0 && i + 1 < argc) {
+            options->view_distance = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--lod-distance") == 0 && i + 1 < argc) {
+            options->lod_distance = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--report") == 0 && i + 1 < argc) {
+            options->report_path = argv[++i];
+        } else if (strcmp(argv[i], "--heap-budget") == 0 && i + 1 < argc) {
+            options->heap_budget_mb = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--vram-budget") == 0 && i + 1 < argc) {
+            options->gpu_budget_mb = atoi(argv[++i]);
+        } else {
+            printf("[MAIN] Ignoring unknown option %s\n", argv[i]);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    GameOptions options = {0};
+    parse_options(argc, argv, &options);
+    game_set_options(&options);
+
     // Initialize Raylib window
     const int screen_width = 800;
     const int screen_height = 600;
     InitWindow(screen_width, screen_height, "Katalis");
-    SetTargetFPS(60);
+    SetTargetFPS(options.benchmark_flythrough ? 0 : 60);  // Benchmarks measure uncapped frames
 
     printf("[MAIN] Katalis starting...\n");
     printf("[MAIN] Window initialized: %dx%d\n", screen_width, screen_height);
 
     // Main game loop
-    while (!WindowShouldClose()) {
+    while (!WindowShouldClose() && !game_should_exit()) {
         BeginDrawing();
         game_run();
         EndDrawing();
@@ -0,0 +1,173 @@
+#define _POSIX_C_SOURCE 200112L
+/**
+ * Katalis Dedicated Server
+ *
+ * Headless host: terrain generation, water, entities and networking run at
+ * a fixed tick rate without a window. Chunks are never meshed; clients
+ * stream them from this world and mesh them themselves.
+ *
+ * Usage: server [port] [view distance]
+ */
+
+#include "game_constants.h"
+#include "voxel/core/block.h"
+#include "voxel/core/item.h"
+#include "voxel/world/world.h"
+#include "voxel/world/noise.h"
+#include "voxel/world/terrain.h"
+#include "voxel/world/region.h"
+#include "voxel/world/terrain_cache.h"
+#include "voxel/entity/entity.h"
+#include "voxel/entity/tree.h"
+#include "voxel/inventory/crafting.h"
+#include "voxel/network/network.h"
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define SERVER_TICK_RATE WORLD_TICK_RATE  // Same simulation rate as clients
+#define SERVER_MAX_CATCH_UP 5           // Ticks behind before the schedule is reset
+#define SERVER_TIME_SYNC_INTERVAL 5.0f  // Seconds between time of day broadcasts
+#define SERVER_STATS_INTERVAL 60.0f     // Seconds between status lines
+#define SERVER_START_TIME 12.0f         // Time of day at startup (hours)
+#define SERVER_DAY_SPEED 0.5f           // Game hours per real second
+#define SERVER_NAME "Server"
+
+// ============================================================================
+// SERVER LOOP
+// ============================================================================
+
+static volatile sig_atomic_t g_running = 1;
+
+static void handle_signal(int sig) {
+    (void)sig;
+    g_running = 0;
+}
+
+static double monotonic_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void sleep_until(double when) {
+    struct timespec ts;
+    ts.tv_sec = (time_t)when;
+    ts.tv_nsec = (long)((when - (double)ts.tv_sec) * 1e9);
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+}
+
+int main(int argc, char** argv) {
+    uint16_t port = argc > 1 ? (uint16_t)atoi(argv[1]) : NET_DEFAULT_PORT;
+    int view_distance = argc > 2 ? atoi(argv[2]) : WORLD_VIEW_DISTANCE;
+    if (view_distance < 1) view_distance = WORLD_VIEW_DISTANCE;
+
+    signal(SIGINT, handle_signal);
+    signal(SIGTERM, handle_signal);
+    printf("[SERVER] Katalis dedicated server starting...\n");
+
+    block_system_init();
+    item_system_init();
+    crafting_init();  // Inventory sync recomputes crafting output
+
+    // Same save layout and seed handling as the client's world
+    RegionStorage* storage = region_storage_create(SAVE_DIRECTORY);
+    uint32_t seed = 0;
+    if (!region_storage_read_seed(storage, &seed)) {
+        seed = (uint32_t)time(NULL);
+        region_storage_write_seed(storage, seed);
+    }
+    noise_init(seed);
+    printf("[SERVER] Using world seed: %u\n", seed);
+
+    TerrainParams terrain_params = terrain_default_params();
+    World* world = world_create_headless(terrain_params);
+    world_set_storage(world, storage);
+#if TERRAIN_CACHE_ENABLED
+    world_set_terrain_cache(world, terrain_cache_create(TERRAIN_CACHE_DIRECTORY, seed, terrain_params));
+#endif
+    world->view_distance = view_distance;
+
+    EntityManager* entities = entity_manager_create();
+    world_set_entity_manager(world, entities);
+    leaf_decay_init();
+
+    float time_of_day = SERVER_START_TIME;
+    float day_speed = SERVER_DAY_SPEED;
+    world->time_of_day = time_of_day;
+
+    NetworkContext* network = network_create();
+    if (!network_host(network, port, SERVER_NAME, world, NULL, entities, &time_of_day, &day_speed)) {
+        printf("[SERVER] Failed to host on port %d\n", port);
+        network_destroy(network);
+        entity_manager_destroy(entities);
+        world_destroy(world);
+        return 1;
+    }
+
+    // Fixed timestep: ticks are scheduled on an absolute clock so sleep
+    // overshoot does not accumulate; falling far behind drops the backlog
+    const float dt = 1.0f / SERVER_TICK_RATE;
+    double next_tick = monotonic_seconds();
+    float time_sync_timer = 0.0f;
+    float stats_timer = 0.0f;
+    double busy_seconds = 0.0;
+    int stats_ticks = 0;
+
+    printf("[SERVER] Running at %d ticks per second, view distance %d\n", SERVER_TICK_RATE, view_distance);
+    while (g_running) {
+        double tick_start = monotonic_seconds();
+
+        // Network first, so block changes from clients land before simulation
+        network_update(network, dt);
+
+        // The world stays centered on spawn (chunk 0, 0)
+        world_update(world, 0, 0);
+        world->time_of_day = time_of_day;
+        entity_manager_update(entities, (struct World*)world, dt);
+        leaf_decay_update(world, dt);
+        world_tick(world);
+
+        time_of_day += day_speed * dt;
+        if (time_of_day >= 24.0f) time_of_day -= 24.0f;
+
+        time_sync_timer += dt;
+        if (time_sync_timer >= SERVER_TIME_SYNC_INTERVAL) {
+            time_sync_timer = 0.0f;
+            net_server_broadcast_time(network->server);
+        }
+
+        double now = monotonic_seconds();
+        busy_seconds += now - tick_start;
+        stats_ticks++;
+        stats_timer += dt;
+        if (stats_timer >= SERVER_STATS_INTERVAL) {
+            printf("[SERVER] %d players, %d chunks loaded, %.2f ms per tick\n",
+                   net_server_get_client_count(network->server), world->chunks->chunk_count,
+                   1000.0 * busy_seconds / stats_ticks);
+            stats_timer = 0.0f;
+            busy_seconds = 0.0;
+            stats_ticks = 0;
+        }
+
+        next_tick += dt;
+        if (now - next_tick > SERVER_MAX_CATCH_UP * dt) {
+            printf("[SERVER] Running %.0f ms behind, skipping ticks\n", 1000.0 * (now - next_tick));
+            next_tick = now;
+        }
+        sleep_until(next_tick);
+    }
+
+    printf("[SERVER] Shutting down...\n");
+    network_destroy(network);
+    entity_manager_destroy(entities);
+    world_destroy(world);  // Saves every modified chunk
+    printf("[SERVER] Stopped cleanly\n");
+    return 0;
+}
@@ -0,0 +1,225 @@
+/**
+ * Atlas Tile Lookup
+ *
+ * Which atlas tile each block face uses. Kept apart from the atlas image and
+ * GPU resources (texture_atlas.c) so headless builds mesh with the same tiles.
+ */
+
+#include "voxel/core/texture_atlas.h"
+#include "voxel/core/block.h"
+
+// ============================================================================
+// TEXTURE COORDINATE LOOKUP
+// ============================================================================
+
+/**
+ * Get atlas tile for a block face
+ */
+AtlasTile texture_atlas_get_tile(BlockType block_type, BlockFace face) {
+    int tile_x = 0;
+    int tile_y = 0;
+
+    // Map block types to tile positions
+    switch (block_type) {
+        case BLOCK_GRASS:
+            if (face == FACE_TOP) {
+                tile_x = 0; tile_y = 0;  // Green grass top
+            } else if (face == FACE_BOTTOM) {
+                tile_x = 1; tile_y = 0;  // Dirt bottom
+            } else {
+                tile_x = 2; tile_y = 0;  // Grass side
+            }
+            break;
+
+        case BLOCK_DIRT:
+            tile_x = 0; tile_y = 1;
+            break;
+
+        case BLOCK_STONE:
+            tile_x = 0; tile_y = 2;
+            break;
+
+        case BLOCK_WOOD:
+            if (face == FACE_TOP || face == FACE_BOTTOM) {
+                tile_x = 1; tile_y = 3;  // Wood rings
+            } else {
+                tile_x = 0; tile_y = 3;  // Bark
+            }
+            break;
+
+        case BLOCK_LEAVES:
+            tile_x = 0; tile_y = 4;
+            break;
+
+        case BLOCK_SAND:
+            tile_x = 0; tile_y = 5;
+            break;
+
+        case BLOCK_WATER:
+            tile_x = 0; tile_y = 6;
+            break;
+
+        case BLOCK_COBBLESTONE:
+            tile_x = 0; tile_y = 7;
+            break;
+
+        case BLOCK_BEDROCK:
+            tile_x = 0; tile_y = 8;
+            break;
+
+        case BLOCK_DEEP_STONE:
+            tile_x = 0; tile_y = 9;
+            break;
+
+        case BLOCK_GRAVEL:
+            tile_x = 0; tile_y = 10;
+            break;
+
+        case BLOCK_COAL_ORE:
+            tile_x = 0; tile_y = 11;  // For now, use base stone texture
+            break;
+
+        case BLOCK_IRON_ORE:
+            tile_x = 0; tile_y = 12;
+            break;
+
+        case BLOCK_GOLD_ORE:
+            tile_x = 0; tile_y = 13;
+            break;
+
+        case BLOCK_DIAMOND_ORE:
+            tile_x = 0; tile_y = 14;
+            break;
+
+        case BLOCK_MOSSY_COBBLE:
+            tile_x = 0; tile_y = 15;
+            break;
+
+        case BLOCK_STONE_BRICK:
+            tile_x = 0; tile_y = 16;
+            break;
+
+        case BLOCK_CRACKED_BRICK:
+            tile_x = 1; tile_y = 16;
+            break;
+
+        case BLOCK_CLAY:
+            tile_x = 0; tile_y = 17;
+            break;
+
+        case BLOCK_SNOW:
+            tile_x = 0; tile_y = 18;
+            break;
+
+        case BLOCK_CACTUS:
+            tile_x = 0; tile_y = 19;
+            break;
+
+        case BLOCK_BIRCH_WOOD:
+            if (face == FACE_TOP || face == FACE_BOTTOM) {
+                tile_x = 1; tile_y = 21;  // Wood rings
+            } else {
+                tile_x = 0; tile_y = 21;  // Cream bark
+            }
+            break;
+
+        case BLOCK_BIRCH_LEAVES:
+            tile_x = 0; tile_y = 22;
+            break;
+
+        case BLOCK_SPRUCE_WOOD:
+            if (face == FACE_TOP || face == FACE_BOTTOM) {
+                tile_x = 1; tile_y = 23;  // Wood rings
+            } else {
+                tile_x = 0; tile_y = 23;  // Dark bark
+            }
+            break;
+
+        case BLOCK_SPRUCE_LEAVES:
+            tile_x = 0; tile_y = 24;
+            break;
+
+        case BLOCK_ACACIA_WOOD:
+            if (face == FACE_TOP || face == FACE_BOTTOM) {
+                tile_x = 1; tile_y = 25;  // Wood rings
+            } else {
+                tile_x = 0; tile_y = 25;  // Orange bark
+            }
+            break;
+
+        case BLOCK_ACACIA_LEAVES:
+            tile_x = 0; tile_y = 26;
+            break;
+
+        case BLOCK_STALACTITE:
+            tile_x = 0; tile_y = 27;
+            break;
+
+        case BLOCK_STALAGMITE:
+            tile_x = 0; tile_y = 28;
+            break;
+
+        case BLOCK_CHEST:
+            if (face == FACE_TOP || face == FACE_BOTTOM) {
+                tile_x = 1; tile_y = 29;  // Darker lid
+            } else {
+                tile_x = 0; tile_y = 29;  // Wood sides
+            }
+            break;
+
+        default:
+            tile_x = 0; tile_y = 0;  // Default to first tile
+            break;
+    }
+
+    return (AtlasTile){(uint8_t)tile_x, (uint8_t)tile_y};
+}
+
+/**
+ * Get texture coordinates for a block face
+ */
+TextureCoords texture_atlas_get_coords(BlockType block_type, BlockFace face) {
+    TextureCoords coords = {0};
+
+    // UV range is 0.0 to 1.0
+    float tile_uv_size = 1.0f / (float)TILES_PER_ROW;
+
+    AtlasTile tile = texture_atlas_get_tile(block_type, face);
+    int tile_x = tile.x;
+    int tile_y = tile.y;
+
+    // Calculate UV coordinates with small padding to prevent bleeding
+    float padding = 0.001f;  // Small inset to prevent sampling adjacent tiles
+
+    coords.u_min = (float)tile_x * tile_uv_size + padding;
+    coords.v_min = (float)tile_y * tile_uv_size + padding;
+    coords.u_max = coords.u_min + tile_uv_size - padding * 2.0f;
+    coords.v_max = coords.v_min + tile_uv_size - padding * 2.0f;
+
+    return coords;
+}
+
+/**
+ * Get texture coordinates for a crack overlay stage (0-9)
+ */
+TextureCoords texture_atlas_get_crack_coords(int stage) {
+    TextureCoords coords = {0};
+
+    // Clamp stage to valid range
+    if (stage < 0) stage = 0;
+    if (stage > 9) stage = 9;
+
+    float tile_uv_size = 1.0f / (float)TILES_PER_ROW;
+    float padding = 0.001f;
+
+    // Crack textures are at row 20, columns 0-9
+    int tile_x = stage;
+    int tile_y = 20;
+
+    coords.u_min = (float)tile_x * tile_uv_size + padding;
+    coords.v_min = (float)tile_y * tile_uv_size + padding;
+    coords.u_max = coords.u_min + tile_uv_size - padding * 2.0f;
+    coords.v_max = coords.v_min + tile_uv_size - padding * 2.0f;
+
+    return coords;
+}
@@ -13,6 +13,26 @@
 static BlockProperties g_block_properties[BLOCK_COUNT];
 static bool g_initialized = false;
 
+uint8_t g_block_flags[256];
+uint8_t g_block_light_emission[256];
+
+/**
+ * Pack the flags of every type (unknown types copy air)
+ */
+static void block_flags_init(void) {
+    for (int t = 0; t < 256; t++) {
+        const BlockProperties* props = &g_block_properties[t < BLOCK_COUNT ? t : BLOCK_AIR];
+        uint8_t flags = 0;
+        if (props->is_solid) flags |= BLOCK_FLAG_SOLID;
+        if (props->is_transparent) flags |= BLOCK_FLAG_TRANSPARENT;
+        if (props->is_fluid) flags |= BLOCK_FLAG_FLUID;
+        if (props->is_solid && !props->is_transparent) flags |= BLOCK_FLAG_OPAQUE;
+        if (t == BLOCK_AIR || props->is_transparent) flags |= BLOCK_FLAG_PASSES_LIGHT;
+        g_block_flags[t] = flags;
+        g_block_light_emission[t] = props->light_emission;
+    }
+}
+
 /**
  * Initialize block properties
  */
@@ -407,6 +427,7 @@ void block_system_init(void) {
         .requires_tool = true
     };
 
+    block_flags_init();
     g_initialized = true;
     printf("[BLOCK] Block system initialized with %d block types\n", BLOCK_COUNT);
 }
@@ -426,30 +447,6 @@ const BlockProperties* block_get_properties(BlockType type) {
     return &g_block_properties[BLOCK_AIR];
 }
 
-/**
- * Check if block is solid
- */
-bool block_is_solid(Block block) {
-    const BlockProperties* props = block_get_properties(block.type);
-    return props->is_solid;
-}
-
-/**
- * Check if block is transparent
- */
-bool block_is_transparent(Block block) {
-    const BlockProperties* props = block_get_properties(block.type);
-    return props->is_transparent;
-}
-
-/**
- * Check if block is fluid
- */
-bool block_is_fluid(Block block) {
-    const BlockProperties* props = block_get_properties(block.type);
-    return props->is_fluid;
-}
-
 /**
  * Get block name
  */
@@ -0,0 +1,117 @@
+/**
+ * Memory Accounting Implementation
+ */
+
+#include "voxel/core/memory.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* g_category_names[MEMORY_CATEGORY_COUNT] = {
+    [MEMORY_CHUNK_STORAGE] = "chunk storage",
+    [MEMORY_CPU_MESH]      = "CPU meshes",
+    [MEMORY_WORKER]        = "worker queues",
+    [MEMORY_BATCHER]       = "batcher",
+    [MEMORY_LOD]           = "LOD builder",
+    [MEMORY_CHESTS]        = "chests",
+    [MEMORY_WATER]         = "water",
+    [MEMORY_ENTITIES]      = "entities",
+    [MEMORY_GPU_CHUNK]     = "chunk buffers",
+    [MEMORY_GPU_BATCH]     = "batch buffers",
+    [MEMORY_GPU_LOD]       = "LOD buffers",
+};
+
+static atomic_llong g_bytes[MEMORY_CATEGORY_COUNT];
+static atomic_llong g_peak[MEMORY_CATEGORY_COUNT];
+
+static size_t g_budget[MEMORY_KIND_COUNT] = {
+    [MEMORY_HEAP] = (size_t)MEMORY_HEAP_BUDGET_MB * 1024 * 1024,
+    [MEMORY_GPU]  = (size_t)MEMORY_GPU_BUDGET_MB * 1024 * 1024,
+};
+
+// ============================================================================
+// API
+// ============================================================================
+
+void memory_track(MemoryCategory category, ptrdiff_t bytes) {
+    if (category < 0 || category >= MEMORY_CATEGORY_COUNT || bytes == 0) return;
+
+    long long now = atomic_fetch_add_explicit(&g_bytes[category], (long long)bytes, memory_order_relaxed) + bytes;
+    if (bytes < 0) return;
+
+    long long peak = atomic_load_explicit(&g_peak[category], memory_order_relaxed);
+    while (now > peak && !atomic_compare_exchange_weak_explicit(&g_peak[category], &peak, now,
+                                                                memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+size_t memory_get_bytes(MemoryCategory category) {
+    if (category < 0 || category >= MEMORY_CATEGORY_COUNT) return 0;
+    long long bytes = atomic_load_explicit(&g_bytes[category], memory_order_relaxed);
+    return bytes > 0 ? (size_t)bytes : 0;  // Frees seen before their allocation
+}
+
+size_t memory_get_peak(MemoryCategory category) {
+    if (category < 0 || category >= MEMORY_CATEGORY_COUNT) return 0;
+    long long bytes = atomic_load_explicit(&g_peak[category], memory_order_relaxed);
+    return bytes > 0 ? (size_t)bytes : 0;
+}
+
+const char* memory_category_name(MemoryCategory category) {
+    return category >= 0 && category < MEMORY_CATEGORY_COUNT ? g_category_names[category] : "?";
+}
+
+size_t memory_get_total(MemoryKind kind) {
+    size_t total = 0;
+    for (int c = 0; c < MEMORY_CATEGORY_COUNT; c++) {
+        if (memory_category_kind((MemoryCategory)c) == kind) total += memory_get_bytes((MemoryCategory)c);
+    }
+    return total;
+}
+
+void memory_set_budget(MemoryKind kind, size_t bytes) {
+    if (kind < 0 || kind >= MEMORY_KIND_COUNT) return;
+    g_budget[kind] = bytes;
+    if (bytes > 0) {
+        printf("[MEMORY] %s budget %zu MB\n", kind == MEMORY_GPU ? "GPU" : "Heap", bytes / (1024 * 1024));
+    }
+}
+
+size_t memory_get_budget(MemoryKind kind) {
+    return kind >= 0 && kind < MEMORY_KIND_COUNT ? g_budget[kind] : 0;
+}
+
+MemoryPressure memory_get_pressure(MemoryKind kind) {
+    size_t budget = memory_get_budget(kind);
+    if (budget == 0) return MEMORY_PRESSURE_NONE;
+
+    double used = (double)memory_get_total(kind) / (double)budget;
+    if (used >= 1.0) return MEMORY_PRESSURE_OVER;
+    if (used >= MEMORY_HIGH_WATER) return MEMORY_PRESSURE_HIGH;
+    if (used >= MEMORY_LOW_WATER) return MEMORY_PRESSURE_MODERATE;
+    return MEMORY_PRESSURE_NONE;
+}
+
+MemoryPressure memory_get_max_pressure(void) {
+    MemoryPressure heap = memory_get_pressure(MEMORY_HEAP);
+    MemoryPressure gpu = memory_get_pressure(MEMORY_GPU);
+    return heap > gpu ? heap : gpu;
+}
+
+long memory_get_resident_kb(void) {
+    // Linux only; elsewhere the tracked totals have to do
+    FILE* file = fopen("/proc/self/status", "r");
+    if (!file) return 0;
+
+    char line[128];
+    long kb = 0;
+    while (fgets(line, sizeof(line), file)) {
+        if (strncmp(line, "VmRSS:", 6) == 0) {
+            kb = strtol(line + 6, NULL, 10);
+            break;
+        }
+    }
+    fclose(file);
+    return kb;
+}
@@ -0,0 +1,254 @@
+/**
+ * Profiler Implementation
+ */
+
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#include "voxel/core/profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * One recorded scope of a capture
+ */
+typedef struct ProfileEvent {
+    uint64_t start_ns;
+    uint64_t duration_ns;
+    uint16_t zone;
+    uint16_t thread;
+    atomic_uint committed;              // Set last: the writer skips half-written events
+} ProfileEvent;
+
+typedef struct ProfileZoneInfo {
+    const char* name;
+    int depth;
+} ProfileZoneInfo;
+
+static const ProfileZoneInfo g_zone_info[PROFILE_ZONE_COUNT] = {
+    [PROFILE_GAME_UPDATE]        = { "game update", 0 },
+    [PROFILE_NETWORK_POLL]       = { "network poll", 1 },
+    [PROFILE_WORLD_UPDATE]       = { "world update", 1 },
+    [PROFILE_WORLD_UPLOADS]      = { "mesh uploads", 2 },
+    [PROFILE_WORLD_EVICT]        = { "chunk eviction", 2 },
+    [PROFILE_WORLD_COLD]         = { "cold compression", 2 },
+    [PROFILE_WORLD_STREAMING]    = { "chunk streaming", 2 },
+    [PROFILE_WORLD_REMESH]       = { "remesh dispatch", 2 },
+    [PROFILE_BATCH_REBUILD]      = { "batch rebuilds", 2 },
+    [PROFILE_LOD_UPDATE]         = { "LOD update", 2 },
+    [PROFILE_GAME_TICK]          = { "game tick", 0 },
+    [PROFILE_ENTITY_UPDATE]      = { "entity update", 1 },
+    [PROFILE_GAME_DRAW]          = { "game draw", 0 },
+    [PROFILE_RENDER_OPAQUE]      = { "opaque pass", 1 },
+    [PROFILE_RENDER_ENTITIES]    = { "entity pass", 1 },
+    [PROFILE_RENDER_TRANSPARENT] = { "transparent pass", 1 },
+    [PROFILE_RENDER_UI]          = { "UI pass", 1 },
+    [PROFILE_WATER_TICK]         = { "water tick", 0 },
+    [PROFILE_WORKER_TERRAIN]     = { "worker terrain", 0 },
+    [PROFILE_WORKER_DECORATE]    = { "worker decorate", 0 },
+    [PROFILE_WORKER_LIGHT]       = { "worker light", 0 },
+    [PROFILE_WORKER_MESH]        = { "worker mesh", 0 },
+    [PROFILE_WORKER_REMESH]      = { "worker remesh", 0 },
+};
+
+atomic_bool g_profiler_active = false;
+
+static bool g_enabled = false;
+
+// Current frame, summed by every thread
+static atomic_uint_fast64_t g_zone_ns[PROFILE_ZONE_COUNT];
+static atomic_uint g_zone_calls[PROFILE_ZONE_COUNT];
+
+// Finished frames (main thread)
+static ProfileFrame g_history[PROFILER_HISTORY];
+static int g_history_next = 0;
+static int g_history_count = 0;
+static uint64_t g_last_frame_ns = 0;
+
+// Capture
+static ProfileEvent* g_events = NULL;
+static atomic_uint g_event_count;
+static atomic_bool g_capturing = false;
+static int g_capture_frames_left = 0;
+static uint64_t g_capture_start_ns = 0;
+
+// Thread names
+static atomic_int g_thread_count = 1;   // 0 is left for threads never named
+static char g_thread_names[PROFILER_MAX_THREADS][32];
+static _Thread_local int g_thread_id = -1;
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+static int current_thread_id(void) {
+    if (g_thread_id < 0) {
+        int id = atomic_fetch_add(&g_thread_count, 1);
+        g_thread_id = id < PROFILER_MAX_THREADS ? id : 0;
+    }
+    return g_thread_id;
+}
+
+static void update_active(void) {
+    atomic_store_explicit(&g_profiler_active, g_enabled || g_capture_frames_left > 0, memory_order_relaxed);
+}
+
+/**
+ * Write the captured events as Chrome trace JSON (complete events, times in microseconds)
+ */
+static void write_trace(void) {
+    unsigned count = atomic_load(&g_event_count);
+    if (count > PROFILER_TRACE_EVENTS) count = PROFILER_TRACE_EVENTS;
+
+    FILE* file = fopen(PROFILER_TRACE_PATH, "w");
+    if (!file) {
+        printf("[PROFILER] Failed to open %s\n", PROFILER_TRACE_PATH);
+        return;
+    }
+
+    fprintf(file, "{\"traceEvents\":[\n");
+    bool first = true;
+    int threads = atomic_load(&g_thread_count);
+    if (threads > PROFILER_MAX_THREADS) threads = PROFILER_MAX_THREADS;
+    for (int t = 1; t < threads; t++) {
+        if (!g_thread_names[t][0]) continue;
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                first ? "" : ",\n", t, g_thread_names[t]);
+        first = false;
+    }
+
+    unsigned written = 0;
+    for (unsigned i = 0; i < count; i++) {
+        const ProfileEvent* event = &g_events[i];
+        if (!atomic_load_explicit(&event->committed, memory_order_acquire)) continue;
+        if (event->start_ns < g_capture_start_ns) continue;
+
+        fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                first ? "" : ",\n", g_zone_info[event->zone].name, (unsigned)event->thread,
+                (double)(event->start_ns - g_capture_start_ns) / 1000.0, (double)event->duration_ns / 1000.0);
+        first = false;
+        written++;
+    }
+    fprintf(file, "\n]}\n");
+    fclose(file);
+
+    printf("[PROFILER] Wrote %u events to %s%s\n", written, PROFILER_TRACE_PATH,
+           atomic_load(&g_event_count) > PROFILER_TRACE_EVENTS ? " (buffer full, capture cut short)" : "");
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+uint64_t profiler_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void profiler_end(ProfileZone zone, uint64_t start_ns) {
+    if (start_ns == 0) return;
+
+    uint64_t now = profiler_now_ns();
+    uint64_t duration = now - start_ns;
+    atomic_fetch_add_explicit(&g_zone_ns[zone], duration, memory_order_relaxed);
+    atomic_fetch_add_explicit(&g_zone_calls[zone], 1, memory_order_relaxed);
+
+    if (!atomic_load_explicit(&g_capturing, memory_order_relaxed)) return;
+    unsigned index = atomic_fetch_add_explicit(&g_event_count, 1, memory_order_relaxed);
+    if (index >= PROFILER_TRACE_EVENTS) return;
+
+    ProfileEvent* event = &g_events[index];
+    event->start_ns = start_ns;
+    event->duration_ns = duration;
+    event->zone = (uint16_t)zone;
+    event->thread = (uint16_t)current_thread_id();
+    atomic_store_explicit(&event->committed, 1, memory_order_release);
+}
+
+void profiler_set_enabled(bool enabled) {
+    g_enabled = enabled;
+    update_active();
+}
+
+bool profiler_is_enabled(void) {
+    return g_enabled;
+}
+
+void profiler_set_thread_name(const char* name) {
+    int id = current_thread_id();
+    if (id == 0 || !name) return;
+    snprintf(g_thread_names[id], sizeof(g_thread_names[id]), "%s", name);
+}
+
+void profiler_start_capture(void) {
+    if (g_capture_frames_left > 0) return;
+
+    if (!g_events) {
+        g_events = (ProfileEvent*)malloc(PROFILER_TRACE_EVENTS * sizeof(ProfileEvent));
+        if (!g_events) {
+            printf("[PROFILER] Failed to allocate capture buffer\n");
+            return;
+        }
+    }
+    for (unsigned i = 0; i < PROFILER_TRACE_EVENTS; i++) {
+        atomic_init(&g_events[i].committed, 0);
+    }
+    atomic_store(&g_event_count, 0);
+    g_capture_start_ns = profiler_now_ns();
+    g_capture_frames_left = PROFILER_CAPTURE_FRAMES;
+    atomic_store(&g_capturing, true);
+    update_active();
+    printf("[PROFILER] Capturing %d frames\n", PROFILER_CAPTURE_FRAMES);
+}
+
+bool profiler_is_capturing(void) {
+    return g_capture_frames_left > 0;
+}
+
+void profiler_frame_end(void) {
+    uint64_t now = profiler_now_ns();
+    bool active = atomic_load_explicit(&g_profiler_active, memory_order_relaxed);
+
+    if (active) {
+        ProfileFrame* frame = &g_history[g_history_next];
+        frame->frame_ms = g_last_frame_ns ? (float)((double)(now - g_last_frame_ns) / 1000000.0) : 0.0f;
+        for (int z = 0; z < PROFILE_ZONE_COUNT; z++) {
+            uint64_t ns = atomic_exchange_explicit(&g_zone_ns[z], 0, memory_order_relaxed);
+            unsigned calls = atomic_exchange_explicit(&g_zone_calls[z], 0, memory_order_relaxed);
+            frame->zone_ms[z] = (float)((double)ns / 1000000.0);
+            frame->zone_calls[z] = (uint16_t)(calls > UINT16_MAX ? UINT16_MAX : calls);
+        }
+        g_history_next = (g_history_next + 1) % PROFILER_HISTORY;
+        if (g_history_count < PROFILER_HISTORY) g_history_count++;
+    }
+    g_last_frame_ns = now;
+
+    if (g_capture_frames_left > 0 && --g_capture_frames_left == 0) {
+        atomic_store(&g_capturing, false);
+        write_trace();
+        update_active();
+    }
+}
+
+const ProfileFrame* profiler_get_frame(int age) {
+    if (age < 0 || age >= g_history_count) return NULL;
+    int index = (g_history_next - 1 - age + PROFILER_HISTORY) % PROFILER_HISTORY;
+    return &g_history[index];
+}
+
+const char* profiler_zone_name(ProfileZone zone) {
+    return zone >= 0 && zone < PROFILE_ZONE_COUNT ? g_zone_info[zone].name : "?";
+}
+
+int profiler_zone_depth(ProfileZone zone) {
+    return zone >= 0 && zone < PROFILE_ZONE_COUNT ? g_zone_info[zone].depth : 0;
+}
+
+void profiler_shutdown(void) {
+    atomic_store(&g_capturing, false);
+    g_capture_frames_left = 0;
+    update_active();
+    free(g_events);
+    g_events = NULL;
+}
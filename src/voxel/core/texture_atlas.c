@@ -2,13 +2,19 @@
  * Texture Atlas Implementation
  */
 
+#define GL_GLEXT_PROTOTYPES  // glGenerateMipmap (GL 3.0) is called directly
 #include "voxel/core/texture_atlas.h"
 #include "voxel/core/block.h"
+#include "voxel/render/frame_uniforms.h"
 #include <raylib.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
 #include <string.h>
 #include <math.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <GL/gl.h>
 
 // ============================================================================
 // HELPER FUNCTIONS
@@ -28,7 +34,9 @@ static inline int clamp_int(int value, int min, int max) {
 // ============================================================================
 
 static Texture2D g_atlas_texture;
+static unsigned int g_tile_array = 0;
 static Material g_atlas_material;
+static Material g_water_material;
 static bool g_initialized = false;
 
 // ============================================================================
@@ -538,24 +546,22 @@ static void generate_sword_tile(Image* atlas, int tile_x, int tile_y, Color blad
 }
 
 /**
- * Generate an animated water tile frame
- * Creates subtle wave patterns that vary per frame
+ * Generate the water tile
+ * Creates subtle wave patterns; water.vs scrolls the tile along the flow
+ * and water.fs adds the moving highlights
  */
-static void generate_water_tile(Image* atlas, int tile_x, int tile_y, Color base_color, int frame) {
+static void generate_water_tile(Image* atlas, int tile_x, int tile_y, Color base_color) {
     int start_x = tile_x * TILE_SIZE;
     int start_y = tile_y * TILE_SIZE;
 
-    // Phase offset based on frame (0-3)
-    float phase = (float)frame * 1.57f;  // PI/2 offset per frame
-
     for (int y = 0; y < TILE_SIZE; y++) {
         for (int x = 0; x < TILE_SIZE; x++) {
             Color pixel = base_color;
 
             // Create wave pattern using multiple sine waves
-            float wave1 = sinf((float)x * 0.5f + phase) * 0.5f + 0.5f;
-            float wave2 = sinf((float)y * 0.4f + phase * 0.7f) * 0.5f + 0.5f;
-            float wave3 = sinf((float)(x + y) * 0.3f + phase * 1.3f) * 0.5f + 0.5f;
+            float wave1 = sinf((float)x * 0.5f) * 0.5f + 0.5f;
+            float wave2 = sinf((float)y * 0.4f) * 0.5f + 0.5f;
+            float wave3 = sinf((float)(x + y) * 0.3f) * 0.5f + 0.5f;
 
             // Combine waves for natural water look
             float combined = (wave1 + wave2 + wave3) / 3.0f;
@@ -564,7 +570,7 @@ static void generate_water_tile(Image* atlas, int tile_x, int tile_y, Color base
             int brightness = (int)((combined - 0.5f) * 30.0f);
 
             // Add some extra noise for texture
-            int noise = ((x * 7 + y * 13 + frame * 11) % 10) - 5;
+            int noise = ((x * 7 + y * 13) % 10) - 5;
 
             pixel.r = (unsigned char)clamp_int(pixel.r + brightness + noise, 0, 255);
             pixel.g = (unsigned char)clamp_int(pixel.g + brightness + noise, 0, 255);
@@ -785,12 +791,8 @@ static Image generate_atlas_image(void) {
     // SAND - Row 5 (Warm golden sand)
     generate_tile(&atlas, 0, 5, (Color){240, 220, 130, 255}, true);   // All faces: Golden sand
 
-    // WATER - Row 6 (Bright cyan-blue) - 4 animation frames
-    Color water_color = {50, 150, 255, 180};
-    generate_water_tile(&atlas, 0, 6, water_color, 0);  // Frame 0
-    generate_water_tile(&atlas, 1, 6, water_color, 1);  // Frame 1
-    generate_water_tile(&atlas, 2, 6, water_color, 2);  // Frame 2
-    generate_water_tile(&atlas, 3, 6, water_color, 3);  // Frame 3
+    // WATER - Row 6 (Bright cyan-blue), animated by the water shaders
+    generate_water_tile(&atlas, 0, 6, (Color){50, 150, 255, 180});
 
     // COBBLESTONE - Row 7 (Brown-gray mix, not pure gray)
     generate_tile(&atlas, 0, 7, (Color){130, 120, 110, 255}, true);   // All faces: Brown-gray cobble
@@ -945,6 +947,133 @@ static Image generate_atlas_image(void) {
     return atlas;
 }
 
+// ============================================================================
+// DISK CACHE
+// ============================================================================
+
+/**
+ * Header of ATLAS_CACHE_PATH, followed by width * height RGBA pixels
+ */
+typedef struct {
+    char magic[4];          // "KATL"
+    uint32_t version;       // ATLAS_GENERATOR_VERSION
+    uint32_t width;
+    uint32_t height;
+} AtlasCacheHeader;
+
+/**
+ * Load the cached atlas if it was written by this generator version
+ */
+static bool load_cached_atlas(Image* out) {
+    FILE* file = fopen(ATLAS_CACHE_PATH, "rb");
+    if (!file) return false;
+
+    AtlasCacheHeader header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+              memcmp(header.magic, "KATL", 4) == 0 &&
+              header.version == ATLAS_GENERATOR_VERSION &&
+              header.width == ATLAS_SIZE && header.height == ATLAS_SIZE;
+    if (!ok) {
+        fclose(file);
+        return false;
+    }
+
+    size_t bytes = (size_t)ATLAS_SIZE * ATLAS_SIZE * 4;
+    void* pixels = malloc(bytes);
+    if (!pixels || fread(pixels, 1, bytes, file) != bytes) {
+        free(pixels);
+        fclose(file);
+        return false;
+    }
+    fclose(file);
+
+    out->data = pixels;
+    out->width = ATLAS_SIZE;
+    out->height = ATLAS_SIZE;
+    out->mipmaps = 1;
+    out->format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return true;
+}
+
+/**
+ * Write the generated atlas for the next startup (failures only cost time)
+ */
+static void save_cached_atlas(const Image* atlas) {
+    if (atlas->format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) return;
+    if (mkdir(ATLAS_CACHE_DIRECTORY, 0755) != 0 && errno != EEXIST) {
+        printf("[ATLAS] Failed to create cache directory '%s'\n", ATLAS_CACHE_DIRECTORY);
+        return;
+    }
+
+    // Write a temporary file and rename it, so a torn write is never loaded
+    char temp_path[256];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", ATLAS_CACHE_PATH);
+    FILE* file = fopen(temp_path, "wb");
+    if (!file) return;
+
+    AtlasCacheHeader header = { {'K', 'A', 'T', 'L'}, ATLAS_GENERATOR_VERSION,
+                                (uint32_t)atlas->width, (uint32_t)atlas->height };
+    size_t bytes = (size_t)atlas->width * (size_t)atlas->height * 4;
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(atlas->data, 1, bytes, file) == bytes;
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(temp_path, ATLAS_CACHE_PATH) != 0) {
+        remove(temp_path);
+        printf("[ATLAS] Failed to write atlas cache '%s'\n", ATLAS_CACHE_PATH);
+    }
+}
+
+// ============================================================================
+// TILE ARRAY
+// ============================================================================
+
+/**
+ * Upload every atlas tile as one layer of a GL_TEXTURE_2D_ARRAY with mips
+ * Each layer wraps on its own, so tiled greedy quads never bleed into the
+ * neighbouring tile, and distant faces sample small mips instead of
+ * aliasing across the full-size tile
+ */
+static unsigned int create_tile_array(const Image* atlas) {
+    GLint max_layers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &max_layers);
+    if (max_layers < ATLAS_TILE_LAYERS || atlas->format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
+        printf("[ATLAS] Tile array unavailable (max layers %d), using the 2D atlas\n", (int)max_layers);
+        return 0;
+    }
+
+    size_t tile_bytes = (size_t)TILE_SIZE * TILE_SIZE * 4;
+    uint8_t* layers = (uint8_t*)malloc(tile_bytes * ATLAS_TILE_LAYERS);
+    if (!layers) return 0;
+
+    const uint8_t* src = (const uint8_t*)atlas->data;
+    size_t row_bytes = (size_t)TILE_SIZE * 4;
+    for (int layer = 0; layer < ATLAS_TILE_LAYERS; layer++) {
+        int tile_x = layer % TILES_PER_ROW;
+        int tile_y = layer / TILES_PER_ROW;
+        for (int row = 0; row < TILE_SIZE; row++) {
+            size_t from = ((size_t)(tile_y * TILE_SIZE + row) * ATLAS_SIZE + (size_t)tile_x * TILE_SIZE) * 4;
+            memcpy(layers + tile_bytes * layer + row_bytes * row, src + from, row_bytes);
+        }
+    }
+
+    unsigned int id = 0;
+    glGenTextures(1, &id);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, id);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, TILE_SIZE, TILE_SIZE, ATLAS_TILE_LAYERS, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, layers);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, ATLAS_TILE_MIP_LEVELS - 1);
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);  // Pixelated up close
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    free(layers);
+
+    printf("[ATLAS] Tile array created (%d layers, %d mips)\n", ATLAS_TILE_LAYERS, ATLAS_TILE_MIP_LEVELS);
+    return id;
+}
+
 // ============================================================================
 // INITIALIZATION
 // ============================================================================
@@ -955,15 +1084,21 @@ static Image generate_atlas_image(void) {
 void texture_atlas_init(void) {
     if (g_initialized) return;
 
-    printf("[ATLAS] Generating procedural texture atlas (%dx%d)...\n", ATLAS_SIZE, ATLAS_SIZE);
-
-    // Generate atlas image
-    Image atlas_image = generate_atlas_image();
+    // Reuse the cached atlas, or generate it once for this generator version
+    Image atlas_image;
+    if (load_cached_atlas(&atlas_image)) {
+        printf("[ATLAS] Loaded cached texture atlas '%s'\n", ATLAS_CACHE_PATH);
+    } else {
+        printf("[ATLAS] Generating procedural texture atlas (%dx%d)...\n", ATLAS_SIZE, ATLAS_SIZE);
+        atlas_image = generate_atlas_image();
+        save_cached_atlas(&atlas_image);
+    }
 
     // Upload to GPU
     g_atlas_texture = LoadTextureFromImage(atlas_image);
     SetTextureFilter(g_atlas_texture, TEXTURE_FILTER_POINT);  // Pixelated look
     SetTextureWrap(g_atlas_texture, TEXTURE_WRAP_REPEAT);     // Allow tiling for greedy quads
+    g_tile_array = create_tile_array(&atlas_image);
 
     // Unload CPU image
     UnloadImage(atlas_image);
@@ -981,6 +1116,34 @@ void texture_atlas_init(void) {
     }
     g_atlas_material.maps[MATERIAL_MAP_DIFFUSE].texture = g_atlas_texture;
 
+    // Block shader samples the tile array on unit 1 when it exists
+    if (block_shader.id > 0) {
+        int tile_unit = 1;
+        int use_tile_array = g_tile_array != 0 ? 1 : 0;
+        SetShaderValue(block_shader, GetShaderLocation(block_shader, "u_tile_array"), &tile_unit, SHADER_UNIFORM_INT);
+        SetShaderValue(block_shader, GetShaderLocation(block_shader, "u_use_tile_array"), &use_tile_array,
+                       SHADER_UNIFORM_INT);
+        frame_uniforms_bind_shader(block_shader);
+    }
+
+    // Water surfaces: same textures and uniforms, their own vertex format
+    Shader water_shader = LoadShader("shaders/water.vs", "shaders/water.fs");
+
+    g_water_material = LoadMaterialDefault();
+    if (water_shader.id > 0) {
+        g_water_material.shader = water_shader;
+        int tile_unit = 1;
+        int use_tile_array = g_tile_array != 0 ? 1 : 0;
+        SetShaderValue(water_shader, GetShaderLocation(water_shader, "u_tile_array"), &tile_unit, SHADER_UNIFORM_INT);
+        SetShaderValue(water_shader, GetShaderLocation(water_shader, "u_use_tile_array"), &use_tile_array,
+                       SHADER_UNIFORM_INT);
+        frame_uniforms_bind_shader(water_shader);
+        printf("[ATLAS] Water shader loaded successfully (ID: %d)\n", water_shader.id);
+    } else {
+        printf("[ATLAS] WARNING: Failed to load water shader, using default\n");
+    }
+    g_water_material.maps[MATERIAL_MAP_DIFFUSE].texture = g_atlas_texture;
+
     g_initialized = true;
 
     printf("[ATLAS] Texture atlas created successfully (ID: %d)\n", g_atlas_texture.id);
@@ -993,198 +1156,34 @@ void texture_atlas_destroy(void) {
     if (!g_initialized) return;
 
     UnloadTexture(g_atlas_texture);
+    if (g_tile_array != 0) {
+        glDeleteTextures(1, &g_tile_array);
+        g_tile_array = 0;
+    }
     UnloadMaterial(g_atlas_material);
+    UnloadShader(g_water_material.shader);  // Shares the atlas texture
+    MemFree(g_water_material.maps);
 
     g_initialized = false;
     printf("[ATLAS] Texture atlas destroyed\n");
 }
 
 // ============================================================================
-// TEXTURE COORDINATE LOOKUP
+// GPU RESOURCES
 // ============================================================================
 
 /**
- * Get texture coordinates for a block face
+ * Get the texture atlas texture
  */
-TextureCoords texture_atlas_get_coords(BlockType block_type, BlockFace face) {
-    TextureCoords coords = {0};
-
-    // Calculate UV coordinates based on tile position
-    // UV range is 0.0 to 1.0
-    float tile_uv_size = 1.0f / (float)TILES_PER_ROW;
-
-    int tile_x = 0;
-    int tile_y = 0;
-
-    // Map block types to tile positions
-    switch (block_type) {
-        case BLOCK_GRASS:
-            if (face == FACE_TOP) {
-                tile_x = 0; tile_y = 0;  // Green grass top
-            } else if (face == FACE_BOTTOM) {
-                tile_x = 1; tile_y = 0;  // Dirt bottom
-            } else {
-                tile_x = 2; tile_y = 0;  // Grass side
-            }
-            break;
-
-        case BLOCK_DIRT:
-            tile_x = 0; tile_y = 1;
-            break;
-
-        case BLOCK_STONE:
-            tile_x = 0; tile_y = 2;
-            break;
-
-        case BLOCK_WOOD:
-            if (face == FACE_TOP || face == FACE_BOTTOM) {
-                tile_x = 1; tile_y = 3;  // Wood rings
-            } else {
-                tile_x = 0; tile_y = 3;  // Bark
-            }
-            break;
-
-        case BLOCK_LEAVES:
-            tile_x = 0; tile_y = 4;
-            break;
-
-        case BLOCK_SAND:
-            tile_x = 0; tile_y = 5;
-            break;
-
-        case BLOCK_WATER:
-            tile_x = 0; tile_y = 6;
-            break;
-
-        case BLOCK_COBBLESTONE:
-            tile_x = 0; tile_y = 7;
-            break;
-
-        case BLOCK_BEDROCK:
-            tile_x = 0; tile_y = 8;
-            break;
-
-        case BLOCK_DEEP_STONE:
-            tile_x = 0; tile_y = 9;
-            break;
-
-        case BLOCK_GRAVEL:
-            tile_x = 0; tile_y = 10;
-            break;
-
-        case BLOCK_COAL_ORE:
-            tile_x = 0; tile_y = 11;  // For now, use base stone texture
-            break;
-
-        case BLOCK_IRON_ORE:
-            tile_x = 0; tile_y = 12;
-            break;
-
-        case BLOCK_GOLD_ORE:
-            tile_x = 0; tile_y = 13;
-            break;
-
-        case BLOCK_DIAMOND_ORE:
-            tile_x = 0; tile_y = 14;
-            break;
-
-        case BLOCK_MOSSY_COBBLE:
-            tile_x = 0; tile_y = 15;
-            break;
-
-        case BLOCK_STONE_BRICK:
-            tile_x = 0; tile_y = 16;
-            break;
-
-        case BLOCK_CRACKED_BRICK:
-            tile_x = 1; tile_y = 16;
-            break;
-
-        case BLOCK_CLAY:
-            tile_x = 0; tile_y = 17;
-            break;
-
-        case BLOCK_SNOW:
-            tile_x = 0; tile_y = 18;
-            break;
-
-        case BLOCK_CACTUS:
-            tile_x = 0; tile_y = 19;
-            break;
-
-        case BLOCK_BIRCH_WOOD:
-            if (face == FACE_TOP || face == FACE_BOTTOM) {
-                tile_x = 1; tile_y = 21;  // Wood rings
-            } else {
-                tile_x = 0; tile_y = 21;  // Cream bark
-            }
-            break;
-
-        case BLOCK_BIRCH_LEAVES:
-            tile_x = 0; tile_y = 22;
-            break;
-
-        case BLOCK_SPRUCE_WOOD:
-            if (face == FACE_TOP || face == FACE_BOTTOM) {
-                tile_x = 1; tile_y = 23;  // Wood rings
-            } else {
-                tile_x = 0; tile_y = 23;  // Dark bark
-            }
-            break;
-
-        case BLOCK_SPRUCE_LEAVES:
-            tile_x = 0; tile_y = 24;
-            break;
-
-        case BLOCK_ACACIA_WOOD:
-            if (face == FACE_TOP || face == FACE_BOTTOM) {
-                tile_x = 1; tile_y = 25;  // Wood rings
-            } else {
-                tile_x = 0; tile_y = 25;  // Orange bark
-            }
-            break;
-
-        case BLOCK_ACACIA_LEAVES:
-            tile_x = 0; tile_y = 26;
-            break;
-
-        case BLOCK_STALACTITE:
-            tile_x = 0; tile_y = 27;
-            break;
-
-        case BLOCK_STALAGMITE:
-            tile_x = 0; tile_y = 28;
-            break;
-
-        case BLOCK_CHEST:
-            if (face == FACE_TOP || face == FACE_BOTTOM) {
-                tile_x = 1; tile_y = 29;  // Darker lid
-            } else {
-                tile_x = 0; tile_y = 29;  // Wood sides
-            }
-            break;
-
-        default:
-            tile_x = 0; tile_y = 0;  // Default to first tile
-            break;
-    }
-
-    // Calculate UV coordinates with small padding to prevent bleeding
-    float padding = 0.001f;  // Small inset to prevent sampling adjacent tiles
-
-    coords.u_min = (float)tile_x * tile_uv_size + padding;
-    coords.v_min = (float)tile_y * tile_uv_size + padding;
-    coords.u_max = coords.u_min + tile_uv_size - padding * 2.0f;
-    coords.v_max = coords.v_min + tile_uv_size - padding * 2.0f;
-
-    return coords;
+Texture2D texture_atlas_get_texture(void) {
+    return g_atlas_texture;
 }
 
 /**
- * Get the texture atlas texture
+ * Get the tile array texture (0 = not available)
  */
-Texture2D texture_atlas_get_texture(void) {
-    return g_atlas_texture;
+unsigned int texture_atlas_get_tile_array(void) {
+    return g_tile_array;
 }
 
 /**
@@ -1195,26 +1194,8 @@ Material texture_atlas_get_material(void) {
 }
 
 /**
- * Get texture coordinates for a crack overlay stage (0-9)
+ * Get material for the water meshes (chunk_water)
  */
-TextureCoords texture_atlas_get_crack_coords(int stage) {
-    TextureCoords coords = {0};
-
-    // Clamp stage to valid range
-    if (stage < 0) stage = 0;
-    if (stage > 9) stage = 9;
-
-    float tile_uv_size = 1.0f / (float)TILES_PER_ROW;
-    float padding = 0.001f;
-
-    // Crack textures are at row 20, columns 0-9
-    int tile_x = stage;
-    int tile_y = 20;
-
-    coords.u_min = (float)tile_x * tile_uv_size + padding;
-    coords.v_min = (float)tile_y * tile_uv_size + padding;
-    coords.u_max = coords.u_min + tile_uv_size - padding * 2.0f;
-    coords.v_max = coords.v_min + tile_uv_size - padding * 2.0f;
-
-    return coords;
+Material texture_atlas_get_water_material(void) {
+    return g_water_material;
 }
@@ -4,6 +4,7 @@
 
 #include "voxel/entity/block_human.h"
 #include "voxel/entity/entity_utils.h"
+#include "voxel/render/entity_renderer.h"
 #include "voxel/world/world.h"
 #include <stdlib.h>
 #include <stdio.h>
@@ -121,7 +122,7 @@ void block_human_render(Entity* entity) {
     rlTranslatef(left_hip_x, hip_y, left_hip_z);
     rlRotatef(yaw, 0, 1, 0);
     rlRotatef(data->leg_swing_angle, 1, 0, 0);
-    DrawCube((Vector3){0, -BLOCK_HUMAN_LEG_LENGTH / 2.0f, 0},
+    entity_renderer_cube((Vector3){0, -BLOCK_HUMAN_LEG_LENGTH / 2.0f, 0},
              BLOCK_HUMAN_LEG_WIDTH, BLOCK_HUMAN_LEG_LENGTH, BLOCK_HUMAN_LEG_DEPTH,
              leg_lit);
     rlPopMatrix();
@@ -131,7 +132,7 @@ void block_human_render(Entity* entity) {
     rlTranslatef(right_hip_x, hip_y, right_hip_z);
     rlRotatef(yaw, 0, 1, 0);
     rlRotatef(-data->leg_swing_angle, 1, 0, 0);
-    DrawCube((Vector3){0, -BLOCK_HUMAN_LEG_LENGTH / 2.0f, 0},
+    entity_renderer_cube((Vector3){0, -BLOCK_HUMAN_LEG_LENGTH / 2.0f, 0},
              BLOCK_HUMAN_LEG_WIDTH, BLOCK_HUMAN_LEG_LENGTH, BLOCK_HUMAN_LEG_DEPTH,
              leg_lit);
     rlPopMatrix();
@@ -147,7 +148,7 @@ void block_human_render(Entity* entity) {
     rlPushMatrix();
     rlTranslatef(torso_center.x, torso_center.y, torso_center.z);
     rlRotatef(yaw, 0, 1, 0);
-    DrawCube((Vector3){0, 0, 0},
+    entity_renderer_cube((Vector3){0, 0, 0},
              BLOCK_HUMAN_TORSO_WIDTH, BLOCK_HUMAN_TORSO_HEIGHT, BLOCK_HUMAN_TORSO_DEPTH,
              torso_lit);
     rlPopMatrix();
@@ -171,7 +172,7 @@ void block_human_render(Entity* entity) {
     rlTranslatef(left_shoulder_x, arm_attach_height, left_shoulder_z);
     rlRotatef(yaw, 0, 1, 0);
     rlRotatef(-data->arm_swing_angle, 1, 0, 0);
-    DrawCube((Vector3){0, -BLOCK_HUMAN_ARM_LENGTH / 2.0f, 0},
+    entity_renderer_cube((Vector3){0, -BLOCK_HUMAN_ARM_LENGTH / 2.0f, 0},
              BLOCK_HUMAN_ARM_WIDTH, BLOCK_HUMAN_ARM_LENGTH, BLOCK_HUMAN_ARM_DEPTH,
              arm_lit);
     rlPopMatrix();
@@ -181,7 +182,7 @@ void block_human_render(Entity* entity) {
     rlTranslatef(right_shoulder_x, arm_attach_height, right_shoulder_z);
     rlRotatef(yaw, 0, 1, 0);
     rlRotatef(data->arm_swing_angle, 1, 0, 0);
-    DrawCube((Vector3){0, -BLOCK_HUMAN_ARM_LENGTH / 2.0f, 0},
+    entity_renderer_cube((Vector3){0, -BLOCK_HUMAN_ARM_LENGTH / 2.0f, 0},
              BLOCK_HUMAN_ARM_WIDTH, BLOCK_HUMAN_ARM_LENGTH, BLOCK_HUMAN_ARM_DEPTH,
              arm_lit);
     rlPopMatrix();
@@ -194,7 +195,7 @@ void block_human_render(Entity* entity) {
     // ========================================================================
     Vector3 head_center = {pos.x, y + BLOCK_HUMAN_HEAD_SIZE, pos.z};
 
-    DrawSphere(head_center, BLOCK_HUMAN_HEAD_SIZE, head_lit);
+    entity_renderer_sphere(head_center, BLOCK_HUMAN_HEAD_SIZE, head_lit);
 
     // Eye colors with ambient lighting
     Color eye_white = entity_apply_ambient(WHITE, data->ambient_light);
@@ -214,26 +215,26 @@ void block_human_render(Entity* entity) {
     left_eye_pos.x += forward.x * eye_offset_forward - right.x * eye_offset_side;
     left_eye_pos.y += eye_offset_y;
     left_eye_pos.z += forward.z * eye_offset_forward - right.z * eye_offset_side;
-    DrawSphere(left_eye_pos, 0.07f, eye_white);
+    entity_renderer_sphere(left_eye_pos, 0.07f, eye_white);
 
     // Left pupil (black, slightly forward)
     Vector3 left_pupil_pos = left_eye_pos;
     left_pupil_pos.x += forward.x * 0.04f;
     left_pupil_pos.z += forward.z * 0.04f;
-    DrawSphere(left_pupil_pos, 0.035f, eye_black);
+    entity_renderer_sphere(left_pupil_pos, 0.035f, eye_black);
 
     // Right eye (white part)
     Vector3 right_eye_pos = head_center;
     right_eye_pos.x += forward.x * eye_offset_forward + right.x * eye_offset_side;
     right_eye_pos.y += eye_offset_y;
     right_eye_pos.z += forward.z * eye_offset_forward + right.z * eye_offset_side;
-    DrawSphere(right_eye_pos, 0.07f, eye_white);
+    entity_renderer_sphere(right_eye_pos, 0.07f, eye_white);
 
     // Right pupil (black, slightly forward)
     Vector3 right_pupil_pos = right_eye_pos;
     right_pupil_pos.x += forward.x * 0.04f;
     right_pupil_pos.z += forward.z * 0.04f;
-    DrawSphere(right_pupil_pos, 0.035f, eye_black);
+    entity_renderer_sphere(right_pupil_pos, 0.035f, eye_black);
 
     // Optional: Draw wireframe for debugging
     #ifdef BLOCK_HUMAN_DEBUG
@@ -8,10 +8,75 @@
 #include "voxel/world/world.h"
 #include "voxel/core/block.h"
 #include <math.h>
+#include <string.h>
 
 // Shrink bounding box slightly to prevent edge sticking
 #define COLLISION_EPSILON 0.01f
 
+// ============================================================================
+// COLLISION CONTEXT
+// ============================================================================
+
+void collision_context_fetch(CollisionContext* ctx, struct World* world, Vector3 box_min, Vector3 box_max) {
+    ctx->world = world;
+    world_cursor_init(&ctx->cursor, world);
+    memset(ctx->rows, 0, sizeof(ctx->rows));
+
+    ctx->origin_x = (int)floorf(box_min.x) - COLLISION_CONTEXT_MARGIN;
+    ctx->origin_y = (int)floorf(box_min.y) - COLLISION_CONTEXT_MARGIN;
+    ctx->origin_z = (int)floorf(box_min.z) - COLLISION_CONTEXT_MARGIN;
+    int size_x = (int)floorf(box_max.x) + COLLISION_CONTEXT_MARGIN - ctx->origin_x + 1;
+    int size_y = (int)floorf(box_max.y) + COLLISION_CONTEXT_MARGIN - ctx->origin_y + 1;
+    int size_z = (int)floorf(box_max.z) + COLLISION_CONTEXT_MARGIN - ctx->origin_z + 1;
+    ctx->size_x = size_x < COLLISION_CONTEXT_SIZE ? size_x : COLLISION_CONTEXT_SIZE;
+    ctx->size_y = size_y < COLLISION_CONTEXT_SIZE ? size_y : COLLISION_CONTEXT_SIZE;
+    ctx->size_z = size_z < COLLISION_CONTEXT_SIZE ? size_z : COLLISION_CONTEXT_SIZE;
+    if (!world) {
+        ctx->size_x = ctx->size_y = ctx->size_z = 0;
+        return;
+    }
+
+    // One chunk lookup per column; unloaded columns stay air like world_get_block
+    for (int lz = 0; lz < ctx->size_z; lz++) {
+        for (int lx = 0; lx < ctx->size_x; lx++) {
+            int x = ctx->origin_x + lx;
+            int z = ctx->origin_z + lz;
+            Chunk* chunk = world_cursor_get_chunk(&ctx->cursor, x, z);
+            if (!chunk) continue;
+
+            int local_x = x - chunk->x * CHUNK_SIZE;
+            int local_z = z - chunk->z * CHUNK_SIZE;
+            uint64_t bit = 1ull << (lz * COLLISION_CONTEXT_SIZE + lx);
+            for (int ly = 0; ly < ctx->size_y; ly++) {
+                if (block_is_solid(chunk_get_block(chunk, local_x, ctx->origin_y + ly, local_z))) {
+                    ctx->rows[ly] |= bit;
+                }
+            }
+        }
+    }
+}
+
+void collision_context_fetch_entity(CollisionContext* ctx, struct World* world, const Entity* entity) {
+    collision_context_fetch(ctx, world, Vector3Add(entity->position, entity->bbox_min),
+                            Vector3Add(entity->position, entity->bbox_max));
+}
+
+bool collision_context_is_solid(CollisionContext* ctx, int x, int y, int z) {
+    int lx = x - ctx->origin_x;
+    int ly = y - ctx->origin_y;
+    int lz = z - ctx->origin_z;
+    if (lx >= 0 && lx < ctx->size_x && ly >= 0 && ly < ctx->size_y && lz >= 0 && lz < ctx->size_z) {
+        return (ctx->rows[ly] >> (lz * COLLISION_CONTEXT_SIZE + lx)) & 1;
+    }
+
+    if (!ctx->world) return false;
+    return block_is_solid(world_cursor_get_block(&ctx->cursor, x, y, z));
+}
+
+bool collision_context_is_solid_at(CollisionContext* ctx, float x, float y, float z) {
+    return collision_context_is_solid(ctx, (int)floorf(x), (int)floorf(y), (int)floorf(z));
+}
+
 // ============================================================================
 // INTERNAL HELPERS
 // ============================================================================
@@ -30,59 +95,85 @@ bool entity_is_solid_at(struct World* world, float x, float y, float z) {
     return block_is_solid(block);
 }
 
-// ============================================================================
-// COLLISION DETECTION
-// ============================================================================
+/**
+ * Blocks a box overlaps on each axis (shrunk so touching faces don't count)
+ */
+static void box_block_range(const float box_min[3], const float box_max[3], int first[3], int last[3]) {
+    for (int a = 0; a < 3; a++) {
+        first[a] = (int)floorf(box_min[a] + COLLISION_EPSILON);
+        last[a] = (int)floorf(box_max[a] - COLLISION_EPSILON);
+    }
+}
 
 /**
- * Check if an AABB at the given position collides with any solid blocks
- *
- * Uses 12-point sampling: 4 corners at 3 height levels
- * Shrinks bounding box slightly to prevent edge sticking
+ * Whether any block in the inclusive range is solid
  */
-bool entity_check_collision(struct World* world, Vector3 pos, Vector3 bbox_min, Vector3 bbox_max) {
-    if (!world) return false;
+static bool range_is_solid(CollisionContext* ctx, const int first[3], const int last[3]) {
+    for (int y = first[1]; y <= last[1]; y++) {
+        for (int z = first[2]; z <= last[2]; z++) {
+            for (int x = first[0]; x <= last[0]; x++) {
+                if (collision_context_is_solid(ctx, x, y, z)) return true;
+            }
+        }
+    }
+    return false;
+}
 
-    // Calculate world-space bounding box corners (shrunk slightly)
-    float x_min = pos.x + bbox_min.x + COLLISION_EPSILON;
-    float x_max = pos.x + bbox_max.x - COLLISION_EPSILON;
-    float z_min = pos.z + bbox_min.z + COLLISION_EPSILON;
-    float z_max = pos.z + bbox_max.z - COLLISION_EPSILON;
-
-    // Calculate 3 height levels for checking
-    float height = bbox_max.y - bbox_min.y;
-    float heights[3] = {
-        pos.y + bbox_min.y + 0.1f,           // Bottom (slightly above feet)
-        pos.y + bbox_min.y + height * 0.5f,  // Middle
-        pos.y + bbox_max.y - 0.1f            // Top (slightly below head)
-    };
-
-    // Check all 12 points (4 corners x 3 heights)
-    for (int h = 0; h < 3; h++) {
-        float y = heights[h];
-
-        // Skip if height is invalid
-        if (y < 0) continue;
-
-        // Check 4 corners at this height
-        if (entity_is_solid_at(world, x_min, y, z_min)) return true;
-        if (entity_is_solid_at(world, x_max, y, z_min)) return true;
-        if (entity_is_solid_at(world, x_min, y, z_max)) return true;
-        if (entity_is_solid_at(world, x_max, y, z_max)) return true;
+/**
+ * How far a box can move by delta along one axis before it touches a solid
+ * block: the layers of blocks its leading face passes are tested nearest first
+ */
+static float sweep_axis(CollisionContext* ctx, const float box_min[3], const float box_max[3],
+                        int axis, float delta) {
+    int first[3], last[3];
+    box_block_range(box_min, box_max, first, last);
+
+    if (delta > 0) {
+        int to = (int)floorf(box_max[axis] + delta - COLLISION_EPSILON);
+        for (int layer = last[axis] + 1; layer <= to; layer++) {
+            first[axis] = last[axis] = layer;
+            if (range_is_solid(ctx, first, last)) {
+                float allowed = (float)layer - box_max[axis];
+                return allowed > 0 ? allowed : 0;
+            }
+        }
+    } else {
+        int to = (int)floorf(box_min[axis] + delta + COLLISION_EPSILON);
+        for (int layer = first[axis] - 1; layer >= to; layer--) {
+            first[axis] = last[axis] = layer;
+            if (range_is_solid(ctx, first, last)) {
+                float allowed = (float)(layer + 1) - box_min[axis];
+                return allowed < 0 ? allowed : 0;
+            }
+        }
     }
+    return delta;
+}
 
-    return false;
+// ============================================================================
+// COLLISION DETECTION
+// ============================================================================
+
+/**
+ * Check if an AABB at the given position overlaps any solid block
+ */
+bool entity_check_collision(CollisionContext* ctx, Vector3 pos, Vector3 bbox_min, Vector3 bbox_max) {
+    if (!ctx) return false;
+
+    float box_min[3] = { pos.x + bbox_min.x, pos.y + bbox_min.y, pos.z + bbox_min.z };
+    float box_max[3] = { pos.x + bbox_max.x, pos.y + bbox_max.y, pos.z + bbox_max.z };
+    int first[3], last[3];
+    box_block_range(box_min, box_max, first, last);
+    return range_is_solid(ctx, first, last);
 }
 
 /**
  * Push an entity out of any blocks it's stuck in
  * Returns true if entity was stuck and pushed out
  */
-static bool entity_push_out_of_blocks(Entity* entity, struct World* world) {
-    if (!entity || !world) return false;
-
+static bool entity_push_out_of_blocks(Entity* entity, CollisionContext* ctx) {
     // Check if currently colliding
-    if (!entity_check_collision(world, entity->position, entity->bbox_min, entity->bbox_max)) {
+    if (!entity_check_collision(ctx, entity->position, entity->bbox_min, entity->bbox_max)) {
         return false;  // Not stuck
     }
 
@@ -95,7 +186,7 @@ static bool entity_push_out_of_blocks(Entity* entity, struct World* world) {
         Vector3 test_pos = entity->position;
         test_pos.y += push_amount * (i + 1);
 
-        if (!entity_check_collision(world, test_pos, entity->bbox_min, entity->bbox_max)) {
+        if (!entity_check_collision(ctx, test_pos, entity->bbox_min, entity->bbox_max)) {
             entity->position = test_pos;
             entity->velocity.y = 0;
             return true;
@@ -108,7 +199,7 @@ static bool entity_push_out_of_blocks(Entity* entity, struct World* world) {
             Vector3 test_pos = entity->position;
             test_pos.x += push_amount * (i + 1) * dir;
 
-            if (!entity_check_collision(world, test_pos, entity->bbox_min, entity->bbox_max)) {
+            if (!entity_check_collision(ctx, test_pos, entity->bbox_min, entity->bbox_max)) {
                 entity->position = test_pos;
                 entity->velocity.x = 0;
                 return true;
@@ -122,7 +213,7 @@ static bool entity_push_out_of_blocks(Entity* entity, struct World* world) {
             Vector3 test_pos = entity->position;
             test_pos.z += push_amount * (i + 1) * dir;
 
-            if (!entity_check_collision(world, test_pos, entity->bbox_min, entity->bbox_max)) {
+            if (!entity_check_collision(ctx, test_pos, entity->bbox_min, entity->bbox_max)) {
                 entity->position = test_pos;
                 entity->velocity.z = 0;
                 return true;
@@ -138,60 +229,47 @@ static bool entity_push_out_of_blocks(Entity* entity, struct World* world) {
 // ============================================================================
 
 /**
- * Move an entity with per-axis collision detection
+ * Move an entity with per-axis swept collision
  *
- * Returns collision flags: bit 0 = X, bit 1 = Z, bit 2 = Y
+ * Axis order X, Z, Y; returns collision flags: bit 0 = X, bit 1 = Z, bit 2 = Y
  */
-int entity_move_with_collision(Entity* entity, struct World* world, float dt) {
-    if (!entity || !world) return 0;
+int entity_move_with_collision(Entity* entity, CollisionContext* ctx, float dt) {
+    if (!entity || !ctx || !ctx->world) return 0;
 
     // First, push entity out if stuck in a block
-    entity_push_out_of_blocks(entity, world);
+    entity_push_out_of_blocks(entity, ctx);
 
-    int collision_flags = 0;
-    Vector3 new_pos = entity->position;
-
-    // ========================================================================
-    // X AXIS
-    // ========================================================================
-    if (entity->velocity.x != 0) {
-        new_pos.x += entity->velocity.x * dt;
-
-        if (entity_check_collision(world, new_pos, entity->bbox_min, entity->bbox_max)) {
-            new_pos.x = entity->position.x;
-            entity->velocity.x = 0;
-            collision_flags |= 0x01;  // X collision
-        }
-    }
+    static const int axes[3] = { 0, 2, 1 };
+    static const int axis_flags[3] = { 0x01, 0x02, 0x04 };  // X, Z, Y collision
 
-    // ========================================================================
-    // Z AXIS
-    // ========================================================================
-    if (entity->velocity.z != 0) {
-        new_pos.z += entity->velocity.z * dt;
+    float position[3] = { entity->position.x, entity->position.y, entity->position.z };
+    float* velocity[3] = { &entity->velocity.x, &entity->velocity.y, &entity->velocity.z };
+    const float bbox_min[3] = { entity->bbox_min.x, entity->bbox_min.y, entity->bbox_min.z };
+    const float bbox_max[3] = { entity->bbox_max.x, entity->bbox_max.y, entity->bbox_max.z };
 
-        if (entity_check_collision(world, new_pos, entity->bbox_min, entity->bbox_max)) {
-            new_pos.z = entity->position.z;
-            entity->velocity.z = 0;
-            collision_flags |= 0x02;  // Z collision
+    int collision_flags = 0;
+    for (int i = 0; i < 3; i++) {
+        int axis = axes[i];
+        float delta = *velocity[axis] * dt;
+        if (delta == 0) continue;
+
+        float box_min[3], box_max[3];
+        for (int a = 0; a < 3; a++) {
+            box_min[a] = position[a] + bbox_min[a];
+            box_max[a] = position[a] + bbox_max[a];
         }
-    }
-
-    // ========================================================================
-    // Y AXIS
-    // ========================================================================
-    if (entity->velocity.y != 0) {
-        new_pos.y += entity->velocity.y * dt;
 
-        if (entity_check_collision(world, new_pos, entity->bbox_min, entity->bbox_max)) {
-            new_pos.y = entity->position.y;
-            entity->velocity.y = 0;
-            collision_flags |= 0x04;  // Y collision
+        // Blocked: move up to the face and stop on this axis
+        float moved = sweep_axis(ctx, box_min, box_max, axis, delta);
+        position[axis] += moved;
+        if (moved != delta) {
+            *velocity[axis] = 0;
+            collision_flags |= axis_flags[i];
         }
     }
 
     // Update final position
-    entity->position = new_pos;
+    entity->position = (Vector3){ position[0], position[1], position[2] };
 
     return collision_flags;
 }
@@ -205,8 +283,8 @@ int entity_move_with_collision(Entity* entity, struct World* world, float dt) {
  *
  * Checks all 4 bottom corners slightly below the entity
  */
-bool entity_is_on_ground(Entity* entity, struct World* world) {
-    if (!entity || !world) return false;
+bool entity_is_on_ground(Entity* entity, CollisionContext* ctx) {
+    if (!entity || !ctx || !ctx->world) return false;
 
     // Check slightly below the entity's bottom
     float check_y = entity->position.y + entity->bbox_min.y - 0.1f;
@@ -218,10 +296,10 @@ bool entity_is_on_ground(Entity* entity, struct World* world) {
     float z_max = entity->position.z + entity->bbox_max.z;
 
     // Check all 4 corners
-    return entity_is_solid_at(world, x_min, check_y, z_min) ||
-           entity_is_solid_at(world, x_max, check_y, z_min) ||
-           entity_is_solid_at(world, x_min, check_y, z_max) ||
-           entity_is_solid_at(world, x_max, check_y, z_max);
+    return collision_context_is_solid_at(ctx, x_min, check_y, z_min) ||
+           collision_context_is_solid_at(ctx, x_max, check_y, z_min) ||
+           collision_context_is_solid_at(ctx, x_min, check_y, z_max) ||
+           collision_context_is_solid_at(ctx, x_max, check_y, z_max);
 }
 
 // ============================================================================
@@ -256,11 +334,11 @@ void entity_apply_gravity(Entity* entity, struct World* world, float dt, float g
  * - Clear at jump height (1.3 blocks up)
  * - Has a landing surface
  */
-bool entity_can_jump_obstacle(Entity* entity, struct World* world, Vector3 direction) {
-    if (!entity || !world) return false;
+bool entity_can_jump_obstacle(Entity* entity, CollisionContext* ctx, Vector3 direction) {
+    if (!entity || !ctx || !ctx->world) return false;
 
     // Must be on ground to jump
-    if (!entity_is_on_ground(entity, world)) return false;
+    if (!entity_is_on_ground(entity, ctx)) return false;
 
     // Check position ahead (0.6 blocks in movement direction)
     float look_ahead = 0.6f;
@@ -269,17 +347,17 @@ bool entity_can_jump_obstacle(Entity* entity, struct World* world, Vector3 direc
     float base_y = entity->position.y;
 
     // Check if blocked at feet level (0.3 blocks up)
-    bool blocked_low = entity_is_solid_at(world, ahead_x, base_y + 0.3f, ahead_z);
+    bool blocked_low = collision_context_is_solid_at(ctx, ahead_x, base_y + 0.3f, ahead_z);
 
     // Check if clear at jump height (1.3 blocks up - enough clearance for jump arc)
-    bool clear_high = !entity_is_solid_at(world, ahead_x, base_y + 1.3f, ahead_z);
+    bool clear_high = !collision_context_is_solid_at(ctx, ahead_x, base_y + 1.3f, ahead_z);
 
     // Check if there's a landing surface on top of the obstacle
     // Look for solid block at obstacle top level
-    bool has_landing = entity_is_solid_at(world, ahead_x, base_y + 0.5f, ahead_z);
+    bool has_landing = collision_context_is_solid_at(ctx, ahead_x, base_y + 0.5f, ahead_z);
 
     // Also check there's headroom at the landing position
-    bool landing_clear = !entity_is_solid_at(world, ahead_x, base_y + 2.0f, ahead_z);
+    bool landing_clear = !collision_context_is_solid_at(ctx, ahead_x, base_y + 2.0f, ahead_z);
 
     return blocked_low && clear_high && has_landing && landing_clear;
 }
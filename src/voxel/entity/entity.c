@@ -2,24 +2,296 @@
  * Entity System Implementation
  */
 
+#define _POSIX_C_SOURCE 199309L
+#include <unistd.h>
 #include "voxel/entity/entity.h"
+#include "voxel/entity/nav.h"
+#include "voxel/world/world.h"
+#include "voxel/player/player.h"
+#include "voxel/render/entity_renderer.h"
+#include "voxel/core/memory.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <math.h>
+
+#define ENTITY_POOL_INITIAL_CAPACITY 16
+
+// ============================================================================
+// POOLS AND SPATIAL HASH
+// ============================================================================
+
+static bool valid_type(EntityType type) {
+    return type >= 0 && type < ENTITY_TYPE_COUNT;
+}
+
+static int grid_cell(float coord) {
+    return (int)floorf(coord / (float)ENTITY_GRID_CELL_SIZE);
+}
+
+static uint32_t grid_bucket(int cell_x, int cell_z) {
+    uint32_t h = (uint32_t)cell_x * 73856093u ^ (uint32_t)cell_z * 19349663u;
+    return h & (ENTITY_GRID_BUCKETS - 1);
+}
+
+/**
+ * Copy an entity's hot fields into its pool slot
+ */
+static void pool_store(EntityPool* pool, int index) {
+    Entity* e = pool->entities[index];
+    pool->positions[index] = e->position;
+    pool->velocities[index] = e->velocity;
+    pool->bounds[index] = (BoundingBox){
+        Vector3Add(e->position, e->bbox_min),
+        Vector3Add(e->position, e->bbox_max)
+    };
+}
+
+// Heap per pool slot, grid entry and update list entry (MEMORY_ENTITIES)
+#define POOL_SLOT_BYTES (sizeof(Entity*) + 2 * sizeof(Vector3) + sizeof(BoundingBox))
+#define TICK_SLOT_BYTES (sizeof(Entity*) + sizeof(float))
+
+static bool pool_reserve(EntityPool* pool, int needed) {
+    if (needed <= pool->capacity) return true;
+
+    int capacity = pool->capacity > 0 ? pool->capacity * 2 : ENTITY_POOL_INITIAL_CAPACITY;
+    while (capacity < needed) capacity *= 2;
+
+    Entity** entities = (Entity**)realloc(pool->entities, capacity * sizeof(Entity*));
+    if (entities) pool->entities = entities;
+    Vector3* positions = (Vector3*)realloc(pool->positions, capacity * sizeof(Vector3));
+    if (positions) pool->positions = positions;
+    Vector3* velocities = (Vector3*)realloc(pool->velocities, capacity * sizeof(Vector3));
+    if (velocities) pool->velocities = velocities;
+    BoundingBox* bounds = (BoundingBox*)realloc(pool->bounds, capacity * sizeof(BoundingBox));
+    if (bounds) pool->bounds = bounds;
+
+    if (!entities || !positions || !velocities || !bounds) {
+        printf("[ENTITY] Failed to grow entity pool to %d\n", capacity);
+        return false;
+    }
+    memory_track(MEMORY_ENTITIES, (ptrdiff_t)((size_t)(capacity - pool->capacity) * POOL_SLOT_BYTES));
+    pool->capacity = capacity;
+    return true;
+}
+
+/**
+ * Refresh the packed arrays from the entities and rebuild the spatial hash
+ */
+static void entity_manager_rebuild_grid(EntityManager* manager) {
+    int total = 0;
+    for (int t = 0; t < ENTITY_TYPE_COUNT; t++) total += manager->pools[t].count;
+
+    if (total > manager->grid_capacity) {
+        int capacity = manager->grid_capacity > 0 ? manager->grid_capacity : ENTITY_POOL_INITIAL_CAPACITY;
+        while (capacity < total) capacity *= 2;
+        EntityGridEntry* entries = (EntityGridEntry*)realloc(manager->grid_entries,
+                                                             capacity * sizeof(EntityGridEntry));
+        if (!entries) {
+            printf("[ENTITY] Failed to grow spatial hash to %d entries\n", capacity);
+            return;  // Stays invalid; queries fall back to scanning the pools
+        }
+        memory_track(MEMORY_ENTITIES,
+                     (ptrdiff_t)((size_t)(capacity - manager->grid_capacity) * sizeof(EntityGridEntry)));
+        manager->grid_entries = entries;
+        manager->grid_capacity = capacity;
+    }
+
+    for (int b = 0; b < ENTITY_GRID_BUCKETS; b++) manager->grid_heads[b] = -1;
+
+    float reach = 0.0f;
+    int used = 0;
+    for (int t = 0; t < ENTITY_TYPE_COUNT; t++) {
+        EntityPool* pool = &manager->pools[t];
+        for (int i = 0; i < pool->count; i++) {
+            pool_store(pool, i);
+
+            Entity* e = pool->entities[i];
+            reach = fmaxf(reach, fmaxf(fmaxf(fabsf(e->bbox_min.x), fabsf(e->bbox_max.x)),
+                                       fmaxf(fabsf(e->bbox_min.z), fabsf(e->bbox_max.z))));
+
+            EntityGridEntry* entry = &manager->grid_entries[used];
+            entry->cell_x = grid_cell(pool->positions[i].x);
+            entry->cell_z = grid_cell(pool->positions[i].z);
+            entry->type = (uint16_t)t;
+            entry->index = i;
+
+            uint32_t bucket = grid_bucket(entry->cell_x, entry->cell_z);
+            entry->next = manager->grid_heads[bucket];
+            manager->grid_heads[bucket] = used++;
+        }
+    }
+
+    manager->grid_reach = reach;
+    manager->grid_valid = true;
+}
+
+static bool boxes_overlap(BoundingBox a, Vector3 min, Vector3 max) {
+    return a.min.x <= max.x && a.max.x >= min.x &&
+           a.min.y <= max.y && a.max.y >= min.y &&
+           a.min.z <= max.z && a.max.z >= min.z;
+}
+
+/**
+ * Report one query hit if the entity is live and overlaps
+ */
+static void query_test(EntityPool* pool, int index, Vector3 min, Vector3 max,
+                       Entity** out, int max_out, int* found) {
+    Entity* e = pool->entities[index];
+    if (!e->active || !boxes_overlap(pool->bounds[index], min, max)) return;
+    if (*found < max_out) out[*found] = e;
+    (*found)++;
+}
+
+// ============================================================================
+// PARALLEL UPDATE PHASE
+// ============================================================================
+
+/**
+ * Claim and run batches of the work list until it is exhausted
+ */
+static void update_run_batches(EntityManager* manager) {
+    while (true) {
+        pthread_mutex_lock(&manager->job_mutex);
+        int start = manager->job_next;
+        manager->job_next += ENTITY_UPDATE_BATCH;
+        pthread_mutex_unlock(&manager->job_mutex);
+
+        if (start >= manager->tick_count) return;
+        int end = start + ENTITY_UPDATE_BATCH;
+        if (end > manager->tick_count) end = manager->tick_count;
+
+        for (int i = start; i < end; i++) {
+            Entity* e = manager->tick_entities[i];
+            e->update(e, manager->job_world, manager->tick_dt[i]);
+        }
+    }
+}
+
+static void* update_thread_main(void* arg) {
+    EntityManager* manager = (EntityManager*)arg;
+    uint32_t seen = 0;
+
+    pthread_mutex_lock(&manager->job_mutex);
+    while (true) {
+        while (manager->running && manager->job_generation == seen) {
+            pthread_cond_wait(&manager->job_start, &manager->job_mutex);
+        }
+        if (!manager->running) break;
+        seen = manager->job_generation;
+        pthread_mutex_unlock(&manager->job_mutex);
+
+        update_run_batches(manager);
+
+        pthread_mutex_lock(&manager->job_mutex);
+        if (--manager->job_active == 0) {
+            pthread_cond_signal(&manager->job_done);
+        }
+    }
+    pthread_mutex_unlock(&manager->job_mutex);
+    return NULL;
+}
+
+static void update_start_threads(EntityManager* manager) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int wanted = cores > 1 ? (int)cores - 1 : 0;  // The main thread works too
+    if (wanted > ENTITY_UPDATE_THREADS_MAX) wanted = ENTITY_UPDATE_THREADS_MAX;
+
+    pthread_mutex_init(&manager->job_mutex, NULL);
+    pthread_cond_init(&manager->job_start, NULL);
+    pthread_cond_init(&manager->job_done, NULL);
+    manager->running = true;
+
+    for (int i = 0; i < wanted; i++) {
+        if (pthread_create(&manager->threads[i], NULL, update_thread_main, manager) != 0) {
+            printf("[ENTITY] Failed to start update thread %d\n", i);
+            break;
+        }
+        manager->thread_count++;
+    }
+}
+
+static void update_stop_threads(EntityManager* manager) {
+    pthread_mutex_lock(&manager->job_mutex);
+    manager->running = false;
+    pthread_cond_broadcast(&manager->job_start);
+    pthread_mutex_unlock(&manager->job_mutex);
+
+    for (int i = 0; i < manager->thread_count; i++) {
+        pthread_join(manager->threads[i], NULL);
+    }
+    manager->thread_count = 0;
+
+    pthread_cond_destroy(&manager->job_done);
+    pthread_cond_destroy(&manager->job_start);
+    pthread_mutex_destroy(&manager->job_mutex);
+}
+
+/**
+ * Collect the entities due this tick
+ * Far entities accumulate their time and run on a staggered subset of ticks.
+ */
+static void update_collect(EntityManager* manager, struct World* world, float dt) {
+    manager->tick_count = 0;
+
+    bool has_player = world && world->player;
+    Vector3 player_pos = has_player ? world->player->position : (Vector3){0, 0, 0};
+    float far_sq = ENTITY_FAR_DISTANCE * ENTITY_FAR_DISTANCE;
+
+    for (int t = 0; t < ENTITY_TYPE_COUNT; t++) {
+        EntityPool* pool = &manager->pools[t];
+        if (manager->tick_count + pool->count > manager->tick_capacity) {
+            int capacity = manager->tick_capacity > 0 ? manager->tick_capacity : ENTITY_POOL_INITIAL_CAPACITY;
+            while (capacity < manager->tick_count + pool->count) capacity *= 2;
+            Entity** entities = (Entity**)realloc(manager->tick_entities, capacity * sizeof(Entity*));
+            if (entities) manager->tick_entities = entities;
+            float* times = (float*)realloc(manager->tick_dt, capacity * sizeof(float));
+            if (times) manager->tick_dt = times;
+            if (!entities || !times) {
+                printf("[ENTITY] Failed to grow update list to %d\n", capacity);
+                return;
+            }
+            memory_track(MEMORY_ENTITIES, (ptrdiff_t)((size_t)(capacity - manager->tick_capacity) * TICK_SLOT_BYTES));
+            manager->tick_capacity = capacity;
+        }
+
+        for (int i = 0; i < pool->count; i++) {
+            Entity* e = pool->entities[i];
+            if (!e->active || !e->update) continue;
+
+            e->pending_dt += dt;
+            if (has_player) {
+                float dx = e->position.x - player_pos.x;
+                float dz = e->position.z - player_pos.z;
+                if (dx * dx + dz * dz > far_sq &&
+                    (manager->tick + e->id) % ENTITY_FAR_TICK_INTERVAL != 0) {
+                    continue;
+                }
+            }
+
+            manager->tick_entities[manager->tick_count] = e;
+            manager->tick_dt[manager->tick_count] = fminf(e->pending_dt, ENTITY_MAX_TICK_DT);
+            manager->tick_count++;
+            e->pending_dt = 0.0f;
+        }
+    }
+}
 
 // ============================================================================
 // ENTITY MANAGER
 // ============================================================================
 
 EntityManager* entity_manager_create(void) {
-    EntityManager* manager = (EntityManager*)malloc(sizeof(EntityManager));
+    EntityManager* manager = (EntityManager*)calloc(1, sizeof(EntityManager));
     if (!manager) {
         printf("[ENTITY] Failed to allocate entity manager\n");
         return NULL;
     }
 
-    manager->entities = NULL;
     manager->next_id = 1;  // Start IDs at 1 (0 = invalid)
     manager->entity_count = 0;
+    manager->grid_valid = false;
+    manager->nav = nav_create();
+    update_start_threads(manager);
 
     return manager;
 }
@@ -27,14 +299,27 @@ EntityManager* entity_manager_create(void) {
 void entity_manager_destroy(EntityManager* manager) {
     if (!manager) return;
 
-    // Destroy all entities in the linked list
-    Entity* current = manager->entities;
-    while (current) {
-        Entity* next = current->next;
-        entity_destroy(current);
-        current = next;
+    update_stop_threads(manager);
+
+    // Destroy all entities in every pool
+    for (int t = 0; t < ENTITY_TYPE_COUNT; t++) {
+        EntityPool* pool = &manager->pools[t];
+        for (int i = 0; i < pool->count; i++) {
+            entity_destroy(pool->entities[i]);
+        }
+        memory_track(MEMORY_ENTITIES, -(ptrdiff_t)((size_t)pool->capacity * POOL_SLOT_BYTES));
+        free(pool->entities);
+        free(pool->positions);
+        free(pool->velocities);
+        free(pool->bounds);
     }
 
+    memory_track(MEMORY_ENTITIES, -(ptrdiff_t)((size_t)manager->grid_capacity * sizeof(EntityGridEntry) +
+                                               (size_t)manager->tick_capacity * TICK_SLOT_BYTES));
+    free(manager->grid_entries);
+    free(manager->tick_entities);
+    free(manager->tick_dt);
+    nav_destroy(manager->nav);
     free(manager);
 }
 
@@ -48,6 +333,7 @@ Entity* entity_create(EntityType type) {
         printf("[ENTITY] Failed to allocate entity\n");
         return NULL;
     }
+    memory_track(MEMORY_ENTITIES, (ptrdiff_t)sizeof(Entity));
 
     // Initialize with defaults
     entity->id = 0;  // Will be assigned by manager
@@ -61,7 +347,9 @@ Entity* entity_create(EntityType type) {
     entity->render = NULL;
     entity->destroy_data = NULL;
     entity->data = NULL;
-    entity->next = NULL;
+    entity->pool_index = -1;
+    entity->pending_dt = 0.0f;
+    entity->remote_id = 0;
     entity->active = true;
 
     return entity;
@@ -75,6 +363,7 @@ void entity_destroy(Entity* entity) {
         entity->destroy_data(entity);
     }
 
+    memory_track(MEMORY_ENTITIES, -(ptrdiff_t)sizeof(Entity));
     free(entity);
 }
 
@@ -84,54 +373,180 @@ void entity_destroy(Entity* entity) {
 
 void entity_manager_add(EntityManager* manager, Entity* entity) {
     if (!manager || !entity) return;
+    if (!valid_type(entity->type)) {
+        printf("[ENTITY] Cannot add entity of unknown type %d\n", (int)entity->type);
+        return;
+    }
+
+    EntityPool* pool = &manager->pools[entity->type];
+    if (!pool_reserve(pool, pool->count + 1)) return;
 
     // Assign unique ID
     entity->id = manager->next_id++;
+    entity->previous_position = entity->position;  // Spawns are not interpolated from the origin
+    entity->previous_yaw = entity->rotation.y;
 
-    // Add to front of linked list
-    entity->next = manager->entities;
-    manager->entities = entity;
+    // Append to its type's pool
+    entity->pool_index = pool->count;
+    pool->entities[pool->count] = entity;
+    pool_store(pool, pool->count);
+    pool->count++;
     manager->entity_count++;
+    manager->grid_valid = false;
 }
 
 void entity_manager_remove(EntityManager* manager, Entity* entity) {
-    if (!manager || !entity) return;
+    if (!manager || !entity || !valid_type(entity->type)) return;
 
-    // Find and remove from linked list
-    Entity** current = &manager->entities;
-    while (*current) {
-        if (*current == entity) {
-            *current = entity->next;
-            manager->entity_count--;
-            printf("[ENTITY] Removed entity #%u\n", entity->id);
-            return;
-        }
-        current = &(*current)->next;
+    EntityPool* pool = &manager->pools[entity->type];
+    int index = entity->pool_index;
+    if (index < 0 || index >= pool->count || pool->entities[index] != entity) return;
+    nav_cancel(manager->nav, entity);
+
+    // Move the last entity into the freed slot
+    int last = pool->count - 1;
+    if (index != last) {
+        pool->entities[index] = pool->entities[last];
+        pool->positions[index] = pool->positions[last];
+        pool->velocities[index] = pool->velocities[last];
+        pool->bounds[index] = pool->bounds[last];
+        pool->entities[index]->pool_index = index;
     }
+    pool->count--;
+    entity->pool_index = -1;
+    manager->entity_count--;
+    manager->grid_valid = false;
+    printf("[ENTITY] Removed entity #%u\n", entity->id);
 }
 
 void entity_manager_update(EntityManager* manager, struct World* world, float dt) {
     if (!manager) return;
 
-    Entity* current = manager->entities;
-    while (current) {
-        if (current->active && current->update) {
-            current->update(current, world, dt);
+    // Where this tick starts, for drawing between ticks
+    for (int t = 0; t < ENTITY_TYPE_COUNT; t++) {
+        EntityPool* pool = &manager->pools[t];
+        for (int i = 0; i < pool->count; i++) {
+            Entity* e = pool->entities[i];
+            e->previous_position = e->position;
+            e->previous_yaw = e->rotation.y;
         }
-        current = current->next;
     }
+
+    // Shared navigation jobs the mobs read in phase 1
+    nav_update(manager->nav, world);
+
+    // Phase 1: update callbacks, reading the world only
+    update_collect(manager, world, dt);
+    manager->tick++;
+
+    if (manager->thread_count > 0 && manager->tick_count >= ENTITY_PARALLEL_MIN) {
+        pthread_mutex_lock(&manager->job_mutex);
+        manager->job_world = world;
+        manager->job_next = 0;
+        manager->job_active = manager->thread_count;
+        manager->job_generation++;
+        pthread_cond_broadcast(&manager->job_start);
+        pthread_mutex_unlock(&manager->job_mutex);
+
+        update_run_batches(manager);
+
+        pthread_mutex_lock(&manager->job_mutex);
+        while (manager->job_active > 0) {
+            pthread_cond_wait(&manager->job_done, &manager->job_mutex);
+        }
+        pthread_mutex_unlock(&manager->job_mutex);
+    } else {
+        for (int i = 0; i < manager->tick_count; i++) {
+            Entity* e = manager->tick_entities[i];
+            e->update(e, world, manager->tick_dt[i]);
+        }
+    }
+
+    // Phase 2: commit positions to the pools and the spatial hash
+    entity_manager_rebuild_grid(manager);
 }
 
-void entity_manager_render(EntityManager* manager) {
+void entity_manager_render(EntityManager* manager, float alpha) {
     if (!manager) return;
 
-    Entity* current = manager->entities;
-    while (current) {
-        if (current->active && current->render) {
-            current->render(current);
+    entity_renderer_begin();
+
+    for (int t = 0; t < ENTITY_TYPE_COUNT; t++) {
+        EntityPool* pool = &manager->pools[t];
+        for (int i = 0; i < pool->count; i++) {
+            Entity* current = pool->entities[i];
+            if (!current->active || !current->render) continue;
+
+            // Draw between the last two ticks; a host's entities move with
+            // network updates instead and are drawn where they are
+            Vector3 position = current->position;
+            float yaw = current->rotation.y;
+            if (current->remote_id == 0) {
+                current->position = Vector3Lerp(current->previous_position, position, alpha);
+                float turn = remainderf(yaw - current->previous_yaw, 360.0f);  // Shortest way round
+                current->rotation.y = current->previous_yaw + turn * alpha;
+            }
+
+            // Parts stick out of the collision box a little (heads, snouts)
+            Vector3 box_min = Vector3Add(current->position, current->bbox_min);
+            Vector3 box_max = Vector3Add(current->position, current->bbox_max);
+            box_min = Vector3SubtractValue(box_min, 0.5f);
+            box_max = Vector3AddValue(box_max, 0.5f);
+            if (entity_renderer_box_visible(box_min, box_max)) {
+                current->render(current);
+            }
+
+            current->position = position;
+            current->rotation.y = yaw;
+        }
+    }
+
+    entity_renderer_end();
+}
+
+int entity_manager_query_box(EntityManager* manager, Vector3 min, Vector3 max,
+                             Entity** out, int max_out) {
+    if (!manager) return 0;
+    if (!out) max_out = 0;
+    if (!manager->grid_valid) entity_manager_rebuild_grid(manager);
+
+    int found = 0;
+
+    // Entities are hashed by position; widen by the largest box extent
+    float reach = manager->grid_reach;
+    int cell_min_x = grid_cell(min.x - reach);
+    int cell_max_x = grid_cell(max.x + reach);
+    int cell_min_z = grid_cell(min.z - reach);
+    int cell_max_z = grid_cell(max.z + reach);
+    long cells = (long)(cell_max_x - cell_min_x + 1) * (long)(cell_max_z - cell_min_z + 1);
+
+    if (!manager->grid_valid || cells > ENTITY_GRID_BUCKETS) {
+        // Huge box (or no hash): a straight scan of the packed boxes is cheaper
+        for (int t = 0; t < ENTITY_TYPE_COUNT; t++) {
+            EntityPool* pool = &manager->pools[t];
+            for (int i = 0; i < pool->count; i++) {
+                query_test(pool, i, min, max, out, max_out, &found);
+            }
         }
-        current = current->next;
+        return found;
     }
+
+    for (int cz = cell_min_z; cz <= cell_max_z; cz++) {
+        for (int cx = cell_min_x; cx <= cell_max_x; cx++) {
+            int e = manager->grid_heads[grid_bucket(cx, cz)];
+            while (e >= 0) {
+                EntityGridEntry* entry = &manager->grid_entries[e];
+                // Buckets are shared; the cell check also keeps hits unique
+                if (entry->cell_x == cx && entry->cell_z == cz) {
+                    query_test(&manager->pools[entry->type], entry->index,
+                               min, max, out, max_out, &found);
+                }
+                e = entry->next;
+            }
+        }
+    }
+
+    return found;
 }
 
 int entity_manager_get_count(EntityManager* manager) {
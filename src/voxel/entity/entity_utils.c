@@ -6,10 +6,21 @@
 
 #include "voxel/entity/entity_utils.h"
 #include <stdlib.h>
+#include <stdint.h>
 #include <math.h>
 
+// Entity updates run on several threads; each keeps its own generator
+static _Thread_local uint32_t g_random_state = 0;
+
 float entity_random_range(float min, float max) {
-    return min + ((float)rand() / RAND_MAX) * (max - min);
+    if (g_random_state == 0) {
+        g_random_state = (uint32_t)rand() | 1u;  // Seeded once per thread
+    }
+    // xorshift32
+    g_random_state ^= g_random_state << 13;
+    g_random_state ^= g_random_state >> 17;
+    g_random_state ^= g_random_state << 5;
+    return min + ((float)(g_random_state >> 8) / (float)(1u << 24)) * (max - min);
 }
 
 Vector3 entity_random_direction(void) {
@@ -0,0 +1,528 @@
+/**
+ * Mob Navigation Implementation
+ *
+ * Flee field (breadth-first over the nav heightfield) and batched A* paths
+ */
+
+#include "voxel/entity/nav.h"
+#include "voxel/entity/collision.h"
+#include "voxel/entity/entity_utils.h"
+#include "voxel/world/world.h"
+#include "voxel/player/player.h"
+#include "voxel/core/memory.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// Neighbor steps: 4 orthogonal, then 4 diagonal
+static const int g_step_x[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+static const int g_step_z[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+// ============================================================================
+// HEIGHTFIELD
+// ============================================================================
+
+uint8_t nav_sample(WorldCursor* cursor, int x, int z, int* out_height) {
+    Chunk* chunk = world_cursor_get_chunk(cursor, x, z);
+    if (!chunk) {
+        *out_height = 0;
+        return 0;
+    }
+    int column = ((z & (CHUNK_SIZE - 1)) << 4) | (x & (CHUNK_SIZE - 1));
+    *out_height = chunk->nav_height[column];
+    return chunk->nav_flags[column];
+}
+
+/**
+ * Whether a mob with its feet at from can walk onto a column
+ */
+static bool nav_can_step(int from, int to, uint8_t to_flags) {
+    return (to_flags & CHUNK_NAV_WALK) && to <= from + 1 && to + NAV_MAX_DROP >= from;
+}
+
+static int feet_block(Vector3 position) {
+    return (int)floorf(position.y + 0.05f);
+}
+
+// ============================================================================
+// FLEE FIELD
+// ============================================================================
+
+/**
+ * Steps from the player's column to every column of the field
+ * The player's own column is left whatever it is (the player may fly or
+ * stand on a pillar); its neighbors are reached if they are walkable.
+ */
+static void flee_build(NavFleeField* field, World* world, int threat_x, int threat_z) {
+    WorldCursor cursor;
+    world_cursor_init(&cursor, world);
+
+    field->origin_x = threat_x - NAV_FIELD_SIZE / 2;
+    field->origin_z = threat_z - NAV_FIELD_SIZE / 2;
+    for (int z = 0; z < NAV_FIELD_SIZE; z++) {
+        for (int x = 0; x < NAV_FIELD_SIZE; x++) {
+            int i = z * NAV_FIELD_SIZE + x;
+            int height;
+            field->flags[i] = nav_sample(&cursor, field->origin_x + x, field->origin_z + z, &height);
+            field->height[i] = (uint8_t)height;
+            field->dist[i] = NAV_UNREACHED;
+        }
+    }
+
+    int center = (NAV_FIELD_SIZE / 2) * NAV_FIELD_SIZE + NAV_FIELD_SIZE / 2;
+    int head = 0, tail = 0;
+    field->dist[center] = 0;
+    field->queue[tail++] = (uint16_t)center;
+
+    while (head < tail) {
+        int i = field->queue[head++];
+        int x = i % NAV_FIELD_SIZE;
+        int z = i / NAV_FIELD_SIZE;
+        bool seed = i == center;
+
+        bool open[4] = {false, false, false, false};
+        for (int d = 0; d < 8; d++) {
+            int nx = x + g_step_x[d];
+            int nz = z + g_step_z[d];
+            if (nx < 0 || nz < 0 || nx >= NAV_FIELD_SIZE || nz >= NAV_FIELD_SIZE) continue;
+            int n = nz * NAV_FIELD_SIZE + nx;
+
+            bool can_step = seed ? (field->flags[n] & CHUNK_NAV_WALK) != 0
+                                 : nav_can_step(field->height[i], field->height[n], field->flags[n]);
+            if (d < 4) open[d] = can_step;
+            // No cutting corners: both orthogonal steps of a diagonal must be open
+            else if (!open[g_step_x[d] > 0 ? 0 : 1] || !open[g_step_z[d] > 0 ? 2 : 3]) continue;
+
+            if (!can_step || field->dist[n] != NAV_UNREACHED) continue;
+            field->dist[n] = (uint16_t)(field->dist[i] + 1);
+            field->queue[tail++] = (uint16_t)n;
+        }
+    }
+
+    field->threat_x = threat_x;
+    field->threat_z = threat_z;
+    field->valid = true;
+}
+
+bool nav_flee_direction(NavSystem* nav, Vector3 position, Vector3* out_dir) {
+    if (!nav) return false;
+    const NavFleeField* field = &nav->flee;
+    atomic_store_explicit(&nav->flee.wanted, true, memory_order_relaxed);
+    if (!field->valid || nav->tick - field->built_tick > NAV_FIELD_REFRESH) return false;
+
+    int x = (int)floorf(position.x) - field->origin_x;
+    int z = (int)floorf(position.z) - field->origin_z;
+    if (x < 1 || z < 1 || x >= NAV_FIELD_SIZE - 1 || z >= NAV_FIELD_SIZE - 1) return false;
+    int i = z * NAV_FIELD_SIZE + x;
+    if (field->dist[i] == NAV_UNREACHED) return false;
+
+    // Farthest steppable neighbor; one no farther along the field only if it
+    // gets farther from the player in a straight line
+    int ax = x + field->origin_x - field->threat_x;
+    int az = z + field->origin_z - field->threat_z;
+    int best = -1;
+    int best_dist = field->dist[i];
+    int best_away = ax * ax + az * az;
+    bool open[4] = {false, false, false, false};
+    for (int d = 0; d < 8; d++) {
+        int nx = x + g_step_x[d];
+        int nz = z + g_step_z[d];
+        int n = nz * NAV_FIELD_SIZE + nx;
+        bool can_step = nav_can_step(field->height[i], field->height[n], field->flags[n]);
+        if (d < 4) open[d] = can_step;
+        else if (!open[g_step_x[d] > 0 ? 0 : 1] || !open[g_step_z[d] > 0 ? 2 : 3]) continue;
+        if (!can_step || field->dist[n] == NAV_UNREACHED || field->dist[n] < field->dist[i]) continue;
+
+        int away = (ax + g_step_x[d]) * (ax + g_step_x[d]) + (az + g_step_z[d]) * (az + g_step_z[d]);
+        if (field->dist[n] > best_dist || (field->dist[n] == best_dist && away > best_away)) {
+            best = n;
+            best_dist = field->dist[n];
+            best_away = away;
+        }
+    }
+    if (best < 0) return false;
+
+    float dx = (float)(field->origin_x + best % NAV_FIELD_SIZE) + 0.5f - position.x;
+    float dz = (float)(field->origin_z + best / NAV_FIELD_SIZE) + 0.5f - position.z;
+    float length = sqrtf(dx * dx + dz * dz);
+    if (length < 0.001f) return false;
+    *out_dir = (Vector3){dx / length, 0, dz / length};
+    return true;
+}
+
+// ============================================================================
+// PATHS
+// ============================================================================
+
+/**
+ * Node of window cell i, read from the heightfield on its first touch in this search
+ */
+static NavNode* path_node(NavSystem* nav, WorldCursor* cursor, int origin_x, int origin_z, int i) {
+    NavNode* node = &nav->nodes[i];
+    if (node->stamp != nav->search) {
+        int height;
+        node->flags = nav_sample(cursor, origin_x + i % NAV_PATH_WINDOW, origin_z + i / NAV_PATH_WINDOW, &height);
+        node->height = (uint8_t)height;
+        node->cost = UINT16_MAX;
+        node->parent = -1;
+        node->closed = false;
+        node->stamp = nav->search;
+    }
+    return node;
+}
+
+static void heap_push(NavHeapEntry* heap, int* count, uint32_t score, int index) {
+    int i = (*count)++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (heap[parent].score <= score) break;
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = (NavHeapEntry){score, (int16_t)index};
+}
+
+static NavHeapEntry heap_pop(NavHeapEntry* heap, int* count) {
+    NavHeapEntry top = heap[0];
+    NavHeapEntry last = heap[--(*count)];
+    int i = 0;
+    for (;;) {
+        int child = i * 2 + 1;
+        if (child >= *count) break;
+        if (child + 1 < *count && heap[child + 1].score < heap[child].score) child++;
+        if (heap[child].score >= last.score) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    if (*count > 0) heap[i] = last;
+    return top;
+}
+
+/**
+ * Octile distance, 10 per straight step and 14 per diagonal
+ */
+static uint32_t path_estimate(int x, int z, int goal_x, int goal_z) {
+    int dx = abs(x - goal_x);
+    int dz = abs(z - goal_z);
+    return (uint32_t)(10 * (dx + dz) - 6 * (dx < dz ? dx : dz));
+}
+
+/**
+ * A* over the window around the start; an unreachable goal yields a path
+ * to the closest column found. Returns the nodes expanded.
+ */
+static int path_solve(NavSystem* nav, WorldCursor* cursor, const NavRequest* request) {
+    if (++nav->search == 0) {
+        memset(nav->nodes, 0, sizeof(nav->nodes));
+        nav->search = 1;
+    }
+
+    int origin_x = request->start_x - NAV_PATH_WINDOW / 2;
+    int origin_z = request->start_z - NAV_PATH_WINDOW / 2;
+    int goal_x = request->goal_x - origin_x;
+    int goal_z = request->goal_z - origin_z;
+    if (goal_x < 0) goal_x = 0;
+    if (goal_z < 0) goal_z = 0;
+    if (goal_x >= NAV_PATH_WINDOW) goal_x = NAV_PATH_WINDOW - 1;
+    if (goal_z >= NAV_PATH_WINDOW) goal_z = NAV_PATH_WINDOW - 1;
+
+    // The mob may stand where it could not walk to (water, a ledge under leaves)
+    int start = (NAV_PATH_WINDOW / 2) * NAV_PATH_WINDOW + NAV_PATH_WINDOW / 2;
+    NavNode* start_node = path_node(nav, cursor, origin_x, origin_z, start);
+    start_node->height = (uint8_t)request->start_y;
+    start_node->cost = 0;
+
+    int heap_count = 0;
+    uint32_t start_estimate = path_estimate(NAV_PATH_WINDOW / 2, NAV_PATH_WINDOW / 2, goal_x, goal_z);
+    heap_push(nav->heap, &heap_count, start_estimate, start);
+    int best = start;
+    uint32_t best_estimate = start_estimate;
+    int expanded = 0;
+
+    while (heap_count > 0 && expanded < NAV_PATH_NODES) {
+        NavHeapEntry entry = heap_pop(nav->heap, &heap_count);
+        NavNode* node = &nav->nodes[entry.index];
+        if (node->closed) continue;
+        node->closed = true;
+        expanded++;
+
+        int x = entry.index % NAV_PATH_WINDOW;
+        int z = entry.index / NAV_PATH_WINDOW;
+        uint32_t estimate = path_estimate(x, z, goal_x, goal_z);
+        if (estimate < best_estimate) {
+            best = entry.index;
+            best_estimate = estimate;
+        }
+        if (estimate == 0) break;
+
+        bool open[4] = {false, false, false, false};
+        for (int d = 0; d < 8; d++) {
+            int nx = x + g_step_x[d];
+            int nz = z + g_step_z[d];
+            if (nx < 0 || nz < 0 || nx >= NAV_PATH_WINDOW || nz >= NAV_PATH_WINDOW) continue;
+            int n = nz * NAV_PATH_WINDOW + nx;
+            NavNode* next = path_node(nav, cursor, origin_x, origin_z, n);
+
+            bool can_step = nav_can_step(node->height, next->height, next->flags);
+            if (d < 4) open[d] = can_step;
+            else if (!open[g_step_x[d] > 0 ? 0 : 1] || !open[g_step_z[d] > 0 ? 2 : 3]) continue;
+            if (!can_step || next->closed) continue;
+
+            // Prefer flat ground over jumps
+            int cost = node->cost + (d < 4 ? 10 : 14) + (next->height > node->height ? 4 : 0);
+            if (cost >= next->cost) continue;
+            next->cost = (uint16_t)cost;
+            next->parent = (int16_t)entry.index;
+            heap_push(nav->heap, &heap_count, (uint32_t)cost + path_estimate(nx, nz, goal_x, goal_z), n);
+        }
+    }
+
+    NavAgent* agent = request->agent;
+    if (best == start) {
+        agent->state = NAV_PATH_FAILED;
+        return expanded;
+    }
+
+    int length = 0;
+    for (int i = best; i != start; i = nav->nodes[i].parent) {
+        nav->trail[length++] = (int16_t)i;
+    }
+    int kept = length < NAV_PATH_MAX ? length : NAV_PATH_MAX;
+    for (int k = 0; k < kept; k++) {
+        int i = nav->trail[length - 1 - k];
+        agent->path_x[k] = origin_x + i % NAV_PATH_WINDOW;
+        agent->path_z[k] = origin_z + i / NAV_PATH_WINDOW;
+    }
+    agent->path_length = kept;
+    agent->path_index = 0;
+    agent->state = NAV_PATH_READY;
+    return expanded;
+}
+
+// ============================================================================
+// AGENTS
+// ============================================================================
+
+bool nav_agent_wander(NavSystem* nav, NavAgent* agent, const Entity* entity,
+                      World* world, float radius) {
+    nav_agent_reset(agent);
+    if (!nav || !world) return false;
+
+    float max_radius = (float)(NAV_PATH_WINDOW / 2 - 1);
+    if (radius > max_radius) radius = max_radius;
+
+    WorldCursor cursor;
+    world_cursor_init(&cursor, world);
+    int feet = feet_block(entity->position);
+    int start_x = (int)floorf(entity->position.x);
+    int start_z = (int)floorf(entity->position.z);
+
+    for (int attempt = 0; attempt < 4; attempt++) {
+        Vector3 dir = entity_random_direction();
+        float r = entity_random_range(radius * 0.5f, radius);
+        int goal_x = (int)floorf(entity->position.x + dir.x * r);
+        int goal_z = (int)floorf(entity->position.z + dir.z * r);
+        int height;
+        if (!(nav_sample(&cursor, goal_x, goal_z, &height) & CHUNK_NAV_WALK)) continue;
+        if (abs(height - feet) > NAV_MAX_DROP) continue;
+
+        int slot = atomic_fetch_add_explicit(&nav->request_count, 1, memory_order_relaxed);
+        if (slot >= NAV_MAX_REQUESTS) return false;
+        uint32_t id = atomic_fetch_add_explicit(&nav->next_request_id, 1, memory_order_relaxed) + 1;
+        nav->requests[slot] = (NavRequest){
+            .entity = entity, .agent = agent, .request_id = id,
+            .start_x = start_x, .start_y = feet, .start_z = start_z,
+            .goal_x = goal_x, .goal_z = goal_z
+        };
+        agent->request_id = id;
+        agent->state = NAV_PATH_PENDING;
+        return true;
+    }
+    return false;
+}
+
+NavSteer nav_agent_steer(NavAgent* agent, Vector3 position, Vector3* out_dir) {
+    if (agent->state == NAV_PATH_PENDING) return NAV_STEER_WAIT;
+    if (agent->state != NAV_PATH_READY) return NAV_STEER_NONE;
+
+    while (agent->path_index < agent->path_length) {
+        float dx = (float)agent->path_x[agent->path_index] + 0.5f - position.x;
+        float dz = (float)agent->path_z[agent->path_index] + 0.5f - position.z;
+        float dist = sqrtf(dx * dx + dz * dz);
+        if (dist > NAV_WAYPOINT_RADIUS) {
+            *out_dir = (Vector3){dx / dist, 0, dz / dist};
+            return NAV_STEER_MOVE;
+        }
+        agent->path_index++;
+    }
+    agent->state = NAV_PATH_NONE;
+    return NAV_STEER_ARRIVED;
+}
+
+void nav_agent_reset(NavAgent* agent) {
+    agent->state = NAV_PATH_NONE;
+    agent->path_length = 0;
+    agent->path_index = 0;
+}
+
+bool nav_should_jump(World* world, Vector3 position, Vector3 direction) {
+    if (!world) return false;
+    int x = (int)floorf(position.x + direction.x * 0.6f);
+    int z = (int)floorf(position.z + direction.z * 0.6f);
+    if (x == (int)floorf(position.x) && z == (int)floorf(position.z)) return false;
+
+    WorldCursor cursor;
+    world_cursor_init(&cursor, world);
+    int height;
+    if (!(nav_sample(&cursor, x, z, &height) & CHUNK_NAV_WALK)) return false;
+    return height == feet_block(position) + 1;
+}
+
+bool nav_is_resting(World* world, const Entity* entity) {
+    if (!world || entity->velocity.x != 0 || entity->velocity.y != 0 || entity->velocity.z != 0) return false;
+
+    WorldCursor cursor;
+    world_cursor_init(&cursor, world);
+    int height;
+    if (!(nav_sample(&cursor, (int)floorf(entity->position.x), (int)floorf(entity->position.z), &height) &
+          CHUNK_NAV_WALK)) {
+        return false;
+    }
+    return entity->position.y == (float)height;
+}
+
+// ============================================================================
+// MOB MOVEMENT
+// ============================================================================
+
+Vector3 nav_agent_flee(NavAgent* agent, Entity* entity, World* world, Vector3 away, float speed) {
+    nav_agent_reset(agent);
+    Vector3 move_dir = away;
+    nav_flee_direction(nav_get(world), entity->position, &move_dir);
+    entity->velocity.x = move_dir.x * speed;
+    entity->velocity.z = move_dir.z * speed;
+
+    // Face away from player
+    entity->rotation.y = atan2f(move_dir.x, move_dir.z) * RAD2DEG;
+    return move_dir;
+}
+
+bool nav_agent_move(NavAgent* agent, Entity* entity, World* world, Vector3 move_dir,
+                    float* jump_cooldown, float jump_velocity, float jump_cooldown_time, float dt) {
+    if (*jump_cooldown > 0) {
+        *jump_cooldown -= dt;
+    }
+
+    // Standing still on known ground: skip the block fetch
+    bool moving = move_dir.x != 0 || move_dir.z != 0;
+    if (!moving && nav_is_resting(world, entity)) {
+        return false;
+    }
+
+    // Solid blocks around the entity, shared by the jump check and the move
+    CollisionContext collision;
+    collision_context_fetch_entity(&collision, world, entity);
+
+    // Step up where the heightfield ahead is one block higher
+    bool should_jump = false;
+    if (*jump_cooldown <= 0 && moving) {
+        should_jump = nav_get(world) ? nav_should_jump(world, entity->position, move_dir) &&
+                                           entity_is_on_ground(entity, &collision)
+                                     : entity_can_jump_obstacle(entity, &collision, move_dir);
+    }
+    if (should_jump) {
+        entity->velocity.y = jump_velocity;
+        *jump_cooldown = jump_cooldown_time;
+    }
+
+    entity_apply_gravity(entity, world, dt, 20.0f);
+    int collision_flags = entity_move_with_collision(entity, &collision, dt);
+
+    // A path only hits walls mid-jump or where the heightfield missed a block
+    if (COLLISION_HIT_WALL(collision_flags) && !should_jump &&
+        (agent->state != NAV_PATH_READY || *jump_cooldown <= 0)) {
+        nav_agent_reset(agent);
+        return true;
+    }
+    return false;
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+NavSystem* nav_create(void) {
+    NavSystem* nav = (NavSystem*)calloc(1, sizeof(NavSystem));
+    if (!nav) {
+        printf("[NAV] Failed to allocate navigation\n");
+        return NULL;
+    }
+    atomic_init(&nav->flee.wanted, false);
+    atomic_init(&nav->request_count, 0);
+    atomic_init(&nav->next_request_id, 0);
+    memory_track(MEMORY_ENTITIES, (ptrdiff_t)sizeof(NavSystem));
+    return nav;
+}
+
+void nav_destroy(NavSystem* nav) {
+    if (!nav) return;
+    memory_track(MEMORY_ENTITIES, -(ptrdiff_t)sizeof(NavSystem));
+    free(nav);
+}
+
+NavSystem* nav_get(World* world) {
+    return world && world->entity_manager ? world->entity_manager->nav : NULL;
+}
+
+void nav_cancel(NavSystem* nav, const Entity* entity) {
+    if (!nav) return;
+    int count = atomic_load_explicit(&nav->request_count, memory_order_relaxed);
+    if (count > NAV_MAX_REQUESTS) count = NAV_MAX_REQUESTS;
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        if (nav->requests[i].entity != entity) nav->requests[kept++] = nav->requests[i];
+    }
+    atomic_store_explicit(&nav->request_count, kept, memory_order_relaxed);
+}
+
+void nav_update(NavSystem* nav, World* world) {
+    if (!nav || !world) return;
+    nav->tick++;
+
+    // Flee field, only while some mob is fleeing
+    NavFleeField* field = &nav->flee;
+    if (atomic_exchange_explicit(&field->wanted, false, memory_order_relaxed) && world->player) {
+        int threat_x = (int)floorf(world->player->position.x);
+        int threat_z = (int)floorf(world->player->position.z);
+        if (!field->valid || threat_x != field->threat_x || threat_z != field->threat_z ||
+            nav->tick - field->built_tick >= NAV_FIELD_REFRESH) {
+            flee_build(field, world, threat_x, threat_z);
+            field->built_tick = nav->tick;
+        }
+    }
+
+    // Path requests, oldest first; the rest wait for the next tick
+    int count = atomic_load_explicit(&nav->request_count, memory_order_relaxed);
+    if (count > NAV_MAX_REQUESTS) count = NAV_MAX_REQUESTS;
+    WorldCursor cursor;
+    world_cursor_init(&cursor, world);
+    int budget = NAV_NODE_BUDGET;
+    int done = 0;
+    int solved = 0;
+    while (done < count && budget > 0) {
+        const NavRequest* request = &nav->requests[done++];
+        // Dropped or asked again since
+        if (request->agent->request_id != request->request_id ||
+            request->agent->state != NAV_PATH_PENDING) {
+            continue;
+        }
+        budget -= path_solve(nav, &cursor, request);
+        solved++;
+    }
+    memmove(nav->requests, nav->requests + done, (size_t)(count - done) * sizeof(NavRequest));
+    atomic_store_explicit(&nav->request_count, count - done, memory_order_relaxed);
+
+    nav->paths_solved = solved;
+    nav->nodes_expanded = NAV_NODE_BUDGET - budget;
+}
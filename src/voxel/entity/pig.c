@@ -5,8 +5,8 @@
  */
 
 #include "voxel/entity/pig.h"
-#include "voxel/entity/collision.h"
 #include "voxel/entity/entity_utils.h"
+#include "voxel/render/entity_renderer.h"
 #include "voxel/world/world.h"
 #include "voxel/player/player.h"
 #include "voxel/core/block.h"
@@ -45,12 +45,13 @@ static PigData* pig_create_data(void) {
     data->ear_twitch_timer = entity_random_range(2.0f, 5.0f);
     data->ear_twitch_angle = 0.0f;
 
-    // AI state - start wandering
-    data->wander_timer = entity_random_range(PIG_WANDER_TIME_MIN, PIG_WANDER_TIME_MAX);
+    // AI state - pick a behavior on the first update
+    data->wander_timer = 0.0f;
     data->idle_timer = 0.0f;
     data->is_idle = false;
     data->is_fleeing = false;
     data->wander_direction = entity_random_direction();
+    data->nav = (NavAgent){0};
 
     // Default lighting (full brightness)
     data->ambient_light = (Vector3){1.0f, 1.0f, 1.0f};
@@ -70,14 +71,26 @@ static PigData* pig_create_data(void) {
 // ============================================================================
 
 /**
- * Update function for pig
- * Handles AI behavior (wandering, idling, fleeing) and animation
+ * Head for a new wander goal
+ * Stands still until the path arrives, or for the whole leg if there is
+ * none; walks straight in a random direction without navigation
  */
-void pig_update(Entity* entity, struct World* world, float dt) {
-    if (!entity || !entity->data) return;
-
-    PigData* data = (PigData*)entity->data;
+static void pig_start_wander(Entity* entity, PigData* data, struct World* world) {
+    data->wander_timer = entity_random_range(PIG_WANDER_TIME_MIN, PIG_WANDER_TIME_MAX);
+    NavSystem* nav = nav_get(world);
+    if (nav) {
+        data->wander_direction = (Vector3){0, 0, 0};
+        nav_agent_wander(nav, &data->nav, entity, world, PIG_WANDER_RADIUS);
+    } else {
+        data->wander_direction = entity_random_direction();
+    }
+}
 
+/**
+ * AI behavior (wandering, idling, fleeing) and physics for pig
+ * Skipped for copies of a host's pig, which the host simulates.
+ */
+static void pig_think(Entity* entity, PigData* data, struct World* world, float dt) {
     // Get player position for flee behavior
     Vector3 player_pos = {0, 0, 0};
     bool has_player = false;
@@ -113,13 +126,9 @@ void pig_update(Entity* entity, struct World* world, float dt) {
     }
 
     // Update based on state
+    Vector3 move_dir = {0, 0, 0};
     if (data->is_fleeing) {
-        // Fleeing: run away from player
-        entity->velocity.x = flee_direction.x * PIG_FLEE_SPEED;
-        entity->velocity.z = flee_direction.z * PIG_FLEE_SPEED;
-
-        // Face away from player
-        entity->rotation.y = atan2f(flee_direction.x, flee_direction.z) * RAD2DEG;
+        move_dir = nav_agent_flee(&data->nav, entity, world, flee_direction, PIG_FLEE_SPEED);
     }
     else if (data->is_idle) {
         // Idle: stand still, wiggle tail
@@ -129,8 +138,7 @@ void pig_update(Entity* entity, struct World* world, float dt) {
         data->idle_timer -= dt;
         if (data->idle_timer <= 0) {
             data->is_idle = false;
-            data->wander_timer = entity_random_range(PIG_WANDER_TIME_MIN, PIG_WANDER_TIME_MAX);
-            data->wander_direction = entity_random_direction();
+            pig_start_wander(entity, data, world);
         }
     }
     else {
@@ -143,16 +151,32 @@ void pig_update(Entity* entity, struct World* world, float dt) {
                 // Start idling
                 data->is_idle = true;
                 data->idle_timer = PIG_IDLE_TIME;
+                nav_agent_reset(&data->nav);
             } else {
-                // Pick new wander direction
-                data->wander_direction = entity_random_direction();
-                data->wander_timer = entity_random_range(PIG_WANDER_TIME_MIN, PIG_WANDER_TIME_MAX);
+                pig_start_wander(entity, data, world);
             }
         }
 
-        // Move in wander direction
-        entity->velocity.x = data->wander_direction.x * PIG_WANDER_SPEED;
-        entity->velocity.z = data->wander_direction.z * PIG_WANDER_SPEED;
+        // Follow the path to the goal, or the wander direction without one
+        float speed = PIG_WANDER_SPEED;
+        Vector3 path_dir;
+        switch (nav_agent_steer(&data->nav, entity->position, &path_dir)) {
+            case NAV_STEER_MOVE:
+                data->wander_direction = path_dir;
+                break;
+            case NAV_STEER_WAIT:
+                speed = 0.0f;
+                break;
+            case NAV_STEER_ARRIVED:
+                speed = 0.0f;
+                data->wander_timer = 0.0f;  // Decide what to do next
+                break;
+            case NAV_STEER_NONE:
+                break;
+        }
+        if (speed > 0.0f) move_dir = data->wander_direction;
+        entity->velocity.x = move_dir.x * speed;
+        entity->velocity.z = move_dir.z * speed;
 
         // Face movement direction
         if (Vector3Length(data->wander_direction) > 0.01f) {
@@ -164,33 +188,25 @@ void pig_update(Entity* entity, struct World* world, float dt) {
     // PHYSICS (using AABB collision system)
     // ========================================================================
 
-    // Update jump cooldown
-    if (data->jump_cooldown > 0) {
-        data->jump_cooldown -= dt;
-    }
-
-    // Check for jumpable obstacles ahead (using current movement direction)
-    Vector3 move_dir = data->is_fleeing ? flee_direction : data->wander_direction;
-    bool should_jump = false;
-    if (data->jump_cooldown <= 0 && (move_dir.x != 0 || move_dir.z != 0)) {
-        should_jump = entity_can_jump_obstacle(entity, world, move_dir);
-    }
-
-    // Apply jump if obstacle is jumpable
-    if (should_jump) {
-        entity->velocity.y = PIG_JUMP_VELOCITY;
-        data->jump_cooldown = PIG_JUMP_COOLDOWN;
+    // Pick a new goal when a wall blocks the way (fleeing follows the field)
+    if (nav_agent_move(&data->nav, entity, world, move_dir, &data->jump_cooldown,
+                       PIG_JUMP_VELOCITY, PIG_JUMP_COOLDOWN, dt) &&
+        !data->is_fleeing) {
+        pig_start_wander(entity, data, world);
     }
+}
 
-    // Apply gravity
-    entity_apply_gravity(entity, world, dt, 20.0f);
+/**
+ * Update function for pig
+ * Handles AI behavior (wandering, idling, fleeing) and animation
+ */
+void pig_update(Entity* entity, struct World* world, float dt) {
+    if (!entity || !entity->data) return;
 
-    // Move with per-axis collision detection
-    int collision_flags = entity_move_with_collision(entity, world, dt);
+    PigData* data = (PigData*)entity->data;
 
-    // Pick new direction when hitting a wall (only if can't jump and not fleeing)
-    if (COLLISION_HIT_WALL(collision_flags) && !data->is_fleeing && !should_jump) {
-        data->wander_direction = entity_random_direction();
+    if (entity->remote_id == 0) {
+        pig_think(entity, data, world, dt);
     }
 
     // ========================================================================
@@ -313,7 +329,7 @@ void pig_render(Entity* entity) {
     rlTranslatef(fl_hip.x, fl_hip.y, fl_hip.z);
     rlRotatef(yaw, 0, 1, 0);
     rlRotatef(data->leg_swing_angle, 1, 0, 0);
-    DrawCube((Vector3){0, -PIG_LEG_LENGTH / 2.0f, 0},
+    entity_renderer_cube((Vector3){0, -PIG_LEG_LENGTH / 2.0f, 0},
              PIG_LEG_WIDTH, PIG_LEG_LENGTH, PIG_LEG_WIDTH,
              body_lit);
     rlPopMatrix();
@@ -328,7 +344,7 @@ void pig_render(Entity* entity) {
     rlTranslatef(fr_hip.x, fr_hip.y, fr_hip.z);
     rlRotatef(yaw, 0, 1, 0);
     rlRotatef(-data->leg_swing_angle, 1, 0, 0);
-    DrawCube((Vector3){0, -PIG_LEG_LENGTH / 2.0f, 0},
+    entity_renderer_cube((Vector3){0, -PIG_LEG_LENGTH / 2.0f, 0},
              PIG_LEG_WIDTH, PIG_LEG_LENGTH, PIG_LEG_WIDTH,
              body_lit);
     rlPopMatrix();
@@ -343,7 +359,7 @@ void pig_render(Entity* entity) {
     rlTranslatef(bl_hip.x, bl_hip.y, bl_hip.z);
     rlRotatef(yaw, 0, 1, 0);
     rlRotatef(-data->leg_swing_angle, 1, 0, 0);
-    DrawCube((Vector3){0, -PIG_LEG_LENGTH / 2.0f, 0},
+    entity_renderer_cube((Vector3){0, -PIG_LEG_LENGTH / 2.0f, 0},
              PIG_LEG_WIDTH, PIG_LEG_LENGTH, PIG_LEG_WIDTH,
              body_lit);
     rlPopMatrix();
@@ -358,7 +374,7 @@ void pig_render(Entity* entity) {
     rlTranslatef(br_hip.x, br_hip.y, br_hip.z);
     rlRotatef(yaw, 0, 1, 0);
     rlRotatef(data->leg_swing_angle, 1, 0, 0);
-    DrawCube((Vector3){0, -PIG_LEG_LENGTH / 2.0f, 0},
+    entity_renderer_cube((Vector3){0, -PIG_LEG_LENGTH / 2.0f, 0},
              PIG_LEG_WIDTH, PIG_LEG_LENGTH, PIG_LEG_WIDTH,
              body_lit);
     rlPopMatrix();
@@ -386,7 +402,7 @@ void pig_render(Entity* entity) {
     rlPushMatrix();
     rlTranslatef(body_center.x, body_center.y, body_center.z);
     rlRotatef(yaw, 0, 1, 0);
-    DrawCube((Vector3){0, 0, 0},
+    entity_renderer_cube((Vector3){0, 0, 0},
              PIG_BODY_WIDTH, PIG_BODY_HEIGHT, PIG_BODY_LENGTH,
              body_lit);
     rlPopMatrix();
@@ -403,7 +419,7 @@ void pig_render(Entity* entity) {
     rlPushMatrix();
     rlTranslatef(tail_pos.x, tail_pos.y, tail_pos.z);
     rlRotatef(yaw + data->tail_wiggle_angle, 0, 1, 0);
-    DrawCube((Vector3){0, 0, -0.03f}, 0.06f, 0.06f, 0.08f, snout_lit);
+    entity_renderer_cube((Vector3){0, 0, -0.03f}, 0.06f, 0.06f, 0.08f, snout_lit);
     rlPopMatrix();
 
     // ========================================================================
@@ -424,7 +440,7 @@ void pig_render(Entity* entity) {
     rlPushMatrix();
     rlTranslatef(head_center.x, head_center.y, head_center.z);
     rlRotatef(head_yaw, 0, 1, 0);
-    DrawCube((Vector3){0, 0, 0},
+    entity_renderer_cube((Vector3){0, 0, 0},
              PIG_HEAD_WIDTH, PIG_HEAD_HEIGHT, PIG_HEAD_LENGTH,
              body_lit);
     rlPopMatrix();
@@ -441,7 +457,7 @@ void pig_render(Entity* entity) {
     rlPushMatrix();
     rlTranslatef(snout_pos.x, snout_pos.y, snout_pos.z);
     rlRotatef(head_yaw, 0, 1, 0);
-    DrawCube((Vector3){0, 0, 0},
+    entity_renderer_cube((Vector3){0, 0, 0},
              PIG_SNOUT_WIDTH, PIG_SNOUT_HEIGHT, PIG_SNOUT_LENGTH,
              snout_lit);
     rlPopMatrix();
@@ -455,13 +471,13 @@ void pig_render(Entity* entity) {
     left_nostril.x += head_forward.x * nostril_forward - head_right.x * nostril_side;
     left_nostril.z += head_forward.z * nostril_forward - head_right.z * nostril_side;
     left_nostril.y -= 0.05f;
-    DrawSphere(left_nostril, 0.015f, nostril_color);
+    entity_renderer_sphere(left_nostril, 0.015f, nostril_color);
 
     Vector3 right_nostril = head_center;
     right_nostril.x += head_forward.x * nostril_forward + head_right.x * nostril_side;
     right_nostril.z += head_forward.z * nostril_forward + head_right.z * nostril_side;
     right_nostril.y -= 0.05f;
-    DrawSphere(right_nostril, 0.015f, nostril_color);
+    entity_renderer_sphere(right_nostril, 0.015f, nostril_color);
 
     // ========================================================================
     // EARS (two small cubes on top of head) with twitch animation
@@ -479,7 +495,7 @@ void pig_render(Entity* entity) {
     rlTranslatef(left_ear.x, left_ear.y, left_ear.z);
     rlRotatef(head_yaw, 0, 1, 0);
     rlRotatef(-15 - data->ear_twitch_angle, 0, 0, 1);  // Tilt outward + twitch
-    DrawCube((Vector3){0, 0, 0}, PIG_EAR_SIZE, PIG_EAR_SIZE * 0.6f, PIG_EAR_SIZE, body_lit);
+    entity_renderer_cube((Vector3){0, 0, 0}, PIG_EAR_SIZE, PIG_EAR_SIZE * 0.6f, PIG_EAR_SIZE, body_lit);
     rlPopMatrix();
 
     // Right ear
@@ -492,7 +508,7 @@ void pig_render(Entity* entity) {
     rlTranslatef(right_ear.x, right_ear.y, right_ear.z);
     rlRotatef(head_yaw, 0, 1, 0);
     rlRotatef(15 + data->ear_twitch_angle, 0, 0, 1);  // Tilt outward + twitch
-    DrawCube((Vector3){0, 0, 0}, PIG_EAR_SIZE, PIG_EAR_SIZE * 0.6f, PIG_EAR_SIZE, body_lit);
+    entity_renderer_cube((Vector3){0, 0, 0}, PIG_EAR_SIZE, PIG_EAR_SIZE * 0.6f, PIG_EAR_SIZE, body_lit);
     rlPopMatrix();
 
     // ========================================================================
@@ -523,29 +539,29 @@ void pig_render(Entity* entity) {
         rlPushMatrix();
         rlTranslatef(left_eye.x, left_eye.y, left_eye.z);
         rlRotatef(head_yaw, 0, 1, 0);
-        DrawCube((Vector3){0, 0, 0}, 0.06f, 0.01f, 0.01f, eye_black);
+        entity_renderer_cube((Vector3){0, 0, 0}, 0.06f, 0.01f, 0.01f, eye_black);
         rlPopMatrix();
 
         rlPushMatrix();
         rlTranslatef(right_eye.x, right_eye.y, right_eye.z);
         rlRotatef(head_yaw, 0, 1, 0);
-        DrawCube((Vector3){0, 0, 0}, 0.06f, 0.01f, 0.01f, eye_black);
+        entity_renderer_cube((Vector3){0, 0, 0}, 0.06f, 0.01f, 0.01f, eye_black);
         rlPopMatrix();
     } else {
         // Eyes open - draw normal spheres
-        DrawSphere(left_eye, 0.035f, eye_white);
-        DrawSphere(right_eye, 0.035f, eye_white);
+        entity_renderer_sphere(left_eye, 0.035f, eye_white);
+        entity_renderer_sphere(right_eye, 0.035f, eye_white);
 
         // Pupils
         Vector3 left_pupil = left_eye;
         left_pupil.x += head_forward.x * 0.02f;
         left_pupil.z += head_forward.z * 0.02f;
-        DrawSphere(left_pupil, 0.018f, eye_black);
+        entity_renderer_sphere(left_pupil, 0.018f, eye_black);
 
         Vector3 right_pupil = right_eye;
         right_pupil.x += head_forward.x * 0.02f;
         right_pupil.z += head_forward.z * 0.02f;
-        DrawSphere(right_pupil, 0.018f, eye_black);
+        entity_renderer_sphere(right_pupil, 0.018f, eye_black);
     }
 }
 
@@ -586,6 +602,13 @@ bool pig_damage(Entity* entity, int damage) {
     return data->hp <= 0;  // Returns true if dead
 }
 
+int pig_get_drops(const Entity* entity, ItemStack* out) {
+    (void)entity;
+    // Drop 1-3 meat (pigs drop more)
+    out[0] = (ItemStack){ITEM_MEAT, (uint8_t)(1 + rand() % 3), 0, 0};
+    return 1;
+}
+
 // ============================================================================
 // PUBLIC SPAWN API
 // ============================================================================
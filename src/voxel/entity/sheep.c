@@ -5,8 +5,8 @@
  */
 
 #include "voxel/entity/sheep.h"
-#include "voxel/entity/collision.h"
 #include "voxel/entity/entity_utils.h"
+#include "voxel/render/entity_renderer.h"
 #include "voxel/world/world.h"
 #include "voxel/player/player.h"
 #include "voxel/core/block.h"
@@ -41,12 +41,13 @@ static SheepData* sheep_create_data(Color wool_color, Color skin_color) {
     data->blink_timer = entity_random_range(3.0f, 6.0f);
     data->blink_progress = 0.0f;
 
-    // AI state - start wandering
-    data->wander_timer = entity_random_range(SHEEP_WANDER_TIME_MIN, SHEEP_WANDER_TIME_MAX);
+    // AI state - pick a behavior on the first update
+    data->wander_timer = 0.0f;
     data->graze_timer = 0.0f;
     data->is_grazing = false;
     data->is_fleeing = false;
     data->wander_direction = entity_random_direction();
+    data->nav = (NavAgent){0};
 
     // Default lighting (full brightness)
     data->ambient_light = (Vector3){1.0f, 1.0f, 1.0f};
@@ -66,14 +67,26 @@ static SheepData* sheep_create_data(Color wool_color, Color skin_color) {
 // ============================================================================
 
 /**
- * Update function for sheep
- * Handles AI behavior (wandering, grazing, fleeing) and animation
+ * Head for a new wander goal
+ * Stands still until the path arrives, or for the whole leg if there is
+ * none; walks straight in a random direction without navigation
  */
-void sheep_update(Entity* entity, struct World* world, float dt) {
-    if (!entity || !entity->data) return;
-
-    SheepData* data = (SheepData*)entity->data;
+static void sheep_start_wander(Entity* entity, SheepData* data, struct World* world) {
+    data->wander_timer = entity_random_range(SHEEP_WANDER_TIME_MIN, SHEEP_WANDER_TIME_MAX);
+    NavSystem* nav = nav_get(world);
+    if (nav) {
+        data->wander_direction = (Vector3){0, 0, 0};
+        nav_agent_wander(nav, &data->nav, entity, world, SHEEP_WANDER_RADIUS);
+    } else {
+        data->wander_direction = entity_random_direction();
+    }
+}
 
+/**
+ * AI behavior (wandering, grazing, fleeing) and physics for sheep
+ * Skipped for copies of a host's sheep, which the host simulates.
+ */
+static void sheep_think(Entity* entity, SheepData* data, struct World* world, float dt) {
     // Get player position for flee behavior (if world has player reference)
     Vector3 player_pos = {0, 0, 0};
     bool has_player = false;
@@ -109,13 +122,9 @@ void sheep_update(Entity* entity, struct World* world, float dt) {
     }
 
     // Update based on state
+    Vector3 move_dir = {0, 0, 0};
     if (data->is_fleeing) {
-        // Fleeing: run away from player
-        entity->velocity.x = flee_direction.x * SHEEP_FLEE_SPEED;
-        entity->velocity.z = flee_direction.z * SHEEP_FLEE_SPEED;
-
-        // Face away from player
-        entity->rotation.y = atan2f(flee_direction.x, flee_direction.z) * RAD2DEG;
+        move_dir = nav_agent_flee(&data->nav, entity, world, flee_direction, SHEEP_FLEE_SPEED);
     }
     else if (data->is_grazing) {
         // Grazing: stand still
@@ -125,8 +134,7 @@ void sheep_update(Entity* entity, struct World* world, float dt) {
         data->graze_timer -= dt;
         if (data->graze_timer <= 0) {
             data->is_grazing = false;
-            data->wander_timer = entity_random_range(SHEEP_WANDER_TIME_MIN, SHEEP_WANDER_TIME_MAX);
-            data->wander_direction = entity_random_direction();
+            sheep_start_wander(entity, data, world);
         }
     }
     else {
@@ -139,16 +147,32 @@ void sheep_update(Entity* entity, struct World* world, float dt) {
                 // Start grazing
                 data->is_grazing = true;
                 data->graze_timer = SHEEP_GRAZE_TIME;
+                nav_agent_reset(&data->nav);
             } else {
-                // Pick new wander direction
-                data->wander_direction = entity_random_direction();
-                data->wander_timer = entity_random_range(SHEEP_WANDER_TIME_MIN, SHEEP_WANDER_TIME_MAX);
+                sheep_start_wander(entity, data, world);
             }
         }
 
-        // Move in wander direction
-        entity->velocity.x = data->wander_direction.x * SHEEP_WANDER_SPEED;
-        entity->velocity.z = data->wander_direction.z * SHEEP_WANDER_SPEED;
+        // Follow the path to the goal, or the wander direction without one
+        float speed = SHEEP_WANDER_SPEED;
+        Vector3 path_dir;
+        switch (nav_agent_steer(&data->nav, entity->position, &path_dir)) {
+            case NAV_STEER_MOVE:
+                data->wander_direction = path_dir;
+                break;
+            case NAV_STEER_WAIT:
+                speed = 0.0f;
+                break;
+            case NAV_STEER_ARRIVED:
+                speed = 0.0f;
+                data->wander_timer = 0.0f;  // Decide what to do next
+                break;
+            case NAV_STEER_NONE:
+                break;
+        }
+        if (speed > 0.0f) move_dir = data->wander_direction;
+        entity->velocity.x = move_dir.x * speed;
+        entity->velocity.z = move_dir.z * speed;
 
         // Face movement direction
         if (Vector3Length(data->wander_direction) > 0.01f) {
@@ -160,33 +184,25 @@ void sheep_update(Entity* entity, struct World* world, float dt) {
     // PHYSICS (using AABB collision system)
     // ========================================================================
 
-    // Update jump cooldown
-    if (data->jump_cooldown > 0) {
-        data->jump_cooldown -= dt;
-    }
-
-    // Check for jumpable obstacles ahead (using current movement direction)
-    Vector3 move_dir = data->is_fleeing ? flee_direction : data->wander_direction;
-    bool should_jump = false;
-    if (data->jump_cooldown <= 0 && (move_dir.x != 0 || move_dir.z != 0)) {
-        should_jump = entity_can_jump_obstacle(entity, world, move_dir);
-    }
-
-    // Apply jump if obstacle is jumpable
-    if (should_jump) {
-        entity->velocity.y = SHEEP_JUMP_VELOCITY;
-        data->jump_cooldown = SHEEP_JUMP_COOLDOWN;
+    // Pick a new goal when a wall blocks the way (fleeing follows the field)
+    if (nav_agent_move(&data->nav, entity, world, move_dir, &data->jump_cooldown,
+                       SHEEP_JUMP_VELOCITY, SHEEP_JUMP_COOLDOWN, dt) &&
+        !data->is_fleeing) {
+        sheep_start_wander(entity, data, world);
     }
+}
 
-    // Apply gravity
-    entity_apply_gravity(entity, world, dt, 20.0f);
+/**
+ * Update function for sheep
+ * Handles AI behavior (wandering, grazing, fleeing) and animation
+ */
+void sheep_update(Entity* entity, struct World* world, float dt) {
+    if (!entity || !entity->data) return;
 
-    // Move with per-axis collision detection
-    int collision_flags = entity_move_with_collision(entity, world, dt);
+    SheepData* data = (SheepData*)entity->data;
 
-    // Pick new direction when hitting a wall (only if can't jump and not fleeing)
-    if (COLLISION_HIT_WALL(collision_flags) && !data->is_fleeing && !should_jump) {
-        data->wander_direction = entity_random_direction();
+    if (entity->remote_id == 0) {
+        sheep_think(entity, data, world, dt);
     }
 
     // ========================================================================
@@ -298,7 +314,7 @@ void sheep_render(Entity* entity) {
     rlTranslatef(fl_hip.x, fl_hip.y, fl_hip.z);
     rlRotatef(yaw, 0, 1, 0);
     rlRotatef(data->leg_swing_angle, 1, 0, 0);
-    DrawCube((Vector3){0, -SHEEP_LEG_LENGTH / 2.0f, 0},
+    entity_renderer_cube((Vector3){0, -SHEEP_LEG_LENGTH / 2.0f, 0},
              SHEEP_LEG_WIDTH, SHEEP_LEG_LENGTH, SHEEP_LEG_WIDTH,
              skin_lit);
     rlPopMatrix();
@@ -313,7 +329,7 @@ void sheep_render(Entity* entity) {
     rlTranslatef(fr_hip.x, fr_hip.y, fr_hip.z);
     rlRotatef(yaw, 0, 1, 0);
     rlRotatef(-data->leg_swing_angle, 1, 0, 0);
-    DrawCube((Vector3){0, -SHEEP_LEG_LENGTH / 2.0f, 0},
+    entity_renderer_cube((Vector3){0, -SHEEP_LEG_LENGTH / 2.0f, 0},
              SHEEP_LEG_WIDTH, SHEEP_LEG_LENGTH, SHEEP_LEG_WIDTH,
              skin_lit);
     rlPopMatrix();
@@ -328,7 +344,7 @@ void sheep_render(Entity* entity) {
     rlTranslatef(bl_hip.x, bl_hip.y, bl_hip.z);
     rlRotatef(yaw, 0, 1, 0);
     rlRotatef(-data->leg_swing_angle, 1, 0, 0);
-    DrawCube((Vector3){0, -SHEEP_LEG_LENGTH / 2.0f, 0},
+    entity_renderer_cube((Vector3){0, -SHEEP_LEG_LENGTH / 2.0f, 0},
              SHEEP_LEG_WIDTH, SHEEP_LEG_LENGTH, SHEEP_LEG_WIDTH,
              skin_lit);
     rlPopMatrix();
@@ -343,7 +359,7 @@ void sheep_render(Entity* entity) {
     rlTranslatef(br_hip.x, br_hip.y, br_hip.z);
     rlRotatef(yaw, 0, 1, 0);
     rlRotatef(data->leg_swing_angle, 1, 0, 0);
-    DrawCube((Vector3){0, -SHEEP_LEG_LENGTH / 2.0f, 0},
+    entity_renderer_cube((Vector3){0, -SHEEP_LEG_LENGTH / 2.0f, 0},
              SHEEP_LEG_WIDTH, SHEEP_LEG_LENGTH, SHEEP_LEG_WIDTH,
              skin_lit);
     rlPopMatrix();
@@ -371,7 +387,7 @@ void sheep_render(Entity* entity) {
     rlPushMatrix();
     rlTranslatef(body_center.x, body_center.y, body_center.z);
     rlRotatef(yaw, 0, 1, 0);
-    DrawCube((Vector3){0, 0, 0},
+    entity_renderer_cube((Vector3){0, 0, 0},
              SHEEP_BODY_WIDTH, SHEEP_BODY_HEIGHT, SHEEP_BODY_LENGTH,
              wool_lit);
     rlPopMatrix();
@@ -397,7 +413,7 @@ void sheep_render(Entity* entity) {
     rlPushMatrix();
     rlTranslatef(head_center.x, head_center.y, head_center.z);
     rlRotatef(head_yaw, 0, 1, 0);
-    DrawCube((Vector3){0, 0, 0},
+    entity_renderer_cube((Vector3){0, 0, 0},
              SHEEP_HEAD_WIDTH, SHEEP_HEAD_HEIGHT, SHEEP_HEAD_LENGTH,
              skin_lit);
     rlPopMatrix();
@@ -430,29 +446,29 @@ void sheep_render(Entity* entity) {
         rlPushMatrix();
         rlTranslatef(left_eye.x, left_eye.y, left_eye.z);
         rlRotatef(head_yaw, 0, 1, 0);
-        DrawCube((Vector3){0, 0, 0}, 0.07f, 0.01f, 0.01f, eye_black);
+        entity_renderer_cube((Vector3){0, 0, 0}, 0.07f, 0.01f, 0.01f, eye_black);
         rlPopMatrix();
 
         rlPushMatrix();
         rlTranslatef(right_eye.x, right_eye.y, right_eye.z);
         rlRotatef(head_yaw, 0, 1, 0);
-        DrawCube((Vector3){0, 0, 0}, 0.07f, 0.01f, 0.01f, eye_black);
+        entity_renderer_cube((Vector3){0, 0, 0}, 0.07f, 0.01f, 0.01f, eye_black);
         rlPopMatrix();
     } else {
         // Eyes open - draw normal spheres
-        DrawSphere(left_eye, 0.04f, eye_white);
-        DrawSphere(right_eye, 0.04f, eye_white);
+        entity_renderer_sphere(left_eye, 0.04f, eye_white);
+        entity_renderer_sphere(right_eye, 0.04f, eye_white);
 
         // Pupils
         Vector3 left_pupil = left_eye;
         left_pupil.x += head_forward.x * 0.025f;
         left_pupil.z += head_forward.z * 0.025f;
-        DrawSphere(left_pupil, 0.02f, eye_black);
+        entity_renderer_sphere(left_pupil, 0.02f, eye_black);
 
         Vector3 right_pupil = right_eye;
         right_pupil.x += head_forward.x * 0.025f;
         right_pupil.z += head_forward.z * 0.025f;
-        DrawSphere(right_pupil, 0.02f, eye_black);
+        entity_renderer_sphere(right_pupil, 0.02f, eye_black);
     }
 }
 
@@ -493,6 +509,38 @@ bool sheep_damage(Entity* entity, int damage) {
     return data->hp <= 0;  // Returns true if dead
 }
 
+/**
+ * Wool item closest to a wool color (simple RGB thresholds)
+ */
+static ItemType sheep_wool_item(Color wool_color) {
+    if (wool_color.r > 230 && wool_color.g > 230 && wool_color.b > 230) {
+        return ITEM_WOOL_WHITE;
+    } else if (wool_color.r < 60 && wool_color.g < 60 && wool_color.b < 60) {
+        return ITEM_WOOL_BLACK;
+    } else if (wool_color.r > 180 && wool_color.g < 80 && wool_color.b < 80) {
+        return ITEM_WOOL_RED;
+    } else if (wool_color.r < 100 && wool_color.g > 100 && wool_color.b < 100) {
+        return ITEM_WOOL_GREEN;
+    } else if (wool_color.r < 100 && wool_color.g < 100 && wool_color.b > 150) {
+        return ITEM_WOOL_BLUE;
+    }
+    // Default to light gray for other colors
+    return ITEM_WOOL_LIGHT_GRAY;
+}
+
+int sheep_get_drops(const Entity* entity, ItemStack* out) {
+    // Drop 1-2 meat
+    int count = 0;
+    out[count++] = (ItemStack){ITEM_MEAT, (uint8_t)(1 + rand() % 2), 0, 0};
+
+    // Drop 1-3 wool (based on sheep's wool color)
+    const SheepData* data = (const SheepData*)entity->data;
+    if (data) {
+        out[count++] = (ItemStack){sheep_wool_item(data->wool_color), (uint8_t)(1 + rand() % 3), 0, 0};
+    }
+    return count;
+}
+
 // ============================================================================
 // PUBLIC SPAWN API
 // ============================================================================
@@ -8,10 +8,14 @@
 #include "voxel/core/block.h"
 #include "voxel/world/biome.h"
 #include "voxel/world/noise.h"
+#include "voxel/world/random.h"
 #include "voxel/world/world.h"
+#include "voxel/world/structure.h"
+#include <pthread.h>
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 
 // ============================================================================
 // TREE TEMPLATES
@@ -566,87 +570,258 @@ static const TreeBlock* get_template_typed(TreeSize size, TreeType type, int* co
     }
 }
 
-// Template accessor (legacy, uses Oak)
-static const TreeBlock* get_template(TreeSize size, int* count) {
-    switch (size) {
-        case TREE_SMALL:
-            *count = SMALL_OAK_COUNT;
-            return SMALL_OAK;
-        case TREE_MEDIUM:
-            *count = MEDIUM_OAK_COUNT;
-            return MEDIUM_OAK;
-        case TREE_LARGE:
-            *count = LARGE_OAK_COUNT;
-            return LARGE_OAK;
-        default:
-            *count = SMALL_OAK_COUNT;
-            return SMALL_OAK;
+// ============================================================================
+// TREE STAMPS
+// ============================================================================
+//
+// Templates are compiled once into dense stamps: a bitmask per (y, z) row of
+// the template's bounding box plus the row's cells in x order. Leaves carry
+// their distance to the tree's own logs, found at compile time, so placing a
+// tree - or the part of it that fell into a neighbor chunk - is a clipped
+// copy with no search.
+
+#define STAMP_MAX_SIZE 16           // Bounding box side limit (16-bit row masks)
+#define STAMP_MAX_CELLS TREE_MAX_BLOCKS
+#define TREE_STAMP_COUNT (TREE_TYPE_COUNT * TREE_SIZE_COUNT)
+
+typedef struct {
+    int min_x, min_y, min_z;        // Bounding box relative to the trunk base
+    int size_x, size_y, size_z;
+    uint16_t row_mask[STAMP_MAX_SIZE][STAMP_MAX_SIZE];   // [y][z], bit x set = cell present
+    uint8_t row_start[STAMP_MAX_SIZE][STAMP_MAX_SIZE];   // Index of the row's first cell
+    uint8_t cell_type[STAMP_MAX_CELLS];                  // BlockType
+    uint8_t cell_metadata[STAMP_MAX_CELLS];              // Logs: 1 (natural), leaves: distance
+} TreeStamp;
+
+static TreeStamp g_stamps[TREE_STAMP_COUNT];
+static pthread_once_t g_stamps_once = PTHREAD_ONCE_INIT;
+
+static int stamp_id(TreeSize size, TreeType type) {
+    if ((unsigned)type >= TREE_TYPE_COUNT) type = TREE_TYPE_OAK;
+    if ((unsigned)size >= TREE_SIZE_COUNT) size = TREE_SMALL;
+    return (int)type * TREE_SIZE_COUNT + (int)size;
+}
+
+static void compile_stamp(TreeStamp* stamp, const TreeBlock* template, int count) {
+    int min[3] = {127, 127, 127}, max[3] = {-128, -128, -128};
+    for (int i = 0; i < count; i++) {
+        int p[3] = {template[i].dx, template[i].dy, template[i].dz};
+        for (int a = 0; a < 3; a++) {
+            if (p[a] < min[a]) min[a] = p[a];
+            if (p[a] > max[a]) max[a] = p[a];
+        }
+    }
+    stamp->min_x = min[0];
+    stamp->min_y = min[1];
+    stamp->min_z = min[2];
+    stamp->size_x = max[0] - min[0] + 1;
+    stamp->size_y = max[1] - min[1] + 1;
+    stamp->size_z = max[2] - min[2] + 1;
+
+    // Dense grid of the template, then log distances through its leaves
+    static uint8_t types[STAMP_MAX_SIZE][STAMP_MAX_SIZE][STAMP_MAX_SIZE];  // [y][z][x]
+    static uint8_t dist[STAMP_MAX_SIZE][STAMP_MAX_SIZE][STAMP_MAX_SIZE];
+    static uint8_t queue[STAMP_MAX_CELLS][3];
+    memset(types, 0, sizeof(types));
+    memset(dist, LEAF_DISTANCE_NONE, sizeof(dist));
+
+    int head = 0, tail = 0;
+    for (int i = 0; i < count && i < STAMP_MAX_CELLS; i++) {
+        int x = template[i].dx - min[0], y = template[i].dy - min[1], z = template[i].dz - min[2];
+        if (x >= STAMP_MAX_SIZE || y >= STAMP_MAX_SIZE || z >= STAMP_MAX_SIZE) continue;
+        types[y][z][x] = (uint8_t)template[i].type;
+        if (is_wood_block(template[i].type)) {
+            dist[y][z][x] = 0;
+            queue[tail][0] = (uint8_t)x;
+            queue[tail][1] = (uint8_t)y;
+            queue[tail][2] = (uint8_t)z;
+            tail++;
+        }
+    }
+
+    static const int offsets[6][3] = {
+        {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}
+    };
+    while (head < tail) {
+        int nx0 = queue[head][0], ny0 = queue[head][1], nz0 = queue[head][2];
+        head++;
+        int d = dist[ny0][nz0][nx0] + 1;
+        if (d > LEAF_DECAY_RANGE) continue;
+        for (int i = 0; i < 6; i++) {
+            int x = nx0 + offsets[i][0], y = ny0 + offsets[i][1], z = nz0 + offsets[i][2];
+            if (x < 0 || y < 0 || z < 0 || x >= STAMP_MAX_SIZE || y >= STAMP_MAX_SIZE || z >= STAMP_MAX_SIZE) continue;
+            if (!is_leaf_block((BlockType)types[y][z][x]) || dist[y][z][x] <= d) continue;
+            dist[y][z][x] = (uint8_t)d;
+            queue[tail][0] = (uint8_t)x;
+            queue[tail][1] = (uint8_t)y;
+            queue[tail][2] = (uint8_t)z;
+            tail++;
+        }
+    }
+
+    // Rows in (y, z) order, cells in x order
+    int cell = 0;
+    for (int y = 0; y < stamp->size_y && y < STAMP_MAX_SIZE; y++) {
+        for (int z = 0; z < stamp->size_z && z < STAMP_MAX_SIZE; z++) {
+            stamp->row_start[y][z] = (uint8_t)cell;
+            stamp->row_mask[y][z] = 0;
+            for (int x = 0; x < stamp->size_x && x < STAMP_MAX_SIZE; x++) {
+                if (types[y][z][x] == BLOCK_AIR) continue;
+                stamp->row_mask[y][z] |= (uint16_t)(1u << x);
+                stamp->cell_type[cell] = types[y][z][x];
+                stamp->cell_metadata[cell] = is_wood_block((BlockType)types[y][z][x]) ? 1 : dist[y][z][x];
+                cell++;
+            }
+        }
+    }
+}
+
+static void compile_stamps(void) {
+    for (int type = 0; type < TREE_TYPE_COUNT; type++) {
+        for (int size = 0; size < TREE_SIZE_COUNT; size++) {
+            int count;
+            const TreeBlock* template = get_template_typed((TreeSize)size, (TreeType)type, &count);
+            compile_stamp(&g_stamps[stamp_id((TreeSize)size, (TreeType)type)], template, count);
+        }
     }
 }
 
+static const TreeStamp* get_stamp(int id) {
+    pthread_once(&g_stamps_once, compile_stamps);
+    return (id >= 0 && id < TREE_STAMP_COUNT) ? &g_stamps[id] : NULL;
+}
+
 // ============================================================================
 // TREE PLACEMENT
 // ============================================================================
 
-void tree_place_at(Chunk* chunk, int local_x, int base_y, int local_z, TreeSize size) {
-    if (!chunk) return;
+/**
+ * The block a stamp cell turns existing into, or false to leave it
+ * Only air and leaves are replaced; leaves keep the closer of both trees'
+ * distances, and player-placed leaves stay persistent
+ */
+static bool stamp_cell_block(BlockType type, uint8_t metadata, Block existing, Block* out) {
+    if (existing.type != BLOCK_AIR && !is_leaf_block(existing.type)) return false;
 
-    int count;
-    const TreeBlock* template = get_template(size, &count);
+    if (is_leaf_block(type) && is_leaf_block(existing.type)) {
+        int current = existing.metadata & LEAF_DISTANCE_MASK;
+        if (current == LEAF_DISTANCE_PERSISTENT || current < metadata) metadata = (uint8_t)current;
+        metadata = (uint8_t)((existing.metadata & ~LEAF_DISTANCE_MASK) | metadata);
+    }
+    *out = (Block){ .type = type, .light_level = 0, .metadata = metadata };
+    return existing.type != out->type || existing.metadata != out->metadata;
+}
 
-    for (int i = 0; i < count; i++) {
-        int x = local_x + template[i].dx;
-        int y = base_y + template[i].dy;
-        int z = local_z + template[i].dz;
-
-        // Check bounds - skip blocks outside chunk
-        if (x < 0 || x >= CHUNK_SIZE || z < 0 || z >= CHUNK_SIZE) continue;
-        if (y < 0 || y >= CHUNK_HEIGHT) continue;
-
-        // Don't overwrite existing solid blocks (except air)
-        Block existing = chunk_get_block(chunk, x, y, z);
-        if (existing.type != BLOCK_AIR && existing.type != BLOCK_LEAVES) continue;
-
-        // Create block with metadata=1 for natural tree
-        Block block = {
-            .type = template[i].type,
-            .light_level = 0,
-            .metadata = 1  // Mark as natural tree
-        };
-
-        chunk_set_block(chunk, x, y, z, block);
+/**
+ * Place the part of a stamp that falls into the chunk
+ * origin: trunk base in chunk-local coordinates (may lie outside the chunk).
+ * With edits, blocks are collected as world edits instead of written.
+ * Returns the number of blocks placed or collected
+ */
+static int stamp_place(Chunk* chunk, const TreeStamp* stamp, int origin_x, int origin_y, int origin_z,
+                       WorldEdit* edits, int max_edits) {
+    // Clip the bounding box to the chunk, in stamp coordinates
+    int x0 = origin_x + stamp->min_x, y0 = origin_y + stamp->min_y, z0 = origin_z + stamp->min_z;
+    int lo_x = x0 < 0 ? -x0 : 0;
+    int hi_x = x0 + stamp->size_x > CHUNK_SIZE ? CHUNK_SIZE - x0 : stamp->size_x;
+    int lo_y = y0 < 0 ? -y0 : 0;
+    int hi_y = y0 + stamp->size_y > CHUNK_HEIGHT ? CHUNK_HEIGHT - y0 : stamp->size_y;
+    int lo_z = z0 < 0 ? -z0 : 0;
+    int hi_z = z0 + stamp->size_z > CHUNK_SIZE ? CHUNK_SIZE - z0 : stamp->size_z;
+    if (lo_x >= hi_x || lo_y >= hi_y || lo_z >= hi_z) return 0;
+
+    uint32_t clip = ((1u << hi_x) - 1) & ~((1u << lo_x) - 1);
+    int placed = 0;
+    for (int sy = lo_y; sy < hi_y; sy++) {
+        for (int sz = lo_z; sz < hi_z; sz++) {
+            uint32_t row = stamp->row_mask[sy][sz];
+            for (uint32_t bits = row & clip; bits; bits &= bits - 1) {
+                int sx = __builtin_ctz(bits);
+                int cell = stamp->row_start[sy][sz] + __builtin_popcount(row & ((1u << sx) - 1));
+                int x = x0 + sx, y = y0 + sy, z = z0 + sz;
+
+                Block block;
+                Block existing = chunk_get_block(chunk, x, y, z);
+                if (!stamp_cell_block((BlockType)stamp->cell_type[cell], stamp->cell_metadata[cell],
+                                      existing, &block)) {
+                    continue;
+                }
+                if (edits) {
+                    if (placed >= max_edits) return placed;
+                    edits[placed] = (WorldEdit){ chunk->x * CHUNK_SIZE + x, y, chunk->z * CHUNK_SIZE + z, block };
+                } else {
+                    chunk_set_block(chunk, x, y, z, block);
+                }
+                placed++;
+            }
+        }
+    }
+    return placed;
+}
+
+/**
+ * Place a tree rooted in chunk; the parts that reach into neighbor chunks
+ * are recorded as fragments (or clipped without a store)
+ */
+static void place_tree(Chunk* chunk, StructureStore* structures, int id,
+                       int local_x, int base_y, int local_z) {
+    const TreeStamp* stamp = get_stamp(id);
+    if (!stamp) return;
+    stamp_place(chunk, stamp, local_x, base_y, local_z, NULL, 0);
+    if (!structures) return;
+
+    // Neighbor chunks the bounding box overlaps
+    int min_cx = local_x + stamp->min_x < 0 ? -1 : 0;
+    int max_cx = local_x + stamp->min_x + stamp->size_x > CHUNK_SIZE ? 1 : 0;
+    int min_cz = local_z + stamp->min_z < 0 ? -1 : 0;
+    int max_cz = local_z + stamp->min_z + stamp->size_z > CHUNK_SIZE ? 1 : 0;
+    for (int dz = min_cz; dz <= max_cz; dz++) {
+        for (int dx = min_cx; dx <= max_cx; dx++) {
+            if (dx == 0 && dz == 0) continue;
+            StructureFragment fragment = {
+                .chunk_x = chunk->x + dx,
+                .chunk_z = chunk->z + dz,
+                .origin_x = (int16_t)(local_x - dx * CHUNK_SIZE),
+                .origin_z = (int16_t)(local_z - dz * CHUNK_SIZE),
+                .origin_y = (int16_t)base_y,
+                .stamp = (uint16_t)id
+            };
+            structure_store_add(structures, &fragment);
+        }
     }
 }
 
+void tree_place_at(Chunk* chunk, int local_x, int base_y, int local_z, TreeSize size) {
+    if (!chunk) return;
+    place_tree(chunk, NULL, stamp_id(size, TREE_TYPE_OAK), local_x, base_y, local_z);
+}
+
 void tree_place_at_typed(Chunk* chunk, int local_x, int base_y, int local_z,
                          TreeSize size, TreeType type) {
     if (!chunk) return;
+    place_tree(chunk, NULL, stamp_id(size, type), local_x, base_y, local_z);
+}
 
-    int count;
-    const TreeBlock* template = get_template_typed(size, type, &count);
+int tree_apply_pending(Chunk* chunk, StructureStore* structures) {
+    if (!chunk || !structures) return 0;
 
+    StructureFragment* fragments;
+    int count = structure_store_claim(structures, chunk->x, chunk->z, &fragments);
     for (int i = 0; i < count; i++) {
-        int x = local_x + template[i].dx;
-        int y = base_y + template[i].dy;
-        int z = local_z + template[i].dz;
-
-        // Check bounds - skip blocks outside chunk
-        if (x < 0 || x >= CHUNK_SIZE || z < 0 || z >= CHUNK_SIZE) continue;
-        if (y < 0 || y >= CHUNK_HEIGHT) continue;
-
-        // Don't overwrite existing solid blocks (except air and leaves)
-        Block existing = chunk_get_block(chunk, x, y, z);
-        if (existing.type != BLOCK_AIR && !is_leaf_block(existing.type)) continue;
-
-        // Create block with metadata=1 for natural tree
-        Block block = {
-            .type = template[i].type,
-            .light_level = 0,
-            .metadata = 1  // Mark as natural tree
-        };
-
-        chunk_set_block(chunk, x, y, z, block);
+        const TreeStamp* stamp = get_stamp(fragments[i].stamp);
+        if (stamp) {
+            stamp_place(chunk, stamp, fragments[i].origin_x, fragments[i].origin_y, fragments[i].origin_z, NULL, 0);
+        }
     }
+    free(fragments);
+    return count;
+}
+
+int tree_fragment_edits(Chunk* chunk, const StructureFragment* fragment, WorldEdit* edits, int max_edits) {
+    const TreeStamp* stamp = chunk && fragment ? get_stamp(fragment->stamp) : NULL;
+    if (!stamp) return 0;
+    return stamp_place(chunk, stamp, fragment->origin_x, fragment->origin_y, fragment->origin_z,
+                       edits, max_edits);
 }
 
 // ============================================================================
@@ -674,7 +849,7 @@ static void place_cactus(Chunk* chunk, int x, int surface_y, int z) {
     int world_z = chunk->z * CHUNK_SIZE + z;
 
     // Use position hash for height variation
-    uint32_t hash = (uint32_t)(world_x * 73856093 ^ world_z * 19349663);
+    uint32_t hash = random_hash_2d(world_x, world_z, random_feature_seed(noise_get_seed(), RANDOM_FEATURE_CACTUS));
     int height = 1 + (hash % 3);  // 1-3 blocks tall
 
     for (int i = 0; i < height; i++) {
@@ -686,9 +861,13 @@ static void place_cactus(Chunk* chunk, int x, int surface_y, int z) {
     }
 }
 
-void tree_generate_for_chunk(Chunk* chunk) {
+void tree_generate_for_chunk(Chunk* chunk, const ColumnMap* columns, StructureStore* structures) {
     if (!chunk) return;
 
+    // Neighbors' trees first, so the spacing check below sees their trunks
+    tree_apply_pending(chunk, structures);
+
+    uint32_t tree_seed = random_feature_seed(noise_get_seed(), RANDOM_FEATURE_TREES);
     for (int x = 0; x < CHUNK_SIZE; x++) {
         for (int z = 0; z < CHUNK_SIZE; z++) {
             // Calculate world coordinates
@@ -696,7 +875,7 @@ void tree_generate_for_chunk(Chunk* chunk) {
             int world_z = chunk->z * CHUNK_SIZE + z;
 
             // Get biome at this position
-            BiomeType biome = biome_get_at(world_x, world_z);
+            BiomeType biome = columns ? (BiomeType)columns->biomes[z][x] : biome_get_at(world_x, world_z);
             const BiomeProperties* bp = biome_get_properties(biome);
 
             // Find surface using biome-specific surface block
@@ -749,7 +928,7 @@ void tree_generate_for_chunk(Chunk* chunk) {
 
                 if (!too_close) {
                     // Pick tree size and type based on position hash
-                    uint32_t hash = (uint32_t)(world_x * 73856093 ^ world_z * 19349663);
+                    uint32_t hash = random_hash_2d(world_x, world_z, tree_seed);
                     TreeSize size = (TreeSize)(hash % TREE_SIZE_COUNT);
 
                     // Determine tree type from biome
@@ -763,7 +942,7 @@ void tree_generate_for_chunk(Chunk* chunk) {
                     }
 
                     // Place tree with correct type (trunk starts above surface)
-                    tree_place_at_typed(chunk, x, surface_y + 1, z, size, tree_type);
+                    place_tree(chunk, structures, stamp_id(size, tree_type), x, surface_y + 1, z);
                 }
             }
         }
@@ -777,170 +956,237 @@ void tree_generate_for_chunk(Chunk* chunk) {
 // ============================================================================
 // LEAF DECAY SYSTEM
 // ============================================================================
-
-#define MAX_DECAY_QUEUE 256
-#define LEAF_DECAY_RANGE 4  // Max distance leaves can be from wood
+//
+// Leaves store their distance to the nearest log in metadata. Removing a log
+// or leaf runs one two-phase BFS (like light removal): leaves that depended
+// on the removed block are reset to unsupported, then refilled from the
+// surviving supports around them. Whatever stays unsupported is put on a
+// timing wheel and removed when its slot comes up.
+
+#define LEAF_DECAY_TICK 0.05f        // Seconds per wheel slot
+#define LEAF_DECAY_WHEEL_SLOTS 64    // Wheel slots (power of two, > longest delay)
+#define LEAF_DECAY_MIN_TICKS 10      // Decay delay range (0.5 - 2.0 seconds)
+#define LEAF_DECAY_MAX_TICKS 40
+#define LEAF_DECAY_MAX_PENDING 4096  // Scheduled leaves
+#define LEAF_DECAY_SET_BUCKETS 4096  // Scheduled position set buckets (power of two)
+#define LEAF_DECAY_BFS_SIZE 4096     // BFS queue entries (range 4 touches < 9^3 cells)
 
 typedef struct {
     int x, y, z;
-    float timer;  // Seconds until decay check
+    int next;       // Wheel slot or free list (-1 = end)
+    int hash_next;  // Position set chain (-1 = end)
 } DecayEntry;
 
-static DecayEntry g_decay_queue[MAX_DECAY_QUEUE];
-static int g_decay_count = 0;
+typedef struct {
+    int x, y, z, dist;
+} DecayNode;
+
+static DecayEntry g_decay_entries[LEAF_DECAY_MAX_PENDING];
+static int g_decay_free;
+static int g_decay_wheel[LEAF_DECAY_WHEEL_SLOTS];
+static int g_decay_set[LEAF_DECAY_SET_BUCKETS];
+static int g_decay_tick = 0;
+static float g_decay_accumulator = 0.0f;
+
+static DecayNode g_reset_queue[LEAF_DECAY_BFS_SIZE];
+static DecayNode g_refill_queue[LEAF_DECAY_BFS_SIZE];
+
+static const int g_neighbor_offsets[6][3] = {
+    {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}
+};
 
 void leaf_decay_init(void) {
-    g_decay_count = 0;
+    for (int i = 0; i < LEAF_DECAY_MAX_PENDING; i++) {
+        g_decay_entries[i].next = i + 1 < LEAF_DECAY_MAX_PENDING ? i + 1 : -1;
+    }
+    g_decay_free = 0;
+    for (int i = 0; i < LEAF_DECAY_WHEEL_SLOTS; i++) g_decay_wheel[i] = -1;
+    for (int i = 0; i < LEAF_DECAY_SET_BUCKETS; i++) g_decay_set[i] = -1;
+    g_decay_tick = 0;
+    g_decay_accumulator = 0.0f;
+}
+
+static uint32_t decay_bucket(int x, int y, int z) {
+    uint32_t h = (uint32_t)x * 73856093u ^ (uint32_t)y * 19349663u ^ (uint32_t)z * 83492791u;
+    return (h ^ (h >> 13)) & (LEAF_DECAY_SET_BUCKETS - 1);
 }
 
-// Check if position is already in decay queue
-static bool is_in_decay_queue(int x, int y, int z) {
-    for (int i = 0; i < g_decay_count; i++) {
-        if (g_decay_queue[i].x == x &&
-            g_decay_queue[i].y == y &&
-            g_decay_queue[i].z == z) {
+static bool is_decay_scheduled(int x, int y, int z) {
+    for (int e = g_decay_set[decay_bucket(x, y, z)]; e >= 0; e = g_decay_entries[e].hash_next) {
+        if (g_decay_entries[e].x == x && g_decay_entries[e].y == y && g_decay_entries[e].z == z) {
             return true;
         }
     }
     return false;
 }
 
-// Add a leaf to the decay queue
-static void add_to_decay_queue(int x, int y, int z) {
-    if (g_decay_count >= MAX_DECAY_QUEUE) return;
-    if (is_in_decay_queue(x, y, z)) return;
-
-    g_decay_queue[g_decay_count].x = x;
-    g_decay_queue[g_decay_count].y = y;
-    g_decay_queue[g_decay_count].z = z;
-    // Random delay between 0.5 and 2.0 seconds
-    g_decay_queue[g_decay_count].timer = 0.5f + ((float)(rand() % 150) / 100.0f);
-    g_decay_count++;
+static void unlink_decay(int entry) {
+    DecayEntry* d = &g_decay_entries[entry];
+    int* link = &g_decay_set[decay_bucket(d->x, d->y, d->z)];
+    while (*link >= 0 && *link != entry) {
+        link = &g_decay_entries[*link].hash_next;
+    }
+    if (*link >= 0) *link = d->hash_next;
+}
+
+// Put a leaf on the wheel after a random delay (once per position)
+static void schedule_decay(int x, int y, int z) {
+    if (g_decay_free < 0 || is_decay_scheduled(x, y, z)) return;
+
+    int e = g_decay_free;
+    DecayEntry* d = &g_decay_entries[e];
+    g_decay_free = d->next;
+
+    d->x = x;
+    d->y = y;
+    d->z = z;
+    uint32_t bucket = decay_bucket(x, y, z);
+    d->hash_next = g_decay_set[bucket];
+    g_decay_set[bucket] = e;
+
+    // Hash of place and time rather than rand(): no shared generator state
+    uint32_t jitter = random_hash_3d(x, y, z, g_decay_tick);
+    int delay = LEAF_DECAY_MIN_TICKS + (int)(jitter % (LEAF_DECAY_MAX_TICKS - LEAF_DECAY_MIN_TICKS + 1));
+    int slot = (g_decay_tick + delay) & (LEAF_DECAY_WHEEL_SLOTS - 1);
+    d->next = g_decay_wheel[slot];
+    g_decay_wheel[slot] = e;
+}
+
+// Distance stored in a leaf (0 = player-placed)
+static int leaf_distance(Block block) {
+    return block.metadata & LEAF_DISTANCE_MASK;
+}
+
+static void set_leaf_distance(struct World* world, int x, int y, int z, Block block, int dist) {
+    world_set_block_metadata(world, x, y, z,
+                             (uint8_t)((block.metadata & ~LEAF_DISTANCE_MASK) | dist));
 }
 
-void leaf_decay_on_wood_removed(struct World* world, int x, int y, int z) {
+void leaf_decay_on_block_removed(struct World* world, int x, int y, int z, Block removed) {
     if (!world) return;
 
-    // Check all blocks within LEAF_DECAY_RANGE for leaves
-    for (int dx = -LEAF_DECAY_RANGE; dx <= LEAF_DECAY_RANGE; dx++) {
-        for (int dy = -LEAF_DECAY_RANGE; dy <= LEAF_DECAY_RANGE; dy++) {
-            for (int dz = -LEAF_DECAY_RANGE; dz <= LEAF_DECAY_RANGE; dz++) {
-                int nx = x + dx;
-                int ny = y + dy;
-                int nz = z + dz;
-
-                Block block = world_get_block(world, nx, ny, nz);
-                if (is_leaf_block(block.type)) {
-                    add_to_decay_queue(nx, ny, nz);
-                }
-            }
-        }
+    int removed_dist;
+    if (is_wood_block(removed.type)) {
+        removed_dist = 0;
+    } else if (is_leaf_block(removed.type) && leaf_distance(removed) != LEAF_DISTANCE_PERSISTENT) {
+        removed_dist = leaf_distance(removed);
+    } else {
+        return;  // Supported nothing
     }
-}
 
-// Check if a leaf at (x,y,z) is connected to wood within range
-static bool leaf_is_supported(struct World* world, int x, int y, int z) {
-    // BFS to find wood within LEAF_DECAY_RANGE blocks
-    typedef struct { int x, y, z, dist; } SearchNode;
-    SearchNode queue[512];
-    int queue_head = 0, queue_tail = 0;
-
-    // Simple visited tracking
-    #define VISITED_SIZE 512
-    int visited_x[VISITED_SIZE];
-    int visited_y[VISITED_SIZE];
-    int visited_z[VISITED_SIZE];
-    int visited_count = 0;
-
-    // Start from the leaf position
-    queue[queue_tail++] = (SearchNode){x, y, z, 0};
-
-    while (queue_head < queue_tail) {
-        SearchNode node = queue[queue_head++];
-
-        if (node.dist > LEAF_DECAY_RANGE) continue;
-
-        // Check if already visited
-        bool already_visited = false;
-        for (int i = 0; i < visited_count; i++) {
-            if (visited_x[i] == node.x && visited_y[i] == node.y && visited_z[i] == node.z) {
-                already_visited = true;
-                break;
+    WorldCursor cursor;
+    world_cursor_init(&cursor, world);
+    int reset_count = 0, refill_count = 0;
+    g_reset_queue[reset_count++] = (DecayNode){ x, y, z, removed_dist };
+
+    // Phase 1: unsupport every leaf whose distance came through the removed
+    // block; supports found along the way seed the refill
+    for (int head = 0; head < reset_count; head++) {
+        DecayNode node = g_reset_queue[head];
+        for (int i = 0; i < 6; i++) {
+            int nx = node.x + g_neighbor_offsets[i][0];
+            int ny = node.y + g_neighbor_offsets[i][1];
+            int nz = node.z + g_neighbor_offsets[i][2];
+            Block block = world_cursor_get_block(&cursor, nx, ny, nz);
+
+            if (is_wood_block(block.type)) {
+                if (refill_count < LEAF_DECAY_BFS_SIZE) {
+                    g_refill_queue[refill_count++] = (DecayNode){ nx, ny, nz, 0 };
+                }
+                continue;
+            }
+            if (!is_leaf_block(block.type)) continue;
+
+            int dist = leaf_distance(block);
+            if (dist == LEAF_DISTANCE_PERSISTENT) continue;
+            if (dist == LEAF_DISTANCE_NONE) {
+                schedule_decay(nx, ny, nz);  // Already orphaned (generated out of range)
+            } else if (dist > node.dist) {
+                if (reset_count < LEAF_DECAY_BFS_SIZE) {
+                    set_leaf_distance(world, nx, ny, nz, block, LEAF_DISTANCE_NONE);
+                    g_reset_queue[reset_count++] = (DecayNode){ nx, ny, nz, dist };
+                }
+            } else if (refill_count < LEAF_DECAY_BFS_SIZE) {
+                g_refill_queue[refill_count++] = (DecayNode){ nx, ny, nz, dist };
             }
         }
-        if (already_visited) continue;
-
-        // Mark visited
-        if (visited_count < VISITED_SIZE) {
-            visited_x[visited_count] = node.x;
-            visited_y[visited_count] = node.y;
-            visited_z[visited_count] = node.z;
-            visited_count++;
-        }
-
-        Block block = world_get_block(world, node.x, node.y, node.z);
+    }
 
-        // Found wood! Leaf is supported
-        if (is_wood_block(block.type)) {
-            return true;
+    // Phase 2: spread distances back from the remaining supports
+    for (int head = 0; head < refill_count; head++) {
+        DecayNode node = g_refill_queue[head];
+
+        // A seed may have been reset after it was queued: use its current distance
+        Block source = world_cursor_get_block(&cursor, node.x, node.y, node.z);
+        if (is_leaf_block(source.type)) {
+            node.dist = leaf_distance(source);
+            if (node.dist == LEAF_DISTANCE_PERSISTENT) continue;
+        } else if (!is_wood_block(source.type)) {
+            continue;
         }
-
-        // Continue searching through leaves
-        if (is_leaf_block(block.type) || (node.x == x && node.y == y && node.z == z)) {
-            // Add neighbors
-            if (queue_tail < 500) {
-                queue[queue_tail++] = (SearchNode){node.x + 1, node.y, node.z, node.dist + 1};
-                queue[queue_tail++] = (SearchNode){node.x - 1, node.y, node.z, node.dist + 1};
-                queue[queue_tail++] = (SearchNode){node.x, node.y + 1, node.z, node.dist + 1};
-                queue[queue_tail++] = (SearchNode){node.x, node.y - 1, node.z, node.dist + 1};
-                queue[queue_tail++] = (SearchNode){node.x, node.y, node.z + 1, node.dist + 1};
-                queue[queue_tail++] = (SearchNode){node.x, node.y, node.z - 1, node.dist + 1};
+        int dist = node.dist + 1;
+        if (dist > LEAF_DECAY_RANGE) continue;
+
+        for (int i = 0; i < 6; i++) {
+            int nx = node.x + g_neighbor_offsets[i][0];
+            int ny = node.y + g_neighbor_offsets[i][1];
+            int nz = node.z + g_neighbor_offsets[i][2];
+            Block block = world_cursor_get_block(&cursor, nx, ny, nz);
+            if (!is_leaf_block(block.type)) continue;
+
+            int current = leaf_distance(block);
+            if (current == LEAF_DISTANCE_PERSISTENT || current <= dist) continue;
+            set_leaf_distance(world, nx, ny, nz, block, dist);
+            if (refill_count < LEAF_DECAY_BFS_SIZE) {
+                g_refill_queue[refill_count++] = (DecayNode){ nx, ny, nz, dist };
             }
         }
     }
 
-    return false;  // No wood found within range
+    // Leaves no support reached again decay
+    for (int i = 1; i < reset_count; i++) {
+        DecayNode node = g_reset_queue[i];
+        Block block = world_cursor_get_block(&cursor, node.x, node.y, node.z);
+        if (is_leaf_block(block.type) && leaf_distance(block) == LEAF_DISTANCE_NONE) {
+            schedule_decay(node.x, node.y, node.z);
+        }
+    }
 }
 
 void leaf_decay_update(struct World* world, float dt) {
-    if (!world || g_decay_count == 0) return;
+    if (!world) return;
+
+    g_decay_accumulator += dt;
+    while (g_decay_accumulator >= LEAF_DECAY_TICK) {
+        g_decay_accumulator -= LEAF_DECAY_TICK;
+        g_decay_tick++;
+
+        // Detach the slot first: leaves that can't be removed yet go back on the wheel
+        int slot = g_decay_tick & (LEAF_DECAY_WHEEL_SLOTS - 1);
+        int e = g_decay_wheel[slot];
+        g_decay_wheel[slot] = -1;
 
-    // Process decay queue
-    for (int i = g_decay_count - 1; i >= 0; i--) {
-        g_decay_queue[i].timer -= dt;
+        while (e >= 0) {
+            DecayEntry* d = &g_decay_entries[e];
+            int next = d->next;
+            int x = d->x, y = d->y, z = d->z;
 
-        if (g_decay_queue[i].timer <= 0) {
-            int x = g_decay_queue[i].x;
-            int y = g_decay_queue[i].y;
-            int z = g_decay_queue[i].z;
+            unlink_decay(e);
+            d->next = g_decay_free;
+            g_decay_free = e;
 
-            // Check if block is still a leaf
+            // Still an unsupported leaf (a refill may have reached it since)
             Block block = world_get_block(world, x, y, z);
-            if (is_leaf_block(block.type)) {
-                // Check if connected to wood
-                if (!leaf_is_supported(world, x, y, z)) {
-                    // Decay the leaf
-                    Block air = {BLOCK_AIR, 0, 0};
-                    world_set_block(world, x, y, z, air);
-
-                    // Add nearby leaves to queue (chain reaction)
-                    for (int dx = -1; dx <= 1; dx++) {
-                        for (int dy = -1; dy <= 1; dy++) {
-                            for (int dz = -1; dz <= 1; dz++) {
-                                if (dx == 0 && dy == 0 && dz == 0) continue;
-                                Block neighbor = world_get_block(world, x + dx, y + dy, z + dz);
-                                if (is_leaf_block(neighbor.type)) {
-                                    add_to_decay_queue(x + dx, y + dy, z + dz);
-                                }
-                            }
-                        }
-                    }
+            if (is_leaf_block(block.type) && leaf_distance(block) == LEAF_DISTANCE_NONE) {
+                Block air = {BLOCK_AIR, 0, 0};
+                world_set_block(world, x, y, z, air);
+
+                // Chunk busy in a worker: try again later
+                if (world_get_block(world, x, y, z).type == block.type) {
+                    schedule_decay(x, y, z);
                 }
             }
-
-            // Remove from queue (swap with last)
-            g_decay_queue[i] = g_decay_queue[g_decay_count - 1];
-            g_decay_count--;
+            e = next;
         }
     }
 }
@@ -5,6 +5,7 @@
 #include "voxel/inventory/crafting.h"
 #include "voxel/core/item.h"
 #include <stdio.h>
+#include <stdint.h>
 #include <string.h>
 
 // ============================================================================
@@ -14,6 +15,40 @@
 static CraftingRecipe g_recipes[MAX_RECIPES];
 static int g_recipe_count = 0;
 
+/**
+ * Lookup data compiled from a recipe by crafting_init
+ */
+typedef struct {
+    uint64_t key;               // Hash of the trimmed pattern (shaped) or sorted inputs (shapeless)
+    int next;                   // Next recipe in the same bucket plus one, in recipe order (0 = end)
+    ItemType sorted[9];         // Inputs sorted by type (shapeless check)
+    int input_count;
+    ItemType ingredients[9];    // Distinct input types
+    int amounts[9];             // Needed per craft
+    int ingredient_count;
+} CompiledRecipe;
+
+static CompiledRecipe g_compiled[MAX_RECIPES];
+// Recipe indices are stored plus one, so the zeroed tables before
+// crafting_init read as empty
+static int g_shaped_buckets[RECIPE_INDEX_BUCKETS];
+static int g_shapeless_buckets[RECIPE_INDEX_BUCKETS];
+static int g_output_recipe[ITEM_COUNT];    // First recipe producing each item plus one (0 = none)
+
+/**
+ * Item totals of one inventory (hotbar, main inventory and crafting grid),
+ * recounted only when the slot signature changes
+ */
+typedef struct {
+    const Inventory* owner;
+    uint32_t signature;
+    int counts[ITEM_COUNT];
+} ItemCountCache;
+
+static ItemCountCache g_count_cache;
+
+static void build_recipe_index(void);
+
 /**
  * Helper to add a recipe to the database
  */
@@ -361,6 +396,7 @@ void crafting_init(void) {
         },
         ITEM_IRON_DOOR, 3);
 
+    build_recipe_index();
     printf("[CRAFTING] Loaded %d recipes\n", g_recipe_count);
 }
 
@@ -431,52 +467,139 @@ static bool match_shaped_recipe(const CraftingRecipe* recipe, const ItemType gri
     return true;
 }
 
+// ============================================================================
+// RECIPE INDEX
+// ============================================================================
+
+static uint64_t key_mix(uint64_t h, uint32_t v) {
+    return (h ^ v) * 1099511628211ull;
+}
+
 /**
- * Check if a shapeless recipe matches the grid (order doesn't matter)
+ * Hash of the pattern trimmed to its bounding box (position in the grid
+ * doesn't matter, same rule as match_shaped_recipe)
  */
-static bool match_shapeless_recipe(const CraftingRecipe* recipe, const ItemType grid[9]) {
-    // Count required ingredients
-    int required_counts[ITEM_COUNT] = {0};
-    for (int i = 0; i < 9; i++) {
-        if (recipe->inputs[i] != ITEM_NONE) {
-            required_counts[recipe->inputs[i]]++;
+static uint64_t shaped_key(const ItemType items[9]) {
+    int min_row, max_row, min_col, max_col;
+    get_pattern_bounds(items, &min_row, &max_row, &min_col, &max_col);
+
+    uint64_t h = 14695981039346656037ull;
+    if (max_row < 0) return h;
+    h = key_mix(h, (uint32_t)(max_row - min_row + 1));
+    h = key_mix(h, (uint32_t)(max_col - min_col + 1));
+    for (int row = min_row; row <= max_row; row++) {
+        for (int col = min_col; col <= max_col; col++) {
+            h = key_mix(h, (uint32_t)items[row * 3 + col]);
         }
     }
+    return h;
+}
 
-    // Count grid ingredients
-    int grid_counts[ITEM_COUNT] = {0};
+/**
+ * Sort the non-empty inputs by type (the multiset a shapeless recipe needs)
+ * Returns the number of inputs
+ */
+static int sort_inputs(const ItemType items[9], ItemType out[9]) {
+    int count = 0;
     for (int i = 0; i < 9; i++) {
-        if (grid[i] != ITEM_NONE) {
-            grid_counts[grid[i]]++;
+        if (items[i] == ITEM_NONE) continue;
+        int j = count++;
+        while (j > 0 && out[j - 1] > items[i]) {
+            out[j] = out[j - 1];
+            j--;
         }
+        out[j] = items[i];
     }
+    return count;
+}
 
-    // Compare counts for all item types
-    for (int type = 0; type < ITEM_COUNT; type++) {
-        if (required_counts[type] != grid_counts[type]) {
-            return false;
-        }
+static uint64_t shapeless_key(const ItemType sorted[9], int count) {
+    uint64_t h = 14695981039346656037ull;
+    for (int i = 0; i < count; i++) {
+        h = key_mix(h, (uint32_t)sorted[i]);
     }
+    return key_mix(h, (uint32_t)count);
+}
 
-    return true;
+/**
+ * Append a recipe to the tail of its bucket, keeping recipe order
+ */
+static void index_insert(int* buckets, int recipe) {
+    int* link = &buckets[g_compiled[recipe].key & (RECIPE_INDEX_BUCKETS - 1)];
+    while (*link > 0) {
+        link = &g_compiled[*link - 1].next;
+    }
+    *link = recipe + 1;
 }
 
-const CraftingRecipe* crafting_find_match(const ItemType grid[9]) {
-    for (int i = 0; i < g_recipe_count; i++) {
-        const CraftingRecipe* recipe = &g_recipes[i];
+static void build_recipe_index(void) {
+    memset(g_shaped_buckets, 0, sizeof(g_shaped_buckets));
+    memset(g_shapeless_buckets, 0, sizeof(g_shapeless_buckets));
+    memset(g_output_recipe, 0, sizeof(g_output_recipe));
+
+    for (int r = 0; r < g_recipe_count; r++) {
+        const CraftingRecipe* recipe = &g_recipes[r];
+        CompiledRecipe* c = &g_compiled[r];
+        c->next = 0;
+        c->input_count = sort_inputs(recipe->inputs, c->sorted);
+
+        // Sorted inputs group equal types: one ingredient per run
+        c->ingredient_count = 0;
+        for (int i = 0; i < c->input_count; i++) {
+            if (c->ingredient_count > 0 && c->ingredients[c->ingredient_count - 1] == c->sorted[i]) {
+                c->amounts[c->ingredient_count - 1]++;
+            } else {
+                c->ingredients[c->ingredient_count] = c->sorted[i];
+                c->amounts[c->ingredient_count] = 1;
+                c->ingredient_count++;
+            }
+        }
 
         if (recipe->type == RECIPE_SHAPED) {
-            if (match_shaped_recipe(recipe, grid)) {
-                return recipe;
-            }
-        } else {  // RECIPE_SHAPELESS
-            if (match_shapeless_recipe(recipe, grid)) {
-                return recipe;
-            }
+            c->key = shaped_key(recipe->inputs);
+            index_insert(g_shaped_buckets, r);
+        } else {
+            c->key = shapeless_key(c->sorted, c->input_count);
+            index_insert(g_shapeless_buckets, r);
+        }
+
+        if (recipe->output > ITEM_NONE && recipe->output < ITEM_COUNT && g_output_recipe[recipe->output] == 0) {
+            g_output_recipe[recipe->output] = r + 1;
+        }
+    }
+    g_count_cache.owner = NULL;
+}
+
+const CraftingRecipe* crafting_find_match(const ItemType grid[9]) {
+    // The first recipe in registration order wins, shaped or shapeless
+    int best = -1;
+
+    uint64_t key = shaped_key(grid);
+    for (int link = g_shaped_buckets[key & (RECIPE_INDEX_BUCKETS - 1)]; link > 0;
+         link = g_compiled[link - 1].next) {
+        int r = link - 1;
+        if (g_compiled[r].key == key && match_shaped_recipe(&g_recipes[r], grid)) {
+            best = r;
+            break;
+        }
+    }
+
+    ItemType sorted[9];
+    int count = sort_inputs(grid, sorted);
+    key = shapeless_key(sorted, count);
+    for (int link = g_shapeless_buckets[key & (RECIPE_INDEX_BUCKETS - 1)]; link > 0;
+         link = g_compiled[link - 1].next) {
+        int r = link - 1;
+        if (best >= 0 && r > best) break;
+        const CompiledRecipe* c = &g_compiled[r];
+        if (c->key == key && c->input_count == count &&
+            memcmp(c->sorted, sorted, (size_t)count * sizeof(ItemType)) == 0) {
+            best = r;
+            break;
         }
     }
 
-    return NULL;  // No matching recipe
+    return best >= 0 ? &g_recipes[best] : NULL;  // NULL = no matching recipe
 }
 
 // ============================================================================
@@ -554,6 +677,36 @@ bool crafting_try_craft(Inventory* inv) {
     return true;
 }
 
+bool crafting_take_output(Inventory* inv) {
+    if (!inv) return false;
+
+    ItemStack output = inv->crafting_output[0];
+    if (output.type == ITEM_NONE) return false;
+
+    // Can only pick up if hand is empty or holding the same item with room
+    if (inv->is_holding_item) {
+        if (inv->held_item.type != output.type) return false;
+        const ItemProperties* props = item_get_properties(output.type);
+        if (props->max_stack_size - inv->held_item.count < output.count) return false;
+    }
+
+    if (inv->action_func) {
+        InventoryAction action = {INVENTORY_ACTION_CRAFT, NULL, 0, 0, 0, 0, BLOCK_AIR};
+        inv->action_func(inv->action_user, inv, &action);
+    }
+
+    // Consume crafting inputs
+    if (!crafting_try_craft(inv)) return false;
+
+    if (inv->is_holding_item) {
+        inv->held_item.count += output.count;
+    } else {
+        inv->held_item = output;
+        inv->is_holding_item = true;
+    }
+    return true;
+}
+
 int crafting_get_max_craft_count(Inventory* inv) {
     if (!inv) return 0;
 
@@ -662,43 +815,68 @@ const CraftingRecipe* crafting_get_recipe(int index) {
     return &g_recipes[index];
 }
 
-bool crafting_can_craft_recipe(Inventory* inv, const CraftingRecipe* recipe) {
-    if (!inv || !recipe) return false;
+static uint32_t slot_signature(uint32_t h, const ItemStack* slots, int count) {
+    for (int i = 0; i < count; i++) {
+        h = (h ^ ((uint32_t)slots[i].type << 8 | slots[i].count)) * 16777619u;
+    }
+    return h;
+}
 
-    // Count required ingredients from recipe
-    int required[ITEM_COUNT] = {0};
-    for (int i = 0; i < 9; i++) {
-        if (recipe->inputs[i] != ITEM_NONE) {
-            required[recipe->inputs[i]]++;
-        }
+/**
+ * Item totals over hotbar, main inventory and crafting grid
+ * Hashing the slots is much cheaper than recounting, so the crafting guide
+ * can ask for every recipe each frame
+ */
+static const int* inventory_counts(const Inventory* inv) {
+    uint32_t signature = 2166136261u;
+    signature = slot_signature(signature, inv->hotbar, HOTBAR_SIZE);
+    signature = slot_signature(signature, inv->main_inventory, MAIN_INVENTORY_SIZE);
+    signature = slot_signature(signature, inv->crafting_grid, CRAFTING_GRID_SIZE);
+
+    ItemCountCache* cache = &g_count_cache;
+    if (cache->owner == inv && cache->signature == signature) {
+        return cache->counts;
     }
 
-    // Count available items in inventory (hotbar + main inventory + crafting grid)
-    int available[ITEM_COUNT] = {0};
+    memset(cache->counts, 0, sizeof(cache->counts));
     for (int i = 0; i < HOTBAR_SIZE; i++) {
         if (inv->hotbar[i].type != ITEM_NONE) {
-            available[inv->hotbar[i].type] += inv->hotbar[i].count;
+            cache->counts[inv->hotbar[i].type] += inv->hotbar[i].count;
         }
     }
     for (int i = 0; i < MAIN_INVENTORY_SIZE; i++) {
         if (inv->main_inventory[i].type != ITEM_NONE) {
-            available[inv->main_inventory[i].type] += inv->main_inventory[i].count;
+            cache->counts[inv->main_inventory[i].type] += inv->main_inventory[i].count;
         }
     }
     // Also count items in crafting grid (user may have moved items there)
-    for (int i = 0; i < 9; i++) {
+    for (int i = 0; i < CRAFTING_GRID_SIZE; i++) {
         if (inv->crafting_grid[i].type != ITEM_NONE) {
-            available[inv->crafting_grid[i].type] += inv->crafting_grid[i].count;
+            cache->counts[inv->crafting_grid[i].type] += inv->crafting_grid[i].count;
         }
     }
-    // Also count held item (cursor item being dragged)
-    if (inv->is_holding_item && inv->held_item.type != ITEM_NONE) {
-        available[inv->held_item.type] += inv->held_item.count;
-    }
+    cache->owner = inv;
+    cache->signature = signature;
+    return cache->counts;
+}
+
+static const CompiledRecipe* compiled_recipe(const CraftingRecipe* recipe) {
+    return &g_compiled[recipe - g_recipes];
+}
+
+bool crafting_can_craft_recipe(Inventory* inv, const CraftingRecipe* recipe) {
+    if (!inv || !recipe) return false;
 
-    // Check if all required ingredients are available
-    for (int i = 0; i < ITEM_COUNT; i++) {
-        if (required[i] > available[i]) {
+    const int* available = inventory_counts(inv);
+    const CompiledRecipe* c = compiled_recipe(recipe);
+    for (int i = 0; i < c->ingredient_count; i++) {
+        int have = available[c->ingredients[i]];
+
+        // Also count held item (cursor item being dragged)
+        if (inv->is_holding_item && inv->held_item.type == c->ingredients[i]) {
+            have += inv->held_item.count;
+        }
+        if (have < c->amounts[i]) {
             return false;
         }
     }
@@ -707,53 +885,23 @@ bool crafting_can_craft_recipe(Inventory* inv, const CraftingRecipe* recipe) {
 }
 
 const CraftingRecipe* crafting_find_recipe_for_output(ItemType output) {
-    if (output == ITEM_NONE) return NULL;
+    if (output <= ITEM_NONE || output >= ITEM_COUNT) return NULL;
 
-    for (int i = 0; i < g_recipe_count; i++) {
-        if (g_recipes[i].output == output) {
-            return &g_recipes[i];
-        }
-    }
-    return NULL;
+    int r = g_output_recipe[output];
+    return r > 0 ? &g_recipes[r - 1] : NULL;
 }
 
 int crafting_count_available_crafts(Inventory* inv, const CraftingRecipe* recipe) {
     if (!inv || !recipe) return 0;
 
-    // Count required ingredients
-    int required[ITEM_COUNT] = {0};
-    for (int i = 0; i < 9; i++) {
-        if (recipe->inputs[i] != ITEM_NONE) {
-            required[recipe->inputs[i]]++;
-        }
-    }
-
-    // Count available items from all sources
-    int available[ITEM_COUNT] = {0};
-    for (int i = 0; i < HOTBAR_SIZE; i++) {
-        if (inv->hotbar[i].type != ITEM_NONE) {
-            available[inv->hotbar[i].type] += inv->hotbar[i].count;
-        }
-    }
-    for (int i = 0; i < MAIN_INVENTORY_SIZE; i++) {
-        if (inv->main_inventory[i].type != ITEM_NONE) {
-            available[inv->main_inventory[i].type] += inv->main_inventory[i].count;
-        }
-    }
-    for (int i = 0; i < 9; i++) {
-        if (inv->crafting_grid[i].type != ITEM_NONE) {
-            available[inv->crafting_grid[i].type] += inv->crafting_grid[i].count;
-        }
-    }
-
     // Find the minimum number of crafts possible
+    const int* available = inventory_counts(inv);
+    const CompiledRecipe* c = compiled_recipe(recipe);
     int max_crafts = 999;
-    for (int type = 0; type < ITEM_COUNT; type++) {
-        if (required[type] > 0) {
-            int possible = available[type] / required[type];
-            if (possible < max_crafts) {
-                max_crafts = possible;
-            }
+    for (int i = 0; i < c->ingredient_count; i++) {
+        int possible = available[c->ingredients[i]] / c->amounts[i];
+        if (possible < max_crafts) {
+            max_crafts = possible;
         }
     }
 
@@ -3,6 +3,7 @@
  */
 
 #include "voxel/inventory/inventory.h"
+#include "voxel/world/chest.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -50,6 +51,25 @@ void inventory_clear(Inventory* inv) {
     inv->is_holding_item = false;
 }
 
+void inventory_give_starting_items(Inventory* inv) {
+    if (!inv) return;
+
+    // Stone tools in hotbar slots 0-2
+    inv->hotbar[0] = (ItemStack){ITEM_STONE_PICKAXE, 1, 132, 132};
+    inv->hotbar[1] = (ItemStack){ITEM_STONE_SHOVEL, 1, 132, 132};
+    inv->hotbar[2] = (ItemStack){ITEM_STONE_AXE, 1, 132, 132};
+    // Blocks in slots 3-5
+    inv->hotbar[3] = (ItemStack){ITEM_WOOD_LOG, 16, 0, 0};
+    inv->hotbar[4] = (ItemStack){ITEM_DIRT, 64, 0, 0};
+    inv->hotbar[5] = (ItemStack){ITEM_COBBLESTONE, 32, 0, 0};
+    // New items for testing
+    inv->hotbar[6] = (ItemStack){ITEM_STONE_SWORD, 1, 132, 132};  // Sword for combat
+    inv->hotbar[7] = (ItemStack){ITEM_WOOL_WHITE, 16, 0, 0};   // Wool for bed crafting
+    inv->hotbar[8] = (ItemStack){ITEM_WOOD_PLANKS, 32, 0, 0};  // Planks for crafting
+    // Add some iron blocks for crafting (in main inventory)
+    inventory_add_item(inv, ITEM_IRON_BLOCK, 8);
+}
+
 // ============================================================================
 // SLOT ACCESS
 // ============================================================================
@@ -206,3 +226,64 @@ bool inventory_remove_item(Inventory* inv, int slot_index, uint8_t count) {
 
     return true;
 }
+
+// ============================================================================
+// VALIDATED ACTIONS
+// ============================================================================
+
+void inventory_set_action_func(Inventory* inv, InventoryActionFunc func, void* user) {
+    if (!inv) return;
+    inv->action_func = func;
+    inv->action_user = user;
+}
+
+bool inventory_take_from_chest(Inventory* inv, ChestData* chest, int chest_slot) {
+    if (!inv || !chest || chest_slot < 0 || chest_slot >= CHEST_SLOTS) return false;
+
+    ItemStack item = chest->slots[chest_slot];
+    if (item.type == ITEM_NONE || item.count == 0) return false;
+    if (!inventory_can_add_item(inv, item.type, item.count)) return false;
+
+    if (inv->action_func) {
+        InventoryAction action = {INVENTORY_ACTION_CHEST_TAKE, chest, chest_slot, 0, 0, 0, BLOCK_AIR};
+        inv->action_func(inv->action_user, inv, &action);
+    }
+
+    item = chest_take_item(chest, chest_slot);
+    inventory_add_item(inv, item.type, item.count);
+    return true;
+}
+
+bool inventory_store_in_chest(Inventory* inv, int slot_index, ChestData* chest) {
+    if (!inv || !chest || slot_index < 0 || slot_index >= INVENTORY_SLOT_CRAFTING_GRID) return false;
+
+    ItemStack* slot = inventory_get_slot(inv, slot_index);
+    if (slot->type == ITEM_NONE) return false;
+
+    if (inv->action_func) {
+        InventoryAction action = {INVENTORY_ACTION_CHEST_STORE, chest, slot_index, 0, 0, 0, BLOCK_AIR};
+        inv->action_func(inv->action_user, inv, &action);
+    }
+
+    if (!chest_add_item(chest, *slot)) return false;
+    memset(slot, 0, sizeof(ItemStack));
+    return true;
+}
+
+bool inventory_add_block_drop(Inventory* inv, int x, int y, int z, BlockType block) {
+    if (!inv) return false;
+
+    ItemStack* held = inventory_get_selected_hotbar_item(inv);
+    ItemType tool = held ? held->type : ITEM_NONE;
+    if (!item_can_harvest_block(block, tool)) return false;
+
+    ItemStack drop = item_get_block_drop(block);
+    if (drop.type == ITEM_NONE || !inventory_can_add_item(inv, drop.type, drop.count)) return false;
+
+    if (inv->action_func) {
+        InventoryAction action = {INVENTORY_ACTION_MINE, NULL, inv->selected_hotbar_slot, x, y, z, block};
+        inv->action_func(inv->action_user, inv, &action);
+    }
+
+    return inventory_add_item(inv, drop.type, drop.count);
+}
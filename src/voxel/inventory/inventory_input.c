@@ -133,40 +133,9 @@ void inventory_input_handle_left_click(Inventory* inv, int mouse_x, int mouse_y)
         return;  // No slot clicked
     }
 
-    // Special case: clicking crafting output
+    // Special case: clicking crafting output picks up the crafted item
     if (section == SECTION_CRAFTING_OUTPUT) {
-        ItemStack* output_slot = &inv->crafting_output[0];
-
-        // Can only pick up if output has an item
-        if (output_slot->type == ITEM_NONE) {
-            return;
-        }
-
-        // Can only pick up if hand is empty or holding same item type
-        if (inv->is_holding_item && inv->held_item.type != output_slot->type) {
-            return;  // Can't swap with crafting output
-        }
-
-        // Pick up crafted item
-        if (!inv->is_holding_item) {
-            // Empty hand - pick up output
-            inv->held_item = *output_slot;
-            inv->is_holding_item = true;
-        } else {
-            // Holding same item - try to stack
-            const ItemProperties* props = item_get_properties(output_slot->type);
-            uint8_t space = props->max_stack_size - inv->held_item.count;
-
-            if (space < output_slot->count) {
-                return;  // Not enough space in held stack
-            }
-
-            inv->held_item.count += output_slot->count;
-        }
-
-        // Consume crafting inputs
-        crafting_try_craft(inv);
-
+        crafting_take_output(inv);
         return;
     }
 
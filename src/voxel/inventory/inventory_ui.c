@@ -9,6 +9,7 @@
 #include "voxel/inventory/inventory_input.h"
 #include "voxel/world/chest.h"
 #include "voxel/player/player.h"
+#include "voxel/ui/ui_cache.h"
 #include <raylib.h>
 #include <rlgl.h>
 #include <raymath.h>
@@ -44,6 +45,9 @@
 #define PREVIEW_SLOT_SIZE 24
 #define PREVIEW_GAP 2
 
+// Icons queued per panel redraw (inventory: 46 slots + 30 browser + 10 preview)
+#define ICON_BATCH_MAX 128
+
 // ============================================================================
 // CRAFTING GUIDE STATE
 // ============================================================================
@@ -56,6 +60,14 @@ static ItemType guide_filtered_items[ITEM_COUNT];
 static int guide_filtered_count = 0;
 static bool guide_initialized = false;
 
+// ============================================================================
+// PANEL CACHES
+// ============================================================================
+
+// Full-screen panels are redrawn into these only when what they show changes
+static UiCache g_inventory_cache;
+static UiCache g_chest_cache;
+
 // ============================================================================
 // HELPER FUNCTIONS
 // ============================================================================
@@ -123,6 +135,100 @@ static void draw_mini_item_icon(ItemType type, int x, int y, int size, Texture2D
     DrawTexturePro(atlas, source, dest, (Vector2){0, 0}, 0.0f, tint);
 }
 
+// ============================================================================
+// ICON BATCH
+// ============================================================================
+
+// Icons and stack counts are queued while a panel is laid out and drawn after
+// it, so the atlas quads go out as one batch instead of alternating textures
+// with the panel's rectangles and text
+
+typedef struct QueuedIcon {
+    ItemType type;
+    int x, y, size;
+    Color tint;
+} QueuedIcon;
+
+typedef struct QueuedCount {
+    int x, y, slot_size;
+    uint8_t count;
+} QueuedCount;
+
+static QueuedIcon g_icon_batch[ICON_BATCH_MAX];
+static int g_icon_batch_count = 0;
+static QueuedCount g_count_batch[ICON_BATCH_MAX];
+static int g_count_batch_count = 0;
+
+static void queue_icon(ItemType type, int x, int y, int size, Color tint) {
+    if (type == ITEM_NONE || g_icon_batch_count >= ICON_BATCH_MAX) return;
+    g_icon_batch[g_icon_batch_count++] = (QueuedIcon){type, x, y, size, tint};
+}
+
+/**
+ * Queue a slot's item icon (28px, centered) and stack count
+ */
+static void queue_slot_stack(const ItemStack* slot, int x, int y, int slot_size) {
+    if (slot->type == ITEM_NONE) return;
+
+    queue_icon(slot->type, x + (slot_size - 28) / 2, y + (slot_size - 28) / 2, 28, WHITE);
+    if (slot->count > 1 && g_count_batch_count < ICON_BATCH_MAX) {
+        g_count_batch[g_count_batch_count++] = (QueuedCount){x, y, slot_size, slot->count};
+    }
+}
+
+/**
+ * Draw all queued icons, then the counts on top of them
+ */
+static void flush_icon_batch(Texture2D atlas) {
+    for (int i = 0; i < g_icon_batch_count; i++) {
+        const QueuedIcon* icon = &g_icon_batch[i];
+        draw_mini_item_icon(icon->type, icon->x, icon->y, icon->size, atlas, icon->tint);
+    }
+    for (int i = 0; i < g_count_batch_count; i++) {
+        const QueuedCount* c = &g_count_batch[i];
+        draw_item_count(c->x, c->y, c->slot_size, c->count);
+    }
+    g_icon_batch_count = 0;
+    g_count_batch_count = 0;
+}
+
+// ============================================================================
+// PANEL SIGNATURES
+// ============================================================================
+
+static uint32_t hash_stacks(uint32_t hash, const ItemStack* stacks, int count) {
+    for (int i = 0; i < count; i++) {
+        hash = ui_hash_int(hash, (int)stacks[i].type);
+        hash = ui_hash_int(hash, (int)stacks[i].count);
+    }
+    return hash;
+}
+
+/**
+ * Everything the player's slots contribute to a panel: contents, plus the
+ * held item because the guide's craftability counts it
+ */
+static uint32_t hash_inventory(uint32_t hash, const Inventory* inv) {
+    hash = hash_stacks(hash, inv->main_inventory, MAIN_INVENTORY_SIZE);
+    hash = hash_stacks(hash, inv->hotbar, HOTBAR_SIZE);
+    hash = hash_stacks(hash, inv->crafting_grid, CRAFTING_GRID_SIZE);
+    hash = hash_stacks(hash, inv->crafting_output, CRAFTING_OUTPUT_SIZE);
+    hash = ui_hash_int(hash, inv->is_holding_item);
+    if (inv->is_holding_item) hash = hash_stacks(hash, &inv->held_item, 1);
+    return hash;
+}
+
+/**
+ * Guide state (the filtered list follows from the search text)
+ */
+static uint32_t hash_guide(uint32_t hash) {
+    hash = ui_hash_int(hash, guide_current_page);
+    hash = ui_hash_int(hash, (int)guide_selected_item);
+    hash = ui_hash_str(hash, guide_search_text);
+    hash = ui_hash_int(hash, guide_search_active);
+    return hash;
+}
+
 /**
  * Case-insensitive substring search
  */
@@ -212,7 +318,7 @@ static void draw_search_box(int x, int y, int width) {
 /**
  * Draw the item browser grid
  */
-static void draw_item_browser(int x, int y, Texture2D atlas, Inventory* inv) {
+static void draw_item_browser(int x, int y, Inventory* inv) {
     int start_idx = guide_current_page * ITEMS_PER_PAGE;
 
     for (int row = 0; row < BROWSER_ROWS; row++) {
@@ -247,7 +353,7 @@ static void draw_item_browser(int x, int y, Texture2D atlas, Inventory* inv) {
 
                 int icon_x = slot_x + (BROWSER_ITEM_SIZE - 24) / 2;
                 int icon_y = slot_y + (BROWSER_ITEM_SIZE - 24) / 2;
-                draw_mini_item_icon(item, icon_x, icon_y, 24, atlas, tint);
+                queue_icon(item, icon_x, icon_y, 24, tint);
             }
         }
     }
@@ -277,7 +383,7 @@ static void draw_pagination(int x, int y) {
 /**
  * Draw the recipe preview (3x3 grid showing exact pattern)
  */
-static void draw_recipe_preview(int x, int y, Texture2D atlas, Inventory* inv) {
+static void draw_recipe_preview(int x, int y, Inventory* inv) {
     const CraftingRecipe* recipe = crafting_find_recipe_for_output(guide_selected_item);
 
     if (!recipe) {
@@ -308,7 +414,7 @@ static void draw_recipe_preview(int x, int y, Texture2D atlas, Inventory* inv) {
             if (recipe->inputs[idx] != ITEM_NONE) {
                 int icon_x = slot_x + (PREVIEW_SLOT_SIZE - 20) / 2;
                 int icon_y = slot_y + (PREVIEW_SLOT_SIZE - 20) / 2;
-                draw_mini_item_icon(recipe->inputs[idx], icon_x, icon_y, 20, atlas, WHITE);
+                queue_icon(recipe->inputs[idx], icon_x, icon_y, 20, WHITE);
             }
         }
     }
@@ -326,7 +432,7 @@ static void draw_recipe_preview(int x, int y, Texture2D atlas, Inventory* inv) {
 
     int icon_x = out_x + (PREVIEW_SLOT_SIZE - 20) / 2;
     int icon_y = out_y + (PREVIEW_SLOT_SIZE - 20) / 2;
-    draw_mini_item_icon(recipe->output, icon_x, icon_y, 20, atlas, WHITE);
+    queue_icon(recipe->output, icon_x, icon_y, 20, WHITE);
 
     // Draw output count
     if (recipe->output_count > 1) {
@@ -371,11 +477,9 @@ static void draw_craft_buttons(int x, int y, Inventory* inv) {
 }
 
 /**
- * Draw the Luanti-style crafting guide sidebar
+ * Draw the Luanti-style crafting guide sidebar (icons are queued)
  */
-static void draw_crafting_guide(Inventory* inv, Texture2D atlas) {
-    guide_init_if_needed();
-
+static void draw_crafting_guide(Inventory* inv) {
     // Draw sidebar panel background
     DrawRectangle(GUIDE_X, GUIDE_Y, GUIDE_WIDTH, GUIDE_HEIGHT, (Color){40, 40, 40, 240});
     DrawRectangleLines(GUIDE_X, GUIDE_Y, GUIDE_WIDTH, GUIDE_HEIGHT, (Color){150, 150, 150, 255});
@@ -391,7 +495,7 @@ static void draw_crafting_guide(Inventory* inv, Texture2D atlas) {
              (Color){100, 100, 100, 255});
 
     // Item browser grid
-    draw_item_browser(GUIDE_X + 10, GUIDE_Y + 58, atlas, inv);
+    draw_item_browser(GUIDE_X + 10, GUIDE_Y + 58, inv);
 
     // Pagination
     int browser_height = BROWSER_ROWS * (BROWSER_ITEM_SIZE + 2);
@@ -404,7 +508,7 @@ static void draw_crafting_guide(Inventory* inv, Texture2D atlas) {
 
     // Recipe preview (only if an item is selected)
     if (guide_selected_item != ITEM_NONE) {
-        draw_recipe_preview(GUIDE_X + 10, preview_y, atlas, inv);
+        draw_recipe_preview(GUIDE_X + 10, preview_y, inv);
 
         // Craft buttons
         draw_craft_buttons(GUIDE_X + 10, GUIDE_Y + GUIDE_HEIGHT - 32, inv);
@@ -502,9 +606,10 @@ void inventory_ui_draw_hotbar(Inventory* inv, Texture2D atlas) {
     }
 }
 
-void inventory_ui_draw_full_screen(Inventory* inv, Texture2D atlas) {
-    if (!inv) return;
-
+/**
+ * Draw the inventory panel and crafting guide (into the panel cache)
+ */
+static void draw_inventory_panel(Inventory* inv, Texture2D atlas) {
     const int SLOT_SIZE = 40;
     const int SLOT_GAP = 2;
     int screen_width = GetScreenWidth();
@@ -540,14 +645,7 @@ void inventory_ui_draw_full_screen(Inventory* inv, Texture2D atlas) {
 
             draw_slot(x, y, SLOT_SIZE);
 
-            // Draw item if present
-            ItemStack* slot = &inv->crafting_grid[slot_index];
-            if (slot->type != ITEM_NONE) {
-                int icon_x = x + (SLOT_SIZE - 28) / 2;
-                int icon_y = y + (SLOT_SIZE - 28) / 2;
-                inventory_ui_draw_item_icon(slot->type, icon_x, icon_y, 28, atlas);
-                draw_item_count(x, y, SLOT_SIZE, slot->count);
-            }
+            queue_slot_stack(&inv->crafting_grid[slot_index], x, y, SLOT_SIZE);
         }
     }
 
@@ -560,13 +658,7 @@ void inventory_ui_draw_full_screen(Inventory* inv, Texture2D atlas) {
     int output_y = craft_y + SLOT_SIZE - SLOT_SIZE/2;
     draw_slot(output_x, output_y, SLOT_SIZE);
 
-    ItemStack* output_slot = &inv->crafting_output[0];
-    if (output_slot->type != ITEM_NONE) {
-        int icon_x = output_x + (SLOT_SIZE - 28) / 2;
-        int icon_y = output_y + (SLOT_SIZE - 28) / 2;
-        inventory_ui_draw_item_icon(output_slot->type, icon_x, icon_y, 28, atlas);
-        draw_item_count(output_x, output_y, SLOT_SIZE, output_slot->count);
-    }
+    queue_slot_stack(&inv->crafting_output[0], output_x, output_y, SLOT_SIZE);
 
     // Section 2: Main Inventory (3 rows x 9 columns)
     int inv_x = panel_x + 20;
@@ -582,14 +674,7 @@ void inventory_ui_draw_full_screen(Inventory* inv, Texture2D atlas) {
 
             draw_slot(x, y, SLOT_SIZE);
 
-            // Draw item if present
-            ItemStack* slot = &inv->main_inventory[slot_index];
-            if (slot->type != ITEM_NONE) {
-                int icon_x = x + (SLOT_SIZE - 28) / 2;
-                int icon_y = y + (SLOT_SIZE - 28) / 2;
-                inventory_ui_draw_item_icon(slot->type, icon_x, icon_y, 28, atlas);
-                draw_item_count(x, y, SLOT_SIZE, slot->count);
-            }
+            queue_slot_stack(&inv->main_inventory[slot_index], x, y, SLOT_SIZE);
         }
     }
 
@@ -603,18 +688,34 @@ void inventory_ui_draw_full_screen(Inventory* inv, Texture2D atlas) {
 
         draw_slot(x, y, SLOT_SIZE);
 
-        // Draw item if present
-        ItemStack* slot = &inv->hotbar[i];
-        if (slot->type != ITEM_NONE) {
-            int icon_x = x + (SLOT_SIZE - 28) / 2;
-            int icon_y = y + (SLOT_SIZE - 28) / 2;
-            inventory_ui_draw_item_icon(slot->type, icon_x, icon_y, 28, atlas);
-            draw_item_count(x, y, SLOT_SIZE, slot->count);
-        }
+        queue_slot_stack(&inv->hotbar[i], x, y, SLOT_SIZE);
     }
 
     // Draw crafting guide sidebar
-    draw_crafting_guide(inv, atlas);
+    draw_crafting_guide(inv);
+
+    flush_icon_batch(atlas);
+}
+
+void inventory_ui_draw_full_screen(Inventory* inv, Texture2D atlas) {
+    if (!inv) return;
+
+    guide_init_if_needed();
+
+    uint32_t signature = hash_inventory(UI_HASH_SEED, inv);
+    signature = hash_guide(signature);
+    signature = ui_hash_int(signature, (int)atlas.id);
+
+    if (ui_cache_begin(&g_inventory_cache, signature)) {
+        draw_inventory_panel(inv, atlas);
+        ui_cache_end(&g_inventory_cache);
+    }
+    ui_cache_draw(&g_inventory_cache);
+}
+
+void inventory_ui_unload(void) {
+    ui_cache_unload(&g_inventory_cache);
+    ui_cache_unload(&g_chest_cache);
 }
 
 void inventory_ui_draw_tooltip(Inventory* inv, int mouse_x, int mouse_y) {
@@ -700,9 +801,10 @@ void inventory_ui_draw_tooltip(Inventory* inv, int mouse_x, int mouse_y) {
 #define CHEST_SLOT_SIZE 40
 #define CHEST_SLOT_GAP 2
 
-void inventory_ui_draw_chest(ChestData* chest, Inventory* inv, Texture2D atlas) {
-    if (!chest || !inv) return;
-
+/**
+ * Draw the chest panel with the player's inventory (into the panel cache)
+ */
+static void draw_chest_panel(ChestData* chest, Inventory* inv, Texture2D atlas) {
     const int SLOT_SIZE = CHEST_SLOT_SIZE;
     const int SLOT_GAP = CHEST_SLOT_GAP;
 
@@ -735,14 +837,8 @@ void inventory_ui_draw_chest(ChestData* chest, Inventory* inv, Texture2D atlas)
             draw_slot(x, y, SLOT_SIZE);
 
             // Draw item if present
-            if (slot_index < CHEST_SLOTS) {
-                ItemStack* slot = &chest->slots[slot_index];
-                if (slot->type != ITEM_NONE && slot->count > 0) {
-                    int icon_x = x + (SLOT_SIZE - 28) / 2;
-                    int icon_y = y + (SLOT_SIZE - 28) / 2;
-                    inventory_ui_draw_item_icon(slot->type, icon_x, icon_y, 28, atlas);
-                    draw_item_count(x, y, SLOT_SIZE, slot->count);
-                }
+            if (slot_index < CHEST_SLOTS && chest->slots[slot_index].count > 0) {
+                queue_slot_stack(&chest->slots[slot_index], x, y, SLOT_SIZE);
             }
         }
     }
@@ -766,12 +862,8 @@ void inventory_ui_draw_chest(ChestData* chest, Inventory* inv, Texture2D atlas)
             draw_slot(x, y, SLOT_SIZE);
 
             // Draw item if present
-            ItemStack* slot = &inv->main_inventory[slot_index];
-            if (slot->type != ITEM_NONE && slot->count > 0) {
-                int icon_x = x + (SLOT_SIZE - 28) / 2;
-                int icon_y = y + (SLOT_SIZE - 28) / 2;
-                inventory_ui_draw_item_icon(slot->type, icon_x, icon_y, 28, atlas);
-                draw_item_count(x, y, SLOT_SIZE, slot->count);
+            if (inv->main_inventory[slot_index].count > 0) {
+                queue_slot_stack(&inv->main_inventory[slot_index], x, y, SLOT_SIZE);
             }
         }
     }
@@ -787,17 +879,30 @@ void inventory_ui_draw_chest(ChestData* chest, Inventory* inv, Texture2D atlas)
         draw_slot(x, y, SLOT_SIZE);
 
         // Draw item if present
-        ItemStack* slot = &inv->hotbar[i];
-        if (slot->type != ITEM_NONE && slot->count > 0) {
-            int icon_x = x + (SLOT_SIZE - 28) / 2;
-            int icon_y = y + (SLOT_SIZE - 28) / 2;
-            inventory_ui_draw_item_icon(slot->type, icon_x, icon_y, 28, atlas);
-            draw_item_count(x, y, SLOT_SIZE, slot->count);
+        if (inv->hotbar[i].count > 0) {
+            queue_slot_stack(&inv->hotbar[i], x, y, SLOT_SIZE);
         }
     }
 
     // Instructions
     DrawText("Click items to transfer. Press E or ESC to close.", panel_x + 20, panel_y + panel_h - 25, 14, GRAY);
+
+    flush_icon_batch(atlas);
+}
+
+void inventory_ui_draw_chest(ChestData* chest, Inventory* inv, Texture2D atlas) {
+    if (!chest || !inv) return;
+
+    uint32_t signature = ui_hash(UI_HASH_SEED, &chest, sizeof(chest));
+    signature = ui_hash_int(signature, (int)atlas.id);
+    signature = hash_stacks(signature, chest->slots, CHEST_SLOTS);
+    signature = hash_inventory(signature, inv);
+
+    if (ui_cache_begin(&g_chest_cache, signature)) {
+        draw_chest_panel(chest, inv, atlas);
+        ui_cache_end(&g_chest_cache);
+    }
+    ui_cache_draw(&g_chest_cache);
 }
 
 void inventory_ui_handle_chest_click(ChestData* chest, Inventory* inv, int mouse_x, int mouse_y) {
@@ -821,13 +926,9 @@ void inventory_ui_handle_chest_click(ChestData* chest, Inventory* inv, int mouse
             if (mouse_x >= x && mouse_x < x + SLOT_SIZE &&
                 mouse_y >= y && mouse_y < y + SLOT_SIZE) {
                 // Clicked on chest slot - transfer to player inventory
-                if (slot_index < CHEST_SLOTS && chest->slots[slot_index].type != ITEM_NONE) {
+                if (slot_index < CHEST_SLOTS) {
                     ItemStack item = chest->slots[slot_index];
-
-                    // Try to add to player inventory
-                    if (inventory_add_item(inv, item.type, item.count)) {
-                        // Remove from chest
-                        chest->slots[slot_index] = (ItemStack){ITEM_NONE, 0, 0, 0};
+                    if (inventory_take_from_chest(inv, chest, slot_index)) {
                         printf("[CHEST] Took %d %s\n", item.count, item_get_name(item.type));
                     }
                 }
@@ -851,15 +952,9 @@ void inventory_ui_handle_chest_click(ChestData* chest, Inventory* inv, int mouse
             if (mouse_x >= x && mouse_x < x + SLOT_SIZE &&
                 mouse_y >= y && mouse_y < y + SLOT_SIZE) {
                 // Clicked on inventory slot - transfer to chest
-                if (inv->main_inventory[slot_index].type != ITEM_NONE) {
-                    ItemStack item = inv->main_inventory[slot_index];
-
-                    // Try to add to chest
-                    if (chest_add_item(chest, item)) {
-                        // Remove from inventory
-                        inv->main_inventory[slot_index] = (ItemStack){ITEM_NONE, 0, 0, 0};
-                        printf("[CHEST] Stored %d %s\n", item.count, item_get_name(item.type));
-                    }
+                ItemStack item = inv->main_inventory[slot_index];
+                if (inventory_store_in_chest(inv, HOTBAR_SIZE + slot_index, chest)) {
+                    printf("[CHEST] Stored %d %s\n", item.count, item_get_name(item.type));
                 }
                 return;
             }
@@ -877,15 +972,9 @@ void inventory_ui_handle_chest_click(ChestData* chest, Inventory* inv, int mouse
         if (mouse_x >= x && mouse_x < x + SLOT_SIZE &&
             mouse_y >= y && mouse_y < y + SLOT_SIZE) {
             // Clicked on hotbar slot - transfer to chest
-            if (inv->hotbar[i].type != ITEM_NONE) {
-                ItemStack item = inv->hotbar[i];
-
-                // Try to add to chest
-                if (chest_add_item(chest, item)) {
-                    // Remove from hotbar
-                    inv->hotbar[i] = (ItemStack){ITEM_NONE, 0, 0, 0};
-                    printf("[CHEST] Stored %d %s\n", item.count, item_get_name(item.type));
-                }
+            ItemStack item = inv->hotbar[i];
+            if (inventory_store_in_chest(inv, i, chest)) {
+                printf("[CHEST] Stored %d %s\n", item.count, item_get_name(item.type));
             }
             return;
         }
@@ -9,11 +9,16 @@
 #include "voxel/world/world.h"
 #include "voxel/player/player.h"
 #include "voxel/inventory/inventory.h"
+#include "voxel/inventory/crafting.h"
+#include "voxel/world/chest.h"
 #include "voxel/entity/entity.h"
 #include "voxel/entity/block_human.h"
+#include "voxel/entity/pig.h"
+#include "voxel/entity/sheep.h"
 #include "voxel/core/block.h"
 
 #include <stdio.h>
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
@@ -26,13 +31,26 @@
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <poll.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
 
 // ============================================================================
 // UTILITY FUNCTIONS
 // ============================================================================
 
 static float get_time_seconds(void) {
-    return (float)GetTime();  // Raylib's GetTime()
+    // Monotonic clock rather than raylib's GetTime, which needs a window
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (float)ts.tv_sec + (float)ts.tv_nsec * 1e-9f;
+}
+
+static uint32_t get_time_ms(void) {
+    // Wraps every ~49 days; compare with signed differences
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u);
 }
 
 static void set_socket_nonblocking(int fd) {
@@ -65,6 +83,24 @@ static size_t build_packet_header(uint8_t* buf, NetPacketType type,
     return NET_HEADER_SIZE;
 }
 
+/**
+ * Validate a datagram (one whole packet) and locate its payload
+ */
+static bool parse_datagram(const uint8_t* buf, size_t size, uint8_t* type, uint32_t* sequence,
+                           const uint8_t** payload, size_t* payload_size) {
+    if (size < NET_HEADER_SIZE) return false;
+    const uint8_t* p = buf;
+    if (ser_read_u32(&p) != NET_PROTOCOL_MAGIC) return false;
+    if (ser_read_u8(&p) != NET_PROTOCOL_VERSION) return false;
+    *type = ser_read_u8(&p);
+    uint16_t declared = ser_read_u16(&p);
+    *sequence = ser_read_u32(&p);
+    if (declared != size - NET_HEADER_SIZE) return false;
+    *payload = buf + NET_HEADER_SIZE;
+    *payload_size = declared;
+    return true;
+}
+
 static size_t build_player_state(uint8_t* buf, const NetPlayerState* state) {
     uint8_t* p = buf;
     ser_write_u8(&p, state->client_id);
@@ -97,32 +133,905 @@ static size_t parse_player_state(const uint8_t* buf, NetPlayerState* state) {
     return p - buf;
 }
 
-static size_t build_block_change(uint8_t* buf, const NetBlockChange* change) {
+// ============================================================================
+// BLOCK CHANGE BATCHES
+// ============================================================================
+
+#define BLOCK_CHANGES_PAYLOAD_MAX (NET_MAX_PACKET_SIZE - NET_HEADER_SIZE)
+
+static int block_chunk_coord(int32_t coord) {
+    return (int)floorf((float)coord / CHUNK_SIZE);
+}
+
+static uint32_t block_batch_hash(int32_t x, int32_t y, int32_t z) {
+    uint32_t h = (uint32_t)x * 73856093u ^ (uint32_t)y * 19349663u ^ (uint32_t)z * 83492791u;
+    return h & (NET_BLOCK_BATCH_SLOTS - 1);
+}
+
+/**
+ * Add a change to a batch, replacing an earlier change to the same block
+ * Returns false if the batch is full (flush it and add again)
+ */
+static bool block_batch_add(NetBlockBatch* batch, const NetBlockChange* change) {
+    uint32_t slot = block_batch_hash(change->x, change->y, change->z);
+    while (batch->slots[slot] != 0) {
+        NetBlockChange* queued = &batch->changes[batch->slots[slot] - 1];
+        if (queued->x == change->x && queued->y == change->y && queued->z == change->z) {
+            *queued = *change;
+            return true;
+        }
+        slot = (slot + 1) & (NET_BLOCK_BATCH_SLOTS - 1);
+    }
+    if (batch->count >= NET_BLOCK_BATCH_MAX) return false;
+
+    batch->changes[batch->count] = *change;
+    batch->slots[slot] = (uint16_t)(++batch->count);
+    return true;
+}
+
+static void block_batch_reset(NetBlockBatch* batch) {
+    if (batch->count == 0) return;
+    batch->count = 0;
+    memset(batch->slots, 0, sizeof(batch->slots));
+}
+
+static int compare_block_chunks(const void* a, const void* b) {
+    const NetBlockChange* ca = (const NetBlockChange*)a;
+    const NetBlockChange* cb = (const NetBlockChange*)b;
+    int ax = block_chunk_coord(ca->x), bx = block_chunk_coord(cb->x);
+    if (ax != bx) return ax < bx ? -1 : 1;
+    int az = block_chunk_coord(ca->z), bz = block_chunk_coord(cb->z);
+    return az < bz ? -1 : (az > bz ? 1 : 0);
+}
+
+/**
+ * Sort a batch by chunk so each chunk's changes are one group
+ * The position table no longer matches afterwards: reset the batch once sent.
+ */
+static void block_batch_sort(NetBlockBatch* batch) {
+    qsort(batch->changes, batch->count, sizeof(NetBlockChange), compare_block_chunks);
+}
+
+/**
+ * End of the group starting at index start of a sorted batch
+ */
+static int block_batch_group_end(const NetBlockBatch* batch, int start) {
+    int chunk_x = block_chunk_coord(batch->changes[start].x);
+    int chunk_z = block_chunk_coord(batch->changes[start].z);
+    int end = start + 1;
+    while (end < batch->count && block_chunk_coord(batch->changes[end].x) == chunk_x &&
+           block_chunk_coord(batch->changes[end].z) == chunk_z) {
+        end++;
+    }
+    return end;
+}
+
+/**
+ * Write changes [start, end) of one chunk as a BLOCK_CHANGES group
+ */
+static size_t build_block_group(uint8_t* buf, const NetBlockBatch* batch, int start, int end) {
+    uint8_t* p = buf;
+    int chunk_x = block_chunk_coord(batch->changes[start].x);
+    int chunk_z = block_chunk_coord(batch->changes[start].z);
+    ser_write_i32(&p, chunk_x);
+    ser_write_i32(&p, chunk_z);
+    ser_write_u16(&p, (uint16_t)(end - start));
+    for (int i = start; i < end; i++) {
+        const NetBlockChange* change = &batch->changes[i];
+        int local_x = change->x - chunk_x * CHUNK_SIZE;
+        int local_z = change->z - chunk_z * CHUNK_SIZE;
+        ser_write_u16(&p, (uint16_t)(change->y << 8 | local_z << 4 | local_x));
+        ser_write_u8(&p, change->block_type);
+        ser_write_u8(&p, change->metadata);
+    }
+    return p - buf;
+}
+
+/**
+ * Cursor over the changes of a BLOCK_CHANGES payload
+ */
+typedef struct {
+    const uint8_t* p;
+    const uint8_t* end;
+    uint16_t groups_left;
+    uint16_t changes_left;          // In the current group
+    int32_t chunk_x, chunk_z;
+} BlockChangeReader;
+
+static void block_reader_init(BlockChangeReader* reader, const uint8_t* data, size_t size) {
+    reader->p = data;
+    reader->end = data + size;
+    reader->groups_left = size >= 2 ? ser_read_u16(&reader->p) : 0;
+    reader->changes_left = 0;
+}
+
+/**
+ * Read the next change; returns false at the end or at malformed data
+ */
+static bool block_reader_next(BlockChangeReader* reader, NetBlockChange* change) {
+    while (reader->changes_left == 0) {
+        if (reader->groups_left == 0 || reader->end - reader->p < NET_BLOCK_GROUP_HEADER) return false;
+        reader->groups_left--;
+        reader->chunk_x = ser_read_i32(&reader->p);
+        reader->chunk_z = ser_read_i32(&reader->p);
+        reader->changes_left = ser_read_u16(&reader->p);
+        if ((size_t)(reader->end - reader->p) < (size_t)reader->changes_left * NET_BLOCK_ENTRY_SIZE) {
+            return false;
+        }
+    }
+
+    reader->changes_left--;
+    uint16_t packed = ser_read_u16(&reader->p);
+    change->x = reader->chunk_x * CHUNK_SIZE + (packed & 0x0F);
+    change->y = packed >> 8;
+    change->z = reader->chunk_z * CHUNK_SIZE + ((packed >> 4) & 0x0F);
+    change->block_type = ser_read_u8(&reader->p);
+    change->metadata = ser_read_u8(&reader->p);
+    change->client_id = 0;
+    return true;
+}
+
+// ============================================================================
+// INVENTORY SYNC
+// ============================================================================
+
+#define INVENTORY_ALL_SLOTS ((1ull << NET_INVENTORY_SLOT_COUNT) - 1)
+#define INVENTORY_ENTRY_MIN 3           // Slot, type, count
+#define INVENTORY_DURABILITY_SIZE 4
+#define INVENTORY_CHEST_HEADER 14       // Kind, position, entry count
+
+_Static_assert(ITEM_COUNT <= 256, "item types are sent as a byte");
+_Static_assert(NET_INVENTORY_SLOT_COUNT <= 64 && NET_INVENTORY_SLOT_COUNT < NET_ITEM_DELTA_DURABILITY,
+               "slots are a 64-bit mask and share a byte with the durability flag");
+
+/**
+ * Synchronized slot: global inventory slots, then the held stack
+ */
+static ItemStack* sync_slot(Inventory* inv, int slot) {
+    return slot == NET_INVENTORY_HELD_SLOT ? &inv->held_item : inventory_get_slot(inv, slot);
+}
+
+static void sync_set_slot(Inventory* inv, int slot, const ItemStack* stack) {
+    *sync_slot(inv, slot) = *stack;
+    if (slot == NET_INVENTORY_HELD_SLOT) inv->is_holding_item = stack->type != ITEM_NONE;
+}
+
+static bool stack_equal(const ItemStack* a, const ItemStack* b) {
+    return a->type == b->type && a->count == b->count && a->durability == b->durability &&
+           a->max_durability == b->max_durability;
+}
+
+/**
+ * A stack a client may hold: known item, count within its stack size,
+ * durability within its maximum
+ */
+static bool stack_valid(const ItemStack* stack) {
+    if (stack->type == ITEM_NONE) return stack->count == 0;
+    if (stack->type >= ITEM_COUNT) return false;
+    const ItemProperties* props = item_get_properties(stack->type);
+    return stack->count > 0 && stack->count <= props->max_stack_size &&
+           stack->durability <= stack->max_durability;
+}
+
+static size_t build_slot_entry(uint8_t* buf, int slot, const ItemStack* stack) {
+    uint8_t* p = buf;
+    bool durability = stack->durability != 0 || stack->max_durability != 0;
+    ser_write_u8(&p, (uint8_t)slot | (durability ? NET_ITEM_DELTA_DURABILITY : 0));
+    ser_write_u8(&p, (uint8_t)stack->type);
+    ser_write_u8(&p, stack->count);
+    if (durability) {
+        ser_write_u16(&p, stack->durability);
+        ser_write_u16(&p, stack->max_durability);
+    }
+    return p - buf;
+}
+
+/**
+ * Read one slot entry; returns false at truncated data
+ */
+static bool parse_slot_entry(const uint8_t** p, const uint8_t* end, int* slot, ItemStack* stack) {
+    if (end - *p < INVENTORY_ENTRY_MIN) return false;
+    uint8_t slot_byte = ser_read_u8(p);
+    *slot = slot_byte & ~NET_ITEM_DELTA_DURABILITY;
+    stack->type = (ItemType)ser_read_u8(p);
+    stack->count = ser_read_u8(p);
+    stack->durability = 0;
+    stack->max_durability = 0;
+    if (slot_byte & NET_ITEM_DELTA_DURABILITY) {
+        if (end - *p < INVENTORY_DURABILITY_SIZE) return false;
+        stack->durability = ser_read_u16(p);
+        stack->max_durability = ser_read_u16(p);
+    }
+    return true;
+}
+
+static uint32_t hash_stack(uint32_t hash, const ItemStack* stack) {
+    uint32_t fields[4] = {(uint32_t)stack->type, stack->count, stack->durability, stack->max_durability};
+    for (int i = 0; i < 4; i++) {
+        hash = (hash ^ fields[i]) * 16777619u;  // FNV-1a
+    }
+    return hash;
+}
+
+/**
+ * Hash of the synchronized slots (the crafting output follows from the grid)
+ */
+static uint32_t inventory_sync_hash(Inventory* inv) {
+    uint32_t hash = 2166136261u;
+    for (int slot = 0; slot < NET_INVENTORY_SLOT_COUNT; slot++) {
+        if (slot != INVENTORY_SLOT_CRAFTING_OUTPUT) hash = hash_stack(hash, sync_slot(inv, slot));
+    }
+    return hash;
+}
+
+static uint32_t chest_sync_hash(const ChestData* chest) {
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < CHEST_SLOTS; i++) {
+        hash = hash_stack(hash, &chest->slots[i]);
+    }
+    return hash;
+}
+
+/**
+ * Write a CHEST record of the slots that differ from before (NULL: all slots)
+ * Returns 0 if no slot changed
+ */
+static size_t build_chest_record(uint8_t* buf, const ChestData* chest, const ItemStack* before) {
     uint8_t* p = buf;
-    ser_write_i32(&p, change->x);
-    ser_write_i32(&p, change->y);
-    ser_write_i32(&p, change->z);
-    ser_write_u8(&p, change->block_type);
-    ser_write_u8(&p, change->metadata);
-    ser_write_u8(&p, change->client_id);
+    ser_write_u8(&p, NET_INVENTORY_CHEST);
+    ser_write_i32(&p, chest->x);
+    ser_write_i32(&p, chest->y);
+    ser_write_i32(&p, chest->z);
+    uint8_t* count_at = p;
+    ser_write_u8(&p, 0);
+
+    uint8_t count = 0;
+    for (int i = 0; i < CHEST_SLOTS; i++) {
+        if (before && stack_equal(&before[i], &chest->slots[i])) continue;
+        p += build_slot_entry(p, i, &chest->slots[i]);
+        count++;
+    }
+    if (count == 0 && before) return 0;
+    ser_write_u8(&count_at, count);
     return p - buf;
 }
 
-static size_t parse_block_change(const uint8_t* buf, NetBlockChange* change) {
+/**
+ * Chest at a world position in a loaded chunk (open: create it with its loot)
+ */
+static ChestData* find_chest(World* world, int32_t x, int32_t y, int32_t z, bool open) {
+    if (!world || y < 0 || y >= CHUNK_HEIGHT) return NULL;
+    Chunk* chunk = world_get_chunk(world, block_chunk_coord(x), block_chunk_coord(z));
+    if (!chunk) return NULL;
+    if (!open) return chest_get(chunk, x, y, z);
+    if (world_get_block(world, x, y, z).type != BLOCK_CHEST) return NULL;
+    return chest_open(chunk, x, y, z);
+}
+
+/**
+ * Whether writing stacks to slots only moves, splits or uses up what inv
+ * holds there: no item type gains count, durability or max durability
+ */
+static bool slot_writes_conserve(Inventory* inv, const int* slots, const ItemStack* stacks, int count) {
+    int delta[ITEM_COUNT][3];
+    memset(delta, 0, sizeof(delta));
+    for (int i = 0; i < count; i++) {
+        const ItemStack* old = sync_slot(inv, slots[i]);
+        delta[old->type][0] -= old->count;
+        delta[old->type][1] -= old->durability;
+        delta[old->type][2] -= old->max_durability;
+        delta[stacks[i].type][0] += stacks[i].count;
+        delta[stacks[i].type][1] += stacks[i].durability;
+        delta[stacks[i].type][2] += stacks[i].max_durability;
+    }
+    for (int type = ITEM_NONE + 1; type < ITEM_COUNT; type++) {
+        if (delta[type][0] > 0 || delta[type][1] > 0 || delta[type][2] > 0) return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// PLAYER STATE SNAPSHOTS
+// ============================================================================
+
+#define QUANT_POS_SCALE   256.0f    // Horizontal steps per block
+#define QUANT_Y_SCALE     128.0f    // Vertical steps per block
+#define QUANT_Y_OFFSET    64.0f     // Lowest height that is not clamped
+#define QUANT_VEL_SCALE   256.0f    // Steps per block per second
+#define QUANT_ANGLE_SCALE (65536.0f / 360.0f)
+
+static int32_t quantize_clamped(float value, float scale, int32_t min, int32_t max) {
+    int32_t q = (int32_t)lroundf(value * scale);
+    return q < min ? min : (q > max ? max : q);
+}
+
+static uint16_t quantize_angle(float degrees) {
+    return (uint16_t)((uint32_t)lroundf(fmodf(degrees, 360.0f) * QUANT_ANGLE_SCALE) & 0xFFFF);
+}
+
+static void quantize_player_state(const NetPlayerState* state, NetQuantState* q) {
+    q->chunk_x = (int32_t)floorf(state->pos_x / CHUNK_SIZE);
+    q->chunk_z = (int32_t)floorf(state->pos_z / CHUNK_SIZE);
+    q->pos[0] = (uint16_t)quantize_clamped(state->pos_x - q->chunk_x * CHUNK_SIZE, QUANT_POS_SCALE,
+                                           0, CHUNK_SIZE * (int32_t)QUANT_POS_SCALE - 1);
+    q->pos[1] = (uint16_t)quantize_clamped(state->pos_y + QUANT_Y_OFFSET, QUANT_Y_SCALE, 0, UINT16_MAX);
+    q->pos[2] = (uint16_t)quantize_clamped(state->pos_z - q->chunk_z * CHUNK_SIZE, QUANT_POS_SCALE,
+                                           0, CHUNK_SIZE * (int32_t)QUANT_POS_SCALE - 1);
+    q->vel[0] = (int16_t)quantize_clamped(state->vel_x, QUANT_VEL_SCALE, INT16_MIN, INT16_MAX);
+    q->vel[1] = (int16_t)quantize_clamped(state->vel_y, QUANT_VEL_SCALE, INT16_MIN, INT16_MAX);
+    q->vel[2] = (int16_t)quantize_clamped(state->vel_z, QUANT_VEL_SCALE, INT16_MIN, INT16_MAX);
+    q->yaw = quantize_angle(state->yaw);
+    q->pitch = quantize_angle(state->pitch);
+    q->flags = state->flags;
+    q->selected_slot = state->selected_slot;
+}
+
+static void dequantize_player_state(const NetQuantState* q, uint8_t client_id, NetPlayerState* state) {
+    state->client_id = client_id;
+    state->pos_x = q->chunk_x * CHUNK_SIZE + q->pos[0] / QUANT_POS_SCALE;
+    state->pos_y = q->pos[1] / QUANT_Y_SCALE - QUANT_Y_OFFSET;
+    state->pos_z = q->chunk_z * CHUNK_SIZE + q->pos[2] / QUANT_POS_SCALE;
+    state->vel_x = q->vel[0] / QUANT_VEL_SCALE;
+    state->vel_y = q->vel[1] / QUANT_VEL_SCALE;
+    state->vel_z = q->vel[2] / QUANT_VEL_SCALE;
+    state->yaw = q->yaw / QUANT_ANGLE_SCALE;                    // [0, 360)
+    state->pitch = (int16_t)q->pitch / QUANT_ANGLE_SCALE;       // [-180, 180)
+    state->flags = q->flags;
+    state->selected_slot = q->selected_slot;
+}
+
+static bool snapshot_is_active(const NetSnapshot* snapshot, int client_id) {
+    return (snapshot->active[client_id / 8] >> (client_id % 8)) & 1;
+}
+
+/**
+ * Fields of q that differ from base
+ */
+static uint16_t quant_changed_fields(const NetQuantState* base, const NetQuantState* q) {
+    uint16_t fields = 0;
+    if (q->chunk_x != base->chunk_x || q->chunk_z != base->chunk_z) fields |= NET_QUANT_CHUNK;
+    if (q->pos[0] != base->pos[0]) fields |= NET_QUANT_POS_X;
+    if (q->pos[1] != base->pos[1]) fields |= NET_QUANT_POS_Y;
+    if (q->pos[2] != base->pos[2]) fields |= NET_QUANT_POS_Z;
+    if (q->vel[0] != base->vel[0]) fields |= NET_QUANT_VEL_X;
+    if (q->vel[1] != base->vel[1]) fields |= NET_QUANT_VEL_Y;
+    if (q->vel[2] != base->vel[2]) fields |= NET_QUANT_VEL_Z;
+    if (q->yaw != base->yaw) fields |= NET_QUANT_YAW;
+    if (q->pitch != base->pitch) fields |= NET_QUANT_PITCH;
+    if (q->flags != base->flags) fields |= NET_QUANT_FLAGS;
+    if (q->selected_slot != base->selected_slot) fields |= NET_QUANT_SLOT;
+    return fields;
+}
+
+/**
+ * Bytes the given fields take in a snapshot entry
+ */
+static size_t quant_fields_size(uint16_t fields) {
+    size_t size = 0;
+    if (fields & NET_QUANT_CHUNK) size += 8;
+    for (uint16_t bit = NET_QUANT_POS_X; bit <= NET_QUANT_PITCH; bit <<= 1) {
+        if (fields & bit) size += 2;
+    }
+    if (fields & NET_QUANT_FLAGS) size += 1;
+    if (fields & NET_QUANT_SLOT) size += 1;
+    return size;
+}
+
+#define SNAPSHOT_ENTRY_MAX (3 + 8 + 8 * 2 + 2)
+#define SNAPSHOT_PACKET_MAX (10 + NET_SNAPSHOT_MASK_BYTES + NET_MAX_CLIENTS * SNAPSHOT_ENTRY_MAX)
+
+/**
+ * Write snapshot as a delta against base (NULL = against nothing)
+ * The recipient's own state is left out.
+ */
+static size_t build_snapshot_delta(uint8_t* buf, const NetSnapshot* snapshot,
+                                   const NetSnapshot* base, int recipient) {
+    static const NetQuantState zero_state;
+    uint8_t* p = buf;
+    ser_write_u16(&p, snapshot->id);
+    ser_write_u16(&p, base ? base->id : 0);
+    ser_write_u8(&p, base ? 1 : 0);
+    ser_write_u32(&p, snapshot->time_ms);
+    for (int b = 0; b < NET_SNAPSHOT_MASK_BYTES; b++) {
+        uint8_t mask = snapshot->active[b];
+        if (recipient / 8 == b) mask &= (uint8_t)~(1u << (recipient % 8));
+        ser_write_u8(&p, mask);
+    }
+
+    uint8_t* count_at = p;
+    ser_write_u8(&p, 0);
+    uint8_t count = 0;
+
+    for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+        if (i == recipient || !snapshot_is_active(snapshot, i)) continue;
+        const NetQuantState* from = base && snapshot_is_active(base, i) ? &base->states[i] : &zero_state;
+        const NetQuantState* q = &snapshot->states[i];
+        uint16_t fields = quant_changed_fields(from, q);
+        if (fields == 0) continue;
+
+        ser_write_u8(&p, (uint8_t)i);
+        ser_write_u16(&p, fields);
+        if (fields & NET_QUANT_CHUNK) {
+            ser_write_i32(&p, q->chunk_x);
+            ser_write_i32(&p, q->chunk_z);
+        }
+        if (fields & NET_QUANT_POS_X) ser_write_u16(&p, q->pos[0]);
+        if (fields & NET_QUANT_POS_Y) ser_write_u16(&p, q->pos[1]);
+        if (fields & NET_QUANT_POS_Z) ser_write_u16(&p, q->pos[2]);
+        if (fields & NET_QUANT_VEL_X) ser_write_u16(&p, (uint16_t)q->vel[0]);
+        if (fields & NET_QUANT_VEL_Y) ser_write_u16(&p, (uint16_t)q->vel[1]);
+        if (fields & NET_QUANT_VEL_Z) ser_write_u16(&p, (uint16_t)q->vel[2]);
+        if (fields & NET_QUANT_YAW) ser_write_u16(&p, q->yaw);
+        if (fields & NET_QUANT_PITCH) ser_write_u16(&p, q->pitch);
+        if (fields & NET_QUANT_FLAGS) ser_write_u8(&p, q->flags);
+        if (fields & NET_QUANT_SLOT) ser_write_u8(&p, q->selected_slot);
+        count++;
+    }
+    *count_at = count;
+    return p - buf;
+}
+
+/**
+ * Rebuild a snapshot from its delta and the received history
+ * Returns false if the data is malformed or the baseline is not known
+ */
+static bool parse_snapshot_delta(const uint8_t* data, size_t size,
+                                 const NetSnapshot* history, NetSnapshot* snapshot) {
+    static const NetQuantState zero_state;
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    if (size < 10 + NET_SNAPSHOT_MASK_BYTES) return false;
+
+    snapshot->id = ser_read_u16(&p);
+    uint16_t base_id = ser_read_u16(&p);
+    const NetSnapshot* base = NULL;
+    if (ser_read_u8(&p)) {
+        base = &history[base_id % NET_SNAPSHOT_HISTORY];
+        if (!base->valid || base->id != base_id) return false;
+    }
+    snapshot->time_ms = ser_read_u32(&p);
+    for (int b = 0; b < NET_SNAPSHOT_MASK_BYTES; b++) {
+        snapshot->active[b] = ser_read_u8(&p);
+    }
+    for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+        bool known = base && snapshot_is_active(base, i);
+        snapshot->states[i] = known ? base->states[i] : zero_state;
+    }
+
+    uint8_t count = ser_read_u8(&p);
+    for (int e = 0; e < count; e++) {
+        if (end - p < 3) return false;
+        uint8_t client_id = ser_read_u8(&p);
+        uint16_t fields = ser_read_u16(&p);
+        if (client_id >= NET_MAX_CLIENTS || (size_t)(end - p) < quant_fields_size(fields)) return false;
+
+        NetQuantState* q = &snapshot->states[client_id];
+        if (fields & NET_QUANT_CHUNK) {
+            q->chunk_x = ser_read_i32(&p);
+            q->chunk_z = ser_read_i32(&p);
+        }
+        if (fields & NET_QUANT_POS_X) q->pos[0] = ser_read_u16(&p);
+        if (fields & NET_QUANT_POS_Y) q->pos[1] = ser_read_u16(&p);
+        if (fields & NET_QUANT_POS_Z) q->pos[2] = ser_read_u16(&p);
+        if (fields & NET_QUANT_VEL_X) q->vel[0] = (int16_t)ser_read_u16(&p);
+        if (fields & NET_QUANT_VEL_Y) q->vel[1] = (int16_t)ser_read_u16(&p);
+        if (fields & NET_QUANT_VEL_Z) q->vel[2] = (int16_t)ser_read_u16(&p);
+        if (fields & NET_QUANT_YAW) q->yaw = ser_read_u16(&p);
+        if (fields & NET_QUANT_PITCH) q->pitch = ser_read_u16(&p);
+        if (fields & NET_QUANT_FLAGS) q->flags = ser_read_u8(&p);
+        if (fields & NET_QUANT_SLOT) q->selected_slot = ser_read_u8(&p);
+    }
+    snapshot->valid = true;
+    return true;
+}
+
+// ============================================================================
+// REMOTE PLAYER INTERPOLATION
+// ============================================================================
+
+static void interp_track_reset(NetInterpTrack* track) {
+    track->head = 0;
+    track->count = 0;
+}
+
+/**
+ * Add a state received at time_ms (local clock)
+ * A state not newer than the newest one replaces it, keeping times ordered.
+ */
+static void interp_track_push(NetInterpTrack* track, uint32_t time_ms, const NetPlayerState* state) {
+    if (track->count > 0 && (int32_t)(time_ms - track->samples[track->head].time_ms) <= 0) {
+        track->samples[track->head].state = *state;
+        return;
+    }
+    track->head = (track->head + 1) % NET_INTERP_SAMPLES;
+    if (track->count < NET_INTERP_SAMPLES) track->count++;
+    track->samples[track->head].time_ms = time_ms;
+    track->samples[track->head].state = *state;
+}
+
+static float lerp_angle(float from, float to, float t) {
+    float diff = fmodf(to - from + 540.0f, 360.0f) - 180.0f;
+    return from + diff * t;
+}
+
+/**
+ * Position and yaw of a remote player at time_ms (local clock)
+ * Between two states the player is interpolated; past the newest one it is
+ * extrapolated along its velocity for up to NET_EXTRAPOLATE_MAX_MS, then held.
+ * Returns false if the track is empty
+ */
+static bool interp_track_sample(const NetInterpTrack* track, uint32_t time_ms,
+                                Vector3* pos, float* yaw) {
+    if (track->count == 0) return false;
+
+    const NetInterpSample* newer = &track->samples[track->head];
+    int32_t ahead = (int32_t)(time_ms - newer->time_ms);
+    if (ahead >= 0) {
+        const NetPlayerState* s = &newer->state;
+        float t = (float)(ahead < NET_EXTRAPOLATE_MAX_MS ? ahead : NET_EXTRAPOLATE_MAX_MS) * 0.001f;
+        *pos = (Vector3){s->pos_x + s->vel_x * t, s->pos_y + s->vel_y * t, s->pos_z + s->vel_z * t};
+        *yaw = s->yaw;
+        return true;
+    }
+
+    // Walk back to the pair of states around time_ms
+    for (int k = 1; k < track->count; k++) {
+        const NetInterpSample* older =
+            &track->samples[(track->head - k + NET_INTERP_SAMPLES) % NET_INTERP_SAMPLES];
+        int32_t since = (int32_t)(time_ms - older->time_ms);
+        if (since >= 0) {
+            int32_t span = (int32_t)(newer->time_ms - older->time_ms);
+            float t = span > 0 ? (float)since / (float)span : 1.0f;
+            const NetPlayerState* a = &older->state;
+            const NetPlayerState* b = &newer->state;
+            *pos = (Vector3){a->pos_x + (b->pos_x - a->pos_x) * t,
+                             a->pos_y + (b->pos_y - a->pos_y) * t,
+                             a->pos_z + (b->pos_z - a->pos_z) * t};
+            *yaw = lerp_angle(a->yaw, b->yaw, t);
+            return true;
+        }
+        newer = older;
+    }
+
+    // Older than everything kept: hold the oldest state
+    *pos = (Vector3){newer->state.pos_x, newer->state.pos_y, newer->state.pos_z};
+    *yaw = newer->state.yaw;
+    return true;
+}
+
+// ============================================================================
+// ENTITY REPLICATION
+// ============================================================================
+
+#define ENTITY_HIT_REACH    8.0f    // Farthest a client's hit on a host entity reaches
+#define ENTITY_DROP_STACKS  2       // Most item stacks an animal drops
+
+_Static_assert(PIG_DROP_STACKS <= ENTITY_DROP_STACKS && SHEEP_DROP_STACKS <= ENTITY_DROP_STACKS,
+               "animal drops fit the host's drop buffer");
+#define ENTITY_HIT_QUERY    64      // Entities looked at around a hit
+
+/**
+ * Entity types the host simulates and clients copy
+ */
+static bool entity_is_replicated(EntityType type) {
+    return type == ENTITY_TYPE_PIG || type == ENTITY_TYPE_SHEEP;
+}
+
+/**
+ * Replicated animation state and appearance of a host animal
+ */
+static void entity_read_replicated(const Entity* entity, NetEntityState* state) {
+    state->flags = 0;
+    state->hp = 0;
+    state->color = (Color){255, 255, 255, 255};
+    if (entity->type == ENTITY_TYPE_PIG) {
+        const PigData* data = (const PigData*)entity->data;
+        if (data->is_fleeing) state->flags |= NET_ENTITY_FLAG_FLEEING;
+        if (data->is_idle) state->flags |= NET_ENTITY_FLAG_RESTING;
+        if (data->damage_flash_timer > 0) state->flags |= NET_ENTITY_FLAG_HURT;
+        state->hp = (uint8_t)(data->hp > 0 ? data->hp : 0);
+        state->color = data->body_color;
+    } else if (entity->type == ENTITY_TYPE_SHEEP) {
+        const SheepData* data = (const SheepData*)entity->data;
+        if (data->is_fleeing) state->flags |= NET_ENTITY_FLAG_FLEEING;
+        if (data->is_grazing) state->flags |= NET_ENTITY_FLAG_RESTING;
+        if (data->damage_flash_timer > 0) state->flags |= NET_ENTITY_FLAG_HURT;
+        state->hp = (uint8_t)(data->hp > 0 ? data->hp : 0);
+        state->color = data->wool_color;
+    }
+}
+
+/**
+ * Apply received animation state to a client's copy
+ */
+static void entity_apply_replicated(Entity* entity, const NetEntityState* state) {
+    bool hurt = (state->flags & NET_ENTITY_FLAG_HURT) != 0;
+    if (entity->type == ENTITY_TYPE_PIG) {
+        PigData* data = (PigData*)entity->data;
+        data->is_fleeing = (state->flags & NET_ENTITY_FLAG_FLEEING) != 0;
+        data->is_idle = (state->flags & NET_ENTITY_FLAG_RESTING) != 0;
+        data->hp = state->hp;
+        if (hurt) data->damage_flash_timer = fmaxf(data->damage_flash_timer, 0.1f);
+    } else if (entity->type == ENTITY_TYPE_SHEEP) {
+        SheepData* data = (SheepData*)entity->data;
+        data->is_fleeing = (state->flags & NET_ENTITY_FLAG_FLEEING) != 0;
+        data->is_grazing = (state->flags & NET_ENTITY_FLAG_RESTING) != 0;
+        data->hp = state->hp;
+        if (hurt) data->damage_flash_timer = fmaxf(data->damage_flash_timer, 0.1f);
+    }
+}
+
+static size_t build_entity_state(uint8_t* buf, const NetEntityState* state) {
+    uint8_t* p = buf;
+    ser_write_u32(&p, state->id);
+    ser_write_u8(&p, state->type);
+    ser_write_u8(&p, state->flags);
+    ser_write_i32(&p, state->pos_x);
+    ser_write_i32(&p, state->pos_z);
+    ser_write_u16(&p, state->pos_y);
+    ser_write_u16(&p, state->yaw);
+    ser_write_u8(&p, state->hp);
+    if (state->flags & NET_ENTITY_FLAG_SPAWN) {
+        ser_write_u8(&p, state->color.r);
+        ser_write_u8(&p, state->color.g);
+        ser_write_u8(&p, state->color.b);
+    }
+    return p - buf;
+}
+
+/**
+ * Read one entity state; returns 0 if fewer than its bytes remain
+ */
+static size_t parse_entity_state(const uint8_t* buf, size_t size, NetEntityState* state) {
     const uint8_t* p = buf;
-    change->x = ser_read_i32(&p);
-    change->y = ser_read_i32(&p);
-    change->z = ser_read_i32(&p);
-    change->block_type = ser_read_u8(&p);
-    change->metadata = ser_read_u8(&p);
-    change->client_id = ser_read_u8(&p);
+    if (size < NET_ENTITY_STATE_SIZE) return 0;
+    state->id = ser_read_u32(&p);
+    state->type = ser_read_u8(&p);
+    state->flags = ser_read_u8(&p);
+    state->pos_x = ser_read_i32(&p);
+    state->pos_z = ser_read_i32(&p);
+    state->pos_y = ser_read_u16(&p);
+    state->yaw = ser_read_u16(&p);
+    state->hp = ser_read_u8(&p);
+    state->color = (Color){255, 255, 255, 255};
+    if (state->flags & NET_ENTITY_FLAG_SPAWN) {
+        if (size < NET_ENTITY_STATE_SIZE + 3) return 0;
+        state->color.r = ser_read_u8(&p);
+        state->color.g = ser_read_u8(&p);
+        state->color.b = ser_read_u8(&p);
+    }
     return p - buf;
 }
 
+static int compare_entity_ids(const void* a, const void* b) {
+    EntityId ia = (*(Entity* const*)a)->id;
+    EntityId ib = (*(Entity* const*)b)->id;
+    return ia < ib ? -1 : (ia > ib ? 1 : 0);
+}
+
+// ============================================================================
+// BYTE RINGS
+// ============================================================================
+
+/**
+ * Allocate a ring (capacity must be a power of two)
+ */
+static bool ring_init(NetRing* ring, size_t capacity) {
+    ring->data = (uint8_t*)malloc(capacity);
+    ring->capacity = ring->data ? capacity : 0;
+    ring->head = ring->tail = 0;
+    return ring->data != NULL;
+}
+
+static void ring_free(NetRing* ring) {
+    free(ring->data);
+    memset(ring, 0, sizeof(NetRing));
+}
+
+static size_t ring_used(const NetRing* ring) {
+    return ring->tail - ring->head;
+}
+
+/**
+ * Free space as up to two segments, for readv
+ */
+static int ring_free_iov(const NetRing* ring, struct iovec iov[2]) {
+    size_t space = ring->capacity - ring_used(ring);
+    if (space == 0) return 0;
+    size_t start = ring->tail & (ring->capacity - 1);
+    size_t first = ring->capacity - start < space ? ring->capacity - start : space;
+    iov[0].iov_base = ring->data + start;
+    iov[0].iov_len = first;
+    if (first == space) return 1;
+    iov[1].iov_base = ring->data;
+    iov[1].iov_len = space - first;
+    return 2;
+}
+
+/**
+ * Copy size bytes starting offset bytes past the head
+ */
+static void ring_peek(const NetRing* ring, size_t offset, uint8_t* out, size_t size) {
+    size_t start = (ring->head + offset) & (ring->capacity - 1);
+    size_t first = ring->capacity - start < size ? ring->capacity - start : size;
+    memcpy(out, ring->data + start, first);
+    memcpy(out + first, ring->data, size - first);
+}
+
+// ============================================================================
+// PACKET BUFFERS
+// ============================================================================
+
+// Capacity (header included) of each size class: small control packets,
+// snapshots and block changes, full-size packets
+static const uint32_t packet_class_capacity[NET_PACKET_CLASSES] = {
+    512, 8192, NET_HEADER_SIZE + NET_MAX_PACKET_SIZE
+};
+
+#define SERVER_FLUSH_IOV 16     // Queued packets handed to one writev
+
+/**
+ * Take a buffer with room for payload_size bytes (refs = 1)
+ * Serialize into packet_payload, then packet_finish writes the header.
+ * Returns NULL if out of memory or larger than a packet can be
+ */
+static NetPacketBuf* packet_acquire(NetServer* server, size_t payload_size) {
+    size_t needed = NET_HEADER_SIZE + payload_size;
+    int size_class = 0;
+    while (size_class < NET_PACKET_CLASSES - 1 && packet_class_capacity[size_class] < needed) size_class++;
+    if (needed > packet_class_capacity[size_class]) return NULL;
+
+    NetPacketBuf* packet = server->packet_pool[size_class];
+    if (packet) {
+        server->packet_pool[size_class] = packet->next_free;
+        server->packet_pool_count[size_class]--;
+    } else {
+        packet = (NetPacketBuf*)malloc(sizeof(NetPacketBuf) + packet_class_capacity[size_class]);
+        if (!packet) return NULL;
+        packet->capacity = packet_class_capacity[size_class];
+        packet->size_class = (uint8_t)size_class;
+    }
+    packet->next_free = NULL;
+    packet->refs = 1;
+    packet->size = NET_HEADER_SIZE;
+    return packet;
+}
+
+static uint8_t* packet_payload(NetPacketBuf* packet) {
+    return packet->data + NET_HEADER_SIZE;
+}
+
+/**
+ * Write the header once payload_size bytes of payload are in place
+ */
+static void packet_finish(NetServer* server, NetPacketBuf* packet, NetPacketType type, size_t payload_size) {
+    build_packet_header(packet->data, type, (uint16_t)payload_size, server->next_sequence++);
+    packet->size = (uint32_t)(NET_HEADER_SIZE + payload_size);
+}
+
+static void packet_release(NetServer* server, NetPacketBuf* packet) {
+    if (--packet->refs > 0) return;
+    int size_class = packet->size_class;
+    if (server->packet_pool_count[size_class] >= NET_PACKET_POOL_KEEP) {
+        free(packet);
+        return;
+    }
+    packet->next_free = server->packet_pool[size_class];
+    server->packet_pool[size_class] = packet;
+    server->packet_pool_count[size_class]++;
+}
+
+static void packet_pool_free(NetServer* server) {
+    for (int c = 0; c < NET_PACKET_CLASSES; c++) {
+        while (server->packet_pool[c]) {
+            NetPacketBuf* next = server->packet_pool[c]->next_free;
+            free(server->packet_pool[c]);
+            server->packet_pool[c] = next;
+        }
+        server->packet_pool_count[c] = 0;
+    }
+}
+
+/**
+ * Queue a reference to the unsent part of a packet, doubling the queue when full
+ */
+static bool send_queue_push(NetClientSlot* client, NetPacketBuf* packet, uint32_t offset) {
+    if (client->send_queue_count == client->send_queue_capacity) {
+        int capacity = client->send_queue_capacity ? client->send_queue_capacity * 2 : NET_SEND_QUEUE_INITIAL;
+        NetSendEntry* grown = (NetSendEntry*)malloc((size_t)capacity * sizeof(NetSendEntry));
+        if (!grown) return false;
+        for (int k = 0; k < client->send_queue_count; k++) {
+            grown[k] = client->send_queue[(client->send_queue_head + k) & (client->send_queue_capacity - 1)];
+        }
+        free(client->send_queue);
+        client->send_queue = grown;
+        client->send_queue_capacity = capacity;
+        client->send_queue_head = 0;
+    }
+
+    int tail = (client->send_queue_head + client->send_queue_count) & (client->send_queue_capacity - 1);
+    client->send_queue[tail] = (NetSendEntry){packet, offset};
+    client->send_queue_count++;
+    client->send_queued += packet->size - offset;
+    packet->refs++;
+    return true;
+}
+
+/**
+ * Mark sent bytes off the front of the queue, releasing finished packets
+ */
+static void send_queue_consume(NetServer* server, NetClientSlot* client, size_t sent) {
+    client->send_queued -= sent;
+    while (sent > 0) {
+        NetSendEntry* entry = &client->send_queue[client->send_queue_head];
+        size_t rest = entry->packet->size - entry->offset;
+        if (sent < rest) {
+            entry->offset += (uint32_t)sent;
+            return;
+        }
+        sent -= rest;
+        packet_release(server, entry->packet);
+        client->send_queue_head = (client->send_queue_head + 1) & (client->send_queue_capacity - 1);
+        client->send_queue_count--;
+    }
+}
+
+static void send_queue_free(NetServer* server, NetClientSlot* client) {
+    for (int k = 0; k < client->send_queue_count; k++) {
+        packet_release(server, client->send_queue[(client->send_queue_head + k) & (client->send_queue_capacity - 1)].packet);
+    }
+    free(client->send_queue);
+    client->send_queue = NULL;
+    client->send_queue_capacity = 0;
+    client->send_queue_head = 0;
+    client->send_queue_count = 0;
+    client->send_queued = 0;
+}
+
 // ============================================================================
 // SERVER IMPLEMENTATION
 // ============================================================================
 
+#define SERVER_LISTEN_TAG UINT32_MAX    // epoll data of the listen socket
+#define SERVER_UDP_TAG (UINT32_MAX - 1) // epoll data of the UDP socket
+#define SERVER_UDP_BATCH 256            // Datagrams read per readiness event
+
+/**
+ * Connected client in a slot, or NULL
+ */
+static NetClientSlot* server_client(NetServer* server, int client_id) {
+    NetClientSlot* client = server->clients[client_id];
+    return client && client->connected ? client : NULL;
+}
+
+/**
+ * Remember a chest's slots before it changes (the changed ones go out with
+ * the next flush)
+ */
+static void server_mark_chest(NetServer* server, const ChestData* chest) {
+    NetChestBatch* batch = &server->chest_batch;
+    for (int i = 0; i < batch->count; i++) {
+        const NetChestChange* change = &batch->chests[i];
+        if (change->x == chest->x && change->y == chest->y && change->z == chest->z) return;
+    }
+    if (batch->count >= NET_CHEST_BATCH_MAX) net_server_flush_inventory(server);
+
+    NetChestChange* change = &batch->chests[batch->count++];
+    change->x = chest->x;
+    change->y = chest->y;
+    change->z = chest->z;
+    memcpy(change->before, chest->slots, sizeof(change->before));
+}
+
+/**
+ * The host player's chest moves change chests that clients may see
+ */
+static void server_inventory_action(void* user, Inventory* inv, const InventoryAction* action) {
+    (void)inv;
+    NetServer* server = (NetServer*)user;
+    if (action->chest && server->running) server_mark_chest(server, action->chest);
+}
+
 NetServer* net_server_create(uint16_t port, World* world, Player* host_player,
                               EntityManager* entities, float* time_of_day, float* day_speed) {
     NetServer* server = (NetServer*)calloc(1, sizeof(NetServer));
@@ -135,13 +1044,13 @@ NetServer* net_server_create(uint16_t port, World* world, Player* host_player,
     server->time_of_day = time_of_day;
     server->day_speed = day_speed;
     server->listen_socket = -1;
+    server->udp_socket = -1;
+    server->epoll_fd = -1;
     server->running = false;
 
-    // Initialize client slots
-    for (int i = 0; i < NET_MAX_CLIENTS; i++) {
-        server->clients[i].socket_fd = -1;
-        server->clients[i].client_id = i;
-        server->clients[i].connected = false;
+    // Chests the host player changes are sent to the clients
+    if (host_player && host_player->inventory) {
+        inventory_set_action_func(host_player->inventory, server_inventory_action, server);
     }
 
     printf("[NET_SERVER] Created on port %d\n", port);
@@ -152,6 +1061,11 @@ void net_server_destroy(NetServer* server) {
     if (!server) return;
 
     net_server_stop(server);
+    packet_pool_free(server);
+    if (server->host_player && server->host_player->inventory &&
+        server->host_player->inventory->action_user == server) {
+        inventory_set_action_func(server->host_player->inventory, NULL, NULL);
+    }
     free(server);
     printf("[NET_SERVER] Destroyed\n");
 }
@@ -184,52 +1098,148 @@ bool net_server_start(NetServer* server) {
     }
 
     // Listen
-    if (listen(server->listen_socket, 8) < 0) {
+    if (listen(server->listen_socket, NET_MAX_CLIENTS) < 0) {
         printf("[NET_SERVER] Failed to listen: %s\n", strerror(errno));
         close(server->listen_socket);
         server->listen_socket = -1;
         return false;
     }
 
+    // All sockets are watched by one epoll instance
+    server->epoll_fd = epoll_create1(0);
+    struct epoll_event event = {.events = EPOLLIN, .data.u32 = SERVER_LISTEN_TAG};
+    if (server->epoll_fd < 0 ||
+        epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, server->listen_socket, &event) < 0) {
+        printf("[NET_SERVER] Failed to set up epoll: %s\n", strerror(errno));
+        if (server->epoll_fd >= 0) close(server->epoll_fd);
+        server->epoll_fd = -1;
+        close(server->listen_socket);
+        server->listen_socket = -1;
+        return false;
+    }
+
+    // UDP channel on the same port; without it player states stay on TCP
+    server->udp_socket = socket(AF_INET, SOCK_DGRAM, 0);
+    struct epoll_event udp_event = {.events = EPOLLIN, .data.u32 = SERVER_UDP_TAG};
+    if (server->udp_socket < 0 ||
+        bind(server->udp_socket, (struct sockaddr*)&addr, sizeof(addr)) < 0 ||
+        epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, server->udp_socket, &udp_event) < 0) {
+        printf("[NET_SERVER] UDP unavailable (%s), player states use TCP\n", strerror(errno));
+        if (server->udp_socket >= 0) close(server->udp_socket);
+        server->udp_socket = -1;
+    } else {
+        set_socket_nonblocking(server->udp_socket);
+    }
+
     server->running = true;
     printf("[NET_SERVER] Started listening on port %d\n", server->port);
     return true;
 }
 
+/**
+ * Close a client connection
+ * The slot is freed by server_reap_clients, so callers may still look at it.
+ */
+static void server_drop_client(NetServer* server, int client_id) {
+    NetClientSlot* client = server->clients[client_id];
+    if (!client || !client->connected) return;
+
+    close(client->socket_fd);  // Also leaves the epoll set
+    client->socket_fd = -1;
+    client->connected = false;
+    if (client->authenticated) server->client_count--;
+}
+
+static void server_broadcast(NetServer* server, NetPacketType type,
+                              const void* payload, size_t payload_size, int exclude);
+
+/**
+ * Free the slots of dropped clients and tell the others they left
+ */
+static void server_reap_clients(NetServer* server) {
+    bool left[NET_MAX_CLIENTS] = {false};
+    for (int i = 1; i < NET_MAX_CLIENTS; i++) {
+        NetClientSlot* client = server->clients[i];
+        if (!client || client->connected) continue;
+        left[i] = client->authenticated;
+        world_remove_ticket(server->world, client->load_ticket);
+        ring_free(&client->recv_ring);
+        send_queue_free(server, client);
+        free(client->entity_view);
+        free(client);
+        server->clients[i] = NULL;
+    }
+
+    // Sent after freeing: clients dropped by these sends are reaped next poll
+    for (int i = 1; i < NET_MAX_CLIENTS; i++) {
+        if (!left[i]) continue;
+        uint8_t buf[2];
+        uint8_t* p = buf;
+        ser_write_u8(&p, (uint8_t)i);
+        ser_write_u8(&p, 0);  // reason: disconnect
+        server_broadcast(server, NET_PACKET_PLAYER_LEAVE, buf, p - buf, -1);
+    }
+}
+
 void net_server_stop(NetServer* server) {
     if (!server) return;
 
     // Disconnect all clients
-    for (int i = 0; i < NET_MAX_CLIENTS; i++) {
-        if (server->clients[i].connected && server->clients[i].socket_fd >= 0) {
-            close(server->clients[i].socket_fd);
-            server->clients[i].socket_fd = -1;
-            server->clients[i].connected = false;
-        }
+    for (int i = 1; i < NET_MAX_CLIENTS; i++) {
+        server_drop_client(server, i);
     }
+    server_reap_clients(server);
 
     // Close listen socket
     if (server->listen_socket >= 0) {
         close(server->listen_socket);
         server->listen_socket = -1;
     }
+    if (server->udp_socket >= 0) {
+        close(server->udp_socket);
+        server->udp_socket = -1;
+    }
+    if (server->epoll_fd >= 0) {
+        close(server->epoll_fd);
+        server->epoll_fd = -1;
+    }
 
     server->running = false;
     server->client_count = 0;
     printf("[NET_SERVER] Stopped\n");
 }
 
-static void server_accept_connection(NetServer* server) {
+/**
+ * Token a client proves its UDP address with (not secret against anyone
+ * who can read the TCP stream)
+ */
+static uint32_t make_udp_token(int slot) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint32_t h = (uint32_t)ts.tv_nsec ^ ((uint32_t)ts.tv_sec << 16) ^ ((uint32_t)slot * 2654435761u);
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    h *= 0x846ca68bu;
+    h ^= h >> 16;
+    return h;
+}
+
+/**
+ * Accept one pending connection
+ * Returns false once no connection is waiting
+ */
+static bool server_accept_connection(NetServer* server) {
     struct sockaddr_in client_addr;
     socklen_t addr_len = sizeof(client_addr);
 
     int client_fd = accept(server->listen_socket, (struct sockaddr*)&client_addr, &addr_len);
-    if (client_fd < 0) return;
+    if (client_fd < 0) return false;
 
     // Find free slot (starting from 1, 0 is host)
     int slot = -1;
     for (int i = 1; i < NET_MAX_CLIENTS; i++) {
-        if (!server->clients[i].connected) {
+        if (!server->clients[i]) {
             slot = i;
             break;
         }
@@ -239,61 +1249,318 @@ static void server_accept_connection(NetServer* server) {
         // Server full
         printf("[NET_SERVER] Connection rejected - server full\n");
         close(client_fd);
-        return;
+        return true;
+    }
+
+    NetClientSlot* client = (NetClientSlot*)calloc(1, sizeof(NetClientSlot));
+    if (!client || !ring_init(&client->recv_ring, NET_RECV_BUFFER_SIZE)) {
+        printf("[NET_SERVER] Connection rejected - out of memory\n");
+        free(client);
+        close(client_fd);
+        return true;
     }
 
     set_socket_nonblocking(client_fd);
     set_socket_nodelay(client_fd);
 
-    NetClientSlot* client = &server->clients[slot];
-    memset(client, 0, sizeof(NetClientSlot));
+    struct epoll_event event = {.events = EPOLLIN, .data.u32 = (uint32_t)slot};
+    if (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, client_fd, &event) < 0) {
+        printf("[NET_SERVER] Connection rejected - epoll: %s\n", strerror(errno));
+        ring_free(&client->recv_ring);
+        free(client);
+        close(client_fd);
+        return true;
+    }
+
     client->socket_fd = client_fd;
     client->client_id = slot;
     client->connected = true;
     client->authenticated = false;
+    client->udp_token = make_udp_token(slot);
+    client->load_ticket = -1;
     client->last_heartbeat = get_time_seconds();
+    server->clients[slot] = client;
+
+    char ip_str[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &client_addr.sin_addr, ip_str, sizeof(ip_str));
+    printf("[NET_SERVER] Client connected from %s (slot %d)\n", ip_str, slot);
+    return true;
+}
+
+/**
+ * Watch a client socket for writability only while packets are queued
+ */
+static void server_update_interest(NetServer* server, NetClientSlot* client) {
+    bool want_write = client->send_queue_count > 0;
+    if (want_write == client->want_write) return;
+
+    struct epoll_event event = {.events = EPOLLIN | (want_write ? EPOLLOUT : 0),
+                                .data.u32 = client->client_id};
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_MOD, client->socket_fd, &event);
+    client->want_write = want_write;
+}
+
+/**
+ * Send as much of the queued packets as the socket takes
+ */
+static void server_flush_client(NetServer* server, int client_id) {
+    NetClientSlot* client = server_client(server, client_id);
+    if (!client || client->send_queue_count == 0) return;
+
+    struct iovec iov[SERVER_FLUSH_IOV];
+    int count = client->send_queue_count < SERVER_FLUSH_IOV ? client->send_queue_count : SERVER_FLUSH_IOV;
+    for (int k = 0; k < count; k++) {
+        const NetSendEntry* entry =
+            &client->send_queue[(client->send_queue_head + k) & (client->send_queue_capacity - 1)];
+        iov[k].iov_base = entry->packet->data + entry->offset;
+        iov[k].iov_len = entry->packet->size - entry->offset;
+    }
+
+    ssize_t sent = writev(client->socket_fd, iov, count);
+    if (sent < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            printf("[NET_SERVER] Send error to client %d: %s\n", client_id, strerror(errno));
+            server_drop_client(server, client_id);
+        }
+        return;
+    }
+    send_queue_consume(server, client, (size_t)sent);
+    server_update_interest(server, client);
+}
+
+/**
+ * Send a finished packet; whatever the socket does not take is queued by
+ * reference, so the caller may release its own reference right away
+ */
+static void server_send_buf(NetServer* server, int client_id, NetPacketBuf* packet) {
+    if (client_id < 0 || client_id >= NET_MAX_CLIENTS) return;
+    NetClientSlot* client = server_client(server, client_id);
+    if (!client) return;
+
+    // Packets must not overtake bytes still waiting in the queue
+    size_t sent = 0;
+    if (client->send_queue_count == 0) {
+        ssize_t result = send(client->socket_fd, packet->data, packet->size, MSG_NOSIGNAL);
+        if (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            printf("[NET_SERVER] Send error to client %d: %s\n", client_id, strerror(errno));
+            server_drop_client(server, client_id);
+            return;
+        }
+        if (result > 0) sent = (size_t)result;
+    }
+    if (sent == packet->size) return;
+
+    if (client->send_queued + (packet->size - sent) > NET_SEND_QUEUE_MAX ||
+        !send_queue_push(client, packet, (uint32_t)sent)) {
+        printf("[NET_SERVER] Client %d is not keeping up, disconnecting\n", client_id);
+        server_drop_client(server, client_id);
+        return;
+    }
+    server_update_interest(server, client);
+}
+
+static void server_send_packet(NetServer* server, int client_id,
+                                NetPacketType type, const void* payload, size_t payload_size) {
+    if (!payload) payload_size = 0;
+    NetPacketBuf* packet = packet_acquire(server, payload_size);
+    if (!packet) {
+        printf("[NET_SERVER] No packet buffer for client %d, disconnecting\n", client_id);
+        if (client_id >= 0 && client_id < NET_MAX_CLIENTS) server_drop_client(server, client_id);
+        return;
+    }
+    if (payload_size > 0) memcpy(packet_payload(packet), payload, payload_size);
+    packet_finish(server, packet, type, payload_size);
+    server_send_buf(server, client_id, packet);
+    packet_release(server, packet);
+}
+
+/**
+ * Send a finished packet over the unreliable sequenced channel when the
+ * client has one, over TCP otherwise
+ */
+static void server_send_unreliable(NetServer* server, int client_id, NetPacketBuf* packet) {
+    NetClientSlot* client = server_client(server, client_id);
+    if (!client) return;
+    if (server->udp_socket < 0 || !client->udp_bound ||
+        packet->size - NET_HEADER_SIZE > NET_UDP_PAYLOAD_MAX) {
+        server_send_buf(server, client_id, packet);
+        return;
+    }
+
+    // Unreliable: a datagram the socket refuses is simply lost
+    sendto(server->udp_socket, packet->data, packet->size, 0,
+           (const struct sockaddr*)&client->udp_addr, sizeof(client->udp_addr));
+}
+
+/**
+ * Serialized once; clients that cannot take it right away share the buffer
+ */
+static void server_broadcast(NetServer* server, NetPacketType type,
+                              const void* payload, size_t payload_size, int exclude) {
+    if (!payload) payload_size = 0;
+    NetPacketBuf* packet = packet_acquire(server, payload_size);
+    if (!packet) return;
+    if (payload_size > 0) memcpy(packet_payload(packet), payload, payload_size);
+    packet_finish(server, packet, type, payload_size);
+
+    for (int i = 1; i < NET_MAX_CLIENTS; i++) {
+        if (i == exclude) continue;
+        NetClientSlot* client = server_client(server, i);
+        if (client && client->authenticated) {
+            server_send_buf(server, i, packet);
+        }
+    }
+    packet_release(server, packet);
+}
+
+// ============================================================================
+// INTEREST MANAGEMENT
+// ============================================================================
+
+/**
+ * Chebyshev distance in chunks from a client's player to a chunk
+ */
+static int server_client_chunk_distance(const NetClientSlot* client, int chunk_x, int chunk_z) {
+    int dx = abs(chunk_x - (int)floorf(client->last_state.pos_x / CHUNK_SIZE));
+    int dz = abs(chunk_z - (int)floorf(client->last_state.pos_z / CHUNK_SIZE));
+    return dx > dz ? dx : dz;
+}
 
-    char ip_str[INET_ADDRSTRLEN];
-    inet_ntop(AF_INET, &client_addr.sin_addr, ip_str, sizeof(ip_str));
-    printf("[NET_SERVER] Client connected from %s (slot %d)\n", ip_str, slot);
+/**
+ * Whether a chunk is inside a client's interest window
+ * The window is the area the client keeps loaded: its view distance plus the
+ * unload margin. Chunks outside it are streamed fresh when the client loads
+ * them again, so changes there need not be sent.
+ */
+static bool server_client_sees_chunk(const NetClientSlot* client, int chunk_x, int chunk_z) {
+    return server_client_chunk_distance(client, chunk_x, chunk_z) <= client->view_distance + WORLD_UNLOAD_MARGIN;
 }
 
-static void server_send_packet(NetServer* server, int client_id,
-                                NetPacketType type, const void* payload, size_t payload_size) {
-    if (client_id < 0 || client_id >= NET_MAX_CLIENTS) return;
-    NetClientSlot* client = &server->clients[client_id];
-    if (!client->connected || client->socket_fd < 0) return;
+/**
+ * Build the snapshot a client is sent from the server's snapshot of everyone
+ * Players outside its interest window are left out. Players past
+ * NET_INTEREST_NEAR are refreshed every NET_INTEREST_FAR_INTERVAL snapshots
+ * (staggered by id) and otherwise keep the state the client was last sent,
+ * taken from prev (the view sent one snapshot earlier, NULL if none).
+ */
+static void server_build_view(const NetServer* server, const NetClientSlot* client,
+                              const NetSnapshot* prev, NetSnapshot* view) {
+    const NetSnapshot* all = &server->snapshot;
+    memset(view, 0, sizeof(NetSnapshot));
+    view->id = all->id;
+    view->valid = true;
 
-    uint8_t packet[NET_MAX_PACKET_SIZE];
-    build_packet_header(packet, type, payload_size, server->next_sequence++);
-    if (payload && payload_size > 0) {
-        memcpy(packet + NET_HEADER_SIZE, payload, payload_size);
+    for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+        if (i == client->client_id || !snapshot_is_active(all, i)) continue;
+        const NetQuantState* q = &all->states[i];
+        int dist = server_client_chunk_distance(client, q->chunk_x, q->chunk_z);
+        if (dist > client->view_distance + WORLD_UNLOAD_MARGIN) continue;
+
+        view->active[i / 8] |= (uint8_t)(1u << (i % 8));
+        bool due = dist <= NET_INTEREST_NEAR || (all->id + i) % NET_INTEREST_FAR_INTERVAL == 0;
+        view->states[i] = !due && prev && snapshot_is_active(prev, i) ? prev->states[i] : *q;
     }
+}
 
-    ssize_t sent = send(client->socket_fd, packet, NET_HEADER_SIZE + payload_size, MSG_NOSIGNAL);
-    if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
-        printf("[NET_SERVER] Send error to client %d: %s\n", client_id, strerror(errno));
+/**
+ * Write a PLAYER_JOIN payload for a client slot
+ */
+/**
+ * Records owed to one client for its INVENTORY_SYNC, sent together
+ */
+typedef struct {
+    uint8_t  data[NET_INVENTORY_PAYLOAD_MAX];
+    size_t   size;
+    uint64_t fix;                   // Slots to send the host's contents of
+} InventoryReply;
+
+static void server_reply_reserve(NetServer* server, int client_id, InventoryReply* reply) {
+    if (reply->size + NET_INVENTORY_RECORD_MAX > sizeof(reply->data)) {
+        server_send_packet(server, client_id, NET_PACKET_INVENTORY_SYNC, reply->data, reply->size);
+        reply->size = 0;
     }
 }
 
-static void server_broadcast(NetServer* server, NetPacketType type,
-                              const void* payload, size_t payload_size, int exclude) {
-    for (int i = 1; i < NET_MAX_CLIENTS; i++) {
-        if (i == exclude) continue;
-        if (server->clients[i].connected && server->clients[i].authenticated) {
-            server_send_packet(server, i, type, payload, payload_size);
+static void server_reply_chest(NetServer* server, int client_id, InventoryReply* reply,
+                               const ChestData* chest) {
+    server_reply_reserve(server, client_id, reply);
+    reply->size += build_chest_record(reply->data + reply->size, chest, NULL);
+}
+
+static void server_send_inventory_reply(NetServer* server, int client_id, InventoryReply* reply) {
+    if (reply->fix != 0) {
+        server_reply_reserve(server, client_id, reply);
+        Inventory* inv = &server->clients[client_id]->inventory;
+        uint8_t* p = reply->data + reply->size;
+        ser_write_u8(&p, NET_INVENTORY_SLOTS);
+        uint8_t* count_at = p;
+        ser_write_u8(&p, 0);
+        uint8_t count = 0;
+        for (int slot = 0; slot < NET_INVENTORY_SLOT_COUNT; slot++) {
+            if (!(reply->fix & (1ull << slot))) continue;
+            p += build_slot_entry(p, slot, sync_slot(inv, slot));
+            count++;
         }
+        ser_write_u8(&count_at, count);
+        reply->size = p - reply->data;
+    }
+    if (reply->size > 0 && server_client(server, client_id)) {
+        server_send_packet(server, client_id, NET_PACKET_INVENTORY_SYNC, reply->data, reply->size);
+    }
+}
+
+/**
+ * Give a client items the host rolled and send it the slots that changed
+ */
+static void server_grant_items(NetServer* server, int client_id, const ItemStack* items, int count) {
+    Inventory* inv = &server->clients[client_id]->inventory;
+    ItemStack before[NET_INVENTORY_SLOT_COUNT];
+    for (int slot = 0; slot < NET_INVENTORY_SLOT_COUNT; slot++) {
+        before[slot] = *sync_slot(inv, slot);
+    }
+    for (int i = 0; i < count; i++) {
+        inventory_add_item(inv, items[i].type, items[i].count);
+    }
+
+    InventoryReply reply;
+    reply.size = 0;
+    reply.fix = 0;
+    for (int slot = 0; slot < NET_INVENTORY_SLOT_COUNT; slot++) {
+        if (!stack_equal(&before[slot], sync_slot(inv, slot))) reply.fix |= 1ull << slot;
     }
+    server_send_inventory_reply(server, client_id, &reply);
+}
+
+static size_t build_player_join(uint8_t* buf, uint8_t client_id, const char* name, Vector3 pos) {
+    uint8_t* p = buf;
+    ser_write_u8(&p, client_id);
+    ser_write_string(&p, name, NET_PLAYER_NAME_MAX);
+    ser_write_f32(&p, pos.x);
+    ser_write_f32(&p, pos.y);
+    ser_write_f32(&p, pos.z);
+    return p - buf;
 }
 
-static void server_handle_connect_request(NetServer* server, int client_id, const uint8_t* data) {
-    NetClientSlot* client = &server->clients[client_id];
+static void server_handle_connect_request(NetServer* server, int client_id,
+                                          const uint8_t* data, size_t size) {
+    NetClientSlot* client = server->clients[client_id];
 
     // Parse request
     const uint8_t* p = data;
     ser_read_string(&p, client->player_name, NET_PLAYER_NAME_MAX);
+    client->view_distance = WORLD_VIEW_DISTANCE;
+    if ((size_t)(p - data) < size) {
+        uint8_t view_distance = ser_read_u8(&p);
+        if (view_distance > 0) client->view_distance = view_distance;
+    }
 
-    printf("[NET_SERVER] Player '%s' joining as client %d\n", client->player_name, client_id);
+    // The client resends its request until the accept arrives: count and
+    // announce the player only once
+    bool first_join = !client->authenticated;
+    if (first_join) {
+        server->client_count++;
+        printf("[NET_SERVER] Player '%s' joining as client %d\n", client->player_name, client_id);
+    }
 
     // Send accept (includes host name so client knows who the host is)
     uint8_t accept_buf[128];
@@ -301,87 +1568,418 @@ static void server_handle_connect_request(NetServer* server, int client_id, cons
     ser_write_u8(&ap, client_id);
     ser_write_u32(&ap, 0);  // world_seed (not used currently)
     ser_write_f32(&ap, server->time_of_day ? *server->time_of_day : 12.0f);
-    ser_write_u8(&ap, server->client_count + 1);
+    ser_write_u8(&ap, server->client_count);
     ser_write_string(&ap, server->host_name, NET_PLAYER_NAME_MAX);  // Host name
+    ser_write_u32(&ap, client->udp_token);
 
     server_send_packet(server, client_id, NET_PACKET_CONNECT_ACCEPT, accept_buf, ap - accept_buf);
+
+    // The host owns the inventory: a new player gets the starting items,
+    // and the client is sent every slot in place of its own
+    if (first_join) inventory_give_starting_items(&client->inventory);
+    InventoryReply reply;
+    reply.size = 0;
+    reply.fix = INVENTORY_ALL_SLOTS;
+    server_send_inventory_reply(server, client_id, &reply);
+
     client->authenticated = true;
-    server->client_count++;
+
+    // The host generates and simulates the world around the player, no
+    // farther than its own view (a repeated request keeps its ticket)
+    Vector3 join_pos = server->host_player ? server->host_player->position : (Vector3){0, 0, 0};
+    if (server->world && client->load_ticket < 0) {
+        int radius = client->view_distance < server->world->view_distance ? client->view_distance
+                                                                           : server->world->view_distance;
+        client->load_ticket = world_add_ticket(server->world, (int)floorf(join_pos.x / CHUNK_SIZE),
+                                               (int)floorf(join_pos.z / CHUNK_SIZE), radius);
+    }
 
     // Notify other clients
     uint8_t join_buf[64];
-    uint8_t* jp = join_buf;
-    ser_write_u8(&jp, client_id);
-    ser_write_string(&jp, client->player_name, NET_PLAYER_NAME_MAX);
-    ser_write_f32(&jp, server->host_player->position.x);
-    ser_write_f32(&jp, server->host_player->position.y);
-    ser_write_f32(&jp, server->host_player->position.z);
+    size_t join_len = build_player_join(join_buf, client_id, client->player_name, join_pos);
+    server_broadcast(server, NET_PACKET_PLAYER_JOIN, join_buf, join_len, client_id);
 
-    server_broadcast(server, NET_PACKET_PLAYER_JOIN, join_buf, jp - join_buf, client_id);
+    // Snapshots only carry nearby players, so list everyone already here
+    for (int i = 1; i < NET_MAX_CLIENTS; i++) {
+        NetClientSlot* other = server_client(server, i);
+        if (i == client_id || !other || !other->authenticated) continue;
+        Vector3 pos = {other->last_state.pos_x, other->last_state.pos_y, other->last_state.pos_z};
+        join_len = build_player_join(join_buf, (uint8_t)i, other->player_name, pos);
+        server_send_packet(server, client_id, NET_PACKET_PLAYER_JOIN, join_buf, join_len);
+    }
 }
 
-static void server_handle_player_state(NetServer* server, int client_id, const uint8_t* data) {
-    NetClientSlot* client = &server->clients[client_id];
+static void server_handle_player_state(NetServer* server, int client_id,
+                                       const uint8_t* data, size_t size) {
+    NetClientSlot* client = server->clients[client_id];
+    if (size < NET_PLAYER_STATE_SIZE) return;
     parse_player_state(data, &client->last_state);
     client->last_state.client_id = client_id;  // Ensure correct ID
+    interp_track_push(&client->track, get_time_ms(), &client->last_state);
+    world_move_ticket(server->world, client->load_ticket, (int)floorf(client->last_state.pos_x / CHUNK_SIZE),
+                      (int)floorf(client->last_state.pos_z / CHUNK_SIZE));
+
+    // Snapshot acknowledgement follows the state
+    if (size >= NET_PLAYER_STATE_SIZE + 2) {
+        const uint8_t* p = data + NET_PLAYER_STATE_SIZE;
+        client->acked_snapshot = ser_read_u16(&p);
+        client->has_acked_snapshot = true;
+    }
+}
+
+static void server_queue_block_change(NetServer* server, const NetBlockChange* change) {
+    if (!block_batch_add(&server->block_batch, change)) {
+        net_server_flush_block_changes(server);
+        block_batch_add(&server->block_batch, change);
+    }
+}
+
+/**
+ * Remember a block a client broke, forgetting the oldest unclaimed one if full
+ */
+static void server_remember_mined(NetClientSlot* client, int32_t x, int32_t y, int32_t z, BlockType type) {
+    if (client->mined_count >= NET_MINED_BLOCKS_MAX) {
+        memmove(client->mined, client->mined + 1, (NET_MINED_BLOCKS_MAX - 1) * sizeof(NetMinedBlock));
+        client->mined_count--;
+    }
+    client->mined[client->mined_count++] = (NetMinedBlock){x, y, z, type};
+}
+
+/**
+ * Take a block a client broke off its unclaimed ones; false if it broke none there
+ */
+static bool server_claim_mined(NetClientSlot* client, int32_t x, int32_t y, int32_t z, BlockType* type) {
+    for (int i = 0; i < client->mined_count; i++) {
+        NetMinedBlock* mined = &client->mined[i];
+        if (mined->x != x || mined->y != y || mined->z != z) continue;
+        *type = mined->type;
+        memmove(mined, mined + 1, (client->mined_count - i - 1) * sizeof(NetMinedBlock));
+        client->mined_count--;
+        return true;
+    }
+    return false;
 }
 
-static void server_handle_block_change(NetServer* server, int client_id, const uint8_t* data) {
+static void server_handle_block_changes(NetServer* server, int client_id,
+                                        const uint8_t* data, size_t size) {
+    NetClientSlot* client = server->clients[client_id];
+    BlockChangeReader reader;
+    block_reader_init(&reader, data, size);
+
     NetBlockChange change;
-    parse_block_change(data, &change);
-    change.client_id = client_id;
-
-    // Validate: check distance from player
-    NetClientSlot* client = &server->clients[client_id];
-    float dx = change.x - client->last_state.pos_x;
-    float dy = change.y - client->last_state.pos_y;
-    float dz = change.z - client->last_state.pos_z;
-    float dist = sqrtf(dx*dx + dy*dy + dz*dz);
-
-    if (dist > 8.0f) {
-        printf("[NET_SERVER] Block change rejected - too far (%.1f)\n", dist);
+    int rejected = 0;
+    while (block_reader_next(&reader, &change)) {
+        change.client_id = (uint8_t)client_id;
+
+        // Validate: check distance from player
+        float dx = change.x - client->last_state.pos_x;
+        float dy = change.y - client->last_state.pos_y;
+        float dz = change.z - client->last_state.pos_z;
+        if (dx*dx + dy*dy + dz*dz > 8.0f * 8.0f) {
+            rejected++;
+            continue;
+        }
+
+        // A broken block's drop can be claimed with a MINE record
+        Block old = world_get_block(server->world, change.x, change.y, change.z);
+        if (change.block_type == BLOCK_AIR && item_get_block_drop(old.type).type != ITEM_NONE) {
+            server_remember_mined(client, change.x, change.y, change.z, old.type);
+        }
+
+        // Apply to world, then forward with this update's other changes
+        Block block = {change.block_type, 0, change.metadata};
+        world_set_block(server->world, change.x, change.y, change.z, block);
+        server_queue_block_change(server, &change);
+    }
+    if (rejected > 0) {
+        printf("[NET_SERVER] %d block changes from client %d rejected - too far\n", rejected, client_id);
+    }
+}
+
+static void server_handle_entity_hit(NetServer* server, int client_id,
+                                    const uint8_t* data, size_t size) {
+    if (size < 5 || !server->entity_manager) return;
+
+    const uint8_t* p = data;
+    uint32_t id = ser_read_u32(&p);
+    uint8_t damage = ser_read_u8(&p);
+
+    // Only entities within reach of the attacker can be hit
+    NetClientSlot* client = server->clients[client_id];
+    Vector3 pos = {client->last_state.pos_x, client->last_state.pos_y, client->last_state.pos_z};
+    Vector3 reach = {ENTITY_HIT_REACH, ENTITY_HIT_REACH, ENTITY_HIT_REACH};
+    Entity* near[ENTITY_HIT_QUERY];
+    int found = entity_manager_query_box(server->entity_manager, Vector3Subtract(pos, reach),
+                                         Vector3Add(pos, reach), near, ENTITY_HIT_QUERY);
+    if (found > ENTITY_HIT_QUERY) found = ENTITY_HIT_QUERY;
+
+    for (int i = 0; i < found; i++) {
+        Entity* entity = near[i];
+        if (entity->id != id || !entity_is_replicated(entity->type)) continue;
+
+        bool died = entity->type == ENTITY_TYPE_PIG ? pig_damage(entity, damage)
+                                                    : sheep_damage(entity, damage);
+        if (died) {
+            // The host rolls the drops and adds them to the attacker's inventory
+            ItemStack drops[ENTITY_DROP_STACKS];
+            int drop_count = entity->type == ENTITY_TYPE_PIG ? pig_get_drops(entity, drops)
+                                                             : sheep_get_drops(entity, drops);
+            server_grant_items(server, client_id, drops, drop_count);
+
+            // Left out of the next ENTITY_STATES, so clients drop their copies
+            entity_manager_remove(server->entity_manager, entity);
+            entity_destroy(entity);
+        }
         return;
     }
+}
+
+static bool server_client_reaches(const NetClientSlot* client, int32_t x, int32_t y, int32_t z) {
+    float dx = x - client->last_state.pos_x;
+    float dy = y - client->last_state.pos_y;
+    float dz = z - client->last_state.pos_z;
+    return dx*dx + dy*dy + dz*dz <= NET_CHEST_REACH * NET_CHEST_REACH;
+}
+
+/**
+ * Apply a client's slot changes to its validated inventory, then run its
+ * crafting, chest and mining actions here; where the client predicted
+ * another result or changed slots in a way that adds items it is sent the
+ * host's slots
+ */
+static void server_handle_inventory_sync(NetServer* server, int client_id,
+                                         const uint8_t* data, size_t size) {
+    NetClientSlot* client = server->clients[client_id];
+    Inventory* inv = &client->inventory;
+    InventoryReply reply;
+    reply.size = 0;
+    reply.fix = 0;
+    int rejected = 0;
+
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    bool malformed = false;
+    while (p < end && !malformed) {
+        uint8_t kind = ser_read_u8(&p);
+        if (kind == NET_INVENTORY_SLOTS) {
+            if (end - p < 1) break;
+            int count = ser_read_u8(&p);
+            if (count > NET_INVENTORY_SLOT_COUNT) break;
+
+            // Each slot once; the output follows from the grid
+            int slots[NET_INVENTORY_SLOT_COUNT];
+            ItemStack stacks[NET_INVENTORY_SLOT_COUNT];
+            int written = 0;
+            uint64_t mask = 0;
+            bool valid = true;
+            for (int i = 0; i < count && !malformed; i++) {
+                int slot;
+                ItemStack stack;
+                if (!parse_slot_entry(&p, end, &slot, &stack) || slot >= NET_INVENTORY_SLOT_COUNT) {
+                    malformed = true;
+                } else if (slot != INVENTORY_SLOT_CRAFTING_OUTPUT) {
+                    valid &= stack_valid(&stack) && !(mask & (1ull << slot));
+                    mask |= 1ull << slot;
+                    slots[written] = slot;
+                    stacks[written++] = stack;
+                }
+            }
+            if (malformed) break;
+
+            // Slot changes only rearrange items; whatever adds them is an action
+            if (!valid || !slot_writes_conserve(inv, slots, stacks, written)) {
+                reply.fix |= mask;
+                rejected++;
+                continue;
+            }
+            bool grid_changed = false;
+            for (int i = 0; i < written; i++) {
+                sync_set_slot(inv, slots[i], &stacks[i]);
+                grid_changed |= slots[i] >= INVENTORY_SLOT_CRAFTING_GRID && slots[i] < INVENTORY_SLOT_CRAFTING_OUTPUT;
+            }
+            if (grid_changed) crafting_update_output(inv);
+        } else if (kind == NET_INVENTORY_CRAFT) {
+            if (end - p < 4) break;
+            uint32_t predicted = ser_read_u32(&p);
+            if (!crafting_take_output(inv)) rejected++;
+            if (inventory_sync_hash(inv) != predicted) reply.fix = INVENTORY_ALL_SLOTS;
+        } else if (kind == NET_INVENTORY_MINE) {
+            if (end - p < 17) break;
+            int32_t x = ser_read_i32(&p);
+            int32_t y = ser_read_i32(&p);
+            int32_t z = ser_read_i32(&p);
+            int slot = ser_read_u8(&p);
+            uint32_t predicted = ser_read_u32(&p);
+
+            // Only the drop of a block this client broke, with its own tool
+            BlockType block;
+            bool added = false;
+            if (slot < HOTBAR_SIZE && server_claim_mined(client, x, y, z, &block)) {
+                inv->selected_hotbar_slot = slot;
+                added = inventory_add_block_drop(inv, x, y, z, block);
+            }
+            if (!added) rejected++;
+            if (inventory_sync_hash(inv) != predicted) reply.fix = INVENTORY_ALL_SLOTS;
+        } else if (kind == NET_INVENTORY_CHEST_OPEN) {
+            if (end - p < 12) break;
+            int32_t x = ser_read_i32(&p);
+            int32_t y = ser_read_i32(&p);
+            int32_t z = ser_read_i32(&p);
+            ChestData* chest = server_client_reaches(client, x, y, z) ? find_chest(server->world, x, y, z, true)
+                                                                       : NULL;
+            if (chest) server_reply_chest(server, client_id, &reply, chest);
+        } else if (kind == NET_INVENTORY_CHEST_TAKE || kind == NET_INVENTORY_CHEST_STORE) {
+            if (end - p < 21) break;
+            int32_t x = ser_read_i32(&p);
+            int32_t y = ser_read_i32(&p);
+            int32_t z = ser_read_i32(&p);
+            int slot = ser_read_u8(&p);
+            uint32_t predicted = ser_read_u32(&p);
+            uint32_t predicted_chest = ser_read_u32(&p);
+
+            ChestData* chest = find_chest(server->world, x, y, z, false);
+            bool moved = false;
+            if (chest && server_client_reaches(client, x, y, z)) {
+                server_mark_chest(server, chest);
+                moved = kind == NET_INVENTORY_CHEST_TAKE ? inventory_take_from_chest(inv, chest, slot)
+                                                         : inventory_store_in_chest(inv, slot, chest);
+            }
+            if (moved) {
+                world_get_chunk(server->world, block_chunk_coord(x), block_chunk_coord(z))->needs_save = true;
+            } else {
+                rejected++;
+            }
+            if (inventory_sync_hash(inv) != predicted) reply.fix = INVENTORY_ALL_SLOTS;
+            if (chest && chest_sync_hash(chest) != predicted_chest) {
+                server_reply_chest(server, client_id, &reply, chest);
+            }
+        } else {
+            malformed = true;  // Unknown record: the rest cannot be read
+        }
+    }
+
+    if (rejected > 0) {
+        printf("[NET_SERVER] %d inventory changes from client %d rejected\n", rejected, client_id);
+    }
+    server_send_inventory_reply(server, client_id, &reply);
+}
+
+static void server_handle_chunk_request(NetServer* server, int client_id,
+                                        const uint8_t* data, size_t size) {
+    NetClientSlot* client = server->clients[client_id];
+    if (size < 2) return;
+
+    const uint8_t* p = data;
+    uint16_t count = ser_read_u16(&p);
+    if (size < 2 + (size_t)count * 8) return;
+
+    for (int i = 0; i < count; i++) {
+        NetChunkCoord coord;
+        coord.x = ser_read_i32(&p);
+        coord.z = ser_read_i32(&p);
+
+        bool queued = false;
+        for (int q = 0; q < client->chunk_queue_count && !queued; q++) {
+            queued = client->chunk_queue[q].x == coord.x && client->chunk_queue[q].z == coord.z;
+        }
+        // A full queue drops the request; the client generates the chunk on timeout
+        if (!queued && client->chunk_queue_count < NET_CHUNK_QUEUE_MAX) {
+            client->chunk_queue[client->chunk_queue_count++] = coord;
+        }
+    }
+}
+
+static void server_handle_udp_hello(NetServer* server, const struct sockaddr_in* from,
+                                    uint32_t sequence, const uint8_t* data, size_t size) {
+    if (size < 5) return;
+    const uint8_t* p = data;
+    uint8_t client_id = ser_read_u8(&p);
+    uint32_t token = ser_read_u32(&p);
+    if (client_id == 0 || client_id >= NET_MAX_CLIENTS) return;
 
-    // Apply to world
-    Block block = {change.block_type, 0, change.metadata};
-    world_set_block(server->world, change.x, change.y, change.z, block);
+    NetClientSlot* client = server_client(server, client_id);
+    if (!client || !client->authenticated || client->udp_bound || client->udp_token != token) return;
+
+    client->udp_addr = *from;
+    client->udp_sequence = sequence;
+    client->udp_bound = true;
+    server_send_packet(server, client_id, NET_PACKET_UDP_READY, NULL, 0);
+    printf("[NET_SERVER] Client %d player states over UDP\n", client_id);
+}
+
+/**
+ * Client whose confirmed UDP address is addr, or NULL
+ */
+static NetClientSlot* server_find_udp_client(NetServer* server, const struct sockaddr_in* addr) {
+    for (int i = 1; i < NET_MAX_CLIENTS; i++) {
+        NetClientSlot* client = server_client(server, i);
+        if (client && client->udp_bound &&
+            client->udp_addr.sin_addr.s_addr == addr->sin_addr.s_addr &&
+            client->udp_addr.sin_port == addr->sin_port) {
+            return client;
+        }
+    }
+    return NULL;
+}
 
-    // Broadcast to all clients
-    uint8_t buf[32];
-    size_t len = build_block_change(buf, &change);
-    server_broadcast(server, NET_PACKET_BLOCK_CHANGE, buf, len, -1);
+static void server_receive_datagrams(NetServer* server) {
+    uint8_t buf[NET_HEADER_SIZE + NET_UDP_PAYLOAD_MAX];
+    for (int n = 0; n < SERVER_UDP_BATCH; n++) {
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+        ssize_t len = recvfrom(server->udp_socket, buf, sizeof(buf), 0, (struct sockaddr*)&from, &from_len);
+        if (len < 0) break;
+
+        uint8_t type;
+        uint32_t sequence;
+        const uint8_t* payload;
+        size_t payload_size;
+        if (!parse_datagram(buf, (size_t)len, &type, &sequence, &payload, &payload_size)) continue;
+
+        if (type == NET_PACKET_UDP_HELLO) {
+            server_handle_udp_hello(server, &from, sequence, payload, payload_size);
+            continue;
+        }
 
-    printf("[NET_SERVER] Block change at (%d,%d,%d) by client %d\n",
-           change.x, change.y, change.z, client_id);
+        // Anything else must come from a confirmed address and be newer than
+        // the last datagram taken from it
+        NetClientSlot* client = server_find_udp_client(server, &from);
+        if (!client || (int32_t)(sequence - client->udp_sequence) <= 0) continue;
+        client->udp_sequence = sequence;
+        if (type == NET_PACKET_PLAYER_STATE) {
+            server_handle_player_state(server, client->client_id, payload, payload_size);
+        }
+    }
 }
 
 static void server_handle_packet(NetServer* server, int client_id,
                                   NetPacketType type, const uint8_t* data, size_t size) {
-    (void)size;
-
     switch (type) {
         case NET_PACKET_CONNECT_REQUEST:
-            server_handle_connect_request(server, client_id, data);
+            server_handle_connect_request(server, client_id, data, size);
             break;
         case NET_PACKET_PLAYER_STATE:
-            server_handle_player_state(server, client_id, data);
+            server_handle_player_state(server, client_id, data, size);
+            break;
+        case NET_PACKET_BLOCK_CHANGES:
+            server_handle_block_changes(server, client_id, data, size);
+            break;
+        case NET_PACKET_CHUNK_REQUEST:
+            server_handle_chunk_request(server, client_id, data, size);
+            break;
+        case NET_PACKET_ENTITY_HIT:
+            server_handle_entity_hit(server, client_id, data, size);
             break;
-        case NET_PACKET_BLOCK_CHANGE:
-            server_handle_block_change(server, client_id, data);
+        case NET_PACKET_INVENTORY_SYNC:
+            server_handle_inventory_sync(server, client_id, data, size);
             break;
         case NET_PACKET_HEARTBEAT:
-            server->clients[client_id].last_heartbeat = get_time_seconds();
+            server->clients[client_id]->last_heartbeat = get_time_seconds();
             server_send_packet(server, client_id, NET_PACKET_HEARTBEAT_ACK, NULL, 0);
             break;
         case NET_PACKET_DISCONNECT:
             printf("[NET_SERVER] Client %d disconnecting\n", client_id);
-            close(server->clients[client_id].socket_fd);
-            server->clients[client_id].socket_fd = -1;
-            server->clients[client_id].connected = false;
-            if (server->clients[client_id].authenticated) {
-                server->client_count--;
-            }
+            server_drop_client(server, client_id);
             break;
         default:
             break;
@@ -389,19 +1987,17 @@ static void server_handle_packet(NetServer* server, int client_id,
 }
 
 static void server_receive_client(NetServer* server, int client_id) {
-    NetClientSlot* client = &server->clients[client_id];
+    NetClientSlot* client = server->clients[client_id];
+    NetRing* ring = &client->recv_ring;
 
-    ssize_t received = recv(client->socket_fd,
-                            client->recv_buffer + client->recv_offset,
-                            NET_RECV_BUFFER_SIZE - client->recv_offset, 0);
+    struct iovec iov[2];
+    int count = ring_free_iov(ring, iov);
+    ssize_t received = count > 0 ? readv(client->socket_fd, iov, count) : 0;
 
     if (received < 0) {
         if (errno != EAGAIN && errno != EWOULDBLOCK) {
             printf("[NET_SERVER] Receive error from client %d: %s\n", client_id, strerror(errno));
-            close(client->socket_fd);
-            client->socket_fd = -1;
-            client->connected = false;
-            if (client->authenticated) server->client_count--;
+            server_drop_client(server, client_id);
         }
         return;
     }
@@ -409,24 +2005,24 @@ static void server_receive_client(NetServer* server, int client_id) {
     if (received == 0) {
         // Client disconnected
         printf("[NET_SERVER] Client %d disconnected\n", client_id);
-        close(client->socket_fd);
-        client->socket_fd = -1;
-        client->connected = false;
-        if (client->authenticated) server->client_count--;
+        server_drop_client(server, client_id);
         return;
     }
 
-    client->recv_offset += received;
+    ring->tail += (size_t)received;
 
-    // Process complete packets
-    while (client->recv_offset >= NET_HEADER_SIZE) {
-        const uint8_t* p = client->recv_buffer;
+    // Process complete packets in place; only packets split by the ring's
+    // end are copied out
+    while (client->connected && ring_used(ring) >= NET_HEADER_SIZE) {
+        uint8_t header[NET_HEADER_SIZE];
+        ring_peek(ring, 0, header, NET_HEADER_SIZE);
+        const uint8_t* p = header;
 
         // Validate header
         uint32_t magic = ser_read_u32(&p);
         if (magic != NET_PROTOCOL_MAGIC) {
             printf("[NET_SERVER] Invalid magic from client %d\n", client_id);
-            client->recv_offset = 0;
+            ring->head = ring->tail;
             break;
         }
 
@@ -437,127 +2033,301 @@ static void server_receive_client(NetServer* server, int client_id) {
         ser_read_u32(&p);  // sequence
 
         size_t total_size = NET_HEADER_SIZE + payload_size;
-        if (client->recv_offset < total_size) {
+        if (total_size > ring->capacity) {
+            printf("[NET_SERVER] Oversized packet from client %d\n", client_id);
+            server_drop_client(server, client_id);
+            break;
+        }
+        if (ring_used(ring) < total_size) {
             break;  // Wait for more data
         }
 
-        // Handle packet
-        server_handle_packet(server, client_id, (NetPacketType)type,
-                             client->recv_buffer + NET_HEADER_SIZE, payload_size);
+        const uint8_t* payload;
+        size_t start = (ring->head + NET_HEADER_SIZE) & (ring->capacity - 1);
+        if (start + payload_size <= ring->capacity) {
+            payload = ring->data + start;
+        } else {
+            ring_peek(ring, NET_HEADER_SIZE, server->scratch, payload_size);
+            payload = server->scratch;
+        }
 
-        // Remove packet from buffer
-        memmove(client->recv_buffer, client->recv_buffer + total_size,
-                client->recv_offset - total_size);
-        client->recv_offset -= total_size;
+        // Handle packet
+        server_handle_packet(server, client_id, (NetPacketType)type, payload, payload_size);
+        ring->head += total_size;
     }
 }
 
 int net_server_poll(NetServer* server, int timeout_ms) {
     if (!server || !server->running) return 0;
 
-    struct pollfd fds[NET_MAX_CLIENTS + 1];
-    int nfds = 0;
+    struct epoll_event events[NET_EPOLL_EVENTS];
+    int ready = epoll_wait(server->epoll_fd, events, NET_EPOLL_EVENTS, timeout_ms);
 
-    // Add listen socket
-    fds[nfds].fd = server->listen_socket;
-    fds[nfds].events = POLLIN;
-    nfds++;
+    for (int i = 0; i < ready; i++) {
+        uint32_t tag = events[i].data.u32;
 
-    // Add client sockets
-    int client_fds[NET_MAX_CLIENTS];
-    int client_count = 0;
-    for (int i = 1; i < NET_MAX_CLIENTS; i++) {
-        if (server->clients[i].connected && server->clients[i].socket_fd >= 0) {
-            fds[nfds].fd = server->clients[i].socket_fd;
-            fds[nfds].events = POLLIN;
-            client_fds[client_count++] = i;
-            nfds++;
+        // New connections, as many as are waiting
+        if (tag == SERVER_LISTEN_TAG) {
+            while (server_accept_connection(server)) {}
+            continue;
+        }
+        if (tag == SERVER_UDP_TAG) {
+            server_receive_datagrams(server);
+            continue;
         }
-    }
-
-    int ready = poll(fds, nfds, timeout_ms);
-    if (ready <= 0) return 0;
-
-    int events = 0;
 
-    // Check listen socket
-    if (fds[0].revents & POLLIN) {
-        server_accept_connection(server);
-        events++;
-    }
+        int client_id = (int)tag;
+        if (!server_client(server, client_id)) continue;
 
-    // Check client sockets
-    for (int i = 0; i < client_count; i++) {
-        if (fds[i + 1].revents & POLLIN) {
-            server_receive_client(server, client_fds[i]);
-            events++;
+        if (events[i].events & EPOLLIN) server_receive_client(server, client_id);
+        if ((events[i].events & EPOLLOUT) && server_client(server, client_id)) {
+            server_flush_client(server, client_id);
         }
-        if (fds[i + 1].revents & (POLLERR | POLLHUP)) {
-            int client_id = client_fds[i];
+        if ((events[i].events & (EPOLLERR | EPOLLHUP)) && server_client(server, client_id)) {
             printf("[NET_SERVER] Client %d connection error\n", client_id);
-            close(server->clients[client_id].socket_fd);
-            server->clients[client_id].socket_fd = -1;
-            server->clients[client_id].connected = false;
-            if (server->clients[client_id].authenticated) server->client_count--;
-            events++;
+            server_drop_client(server, client_id);
         }
     }
 
-    return events;
+    server_reap_clients(server);
+    return ready > 0 ? ready : 0;
 }
 
 void net_server_broadcast_states(NetServer* server) {
     if (!server || !server->running) return;
 
-    // Build host state
-    server->host_state.client_id = 0;
-    server->host_state.pos_x = server->host_player->position.x;
-    server->host_state.pos_y = server->host_player->position.y;
-    server->host_state.pos_z = server->host_player->position.z;
-    server->host_state.vel_x = server->host_player->velocity.x;
-    server->host_state.vel_y = server->host_player->velocity.y;
-    server->host_state.vel_z = server->host_player->velocity.z;
-    server->host_state.yaw = server->host_player->yaw;
-    server->host_state.pitch = server->host_player->pitch;
-    server->host_state.flags = 0;
-    if (server->host_player->is_flying) server->host_state.flags |= NET_PLAYER_FLAG_FLYING;
-    if (server->host_player->is_grounded) server->host_state.flags |= NET_PLAYER_FLAG_GROUNDED;
-    server->host_state.selected_slot = server->host_player->inventory->selected_hotbar_slot;
-
-    // Build packet with all player states
-    uint8_t buf[1024];
-    uint8_t* p = buf;
+    // Build host state (a dedicated server has no host player)
+    Player* host = server->host_player;
+    if (host) {
+        server->host_state.client_id = 0;
+        server->host_state.pos_x = host->position.x;
+        server->host_state.pos_y = host->position.y;
+        server->host_state.pos_z = host->position.z;
+        server->host_state.vel_x = host->velocity.x;
+        server->host_state.vel_y = host->velocity.y;
+        server->host_state.vel_z = host->velocity.z;
+        server->host_state.yaw = host->yaw;
+        server->host_state.pitch = host->pitch;
+        server->host_state.flags = 0;
+        if (host->is_flying) server->host_state.flags |= NET_PLAYER_FLAG_FLYING;
+        if (host->is_grounded) server->host_state.flags |= NET_PLAYER_FLAG_GROUNDED;
+        server->host_state.selected_slot = host->inventory->selected_hotbar_slot;
+    }
+
+    // Record this broadcast's snapshot of all players
+    uint16_t id = ++server->snapshot_id;
+    NetSnapshot* snapshot = &server->snapshot;
+    memset(snapshot, 0, sizeof(NetSnapshot));
+    snapshot->id = id;
+    snapshot->valid = true;
+    snapshot->time_ms = get_time_ms();
+    for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+        const NetPlayerState* state = NULL;
+        if (i == 0) {
+            state = host ? &server->host_state : NULL;
+        } else if (server_client(server, i) && server->clients[i]->authenticated) {
+            state = &server->clients[i]->last_state;
+        }
+        if (!state) continue;
+        snapshot->active[i / 8] |= (uint8_t)(1u << (i % 8));
+        quantize_player_state(state, &snapshot->states[i]);
+    }
 
-    // Count active players
-    int player_count = 1;  // Host
+    // Each client gets its view's changes since the last view it acknowledged,
+    // serialized straight into the packet that is sent
     for (int i = 1; i < NET_MAX_CLIENTS; i++) {
-        if (server->clients[i].connected && server->clients[i].authenticated) {
-            player_count++;
+        NetClientSlot* client = server_client(server, i);
+        if (!client || !client->authenticated) continue;
+
+        const NetSnapshot* base = NULL;
+        if (client->has_acked_snapshot &&
+            (uint16_t)(id - client->acked_snapshot) < NET_SNAPSHOT_HISTORY) {
+            base = &client->views[client->acked_snapshot % NET_SNAPSHOT_HISTORY];
+            if (!base->valid || base->id != client->acked_snapshot) base = NULL;
         }
+        uint16_t prev_id = (uint16_t)(id - 1);
+        const NetSnapshot* prev = &client->views[prev_id % NET_SNAPSHOT_HISTORY];
+        if (!prev->valid || prev->id != prev_id) prev = NULL;
+
+        NetSnapshot* view = &client->views[id % NET_SNAPSHOT_HISTORY];
+        server_build_view(server, client, prev, view);
+        NetPacketBuf* packet = packet_acquire(server, SNAPSHOT_PACKET_MAX);
+        if (!packet) continue;
+        size_t len = build_snapshot_delta(packet_payload(packet), view, base, i);
+        packet_finish(server, packet, NET_PACKET_PLAYER_STATES, len);
+        server_send_unreliable(server, i, packet);
+        packet_release(server, packet);
     }
-    ser_write_u8(&p, player_count);
+}
 
-    // Write host state
-    p += build_player_state(p, &server->host_state);
+void net_server_broadcast_entities(NetServer* server) {
+    if (!server || !server->running || !server->entity_manager) return;
 
-    // Write client states
+    const size_t payload_max = 2 + NET_ENTITY_VIEW_MAX * (NET_ENTITY_STATE_SIZE + 3);
     for (int i = 1; i < NET_MAX_CLIENTS; i++) {
-        if (server->clients[i].connected && server->clients[i].authenticated) {
-            p += build_player_state(p, &server->clients[i].last_state);
+        NetClientSlot* client = server_client(server, i);
+        if (!client || !client->authenticated) continue;
+        if (!client->entity_view) {
+            client->entity_view = (uint32_t*)malloc(NET_ENTITY_VIEW_MAX * sizeof(uint32_t));
+            if (!client->entity_view) continue;
         }
-    }
 
-    server_broadcast(server, NET_PACKET_PLAYER_STATES, buf, p - buf, -1);
+        // Animals in the chunks around the player, up to the client's window
+        int radius = client->view_distance + WORLD_UNLOAD_MARGIN;
+        if (radius > NET_ENTITY_INTEREST) radius = NET_ENTITY_INTEREST;
+        int chunk_x = (int)floorf(client->last_state.pos_x / CHUNK_SIZE);
+        int chunk_z = (int)floorf(client->last_state.pos_z / CHUNK_SIZE);
+        Vector3 min = {(float)((chunk_x - radius) * CHUNK_SIZE), -QUANT_Y_OFFSET,
+                       (float)((chunk_z - radius) * CHUNK_SIZE)};
+        Vector3 max = {(float)((chunk_x + radius + 1) * CHUNK_SIZE), (float)CHUNK_HEIGHT + QUANT_Y_OFFSET,
+                       (float)((chunk_z + radius + 1) * CHUNK_SIZE)};
+        Entity** found = server->entity_scratch;
+        int count = entity_manager_query_box(server->entity_manager, min, max, found, NET_ENTITY_VIEW_MAX);
+        if (count > NET_ENTITY_VIEW_MAX) count = NET_ENTITY_VIEW_MAX;
+
+        int kept = 0;
+        for (int e = 0; e < count; e++) {
+            if (entity_is_replicated(found[e]->type)) found[kept++] = found[e];
+        }
+        count = kept;
+        if (count == 0 && client->entity_view_count == 0) continue;
+        qsort(found, count, sizeof(Entity*), compare_entity_ids);
+
+        NetPacketBuf* packet = packet_acquire(server, payload_max);
+        if (!packet) continue;
+
+        // Animals missing from the last list are new to the client: merge the
+        // two sorted id lists to tell them apart
+        uint8_t* buf = packet_payload(packet);
+        uint8_t* p = buf;
+        ser_write_u16(&p, (uint16_t)count);
+        int prev = 0;
+        for (int e = 0; e < count; e++) {
+            const Entity* entity = found[e];
+            while (prev < client->entity_view_count && client->entity_view[prev] < entity->id) prev++;
+            bool known = prev < client->entity_view_count && client->entity_view[prev] == entity->id;
+
+            NetEntityState state;
+            entity_read_replicated(entity, &state);
+            state.id = entity->id;
+            state.type = (uint8_t)entity->type;
+            state.pos_x = quantize_clamped(entity->position.x, QUANT_POS_SCALE, INT32_MIN, INT32_MAX);
+            state.pos_z = quantize_clamped(entity->position.z, QUANT_POS_SCALE, INT32_MIN, INT32_MAX);
+            state.pos_y = (uint16_t)quantize_clamped(entity->position.y + QUANT_Y_OFFSET, QUANT_Y_SCALE,
+                                                     0, UINT16_MAX);
+            state.yaw = quantize_angle(entity->rotation.y);
+            if (!known) state.flags |= NET_ENTITY_FLAG_SPAWN;
+            p += build_entity_state(p, &state);
+        }
+        for (int e = 0; e < count; e++) client->entity_view[e] = found[e]->id;
+        client->entity_view_count = count;
+
+        packet_finish(server, packet, NET_PACKET_ENTITY_STATES, p - buf);
+        server_send_buf(server, i, packet);
+        packet_release(server, packet);
+    }
 }
 
 void net_server_broadcast_block_change(NetServer* server, int x, int y, int z,
                                         uint8_t block_type, uint8_t metadata) {
-    if (!server || !server->running) return;
+    if (!server || !server->running || y < 0 || y >= CHUNK_HEIGHT) return;
 
     NetBlockChange change = {x, y, z, block_type, metadata, 0};
-    uint8_t buf[32];
-    size_t len = build_block_change(buf, &change);
-    server_broadcast(server, NET_PACKET_BLOCK_CHANGE, buf, len, -1);
+    server_queue_block_change(server, &change);
+}
+
+/**
+ * Finish, send and release a BLOCK_CHANGES packet holding groups groups
+ */
+static void server_send_block_packet(NetServer* server, int client_id, NetPacketBuf* packet,
+                                     uint16_t groups, size_t payload_size) {
+    uint8_t* count_at = packet_payload(packet);
+    ser_write_u16(&count_at, groups);
+    packet_finish(server, packet, NET_PACKET_BLOCK_CHANGES, payload_size);
+    server_send_buf(server, client_id, packet);
+    packet_release(server, packet);
+}
+
+void net_server_flush_block_changes(NetServer* server) {
+    if (!server) return;
+    NetBlockBatch* batch = &server->block_batch;
+    if (batch->count == 0 || !server->running) {
+        block_batch_reset(batch);
+        return;
+    }
+    block_batch_sort(batch);
+
+    // Each client gets the groups of the chunks in its interest window,
+    // written straight into the packets that are sent
+    for (int i = 1; i < NET_MAX_CLIENTS; i++) {
+        NetClientSlot* client = server_client(server, i);
+        if (!client || !client->authenticated) continue;
+
+        NetPacketBuf* packet = NULL;
+        uint8_t* buf = NULL;
+        uint8_t* p = NULL;
+        uint16_t groups = 0;
+        for (int start = 0; start < batch->count && server_client(server, i);) {
+            int end = block_batch_group_end(batch, start);
+            int chunk_x = block_chunk_coord(batch->changes[start].x);
+            int chunk_z = block_chunk_coord(batch->changes[start].z);
+            if (server_client_sees_chunk(client, chunk_x, chunk_z)) {
+                size_t group_size = NET_BLOCK_GROUP_HEADER + (size_t)(end - start) * NET_BLOCK_ENTRY_SIZE;
+                if (packet && (size_t)(p - buf) + group_size > BLOCK_CHANGES_PAYLOAD_MAX) {
+                    server_send_block_packet(server, i, packet, groups, p - buf);
+                    packet = NULL;
+                }
+                if (!packet) {
+                    packet = packet_acquire(server, BLOCK_CHANGES_PAYLOAD_MAX);
+                    if (!packet) break;
+                    buf = packet_payload(packet);
+                    p = buf + 2;
+                    groups = 0;
+                }
+                p += build_block_group(p, batch, start, end);
+                groups++;
+            }
+            start = end;
+        }
+        if (packet) server_send_block_packet(server, i, packet, groups, p - buf);
+    }
+    block_batch_reset(batch);
+}
+
+void net_server_flush_inventory(NetServer* server) {
+    if (!server) return;
+    NetChestBatch* batch = &server->chest_batch;
+    if (batch->count == 0 || !server->running) {
+        batch->count = 0;
+        return;
+    }
+
+    // Each client gets the changed slots of the chests in its interest window
+    uint8_t buf[NET_INVENTORY_PAYLOAD_MAX];
+    for (int i = 1; i < NET_MAX_CLIENTS; i++) {
+        NetClientSlot* client = server_client(server, i);
+        if (!client || !client->authenticated) continue;
+
+        size_t used = 0;
+        for (int c = 0; c < batch->count && server_client(server, i); c++) {
+            const NetChestChange* change = &batch->chests[c];
+            if (!server_client_sees_chunk(client, block_chunk_coord(change->x), block_chunk_coord(change->z))) {
+                continue;
+            }
+            ChestData* chest = find_chest(server->world, change->x, change->y, change->z, false);
+            if (!chest) continue;  // Broken since
+
+            if (used + NET_INVENTORY_RECORD_MAX > sizeof(buf)) {
+                server_send_packet(server, i, NET_PACKET_INVENTORY_SYNC, buf, used);
+                used = 0;
+            }
+            used += build_chest_record(buf + used, chest, change->before);
+        }
+        if (used > 0 && server_client(server, i)) {
+            server_send_packet(server, i, NET_PACKET_INVENTORY_SYNC, buf, used);
+        }
+    }
+    batch->count = 0;
 }
 
 void net_server_broadcast_time(NetServer* server) {
@@ -572,6 +2342,79 @@ void net_server_broadcast_time(NetServer* server) {
     server_broadcast(server, NET_PACKET_TIME_SYNC, buf, p - buf, -1);
 }
 
+/**
+ * Send one encoded chunk in CHUNK_DATA fragments (data = NULL: host has none)
+ */
+static void server_send_chunk(NetServer* server, int client_id, NetChunkCoord coord,
+                              const uint8_t* data, uint32_t size) {
+    uint32_t offset = 0;
+    do {
+        uint32_t length = size - offset;
+        if (length > NET_CHUNK_FRAGMENT_SIZE) length = NET_CHUNK_FRAGMENT_SIZE;
+
+        NetPacketBuf* packet = packet_acquire(server, NET_CHUNK_DATA_HEADER_SIZE + length);
+        if (!packet) return;
+        uint8_t* p = packet_payload(packet);
+        ser_write_i32(&p, coord.x);
+        ser_write_i32(&p, coord.z);
+        ser_write_u32(&p, size);
+        ser_write_u32(&p, offset);
+        ser_write_bytes(&p, data + offset, length);
+        packet_finish(server, packet, NET_PACKET_CHUNK_DATA, NET_CHUNK_DATA_HEADER_SIZE + length);
+        server_send_buf(server, client_id, packet);
+        packet_release(server, packet);
+        offset += length;
+    } while (offset < size && server_client(server, client_id));
+}
+
+void net_server_stream_chunks(NetServer* server) {
+    if (!server || !server->running) return;
+
+    for (int i = 1; i < NET_MAX_CLIENTS; i++) {
+        NetClientSlot* client = server_client(server, i);
+        if (!client || !client->authenticated) continue;
+
+        int player_cx = (int)floorf(client->last_state.pos_x / CHUNK_SIZE);
+        int player_cz = (int)floorf(client->last_state.pos_z / CHUNK_SIZE);
+        int sent = 0;
+
+        // Selection sort moves the nearest request to the front, one at a time;
+        // chunks the host is still generating stay queued for a later update
+        int k = 0;
+        while (k < client->chunk_queue_count && k < NET_CHUNK_SCAN_MAX &&
+               sent < NET_CHUNKS_PER_UPDATE && client->connected &&
+               client->send_queued < NET_CHUNK_SEND_BACKLOG) {
+            int nearest = k;
+            int nearest_dist = INT32_MAX;
+            for (int q = k; q < client->chunk_queue_count; q++) {
+                int dx = client->chunk_queue[q].x - player_cx;
+                int dz = client->chunk_queue[q].z - player_cz;
+                int dist = dx * dx + dz * dz;
+                if (dist < nearest_dist) {
+                    nearest_dist = dist;
+                    nearest = q;
+                }
+            }
+            NetChunkCoord coord = client->chunk_queue[nearest];
+            client->chunk_queue[nearest] = client->chunk_queue[k];
+            client->chunk_queue[k] = coord;
+
+            uint32_t size = 0;
+            bool pending = false;
+            uint8_t* data = world_encode_chunk(server->world, coord.x, coord.z, &size, &pending);
+            if (pending) {
+                k++;
+                continue;
+            }
+
+            client->chunk_queue[k] = client->chunk_queue[--client->chunk_queue_count];
+            server_send_chunk(server, i, coord, data, data ? size : 0);
+            free(data);
+            sent++;
+        }
+    }
+}
+
 int net_server_get_client_count(NetServer* server) {
     return server ? server->client_count : 0;
 }
@@ -591,6 +2434,8 @@ NetClient* net_client_create(const char* player_name, World* world, Player* play
     client->entity_manager = entities;
     client->time_of_day = time_of_day;
     client->socket_fd = -1;
+    client->udp_socket = -1;
+    client->use_udp = true;
     client->state = NET_STATE_DISCONNECTED;
 
     printf("[NET_CLIENT] Created as '%s'\n", player_name);
@@ -601,10 +2446,20 @@ void net_client_destroy(NetClient* client) {
     if (!client) return;
 
     net_client_disconnect(client);
+    free(client->delayed);
     free(client);
     printf("[NET_CLIENT] Destroyed\n");
 }
 
+static void client_close_udp(NetClient* client) {
+    if (client->udp_socket >= 0) {
+        close(client->udp_socket);
+        client->udp_socket = -1;
+    }
+    client->udp_ready = false;
+    client->has_udp_sequence = false;
+}
+
 bool net_client_connect(NetClient* client, const char* ip, uint16_t port) {
     if (!client) return false;
 
@@ -631,39 +2486,236 @@ bool net_client_connect(NetClient* client, const char* ip, uint16_t port) {
         return false;
     }
 
-    client->socket_fd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
-    if (client->socket_fd < 0) {
-        snprintf(client->error_message, sizeof(client->error_message),
-                 "Failed to create socket");
-        printf("[NET_CLIENT] Socket creation failed\n");
-        freeaddrinfo(result);
-        client->state = NET_STATE_ERROR;
-        return false;
+    client->socket_fd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+    if (client->socket_fd < 0) {
+        snprintf(client->error_message, sizeof(client->error_message),
+                 "Failed to create socket");
+        printf("[NET_CLIENT] Socket creation failed\n");
+        freeaddrinfo(result);
+        client->state = NET_STATE_ERROR;
+        return false;
+    }
+
+    set_socket_nonblocking(client->socket_fd);
+    set_socket_nodelay(client->socket_fd);
+
+    int conn_result = connect(client->socket_fd, result->ai_addr, result->ai_addrlen);
+    int saved_errno = errno;  // Save errno before freeaddrinfo might change it
+
+    // UDP socket for player states, connected so only the host's datagrams arrive
+    client_close_udp(client);
+    if (client->use_udp) {
+        client->udp_socket = socket(AF_INET, SOCK_DGRAM, 0);
+        if (client->udp_socket >= 0) {
+            set_socket_nonblocking(client->udp_socket);
+            if (connect(client->udp_socket, result->ai_addr, result->ai_addrlen) < 0) {
+                client_close_udp(client);
+            }
+        }
+    }
+    freeaddrinfo(result);
+
+    printf("[NET_CLIENT] connect() returned %d, errno=%d (%s)\n",
+           conn_result, saved_errno, strerror(saved_errno));
+
+    if (conn_result < 0 && saved_errno != EINPROGRESS) {
+        snprintf(client->error_message, sizeof(client->error_message),
+                 "Connection failed: %s", strerror(saved_errno));
+        printf("[NET_CLIENT] Connection failed: %s\n", strerror(saved_errno));
+        close(client->socket_fd);
+        client->socket_fd = -1;
+        client_close_udp(client);
+        client->state = NET_STATE_ERROR;
+        return false;
+    }
+
+    client->state = NET_STATE_CONNECTING;
+    printf("[NET_CLIENT] Connecting to %s:%d (state=CONNECTING)\n", ip, port);
+    return true;
+}
+
+// ============================================================================
+// CLIENT SIMULATED LINK
+// ============================================================================
+
+struct NetDelayedPacket {
+    uint32_t due_ms;
+    bool     outgoing;
+    bool     datagram;
+    uint32_t size;
+    uint8_t  data[];            // Header and payload
+};
+
+static bool link_active(const NetClient* client) {
+    return client->link.latency_ms > 0 || client->link.jitter_ms > 0 || client->link.loss > 0.0f;
+}
+
+static uint32_t link_next_random(NetClient* client) {
+    // xorshift32: each client's losses and delays repeat run to run
+    uint32_t x = client->link_random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    client->link_random = x;
+    return x;
+}
+
+/**
+ * Hold a packet (header, then payload) back for the link's delay
+ * Returns false if the link drops it
+ */
+static bool link_hold(NetClient* client, bool outgoing, bool datagram,
+                      const void* header, size_t header_size,
+                      const void* payload, size_t payload_size) {
+    if (datagram && client->link.loss > 0.0f &&
+        (float)(link_next_random(client) >> 8) < client->link.loss * (float)(1u << 24)) {
+        client->traffic.packets_dropped++;
+        return false;
+    }
+
+    if (client->delayed_count == client->delayed_capacity) {
+        int capacity = client->delayed_capacity ? client->delayed_capacity * 2 : 64;
+        NetDelayedPacket** grown = (NetDelayedPacket**)realloc(client->delayed, capacity * sizeof(NetDelayedPacket*));
+        if (!grown) return false;
+        client->delayed = grown;
+        client->delayed_capacity = capacity;
+    }
+    NetDelayedPacket* packet = (NetDelayedPacket*)malloc(sizeof(NetDelayedPacket) + header_size + payload_size);
+    if (!packet) return false;
+
+    uint32_t delay = (uint32_t)client->link.latency_ms;
+    if (client->link.jitter_ms > 0) {
+        delay += link_next_random(client) % (uint32_t)(client->link.jitter_ms + 1);
+    }
+    packet->due_ms = get_time_ms() + delay;
+    if (!datagram) {
+        // A stream cannot overtake itself
+        uint32_t* stream_due = &client->link_stream_due[outgoing];
+        if ((int32_t)(*stream_due - packet->due_ms) > 0) packet->due_ms = *stream_due;
+        *stream_due = packet->due_ms;
+    }
+    packet->outgoing = outgoing;
+    packet->datagram = datagram;
+    packet->size = (uint32_t)(header_size + payload_size);
+    memcpy(packet->data, header, header_size);
+    if (payload && payload_size > 0) {
+        memcpy(packet->data + header_size, payload, payload_size);
+    }
+    client->delayed[client->delayed_count++] = packet;
+    return true;
+}
+
+static void link_clear(NetClient* client) {
+    for (int i = 0; i < client->delayed_count; i++) {
+        free(client->delayed[i]);
     }
+    client->delayed_count = 0;
+}
 
-    set_socket_nonblocking(client->socket_fd);
-    set_socket_nodelay(client->socket_fd);
+/**
+ * Put a packet on the wire now; returns bytes sent (negative on error)
+ */
+static ssize_t client_transmit(NetClient* client, bool datagram,
+                               const void* header, size_t header_size,
+                               const void* payload, size_t payload_size) {
+    int fd = datagram ? client->udp_socket : client->socket_fd;
+    if (fd < 0) return -1;
+
+    // Header and payload go out in one call without copying the payload
+    struct iovec iov[2] = {{(void*)header, header_size}, {(void*)payload, payload_size}};
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = payload && payload_size > 0 ? 2 : 1;
+
+    ssize_t sent = sendmsg(fd, &msg, MSG_NOSIGNAL);
+    if (sent > 0) {
+        client->traffic.bytes_sent += (uint64_t)sent;
+        client->traffic.packets_sent++;
+    }
+    return sent;
+}
 
-    int conn_result = connect(client->socket_fd, result->ai_addr, result->ai_addrlen);
-    int saved_errno = errno;  // Save errno before freeaddrinfo might change it
-    freeaddrinfo(result);
+// ============================================================================
+// CLIENT ENTITY COPIES
+// ============================================================================
 
-    printf("[NET_CLIENT] connect() returned %d, errno=%d (%s)\n",
-           conn_result, saved_errno, strerror(saved_errno));
+static uint32_t mirror_home(uint32_t id) {
+    return (id * 2654435761u) & (NET_ENTITY_MIRROR_SLOTS - 1);
+}
 
-    if (conn_result < 0 && saved_errno != EINPROGRESS) {
-        snprintf(client->error_message, sizeof(client->error_message),
-                 "Connection failed: %s", strerror(saved_errno));
-        printf("[NET_CLIENT] Connection failed: %s\n", strerror(saved_errno));
-        close(client->socket_fd);
-        client->socket_fd = -1;
-        client->state = NET_STATE_ERROR;
-        return false;
+/**
+ * Slot holding a host id, or the free slot it would go in (-1 = table full)
+ */
+static int mirror_find(const NetClient* client, uint32_t id) {
+    uint32_t slot = mirror_home(id);
+    for (int probe = 0; probe < NET_ENTITY_MIRROR_SLOTS; probe++) {
+        const NetEntityMirror* m = &client->entity_mirrors[slot];
+        if (m->id == id || m->id == 0) return (int)slot;
+        slot = (slot + 1) & (NET_ENTITY_MIRROR_SLOTS - 1);
     }
+    return -1;
+}
 
-    client->state = NET_STATE_CONNECTING;
-    printf("[NET_CLIENT] Connecting to %s:%d (state=CONNECTING)\n", ip, port);
-    return true;
+/**
+ * Destroy a copy and empty its slot
+ * Later entries of the probe run shift back, so no tombstones are needed.
+ */
+static void mirror_remove(NetClient* client, int slot) {
+    NetEntityMirror* m = &client->entity_mirrors[slot];
+    if (m->entity && client->entity_manager) {
+        entity_manager_remove(client->entity_manager, m->entity);
+        entity_destroy(m->entity);
+    }
+    client->entity_mirror_count--;
+
+    uint32_t hole = (uint32_t)slot;
+    uint32_t next = hole;
+    while (true) {
+        next = (next + 1) & (NET_ENTITY_MIRROR_SLOTS - 1);
+        NetEntityMirror* entry = &client->entity_mirrors[next];
+        if (entry->id == 0) break;
+
+        // Entries whose home lies cyclically in (hole, next] stay put
+        uint32_t home = mirror_home(entry->id);
+        bool stays = hole <= next ? (home > hole && home <= next) : (home > hole || home <= next);
+        if (stays) continue;
+
+        client->entity_mirrors[hole] = *entry;
+        hole = next;
+    }
+    memset(&client->entity_mirrors[hole], 0, sizeof(NetEntityMirror));
+}
+
+static void mirror_clear(NetClient* client) {
+    for (int i = 0; i < NET_ENTITY_MIRROR_SLOTS; i++) {
+        NetEntityMirror* m = &client->entity_mirrors[i];
+        if (m->id != 0 && m->entity && client->entity_manager) {
+            entity_manager_remove(client->entity_manager, m->entity);
+            entity_destroy(m->entity);
+        }
+    }
+    memset(client->entity_mirrors, 0, sizeof(client->entity_mirrors));
+    client->entity_mirror_count = 0;
+}
+
+/**
+ * Remove the animals this peer spawned itself before joining
+ */
+static void client_remove_local_animals(NetClient* client) {
+    EntityManager* manager = client->entity_manager;
+    if (!manager) return;
+
+    for (int t = 0; t < ENTITY_TYPE_COUNT; t++) {
+        if (!entity_is_replicated((EntityType)t)) continue;
+        EntityPool* pool = &manager->pools[t];
+        for (int i = pool->count - 1; i >= 0; i--) {
+            Entity* entity = pool->entities[i];
+            if (entity->remote_id != 0) continue;
+            entity_manager_remove(manager, entity);
+            entity_destroy(entity);
+        }
+    }
 }
 
 void net_client_disconnect(NetClient* client) {
@@ -678,14 +2730,37 @@ void net_client_disconnect(NetClient* client) {
         close(client->socket_fd);
         client->socket_fd = -1;
     }
+    client_close_udp(client);
+    link_clear(client);
 
     client->state = NET_STATE_DISCONNECTED;
     client->recv_offset = 0;
 
+    // Inventory actions are local again
+    if (client->local_player && client->local_player->inventory &&
+        client->local_player->inventory->action_user == client) {
+        inventory_set_action_func(client->local_player->inventory, NULL, NULL);
+    }
+    client->inventory_out_size = 0;
+
+    // Back to generating chunks locally
+    if (client->world && client->world->chunk_request_user == client) {
+        world_set_chunk_source(client->world, NULL, NULL);
+    }
+    client->chunk_request_count = 0;
+    free(client->chunk_assembly);
+    client->chunk_assembly = NULL;
+    client->has_snapshot = false;
+    memset(client->snapshots, 0, sizeof(client->snapshots));
+    mirror_clear(client);
+
     // Clear remote players
     for (int i = 0; i < NET_MAX_CLIENTS; i++) {
         client->player_active[i] = false;
+        client->player_in_view[i] = false;
+        interp_track_reset(&client->tracks[i]);
     }
+    client->has_clock_offset = false;
 
     printf("[NET_CLIENT] Disconnected\n");
 }
@@ -694,20 +2769,192 @@ static void client_send_packet(NetClient* client, NetPacketType type,
                                 const void* payload, size_t payload_size) {
     if (client->socket_fd < 0) return;
 
-    uint8_t packet[NET_MAX_PACKET_SIZE];
-    build_packet_header(packet, type, payload_size, client->send_sequence++);
-    if (payload && payload_size > 0) {
-        memcpy(packet + NET_HEADER_SIZE, payload, payload_size);
+    uint8_t header[NET_HEADER_SIZE];
+    build_packet_header(header, type, payload_size, client->send_sequence++);
+    if (link_active(client)) {
+        link_hold(client, true, false, header, NET_HEADER_SIZE, payload, payload_size);
+        return;
     }
 
-    ssize_t sent = send(client->socket_fd, packet, NET_HEADER_SIZE + payload_size, MSG_NOSIGNAL);
+    ssize_t sent = client_transmit(client, false, header, NET_HEADER_SIZE, payload, payload_size);
     if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
         printf("[NET_CLIENT] Send error: %s\n", strerror(errno));
     }
 }
 
-static void client_handle_connect_accept(NetClient* client, const uint8_t* data) {
+/**
+ * Send one packet as a datagram once the host confirmed our UDP address
+ * Returns false if the packet has to go over TCP instead
+ */
+static bool client_send_datagram(NetClient* client, NetPacketType type,
+                                 const void* payload, size_t payload_size) {
+    if (client->udp_socket < 0 || payload_size > NET_UDP_PAYLOAD_MAX) return false;
+
+    uint8_t header[NET_HEADER_SIZE];
+    build_packet_header(header, type, payload_size, client->send_sequence++);
+    if (link_active(client)) {
+        link_hold(client, true, true, header, NET_HEADER_SIZE, payload, payload_size);
+    } else {
+        client_transmit(client, true, header, NET_HEADER_SIZE, payload, payload_size);  // Lost if refused
+    }
+    return true;
+}
+
+/**
+ * Send over the unreliable sequenced channel when we have one
+ */
+static void client_send_unreliable(NetClient* client, NetPacketType type,
+                                   const void* payload, size_t payload_size) {
+    if (!client->udp_ready || !client_send_datagram(client, type, payload, payload_size)) {
+        client_send_packet(client, type, payload, payload_size);
+    }
+}
+
+/**
+ * Offer our UDP address to the host until it confirms it
+ * After NET_UDP_HELLO_ATTEMPTS unanswered tries the client stays on TCP.
+ */
+static void client_send_udp_hello(NetClient* client) {
+    if (client->udp_socket < 0 || client->udp_ready || client->state != NET_STATE_CONNECTED) return;
+
+    float now = get_time_seconds();
+    if (client->udp_hello_count > 0 && now - client->udp_hello_time < NET_UDP_HELLO_INTERVAL) return;
+    if (client->udp_hello_count >= NET_UDP_HELLO_ATTEMPTS) {
+        printf("[NET_CLIENT] No UDP answer from host, player states stay on TCP\n");
+        client_close_udp(client);
+        return;
+    }
+    client->udp_hello_time = now;
+    client->udp_hello_count++;
+
+    uint8_t buf[5];
+    uint8_t* p = buf;
+    ser_write_u8(&p, client->my_client_id);
+    ser_write_u32(&p, client->udp_token);
+    client_send_datagram(client, NET_PACKET_UDP_HELLO, buf, p - buf);
+}
+
+/**
+ * Add a record to the INVENTORY_SYNC being built, sending it first if full
+ */
+static void client_queue_inventory_record(NetClient* client, const uint8_t* record, size_t size) {
+    if (client->inventory_out_size + size > sizeof(client->inventory_out)) {
+        client_send_packet(client, NET_PACKET_INVENTORY_SYNC, client->inventory_out, client->inventory_out_size);
+        client->inventory_out_size = 0;
+    }
+    memcpy(client->inventory_out + client->inventory_out_size, record, size);
+    client->inventory_out_size += size;
+}
+
+/**
+ * Queue the slots that changed since they were last sent
+ */
+static void client_queue_inventory_slots(NetClient* client) {
+    Inventory* inv = client->local_player->inventory;
+    uint8_t record[NET_INVENTORY_RECORD_MAX];
+    uint8_t* p = record;
+    ser_write_u8(&p, NET_INVENTORY_SLOTS);
+    uint8_t* count_at = p;
+    ser_write_u8(&p, 0);
+
+    uint8_t count = 0;
+    for (int slot = 0; slot < NET_INVENTORY_SLOT_COUNT; slot++) {
+        ItemStack* stack = sync_slot(inv, slot);
+        bool resend = (client->inventory_resend >> slot) & 1;
+        if (!resend && stack_equal(stack, &client->inventory_sent[slot])) continue;
+        client->inventory_sent[slot] = *stack;
+        if (slot == INVENTORY_SLOT_CRAFTING_OUTPUT) continue;  // The host derives it
+        p += build_slot_entry(p, slot, stack);
+        count++;
+    }
+    client->inventory_resend = 0;
+    if (count == 0) return;
+
+    ser_write_u8(&count_at, count);
+    client_queue_inventory_record(client, record, p - record);
+}
+
+/**
+ * Inventory as last sent, to predict the host's result of an action on
+ */
+static void client_sent_inventory(const NetClient* client, Inventory* out) {
+    memset(out, 0, sizeof(Inventory));
+    for (int slot = 0; slot < NET_INVENTORY_SLOT_COUNT; slot++) {
+        sync_set_slot(out, slot, &client->inventory_sent[slot]);
+    }
+}
+
+static void client_set_sent_inventory(NetClient* client, Inventory* inv) {
+    for (int slot = 0; slot < NET_INVENTORY_SLOT_COUNT; slot++) {
+        client->inventory_sent[slot] = *sync_slot(inv, slot);
+    }
+}
+
+/**
+ * Queue an action the host validates, in order after the slot changes made
+ * before it, and apply it to the sent inventory: that is what the host holds
+ * afterwards if it agrees, so only later changes are sent as slots
+ */
+static void client_inventory_action(void* user, Inventory* inv, const InventoryAction* action) {
+    (void)inv;
+    NetClient* client = (NetClient*)user;
+    if (client->state != NET_STATE_CONNECTED) return;
+
+    client_queue_inventory_slots(client);
+
+    Inventory predicted;
+    client_sent_inventory(client, &predicted);
+    uint8_t record[32];
+    uint8_t* p = record;
+    if (action->type == INVENTORY_ACTION_CRAFT) {
+        crafting_take_output(&predicted);
+        ser_write_u8(&p, NET_INVENTORY_CRAFT);
+        ser_write_u32(&p, inventory_sync_hash(&predicted));
+    } else if (action->type == INVENTORY_ACTION_MINE) {
+        predicted.selected_hotbar_slot = action->slot;
+        inventory_add_block_drop(&predicted, action->x, action->y, action->z, action->block);
+        ser_write_u8(&p, NET_INVENTORY_MINE);
+        ser_write_i32(&p, action->x);
+        ser_write_i32(&p, action->y);
+        ser_write_i32(&p, action->z);
+        ser_write_u8(&p, (uint8_t)action->slot);
+        ser_write_u32(&p, inventory_sync_hash(&predicted));
+    } else {
+        ChestData chest = *action->chest;
+        if (action->type == INVENTORY_ACTION_CHEST_TAKE) {
+            inventory_take_from_chest(&predicted, &chest, action->slot);
+        } else {
+            inventory_store_in_chest(&predicted, action->slot, &chest);
+        }
+        ser_write_u8(&p, action->type == INVENTORY_ACTION_CHEST_TAKE ? NET_INVENTORY_CHEST_TAKE
+                                                                      : NET_INVENTORY_CHEST_STORE);
+        ser_write_i32(&p, chest.x);
+        ser_write_i32(&p, chest.y);
+        ser_write_i32(&p, chest.z);
+        ser_write_u8(&p, (uint8_t)action->slot);
+        ser_write_u32(&p, inventory_sync_hash(&predicted));
+        ser_write_u32(&p, chest_sync_hash(&chest));
+    }
+    client_set_sent_inventory(client, &predicted);
+    client_queue_inventory_record(client, record, p - record);
+}
+
+/**
+ * Queue a chunk request for the host (WorldChunkRequestFunc)
+ */
+static bool client_request_chunk(void* user, int chunk_x, int chunk_z) {
+    NetClient* client = (NetClient*)user;
+    if (client->state != NET_STATE_CONNECTED) return false;
+    if (client->chunk_request_count >= NET_CHUNK_QUEUE_MAX) return false;
+
+    NetChunkCoord coord = {chunk_x, chunk_z};
+    client->chunk_requests[client->chunk_request_count++] = coord;
+    return true;
+}
+
+static void client_handle_connect_accept(NetClient* client, const uint8_t* data, size_t size) {
     const uint8_t* p = data;
+    if (size < 10 + NET_PLAYER_NAME_MAX) return;
     client->my_client_id = ser_read_u8(&p);
     ser_read_u32(&p);  // world_seed
     float time_of_day = ser_read_f32(&p);
@@ -715,6 +2962,14 @@ static void client_handle_connect_accept(NetClient* client, const uint8_t* data)
     ser_read_string(&p, client->player_names[0], NET_PLAYER_NAME_MAX);  // Host name is always slot 0
     client->player_active[0] = true;  // Host is always active
 
+    // UDP_HELLO starts on the next poll; without a token only TCP is used
+    client->udp_hello_count = 0;
+    if ((size_t)(p - data) + 4 <= size) {
+        client->udp_token = ser_read_u32(&p);
+    } else {
+        client_close_udp(client);
+    }
+
     if (client->time_of_day) {
         *client->time_of_day = time_of_day;
     }
@@ -722,21 +2977,62 @@ static void client_handle_connect_accept(NetClient* client, const uint8_t* data)
     client->state = NET_STATE_CONNECTED;
     printf("[NET_CLIENT] Connected as client %d, host is '%s'\n",
            client->my_client_id, client->player_names[0]);
+
+    // The host's chunks replace the ones generated here, edits included
+    if (client->world) {
+        world_set_chunk_source(client->world, client_request_chunk, client);
+        world_request_loaded_chunks(client->world);
+    }
+
+    // Animals come from the host from now on
+    client_remove_local_animals(client);
+
+    // The host's inventory replaces this one (every slot follows the accept),
+    // so nothing local is sent. Crafting, chest moves and mined drops are
+    // validated by the host.
+    memset(client->inventory_sent, 0, sizeof(client->inventory_sent));
+    client->inventory_resend = 0;
+    client->inventory_out_size = 0;
+    if (client->local_player && client->local_player->inventory) {
+        client_set_sent_inventory(client, client->local_player->inventory);
+        inventory_set_action_func(client->local_player->inventory, client_inventory_action, client);
+    }
 }
 
-static void client_handle_player_states(NetClient* client, const uint8_t* data) {
-    const uint8_t* p = data;
-    uint8_t player_count = ser_read_u8(&p);
+static void client_handle_player_states(NetClient* client, const uint8_t* data, size_t size) {
+    NetSnapshot snapshot;
+    if (!parse_snapshot_delta(data, size, client->snapshots, &snapshot)) return;
 
-    for (int i = 0; i < player_count; i++) {
-        NetPlayerState state;
-        p += parse_player_state(p, &state);
+    // Late snapshots (reordered datagrams, or a large one sent over TCP
+    // arriving after newer datagrams) are dropped
+    if (client->has_snapshot && (int16_t)(snapshot.id - client->last_snapshot) <= 0) return;
 
-        // Skip our own state
-        if (state.client_id == client->my_client_id) continue;
+    client->snapshots[snapshot.id % NET_SNAPSHOT_HISTORY] = snapshot;
+    client->last_snapshot = snapshot.id;
+    client->has_snapshot = true;
+
+    // Snapshots are placed on the local clock by the lowest delay seen, which
+    // drifts up slowly so clock skew does not build up
+    int32_t offset = (int32_t)(get_time_ms() - snapshot.time_ms);
+    if (!client->has_clock_offset || offset < client->clock_offset_ms) {
+        client->clock_offset_ms = offset;
+        client->has_clock_offset = true;
+    } else {
+        client->clock_offset_ms += (offset - client->clock_offset_ms) / 16;
+    }
+    uint32_t local_ms = snapshot.time_ms + (uint32_t)client->clock_offset_ms;
 
-        client->remote_players[state.client_id] = state;
-        client->player_active[state.client_id] = true;
+    // Our own state is never included; players out of view stay connected
+    for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+        if (i == client->my_client_id) continue;
+        client->player_in_view[i] = snapshot_is_active(&snapshot, i);
+        if (client->player_in_view[i]) {
+            client->player_active[i] = true;
+            dequantize_player_state(&snapshot.states[i], (uint8_t)i, &client->remote_players[i]);
+            interp_track_push(&client->tracks[i], local_ms, &client->remote_players[i]);
+        } else {
+            interp_track_reset(&client->tracks[i]);
+        }
     }
 }
 
@@ -762,15 +3058,185 @@ static void client_handle_player_leave(NetClient* client, const uint8_t* data) {
     ser_read_u8(&p);  // reason
 
     client->player_active[client_id] = false;
+    client->player_in_view[client_id] = false;
+    interp_track_reset(&client->tracks[client_id]);
     printf("[NET_CLIENT] Player %d left\n", client_id);
 }
 
-static void client_handle_block_change(NetClient* client, const uint8_t* data) {
+static void client_handle_block_changes(NetClient* client, const uint8_t* data, size_t size) {
+    BlockChangeReader reader;
+    block_reader_init(&reader, data, size);
+
     NetBlockChange change;
-    parse_block_change(data, &change);
+    while (block_reader_next(&reader, &change)) {
+        if (client->world) {
+            Block block = {change.block_type, 0, change.metadata};
+            world_set_block(client->world, change.x, change.y, change.z, block);
+        }
+        if (client->block_change_func) {
+            client->block_change_func(client->block_change_user, &change);
+        }
+    }
+}
+
+/**
+ * Apply the host's slots: chest contents, and the inventory slots where the
+ * host disagreed with this client (sent back so the host knows they arrived)
+ */
+static void client_handle_inventory_sync(NetClient* client, const uint8_t* data, size_t size) {
+    Inventory* inv = client->local_player ? client->local_player->inventory : NULL;
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    while (p < end) {
+        uint8_t kind = ser_read_u8(&p);
+        if (kind == NET_INVENTORY_SLOTS) {
+            if (end - p < 1) return;
+            int count = ser_read_u8(&p);
+            for (int i = 0; i < count; i++) {
+                int slot;
+                ItemStack stack;
+                if (!parse_slot_entry(&p, end, &slot, &stack) || slot >= NET_INVENTORY_SLOT_COUNT) return;
+                if (!inv) continue;
+                sync_set_slot(inv, slot, &stack);
+                client->inventory_resend |= 1ull << slot;
+            }
+            if (inv && count > 0) crafting_update_output(inv);
+        } else if (kind == NET_INVENTORY_CHEST) {
+            if (end - p < INVENTORY_CHEST_HEADER - 1) return;
+            int32_t x = ser_read_i32(&p);
+            int32_t y = ser_read_i32(&p);
+            int32_t z = ser_read_i32(&p);
+            int count = ser_read_u8(&p);
+
+            // The host's contents replace any loot generated here
+            Chunk* chunk = y >= 0 && y < CHUNK_HEIGHT && client->world
+                ? world_get_chunk(client->world, block_chunk_coord(x), block_chunk_coord(z)) : NULL;
+            ChestData* chest = chunk ? chest_create(chunk, x, y, z) : NULL;
+            if (chest) {
+                chest->loot_generated = true;
+                chunk->needs_save = true;
+            }
+            for (int i = 0; i < count; i++) {
+                int slot;
+                ItemStack stack;
+                if (!parse_slot_entry(&p, end, &slot, &stack) || slot >= CHEST_SLOTS) return;
+                if (chest) chest->slots[slot] = stack;
+            }
+        } else {
+            return;
+        }
+    }
+}
+
+static void client_handle_entity_states(NetClient* client, const uint8_t* data, size_t size) {
+    if (size < 2 || !client->entity_manager) return;
+
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    uint16_t count = ser_read_u16(&p);
+    uint16_t seq = ++client->entity_states_seq;
+
+    for (int e = 0; e < count; e++) {
+        NetEntityState state;
+        size_t used = parse_entity_state(p, (size_t)(end - p), &state);
+        if (used == 0) break;
+        p += used;
+        if (!entity_is_replicated((EntityType)state.type) || state.id == 0) continue;
+
+        int slot = mirror_find(client, state.id);
+        if (slot < 0) continue;
+
+        Vector3 pos = {state.pos_x / QUANT_POS_SCALE, state.pos_y / QUANT_Y_SCALE - QUANT_Y_OFFSET,
+                       state.pos_z / QUANT_POS_SCALE};
+        float yaw = state.yaw / QUANT_ANGLE_SCALE;
+        NetEntityMirror* m = &client->entity_mirrors[slot];
+        if (m->id == 0) {
+            // Copies without a received appearance keep the spawn defaults
+            Entity* entity = NULL;
+            if (state.type == ENTITY_TYPE_PIG) {
+                entity = pig_spawn(client->entity_manager, pos);
+                if (entity && (state.flags & NET_ENTITY_FLAG_SPAWN)) {
+                    ((PigData*)entity->data)->body_color = state.color;
+                }
+            } else if (state.flags & NET_ENTITY_FLAG_SPAWN) {
+                entity = sheep_spawn_colored(client->entity_manager, pos, state.color);
+            } else {
+                entity = sheep_spawn(client->entity_manager, pos);
+            }
+            if (!entity) continue;
+
+            entity->remote_id = state.id;
+            entity->rotation.y = yaw;
+            m->id = state.id;
+            m->entity = entity;
+            client->entity_mirror_count++;
+        }
+        m->target = pos;
+        m->target_yaw = yaw;
+        m->seen = seq;
+        entity_apply_replicated(m->entity, &state);
+    }
+
+    // Animals left out were killed, unloaded or left the window; removal
+    // may shift a later entry into slot i, so it is looked at again
+    for (int i = 0; i < NET_ENTITY_MIRROR_SLOTS;) {
+        NetEntityMirror* m = &client->entity_mirrors[i];
+        if (m->id != 0 && m->seen != seq) {
+            mirror_remove(client, i);
+            continue;
+        }
+        i++;
+    }
+}
+
+static void client_handle_chunk_data(NetClient* client, const uint8_t* data, size_t size) {
+    if (size < NET_CHUNK_DATA_HEADER_SIZE || !client->world) return;
+
+    const uint8_t* p = data;
+    NetChunkData header;
+    header.chunk_x = ser_read_i32(&p);
+    header.chunk_z = ser_read_i32(&p);
+    header.total_size = ser_read_u32(&p);
+    header.offset = ser_read_u32(&p);
+    uint32_t length = (uint32_t)(size - NET_CHUNK_DATA_HEADER_SIZE);
+
+    if (header.total_size == 0) {
+        world_receive_chunk(client->world, header.chunk_x, header.chunk_z, NULL, 0);
+        return;
+    }
+    if (header.total_size > NET_CHUNK_DATA_MAX) return;
+
+    // Fragments of one chunk arrive in order, chunks one after another
+    if (header.offset == 0) {
+        free(client->chunk_assembly);
+        client->chunk_assembly = (uint8_t*)malloc(header.total_size);
+        if (!client->chunk_assembly) return;
+        client->chunk_assembly_coord.x = header.chunk_x;
+        client->chunk_assembly_coord.z = header.chunk_z;
+        client->chunk_assembly_size = header.total_size;
+        client->chunk_assembly_received = 0;
+    }
+    if (!client->chunk_assembly ||
+        client->chunk_assembly_coord.x != header.chunk_x ||
+        client->chunk_assembly_coord.z != header.chunk_z ||
+        client->chunk_assembly_size != header.total_size ||
+        client->chunk_assembly_received != header.offset ||
+        length > header.total_size - header.offset) {
+        return;
+    }
+
+    ser_read_bytes(&p, client->chunk_assembly + header.offset, length);
+    client->chunk_assembly_received += length;
+    if (client->chunk_assembly_received < client->chunk_assembly_size) return;
 
-    Block block = {change.block_type, 0, change.metadata};
-    world_set_block(client->world, change.x, change.y, change.z, block);
+    if (!world_receive_chunk(client->world, header.chunk_x, header.chunk_z,
+                             client->chunk_assembly, client->chunk_assembly_size) &&
+        world_get_chunk(client->world, header.chunk_x, header.chunk_z)) {
+        // Busy on a worker: ask again
+        client_request_chunk(client, header.chunk_x, header.chunk_z);
+    }
+    free(client->chunk_assembly);
+    client->chunk_assembly = NULL;
 }
 
 static void client_handle_time_sync(NetClient* client, const uint8_t* data) {
@@ -784,11 +3250,9 @@ static void client_handle_time_sync(NetClient* client, const uint8_t* data) {
 
 static void client_handle_packet(NetClient* client, NetPacketType type,
                                   const uint8_t* data, size_t size) {
-    (void)size;
-
     switch (type) {
         case NET_PACKET_CONNECT_ACCEPT:
-            client_handle_connect_accept(client, data);
+            client_handle_connect_accept(client, data, size);
             break;
         case NET_PACKET_CONNECT_REJECT:
             snprintf(client->error_message, sizeof(client->error_message),
@@ -796,7 +3260,7 @@ static void client_handle_packet(NetClient* client, NetPacketType type,
             client->state = NET_STATE_ERROR;
             break;
         case NET_PACKET_PLAYER_STATES:
-            client_handle_player_states(client, data);
+            client_handle_player_states(client, data, size);
             break;
         case NET_PACKET_PLAYER_JOIN:
             client_handle_player_join(client, data);
@@ -804,20 +3268,113 @@ static void client_handle_packet(NetClient* client, NetPacketType type,
         case NET_PACKET_PLAYER_LEAVE:
             client_handle_player_leave(client, data);
             break;
-        case NET_PACKET_BLOCK_CHANGE:
-            client_handle_block_change(client, data);
+        case NET_PACKET_BLOCK_CHANGES:
+            client_handle_block_changes(client, data, size);
+            break;
+        case NET_PACKET_CHUNK_DATA:
+            client_handle_chunk_data(client, data, size);
+            break;
+        case NET_PACKET_ENTITY_STATES:
+            client_handle_entity_states(client, data, size);
             break;
         case NET_PACKET_TIME_SYNC:
             client_handle_time_sync(client, data);
             break;
+        case NET_PACKET_INVENTORY_SYNC:
+            client_handle_inventory_sync(client, data, size);
+            break;
         case NET_PACKET_HEARTBEAT_ACK:
             client->last_heartbeat_received = get_time_seconds();
             break;
+        case NET_PACKET_UDP_READY:
+            if (client->udp_socket >= 0 && !client->udp_ready) {
+                client->udp_ready = true;
+                printf("[NET_CLIENT] Player states over UDP\n");
+            }
+            break;
         default:
             break;
     }
 }
 
+/**
+ * Handle one datagram unless a newer one was handled already
+ * Returns true if it was handled
+ */
+static bool client_handle_datagram(NetClient* client, const uint8_t* buf, size_t len) {
+    uint8_t type;
+    uint32_t sequence;
+    const uint8_t* payload;
+    size_t payload_size;
+    if (!parse_datagram(buf, len, &type, &sequence, &payload, &payload_size)) return false;
+    if (client->has_udp_sequence && (int32_t)(sequence - client->udp_sequence) <= 0) return false;
+    client->udp_sequence = sequence;
+    client->has_udp_sequence = true;
+
+    if (type != NET_PACKET_PLAYER_STATES) return false;
+    client_handle_player_states(client, payload, payload_size);
+    return true;
+}
+
+/**
+ * Handle the datagrams waiting on the UDP channel, newest sequence only
+ * Returns number of packets handled
+ */
+static int client_receive_datagrams(NetClient* client) {
+    if (client->udp_socket < 0) return 0;
+
+    uint8_t buf[NET_HEADER_SIZE + NET_UDP_PAYLOAD_MAX];
+    int packets = 0;
+    ssize_t len;
+    while ((len = recv(client->udp_socket, buf, sizeof(buf), 0)) >= 0) {
+        client->traffic.bytes_received += (uint64_t)len;
+        client->traffic.packets_received++;
+        if (link_active(client)) {
+            link_hold(client, false, true, buf, (size_t)len, NULL, 0);
+        } else if (client_handle_datagram(client, buf, (size_t)len)) {
+            packets++;
+        }
+    }
+    return packets;
+}
+
+/**
+ * Send and handle the packets the simulated link held back that are due
+ * Returns number of received packets handled
+ */
+static int client_release_delayed(NetClient* client) {
+    if (client->delayed_count == 0) return 0;
+
+    // Handlers may hold new packets; those wait for the next call
+    uint32_t now = get_time_ms();
+    int count = client->delayed_count;
+    int packets = 0;
+    for (int i = 0; i < count; i++) {
+        NetDelayedPacket* packet = client->delayed[i];
+        if ((int32_t)(now - packet->due_ms) < 0) continue;
+
+        if (packet->outgoing) {
+            client_transmit(client, packet->datagram, packet->data, packet->size, NULL, 0);
+        } else if (packet->datagram) {
+            packets += client_handle_datagram(client, packet->data, packet->size);
+        } else {
+            client_handle_packet(client, (NetPacketType)packet->data[5],
+                                 packet->data + NET_HEADER_SIZE, packet->size - NET_HEADER_SIZE);
+            packets++;
+        }
+        free(packet);
+        client->delayed[i] = NULL;
+        if (client->delayed_count == 0) return packets;  // Disconnected by a handler
+    }
+
+    int kept = 0;
+    for (int i = 0; i < client->delayed_count; i++) {
+        if (client->delayed[i]) client->delayed[kept++] = client->delayed[i];
+    }
+    client->delayed_count = kept;
+    return packets;
+}
+
 int net_client_poll(NetClient* client, int timeout_ms) {
     if (!client || client->socket_fd < 0) return 0;
 
@@ -835,6 +3392,7 @@ int net_client_poll(NetClient* client, int timeout_ms) {
                 client->state = NET_STATE_ERROR;
                 close(client->socket_fd);
                 client->socket_fd = -1;
+                client_close_udp(client);
                 return 0;
             }
 
@@ -842,14 +3400,21 @@ int net_client_poll(NetClient* client, int timeout_ms) {
             uint8_t buf[64];
             uint8_t* p = buf;
             ser_write_string(&p, client->player_name, NET_PLAYER_NAME_MAX);
+            int view_distance = client->world ? client->world->view_distance : WORLD_VIEW_DISTANCE;
+            ser_write_u8(&p, (uint8_t)(view_distance < 255 ? view_distance : 255));
             client_send_packet(client, NET_PACKET_CONNECT_REQUEST, buf, p - buf);
         }
     }
 
+    // Player states first, they do not wait behind the TCP stream
+    client_send_udp_hello(client);
+    int datagrams = client_release_delayed(client);
+    datagrams += client_receive_datagrams(client);
+
     // Poll for incoming data
     struct pollfd pfd = {client->socket_fd, POLLIN, 0};
     int ready = poll(&pfd, 1, timeout_ms);
-    if (ready <= 0) return 0;
+    if (ready <= 0) return datagrams;
 
     if (pfd.revents & (POLLERR | POLLHUP)) {
         snprintf(client->error_message, sizeof(client->error_message),
@@ -857,7 +3422,8 @@ int net_client_poll(NetClient* client, int timeout_ms) {
         client->state = NET_STATE_ERROR;
         close(client->socket_fd);
         client->socket_fd = -1;
-        return 0;
+        client_close_udp(client);
+        return datagrams;
     }
 
     if (pfd.revents & POLLIN) {
@@ -872,12 +3438,14 @@ int net_client_poll(NetClient* client, int timeout_ms) {
                 client->state = NET_STATE_DISCONNECTED;
                 close(client->socket_fd);
                 client->socket_fd = -1;
-                return 0;
+                client_close_udp(client);
+                return datagrams;
             }
-            return 0;
+            return datagrams;
         }
 
         client->recv_offset += received;
+        client->traffic.bytes_received += (uint64_t)received;
 
         // Process complete packets
         int packets = 0;
@@ -898,19 +3466,24 @@ int net_client_poll(NetClient* client, int timeout_ms) {
             size_t total_size = NET_HEADER_SIZE + payload_size;
             if (client->recv_offset < total_size) break;
 
-            client_handle_packet(client, (NetPacketType)type,
-                                 client->recv_buffer + NET_HEADER_SIZE, payload_size);
-            packets++;
+            client->traffic.packets_received++;
+            if (link_active(client)) {
+                link_hold(client, false, false, client->recv_buffer, total_size, NULL, 0);
+            } else {
+                client_handle_packet(client, (NetPacketType)type,
+                                     client->recv_buffer + NET_HEADER_SIZE, payload_size);
+                packets++;
+            }
 
             memmove(client->recv_buffer, client->recv_buffer + total_size,
                     client->recv_offset - total_size);
             client->recv_offset -= total_size;
         }
 
-        return packets;
+        return packets + datagrams;
     }
 
-    return 0;
+    return datagrams;
 }
 
 void net_client_send_player_state(NetClient* client) {
@@ -933,17 +3506,157 @@ void net_client_send_player_state(NetClient* client) {
 
     uint8_t buf[64];
     size_t len = build_player_state(buf, &state);
-    client_send_packet(client, NET_PACKET_PLAYER_STATE, buf, len);
+    if (client->has_snapshot) {
+        uint8_t* p = buf + len;
+        ser_write_u16(&p, client->last_snapshot);  // Acknowledge the newest snapshot
+        len += 2;
+    }
+    client_send_unreliable(client, NET_PACKET_PLAYER_STATE, buf, len);
 }
 
 void net_client_send_block_change(NetClient* client, int x, int y, int z,
                                    uint8_t block_type, uint8_t metadata) {
-    if (!client || client->state != NET_STATE_CONNECTED) return;
+    if (!client || client->state != NET_STATE_CONNECTED || y < 0 || y >= CHUNK_HEIGHT) return;
 
     NetBlockChange change = {x, y, z, block_type, metadata, client->my_client_id};
-    uint8_t buf[32];
-    size_t len = build_block_change(buf, &change);
-    client_send_packet(client, NET_PACKET_BLOCK_CHANGE, buf, len);
+    if (!block_batch_add(&client->block_batch, &change)) {
+        net_client_flush_block_changes(client);
+        block_batch_add(&client->block_batch, &change);
+    }
+}
+
+void net_client_flush_block_changes(NetClient* client) {
+    if (!client) return;
+    NetBlockBatch* batch = &client->block_batch;
+    if (batch->count == 0 || client->state != NET_STATE_CONNECTED) {
+        block_batch_reset(batch);
+        return;
+    }
+    block_batch_sort(batch);
+
+    uint8_t buf[BLOCK_CHANGES_PAYLOAD_MAX];
+    uint8_t* p = buf + 2;
+    uint16_t groups = 0;
+    for (int start = 0; start < batch->count;) {
+        int end = block_batch_group_end(batch, start);
+        size_t group_size = NET_BLOCK_GROUP_HEADER + (size_t)(end - start) * NET_BLOCK_ENTRY_SIZE;
+        if ((size_t)(p - buf) + group_size > sizeof(buf)) {
+            uint8_t* count_at = buf;
+            ser_write_u16(&count_at, groups);
+            client_send_packet(client, NET_PACKET_BLOCK_CHANGES, buf, p - buf);
+            p = buf + 2;
+            groups = 0;
+        }
+        p += build_block_group(p, batch, start, end);
+        groups++;
+        start = end;
+    }
+    uint8_t* count_at = buf;
+    ser_write_u16(&count_at, groups);
+    client_send_packet(client, NET_PACKET_BLOCK_CHANGES, buf, p - buf);
+    block_batch_reset(batch);
+}
+
+void net_client_flush_inventory(NetClient* client) {
+    if (!client || client->state != NET_STATE_CONNECTED || !client->local_player ||
+        !client->local_player->inventory) {
+        return;
+    }
+
+    client_queue_inventory_slots(client);
+    if (client->inventory_out_size > 0) {
+        client_send_packet(client, NET_PACKET_INVENTORY_SYNC, client->inventory_out, client->inventory_out_size);
+        client->inventory_out_size = 0;
+    }
+}
+
+void net_client_open_chest(NetClient* client, int x, int y, int z) {
+    if (!client || client->state != NET_STATE_CONNECTED) return;
+
+    uint8_t record[16];
+    uint8_t* p = record;
+    ser_write_u8(&p, NET_INVENTORY_CHEST_OPEN);
+    ser_write_i32(&p, x);
+    ser_write_i32(&p, y);
+    ser_write_i32(&p, z);
+    client_queue_inventory_record(client, record, p - record);
+}
+
+void net_client_send_entity_hit(NetClient* client, const Entity* entity, uint8_t damage) {
+    if (!client || client->state != NET_STATE_CONNECTED || !entity || entity->remote_id == 0) return;
+
+    uint8_t buf[8];
+    uint8_t* p = buf;
+    ser_write_u32(&p, entity->remote_id);
+    ser_write_u8(&p, damage);
+    client_send_packet(client, NET_PACKET_ENTITY_HIT, buf, p - buf);
+}
+
+void net_client_update_entities(NetClient* client, float dt) {
+    if (!client || client->entity_mirror_count == 0 || dt <= 0.0f) return;
+
+    float t = fminf(dt * 15.0f, 1.0f);
+    for (int i = 0; i < NET_ENTITY_MIRROR_SLOTS; i++) {
+        NetEntityMirror* m = &client->entity_mirrors[i];
+        if (m->id == 0) continue;
+
+        // Velocity drives the walk animation of the copy
+        Entity* e = m->entity;
+        Vector3 moved = Vector3Scale(Vector3Subtract(m->target, e->position), t);
+        e->position = Vector3Add(e->position, moved);
+        e->velocity = Vector3Scale(moved, 1.0f / dt);
+
+        float turn = fmodf(m->target_yaw - e->rotation.y + 540.0f, 360.0f) - 180.0f;
+        e->rotation.y += turn * t;
+    }
+}
+
+void net_client_flush_chunk_requests(NetClient* client) {
+    if (!client || client->state != NET_STATE_CONNECTED) return;
+
+    uint8_t buf[2 + NET_CHUNK_REQUEST_BATCH * 8];
+    int sent = 0;
+    while (sent < client->chunk_request_count) {
+        int count = client->chunk_request_count - sent;
+        if (count > NET_CHUNK_REQUEST_BATCH) count = NET_CHUNK_REQUEST_BATCH;
+
+        uint8_t* p = buf;
+        ser_write_u16(&p, (uint16_t)count);
+        for (int i = 0; i < count; i++) {
+            ser_write_i32(&p, client->chunk_requests[sent + i].x);
+            ser_write_i32(&p, client->chunk_requests[sent + i].z);
+        }
+        client_send_packet(client, NET_PACKET_CHUNK_REQUEST, buf, p - buf);
+        sent += count;
+    }
+    client->chunk_request_count = 0;
+}
+
+void net_client_set_link(NetClient* client, const NetLinkConditions* link) {
+    if (!client) return;
+
+    if (link) {
+        client->link = *link;
+    } else {
+        memset(&client->link, 0, sizeof(client->link));
+    }
+    if (client->link.latency_ms < 0) client->link.latency_ms = 0;
+    if (client->link.jitter_ms < 0) client->link.jitter_ms = 0;
+    if (client->link.loss < 0.0f) client->link.loss = 0.0f;
+    if (client->link.loss > 1.0f) client->link.loss = 1.0f;
+
+    // Seeded by name, so a run's losses and delays can be repeated
+    uint32_t seed = 2166136261u;
+    for (const char* c = client->player_name; *c; c++) {
+        seed = (seed ^ (uint8_t)*c) * 16777619u;
+    }
+    client->link_random = seed ? seed : 1;
+}
+
+void net_client_set_block_change_func(NetClient* client, NetBlockChangeFunc func, void* user) {
+    if (!client) return;
+    client->block_change_func = func;
+    client->block_change_user = user;
 }
 
 NetClientState net_client_get_state(NetClient* client) {
@@ -963,7 +3676,7 @@ NetworkContext* network_create(void) {
     if (!ctx) return NULL;
 
     ctx->mode = NET_MODE_NONE;
-    ctx->send_interval = 0.05f;  // 20 Hz
+    ctx->send_interval = 1.0f / 15.0f;  // 15 Hz, remote players are interpolated
 
     printf("[NETWORK] Context created\n");
     return ctx;
@@ -1068,11 +3781,15 @@ void network_update(NetworkContext* ctx, float dt) {
 
     if (ctx->mode == NET_MODE_HOST && ctx->server) {
         net_server_poll(ctx->server, 0);
+        net_server_flush_block_changes(ctx->server);
+        net_server_flush_inventory(ctx->server);
+        net_server_stream_chunks(ctx->server);
 
         ctx->send_timer += dt;
         if (ctx->send_timer >= ctx->send_interval) {
             ctx->send_timer = 0;
             net_server_broadcast_states(ctx->server);
+            net_server_broadcast_entities(ctx->server);
         }
 
         // Update remote player entities and names
@@ -1082,6 +3799,10 @@ void network_update(NetworkContext* ctx, float dt) {
         net_client_poll(ctx->client, 0);
 
         if (ctx->client->state == NET_STATE_CONNECTED) {
+            net_client_flush_block_changes(ctx->client);
+            net_client_flush_inventory(ctx->client);
+            net_client_flush_chunk_requests(ctx->client);
+
             ctx->send_timer += dt;
             if (ctx->send_timer >= ctx->send_interval) {
                 ctx->send_timer = 0;
@@ -1090,6 +3811,7 @@ void network_update(NetworkContext* ctx, float dt) {
 
             // Update remote player entities and names
             network_update_remote_players(ctx, dt);
+            net_client_update_entities(ctx->client, dt);
         }
     }
 }
@@ -1106,15 +3828,28 @@ void network_broadcast_block_change(NetworkContext* ctx, int x, int y, int z,
     }
 }
 
+void network_open_chest(NetworkContext* ctx, int x, int y, int z) {
+    if (ctx && ctx->mode == NET_MODE_CLIENT && ctx->client) {
+        net_client_open_chest(ctx->client, x, y, z);
+    }
+}
+
+void network_entity_hit(NetworkContext* ctx, const Entity* entity, uint8_t damage) {
+    if (!ctx || ctx->mode != NET_MODE_CLIENT || !ctx->client) return;
+    net_client_send_entity_hit(ctx->client, entity, damage);
+}
+
 void network_update_remote_players(NetworkContext* ctx, float dt) {
+    (void)dt;  // Positions come from the interpolation tracks
     if (!ctx) return;
+    uint32_t render_ms = get_time_ms() - NET_INTERP_DELAY_MS;
 
     if (ctx->mode == NET_MODE_HOST && ctx->server) {
         // Update entities for connected clients
         for (int i = 1; i < NET_MAX_CLIENTS; i++) {
-            NetClientSlot* slot = &ctx->server->clients[i];
+            NetClientSlot* slot = server_client(ctx->server, i);
 
-            if (slot->connected && slot->authenticated) {
+            if (slot && slot->authenticated) {
                 // Copy name to context for rendering
                 strncpy(ctx->remote_names[i], slot->player_name, NET_PLAYER_NAME_MAX - 1);
 
@@ -1130,16 +3865,13 @@ void network_update_remote_players(NetworkContext* ctx, float dt) {
                     printf("[NETWORK] Spawned entity for client %d '%s'\n", i, slot->player_name);
                 }
 
-                // Update entity position
-                if (ctx->remote_entities[i]) {
-                    Entity* e = ctx->remote_entities[i];
-                    NetPlayerState* s = &slot->last_state;
-
-                    // Interpolate
-                    e->position.x += (s->pos_x - e->position.x) * dt * 15.0f;
-                    e->position.y += (s->pos_y - e->position.y) * dt * 15.0f;
-                    e->position.z += (s->pos_z - e->position.z) * dt * 15.0f;
-                    e->rotation.y = s->yaw;
+                // Draw the client NET_INTERP_DELAY_MS in the past
+                Entity* e = ctx->remote_entities[i];
+                Vector3 pos;
+                float yaw;
+                if (e && interp_track_sample(&slot->track, render_ms, &pos, &yaw)) {
+                    e->position = pos;
+                    e->rotation.y = yaw;
                 }
             } else {
                 // Remove entity if disconnected
@@ -1156,7 +3888,7 @@ void network_update_remote_players(NetworkContext* ctx, float dt) {
         for (int i = 0; i < NET_MAX_CLIENTS; i++) {
             if (i == ctx->client->my_client_id) continue;
 
-            if (ctx->client->player_active[i]) {
+            if (ctx->client->player_active[i] && ctx->client->player_in_view[i]) {
                 // Copy name to context for rendering
                 strncpy(ctx->remote_names[i], ctx->client->player_names[i], NET_PLAYER_NAME_MAX - 1);
 
@@ -1178,16 +3910,13 @@ void network_update_remote_players(NetworkContext* ctx, float dt) {
                     printf("[NETWORK] Spawned entity for player %d '%s'\n", i, ctx->client->player_names[i]);
                 }
 
-                // Update entity position
-                if (ctx->remote_entities[i]) {
-                    Entity* e = ctx->remote_entities[i];
-                    NetPlayerState* s = &ctx->client->remote_players[i];
-
-                    // Interpolate
-                    e->position.x += (s->pos_x - e->position.x) * dt * 15.0f;
-                    e->position.y += (s->pos_y - e->position.y) * dt * 15.0f;
-                    e->position.z += (s->pos_z - e->position.z) * dt * 15.0f;
-                    e->rotation.y = s->yaw;
+                // Draw the player NET_INTERP_DELAY_MS in the past
+                Entity* e = ctx->remote_entities[i];
+                Vector3 pos;
+                float yaw;
+                if (e && interp_track_sample(&ctx->client->tracks[i], render_ms, &pos, &yaw)) {
+                    e->position = pos;
+                    e->rotation.y = yaw;
                 }
             } else {
                 // Remove entity
@@ -1227,8 +3956,8 @@ bool network_is_player_active(NetworkContext* ctx, uint8_t client_id) {
 
     if (ctx->mode == NET_MODE_HOST && ctx->server) {
         if (client_id == 0) return true;  // Host
-        return ctx->server->clients[client_id].connected &&
-               ctx->server->clients[client_id].authenticated;
+        NetClientSlot* slot = server_client(ctx->server, client_id);
+        return slot && slot->authenticated;
     }
     else if (ctx->mode == NET_MODE_CLIENT && ctx->client) {
         if (client_id == ctx->client->my_client_id) return true;
@@ -1243,7 +3972,8 @@ const char* network_get_player_name(NetworkContext* ctx, uint8_t client_id) {
 
     if (ctx->mode == NET_MODE_HOST && ctx->server) {
         if (client_id == 0) return ctx->server->host_name;
-        return ctx->server->clients[client_id].player_name;
+        NetClientSlot* slot = server_client(ctx->server, client_id);
+        return slot ? slot->player_name : "";
     }
     else if (ctx->mode == NET_MODE_CLIENT && ctx->client) {
         if (client_id == ctx->client->my_client_id) return ctx->client->player_name;
@@ -49,6 +49,11 @@ void ser_write_string(uint8_t** buf, const char* str, size_t max_len) {
     (*buf) += max_len;
 }
 
+void ser_write_bytes(uint8_t** buf, const void* data, size_t size) {
+    if (size > 0) memcpy(*buf, data, size);
+    (*buf) += size;
+}
+
 // ============================================================================
 // READ FUNCTIONS
 // ============================================================================
@@ -86,3 +91,8 @@ void ser_read_string(const uint8_t** buf, char* out, size_t max_len) {
     out[max_len - 1] = '\0';
     (*buf) += max_len;
 }
+
+void ser_read_bytes(const uint8_t** buf, void* out, size_t size) {
+    if (size > 0) memcpy(out, *buf, size);
+    (*buf) += size;
+}
@@ -0,0 +1,268 @@
+/**
+ * Flythrough Implementation
+ */
+
+#include "voxel/player/flythrough.h"
+#include "voxel/player/player.h"
+#include "voxel/world/world.h"
+#include "voxel/world/column_cache.h"
+#include "voxel/render/chunk_mesh.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * One leg of the script
+ */
+typedef struct FlythroughSegment {
+    const char* name;
+    float duration;             // Seconds
+    float speed;                // Blocks per second along the heading
+    float turn_rate;            // Degrees of yaw per second
+    float pitch;                // Degrees the view eases toward
+    float height;               // Feet above the terrain surface (0 = on the ground)
+} FlythroughSegment;
+
+static const FlythroughSegment g_script[] = {
+    { "settle",   5.0f,  0.0f,   0.0f,   0.0f,  0.0f },  // Spawn area streams in
+    { "sprint",  10.0f,  8.6f,   0.0f,  -5.0f,  0.0f },  // Walk speed times sprint
+    { "turn",     6.0f,  0.0f,  60.0f,   0.0f,  0.0f },  // Full circle on the spot
+    { "takeoff",  5.0f, 10.0f,  20.0f, -10.0f, 30.0f },
+    { "cruise",  20.0f, 30.0f,   0.0f, -15.0f, 40.0f },  // Streaming a new strip every second
+    { "sweep",   12.0f, 20.0f,  30.0f, -20.0f, 40.0f },  // Culling and sorting under rotation
+    { "high",    10.0f, 45.0f, -15.0f, -35.0f, 90.0f },  // Far view, LOD regions
+    { "descend",  8.0f, 15.0f,   0.0f,   0.0f,  3.0f },
+};
+
+#define FLYTHROUGH_SEGMENTS ((int)(sizeof(g_script) / sizeof(g_script[0])))
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+static float surface_height(World* world, float x, float z) {
+    return (float)column_cache_get_height(world->columns, (int)floorf(x), (int)floorf(z)) + 1.0f;
+}
+
+/**
+ * Resident set high-water mark from /proc (Linux), 0 elsewhere
+ */
+static long read_peak_rss_kb(void) {
+    FILE* file = fopen("/proc/self/status", "r");
+    if (!file) return 0;
+
+    char line[128];
+    long kb = 0;
+    while (fgets(line, sizeof(line), file)) {
+        if (strncmp(line, "VmHWM:", 6) == 0) {
+            kb = strtol(line + 6, NULL, 10);
+            break;
+        }
+    }
+    fclose(file);
+    return kb;
+}
+
+static int compare_floats(const void* a, const void* b) {
+    float x = *(const float*)a;
+    float y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+typedef struct {
+    float mean, p50, p95, p99, max;
+} FlythroughSummary;
+
+/**
+ * Summary of one float field over the frames of a segment (-1: all)
+ */
+static FlythroughSummary summarize(const Flythrough* fly, size_t field, int segment, float* scratch) {
+    FlythroughSummary summary = {0};
+    int count = 0;
+    double total = 0.0;
+    for (int i = 0; i < fly->frame_count; i++) {
+        const FlythroughFrame* frame = &fly->frames[i];
+        if (segment >= 0 && frame->segment != segment) continue;
+        float value = *(const float*)((const char*)frame + field);
+        scratch[count++] = value;
+        total += value;
+    }
+    if (count == 0) return summary;
+
+    qsort(scratch, (size_t)count, sizeof(float), compare_floats);
+    summary.mean = (float)(total / count);
+    summary.p50 = scratch[(int)ceilf(0.50f * count) - 1];
+    summary.p95 = scratch[(int)ceilf(0.95f * count) - 1];
+    summary.p99 = scratch[(int)ceilf(0.99f * count) - 1];
+    summary.max = scratch[count - 1];
+    return summary;
+}
+
+static void write_summary(FILE* file, const char* name, FlythroughSummary s, const char* suffix) {
+    fprintf(file, "\"%s\": {\"mean\": %.3f, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f}%s",
+            name, s.mean, s.p50, s.p95, s.p99, s.max, suffix);
+}
+
+static void write_frames_csv(const Flythrough* fly) {
+    FILE* file = fopen(FLYTHROUGH_FRAMES_PATH, "w");
+    if (!file) {
+        printf("[FLYTHROUGH] Failed to open %s\n", FLYTHROUGH_FRAMES_PATH);
+        return;
+    }
+    fprintf(file, "frame,segment,frame_ms,busy_ms,world_update_ms,uploads,upload_bytes,batch_rebuilds,draw_calls,chunks_loaded\n");
+    for (int i = 0; i < fly->frame_count; i++) {
+        const FlythroughFrame* f = &fly->frames[i];
+        fprintf(file, "%d,%s,%.3f,%.3f,%.3f,%d,%zu,%d,%d,%d\n", i, g_script[f->segment].name, f->frame_ms,
+                f->busy_ms, f->world_update_ms, f->uploads, f->upload_bytes, f->batch_rebuilds, f->draw_calls,
+                f->chunks_loaded);
+    }
+    fclose(file);
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+void flythrough_init(Flythrough* fly, Vector3 start) {
+    if (!fly) return;
+    memset(fly, 0, sizeof(Flythrough));
+    fly->position = start;
+    printf("[FLYTHROUGH] %d segments, seed %u\n", FLYTHROUGH_SEGMENTS, FLYTHROUGH_SEED);
+}
+
+void flythrough_destroy(Flythrough* fly) {
+    if (!fly) return;
+    free(fly->frames);
+    fly->frames = NULL;
+    fly->frame_count = 0;
+    fly->frame_capacity = 0;
+}
+
+bool flythrough_step(Flythrough* fly, Player* player, World* world) {
+    if (!fly || !player || !world) return false;
+    if (fly->segment >= FLYTHROUGH_SEGMENTS) return false;
+
+    const FlythroughSegment* seg = &g_script[fly->segment];
+    float dt = FLYTHROUGH_STEP;
+
+    fly->yaw = fmodf(fly->yaw + seg->turn_rate * dt + 360.0f, 360.0f);
+    fly->pitch += (seg->pitch - fly->pitch) * fminf(1.0f, FLYTHROUGH_PITCH_EASE * dt);
+
+    // Same heading convention as player movement (yaw 0 looks toward -z)
+    float yaw_rad = fly->yaw * DEG2RAD;
+    fly->position.x += sinf(yaw_rad) * seg->speed * dt;
+    fly->position.z -= cosf(yaw_rad) * seg->speed * dt;
+
+    // Walking segments stay on the surface; flying ones ease toward their height
+    float ground = surface_height(world, fly->position.x, fly->position.z);
+    float target = ground + seg->height;
+    if (seg->height <= 0.0f) {
+        fly->position.y = target;
+    } else {
+        fly->position.y += (target - fly->position.y) * fminf(1.0f, FLYTHROUGH_HEIGHT_EASE * dt);
+        if (fly->position.y < ground) fly->position.y = ground;
+    }
+
+    player->is_flying = seg->height > 0.0f;
+    player->velocity = (Vector3){ 0.0f, 0.0f, 0.0f };
+    player_set_view(player, fly->position, fly->yaw, fly->pitch);
+
+    fly->segment_time += dt;
+    if (fly->segment_time >= seg->duration) {
+        fly->segment_time = 0.0f;
+        fly->segment++;
+        if (fly->segment < FLYTHROUGH_SEGMENTS) {
+            printf("[FLYTHROUGH] Segment %s\n", g_script[fly->segment].name);
+        }
+    }
+    return true;
+}
+
+void flythrough_record(Flythrough* fly, const FlythroughFrame* frame) {
+    if (!fly || !frame) return;
+
+    if (fly->frame_count == fly->frame_capacity) {
+        int capacity = fly->frame_capacity > 0 ? fly->frame_capacity * 2 : 4096;
+        FlythroughFrame* frames = (FlythroughFrame*)realloc(fly->frames, (size_t)capacity * sizeof(FlythroughFrame));
+        if (!frames) return;  // Report covers the frames kept so far
+        fly->frames = frames;
+        fly->frame_capacity = capacity;
+    }
+    fly->frames[fly->frame_count++] = *frame;
+
+    size_t gpu_bytes = chunk_mesh_get_stats().gpu_bytes;
+    if (gpu_bytes > fly->peak_gpu_bytes) fly->peak_gpu_bytes = gpu_bytes;
+    long rss = read_peak_rss_kb();
+    if (rss > fly->peak_rss_kb) fly->peak_rss_kb = rss;
+}
+
+void flythrough_write_report(const Flythrough* fly, const char* report_path, World* world) {
+    if (!fly || fly->frame_count == 0) return;
+    if (!report_path) report_path = FLYTHROUGH_REPORT_PATH;
+
+    float* scratch = (float*)malloc((size_t)fly->frame_count * sizeof(float));
+    FILE* file = fopen(report_path, "w");
+    if (!scratch || !file) {
+        printf("[FLYTHROUGH] Failed to write %s\n", report_path);
+        free(scratch);
+        if (file) fclose(file);
+        return;
+    }
+
+    double wall_ms = 0.0;
+    long total_uploads = 0, total_rebuilds = 0, total_draws = 0;
+    size_t total_upload_bytes = 0;
+    int max_draws = 0;
+    for (int i = 0; i < fly->frame_count; i++) {
+        const FlythroughFrame* f = &fly->frames[i];
+        wall_ms += f->frame_ms;
+        total_uploads += f->uploads;
+        total_upload_bytes += f->upload_bytes;
+        total_rebuilds += f->batch_rebuilds;
+        total_draws += f->draw_calls;
+        if (f->draw_calls > max_draws) max_draws = f->draw_calls;
+    }
+
+    FlythroughSummary frame_ms = summarize(fly, offsetof(FlythroughFrame, frame_ms), -1, scratch);
+    FlythroughSummary busy_ms = summarize(fly, offsetof(FlythroughFrame, busy_ms), -1, scratch);
+    FlythroughSummary update_ms = summarize(fly, offsetof(FlythroughFrame, world_update_ms), -1, scratch);
+
+    fprintf(file, "{\n  \"seed\": %u,\n  \"view_distance\": %d,\n  \"lod_distance\": %d,\n  \"mesher\": \"%s\",\n",
+            FLYTHROUGH_SEED, world_get_view_distance(world), world_get_lod_distance(world),
+            chunk_get_mesher() == CHUNK_MESHER_GREEDY ? "greedy" : "simple");
+    fprintf(file, "  \"frames\": %d,\n  \"wall_seconds\": %.3f,\n  \"average_fps\": %.1f,\n",
+            fly->frame_count, wall_ms / 1000.0, wall_ms > 0.0 ? 1000.0 * fly->frame_count / wall_ms : 0.0);
+    fprintf(file, "  ");
+    write_summary(file, "frame_ms", frame_ms, ",\n  ");
+    write_summary(file, "busy_ms", busy_ms, ",\n  ");
+    write_summary(file, "world_update_ms", update_ms, ",\n");
+    fprintf(file, "  \"uploads\": %ld,\n  \"upload_bytes\": %zu,\n  \"batch_rebuilds\": %ld,\n",
+            total_uploads, total_upload_bytes, total_rebuilds);
+    fprintf(file, "  \"draw_calls_mean\": %.1f,\n  \"draw_calls_max\": %d,\n",
+            (double)total_draws / fly->frame_count, max_draws);
+    fprintf(file, "  \"peak_rss_kb\": %ld,\n  \"peak_chunk_gpu_bytes\": %zu,\n", fly->peak_rss_kb, fly->peak_gpu_bytes);
+
+    fprintf(file, "  \"segments\": [\n");
+    for (int s = 0; s < FLYTHROUGH_SEGMENTS; s++) {
+        int frames = 0;
+        for (int i = 0; i < fly->frame_count; i++) {
+            if (fly->frames[i].segment == s) frames++;
+        }
+        fprintf(file, "    {\"name\": \"%s\", \"frames\": %d, ", g_script[s].name, frames);
+        write_summary(file, "frame_ms", summarize(fly, offsetof(FlythroughFrame, frame_ms), s, scratch), ", ");
+        write_summary(file, "world_update_ms", summarize(fly, offsetof(FlythroughFrame, world_update_ms), s, scratch), "");
+        fprintf(file, "}%s\n", s + 1 < FLYTHROUGH_SEGMENTS ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    free(scratch);
+
+    write_frames_csv(fly);
+
+    printf("[FLYTHROUGH] %d frames in %.1f s: frame p50 %.2f ms, p99 %.2f ms, max %.2f ms; world update p99 %.2f ms\n",
+           fly->frame_count, wall_ms / 1000.0, frame_ms.p50, frame_ms.p99, frame_ms.max, update_ms.p99);
+    printf("[FLYTHROUGH] Peak RSS %ld MB, chunk geometry %zu MB\n", fly->peak_rss_kb / 1024,
+           fly->peak_gpu_bytes / (1024 * 1024));
+    printf("[FLYTHROUGH] Report written to %s and %s\n", report_path, FLYTHROUGH_FRAMES_PATH);
+}
@@ -4,6 +4,7 @@
 
 #include "voxel/player/player.h"
 #include "voxel/world/world.h"
+#include "voxel/entity/collision.h"
 #include "voxel/core/block.h"
 #include "voxel/inventory/inventory.h"
 #include <raylib.h>
@@ -103,17 +104,13 @@ void player_destroy(Player* player) {
 // ============================================================================
 
 /**
- * Check if a point is inside a solid block
+ * Cache the solid blocks around the player for one tick's collision checks
  */
-static bool is_solid_at(World * world, float x, float y, float z) {
-    if (!world) return false;
-
-    int block_x = (int)floorf(x);
-    int block_y = (int)floorf(y);
-    int block_z = (int)floorf(z);
-
-    Block block = world_get_block(world, block_x, block_y, block_z);
-    return block_is_solid(block);
+static void fetch_collision(CollisionContext* collision, World* world, Vector3 position) {
+    float half_width = PLAYER_WIDTH / 2.0f;
+    Vector3 box_min = { position.x - half_width, position.y, position.z - half_width };
+    Vector3 box_max = { position.x + half_width, position.y + PLAYER_HEIGHT, position.z + half_width };
+    collision_context_fetch(collision, world, box_min, box_max);
 }
 
 /**
@@ -132,30 +129,28 @@ static bool is_chunk_loaded_at(World* world, float x, float z) {
 /**
  * Check if player's bounding box collides with world at given position
  */
-static bool check_collision(World * world, Vector3 position) {
-    if (!world) return false;
-
+static bool check_collision(CollisionContext* collision, Vector3 position) {
     // Player bounding box corners
     float half_width = PLAYER_WIDTH / 2.0f;
 
     // Check multiple points on the player's bounding box
     // Bottom corners
-    if (is_solid_at(world, position.x - half_width, position.y, position.z - half_width)) return true;
-    if (is_solid_at(world, position.x + half_width, position.y, position.z - half_width)) return true;
-    if (is_solid_at(world, position.x - half_width, position.y, position.z + half_width)) return true;
-    if (is_solid_at(world, position.x + half_width, position.y, position.z + half_width)) return true;
+    if (collision_context_is_solid_at(collision, position.x - half_width, position.y, position.z - half_width)) return true;
+    if (collision_context_is_solid_at(collision, position.x + half_width, position.y, position.z - half_width)) return true;
+    if (collision_context_is_solid_at(collision, position.x - half_width, position.y, position.z + half_width)) return true;
+    if (collision_context_is_solid_at(collision, position.x + half_width, position.y, position.z + half_width)) return true;
 
     // Middle corners
-    if (is_solid_at(world, position.x - half_width, position.y + PLAYER_HEIGHT / 2.0f, position.z - half_width)) return true;
-    if (is_solid_at(world, position.x + half_width, position.y + PLAYER_HEIGHT / 2.0f, position.z - half_width)) return true;
-    if (is_solid_at(world, position.x - half_width, position.y + PLAYER_HEIGHT / 2.0f, position.z + half_width)) return true;
-    if (is_solid_at(world, position.x + half_width, position.y + PLAYER_HEIGHT / 2.0f, position.z + half_width)) return true;
+    if (collision_context_is_solid_at(collision, position.x - half_width, position.y + PLAYER_HEIGHT / 2.0f, position.z - half_width)) return true;
+    if (collision_context_is_solid_at(collision, position.x + half_width, position.y + PLAYER_HEIGHT / 2.0f, position.z - half_width)) return true;
+    if (collision_context_is_solid_at(collision, position.x - half_width, position.y + PLAYER_HEIGHT / 2.0f, position.z + half_width)) return true;
+    if (collision_context_is_solid_at(collision, position.x + half_width, position.y + PLAYER_HEIGHT / 2.0f, position.z + half_width)) return true;
 
     // Top corners
-    if (is_solid_at(world, position.x - half_width, position.y + PLAYER_HEIGHT, position.z - half_width)) return true;
-    if (is_solid_at(world, position.x + half_width, position.y + PLAYER_HEIGHT, position.z - half_width)) return true;
-    if (is_solid_at(world, position.x - half_width, position.y + PLAYER_HEIGHT, position.z + half_width)) return true;
-    if (is_solid_at(world, position.x + half_width, position.y + PLAYER_HEIGHT, position.z + half_width)) return true;
+    if (collision_context_is_solid_at(collision, position.x - half_width, position.y + PLAYER_HEIGHT, position.z - half_width)) return true;
+    if (collision_context_is_solid_at(collision, position.x + half_width, position.y + PLAYER_HEIGHT, position.z - half_width)) return true;
+    if (collision_context_is_solid_at(collision, position.x - half_width, position.y + PLAYER_HEIGHT, position.z + half_width)) return true;
+    if (collision_context_is_solid_at(collision, position.x + half_width, position.y + PLAYER_HEIGHT, position.z + half_width)) return true;
 
     return false;
 }
@@ -268,19 +263,21 @@ static void update_movement(Player* player, World * world, float dt) {
     }
 
     // Apply movement with collision detection (per-axis)
+    CollisionContext collision;
+    fetch_collision(&collision, world, player->position);
     Vector3 new_position = player->position;
 
     // Try to move on X axis
     new_position.x = player->position.x + player->velocity.x * dt;
     if (!is_chunk_loaded_at(world, new_position.x, new_position.z) ||
-        check_collision(world, new_position)) {
+        check_collision(&collision, new_position)) {
         new_position.x = player->position.x;  // Cancel X movement
         player->velocity.x = 0.0f;
     }
 
     // Try to move on Y axis
     new_position.y = player->position.y + player->velocity.y * dt;
-    if (check_collision(world, new_position)) {
+    if (check_collision(&collision, new_position)) {
         // Check if we're hitting ground (moving downward)
         if (player->velocity.y < 0.0f) {
             player->is_grounded = true;
@@ -295,14 +292,14 @@ static void update_movement(Player* player, World * world, float dt) {
     // Additional ground check - look slightly below player
     Vector3 ground_check = new_position;
     ground_check.y -= 0.1f;  // Check 0.1 blocks below
-    if (check_collision(world, ground_check)) {
+    if (check_collision(&collision, ground_check)) {
         player->is_grounded = true;
     }
 
     // Try to move on Z axis
     new_position.z = player->position.z + player->velocity.z * dt;
     if (!is_chunk_loaded_at(world, new_position.x, new_position.z) ||
-        check_collision(world, new_position)) {
+        check_collision(&collision, new_position)) {
         new_position.z = player->position.z;  // Cancel Z movement
         player->velocity.z = 0.0f;
     }
@@ -427,11 +424,13 @@ void player_update_physics(Player* player, World* world, float dt) {
         player->velocity.z = 0.0f;
 
         // Apply movement with collision detection
+        CollisionContext collision;
+        fetch_collision(&collision, world, player->position);
         Vector3 new_position = player->position;
 
         // Try to move on Y axis (gravity)
         new_position.y = player->position.y + player->velocity.y * dt;
-        if (check_collision(world, new_position)) {
+        if (check_collision(&collision, new_position)) {
             // Hit ground (moving downward)
             if (player->velocity.y < 0.0f) {
                 player->is_grounded = true;
@@ -445,7 +444,7 @@ void player_update_physics(Player* player, World* world, float dt) {
         // Additional ground check
         Vector3 ground_check = new_position;
         ground_check.y -= 0.1f;
-        if (check_collision(world, ground_check)) {
+        if (check_collision(&collision, ground_check)) {
             player->is_grounded = true;
         }
 
@@ -465,6 +464,17 @@ void player_set_position(Player* player, Vector3 position) {
     player->position = position;
 }
 
+/**
+ * Set player position and view direction
+ */
+void player_set_view(Player* player, Vector3 position, float yaw, float pitch) {
+    if (!player) return;
+    player->position = position;
+    player->yaw = yaw;
+    player->pitch = pitch > MAX_PITCH ? MAX_PITCH : (pitch < -MAX_PITCH ? -MAX_PITCH : pitch);
+    update_camera(player);
+}
+
 /**
  * Toggle flying mode
  */
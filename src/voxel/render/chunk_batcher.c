@@ -1,26 +1,62 @@
 /**
  * Chunk Batcher Implementation
  *
- * Merges 2x2 chunks into single meshes to reduce draw calls by 75%
+ * Quadtree of 2x2, 4x4 and 8x8 chunk batches, selected by distance each frame
  */
 
 #include "voxel/render/chunk_batcher.h"
+#include "voxel/render/chunk_culler.h"
+#include "voxel/render/chunk_lod.h"
+#include "voxel/render/upload_budget.h"
+#include "voxel/core/memory.h"
 #include "voxel/world/world.h"
 #include "voxel/world/chunk.h"
 #include "voxel/world/chunk_worker.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
-#include <raymath.h>
 
 // ============================================================================
 // HASH MAP HELPERS
 // ============================================================================
 
-static unsigned int batch_hash(int batch_x, int batch_z) {
-    // Simple hash combining both coordinates
-    unsigned int h = (unsigned int)(batch_x * 73856093) ^ (unsigned int)(batch_z * 19349663);
-    return h % BATCH_MAX_COUNT;
+static unsigned int batch_hash(int level, int batch_x, int batch_z) {
+    // Simple hash combining the level and both coordinates
+    unsigned int h = (unsigned int)(batch_x * 73856093) ^ (unsigned int)(batch_z * 19349663) ^
+                     (unsigned int)(level * 83492791);
+    return h % BATCH_BUCKETS;
+}
+
+/**
+ * Node plus its per-chunk arrays (chunks, then opaque and transparent slots)
+ */
+static size_t batch_node_bytes(int level) {
+    size_t cells = (size_t)1 << (2 * level);
+    return sizeof(BatchNode) + cells * (sizeof(Chunk*) + 2 * sizeof(BatchSlotRange));
+}
+
+static ChunkBatch* batcher_find(const ChunkBatcher* batcher, int level, int batch_x, int batch_z) {
+    BatchNode* node = batcher->buckets[batch_hash(level, batch_x, batch_z)];
+    while (node) {
+        ChunkBatch* batch = &node->batch;
+        if (batch->level == level && batch->batch_x == batch_x && batch->batch_z == batch_z) return batch;
+        node = node->next;
+    }
+    return NULL;
+}
+
+/**
+ * Index of a chunk in its batch's per-chunk arrays
+ */
+static int batch_slot(const ChunkBatch* batch, int chunk_x, int chunk_z) {
+    int span = 1 << batch->level;
+    return (chunk_z - batch->batch_z * span) * span + (chunk_x - batch->batch_x * span);
+}
+
+static void batch_mark_dirty(ChunkBatcher* batcher, ChunkBatch* batch) {
+    if (batch->dirty) return;
+    batch->dirty = true;
+    batcher->dirty_count++;
 }
 
 // ============================================================================
@@ -39,6 +75,87 @@ static int compare_sort_entries(const void* a, const void* b) {
     return 0;
 }
 
+/**
+ * Order entries back-to-front, starting from the last pass's order
+ * Batches drawn last pass go back to their old positions and new entries
+ * are appended, then an insertion sort fixes what the camera moved. The
+ * order barely changes between frames, so this stays close to linear
+ */
+static void order_sort_entries(ChunkBatcher* batcher, SortEntry* entries, int count) {
+    SortEntry* slots = batcher->sort_scratch;
+    int previous = batcher->sort_count;
+    for (int i = 0; i < previous; i++) {
+        slots[i].batch = NULL;
+    }
+
+    // Ranked batches to their old slot, the rest packed at the front
+    int unranked = 0;
+    for (int i = 0; i < count; i++) {
+        SortEntry e = entries[i];
+        if (e.is_batch && e.batch->sort_pass == batcher->sort_pass && e.batch->sort_rank < previous) {
+            slots[e.batch->sort_rank] = e;
+        } else {
+            entries[unranked++] = e;
+        }
+    }
+    memmove(entries + (count - unranked), entries, (size_t)unranked * sizeof(SortEntry));
+    int n = 0;
+    for (int i = 0; i < previous; i++) {
+        if (slots[i].batch) entries[n++] = slots[i];
+    }
+
+    // Insertion sort, farthest first
+    for (int i = 1; i < count; i++) {
+        SortEntry e = entries[i];
+        int j = i - 1;
+        while (j >= 0 && entries[j].dist_sq < e.dist_sq) {
+            entries[j + 1] = entries[j];
+            j--;
+        }
+        entries[j + 1] = e;
+    }
+
+    batcher->sort_pass++;
+    batcher->sort_count = count;
+    for (int i = 0; i < count; i++) {
+        if (!entries[i].is_batch) continue;
+        entries[i].batch->sort_rank = i;
+        entries[i].batch->sort_pass = batcher->sort_pass;
+    }
+}
+
+// ============================================================================
+// CULLING
+// ============================================================================
+
+/**
+ * A batch is drawn if any of its chunks passes frustum and cave culling
+ */
+static bool batch_visible(const ChunkBatch* batch, const ChunkCuller* culler) {
+    int cells = 1 << (2 * batch->level);
+    for (int i = 0; i < cells; i++) {
+        const Chunk* chunk = batch->chunks[i];
+        if (chunk && chunk_culler_chunk_visible(culler, chunk)) return true;
+    }
+    return false;
+}
+
+/**
+ * Whether a drawn LOD region overlaps the batch, so it cannot be drawn whole
+ * LOD regions cover whole level-1 batches: one chunk per 2x2 block is enough
+ */
+static bool batch_lod_covered(const ChunkLod* lod, const ChunkBatch* batch) {
+    if (!lod) return false;
+    int span = 1 << batch->level;
+    int x0 = batch->batch_x * span, z0 = batch->batch_z * span;
+    for (int z = 0; z < span; z += 2) {
+        for (int x = 0; x < span; x += 2) {
+            if (chunk_lod_covers(lod, x0 + x, z0 + z)) return true;
+        }
+    }
+    return false;
+}
+
 // ============================================================================
 // BATCH MESH BUILDING
 // ============================================================================
@@ -48,127 +165,254 @@ static int compare_sort_entries(const void* a, const void* b) {
  */
 static int count_batch_vertices(ChunkBatch* batch, bool transparent) {
     int total = 0;
-    for (int bz = 0; bz < BATCH_SIZE; bz++) {
-        for (int bx = 0; bx < BATCH_SIZE; bx++) {
-            Chunk* chunk = batch->chunks[bx][bz];
-            if (!chunk) continue;
-
-            // Select mesh based on LOD distance (simplified: always use full detail for batches)
-            if (transparent) {
-                if (chunk->transparent_mesh_generated && chunk->transparent_mesh.vertexCount > 0) {
-                    total += chunk->transparent_mesh.vertexCount;
-                }
-            } else {
-                if (chunk->mesh_generated && chunk->mesh.vertexCount > 0) {
-                    total += chunk->mesh.vertexCount;
-                }
+    int cells = 1 << (2 * batch->level);
+    for (int i = 0; i < cells; i++) {
+        Chunk* chunk = batch->chunks[i];
+        if (!chunk) continue;
+
+        // Batches hold full-detail chunks only; farther ones are LOD regions
+        if (transparent) {
+            if (chunk->transparent_mesh_generated && chunk->transparent_mesh.vertex_count > 0) {
+                total += chunk->transparent_mesh.vertex_count;
+            }
+        } else {
+            if (chunk->mesh_generated && chunk->mesh.vertex_count > 0) {
+                total += chunk->mesh.vertex_count;
             }
         }
     }
     return total;
 }
 
+/**
+ * Vertices reserved for a chunk inside a combined mesh (whole quads, so
+ * the zeroed padding only ever forms degenerate triangles)
+ */
+static int slot_capacity(int vertex_count) {
+    if (vertex_count == 0) return 0;
+    int capacity = vertex_count + BATCH_SPLICE_SLACK;
+    return (capacity + CHUNK_QUAD_VERTICES - 1) / CHUNK_QUAD_VERTICES * CHUNK_QUAD_VERTICES;
+}
+
 /**
  * Build combined mesh from all chunks in batch
+ * Each chunk gets its own range with spare room after it, so later section
+ * edits can be spliced in without moving the neighbouring chunks
  */
 static void build_batch_mesh(ChunkBatch* batch, bool transparent) {
     int total_vertices = count_batch_vertices(batch, transparent);
+    int cells = 1 << (2 * batch->level);
 
-    if (total_vertices == 0) {
-        if (transparent) {
-            batch->transparent_valid = false;
-        } else {
-            batch->opaque_valid = false;
-        }
-        return;
-    }
+    BatchSlotRange* slots = transparent ? batch->transparent_slots : batch->opaque_slots;
+    memset(slots, 0, (size_t)cells * sizeof(BatchSlotRange));
 
-    // Allocate combined buffers
-    float* vertices = (float*)malloc(total_vertices * 3 * sizeof(float));
-    float* texcoords = (float*)malloc(total_vertices * 2 * sizeof(float));
-    float* normals = (float*)malloc(total_vertices * 3 * sizeof(float));
-    unsigned char* colors = (unsigned char*)malloc(total_vertices * 4);
+    ChunkMesh* target_mesh = transparent ? &batch->transparent_mesh : &batch->opaque_mesh;
+    bool* target_valid = transparent ? &batch->transparent_valid : &batch->opaque_valid;
 
-    if (!vertices || !texcoords || !normals || !colors) {
-        if (vertices) free(vertices);
-        if (texcoords) free(texcoords);
-        if (normals) free(normals);
-        if (colors) free(colors);
+    if (total_vertices == 0) {
+        // Release the previous combined mesh (e.g. last chunk was unloaded)
+        chunk_mesh_unload(target_mesh);
+        *target_valid = false;
         return;
     }
 
-    int offset = 0;
-
-    // Copy vertex data from each chunk
-    for (int bz = 0; bz < BATCH_SIZE; bz++) {
-        for (int bx = 0; bx < BATCH_SIZE; bx++) {
-            Chunk* chunk = batch->chunks[bx][bz];
-            if (!chunk) continue;
-
-            Mesh* src_mesh;
-            bool has_mesh;
-
-            if (transparent) {
-                src_mesh = &chunk->transparent_mesh;
-                has_mesh = chunk->transparent_mesh_generated && src_mesh->vertexCount > 0;
-            } else {
-                src_mesh = &chunk->mesh;
-                has_mesh = chunk->mesh_generated && src_mesh->vertexCount > 0;
+    // Lay out one reserved range per chunk
+    int capacity = 0;
+    for (int i = 0; i < cells; i++) {
+        Chunk* chunk = batch->chunks[i];
+        int vc = 0;
+        if (chunk) {
+            bool generated = transparent ? chunk->transparent_mesh_generated : chunk->mesh_generated;
+            if (generated) {
+                vc = transparent ? chunk->transparent_mesh.vertex_count : chunk->mesh.vertex_count;
             }
+        }
+        slots[i].offset = capacity;
+        slots[i].count = vc;
+        slots[i].capacity = slot_capacity(vc);
+        capacity += slots[i].capacity;
+    }
 
-            if (!has_mesh) continue;
+    // Assemble on the GPU: chunk meshes are already in batch space (their
+    // cell), so each range is a plain buffer copy; zeroed padding draws as
+    // degenerate triangles
+    chunk_mesh_unload(target_mesh);
+    *target_valid = chunk_mesh_upload(target_mesh, NULL, capacity, true, MEMORY_GPU_BATCH);  // Dynamic: sections are patched in place
+    if (!*target_valid) return;
+
+    for (int i = 0; i < cells; i++) {
+        Chunk* chunk = batch->chunks[i];
+        const BatchSlotRange* slot = &slots[i];
+        if (slot->count > 0) {
+            const ChunkMesh* src_mesh = transparent ? &chunk->transparent_mesh : &chunk->mesh;
+            chunk_mesh_copy(target_mesh->vbo_id, slot->offset, src_mesh, 0, slot->count);
+        }
+        chunk_mesh_clear(target_mesh, slot->offset + slot->count, slot->capacity - slot->count);
+    }
+}
 
-            int vc = src_mesh->vertexCount;
+/**
+ * Replace one chunk's changed vertex range inside its reserved batch range
+ * Only the modified span is copied over from the chunk's buffer
+ */
+static bool splice_batch_mesh(ChunkBatch* batch, bool transparent, int slot_index, Chunk* chunk) {
+    ChunkMesh* target = transparent ? &batch->transparent_mesh : &batch->opaque_mesh;
+    bool valid = transparent ? batch->transparent_valid : batch->opaque_valid;
+    BatchSlotRange* slot = transparent ? &batch->transparent_slots[slot_index]
+                                       : &batch->opaque_slots[slot_index];
+    const ChunkMesh* src = transparent ? &chunk->transparent_mesh : &chunk->mesh;
+    bool src_generated = transparent ? chunk->transparent_mesh_generated : chunk->mesh_generated;
+    const ChunkMeshRanges* ranges = transparent ? &chunk->transparent_ranges : &chunk->mesh_ranges;
+
+    int old_count = slot->count;
+    int new_count = src_generated ? src->vertex_count : 0;
+    if (old_count == 0 && new_count == 0) return true;
+    if (!valid || !chunk_mesh_uploaded(target) || new_count > slot->capacity) return false;
+
+    // Everything after splice_first moved if the size changed
+    int first = ranges->splice_first;
+    int end = (new_count == old_count) ? ranges->splice_end : new_count;
+    if (end > new_count) end = new_count;
+
+    int base = slot->offset;
+    if (end > first) {
+        chunk_mesh_copy(target->vbo_id, base + first, src, first, end - first);
+    }
 
-            // Calculate chunk offset within batch
-            float chunk_offset_x = (float)((chunk->x - batch->batch_x * BATCH_SIZE) * CHUNK_SIZE);
-            float chunk_offset_z = (float)((chunk->z - batch->batch_z * BATCH_SIZE) * CHUNK_SIZE);
+    // Shrunk: turn the freed tail back into degenerate padding
+    if (new_count < old_count) {
+        chunk_mesh_clear(target, base + new_count, old_count - new_count);
+    }
+    slot->count = new_count;
+    return true;
+}
 
-            // Copy and offset vertices
-            for (int i = 0; i < vc; i++) {
-                vertices[(offset + i) * 3 + 0] = src_mesh->vertices[i * 3 + 0] + chunk_offset_x;
-                vertices[(offset + i) * 3 + 1] = src_mesh->vertices[i * 3 + 1];  // Y unchanged
-                vertices[(offset + i) * 3 + 2] = src_mesh->vertices[i * 3 + 2] + chunk_offset_z;
-            }
+/**
+ * Drop a batch's meshes; it is rebuilt when selected again
+ */
+static void batch_evict(ChunkBatcher* batcher, ChunkBatch* batch) {
+    chunk_mesh_unload(&batch->opaque_mesh);
+    chunk_mesh_unload(&batch->transparent_mesh);
+    batch->opaque_valid = false;
+    batch->transparent_valid = false;
+    batch->built = false;
+    batch_mark_dirty(batcher, batch);
+}
 
-            // Copy texcoords (no offset needed)
-            memcpy(texcoords + offset * 2, src_mesh->texcoords, vc * 2 * sizeof(float));
+// ============================================================================
+// SELECTION
+// ============================================================================
 
-            // Copy normals (no change)
-            memcpy(normals + offset * 3, src_mesh->normals, vc * 3 * sizeof(float));
+/**
+ * Append a batch or a single chunk to this frame's draws
+ */
+static void batcher_emit(ChunkBatcher* batcher, ChunkBatch* batch, Chunk* chunk) {
+    if (batcher->draw_count == batcher->draw_capacity) {
+        int capacity = batcher->draw_capacity ? batcher->draw_capacity * 2 : 256;
+        SortEntry* draws = (SortEntry*)realloc(batcher->draws, (size_t)capacity * sizeof(SortEntry));
+        if (!draws) return;  // Missing this frame, retried next frame
+        memory_track(MEMORY_BATCHER, (ptrdiff_t)((size_t)(capacity - batcher->draw_capacity) * sizeof(SortEntry)));
+        batcher->draws = draws;
+        batcher->draw_capacity = capacity;
+    }
 
-            // Copy colors (no change)
-            memcpy(colors + offset * 4, src_mesh->colors, vc * 4);
+    SortEntry* entry = &batcher->draws[batcher->draw_count++];
+    if (batch) {
+        entry->batch = batch;
+    } else {
+        entry->chunk = chunk;
+    }
+    entry->dist_sq = 0.0f;
+    entry->is_batch = batch != NULL;
+}
 
-            offset += vc;
+/**
+ * Pick how a batch's area is drawn: whole when its ring level allows it and
+ * it is calm and clear of LOD regions, otherwise as its children (level-1
+ * children are single chunks). A wanted batch that is not built yet is
+ * covered by whatever is built below it (fallback) until its rebuild.
+ * Returns false if part of the area waits for a wanted batch's rebuild;
+ * a batch split only by distance then keeps drawing whole while it is
+ * clean, so moving closer does not fall back to single chunks
+ */
+static bool select_batch(ChunkBatcher* batcher, World* world, int level, int batch_x, int batch_z, bool fallback) {
+    ChunkBatch* batch = batcher_find(batcher, level, batch_x, batch_z);
+    if (!batch) return true;  // No chunks registered there
+
+    bool calm = false;
+    if (!fallback) {
+        int dist = chunk_lod_region_distance(world->center_chunk_x, world->center_chunk_z, level, batch_x, batch_z);
+        calm = batch->recent_edits < BATCH_HOT_EDITS && !batch_lod_covered(world->lod, batch);
+        if (calm && chunk_batch_ring_level(dist) >= level) {
+            batch->wanted_frame = batcher->frame;
+            batch->used_frame = batcher->frame;
+            if (batch->built) {
+                batcher_emit(batcher, batch, NULL);
+                return true;
+            }
+            fallback = true;
+            calm = false;
         }
+    } else if (batch->built && !batch_lod_covered(world->lod, batch)) {
+        batch->used_frame = batcher->frame;
+        batcher_emit(batcher, batch, NULL);
+        return true;
     }
 
-    // Create combined mesh
-    Mesh* target_mesh = transparent ? &batch->transparent_mesh : &batch->opaque_mesh;
-
-    // Unload old mesh if exists
-    if ((transparent ? batch->transparent_valid : batch->opaque_valid) && target_mesh->vboId != NULL) {
-        UnloadMesh(*target_mesh);
+    if (level == 1) {
+        for (int i = 0; i < 4; i++) {
+            Chunk* chunk = batch->chunks[i];
+            if (chunk && (chunk->mesh_generated || chunk->transparent_mesh_generated)) {
+                batcher_emit(batcher, NULL, chunk);
+            }
+        }
+        return !fallback;
     }
 
-    memset(target_mesh, 0, sizeof(Mesh));
-    target_mesh->vertexCount = total_vertices;
-    target_mesh->triangleCount = total_vertices / 3;
-    target_mesh->vertices = vertices;
-    target_mesh->texcoords = texcoords;
-    target_mesh->normals = normals;
-    target_mesh->colors = colors;
+    int mark = batcher->draw_count;
+    bool complete = !fallback;
+    for (int dz = 0; dz < 2; dz++) {
+        for (int dx = 0; dx < 2; dx++) {
+            complete &= select_batch(batcher, world, level - 1, batch_x * 2 + dx, batch_z * 2 + dz, fallback);
+        }
+    }
+    if (!complete && calm && batch->built && !batch->dirty) {
+        batcher->draw_count = mark;  // Children stay wanted and get built
+        batch->used_frame = batcher->frame;
+        batcher_emit(batcher, batch, NULL);
+        return true;
+    }
+    return complete;
+}
 
-    UploadMesh(target_mesh, false);
+/**
+ * Walk the largest batches of the view window
+ */
+static void batcher_select(ChunkBatcher* batcher, World* world) {
+    batcher->frame++;
+    batcher->draw_count = 0;
 
-    if (transparent) {
-        batch->transparent_valid = true;
-    } else {
-        batch->opaque_valid = true;
+    int view_dist = world_get_view_distance(world);
+    int min_x = chunk_lod_region_coord(world->center_chunk_x - view_dist, BATCH_LEVELS);
+    int max_x = chunk_lod_region_coord(world->center_chunk_x + view_dist, BATCH_LEVELS);
+    int min_z = chunk_lod_region_coord(world->center_chunk_z - view_dist, BATCH_LEVELS);
+    int max_z = chunk_lod_region_coord(world->center_chunk_z + view_dist, BATCH_LEVELS);
+
+    for (int bz = min_z; bz <= max_z; bz++) {
+        for (int bx = min_x; bx <= max_x; bx++) {
+            (void)select_batch(batcher, world, BATCH_LEVELS, bx, bz, false);
+        }
     }
 }
 
+/**
+ * Batch origin in world coordinates: the corner of its mesh cell
+ */
+static Vector3 batch_origin(const ChunkBatch* batch) {
+    int span = 1 << batch->level;
+    return chunk_mesh_origin(batch->batch_x * span, batch->batch_z * span);
+}
+
 // ============================================================================
 // PUBLIC API
 // ============================================================================
@@ -183,12 +427,19 @@ ChunkBatcher* chunk_batcher_create(void) {
     // Pre-allocate sort buffer for transparent rendering (avoids per-frame malloc)
     batcher->sort_buffer_capacity = 2048;
     batcher->sort_buffer = (SortEntry*)malloc(batcher->sort_buffer_capacity * sizeof(SortEntry));
-    if (!batcher->sort_buffer) {
+    batcher->sort_scratch = (SortEntry*)malloc(batcher->sort_buffer_capacity * sizeof(SortEntry));
+    if (!batcher->sort_buffer || !batcher->sort_scratch) {
         printf("[BATCHER] Warning: Failed to allocate sort buffer, will use per-frame allocation\n");
+        free(batcher->sort_buffer);
+        free(batcher->sort_scratch);
+        batcher->sort_buffer = NULL;
+        batcher->sort_scratch = NULL;
         batcher->sort_buffer_capacity = 0;
     }
+    memory_track(MEMORY_BATCHER, (ptrdiff_t)(2 * batcher->sort_buffer_capacity * sizeof(SortEntry)));
+    batcher->frame = 1;  // Fresh batches (wanted_frame 0) are not wanted before the first selection
 
-    printf("[BATCHER] Created chunk batcher (2x2 batching)\n");
+    printf("[BATCHER] Created chunk batcher (2x2 to %dx%d batching)\n", BATCH_MAX_SPAN, BATCH_MAX_SPAN);
     return batcher;
 }
 
@@ -196,367 +447,309 @@ void chunk_batcher_destroy(ChunkBatcher* batcher) {
     if (!batcher) return;
 
     // Free all batches
-    for (int i = 0; i < BATCH_MAX_COUNT; i++) {
+    for (int i = 0; i < BATCH_BUCKETS; i++) {
         BatchNode* node = batcher->buckets[i];
         while (node) {
             BatchNode* next = node->next;
 
             // Unload meshes
-            if (node->batch.opaque_valid && node->batch.opaque_mesh.vboId != NULL) {
-                UnloadMesh(node->batch.opaque_mesh);
-            }
-            if (node->batch.transparent_valid && node->batch.transparent_mesh.vboId != NULL) {
-                UnloadMesh(node->batch.transparent_mesh);
-            }
+            chunk_mesh_unload(&node->batch.opaque_mesh);
+            chunk_mesh_unload(&node->batch.transparent_mesh);
 
+            memory_track(MEMORY_BATCHER, -(ptrdiff_t)batch_node_bytes(node->batch.level));
             free(node);
             node = next;
         }
     }
 
-    // Free pre-allocated sort buffer
+    // Free pre-allocated sort buffer and the selection
+    memory_track(MEMORY_BATCHER, -(ptrdiff_t)(2 * batcher->sort_buffer_capacity * sizeof(SortEntry)));
+    memory_track(MEMORY_BATCHER, -(ptrdiff_t)((size_t)batcher->draw_capacity * sizeof(SortEntry)));
     if (batcher->sort_buffer) {
         free(batcher->sort_buffer);
     }
+    free(batcher->sort_scratch);
+    free(batcher->draws);
 
     free(batcher);
     printf("[BATCHER] Destroyed chunk batcher\n");
 }
 
-ChunkBatch* chunk_batcher_get_batch(ChunkBatcher* batcher, int chunk_x, int chunk_z) {
-    if (!batcher) return NULL;
+ChunkBatch* chunk_batcher_get_batch(ChunkBatcher* batcher, int level, int chunk_x, int chunk_z) {
+    if (!batcher || level < 1 || level > BATCH_LEVELS) return NULL;
 
-    int batch_x, batch_z;
-    chunk_to_batch_coords(chunk_x, chunk_z, &batch_x, &batch_z);
-
-    unsigned int hash = batch_hash(batch_x, batch_z);
-    BatchNode* node = batcher->buckets[hash];
+    int batch_x = chunk_lod_region_coord(chunk_x, level);
+    int batch_z = chunk_lod_region_coord(chunk_z, level);
 
     // Search for existing batch
-    while (node) {
-        if (node->batch.batch_x == batch_x && node->batch.batch_z == batch_z) {
-            return &node->batch;
-        }
-        node = node->next;
-    }
+    ChunkBatch* existing = batcher_find(batcher, level, batch_x, batch_z);
+    if (existing) return existing;
 
-    // Create new batch
-    BatchNode* new_node = (BatchNode*)calloc(1, sizeof(BatchNode));
+    // Create new batch with its per-chunk arrays behind the node
+    size_t bytes = batch_node_bytes(level);
+    BatchNode* new_node = (BatchNode*)calloc(1, bytes);
     if (!new_node) return NULL;
-
-    new_node->batch.batch_x = batch_x;
-    new_node->batch.batch_z = batch_z;
-    new_node->batch.dirty = true;
+    memory_track(MEMORY_BATCHER, (ptrdiff_t)bytes);
+
+    size_t cells = (size_t)1 << (2 * level);
+    ChunkBatch* batch = &new_node->batch;
+    batch->level = level;
+    batch->batch_x = batch_x;
+    batch->batch_z = batch_z;
+    batch->chunks = (Chunk**)(new_node + 1);
+    batch->opaque_slots = (BatchSlotRange*)(batch->chunks + cells);
+    batch->transparent_slots = batch->opaque_slots + cells;
+    batch->dirty = true;
+
+    unsigned int hash = batch_hash(level, batch_x, batch_z);
     new_node->next = batcher->buckets[hash];
     batcher->buckets[hash] = new_node;
     batcher->batch_count++;
     batcher->dirty_count++;
 
-    return &new_node->batch;
+    return batch;
 }
 
 void chunk_batcher_register_chunk(ChunkBatcher* batcher, Chunk* chunk) {
     if (!batcher || !chunk) return;
 
-    ChunkBatch* batch = chunk_batcher_get_batch(batcher, chunk->x, chunk->z);
-    if (!batch) return;
-
-    // Calculate position within batch
-    int bx = chunk->x - batch->batch_x * BATCH_SIZE;
-    int bz = chunk->z - batch->batch_z * BATCH_SIZE;
+    for (int level = 1; level <= BATCH_LEVELS; level++) {
+        ChunkBatch* batch = chunk_batcher_get_batch(batcher, level, chunk->x, chunk->z);
+        if (!batch) continue;
 
-    // Handle negative coordinates
-    if (bx < 0) bx += BATCH_SIZE;
-    if (bz < 0) bz += BATCH_SIZE;
-
-    if (bx >= 0 && bx < BATCH_SIZE && bz >= 0 && bz < BATCH_SIZE) {
-        if (batch->chunks[bx][bz] == NULL) {
+        int slot = batch_slot(batch, chunk->x, chunk->z);
+        if (batch->chunks[slot] == NULL) {
             batch->chunk_count++;
         }
-        batch->chunks[bx][bz] = chunk;
-        if (!batch->dirty) {
-            batch->dirty = true;
-            batcher->dirty_count++;
-        }
+        batch->chunks[slot] = chunk;
+        batch_mark_dirty(batcher, batch);
     }
 }
 
 void chunk_batcher_unregister_chunk(ChunkBatcher* batcher, Chunk* chunk) {
     if (!batcher || !chunk) return;
 
-    int batch_x, batch_z;
-    chunk_to_batch_coords(chunk->x, chunk->z, &batch_x, &batch_z);
+    batcher->draw_count = 0;  // May point at the chunk or a freed batch; reselected next render
 
-    unsigned int hash = batch_hash(batch_x, batch_z);
-    BatchNode* node = batcher->buckets[hash];
+    for (int level = 1; level <= BATCH_LEVELS; level++) {
+        int batch_x = chunk_lod_region_coord(chunk->x, level);
+        int batch_z = chunk_lod_region_coord(chunk->z, level);
 
-    while (node) {
-        if (node->batch.batch_x == batch_x && node->batch.batch_z == batch_z) {
-            int bx = chunk->x - batch_x * BATCH_SIZE;
-            int bz = chunk->z - batch_z * BATCH_SIZE;
-            if (bx < 0) bx += BATCH_SIZE;
-            if (bz < 0) bz += BATCH_SIZE;
-
-            if (bx >= 0 && bx < BATCH_SIZE && bz >= 0 && bz < BATCH_SIZE) {
-                if (node->batch.chunks[bx][bz] != NULL) {
-                    node->batch.chunk_count--;
-                }
-                node->batch.chunks[bx][bz] = NULL;
-                if (!node->batch.dirty) batcher->dirty_count++;
-                node->batch.dirty = true;
+        BatchNode** pp = &batcher->buckets[batch_hash(level, batch_x, batch_z)];
+        while (*pp) {
+            BatchNode* node = *pp;
+            ChunkBatch* batch = &node->batch;
+            if (batch->level != level || batch->batch_x != batch_x || batch->batch_z != batch_z) {
+                pp = &node->next;
+                continue;
+            }
+
+            int slot = batch_slot(batch, chunk->x, chunk->z);
+            if (batch->chunks[slot] == chunk) {
+                batch->chunk_count--;
+                batch->chunks[slot] = NULL;
             }
-            return;
+            batch_mark_dirty(batcher, batch);
+
+            // Last chunk gone: free the batch and its GPU meshes
+            if (batch->chunk_count <= 0) {
+                chunk_mesh_unload(&batch->opaque_mesh);
+                chunk_mesh_unload(&batch->transparent_mesh);
+                batcher->dirty_count--;
+                *pp = node->next;
+                memory_track(MEMORY_BATCHER, -(ptrdiff_t)batch_node_bytes(level));
+                free(node);
+                batcher->batch_count--;
+            }
+            break;
         }
-        node = node->next;
     }
 }
 
 void chunk_batcher_invalidate(ChunkBatcher* batcher, int chunk_x, int chunk_z) {
     if (!batcher) return;
 
-    ChunkBatch* batch = chunk_batcher_get_batch(batcher, chunk_x, chunk_z);
-    if (batch && !batch->dirty) {
-        batch->dirty = true;
-        batcher->dirty_count++;
+    for (int level = 1; level <= BATCH_LEVELS; level++) {
+        ChunkBatch* batch = batcher_find(batcher, level, chunk_lod_region_coord(chunk_x, level),
+                                         chunk_lod_region_coord(chunk_z, level));
+        if (batch) batch_mark_dirty(batcher, batch);
     }
 }
 
-void chunk_batcher_update(ChunkBatcher* batcher, int max_rebuilds) {
-    if (!batcher || batcher->dirty_count == 0) return;
+bool chunk_batcher_splice_chunk(ChunkBatcher* batcher, Chunk* chunk) {
+    if (!batcher || !chunk) return false;
 
-    // Use default if not specified
-    if (max_rebuilds <= 0) max_rebuilds = BATCH_REBUILDS_PER_FRAME;
+    bool spliced = true;
+    for (int level = 1; level <= BATCH_LEVELS; level++) {
+        ChunkBatch* batch = batcher_find(batcher, level, chunk_lod_region_coord(chunk->x, level),
+                                         chunk_lod_region_coord(chunk->z, level));
+        if (!batch) {
+            spliced = false;
+            continue;
+        }
 
-    int rebuilt = 0;
+        batch->recent_edits += 1.0f;
+        if (!batch->built || batch->dirty) continue;  // Pending rebuild will pick up the new mesh
 
-    for (int i = 0; i < BATCH_MAX_COUNT && rebuilt < max_rebuilds; i++) {
-        BatchNode* node = batcher->buckets[i];
-        while (node && rebuilt < max_rebuilds) {
-            if (node->batch.dirty) {
-                // Rebuild both meshes
-                build_batch_mesh(&node->batch, false);  // Opaque
-                build_batch_mesh(&node->batch, true);   // Transparent
+        int slot = batch_slot(batch, chunk->x, chunk->z);
+        if (batch->chunks[slot] != chunk ||
+            !splice_batch_mesh(batch, false, slot, chunk) ||
+            !splice_batch_mesh(batch, true, slot, chunk)) {
+            spliced = false;
+        }
+    }
+    return spliced;
+}
 
-                node->batch.dirty = false;
-                batcher->dirty_count--;
-                rebuilt++;
+/**
+ * Rebuild order: nearest first, recently edited batches ahead of calm ones
+ */
+static int compare_rebuild_entries(const void* a, const void* b) {
+    const SortEntry* ea = (const SortEntry*)a;
+    const SortEntry* eb = (const SortEntry*)b;
+    if (ea->dist_sq < eb->dist_sq) return -1;
+    if (ea->dist_sq > eb->dist_sq) return 1;
+    return 0;
+}
+
+int chunk_batcher_update(ChunkBatcher* batcher, World* world, int max_rebuilds, UploadBudget* budget) {
+    if (!batcher || !world) return 0;
+
+    // Use default if not specified
+    if (max_rebuilds <= 0) max_rebuilds = BATCH_REBUILDS_PER_FRAME;
+
+    // Decay edits, drop unused meshes, and queue the wanted dirty batches
+    // in the selection buffer (refilled by the next render)
+    batcher->draw_count = 0;
+    for (int i = 0; i < BATCH_BUCKETS; i++) {
+        for (BatchNode* node = batcher->buckets[i]; node; node = node->next) {
+            ChunkBatch* batch = &node->batch;
+            batch->recent_edits *= BATCH_EDIT_DECAY;
+            if (batch->built && batcher->frame - batch->used_frame > BATCH_KEEP_FRAMES) {
+                batch_evict(batcher, batch);
             }
-            node = node->next;
+            if (!batch->dirty || batch->wanted_frame != batcher->frame) continue;
+
+            int before = batcher->draw_count;
+            batcher_emit(batcher, batch, NULL);
+            if (batcher->draw_count == before) continue;  // OOM, queued again next frame
+            int dist = chunk_lod_region_distance(world->center_chunk_x, world->center_chunk_z,
+                                                 batch->level, batch->batch_x, batch->batch_z);
+            batcher->draws[batcher->draw_count - 1].dist_sq = (float)dist / (1.0f + batch->recent_edits);
         }
     }
+    int queued = batcher->draw_count;
+    batcher->draw_count = 0;
+    if (queued == 0) return 0;
+    qsort(batcher->draws, (size_t)queued, sizeof(SortEntry), compare_rebuild_entries);
+
+    int rebuilt = 0;
+    for (int i = 0; i < queued && rebuilt < max_rebuilds; i++) {
+        ChunkBatch* batch = batcher->draws[i].batch;
+        size_t bytes = (size_t)(count_batch_vertices(batch, false) +
+                                count_batch_vertices(batch, true)) * sizeof(ChunkVertex);
+        if (!upload_budget_allows(budget, bytes)) break;
+
+        // Rebuild both meshes
+        build_batch_mesh(batch, false);  // Opaque
+        build_batch_mesh(batch, true);   // Transparent
+        upload_budget_spend(budget, bytes);
+
+        batch->built = true;
+        batch->dirty = false;
+        batcher->dirty_count--;
+        rebuilt++;
+    }
+    return rebuilt;
 }
 
 void chunk_batcher_render_opaque(ChunkBatcher* batcher, World* world,
                                   Material material, Vector3 camera_pos) {
-    (void)camera_pos;  // Suppress unused warning
+    (void)camera_pos;  // Visibility comes from world->culler
     if (!batcher || !world) return;
 
-    int view_dist = world_get_view_distance(world);
-    int center_x = world->center_chunk_x;
-    int center_z = world->center_chunk_z;
-
-    // Calculate batch view distance
-    int batch_view_dist = (view_dist / BATCH_SIZE) + 1;
-
-    int center_batch_x, center_batch_z;
-    chunk_to_batch_coords(center_x, center_z, &center_batch_x, &center_batch_z);
-
-    int rendered_batches = 0;
-    int rendered_chunks = 0;
-    int missing_batches = 0;
-
-    for (int bz = -batch_view_dist; bz <= batch_view_dist; bz++) {
-        for (int bx = -batch_view_dist; bx <= batch_view_dist; bx++) {
-            int batch_x = center_batch_x + bx;
-            int batch_z = center_batch_z + bz;
-
-            unsigned int hash = batch_hash(batch_x, batch_z);
-            BatchNode* node = batcher->buckets[hash];
-
-            bool found = false;
-            while (node) {
-                if (node->batch.batch_x == batch_x && node->batch.batch_z == batch_z) {
-                    found = true;
-                    if (node->batch.opaque_valid && node->batch.opaque_mesh.vboId != NULL) {
-                        // Batch origin in world coordinates
-                        float origin_x = (float)(batch_x * BATCH_SIZE * CHUNK_SIZE);
-                        float origin_z = (float)(batch_z * BATCH_SIZE * CHUNK_SIZE);
-
-                        Matrix transform = MatrixTranslate(origin_x, 0.0f, origin_z);
-                        DrawMesh(node->batch.opaque_mesh, material, transform);
-                        rendered_batches++;
-                    } else {
-                        // Fallback: render individual chunks when batch not built yet
-                        for (int cbz = 0; cbz < BATCH_SIZE; cbz++) {
-                            for (int cbx = 0; cbx < BATCH_SIZE; cbx++) {
-                                Chunk* chunk = node->batch.chunks[cbx][cbz];
-                                if (chunk && chunk->mesh_generated && chunk->mesh.vboId != NULL) {
-                                    float origin_x = (float)(chunk->x * CHUNK_SIZE);
-                                    float origin_z = (float)(chunk->z * CHUNK_SIZE);
-                                    Matrix transform = MatrixTranslate(origin_x, 0.0f, origin_z);
-                                    DrawMesh(chunk->mesh, material, transform);
-                                    rendered_chunks++;
-                                }
-                            }
-                        }
-                    }
-                    break;
-                }
-                node = node->next;
+    batcher_select(batcher, world);
+
+    chunk_mesh_begin(material);
+    for (int i = 0; i < batcher->draw_count; i++) {
+        const SortEntry* entry = &batcher->draws[i];
+        if (entry->is_batch) {
+            ChunkBatch* batch = entry->batch;
+            if (batch->opaque_valid && batch_visible(batch, world->culler)) {
+                chunk_mesh_draw(&batch->opaque_mesh, batch_origin(batch));
             }
-            if (!found) {
-                missing_batches++;
-                // Fallback: try to render chunks at this batch position directly from world
-                for (int cbz = 0; cbz < BATCH_SIZE; cbz++) {
-                    for (int cbx = 0; cbx < BATCH_SIZE; cbx++) {
-                        int chunk_x = batch_x * BATCH_SIZE + cbx;
-                        int chunk_z = batch_z * BATCH_SIZE + cbz;
-                        Chunk* chunk = world_get_chunk(world, chunk_x, chunk_z);
-                        if (chunk && chunk->mesh_generated && chunk->mesh.vboId != NULL) {
-                            float origin_x = (float)(chunk->x * CHUNK_SIZE);
-                            float origin_z = (float)(chunk->z * CHUNK_SIZE);
-                            Matrix transform = MatrixTranslate(origin_x, 0.0f, origin_z);
-                            DrawMesh(chunk->mesh, material, transform);
-                            rendered_chunks++;
-                        }
-                    }
-                }
+        } else {
+            Chunk* chunk = entry->chunk;
+            if (chunk->mesh_generated && chunk_culler_chunk_visible(world->culler, chunk)) {
+                chunk_mesh_draw(&chunk->mesh, chunk_mesh_origin(chunk->x, chunk->z));
             }
         }
     }
-
-    // Debug output (uncomment to enable):
-    // static int frame = 0;
-    // if (++frame % 60 == 0) {
-    //     printf("[BATCHER] batches=%d chunks=%d missing=%d\n",
-    //            rendered_batches, rendered_chunks, missing_batches);
-    //     fflush(stdout);
-    // }
-    (void)rendered_batches; (void)rendered_chunks; (void)missing_batches;  // Suppress warnings
+    chunk_mesh_end();
 }
 
 void chunk_batcher_render_transparent(ChunkBatcher* batcher, World* world,
                                        Material material, Vector3 camera_pos) {
     if (!batcher || !world) return;
 
-    int view_dist = world_get_view_distance(world);
-    int center_x = world->center_chunk_x;
-    int center_z = world->center_chunk_z;
-
-    int batch_view_dist = (view_dist / BATCH_SIZE) + 1;
-
-    int center_batch_x, center_batch_z;
-    chunk_to_batch_coords(center_x, center_z, &center_batch_x, &center_batch_z);
-
     // Use pre-allocated buffer if available, fallback to malloc
     SortEntry* entries;
     bool needs_free = false;
+    int max_entries;
     if (batcher->sort_buffer && batcher->sort_buffer_capacity > 0) {
         entries = batcher->sort_buffer;
+        max_entries = batcher->sort_buffer_capacity;
     } else {
-        entries = (SortEntry*)malloc(BATCH_MAX_COUNT * 4 * sizeof(SortEntry));
+        if (batcher->draw_count == 0) return;
+        entries = (SortEntry*)malloc((size_t)batcher->draw_count * sizeof(SortEntry));
         if (!entries) return;
         needs_free = true;
+        max_entries = batcher->draw_count;
     }
-    int max_entries = batcher->sort_buffer_capacity > 0 ? batcher->sort_buffer_capacity : (BATCH_MAX_COUNT * 4);
 
+    // Same selection as the opaque pass
     int count = 0;
-
-    for (int bz = -batch_view_dist; bz <= batch_view_dist; bz++) {
-        for (int bx = -batch_view_dist; bx <= batch_view_dist; bx++) {
-            int batch_x = center_batch_x + bx;
-            int batch_z = center_batch_z + bz;
-
-            unsigned int hash = batch_hash(batch_x, batch_z);
-            BatchNode* node = batcher->buckets[hash];
-
-            bool found = false;
-            while (node) {
-                if (node->batch.batch_x == batch_x && node->batch.batch_z == batch_z) {
-                    found = true;
-                    if (node->batch.transparent_valid && node->batch.transparent_mesh.vboId != NULL) {
-                        if (count < max_entries) {
-                            float cx = (batch_x * BATCH_SIZE + BATCH_SIZE / 2.0f) * CHUNK_SIZE;
-                            float cz = (batch_z * BATCH_SIZE + BATCH_SIZE / 2.0f) * CHUNK_SIZE;
-                            float dx = cx - camera_pos.x;
-                            float dz = cz - camera_pos.z;
-
-                            entries[count].batch = &node->batch;
-                            entries[count].dist_sq = dx * dx + dz * dz;
-                            entries[count].is_batch = true;
-                            count++;
-                        }
-                    } else {
-                        // Fallback: add individual chunks from batch
-                        for (int cbz = 0; cbz < BATCH_SIZE && count < max_entries; cbz++) {
-                            for (int cbx = 0; cbx < BATCH_SIZE && count < max_entries; cbx++) {
-                                Chunk* chunk = node->batch.chunks[cbx][cbz];
-                                if (chunk && chunk->transparent_mesh_generated &&
-                                    chunk->transparent_mesh.vboId != NULL) {
-                                    float cx = (chunk->x + 0.5f) * CHUNK_SIZE;
-                                    float cz = (chunk->z + 0.5f) * CHUNK_SIZE;
-                                    float dx = cx - camera_pos.x;
-                                    float dz = cz - camera_pos.z;
-
-                                    entries[count].chunk = chunk;
-                                    entries[count].dist_sq = dx * dx + dz * dz;
-                                    entries[count].is_batch = false;
-                                    count++;
-                                }
-                            }
-                        }
-                    }
-                    break;
-                }
-                node = node->next;
-            }
-
-            // If no batch found, try to find chunks directly from world
-            if (!found) {
-                for (int cbz = 0; cbz < BATCH_SIZE && count < max_entries; cbz++) {
-                    for (int cbx = 0; cbx < BATCH_SIZE && count < max_entries; cbx++) {
-                        int chunk_x = batch_x * BATCH_SIZE + cbx;
-                        int chunk_z = batch_z * BATCH_SIZE + cbz;
-                        Chunk* chunk = world_get_chunk(world, chunk_x, chunk_z);
-                        if (chunk && chunk->transparent_mesh_generated &&
-                            chunk->transparent_mesh.vboId != NULL) {
-                            float cx = (chunk->x + 0.5f) * CHUNK_SIZE;
-                            float cz = (chunk->z + 0.5f) * CHUNK_SIZE;
-                            float dx = cx - camera_pos.x;
-                            float dz = cz - camera_pos.z;
-
-                            entries[count].chunk = chunk;
-                            entries[count].dist_sq = dx * dx + dz * dz;
-                            entries[count].is_batch = false;
-                            count++;
-                        }
-                    }
-                }
-            }
+    for (int i = 0; i < batcher->draw_count && count < max_entries; i++) {
+        SortEntry entry = batcher->draws[i];
+        float cx, cz;
+        if (entry.is_batch) {
+            ChunkBatch* batch = entry.batch;
+            if (!batch->transparent_valid || !batch_visible(batch, world->culler)) continue;
+            int span = 1 << batch->level;
+            cx = (batch->batch_x * span + span / 2.0f) * CHUNK_SIZE;
+            cz = (batch->batch_z * span + span / 2.0f) * CHUNK_SIZE;
+        } else {
+            Chunk* chunk = entry.chunk;
+            if (!chunk->transparent_mesh_generated || !chunk_culler_chunk_visible(world->culler, chunk)) continue;
+            cx = (chunk->x + 0.5f) * CHUNK_SIZE;
+            cz = (chunk->z + 0.5f) * CHUNK_SIZE;
         }
+        float dx = cx - camera_pos.x;
+        float dz = cz - camera_pos.z;
+        entry.dist_sq = dx * dx + dz * dz;
+        entries[count++] = entry;
     }
 
-    // Sort back-to-front using qsort (O(n log n) vs O(n²) bubble sort)
-    if (count > 1) {
+    // Sort back-to-front: incrementally from last frame's order, or a full
+    // qsort when running without the pre-allocated buffers
+    if (!needs_free) {
+        order_sort_entries(batcher, entries, count);
+    } else if (count > 1) {
         qsort(entries, count, sizeof(SortEntry), compare_sort_entries);
     }
 
     // Render sorted
+    chunk_mesh_begin(material);
     for (int i = 0; i < count; i++) {
         if (entries[i].is_batch) {
             ChunkBatch* batch = entries[i].batch;
-            float origin_x = (float)(batch->batch_x * BATCH_SIZE * CHUNK_SIZE);
-            float origin_z = (float)(batch->batch_z * BATCH_SIZE * CHUNK_SIZE);
-            Matrix transform = MatrixTranslate(origin_x, 0.0f, origin_z);
-            DrawMesh(batch->transparent_mesh, material, transform);
+            chunk_mesh_draw(&batch->transparent_mesh, batch_origin(batch));
         } else {
             Chunk* chunk = entries[i].chunk;
-            float origin_x = (float)(chunk->x * CHUNK_SIZE);
-            float origin_z = (float)(chunk->z * CHUNK_SIZE);
-            Matrix transform = MatrixTranslate(origin_x, 0.0f, origin_z);
-            DrawMesh(chunk->transparent_mesh, material, transform);
+            chunk_mesh_draw(&chunk->transparent_mesh, chunk_mesh_origin(chunk->x, chunk->z));
         }
     }
+    chunk_mesh_end();
 
     if (needs_free) {
         free(entries);
@@ -0,0 +1,243 @@
+/**
+ * Chunk Culler Implementation
+ *
+ * Breadth-first walk over 16x16x16 sections ("cave culling"). Unloaded
+ * columns count as open space so the walk is never stopped by missing data.
+ */
+
+#include "voxel/render/chunk_culler.h"
+#include "voxel/world/world.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <raymath.h>
+#include <rlgl.h>
+
+#define CULL_NO_FACE 6
+
+// ============================================================================
+// FRUSTUM
+// ============================================================================
+
+static Vector4 normalize_plane(float a, float b, float c, float d) {
+    float len = sqrtf(a * a + b * b + c * c);
+    if (len > 0.0f) {
+        a /= len; b /= len; c /= len; d /= len;
+    }
+    return (Vector4){ a, b, c, d };
+}
+
+// Gribb/Hartmann plane extraction; raylib matrices are shader-ready:
+// row i of the math matrix is (m[i], m[i+4], m[i+8], m[i+12])
+Frustum frustum_from_matrix(Matrix m) {
+    Frustum f;
+    f.planes[0] = normalize_plane(m.m3 + m.m0, m.m7 + m.m4, m.m11 + m.m8, m.m15 + m.m12);   // Left
+    f.planes[1] = normalize_plane(m.m3 - m.m0, m.m7 - m.m4, m.m11 - m.m8, m.m15 - m.m12);   // Right
+    f.planes[2] = normalize_plane(m.m3 + m.m1, m.m7 + m.m5, m.m11 + m.m9, m.m15 + m.m13);   // Bottom
+    f.planes[3] = normalize_plane(m.m3 - m.m1, m.m7 - m.m5, m.m11 - m.m9, m.m15 - m.m13);   // Top
+    f.planes[4] = normalize_plane(m.m3 + m.m2, m.m7 + m.m6, m.m11 + m.m10, m.m15 + m.m14);  // Near
+    f.planes[5] = normalize_plane(m.m3 - m.m2, m.m7 - m.m6, m.m11 - m.m10, m.m15 - m.m14);  // Far
+    return f;
+}
+
+bool frustum_box_visible(const Frustum* f, Vector3 min, Vector3 max) {
+    for (int i = 0; i < 6; i++) {
+        Vector4 p = f->planes[i];
+        // Corner furthest along the plane normal
+        float x = p.x >= 0.0f ? max.x : min.x;
+        float y = p.y >= 0.0f ? max.y : min.y;
+        float z = p.z >= 0.0f ? max.z : min.z;
+        if (p.x * x + p.y * y + p.z * z + p.w < 0.0f) return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// WINDOW HELPERS
+// ============================================================================
+
+static bool ensure_window(ChunkCuller* culler, int size) {
+    int columns = size * size;
+    if (columns <= culler->capacity) return true;
+
+    Chunk** chunks = (Chunk**)realloc(culler->columns, (size_t)columns * sizeof(Chunk*));
+    if (!chunks) return false;
+    culler->columns = chunks;
+    uint16_t* visible = (uint16_t*)realloc(culler->visible, (size_t)columns * sizeof(uint16_t));
+    if (!visible) return false;
+    culler->visible = visible;
+    uint16_t* visited = (uint16_t*)realloc(culler->visited, (size_t)columns * sizeof(uint16_t));
+    if (!visited) return false;
+    culler->visited = visited;
+    CullNode* queue = (CullNode*)realloc(culler->queue, (size_t)columns * CHUNK_SECTION_COUNT * sizeof(CullNode));
+    if (!queue) return false;
+    culler->queue = queue;
+
+    culler->capacity = columns;
+    return true;
+}
+
+static bool section_in_frustum(const ChunkCuller* culler, int column, int section) {
+    int cx = culler->center_x - culler->radius + column % culler->size;
+    int cz = culler->center_z - culler->radius + column / culler->size;
+    Vector3 min = { (float)(cx * CHUNK_SIZE), (float)(section * CHUNK_SECTION_HEIGHT), (float)(cz * CHUNK_SIZE) };
+    Vector3 max = { min.x + CHUNK_SIZE, min.y + CHUNK_SECTION_HEIGHT, min.z + CHUNK_SIZE };
+    return frustum_box_visible(&culler->frustum, min, max);
+}
+
+/**
+ * Frustum only: every section inside the view volume is visible
+ */
+static void mark_frustum_sections(ChunkCuller* culler) {
+    int count = 0;
+    for (int column = 0; column < culler->size * culler->size; column++) {
+        uint16_t mask = 0;
+        for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+            if (section_in_frustum(culler, column, sy)) mask |= (uint16_t)(1u << sy);
+        }
+        culler->visible[column] = mask;
+        count += __builtin_popcount(mask);
+    }
+    culler->visible_sections = count;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+ChunkCuller* chunk_culler_create(void) {
+    ChunkCuller* culler = (ChunkCuller*)calloc(1, sizeof(ChunkCuller));
+    if (!culler) {
+        printf("[CULLER] Failed to allocate culler\n");
+        return NULL;
+    }
+    culler->occlusion = true;
+    return culler;
+}
+
+void chunk_culler_destroy(ChunkCuller* culler) {
+    if (!culler) return;
+    free(culler->columns);
+    free(culler->visible);
+    free(culler->visited);
+    free(culler->queue);
+    free(culler);
+}
+
+void chunk_culler_update(ChunkCuller* culler, World* world, Vector3 camera_pos) {
+    if (!culler || !world) return;
+
+    Matrix view_projection = MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection());
+    culler->frustum = frustum_from_matrix(view_projection);
+
+    // One ring past the view distance, matching what the renderers draw
+    int radius = world_get_view_distance(world) + 1;
+    int size = 2 * radius + 1;
+    if (!ensure_window(culler, size)) {
+        culler->size = 0;  // chunk_culler_sections reports everything visible
+        return;
+    }
+    culler->center_x = world->center_chunk_x;
+    culler->center_z = world->center_chunk_z;
+    culler->radius = radius;
+    culler->size = size;
+
+    int columns = size * size;
+    for (int column = 0; column < columns; column++) {
+        int cx = culler->center_x - radius + column % size;
+        int cz = culler->center_z - radius + column / size;
+        culler->columns[column] = world_get_chunk(world, cx, cz);
+    }
+    memset(culler->visible, 0, (size_t)columns * sizeof(uint16_t));
+    memset(culler->visited, 0, (size_t)columns * sizeof(uint16_t));
+
+    int camera_cx, camera_cz;
+    world_to_chunk_coords((int)floorf(camera_pos.x), (int)floorf(camera_pos.z), &camera_cx, &camera_cz);
+    int start_x = camera_cx - culler->center_x + radius;
+    int start_z = camera_cz - culler->center_z + radius;
+    if (!culler->occlusion || start_x < 0 || start_x >= size || start_z < 0 || start_z >= size) {
+        mark_frustum_sections(culler);
+        return;
+    }
+
+    int start_section = (int)floorf(camera_pos.y) / CHUNK_SECTION_HEIGHT;
+    if (start_section < 0) start_section = 0;
+    if (start_section >= CHUNK_SECTION_COUNT) start_section = CHUNK_SECTION_COUNT - 1;
+
+    int head = 0, tail = 0;
+    int start_column = start_z * size + start_x;
+    culler->queue[tail++] = (CullNode){ start_column, (uint8_t)start_section, CULL_NO_FACE, 0 };
+    culler->visited[start_column] |= (uint16_t)(1u << start_section);
+    culler->visible[start_column] |= (uint16_t)(1u << start_section);
+    int count = 1;
+
+    while (head < tail) {
+        CullNode node = culler->queue[head++];
+        Chunk* chunk = culler->columns[node.column];
+        uint64_t visibility = chunk ? chunk->section_visibility[node.section] : SECTION_VISIBILITY_ALL;
+        int x = node.column % size;
+        int z = node.column / size;
+
+        for (int face = 0; face < 6; face++) {
+            // Never step back toward the camera (BlockFace pairs are opposites: f ^ 1)
+            if (node.directions & (1 << (face ^ 1))) continue;
+            if (node.entry_face != CULL_NO_FACE &&
+                !section_faces_connected(visibility, node.entry_face, face)) continue;
+
+            int nx = x, nz = z, ny = node.section;
+            switch (face) {
+                case FACE_TOP:    ny++; break;
+                case FACE_BOTTOM: ny--; break;
+                case FACE_FRONT:  nz--; break;
+                case FACE_BACK:   nz++; break;
+                case FACE_LEFT:   nx--; break;
+                case FACE_RIGHT:  nx++; break;
+            }
+            if (nx < 0 || nx >= size || nz < 0 || nz >= size) continue;
+            if (ny < 0 || ny >= CHUNK_SECTION_COUNT) continue;
+
+            int column = nz * size + nx;
+            uint16_t bit = (uint16_t)(1u << ny);
+            if (culler->visited[column] & bit) continue;
+            culler->visited[column] |= bit;
+            if (!section_in_frustum(culler, column, ny)) continue;
+
+            culler->visible[column] |= bit;
+            count++;
+            culler->queue[tail++] = (CullNode){ column, (uint8_t)ny, (uint8_t)(face ^ 1),
+                                                (uint8_t)(node.directions | (1 << face)) };
+        }
+    }
+    culler->visible_sections = count;
+}
+
+uint16_t chunk_culler_sections(const ChunkCuller* culler, int chunk_x, int chunk_z) {
+    if (!culler || culler->size == 0) return CHUNK_SECTIONS_ALL;
+
+    int x = chunk_x - culler->center_x + culler->radius;
+    int z = chunk_z - culler->center_z + culler->radius;
+    if (x < 0 || x >= culler->size || z < 0 || z >= culler->size) return 0;
+    return culler->visible[z * culler->size + x];
+}
+
+void chunk_culler_hide_chunk(ChunkCuller* culler, int chunk_x, int chunk_z) {
+    if (!culler || culler->size == 0) return;
+
+    int x = chunk_x - culler->center_x + culler->radius;
+    int z = chunk_z - culler->center_z + culler->radius;
+    if (x < 0 || x >= culler->size || z < 0 || z >= culler->size) return;
+    culler->visible[z * culler->size + x] = 0;
+}
+
+bool chunk_culler_box_visible(const ChunkCuller* culler, Vector3 min, Vector3 max) {
+    if (!culler || culler->size == 0) return true;
+    return frustum_box_visible(&culler->frustum, min, max);
+}
+
+bool chunk_culler_chunk_visible(const ChunkCuller* culler, const Chunk* chunk) {
+    if (!chunk || chunk->min_block_y > chunk->max_block_y) return false;  // No blocks
+    Vector3 min = { (float)(chunk->x * CHUNK_SIZE), (float)chunk->min_block_y, (float)(chunk->z * CHUNK_SIZE) };
+    Vector3 max = { min.x + CHUNK_SIZE, (float)chunk->max_block_y + 1.0f, min.z + CHUNK_SIZE };
+    return chunk_culler_box_visible(culler, min, max) && chunk_culler_sections(culler, chunk->x, chunk->z) != 0;
+}
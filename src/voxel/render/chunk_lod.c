@@ -0,0 +1,571 @@
+/**
+ * Chunk LOD Implementation
+ *
+ * Region selection, lazy region builds from chunk LOD cells, and drawing
+ */
+
+#include "voxel/render/chunk_lod.h"
+#include "voxel/render/chunk_culler.h"
+#include "voxel/render/light.h"
+#include "voxel/world/world.h"
+#include "voxel/core/block.h"
+#include "voxel/core/memory.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define LOD_VOLUME_HEIGHT (CHUNK_HEIGHT / 2)  // Cell rows at level 1, the tallest level
+#define LOD_VERTICES_INITIAL 16384
+
+// Corner offsets v1..v4 per BlockFace, same winding as the chunk mesher
+static const int lod_face_corners[6][4][3] = {
+    { {0, 1, 0}, {1, 1, 0}, {1, 1, 1}, {0, 1, 1} },  // FACE_TOP
+    { {0, 0, 1}, {1, 0, 1}, {1, 0, 0}, {0, 0, 0} },  // FACE_BOTTOM
+    { {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0} },  // FACE_FRONT (-Z)
+    { {1, 0, 1}, {0, 0, 1}, {0, 1, 1}, {1, 1, 1} },  // FACE_BACK (+Z)
+    { {0, 0, 1}, {0, 0, 0}, {0, 1, 0}, {0, 1, 1} },  // FACE_LEFT (-X)
+    { {1, 0, 0}, {1, 0, 1}, {1, 1, 1}, {1, 1, 0} },  // FACE_RIGHT (+X)
+};
+
+static const int lod_face_offsets[6][3] = {
+    { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, -1 }, { 0, 0, 1 }, { -1, 0, 0 }, { 1, 0, 0 }
+};
+
+// ============================================================================
+// REGION MAP
+// ============================================================================
+
+static unsigned int region_hash(int level, int region_x, int region_z) {
+    unsigned int h = (unsigned int)(region_x * 73856093) ^ (unsigned int)(region_z * 19349663) ^
+                     (unsigned int)(level * 83492791);
+    return h % LOD_REGION_BUCKETS;
+}
+
+static LodRegion* lod_find(const ChunkLod* lod, int level, int region_x, int region_z) {
+    LodRegion* region = lod->buckets[region_hash(level, region_x, region_z)];
+    while (region) {
+        if (region->level == level && region->region_x == region_x && region->region_z == region_z) {
+            return region;
+        }
+        region = region->next;
+    }
+    return NULL;
+}
+
+/**
+ * Find a region or add an empty (unbuilt) one
+ */
+static LodRegion* lod_get_or_create(ChunkLod* lod, int level, int region_x, int region_z) {
+    LodRegion* region = lod_find(lod, level, region_x, region_z);
+    if (region) return region;
+
+    region = (LodRegion*)calloc(1, sizeof(LodRegion));
+    if (!region) return NULL;
+    region->level = level;
+    region->region_x = region_x;
+    region->region_z = region_z;
+    region->drawn_frame = -1;
+
+    unsigned int bucket = region_hash(level, region_x, region_z);
+    region->next = lod->buckets[bucket];
+    lod->buckets[bucket] = region;
+    lod->region_count++;
+    return region;
+}
+
+static void lod_free_region(LodRegion* region) {
+    chunk_mesh_unload(&region->opaque_mesh);
+    chunk_mesh_unload(&region->transparent_mesh);
+    free(region);
+}
+
+/**
+ * Drop regions the selection has not reached for LOD_REGION_KEEP_FRAMES
+ */
+static void lod_evict(ChunkLod* lod) {
+    for (int b = 0; b < LOD_REGION_BUCKETS; b++) {
+        LodRegion** link = &lod->buckets[b];
+        while (*link) {
+            LodRegion* region = *link;
+            if (lod->frame - region->last_used > LOD_REGION_KEEP_FRAMES) {
+                *link = region->next;
+                lod_free_region(region);
+                lod->region_count--;
+            } else {
+                link = &region->next;
+            }
+        }
+    }
+}
+
+/**
+ * Report the change in region and buffer bytes since the last call
+ */
+static void lod_track_memory(ChunkLod* lod) {
+    size_t volume = (size_t)LOD_REGION_CELLS * LOD_VOLUME_HEIGHT * LOD_REGION_CELLS;
+    size_t bytes = (size_t)lod->region_count * sizeof(LodRegion) +
+                   (lod->volume_types ? volume : 0) + (lod->volume_light ? volume : 0) +
+                   (lod->vertices ? (size_t)lod->vertex_capacity * sizeof(ChunkVertex) : 0) +
+                   (size_t)lod->draw_capacity * (sizeof(LodRegion*) + sizeof(LodSortEntry)) +
+                   (size_t)lod->build_capacity * sizeof(LodBuildEntry);
+    memory_track(MEMORY_LOD, (ptrdiff_t)bytes - (ptrdiff_t)lod->tracked_bytes);
+    lod->tracked_bytes = bytes;
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+ChunkLod* chunk_lod_create(int lod_distance) {
+    ChunkLod* lod = (ChunkLod*)calloc(1, sizeof(ChunkLod));
+    if (!lod) {
+        printf("[LOD] Failed to allocate LOD system\n");
+        return NULL;
+    }
+
+    size_t volume = (size_t)LOD_REGION_CELLS * LOD_VOLUME_HEIGHT * LOD_REGION_CELLS;
+    lod->volume_types = (uint8_t*)malloc(volume);
+    lod->volume_light = (uint8_t*)malloc(volume);
+    lod->vertex_capacity = LOD_VERTICES_INITIAL;
+    lod->vertices = (ChunkVertex*)malloc(sizeof(ChunkVertex) * (size_t)lod->vertex_capacity);
+    if (!lod->volume_types || !lod->volume_light || !lod->vertices) {
+        printf("[LOD] Failed to allocate LOD scratch buffers\n");
+        chunk_lod_destroy(lod);
+        return NULL;
+    }
+
+    for (int t = 0; t < BLOCK_COUNT; t++) {
+        Block b = { (uint8_t)t, 0, 0 };
+        if (t == BLOCK_AIR || !block_is_solid(b)) continue;
+        lod->type_flags[t] = LOD_TYPE_SOLID | (block_is_transparent(b) ? LOD_TYPE_TRANSPARENT : 0);
+    }
+
+    lod_track_memory(lod);
+    chunk_lod_set_distance(lod, lod_distance);
+    printf("[LOD] Created LOD system (full detail within %d chunks)\n", lod->distance);
+    return lod;
+}
+
+void chunk_lod_destroy(ChunkLod* lod) {
+    if (!lod) return;
+
+    for (int b = 0; b < LOD_REGION_BUCKETS; b++) {
+        LodRegion* region = lod->buckets[b];
+        while (region) {
+            LodRegion* next = region->next;
+            lod_free_region(region);
+            region = next;
+        }
+    }
+    memory_track(MEMORY_LOD, -(ptrdiff_t)lod->tracked_bytes);
+    free(lod->draw_list);
+    free(lod->builds);
+    free(lod->sort_buffer);
+    free(lod->volume_types);
+    free(lod->volume_light);
+    free(lod->vertices);
+    free(lod);
+}
+
+void chunk_lod_set_distance(ChunkLod* lod, int lod_distance) {
+    if (!lod) return;
+    lod->distance = lod_distance < 1 ? 1 : lod_distance;
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+bool chunk_lod_full_detail(const ChunkLod* lod, int center_x, int center_z,
+                           int chunk_x, int chunk_z, int margin) {
+    if (!lod) return true;
+    int dist = chunk_lod_region_distance(center_x, center_z, 1,
+                                         chunk_lod_region_coord(chunk_x, 1),
+                                         chunk_lod_region_coord(chunk_z, 1));
+    return dist <= lod->distance + margin;
+}
+
+bool chunk_lod_covers(const ChunkLod* lod, int chunk_x, int chunk_z) {
+    if (!lod) return false;
+    for (int level = 1; level <= CHUNK_LOD_LEVELS; level++) {
+        const LodRegion* region = lod_find(lod, level, chunk_lod_region_coord(chunk_x, level),
+                                           chunk_lod_region_coord(chunk_z, level));
+        if (region && region->built && region->drawn_frame == lod->frame) return true;
+    }
+    return false;
+}
+
+// ============================================================================
+// SELECTION
+// ============================================================================
+
+/**
+ * State of a region's chunks
+ * hash: FNV-1a of their lod_version (0 for chunks without cells)
+ * waiting: a chunk within load range has no blocks yet
+ * needs_cells: a chunk's LOD cells are missing or stale
+ */
+static uint32_t lod_children_state(World* world, const LodRegion* region, bool* waiting, bool* needs_cells) {
+    int span = 1 << region->level;
+    int x0 = region->region_x * span, z0 = region->region_z * span;
+    int load_distance = world->view_distance + WORLD_BORDER_RING;
+    uint32_t hash = 2166136261u;
+    *waiting = false;
+    *needs_cells = false;
+
+    for (int dz = 0; dz < span; dz++) {
+        for (int dx = 0; dx < span; dx++) {
+            int cx = x0 + dx, cz = z0 + dz;
+            Chunk* chunk = world_get_chunk(world, cx, cz);
+            bool has_blocks = chunk && CHUNK_STATE_HAS_BLOCKS(chunk_get_state(chunk));
+
+            if (!has_blocks && abs(cx - world->center_chunk_x) <= load_distance &&
+                abs(cz - world->center_chunk_z) <= load_distance) {
+                *waiting = true;
+            }
+            if (has_blocks && (!chunk->lod_cells || chunk->lod_stale)) *needs_cells = true;
+
+            uint32_t version = has_blocks && chunk->lod_cells ? chunk->lod_version : 0;
+            hash = (hash ^ version) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+static void lod_push_draw(ChunkLod* lod, LodRegion* region) {
+    if (lod->draw_count >= lod->draw_capacity) {
+        int capacity = lod->draw_capacity ? lod->draw_capacity * 2 : 256;
+        LodRegion** list = (LodRegion**)realloc(lod->draw_list, sizeof(LodRegion*) * (size_t)capacity);
+        LodSortEntry* sort = (LodSortEntry*)realloc(lod->sort_buffer, sizeof(LodSortEntry) * (size_t)capacity);
+        if (list) lod->draw_list = list;
+        if (sort) lod->sort_buffer = sort;
+        if (!list || !sort) return;
+        lod->draw_capacity = capacity;
+    }
+    lod->draw_list[lod->draw_count++] = region;
+}
+
+static void lod_push_build(ChunkLod* lod, LodRegion* region, int dist) {
+    if (lod->build_count >= lod->build_capacity) {
+        int capacity = lod->build_capacity ? lod->build_capacity * 2 : 256;
+        LodBuildEntry* builds = (LodBuildEntry*)realloc(lod->builds, sizeof(LodBuildEntry) * (size_t)capacity);
+        if (!builds) return;
+        lod->builds = builds;
+        lod->build_capacity = capacity;
+    }
+    lod->builds[lod->build_count++] = (LodBuildEntry){ region, dist };
+}
+
+/**
+ * Quadtree walk: use the region if its ring allows this level and its mesh
+ * exists, otherwise descend; level 0 is left to the batcher or pool
+ */
+static void lod_select(ChunkLod* lod, World* world, int level, int region_x, int region_z) {
+    if (level == 0) return;
+
+    int dist = chunk_lod_region_distance(world->center_chunk_x, world->center_chunk_z, level, region_x, region_z);
+    if (dist > world->view_distance) return;
+
+    if (chunk_lod_ring_level(dist, lod->distance) >= level) {
+        LodRegion* region = lod_get_or_create(lod, level, region_x, region_z);
+        if (!region) return;
+        region->last_used = lod->frame;
+
+        bool waiting, needs_cells;
+        uint32_t hash = lod_children_state(world, region, &waiting, &needs_cells);
+        if (!region->built || region->children_hash != hash || needs_cells) {
+            lod_push_build(lod, region, dist);
+        }
+        if (region->built) {
+            region->drawn_frame = lod->frame;
+            lod_push_draw(lod, region);
+            return;
+        }
+    }
+
+    for (int dz = 0; dz < 2; dz++) {
+        for (int dx = 0; dx < 2; dx++) {
+            lod_select(lod, world, level - 1, region_x * 2 + dx, region_z * 2 + dz);
+        }
+    }
+}
+
+// ============================================================================
+// REGION BUILD
+// ============================================================================
+
+static inline int volume_index(int x, int y, int z) {
+    return (y * LOD_REGION_CELLS + z) * LOD_REGION_CELLS + x;
+}
+
+/**
+ * Copy the chunks' cells of the region's level into the region volume
+ */
+static void lod_fill_volume(ChunkLod* lod, World* world, const LodRegion* region) {
+    int level = region->level;
+    int span = 1 << level;
+    int side = chunk_lod_side(level);
+    int height = chunk_lod_height(level);
+    size_t volume = (size_t)LOD_REGION_CELLS * (size_t)height * LOD_REGION_CELLS;
+    memset(lod->volume_types, BLOCK_AIR, volume);
+    memset(lod->volume_light, LIGHT_MAX, volume);
+
+    for (int dz = 0; dz < span; dz++) {
+        for (int dx = 0; dx < span; dx++) {
+            Chunk* chunk = world_get_chunk(world, region->region_x * span + dx, region->region_z * span + dz);
+            if (!chunk || !chunk->lod_cells || !CHUNK_STATE_HAS_BLOCKS(chunk_get_state(chunk))) continue;
+
+            const ChunkLodCells* cells = chunk->lod_cells;
+            for (int y = 0; y < height; y++) {
+                for (int z = 0; z < side; z++) {
+                    int src = chunk_lod_index(level, 0, y, z);
+                    int dst = volume_index(dx * side, y, dz * side + z);
+                    memcpy(lod->volume_types + dst, cells->types + src, (size_t)side);
+                    memcpy(lod->volume_light + dst, cells->light + src, (size_t)side);
+                }
+            }
+        }
+    }
+}
+
+static bool lod_reserve_vertices(ChunkLod* lod, int count) {
+    if (count <= lod->vertex_capacity) return true;
+    int capacity = lod->vertex_capacity * 2;
+    while (capacity < count) capacity *= 2;
+    ChunkVertex* vertices = (ChunkVertex*)realloc(lod->vertices, sizeof(ChunkVertex) * (size_t)capacity);
+    if (!vertices) return false;
+    lod->vertices = vertices;
+    lod->vertex_capacity = capacity;
+    return true;
+}
+
+/**
+ * Mesh one pass of the region volume into lod->vertices
+ * Faces on the region's sides and top are always emitted (skirts), so
+ * neighbors of any level meet without cracks. Returns the vertex count.
+ */
+static int lod_mesh_volume(ChunkLod* lod, int level, bool transparent_pass, int* min_y, int* max_y) {
+    int height = chunk_lod_height(level);
+    int size = 1 << level;
+    int count = 0;
+
+    for (int y = 0; y < height; y++) {
+        for (int z = 0; z < LOD_REGION_CELLS; z++) {
+            for (int x = 0; x < LOD_REGION_CELLS; x++) {
+                uint8_t type = lod->volume_types[volume_index(x, y, z)];
+                uint8_t flags = lod->type_flags[type];
+                if (!(flags & LOD_TYPE_SOLID)) continue;
+                if (((flags & LOD_TYPE_TRANSPARENT) != 0) != transparent_pass) continue;
+
+                bool emitted = false;
+                for (int face = 0; face < 6; face++) {
+                    int nx = x + lod_face_offsets[face][0];
+                    int ny = y + lod_face_offsets[face][1];
+                    int nz = z + lod_face_offsets[face][2];
+                    if (ny < 0) continue;  // Bottom of the world is never seen
+
+                    uint8_t light = LIGHT_MAX;
+                    if (nx >= 0 && nx < LOD_REGION_CELLS && nz >= 0 && nz < LOD_REGION_CELLS && ny < height) {
+                        int n = volume_index(nx, ny, nz);
+                        uint8_t neighbor = lod->volume_types[n];
+                        uint8_t neighbor_flags = lod->type_flags[neighbor];
+                        if ((neighbor_flags & LOD_TYPE_SOLID) && !(neighbor_flags & LOD_TYPE_TRANSPARENT)) continue;
+                        if ((neighbor_flags & LOD_TYPE_TRANSPARENT) && neighbor == type) continue;
+                        light = lod->volume_light[n];
+                    }
+
+                    if (!lod_reserve_vertices(lod, count + CHUNK_QUAD_VERTICES)) return count;
+                    AtlasTile tile = texture_atlas_get_tile((BlockType)type, (BlockFace)face);
+                    for (int c = 0; c < CHUNK_QUAD_VERTICES; c++) {
+                        const int* corner = lod_face_corners[face][c];
+                        lod->vertices[count++] = chunk_vertex_pack((x + corner[0]) * size, (y + corner[1]) * size,
+                                                                   (z + corner[2]) * size, (BlockFace)face,
+                                                                   tile, light, 3);
+                    }
+                    emitted = true;
+                }
+                if (emitted) {
+                    if (y * size < *min_y) *min_y = y * size;
+                    if ((y + 1) * size - 1 > *max_y) *max_y = (y + 1) * size - 1;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * Replace a mesh with the first count scratch vertices
+ */
+static void lod_upload_mesh(ChunkLod* lod, ChunkMesh* mesh, int count) {
+    chunk_mesh_unload(mesh);
+    if (count == 0) return;
+
+    if (!chunk_mesh_upload(mesh, lod->vertices, count, false, MEMORY_GPU_LOD)) {
+        chunk_mesh_unload(mesh);
+    }
+}
+
+static void lod_build_region(ChunkLod* lod, World* world, LodRegion* region, uint32_t hash) {
+    lod_fill_volume(lod, world, region);
+
+    int min_y = CHUNK_HEIGHT, max_y = -1;
+    int count = lod_mesh_volume(lod, region->level, false, &min_y, &max_y);
+    lod_upload_mesh(lod, &region->opaque_mesh, count);
+    count = lod_mesh_volume(lod, region->level, true, &min_y, &max_y);
+    lod_upload_mesh(lod, &region->transparent_mesh, count);
+
+    region->min_y = min_y;
+    region->max_y = max_y;
+    region->children_hash = hash;
+    region->built = true;
+}
+
+static int compare_builds(const void* a, const void* b) {
+    const LodBuildEntry* ea = (const LodBuildEntry*)a;
+    const LodBuildEntry* eb = (const LodBuildEntry*)b;
+    return ea->dist - eb->dist;
+}
+
+/**
+ * Build the nearest stale regions within the per-frame budgets
+ * A region waits until every chunk in load range has blocks; chunk cells
+ * are built here on first use
+ */
+static void lod_process_builds(ChunkLod* lod, World* world) {
+    if (lod->build_count == 0) return;
+    qsort(lod->builds, (size_t)lod->build_count, sizeof(LodBuildEntry), compare_builds);
+
+    int cell_budget = LOD_CELL_BUILDS_PER_FRAME;
+    int mesh_budget = LOD_MESH_BUILDS_PER_FRAME;
+    for (int i = 0; i < lod->build_count && mesh_budget > 0; i++) {
+        LodRegion* region = lod->builds[i].region;
+        bool waiting, needs_cells;
+        lod_children_state(world, region, &waiting, &needs_cells);
+        if (waiting) continue;
+
+        if (needs_cells) {
+            int span = 1 << region->level;
+            for (int dz = 0; dz < span && cell_budget > 0; dz++) {
+                for (int dx = 0; dx < span && cell_budget > 0; dx++) {
+                    Chunk* chunk = world_get_chunk(world, region->region_x * span + dx, region->region_z * span + dz);
+                    if (!chunk || !CHUNK_STATE_HAS_BLOCKS(chunk_get_state(chunk))) continue;
+                    if (chunk->lod_cells && !chunk->lod_stale) continue;
+                    chunk_build_lod_cells(chunk);
+                    cell_budget--;
+                }
+            }
+        }
+
+        uint32_t hash = lod_children_state(world, region, &waiting, &needs_cells);
+        if (needs_cells) continue;  // Out of cell budget, finish next frame
+        lod_build_region(lod, world, region, hash);
+        mesh_budget--;
+    }
+}
+
+// ============================================================================
+// UPDATE
+// ============================================================================
+
+void chunk_lod_update(ChunkLod* lod, World* world) {
+    if (!lod || !world) return;
+
+    lod->frame++;
+    lod->draw_count = 0;
+    lod->build_count = 0;
+
+    // Level-3 roots over the view square; the walk descends where needed
+    int view = world->view_distance;
+    int top = CHUNK_LOD_LEVELS;
+    int rx0 = chunk_lod_region_coord(world->center_chunk_x - view, top);
+    int rx1 = chunk_lod_region_coord(world->center_chunk_x + view, top);
+    int rz0 = chunk_lod_region_coord(world->center_chunk_z - view, top);
+    int rz1 = chunk_lod_region_coord(world->center_chunk_z + view, top);
+    for (int rz = rz0; rz <= rz1; rz++) {
+        for (int rx = rx0; rx <= rx1; rx++) {
+            lod_select(lod, world, top, rx, rz);
+        }
+    }
+
+    lod_process_builds(lod, world);
+    lod_evict(lod);
+    lod_track_memory(lod);
+}
+
+void chunk_lod_hide_covered(const ChunkLod* lod, ChunkCuller* culler) {
+    if (!lod || !culler) return;
+
+    for (int i = 0; i < lod->draw_count; i++) {
+        const LodRegion* region = lod->draw_list[i];
+        int span = 1 << region->level;
+        for (int dz = 0; dz < span; dz++) {
+            for (int dx = 0; dx < span; dx++) {
+                chunk_culler_hide_chunk(culler, region->region_x * span + dx, region->region_z * span + dz);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// RENDERING
+// ============================================================================
+
+static bool lod_region_visible(const LodRegion* region, const ChunkCuller* culler) {
+    if (region->min_y > region->max_y) return false;
+    float extent = (float)((1 << region->level) * CHUNK_SIZE);
+    Vector3 min = { region->region_x * extent, (float)region->min_y, region->region_z * extent };
+    Vector3 max = { min.x + extent, (float)region->max_y + 1.0f, min.z + extent };
+    return chunk_culler_box_visible(culler, min, max);
+}
+
+static Vector3 lod_region_origin(const LodRegion* region) {
+    float extent = (float)((1 << region->level) * CHUNK_SIZE);
+    return (Vector3){ region->region_x * extent, 0.0f, region->region_z * extent };
+}
+
+void chunk_lod_render_opaque(ChunkLod* lod, World* world, Material material) {
+    if (!lod || !world) return;
+
+    chunk_mesh_begin(material);
+    for (int i = 0; i < lod->draw_count; i++) {
+        const LodRegion* region = lod->draw_list[i];
+        if (!chunk_mesh_uploaded(&region->opaque_mesh)) continue;
+        if (!lod_region_visible(region, world->culler)) continue;
+        chunk_mesh_draw(&region->opaque_mesh, lod_region_origin(region));
+    }
+    chunk_mesh_end();
+}
+
+static int compare_sort_entries(const void* a, const void* b) {
+    const LodSortEntry* ea = (const LodSortEntry*)a;
+    const LodSortEntry* eb = (const LodSortEntry*)b;
+    // Sort descending (farthest first for back-to-front rendering)
+    if (eb->dist_sq > ea->dist_sq) return 1;
+    if (eb->dist_sq < ea->dist_sq) return -1;
+    return 0;
+}
+
+void chunk_lod_render_transparent(ChunkLod* lod, World* world, Material material, Vector3 camera_pos) {
+    if (!lod || !world || !lod->sort_buffer) return;
+
+    int count = 0;
+    for (int i = 0; i < lod->draw_count; i++) {
+        LodRegion* region = lod->draw_list[i];
+        if (!chunk_mesh_uploaded(&region->transparent_mesh)) continue;
+        if (!lod_region_visible(region, world->culler)) continue;
+
+        float extent = (float)((1 << region->level) * CHUNK_SIZE);
+        float dx = region->region_x * extent + extent * 0.5f - camera_pos.x;
+        float dz = region->region_z * extent + extent * 0.5f - camera_pos.z;
+        lod->sort_buffer[count++] = (LodSortEntry){ region, dx * dx + dz * dz };
+    }
+    qsort(lod->sort_buffer, (size_t)count, sizeof(LodSortEntry), compare_sort_entries);
+
+    chunk_mesh_begin(material);
+    for (int i = 0; i < count; i++) {
+        const LodRegion* region = lod->sort_buffer[i].region;
+        chunk_mesh_draw(&region->transparent_mesh, lod_region_origin(region));
+    }
+    chunk_mesh_end();
+}
@@ -0,0 +1,212 @@
+/**
+ * Chunk Mesh Implementation
+ *
+ * Raylib's Mesh only knows float streams, so packed chunk meshes get their
+ * own VAO with two 4-byte attributes and are drawn through rlgl directly.
+ * Buffer-to-buffer copies go through the GL_COPY_READ/WRITE_BUFFER targets,
+ * which leaves the bound vertex state untouched.
+ */
+
+#define GL_GLEXT_PROTOTYPES  // glCopyBufferSubData (GL 3.1) is called directly
+#include "voxel/render/chunk_mesh.h"
+#include "voxel/core/memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <raylib.h>
+#include <rlgl.h>
+#include <GL/gl.h>  // For glDrawElements with 32-bit indices (rlgl only draws 16-bit)
+
+// ============================================================================
+// SHARED QUAD INDEX BUFFER
+// ============================================================================
+
+static unsigned int g_quad_ebo = 0;
+static int g_quad_capacity = 0;  // Quads covered by g_quad_ebo
+
+static ChunkMeshStats g_stats = {0};
+
+static size_t quad_index_bytes(int quads) {
+    return (size_t)quads * CHUNK_QUAD_INDICES * sizeof(uint32_t);
+}
+
+/**
+ * Make sure the shared index buffer covers at least quads quads
+ * The buffer is bound per draw, so replacing it never invalidates a VAO
+ */
+unsigned int chunk_mesh_quad_indices(int quads) {
+    if (quads <= g_quad_capacity) return g_quad_ebo;
+
+    int capacity = g_quad_capacity > 0 ? g_quad_capacity : CHUNK_QUAD_INDEX_INITIAL;
+    while (capacity < quads) capacity *= 2;
+
+    uint32_t* indices = (uint32_t*)malloc((size_t)capacity * CHUNK_QUAD_INDICES * sizeof(uint32_t));
+    if (!indices) {
+        printf("[CHUNK_MESH] Failed to allocate index buffer for %d quads\n", capacity);
+        return 0;
+    }
+    for (int q = 0; q < capacity; q++) {
+        uint32_t base = (uint32_t)q * CHUNK_QUAD_VERTICES;
+        uint32_t* out = indices + q * CHUNK_QUAD_INDICES;
+        out[0] = base;
+        out[1] = base + 1;
+        out[2] = base + 2;
+        out[3] = base;
+        out[4] = base + 2;
+        out[5] = base + 3;
+    }
+
+    // No VAO may be bound, or the element buffer would be attached to it
+    rlDisableVertexArray();
+    if (g_quad_ebo != 0) rlUnloadVertexBuffer(g_quad_ebo);
+    g_quad_ebo = rlLoadVertexBufferElement(indices, capacity * CHUNK_QUAD_INDICES * (int)sizeof(uint32_t), false);
+    rlDisableVertexBufferElement();
+    free(indices);
+
+    memory_track(MEMORY_GPU_CHUNK, -(ptrdiff_t)quad_index_bytes(g_quad_capacity));
+    g_quad_capacity = g_quad_ebo != 0 ? capacity : 0;
+    memory_track(MEMORY_GPU_CHUNK, (ptrdiff_t)quad_index_bytes(g_quad_capacity));
+    return g_quad_ebo;
+}
+
+void chunk_mesh_release_shared(void) {
+    if (g_quad_ebo != 0) rlUnloadVertexBuffer(g_quad_ebo);
+    memory_track(MEMORY_GPU_CHUNK, -(ptrdiff_t)quad_index_bytes(g_quad_capacity));
+    g_quad_ebo = 0;
+    g_quad_capacity = 0;
+}
+
+// ============================================================================
+// MESH API
+// ============================================================================
+
+bool chunk_mesh_upload(ChunkMesh* mesh, const ChunkVertex* vertices, int vertex_count, bool dynamic,
+                       MemoryCategory category) {
+    if (!mesh || vertex_count <= 0) return false;
+
+    mesh->vao_id = rlLoadVertexArray();
+    if (mesh->vao_id == 0) return false;  // VAOs are required (GL 3.3)
+
+    rlEnableVertexArray(mesh->vao_id);
+    mesh->vbo_id = rlLoadVertexBuffer(vertices, vertex_count * (int)sizeof(ChunkVertex), dynamic);
+    mesh->vertex_count = vertex_count;
+    mesh->memory_category = (uint8_t)category;
+    if (mesh->vbo_id != 0) memory_track(category, (ptrdiff_t)((size_t)vertex_count * sizeof(ChunkVertex)));
+
+    // Bytes arrive as unnormalized floats (0-255); block.vs unpacks the bits
+    rlSetVertexAttribute(CHUNK_VERTEX_ATTRIB_POSITION, 4, RL_UNSIGNED_BYTE, false, sizeof(ChunkVertex), 0);
+    rlEnableVertexAttribute(CHUNK_VERTEX_ATTRIB_POSITION);
+    rlSetVertexAttribute(CHUNK_VERTEX_ATTRIB_SURFACE, 4, RL_UNSIGNED_BYTE, false, sizeof(ChunkVertex), 4);
+    rlEnableVertexAttribute(CHUNK_VERTEX_ATTRIB_SURFACE);
+
+    rlDisableVertexArray();
+    return true;
+}
+
+void chunk_mesh_write(ChunkMesh* mesh, int first, const ChunkVertex* vertices, int count) {
+    if (!mesh || mesh->vbo_id == 0 || !vertices || count <= 0) return;
+    rlUpdateVertexBuffer(mesh->vbo_id, vertices, count * (int)sizeof(ChunkVertex),
+                         first * (int)sizeof(ChunkVertex));
+}
+
+void chunk_mesh_clear(ChunkMesh* mesh, int first, int count) {
+    if (!mesh || mesh->vbo_id == 0 || count <= 0) return;
+
+    ChunkVertex* zeros = (ChunkVertex*)calloc((size_t)count, sizeof(ChunkVertex));
+    if (!zeros) return;
+    chunk_mesh_write(mesh, first, zeros, count);
+    free(zeros);
+}
+
+void chunk_mesh_copy(unsigned int dst_buffer, int dst_first, const ChunkMesh* src, int src_first, int count) {
+    if (dst_buffer == 0 || !src || src->vbo_id == 0 || count <= 0) return;
+
+    glBindBuffer(GL_COPY_READ_BUFFER, src->vbo_id);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, dst_buffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                        (GLintptr)src_first * (GLintptr)sizeof(ChunkVertex),
+                        (GLintptr)dst_first * (GLintptr)sizeof(ChunkVertex),
+                        (GLsizeiptr)count * (GLsizeiptr)sizeof(ChunkVertex));
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void chunk_mesh_unload(ChunkMesh* mesh) {
+    if (!mesh) return;
+    if (mesh->vbo_id != 0) {
+        rlUnloadVertexBuffer(mesh->vbo_id);
+        memory_track((MemoryCategory)mesh->memory_category,
+                     -(ptrdiff_t)((size_t)mesh->vertex_count * sizeof(ChunkVertex)));
+    }
+    if (mesh->vao_id != 0) rlUnloadVertexArray(mesh->vao_id);
+    memset(mesh, 0, sizeof(ChunkMesh));
+}
+
+/**
+ * Shader and textures for a pass; the matrices live in the frame uniform
+ * buffer, so nothing here depends on the draw
+ */
+void chunk_mesh_begin(Material material) {
+    Shader shader = material.shader;
+    rlEnableShader(shader.id);
+
+    int texture_slot = 0;
+    rlActiveTextureSlot(texture_slot);
+    rlEnableTexture(material.maps[MATERIAL_MAP_DIFFUSE].texture.id);
+    if (shader.locs[SHADER_LOC_MAP_DIFFUSE] != -1) {
+        rlSetUniform(shader.locs[SHADER_LOC_MAP_DIFFUSE], &texture_slot, RL_SHADER_UNIFORM_INT, 1);
+    }
+
+    // Mipmapped tile array on unit 1 (the shader's u_tile_array is set at atlas init)
+    unsigned int tile_array = texture_atlas_get_tile_array();
+    if (tile_array != 0) {
+        rlActiveTextureSlot(1);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, tile_array);
+        rlActiveTextureSlot(0);
+    }
+}
+
+void chunk_mesh_end(void) {
+    if (texture_atlas_get_tile_array() != 0) {
+        rlActiveTextureSlot(1);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    }
+    rlActiveTextureSlot(0);
+    rlDisableTexture();
+    rlDisableShader();
+}
+
+void chunk_mesh_draw(const ChunkMesh* mesh, Vector3 origin) {
+    if (!mesh || mesh->vao_id == 0 || mesh->vertex_count <= 0) return;
+
+    int quads = mesh->vertex_count / CHUNK_QUAD_VERTICES;
+    unsigned int ebo = chunk_mesh_quad_indices(quads);
+    if (ebo == 0) return;
+
+    // Generic attribute value: used by every VAO but the pool's, which has an origin array
+    rlSetVertexAttributeDefault(CHUNK_VERTEX_ATTRIB_ORIGIN, &origin, RL_SHADER_ATTRIB_VEC3, 3);
+
+    rlEnableVertexArray(mesh->vao_id);
+    rlEnableVertexBufferElement(ebo);
+    glDrawElements(GL_TRIANGLES, quads * CHUNK_QUAD_INDICES, GL_UNSIGNED_INT, NULL);
+    rlDisableVertexArray();
+    g_stats.draw_calls++;
+}
+
+// ============================================================================
+// STATISTICS
+// ============================================================================
+
+ChunkMeshStats chunk_mesh_get_stats(void) {
+    ChunkMeshStats stats = g_stats;
+    stats.gpu_bytes = memory_get_total(MEMORY_GPU);
+    return stats;
+}
+
+void chunk_mesh_reset_draw_calls(void) {
+    g_stats.draw_calls = 0;
+}
+
+void chunk_mesh_count_draws(int draws) {
+    g_stats.draw_calls += draws;
+}
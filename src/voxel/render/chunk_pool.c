@@ -0,0 +1,613 @@
+/**
+ * Chunk Pool Implementation
+ *
+ * First-fit suballocator over one vertex arena. Freed slots are retired
+ * behind a GL fence so a range is never rewritten while an in-flight frame
+ * may still read it. In-place section splices write live slots directly;
+ * the worst case is one frame drawn from a half-patched chunk.
+ */
+
+#define GL_GLEXT_PROTOTYPES  // GL 4.3+ entry points are called directly (rlgl only loads 3.3)
+#include "voxel/render/chunk_pool.h"
+#include "voxel/render/chunk_culler.h"
+#include "voxel/world/world.h"
+#include "voxel/core/memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <rlgl.h>
+#include <GL/gl.h>
+
+// ============================================================================
+// HASH MAP HELPERS
+// ============================================================================
+
+static unsigned int pool_hash(int chunk_x, int chunk_z) {
+    unsigned int h = (unsigned int)(chunk_x * 73856093) ^ (unsigned int)(chunk_z * 19349663);
+    return h % CHUNK_POOL_BUCKETS;
+}
+
+static PoolEntry* pool_find(ChunkPool* pool, int chunk_x, int chunk_z) {
+    PoolEntry* entry = pool->buckets[pool_hash(chunk_x, chunk_z)];
+    while (entry && !(entry->chunk_x == chunk_x && entry->chunk_z == chunk_z)) {
+        entry = entry->next;
+    }
+    return entry;
+}
+
+// ============================================================================
+// ARENA ALLOCATOR
+// ============================================================================
+
+/**
+ * Vertices reserved for a mesh of vertex_count (whole quads plus splice slack)
+ */
+static int slot_capacity(int vertex_count) {
+    int capacity = vertex_count + CHUNK_POOL_SLACK;
+    return (capacity + CHUNK_QUAD_VERTICES - 1) / CHUNK_QUAD_VERTICES * CHUNK_QUAD_VERTICES;
+}
+
+static bool grow_array(void** array, int* max, int needed, size_t element_size) {
+    if (needed <= *max) return true;
+    int new_max = *max > 0 ? *max * 2 : 64;
+    while (new_max < needed) new_max *= 2;
+    void* grown = realloc(*array, (size_t)new_max * element_size);
+    if (!grown) return false;
+    *array = grown;
+    *max = new_max;
+    return true;
+}
+
+/**
+ * Return a range to the free list, merging it with its neighbours
+ */
+static void pool_free_range(ChunkPool* pool, int offset, int capacity) {
+    int i = 0;
+    while (i < pool->free_count && pool->free_ranges[i].offset < offset) i++;
+
+    bool merge_prev = i > 0 &&
+        pool->free_ranges[i - 1].offset + pool->free_ranges[i - 1].capacity == offset;
+    bool merge_next = i < pool->free_count && offset + capacity == pool->free_ranges[i].offset;
+
+    if (merge_prev && merge_next) {
+        pool->free_ranges[i - 1].capacity += capacity + pool->free_ranges[i].capacity;
+        memmove(&pool->free_ranges[i], &pool->free_ranges[i + 1],
+                (size_t)(pool->free_count - i - 1) * sizeof(PoolRange));
+        pool->free_count--;
+    } else if (merge_prev) {
+        pool->free_ranges[i - 1].capacity += capacity;
+    } else if (merge_next) {
+        pool->free_ranges[i].offset = offset;
+        pool->free_ranges[i].capacity += capacity;
+    } else {
+        if (!grow_array((void**)&pool->free_ranges, &pool->free_max, pool->free_count + 1, sizeof(PoolRange))) {
+            printf("[POOL] Failed to grow free list, leaking %d vertices\n", capacity);
+            return;
+        }
+        memmove(&pool->free_ranges[i + 1], &pool->free_ranges[i],
+                (size_t)(pool->free_count - i) * sizeof(PoolRange));
+        pool->free_ranges[i].offset = offset;
+        pool->free_ranges[i].count = 0;
+        pool->free_ranges[i].capacity = capacity;
+        pool->free_count++;
+    }
+}
+
+/**
+ * First-fit allocation, returns false if no free range is large enough
+ */
+static bool pool_alloc(ChunkPool* pool, int capacity, PoolRange* out) {
+    for (int i = 0; i < pool->free_count; i++) {
+        PoolRange* range = &pool->free_ranges[i];
+        if (range->capacity < capacity) continue;
+
+        out->offset = range->offset;
+        out->count = 0;
+        out->capacity = capacity;
+
+        range->offset += capacity;
+        range->capacity -= capacity;
+        if (range->capacity == 0) {
+            memmove(range, range + 1, (size_t)(pool->free_count - i - 1) * sizeof(PoolRange));
+            pool->free_count--;
+        }
+        pool->used += capacity;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Give a slot back once the frames that may have drawn it are done
+ */
+static void pool_retire(ChunkPool* pool, PoolRange* range) {
+    if (range->capacity > 0) {
+        pool->used -= range->capacity;
+        if (grow_array((void**)&pool->retired, &pool->retired_max, pool->retired_count + 1, sizeof(PoolRetired))) {
+            PoolRetired* retired = &pool->retired[pool->retired_count++];
+            retired->offset = range->offset;
+            retired->capacity = range->capacity;
+            retired->frame = pool->frame;
+        } else {
+            printf("[POOL] Failed to retire slot, leaking %d vertices\n", range->capacity);
+        }
+    }
+    memset(range, 0, sizeof(PoolRange));
+}
+
+/**
+ * Copy one full mesh into its slot on the GPU, moving the slot if it no longer fits
+ * Returns false if the arena is out of space (slot left empty)
+ */
+static bool write_pass(ChunkPool* pool, PoolRange* range, const ChunkMesh* mesh, bool generated) {
+    int count = generated ? mesh->vertex_count : 0;
+    if (count <= 0 || !chunk_mesh_uploaded(mesh)) {
+        pool_retire(pool, range);
+        return true;
+    }
+
+    // Keep the slot unless it is too small or mostly wasted
+    int wanted = slot_capacity(count);
+    if (range->capacity < count || range->capacity > 2 * wanted) {
+        pool_retire(pool, range);
+        if (!pool_alloc(pool, wanted, range)) return false;
+    }
+
+    chunk_mesh_copy(pool->vertex_buffer, range->offset, mesh, 0, count);
+    range->count = count;
+    return true;
+}
+
+/**
+ * Replace one pass's changed vertex range inside its slot
+ */
+static bool splice_pass(ChunkPool* pool, PoolRange* range, const ChunkMesh* mesh, bool generated,
+                        const ChunkMeshRanges* ranges) {
+    int old_count = range->count;
+    int new_count = generated ? mesh->vertex_count : 0;
+    if (old_count == 0 && new_count == 0) return true;
+    if (range->capacity == 0 || new_count > range->capacity) return false;
+
+    // Everything after splice_first moved if the size changed
+    int first = ranges->splice_first;
+    int end = (new_count == old_count) ? ranges->splice_end : new_count;
+    if (end > new_count) end = new_count;
+    if (end > first) {
+        chunk_mesh_copy(pool->vertex_buffer, range->offset + first, mesh, first, end - first);
+    }
+    range->count = new_count;  // Draws stop at count, so a shrunk tail needs no clearing
+    return true;
+}
+
+// ============================================================================
+// DRAW SUBMISSION
+// ============================================================================
+
+static bool ensure_draw_capacity(ChunkPool* pool, int draws) {
+    if (draws <= pool->draw_max) return true;
+    int new_max = pool->draw_max > 0 ? pool->draw_max : 256;
+    while (new_max < draws) new_max *= 2;
+
+    PoolDrawCommand* commands = (PoolDrawCommand*)realloc(pool->commands, (size_t)new_max * sizeof(PoolDrawCommand));
+    if (!commands) return false;
+    pool->commands = commands;
+    float* origins = (float*)realloc(pool->origins, (size_t)new_max * 3 * sizeof(float));
+    if (!origins) return false;
+    pool->origins = origins;
+    PoolSortEntry* sort_buffer = (PoolSortEntry*)realloc(pool->sort_buffer, (size_t)new_max * sizeof(PoolSortEntry));
+    if (!sort_buffer) return false;
+    pool->sort_buffer = sort_buffer;
+    PoolSortEntry* sort_scratch = (PoolSortEntry*)realloc(pool->sort_scratch, (size_t)new_max * sizeof(PoolSortEntry));
+    if (!sort_scratch) return false;
+    pool->sort_scratch = sort_scratch;
+
+    pool->draw_max = new_max;
+    return true;
+}
+
+/**
+ * Append a draw for vertices [first, end) of one slot, returns its quad count
+ */
+static int push_draw(ChunkPool* pool, int index, const PoolEntry* entry, const PoolRange* range,
+                     int first, int end) {
+    int quads = (end - first) / CHUNK_QUAD_VERTICES;
+    PoolDrawCommand* cmd = &pool->commands[index];
+    cmd->count = (unsigned int)(quads * CHUNK_QUAD_INDICES);
+    cmd->instance_count = 1;
+    cmd->first_index = 0;
+    cmd->base_vertex = range->offset + first;
+    cmd->base_instance = (unsigned int)index;
+
+    Vector3 origin = chunk_mesh_origin(entry->chunk_x, entry->chunk_z);
+    pool->origins[index * 3 + 0] = origin.x;
+    pool->origins[index * 3 + 1] = origin.y;
+    pool->origins[index * 3 + 2] = origin.z;
+    return quads;
+}
+
+/**
+ * Append one draw per run of consecutive visible sections of a slot
+ * Slots keep the chunk mesh layout, so the chunk's section ranges apply
+ */
+static void push_section_draws(ChunkPool* pool, int* draw_count, int* max_quads, const PoolEntry* entry,
+                               const PoolRange* range, const ChunkMeshRanges* ranges, uint16_t sections) {
+    if (sections == CHUNK_SECTIONS_ALL) {
+        int quads = push_draw(pool, (*draw_count)++, entry, range, 0, range->count);
+        if (quads > *max_quads) *max_quads = quads;
+        return;
+    }
+
+    int sy = 0;
+    while (sy < CHUNK_SECTION_COUNT) {
+        if (!(sections & (1u << sy))) { sy++; continue; }
+        int run_start = sy;
+        while (sy < CHUNK_SECTION_COUNT && (sections & (1u << sy))) sy++;
+
+        int first = ranges->start[run_start];
+        int end = ranges->start[sy];
+        if (end > range->count) end = range->count;
+        if (end <= first) continue;
+
+        int quads = push_draw(pool, (*draw_count)++, entry, range, first, end);
+        if (quads > *max_quads) *max_quads = quads;
+    }
+}
+
+/**
+ * Stream the draw list and issue it as one indirect multi-draw
+ */
+static void submit_draws(ChunkPool* pool, int draw_count, int max_quads) {
+    if (draw_count == 0) return;
+    unsigned int ebo = chunk_mesh_quad_indices(max_quads);
+    if (ebo == 0) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, pool->origin_buffer);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)draw_count * 3 * (GLsizeiptr)sizeof(float), pool->origins, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, pool->command_buffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, (GLsizeiptr)draw_count * (GLsizeiptr)sizeof(PoolDrawCommand),
+                 pool->commands, GL_STREAM_DRAW);
+
+    // Vertices carry cell-local positions; the origin attribute places them
+    rlEnableVertexArray(pool->vao_id);
+    rlEnableVertexBufferElement(ebo);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, NULL, draw_count, 0);
+    rlDisableVertexArray();
+    chunk_mesh_count_draws(1);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+/**
+ * Visible sections of an entry's chunk this frame (0 = cull the chunk)
+ */
+static uint16_t entry_visible_sections(const PoolEntry* entry, const World* world) {
+    const Chunk* chunk = entry->chunk;
+    if (!chunk_culler_chunk_visible(world->culler, chunk)) return 0;
+    return chunk_culler_sections(world->culler, chunk->x, chunk->z);
+}
+
+/**
+ * Draw a chunk from its own mesh (slot missing because the arena was full)
+ */
+static void draw_chunk_fallback(const Chunk* chunk, const ChunkMesh* mesh) {
+    chunk_mesh_draw(mesh, chunk_mesh_origin(chunk->x, chunk->z));
+}
+
+/**
+ * Order sort_buffer back-to-front, starting from the last pass's order
+ * Entries drawn last pass go back to their old positions and new ones are
+ * appended, then an insertion sort fixes what the camera moved; the order
+ * barely changes between frames, so this stays close to linear
+ */
+static void order_sort_entries(ChunkPool* pool, int count) {
+    PoolSortEntry* entries = pool->sort_buffer;
+    PoolSortEntry* slots = pool->sort_scratch;
+    int previous = pool->sort_count;
+    for (int i = 0; i < previous; i++) {
+        slots[i].entry = NULL;
+    }
+
+    int unranked = 0;
+    for (int i = 0; i < count; i++) {
+        PoolSortEntry e = entries[i];
+        if (e.entry->sort_pass == pool->sort_pass && e.entry->sort_rank < previous) {
+            slots[e.entry->sort_rank] = e;
+        } else {
+            entries[unranked++] = e;
+        }
+    }
+    memmove(entries + (count - unranked), entries, (size_t)unranked * sizeof(PoolSortEntry));
+    int n = 0;
+    for (int i = 0; i < previous; i++) {
+        if (slots[i].entry) entries[n++] = slots[i];
+    }
+
+    for (int i = 1; i < count; i++) {
+        PoolSortEntry e = entries[i];
+        int j = i - 1;
+        while (j >= 0 && entries[j].dist_sq < e.dist_sq) {
+            entries[j + 1] = entries[j];
+            j--;
+        }
+        entries[j + 1] = e;
+    }
+
+    pool->sort_pass++;
+    pool->sort_count = count;
+    for (int i = 0; i < count; i++) {
+        entries[i].entry->sort_rank = i;
+        entries[i].entry->sort_pass = pool->sort_pass;
+    }
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+ChunkPool* chunk_pool_create(void) {
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    int version = major * 10 + minor;
+    if (version < 43) {
+        printf("[POOL] OpenGL %d.%d lacks multi-draw indirect, using chunk batcher\n", major, minor);
+        return NULL;
+    }
+
+    ChunkPool* pool = (ChunkPool*)calloc(1, sizeof(ChunkPool));
+    if (!pool) {
+        printf("[POOL] Failed to allocate chunk pool\n");
+        return NULL;
+    }
+    pool->capacity = CHUNK_POOL_VERTICES;
+    GLsizeiptr arena_bytes = (GLsizeiptr)pool->capacity * (GLsizeiptr)sizeof(ChunkVertex);
+
+    pool->vao_id = rlLoadVertexArray();
+    rlEnableVertexArray(pool->vao_id);
+
+    // Only ever written by copies from chunk meshes, never by the CPU
+    glGenBuffers(1, &pool->vertex_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, pool->vertex_buffer);
+    glBufferData(GL_ARRAY_BUFFER, arena_bytes, NULL, GL_DYNAMIC_COPY);
+    if (pool->vertex_buffer != 0) memory_track(MEMORY_GPU_CHUNK, (ptrdiff_t)arena_bytes);
+
+    // Bytes arrive as unnormalized floats (0-255); block.vs unpacks the bits
+    rlSetVertexAttribute(CHUNK_VERTEX_ATTRIB_POSITION, 4, RL_UNSIGNED_BYTE, false, sizeof(ChunkVertex), 0);
+    rlEnableVertexAttribute(CHUNK_VERTEX_ATTRIB_POSITION);
+    rlSetVertexAttribute(CHUNK_VERTEX_ATTRIB_SURFACE, 4, RL_UNSIGNED_BYTE, false, sizeof(ChunkVertex), 4);
+    rlEnableVertexAttribute(CHUNK_VERTEX_ATTRIB_SURFACE);
+
+    // One origin per draw: base_instance selects it
+    glGenBuffers(1, &pool->origin_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, pool->origin_buffer);
+    rlSetVertexAttribute(CHUNK_VERTEX_ATTRIB_ORIGIN, 3, RL_FLOAT, false, 3 * sizeof(float), 0);
+    rlEnableVertexAttribute(CHUNK_VERTEX_ATTRIB_ORIGIN);
+    rlSetVertexAttributeDivisor(CHUNK_VERTEX_ATTRIB_ORIGIN, 1);
+
+    rlDisableVertexArray();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glGenBuffers(1, &pool->command_buffer);
+
+    if (pool->vao_id == 0 || pool->vertex_buffer == 0 || pool->origin_buffer == 0 || pool->command_buffer == 0) {
+        printf("[POOL] Failed to create GPU buffers, using chunk batcher\n");
+        chunk_pool_destroy(pool);
+        return NULL;
+    }
+
+    pool_free_range(pool, 0, pool->capacity);
+
+    printf("[POOL] Created chunk pool (%d MB)\n", (int)(arena_bytes / (1024 * 1024)));
+    return pool;
+}
+
+void chunk_pool_destroy(ChunkPool* pool) {
+    if (!pool) return;
+
+    for (int i = 0; i < CHUNK_POOL_BUCKETS; i++) {
+        PoolEntry* entry = pool->buckets[i];
+        while (entry) {
+            PoolEntry* next = entry->next;
+            free(entry);
+            entry = next;
+        }
+    }
+
+    for (int i = 0; i < CHUNK_POOL_FENCES; i++) {
+        if (pool->fences[i]) glDeleteSync((GLsync)pool->fences[i]);
+    }
+
+    if (pool->vao_id != 0) rlUnloadVertexArray(pool->vao_id);
+    if (pool->vertex_buffer != 0) {
+        glDeleteBuffers(1, &pool->vertex_buffer);
+        memory_track(MEMORY_GPU_CHUNK, -(ptrdiff_t)pool->capacity * (ptrdiff_t)sizeof(ChunkVertex));
+    }
+    if (pool->origin_buffer != 0) glDeleteBuffers(1, &pool->origin_buffer);
+    if (pool->command_buffer != 0) glDeleteBuffers(1, &pool->command_buffer);
+
+    free(pool->free_ranges);
+    free(pool->retired);
+    free(pool->commands);
+    free(pool->origins);
+    free(pool->sort_buffer);
+    free(pool->sort_scratch);
+    free(pool);
+    printf("[POOL] Destroyed chunk pool\n");
+}
+
+void chunk_pool_write_chunk(ChunkPool* pool, Chunk* chunk) {
+    if (!pool || !chunk) return;
+
+    PoolEntry* entry = pool_find(pool, chunk->x, chunk->z);
+    if (!entry) {
+        entry = (PoolEntry*)calloc(1, sizeof(PoolEntry));
+        if (!entry) return;
+        entry->chunk_x = chunk->x;
+        entry->chunk_z = chunk->z;
+        unsigned int hash = pool_hash(chunk->x, chunk->z);
+        entry->next = pool->buckets[hash];
+        pool->buckets[hash] = entry;
+        pool->entry_count++;
+    }
+    entry->chunk = chunk;
+
+    bool opaque_ok = write_pass(pool, &entry->opaque, &chunk->mesh, chunk->mesh_generated);
+    bool transparent_ok = write_pass(pool, &entry->transparent, &chunk->transparent_mesh,
+                                     chunk->transparent_mesh_generated);
+    if (!opaque_ok || !transparent_ok) {
+        // Keep both passes on the same path so the chunk is never drawn twice
+        pool_retire(pool, &entry->opaque);
+        pool_retire(pool, &entry->transparent);
+        if (!entry->overflow) {
+            printf("[POOL] Arena full (%d/%d vertices), drawing chunk (%d, %d) separately\n",
+                   pool->used, pool->capacity, chunk->x, chunk->z);
+        }
+    }
+    entry->overflow = !opaque_ok || !transparent_ok;
+}
+
+bool chunk_pool_splice_chunk(ChunkPool* pool, Chunk* chunk) {
+    if (!pool || !chunk) return false;
+
+    PoolEntry* entry = pool_find(pool, chunk->x, chunk->z);
+    if (!entry || entry->chunk != chunk || entry->overflow) return false;
+
+    return splice_pass(pool, &entry->opaque, &chunk->mesh, chunk->mesh_generated, &chunk->mesh_ranges) &&
+           splice_pass(pool, &entry->transparent, &chunk->transparent_mesh,
+                       chunk->transparent_mesh_generated, &chunk->transparent_ranges);
+}
+
+void chunk_pool_release_chunk(ChunkPool* pool, Chunk* chunk) {
+    if (!pool || !chunk) return;
+
+    PoolEntry** pp = &pool->buckets[pool_hash(chunk->x, chunk->z)];
+    while (*pp) {
+        PoolEntry* entry = *pp;
+        if (entry->chunk_x == chunk->x && entry->chunk_z == chunk->z) {
+            pool_retire(pool, &entry->opaque);
+            pool_retire(pool, &entry->transparent);
+            *pp = entry->next;
+            free(entry);
+            pool->entry_count--;
+            return;
+        }
+        pp = &entry->next;
+    }
+}
+
+void chunk_pool_update(ChunkPool* pool) {
+    if (!pool) return;
+
+    // Fence everything drawn since the last update; a GPU this far behind is waited for
+    int slot = pool->frame % CHUNK_POOL_FENCES;
+    if (pool->fences[slot]) {
+        glClientWaitSync((GLsync)pool->fences[slot], GL_SYNC_FLUSH_COMMANDS_BIT, (GLuint64)1000000000);
+        glDeleteSync((GLsync)pool->fences[slot]);
+        pool->fences[slot] = NULL;
+        pool->completed_frame++;
+    }
+    pool->fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    pool->frame++;
+
+    while (pool->completed_frame < pool->frame) {
+        int done = pool->completed_frame % CHUNK_POOL_FENCES;
+        GLsync fence = (GLsync)pool->fences[done];
+        if (fence) {
+            GLenum status = glClientWaitSync(fence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) break;
+            glDeleteSync(fence);
+            pool->fences[done] = NULL;
+        }
+        pool->completed_frame++;
+    }
+
+    // Recycle slots whose last possible reader has finished
+    int kept = 0;
+    for (int i = 0; i < pool->retired_count; i++) {
+        PoolRetired* retired = &pool->retired[i];
+        if (retired->frame < pool->completed_frame) {
+            pool_free_range(pool, retired->offset, retired->capacity);
+        } else {
+            pool->retired[kept++] = *retired;
+        }
+    }
+    pool->retired_count = kept;
+}
+
+void chunk_pool_render_opaque(ChunkPool* pool, World* world,
+                              Material material, Vector3 camera_pos) {
+    (void)camera_pos;  // Visibility comes from world->culler
+    if (!pool || !world) return;
+    if (!ensure_draw_capacity(pool, pool->entry_count * CHUNK_POOL_MAX_RUNS)) return;
+
+    chunk_mesh_begin(material);
+
+    int draw_count = 0;
+    int max_quads = 0;
+    for (int i = 0; i < CHUNK_POOL_BUCKETS; i++) {
+        for (PoolEntry* entry = pool->buckets[i]; entry; entry = entry->next) {
+            if (!entry->overflow && entry->opaque.count == 0) continue;
+            uint16_t sections = entry_visible_sections(entry, world);
+            if (sections == 0) continue;
+
+            if (entry->overflow) {
+                if (entry->chunk->mesh_generated) {
+                    draw_chunk_fallback(entry->chunk, &entry->chunk->mesh);
+                }
+                continue;
+            }
+            push_section_draws(pool, &draw_count, &max_quads, entry, &entry->opaque,
+                               &entry->chunk->mesh_ranges, sections);
+        }
+    }
+
+    submit_draws(pool, draw_count, max_quads);
+    chunk_mesh_end();
+}
+
+void chunk_pool_render_transparent(ChunkPool* pool, World* world,
+                                   Material material, Vector3 camera_pos) {
+    if (!pool || !world) return;
+    if (!ensure_draw_capacity(pool, pool->entry_count * CHUNK_POOL_MAX_RUNS)) return;
+
+    int count = 0;
+    for (int i = 0; i < CHUNK_POOL_BUCKETS; i++) {
+        for (PoolEntry* entry = pool->buckets[i]; entry; entry = entry->next) {
+            bool has_mesh = entry->overflow ? entry->chunk->transparent_mesh_generated
+                                            : entry->transparent.count > 0;
+            if (!has_mesh || entry_visible_sections(entry, world) == 0) continue;
+
+            float dx = (entry->chunk_x + 0.5f) * CHUNK_SIZE - camera_pos.x;
+            float dz = (entry->chunk_z + 0.5f) * CHUNK_SIZE - camera_pos.z;
+            pool->sort_buffer[count].entry = entry;
+            pool->sort_buffer[count].dist_sq = dx * dx + dz * dz;
+            count++;
+        }
+    }
+
+    // Sort back-to-front; a multi-draw keeps command order
+    order_sort_entries(pool, count);
+
+    chunk_mesh_begin(material);
+
+    int draw_count = 0;
+    int max_quads = 0;
+    for (int i = 0; i < count; i++) {
+        PoolEntry* entry = pool->sort_buffer[i].entry;
+        if (entry->overflow) continue;
+        push_section_draws(pool, &draw_count, &max_quads, entry, &entry->transparent,
+                           &entry->chunk->transparent_ranges, entry_visible_sections(entry, world));
+    }
+    submit_draws(pool, draw_count, max_quads);
+
+    // Overflow chunks only exist while the arena is full, draw them last
+    for (int i = 0; i < count; i++) {
+        PoolEntry* entry = pool->sort_buffer[i].entry;
+        if (entry->overflow) {
+            draw_chunk_fallback(entry->chunk, &entry->chunk->transparent_mesh);
+        }
+    }
+    chunk_mesh_end();
+}
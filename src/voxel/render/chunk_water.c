@@ -0,0 +1,330 @@
+/**
+ * Chunk Water Implementation
+ *
+ * Water meshes are small (only faces against air), so they are built on
+ * the main thread from the blocks and kept per chunk. The cell list maps
+ * every water block to its quads, which is what lets a level change be
+ * written in place.
+ */
+
+#include "voxel/render/chunk_water.h"
+#include "voxel/render/chunk_culler.h"
+#include "voxel/world/chunk.h"
+#include "voxel/world/world.h"
+#include "voxel/world/water.h"
+#include "voxel/core/memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// FACE TABLES
+// ============================================================================
+
+// Neighbor offset per BlockFace
+static const int g_water_face_dirs[6][3] = {
+    {0, 1, 0}, {0, -1, 0}, {0, 0, -1}, {0, 0, 1}, {-1, 0, 0}, {1, 0, 0}
+};
+
+// Quad corners per BlockFace: x, top (0 = block bottom, 1 = surface), z
+static const uint8_t g_water_face_corners[6][4][3] = {
+    {{0, 1, 0}, {0, 1, 1}, {1, 1, 1}, {1, 1, 0}},  // Top
+    {{0, 0, 0}, {1, 0, 0}, {1, 0, 1}, {0, 0, 1}},  // Bottom
+    {{0, 0, 0}, {0, 1, 0}, {1, 1, 0}, {1, 0, 0}},  // Front (-Z)
+    {{1, 0, 1}, {1, 1, 1}, {0, 1, 1}, {0, 0, 1}},  // Back (+Z)
+    {{0, 0, 1}, {0, 1, 1}, {0, 1, 0}, {0, 0, 0}},  // Left (-X)
+    {{1, 0, 0}, {1, 1, 0}, {1, 1, 1}, {1, 0, 1}},  // Right (+X)
+};
+
+#define WATER_BLOCK_MAX_VERTICES (6 * CHUNK_QUAD_VERTICES)
+
+// ============================================================================
+// BLOCK GEOMETRY
+// ============================================================================
+
+/**
+ * Surface height of a water block that has no water above it
+ * Sources and falling water stand highest, the last flow level lowest
+ */
+static int water_surface_height(Block block) {
+    int level = water_is_falling(block.metadata) ? 0 : water_get_level(block.metadata);
+    return (WATER_MAX_LEVEL + 1 - level) * WATER_SURFACE_FULL / (WATER_MAX_LEVEL + 2);
+}
+
+/**
+ * Faces of the water block at world (x, y, z) that border something see-through
+ */
+static uint8_t water_block_faces(WorldCursor* cursor, int x, int y, int z) {
+    uint8_t faces = 0;
+    for (int f = 0; f < 6; f++) {
+        int ny = y + g_water_face_dirs[f][1];
+        if (ny < 0) continue;  // Nothing is seen from below the world
+        if (ny < CHUNK_HEIGHT) {
+            Block neighbor = world_cursor_get_block(cursor, x + g_water_face_dirs[f][0], ny,
+                                                    z + g_water_face_dirs[f][2]);
+            if (chunk_water_hides_face(neighbor)) continue;
+        }
+        faces |= (uint8_t)(1u << f);
+    }
+    return faces;
+}
+
+/**
+ * Surface height at the block corner (x, z): the mean over the water
+ * blocks at y that share the corner, full if any of them has water above
+ */
+static int water_corner_height(WorldCursor* cursor, int x, int y, int z) {
+    int sum = 0, count = 0;
+    for (int dz = -1; dz <= 0; dz++) {
+        for (int dx = -1; dx <= 0; dx++) {
+            Block block = world_cursor_get_block(cursor, x + dx, y, z + dz);
+            if (block.type != BLOCK_WATER) continue;
+            if (y + 1 < CHUNK_HEIGHT && world_cursor_get_block(cursor, x + dx, y + 1, z + dz).type == BLOCK_WATER) {
+                return WATER_SURFACE_FULL;
+            }
+            sum += water_surface_height(block);
+            count++;
+        }
+    }
+    return count > 0 ? sum / count : 0;
+}
+
+static uint8_t water_pack_flow(int slope) {
+    int flow = slope / WATER_FLOW_SCALE;
+    if (flow < -127) flow = -127;
+    if (flow > 127) flow = 127;
+    return (uint8_t)(flow + WATER_FLOW_BIAS);
+}
+
+/**
+ * Vertices of the faces of one water block (world x/z, chunk-local lx/lz)
+ * Returns the number of vertices written (4 per face)
+ */
+static int water_emit_block(WorldCursor* cursor, int x, int y, int z, int lx, int lz, Block block,
+                            uint8_t faces, WaterVertex* out) {
+    // Under water the block is full and still; on the surface its corners
+    // follow the neighboring levels
+    bool covered = y + 1 < CHUNK_HEIGHT && world_cursor_get_block(cursor, x, y + 1, z).type == BLOCK_WATER;
+    int corner[2][2];  // [z][x]
+    for (int cz = 0; cz < 2; cz++) {
+        for (int cx = 0; cx < 2; cx++) {
+            corner[cz][cx] = covered ? WATER_SURFACE_FULL : water_corner_height(cursor, x + cx, y, z + cz);
+        }
+    }
+    uint8_t flow_x = water_pack_flow(corner[0][0] + corner[1][0] - corner[0][1] - corner[1][1]);
+    uint8_t flow_z = water_pack_flow(corner[0][0] + corner[0][1] - corner[1][0] - corner[1][1]);
+    uint8_t light = block.light_level & 0x0F;
+
+    int count = 0;
+    for (int f = 0; f < 6; f++) {
+        if (!(faces & (1u << f))) continue;
+        for (int v = 0; v < CHUNK_QUAD_VERTICES; v++) {
+            const uint8_t* c = g_water_face_corners[f][v];
+            bool top = c[1] != 0;
+            WaterVertex* out_v = &out[count++];
+            out_v->x = (uint8_t)(lx + c[0]);
+            out_v->y = (uint8_t)y;
+            out_v->z = (uint8_t)(lz + c[2]);
+            out_v->face = (uint8_t)(f | (top && !covered ? WATER_VERTEX_SURFACE_BIT : 0));
+            out_v->surface = (uint8_t)(top ? corner[c[2]][c[0]] : 0);
+            out_v->light = light;
+            out_v->flow_x = flow_x;
+            out_v->flow_z = flow_z;
+        }
+    }
+    return count;
+}
+
+// ============================================================================
+// MESH BUILD
+// ============================================================================
+
+// Build scratch (main thread only)
+static WaterVertex* g_water_vertices = NULL;
+static int g_water_vertex_capacity = 0;
+static WaterCell* g_water_cells = NULL;
+static int g_water_cell_capacity = 0;
+
+static bool water_reserve(int vertices, int cells) {
+    if (vertices > g_water_vertex_capacity) {
+        int capacity = g_water_vertex_capacity > 0 ? g_water_vertex_capacity * 2 : 4096;
+        while (capacity < vertices) capacity *= 2;
+        WaterVertex* grown = (WaterVertex*)realloc(g_water_vertices, (size_t)capacity * sizeof(WaterVertex));
+        if (!grown) return false;
+        g_water_vertices = grown;
+        g_water_vertex_capacity = capacity;
+    }
+    if (cells > g_water_cell_capacity) {
+        int capacity = g_water_cell_capacity > 0 ? g_water_cell_capacity * 2 : 1024;
+        while (capacity < cells) capacity *= 2;
+        WaterCell* grown = (WaterCell*)realloc(g_water_cells, (size_t)capacity * sizeof(WaterCell));
+        if (!grown) return false;
+        g_water_cells = grown;
+        g_water_cell_capacity = capacity;
+    }
+    return true;
+}
+
+static bool section_may_hold_water(const ChunkSection* s) {
+    if (s->bits == 0) return s->uniform_type == BLOCK_WATER;
+    for (int p = 0; p < s->palette_size; p++) {
+        if (s->palette[p] == BLOCK_WATER) return true;
+    }
+    return false;
+}
+
+void chunk_water_destroy(ChunkWater* water) {
+    if (!water) return;
+    chunk_mesh_unload(&water->mesh);
+    memory_track(MEMORY_CPU_MESH, -(ptrdiff_t)((size_t)water->cell_count * sizeof(WaterCell)));
+    free(water->cells);
+    free(water);
+}
+
+void chunk_water_build(World* world, Chunk* chunk) {
+    if (!world || !chunk) return;
+
+    chunk_ensure_warm(chunk);
+    WorldCursor cursor;
+    world_cursor_init(&cursor, world);
+    int origin_x = chunk->x * CHUNK_SIZE;
+    int origin_z = chunk->z * CHUNK_SIZE;
+
+    int vertex_count = 0;
+    int cell_count = 0;
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        if (!section_may_hold_water(&chunk->sections[sy])) continue;
+
+        for (int y = sy * CHUNK_SECTION_HEIGHT; y < (sy + 1) * CHUNK_SECTION_HEIGHT; y++) {
+            for (int z = 0; z < CHUNK_SIZE; z++) {
+                for (int x = 0; x < CHUNK_SIZE; x++) {
+                    Block block = chunk_get_block(chunk, x, y, z);
+                    if (block.type != BLOCK_WATER) continue;
+
+                    uint8_t faces = water_block_faces(&cursor, origin_x + x, y, origin_z + z);
+                    if (!faces) continue;  // Inside a body of water
+                    if (!water_reserve(vertex_count + WATER_BLOCK_MAX_VERTICES, cell_count + 1)) {
+                        printf("[WATER] Out of memory building the water mesh of chunk (%d, %d)\n",
+                               chunk->x, chunk->z);
+                        return;
+                    }
+
+                    int written = water_emit_block(&cursor, origin_x + x, y, origin_z + z, x, z, block, faces,
+                                                   g_water_vertices + vertex_count);
+                    g_water_cells[cell_count++] = (WaterCell){
+                        .index = (uint16_t)((y << 8) | (z << 4) | x),
+                        .faces = faces,
+                        .quad_count = (uint8_t)(written / CHUNK_QUAD_VERTICES),
+                        .first_quad = vertex_count / CHUNK_QUAD_VERTICES,
+                    };
+                    vertex_count += written;
+                }
+            }
+        }
+    }
+
+    chunk_water_destroy(chunk->water);
+    chunk->water = NULL;
+    if (cell_count == 0) return;
+
+    ChunkWater* water = (ChunkWater*)calloc(1, sizeof(ChunkWater));
+    WaterCell* cells = (WaterCell*)malloc((size_t)cell_count * sizeof(WaterCell));
+    if (!water || !cells) {
+        free(water);
+        free(cells);
+        return;
+    }
+    memcpy(cells, g_water_cells, (size_t)cell_count * sizeof(WaterCell));
+    water->cells = cells;
+    water->cell_count = cell_count;
+    memory_track(MEMORY_CPU_MESH, (ptrdiff_t)((size_t)cell_count * sizeof(WaterCell)));
+
+    // Same two 4-byte attributes as block vertices; dynamic for level rewrites
+    chunk_mesh_upload(&water->mesh, (const ChunkVertex*)g_water_vertices, vertex_count, true, MEMORY_GPU_CHUNK);
+    chunk->water = water;
+}
+
+static int compare_cell_index(const void* key, const void* element) {
+    int index = *(const int*)key;
+    return index - ((const WaterCell*)element)->index;
+}
+
+bool chunk_water_refresh_block(World* world, Chunk* chunk, int local_x, int y, int local_z) {
+    if (!world || !chunk || y < 0 || y >= CHUNK_HEIGHT) return true;
+
+    int x = chunk->x * CHUNK_SIZE + local_x;
+    int z = chunk->z * CHUNK_SIZE + local_z;
+    Block block = chunk_get_block(chunk, local_x, y, local_z);
+
+    WorldCursor cursor;
+    world_cursor_init(&cursor, world);
+    uint8_t faces = block.type == BLOCK_WATER ? water_block_faces(&cursor, x, y, z) : 0;
+
+    ChunkWater* water = chunk->water;
+    int index = (y << 8) | (local_z << 4) | local_x;
+    const WaterCell* cell = water ? (const WaterCell*)bsearch(&index, water->cells, (size_t)water->cell_count,
+                                                              sizeof(WaterCell), compare_cell_index)
+                                  : NULL;
+    if (!cell) return faces == 0;  // Still nothing to draw here
+    if (faces != cell->faces) return false;
+
+    WaterVertex vertices[WATER_BLOCK_MAX_VERTICES];
+    int count = water_emit_block(&cursor, x, y, z, local_x, local_z, block, faces, vertices);
+    chunk_mesh_write(&water->mesh, cell->first_quad * CHUNK_QUAD_VERTICES, (const ChunkVertex*)vertices, count);
+    return true;
+}
+
+// ============================================================================
+// RENDERING
+// ============================================================================
+
+typedef struct WaterDraw {
+    Chunk* chunk;
+    float dist_sq;
+} WaterDraw;
+
+static WaterDraw* g_water_draws = NULL;
+static int g_water_draw_capacity = 0;
+
+static int compare_draws_far_first(const void* a, const void* b) {
+    float da = ((const WaterDraw*)a)->dist_sq;
+    float db = ((const WaterDraw*)b)->dist_sq;
+    return (da < db) - (da > db);
+}
+
+void chunk_water_render(World* world, Material material, Vector3 camera_pos) {
+    if (!world) return;
+
+    int radius = world->view_distance;
+    int side = 2 * radius + 1;
+    if (side * side > g_water_draw_capacity) {
+        WaterDraw* grown = (WaterDraw*)realloc(g_water_draws, (size_t)(side * side) * sizeof(WaterDraw));
+        if (!grown) return;
+        g_water_draws = grown;
+        g_water_draw_capacity = side * side;
+    }
+
+    int count = 0;
+    for (int cz = world->center_chunk_z - radius; cz <= world->center_chunk_z + radius; cz++) {
+        for (int cx = world->center_chunk_x - radius; cx <= world->center_chunk_x + radius; cx++) {
+            Chunk* chunk = world_get_chunk(world, cx, cz);
+            if (!chunk || !chunk->water || chunk->water->mesh.vertex_count == 0) continue;
+            if (world->culler && chunk_culler_sections(world->culler, cx, cz) == 0) continue;
+
+            float dx = (cx + 0.5f) * CHUNK_SIZE - camera_pos.x;
+            float dz = (cz + 0.5f) * CHUNK_SIZE - camera_pos.z;
+            g_water_draws[count++] = (WaterDraw){ chunk, dx * dx + dz * dz };
+        }
+    }
+    if (count == 0) return;
+
+    qsort(g_water_draws, (size_t)count, sizeof(WaterDraw), compare_draws_far_first);
+
+    chunk_mesh_begin(material);
+    for (int i = 0; i < count; i++) {
+        Chunk* chunk = g_water_draws[i].chunk;
+        Vector3 origin = { (float)(chunk->x * CHUNK_SIZE), 0.0f, (float)(chunk->z * CHUNK_SIZE) };
+        chunk_mesh_draw(&chunk->water->mesh, origin);
+    }
+    chunk_mesh_end();
+}
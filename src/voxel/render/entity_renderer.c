@@ -0,0 +1,158 @@
+/**
+ * Entity Renderer Implementation
+ *
+ * An instance is the part's model matrix (unit mesh scaled, placed, then
+ * the rlgl transform of the caller). Its bottom row is always (0, 0, 0, 1)
+ * for these affine transforms, so it carries the color instead; the vertex
+ * shader reads it back and restores the row.
+ */
+
+#include "voxel/render/entity_renderer.h"
+#include "voxel/render/chunk_culler.h"
+#include <raymath.h>
+#include <rlgl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define ENTITY_INSTANCES_INITIAL 256
+
+typedef struct {
+    Mesh mesh;
+    Matrix* instances;
+    int count;
+    int capacity;
+} EntityPartBatch;
+
+static struct {
+    Shader shader;
+    Material material;
+    EntityPartBatch parts[ENTITY_PART_COUNT];
+    Frustum frustum;
+    Vector3 camera_pos;
+    bool instanced;         // Shader and meshes ready (false = immediate fallback)
+    bool initialized;
+} g_entity_renderer;
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+/**
+ * Queue a unit part placed by local (scale then offset) under the rlgl transform
+ */
+static void record_part(EntityPartMesh part, Matrix local, Color color) {
+    EntityPartBatch* batch = &g_entity_renderer.parts[part];
+    if (batch->count >= batch->capacity) {
+        int capacity = batch->capacity > 0 ? batch->capacity * 2 : ENTITY_INSTANCES_INITIAL;
+        Matrix* instances = (Matrix*)realloc(batch->instances, capacity * sizeof(Matrix));
+        if (!instances) return;  // Part is skipped this frame
+        batch->instances = instances;
+        batch->capacity = capacity;
+    }
+
+    Matrix m = MatrixMultiply(local, rlGetMatrixTransform());
+    m.m3 = color.r / 255.0f;
+    m.m7 = color.g / 255.0f;
+    m.m11 = color.b / 255.0f;
+    m.m15 = color.a / 255.0f;
+    batch->instances[batch->count++] = m;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void entity_renderer_init(void) {
+    memset(&g_entity_renderer, 0, sizeof(g_entity_renderer));
+
+    g_entity_renderer.shader = LoadShader("shaders/entity.vs", "shaders/entity.fs");
+    int instance_loc = GetShaderLocationAttrib(g_entity_renderer.shader, "instanceTransform");
+
+    if (g_entity_renderer.shader.id == 0 || g_entity_renderer.shader.id == rlGetShaderIdDefault() ||
+        instance_loc < 0) {
+        printf("[ENTITY] Warning: Failed to load entity shader, drawing parts one by one\n");
+    } else {
+        g_entity_renderer.shader.locs[SHADER_LOC_MATRIX_MODEL] = instance_loc;
+        g_entity_renderer.material = LoadMaterialDefault();
+        g_entity_renderer.material.shader = g_entity_renderer.shader;
+
+        g_entity_renderer.parts[ENTITY_PART_CUBE].mesh = GenMeshCube(1.0f, 1.0f, 1.0f);
+        g_entity_renderer.parts[ENTITY_PART_SPHERE].mesh =
+            GenMeshSphere(1.0f, ENTITY_SPHERE_RINGS, ENTITY_SPHERE_SLICES);
+        g_entity_renderer.instanced = true;
+    }
+
+    g_entity_renderer.initialized = true;
+    printf("[ENTITY] Renderer initialized (%s)\n",
+           g_entity_renderer.instanced ? "instanced" : "immediate");
+}
+
+void entity_renderer_destroy(void) {
+    if (!g_entity_renderer.initialized) return;
+
+    for (int p = 0; p < ENTITY_PART_COUNT; p++) {
+        if (g_entity_renderer.instanced) UnloadMesh(g_entity_renderer.parts[p].mesh);
+        free(g_entity_renderer.parts[p].instances);
+    }
+    // The material owns the shader
+    if (g_entity_renderer.instanced) {
+        UnloadMaterial(g_entity_renderer.material);
+    } else {
+        UnloadShader(g_entity_renderer.shader);
+    }
+
+    memset(&g_entity_renderer, 0, sizeof(g_entity_renderer));
+}
+
+void entity_renderer_begin(void) {
+    Matrix view = rlGetMatrixModelview();
+    Matrix inverse_view = MatrixInvert(view);
+    g_entity_renderer.camera_pos = (Vector3){inverse_view.m12, inverse_view.m13, inverse_view.m14};
+    g_entity_renderer.frustum = frustum_from_matrix(MatrixMultiply(view, rlGetMatrixProjection()));
+
+    for (int p = 0; p < ENTITY_PART_COUNT; p++) {
+        g_entity_renderer.parts[p].count = 0;
+    }
+}
+
+bool entity_renderer_box_visible(Vector3 min, Vector3 max) {
+    // Distance to the nearest point of the box
+    Vector3 nearest = Vector3Clamp(g_entity_renderer.camera_pos, min, max);
+    if (Vector3DistanceSqr(nearest, g_entity_renderer.camera_pos) >
+        ENTITY_RENDER_DISTANCE * ENTITY_RENDER_DISTANCE) {
+        return false;
+    }
+    return frustum_box_visible(&g_entity_renderer.frustum, min, max);
+}
+
+void entity_renderer_cube(Vector3 position, float width, float height, float length, Color color) {
+    if (!g_entity_renderer.instanced) {
+        DrawCube(position, width, height, length, color);
+        return;
+    }
+    Matrix local = MatrixMultiply(MatrixScale(width, height, length),
+                                  MatrixTranslate(position.x, position.y, position.z));
+    record_part(ENTITY_PART_CUBE, local, color);
+}
+
+void entity_renderer_sphere(Vector3 center, float radius, Color color) {
+    if (!g_entity_renderer.instanced) {
+        DrawSphere(center, radius, color);
+        return;
+    }
+    Matrix local = MatrixMultiply(MatrixScale(radius, radius, radius),
+                                  MatrixTranslate(center.x, center.y, center.z));
+    record_part(ENTITY_PART_SPHERE, local, color);
+}
+
+void entity_renderer_end(void) {
+    if (!g_entity_renderer.instanced) return;
+
+    for (int p = 0; p < ENTITY_PART_COUNT; p++) {
+        EntityPartBatch* batch = &g_entity_renderer.parts[p];
+        if (batch->count == 0) continue;
+        DrawMeshInstanced(batch->mesh, g_entity_renderer.material, batch->instances, batch->count);
+        batch->count = 0;
+    }
+}
@@ -0,0 +1,87 @@
+/**
+ * Frame Uniforms Implementation
+ */
+
+#define GL_GLEXT_PROTOTYPES
+#include "voxel/render/frame_uniforms.h"
+#include <raymath.h>
+#include <rlgl.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <stdio.h>
+
+static GLuint g_frame_ubo = 0;
+
+bool frame_uniforms_init(void) {
+    if (g_frame_ubo != 0) return true;
+
+    glGenBuffers(1, &g_frame_ubo);
+    if (g_frame_ubo == 0) {
+        printf("[FRAME] WARNING: Failed to create frame uniform buffer\n");
+        return false;
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, g_frame_ubo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniformData), NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_UNIFORMS_BINDING, g_frame_ubo);
+
+    printf("[FRAME] Frame uniform buffer created (%d bytes)\n", (int)sizeof(FrameUniformData));
+    return true;
+}
+
+void frame_uniforms_destroy(void) {
+    if (g_frame_ubo != 0) {
+        glDeleteBuffers(1, &g_frame_ubo);
+        g_frame_ubo = 0;
+    }
+}
+
+void frame_uniforms_bind_shader(Shader shader) {
+    if (shader.id == 0) return;
+    GLuint block = glGetUniformBlockIndex(shader.id, FRAME_UNIFORMS_BLOCK);
+    if (block == GL_INVALID_INDEX) return;
+    glUniformBlockBinding(shader.id, block, FRAME_UNIFORMS_BINDING);
+}
+
+static void store_vec3(float* out, Vector3 v) {
+    out[0] = v.x;
+    out[1] = v.y;
+    out[2] = v.z;
+    out[3] = 0.0f;
+}
+
+void frame_uniforms_set_camera(FrameUniformData* data, Camera3D camera) {
+    // Same projection as BeginMode3D
+    float aspect = (float)GetRenderWidth() / (float)GetRenderHeight();
+    Matrix projection;
+    if (camera.projection == CAMERA_ORTHOGRAPHIC) {
+        double top = camera.fovy / 2.0;
+        double right = top * aspect;
+        projection = MatrixOrtho(-right, right, -top, top, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+    } else {
+        projection = MatrixPerspective(camera.fovy * DEG2RAD, aspect, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+    }
+    Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+    float16 view_proj = MatrixToFloatV(MatrixMultiply(view, projection));
+    for (int i = 0; i < 16; i++) {
+        data->view_proj[i] = view_proj.v[i];
+    }
+
+    // Camera basis for billboards and the sky rays
+    Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, camera.up));
+    Vector3 up = Vector3CrossProduct(right, forward);
+
+    store_vec3(data->camera_pos, camera.position);
+    store_vec3(data->camera_right, right);
+    store_vec3(data->camera_up, up);
+    store_vec3(data->camera_forward, forward);
+}
+
+void frame_uniforms_upload(const FrameUniformData* data) {
+    if (g_frame_ubo == 0) return;
+    glBindBuffer(GL_UNIFORM_BUFFER, g_frame_ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniformData), data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
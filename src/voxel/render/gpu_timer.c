@@ -0,0 +1,67 @@
+/**
+ * GPU Timer Implementation
+ */
+
+#define GL_GLEXT_PROTOTYPES  // Timer queries (GL 3.3) are called directly
+#include "voxel/render/gpu_timer.h"
+#include <string.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+bool gpu_timer_init(GpuTimer* timer) {
+    if (!timer) return false;
+
+    memset(timer, 0, sizeof(GpuTimer));
+    glGenQueries(GPU_TIMER_FRAMES, timer->queries);
+    return timer->queries[0] != 0;
+}
+
+void gpu_timer_destroy(GpuTimer* timer) {
+    if (!timer || timer->queries[0] == 0) return;
+
+    if (timer->open) {
+        glEndQuery(GL_TIME_ELAPSED);
+    }
+    glDeleteQueries(GPU_TIMER_FRAMES, timer->queries);
+    memset(timer, 0, sizeof(GpuTimer));
+}
+
+void gpu_timer_begin(GpuTimer* timer) {
+    if (!timer || timer->queries[0] == 0 || timer->open) return;
+    if (timer->pending[timer->next]) return;
+
+    glBeginQuery(GL_TIME_ELAPSED, timer->queries[timer->next]);
+    timer->open = true;
+}
+
+void gpu_timer_end(GpuTimer* timer, size_t tag) {
+    if (!timer || !timer->open) return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    timer->open = false;
+    timer->pending[timer->next] = true;
+    timer->tags[timer->next] = tag;
+    timer->next = (timer->next + 1) % GPU_TIMER_FRAMES;
+}
+
+bool gpu_timer_poll(GpuTimer* timer, double* ms, size_t* tag) {
+    if (!timer) return false;
+
+    // Oldest first: the span after the newest one
+    for (int i = 0; i < GPU_TIMER_FRAMES; i++) {
+        int slot = (timer->next + i) % GPU_TIMER_FRAMES;
+        if (!timer->pending[slot]) continue;
+
+        GLint available = 0;
+        glGetQueryObjectiv(timer->queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) return false;  // Later spans finish later
+
+        GLuint64 elapsed_ns = 0;
+        glGetQueryObjectui64v(timer->queries[slot], GL_QUERY_RESULT, &elapsed_ns);
+        timer->pending[slot] = false;
+        if (ms) *ms = (double)elapsed_ns / 1000000.0;
+        if (tag) *tag = timer->tags[slot];
+        return true;
+    }
+    return false;
+}
@@ -3,122 +3,470 @@
  *
  * Skylight propagation from sky downward, then spreads horizontally.
  * Creates realistic gradual falloff in caves and tunnels.
+ *
+ * Every cell has a source level: the skylight reaching it straight down
+ * its column, or the light its block emits if that is brighter. Light then
+ * spreads breadth-first, one level dimmer per step, into air and
+ * transparent blocks. The chunk pass works on dense scratch arrays decoded
+ * from the chunk's palette sections (chunk_block_index layout); the world
+ * pass works on the stored light of loaded chunks and crosses their borders.
  */
 
 #include "voxel/render/light.h"
 #include "voxel/core/block.h"
+#include "voxel/world/world.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 /**
- * Calculate initial skylight for a single column (x, z)
- * This is the first pass - direct sunlight from above
+ * Skylight reaching the block below one of this type
+ * Air passes it unchanged, transparent blocks (leaves, water) dim it by one,
+ * solid blocks keep it on their top surface and stop it
+ */
+static inline int sky_below(uint8_t type, int light) {
+    if (type == BLOCK_AIR) return light;
+    if (block_type_passes_light(type)) return light > 0 ? light - 1 : 0;
+    return 0;
+}
+
+// ============================================================================
+// CHUNK PASS
+// ============================================================================
+
+/**
+ * Scratch state for one chunk pass (~330 KB, heap allocated)
+ */
+typedef struct {
+    uint8_t types[CHUNK_VOLUME];
+    uint8_t light[CHUNK_VOLUME];
+    uint8_t queued[CHUNK_VOLUME];   // Cell is waiting in the queue
+    uint16_t queue[CHUNK_VOLUME];   // Ring of cell indices (wraps with uint16_t)
+} LightScratch;
+
+/**
+ * Calculate initial skylight for a single column (x, z) below height rows
+ * This is the first pass - direct sunlight from above, plus emitters
  */
-static void calculate_column_skylight(Chunk* chunk, int x, int z) {
+static void calculate_column_skylight(LightScratch* scratch, int x, int z, int rows) {
     int light = LIGHT_MAX;  // Start at full skylight from sky
 
     // Scan from top to bottom
-    for (int y = CHUNK_HEIGHT - 1; y >= 0; y--) {
-        Block* block = &chunk->blocks[x][y][z];
-
-        if (block->type == BLOCK_AIR) {
-            // Air: full light passes through unchanged
-            block->light_level = light;
-        } else if (block_is_transparent(*block)) {
-            // Transparent blocks (leaves, water): light passes through but reduced
-            block->light_level = light;
-            if (light > 0) light--;
-        } else {
-            // Solid block: gets current light level on top surface, then blocks all light
-            block->light_level = light;
-            light = 0;
-        }
+    for (int y = rows - 1; y >= 0; y--) {
+        int i = chunk_block_index(x, y, z);
+        uint8_t type = scratch->types[i];
+        uint8_t emission = g_block_light_emission[type];
+
+        scratch->light[i] = (uint8_t)(light > emission ? light : emission);
+        light = sky_below(type, light);
     }
 }
 
 /**
- * Propagate light horizontally through the chunk.
- * Light spreads to adjacent air blocks with -1 reduction per step.
- * Uses iterative passes until no more changes occur.
+ * Spread light through the chunk's first rows breadth-first.
+ * Light spreads to adjacent air and transparent blocks with -1 per step.
+ * A cell is queued again only when it gets brighter, so each cell is
+ * visited a handful of times instead of once per full sweep.
  */
-static void propagate_light(Chunk* chunk) {
-    // Direction offsets for 6 neighbors (including up/down for cave openings)
-    static const int dx[] = {-1, 1, 0, 0, 0, 0};
-    static const int dy[] = {0, 0, -1, 1, 0, 0};
-    static const int dz[] = {0, 0, 0, 0, -1, 1};
-
-    bool changed = true;
-    int iterations = 0;
-    const int max_iterations = 16;  // Limit iterations (light can only travel 15 blocks max)
-
-    while (changed && iterations < max_iterations) {
-        changed = false;
-        iterations++;
-
-        // Scan all blocks
-        for (int x = 0; x < CHUNK_SIZE; x++) {
-            for (int y = 0; y < CHUNK_HEIGHT; y++) {
-                for (int z = 0; z < CHUNK_SIZE; z++) {
-                    Block* block = &chunk->blocks[x][y][z];
-
-                    // Only propagate through air and transparent blocks
-                    if (block->type != BLOCK_AIR && !block_is_transparent(*block)) {
-                        continue;
-                    }
-
-                    // Check all 6 neighbors
-                    for (int i = 0; i < 6; i++) {
-                        int nx = x + dx[i];
-                        int ny = y + dy[i];
-                        int nz = z + dz[i];
-
-                        // Bounds check
-                        if (nx < 0 || nx >= CHUNK_SIZE) continue;
-                        if (ny < 0 || ny >= CHUNK_HEIGHT) continue;
-                        if (nz < 0 || nz >= CHUNK_SIZE) continue;
-
-                        Block* neighbor = &chunk->blocks[nx][ny][nz];
-
-                        // If neighbor has more light, we can receive some
-                        if (neighbor->light_level > block->light_level + 1) {
-                            block->light_level = neighbor->light_level - 1;
-                            changed = true;
-                        }
-                    }
-                }
+static void propagate_light(LightScratch* scratch, int rows) {
+    uint16_t head = 0, tail = 0;
+    int count = 0;
+    int cells = rows * CHUNK_SIZE * CHUNK_SIZE;
+    memset(scratch->queued, 0, (size_t)cells);
+
+    // Every cell bright enough to light a neighbor starts the fill
+    for (int i = 0; i < cells; i++) {
+        if (scratch->light[i] > 1) {
+            scratch->queue[tail++] = (uint16_t)i;
+            scratch->queued[i] = 1;
+            count++;
+        }
+    }
+
+    while (count > 0) {
+        int i = scratch->queue[head++];
+        count--;
+        scratch->queued[i] = 0;
+
+        int level = scratch->light[i] - 1;
+        if (level <= 0) continue;
+
+        // 6 neighbors inside the chunk (index layout: y << 8 | z << 4 | x)
+        int x = i & (CHUNK_SIZE - 1);
+        int z = (i >> 4) & (CHUNK_SIZE - 1);
+        int y = i >> 8;
+        int neighbors[6];
+        int n = 0;
+        if (x > 0) neighbors[n++] = i - 1;
+        if (x < CHUNK_SIZE - 1) neighbors[n++] = i + 1;
+        if (z > 0) neighbors[n++] = i - CHUNK_SIZE;
+        if (z < CHUNK_SIZE - 1) neighbors[n++] = i + CHUNK_SIZE;
+        if (y > 0) neighbors[n++] = i - CHUNK_SIZE * CHUNK_SIZE;
+        if (y < rows - 1) neighbors[n++] = i + CHUNK_SIZE * CHUNK_SIZE;
+
+        for (int k = 0; k < n; k++) {
+            int j = neighbors[k];
+
+            // Only propagate into air and transparent blocks
+            if (!block_type_passes_light(scratch->types[j])) continue;
+            if (scratch->light[j] >= level) continue;
+
+            scratch->light[j] = (uint8_t)level;
+            if (!scratch->queued[j]) {
+                // Queued cells are distinct, so the ring never overflows
+                scratch->queue[tail++] = (uint16_t)j;
+                scratch->queued[j] = 1;
+                count++;
             }
         }
     }
 }
 
 /**
- * Calculate skylight for entire chunk with horizontal propagation
+ * Calculate light for entire chunk with breadth-first propagation
  */
 void light_calculate_chunk(Chunk* chunk) {
     if (!chunk) return;
 
+    LightScratch* scratch = (LightScratch*)malloc(sizeof(LightScratch));
+    if (!scratch) {
+        printf("[LIGHT] Failed to allocate light scratch\n");
+        return;
+    }
+    chunk_decode_types(chunk, scratch->types);
+
+    // Sections above the highest block are open sky at full light, and
+    // nothing below can brighten them: only the rows up to it are lit
+    int rows = chunk_section_span(chunk) * CHUNK_SECTION_HEIGHT;
+    int cells = rows * CHUNK_SIZE * CHUNK_SIZE;
+    memset(scratch->light + cells, LIGHT_MAX, (size_t)(CHUNK_VOLUME - cells));
+
     // Pass 1: Calculate direct skylight from above
     for (int x = 0; x < CHUNK_SIZE; x++) {
         for (int z = 0; z < CHUNK_SIZE; z++) {
-            calculate_column_skylight(chunk, x, z);
+            calculate_column_skylight(scratch, x, z, rows);
         }
     }
 
     // Pass 2: Propagate light horizontally through caves/tunnels
-    propagate_light(chunk);
+    propagate_light(scratch, rows);
+
+    // Marks the sections whose light changed as needing mesh regeneration
+    chunk_store_light(chunk, scratch->light);
+    free(scratch);
+}
+
+// ============================================================================
+// WORLD PASS (main thread)
+// ============================================================================
+
+#define LIGHT_QUEUE_INITIAL 4096    // Nodes per queue before the first growth
+#define LIGHT_SKY_COLUMNS 1024      // Sky columns cached per update (an edit reaches ~31x31)
+#define LIGHT_SKY_SLOTS 2048        // Sky column hash slots (twice the columns: probes always end)
+
+typedef struct {
+    int x, y, z;
+    uint8_t level;              // Removal: light the cell had before it was cleared
+} LightNode;
+
+/**
+ * FIFO of world cells, grown on demand and reused between updates
+ */
+typedef struct {
+    LightNode* nodes;
+    int head;
+    int count;
+    int capacity;
+} LightQueue;
+
+/**
+ * State of one incremental update
+ * Sky columns are computed from the blocks the first time a cell of the
+ * column needs its source level, and kept until the update ends.
+ */
+typedef struct {
+    World* world;
+    WorldCursor cursor;
+    LightQueue add;
+    LightQueue removal;
+    int sky_x[LIGHT_SKY_COLUMNS];
+    int sky_z[LIGHT_SKY_COLUMNS];
+    uint8_t sky[LIGHT_SKY_COLUMNS][CHUNK_HEIGHT];
+    int16_t sky_slots[LIGHT_SKY_SLOTS];     // Column index + 1 (0 = empty)
+    int sky_count;
+    uint8_t sky_spare[CHUNK_HEIGHT];        // Answer when the cache is full
+} LightUpdate;
+
+static LightUpdate g_update;
+
+static const int g_directions[6][3] = {
+    {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}
+};
+
+static void queue_push(LightQueue* queue, int x, int y, int z, int level) {
+    if (queue->count == queue->capacity) {
+        if (queue->head > 0) {
+            // Reclaim the consumed front before growing
+            queue->count -= queue->head;
+            memmove(queue->nodes, queue->nodes + queue->head, (size_t)queue->count * sizeof(LightNode));
+            queue->head = 0;
+        } else {
+            int capacity = queue->capacity > 0 ? queue->capacity * 2 : LIGHT_QUEUE_INITIAL;
+            LightNode* nodes = (LightNode*)realloc(queue->nodes, (size_t)capacity * sizeof(LightNode));
+            if (!nodes) return;  // Out of memory: the light around this cell stays as it was
+            queue->nodes = nodes;
+            queue->capacity = capacity;
+        }
+    }
+    queue->nodes[queue->count++] = (LightNode){ x, y, z, (uint8_t)level };
+}
+
+static bool queue_pop(LightQueue* queue, LightNode* node) {
+    if (queue->head >= queue->count) {
+        queue->head = 0;
+        queue->count = 0;
+        return false;
+    }
+    *node = queue->nodes[queue->head++];
+    return true;
+}
+
+static LightUpdate* update_begin(World* world) {
+    LightUpdate* u = &g_update;
+    u->world = world;
+    world_cursor_init(&u->cursor, world);
+    u->add.head = u->add.count = 0;
+    u->removal.head = u->removal.count = 0;
+    memset(u->sky_slots, 0, sizeof(u->sky_slots));
+    u->sky_count = 0;
+    return u;
+}
+
+/**
+ * Chunk holding world column (x, z) if its light may be read and written
+ * Chunks owned by a worker or with a mesh in flight are left alone; the
+ * seam is fixed by light_stitch_chunk once their mesh is uploaded.
+ */
+static Chunk* update_chunk_at(LightUpdate* u, int x, int z) {
+    Chunk* chunk = world_cursor_get_chunk(&u->cursor, x, z);
+    if (!chunk) return NULL;
+    ChunkState state = chunk_get_state(chunk);
+    if (state != CHUNK_STATE_GENERATED && state != CHUNK_STATE_COMPLETE) return NULL;
+    return chunk;
+}
+
+/**
+ * Skylight arriving at every height of world column (x, z)
+ */
+static const uint8_t* update_sky_column(LightUpdate* u, Chunk* chunk, int x, int z) {
+    uint32_t hash = ((uint32_t)x * 73856093u) ^ ((uint32_t)z * 19349663u);
+    int slot = (int)(hash & (LIGHT_SKY_SLOTS - 1));
+    while (u->sky_slots[slot]) {
+        int c = u->sky_slots[slot] - 1;
+        if (u->sky_x[c] == x && u->sky_z[c] == z) return u->sky[c];
+        slot = (slot + 1) & (LIGHT_SKY_SLOTS - 1);
+    }
+
+    uint8_t* column = u->sky_spare;
+    if (u->sky_count < LIGHT_SKY_COLUMNS) {
+        column = u->sky[u->sky_count];
+        u->sky_x[u->sky_count] = x;
+        u->sky_z[u->sky_count] = z;
+        u->sky_slots[slot] = (int16_t)(++u->sky_count);
+    }
+
+    // Nothing but air above the chunk's highest block
+    int local_x = x - chunk->x * CHUNK_SIZE;
+    int local_z = z - chunk->z * CHUNK_SIZE;
+    int top = chunk->min_block_y <= chunk->max_block_y ? chunk->max_block_y : -1;
+    int light = LIGHT_MAX;
+    for (int y = CHUNK_HEIGHT - 1; y > top; y--) {
+        column[y] = LIGHT_MAX;
+    }
+    for (int y = top; y >= 0; y--) {
+        column[y] = (uint8_t)light;
+        light = sky_below(chunk_get_block(chunk, local_x, y, local_z).type, light);
+    }
+    return column;
+}
+
+/**
+ * Level a cell has without any light from its neighbors
+ */
+static int update_source(LightUpdate* u, Chunk* chunk, int x, int y, int z, uint8_t type) {
+    int sky = update_sky_column(u, chunk, x, z)[y];
+    int emission = g_block_light_emission[type];
+    return sky > emission ? sky : emission;
+}
+
+static void update_store(LightUpdate* u, Chunk* chunk, int x, int y, int z, int level) {
+    chunk_set_light(chunk, x - chunk->x * CHUNK_SIZE, y, z - chunk->z * CHUNK_SIZE, (uint8_t)level);
+    world_mark_block_dirty(u->world, x, y, z);
+}
+
+/**
+ * Give a cell a new source level
+ * Brighter cells only spread; dimmer ones first clear what they lit
+ */
+static void update_seed(LightUpdate* u, Chunk* chunk, int x, int y, int z, int level, int source) {
+    if (source == level) return;
+    update_store(u, chunk, x, y, z, source);
+    if (source < level) {
+        queue_push(&u->removal, x, y, z, level);
+    }
+    if (source > 0) {
+        queue_push(&u->add, x, y, z, 0);
+    }
+}
+
+/**
+ * Clear the light that came from removed cells
+ * A neighbor dimmer than the removed cell may have been lit by it and goes
+ * back to its source level; a neighbor at least as bright is lit from
+ * elsewhere and spreads back into the cleared cells during the add pass.
+ */
+static void update_run_removal(LightUpdate* u) {
+    LightNode node;
+    while (queue_pop(&u->removal, &node)) {
+        for (int d = 0; d < 6; d++) {
+            int x = node.x + g_directions[d][0];
+            int y = node.y + g_directions[d][1];
+            int z = node.z + g_directions[d][2];
+            if (y < 0 || y >= CHUNK_HEIGHT) continue;
+
+            Chunk* chunk = update_chunk_at(u, x, z);
+            if (!chunk) continue;
+            Block block = chunk_get_block(chunk, x - chunk->x * CHUNK_SIZE, y, z - chunk->z * CHUNK_SIZE);
+            int level = block.light_level;
+            if (level == 0) continue;
 
-    // Mark chunk as needing mesh regeneration
-    chunk->needs_remesh = true;
+            if (level < node.level) {
+                int source = update_source(u, chunk, x, y, z, block.type);
+                if (source >= level) {
+                    // Holds its level on its own: nothing it lit depends on the removed cell
+                    if (source > level) update_store(u, chunk, x, y, z, source);
+                    queue_push(&u->add, x, y, z, 0);
+                    continue;
+                }
+                update_store(u, chunk, x, y, z, source);
+                queue_push(&u->removal, x, y, z, level);
+                if (source > 0) queue_push(&u->add, x, y, z, 0);
+            } else {
+                queue_push(&u->add, x, y, z, 0);
+            }
+        }
+    }
 }
 
 /**
- * Recalculate light for a single column and repropagate
+ * Spread light from queued cells into dimmer air and transparent neighbors
  */
-void light_update_column(Chunk* chunk, int x, int z) {
+static void update_run_add(LightUpdate* u) {
+    LightNode node;
+    while (queue_pop(&u->add, &node)) {
+        Chunk* chunk = update_chunk_at(u, node.x, node.z);
+        if (!chunk) continue;
+        int level = chunk_get_light(chunk, node.x - chunk->x * CHUNK_SIZE, node.y,
+                                    node.z - chunk->z * CHUNK_SIZE) - 1;
+        if (level <= 0) continue;
+
+        for (int d = 0; d < 6; d++) {
+            int x = node.x + g_directions[d][0];
+            int y = node.y + g_directions[d][1];
+            int z = node.z + g_directions[d][2];
+            if (y < 0 || y >= CHUNK_HEIGHT) continue;
+
+            Chunk* neighbor = update_chunk_at(u, x, z);
+            if (!neighbor) continue;
+            Block block = chunk_get_block(neighbor, x - neighbor->x * CHUNK_SIZE, y,
+                                          z - neighbor->z * CHUNK_SIZE);
+            if (!block_type_passes_light(block.type) || block.light_level >= level) continue;
+
+            update_store(u, neighbor, x, y, z, level);
+            queue_push(&u->add, x, y, z, 0);
+        }
+    }
+}
+
+void light_update_block(World* world, int x, int y, int z, Block old) {
+    if (!world || y < 0 || y >= CHUNK_HEIGHT) return;
+
+    LightUpdate* u = update_begin(world);
+    Chunk* chunk = update_chunk_at(u, x, z);
     if (!chunk) return;
-    if (x < 0 || x >= CHUNK_SIZE || z < 0 || z >= CHUNK_SIZE) return;
+    int local_x = x - chunk->x * CHUNK_SIZE;
+    int local_z = z - chunk->z * CHUNK_SIZE;
+
+    // The edit wrote the new block's light level over the old one
+    chunk_set_light(chunk, local_x, y, local_z, old.light_level);
+
+    // The skylight arriving at the block is unchanged (nothing above it
+    // changed). Below it, the old column is replayed with the old block
+    // until both columns agree again, which they then do all the way down.
+    const uint8_t* sky = update_sky_column(u, chunk, x, z);
+    int old_sky = sky[y];
+    for (int yy = y; yy >= 0; yy--) {
+        if (yy < y && old_sky == sky[yy]) break;
+
+        Block block = chunk_get_block(chunk, local_x, yy, local_z);
+        int emission = g_block_light_emission[block.type];
+        int source = sky[yy] > emission ? sky[yy] : emission;
+        update_seed(u, chunk, x, yy, z, block.light_level, source);
+
+        old_sky = sky_below(yy == y ? old.type : block.type, old_sky);
+    }
+
+    // An opened block is lit by its neighbors
+    Block block = chunk_get_block(chunk, local_x, y, local_z);
+    if (block_type_passes_light(block.type)) {
+        for (int d = 0; d < 6; d++) {
+            int ny = y + g_directions[d][1];
+            if (ny < 0 || ny >= CHUNK_HEIGHT) continue;
+            queue_push(&u->add, x + g_directions[d][0], ny, z + g_directions[d][2], 0);
+        }
+    }
+
+    update_run_removal(u);
+    update_run_add(u);
+}
+
+void light_stitch_chunk(World* world, Chunk* chunk) {
+    if (!world || !chunk) return;
+
+    LightUpdate* u = update_begin(world);
+    int origin_x = chunk->x * CHUNK_SIZE;
+    int origin_z = chunk->z * CHUNK_SIZE;
+    if (update_chunk_at(u, origin_x, origin_z) != chunk) return;
+
+    // Queue the brighter cell of every border pair that can light the other
+    for (int side = 0; side < 4; side++) {
+        int dx = side == 0 ? -1 : (side == 1 ? 1 : 0);
+        int dz = side == 2 ? -1 : (side == 3 ? 1 : 0);
+        Chunk* neighbor = update_chunk_at(u, origin_x + dx * CHUNK_SIZE, origin_z + dz * CHUNK_SIZE);
+        if (!neighbor) continue;
+
+        // Above both chunks' highest blocks there is full skylight on each side
+        int top = chunk->max_block_y > neighbor->max_block_y ? chunk->max_block_y : neighbor->max_block_y;
+        if (top > CHUNK_HEIGHT - 2) top = CHUNK_HEIGHT - 2;
+
+        for (int i = 0; i < CHUNK_SIZE; i++) {
+            int inside_x = dx == 0 ? i : (dx < 0 ? 0 : CHUNK_SIZE - 1);
+            int inside_z = dz == 0 ? i : (dz < 0 ? 0 : CHUNK_SIZE - 1);
+            int outside_x = dx == 0 ? i : CHUNK_SIZE - 1 - inside_x;
+            int outside_z = dz == 0 ? i : CHUNK_SIZE - 1 - inside_z;
+
+            for (int y = 0; y <= top + 1; y++) {
+                Block a = chunk_get_block(chunk, inside_x, y, inside_z);
+                Block b = chunk_get_block(neighbor, outside_x, y, outside_z);
+                if (a.light_level > b.light_level + 1 && block_type_passes_light(b.type)) {
+                    queue_push(&u->add, origin_x + inside_x, y, origin_z + inside_z, 0);
+                } else if (b.light_level > a.light_level + 1 && block_type_passes_light(a.type)) {
+                    queue_push(&u->add, neighbor->x * CHUNK_SIZE + outside_x, y,
+                               neighbor->z * CHUNK_SIZE + outside_z, 0);
+                }
+            }
+        }
+    }
 
-    calculate_column_skylight(chunk, x, z);
-    propagate_light(chunk);
-    chunk->needs_remesh = true;
+    update_run_add(u);
 }
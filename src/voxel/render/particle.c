@@ -4,6 +4,7 @@
 
 #include "voxel/render/particle.h"
 #include "voxel/core/texture_atlas.h"
+#include "voxel/render/frame_uniforms.h"
 #include <raymath.h>
 #include <rlgl.h>
 #include <stdlib.h>
@@ -16,16 +17,65 @@ static ParticleSystem g_particles;
 // Gravity constant
 #define PARTICLE_GRAVITY 15.0f
 
+#define PARTICLE_QUAD_VERTICES 6  // Two triangles per instance, corners picked by gl_VertexID
+
 /**
- * Find an inactive particle slot
+ * Append a particle at the end of the live range
+ * Returns its index, or -1 when the pool is full
  */
-static Particle* find_inactive_particle(void) {
-    for (int i = 0; i < MAX_PARTICLES; i++) {
-        if (!g_particles.particles[i].active) {
-            return &g_particles.particles[i];
-        }
-    }
-    return NULL;  // All particles in use
+static int particle_alloc(ParticleType type) {
+    if (g_particles.active_count >= MAX_PARTICLES) return -1;
+    int i = g_particles.active_count++;
+    g_particles.type[i] = (unsigned char)type;
+    return i;
+}
+
+/**
+ * Remove particle i by moving the last live particle into its slot
+ */
+static void particle_remove(int i) {
+    int last = --g_particles.active_count;
+    if (i == last) return;
+
+    g_particles.position[i] = g_particles.position[last];
+    g_particles.velocity[i] = g_particles.velocity[last];
+    g_particles.color[i] = g_particles.color[last];
+    g_particles.size[i] = g_particles.size[last];
+    g_particles.life[i] = g_particles.life[last];
+    g_particles.max_life[i] = g_particles.max_life[last];
+    g_particles.uv[i] = g_particles.uv[last];
+    g_particles.type[i] = g_particles.type[last];
+}
+
+/**
+ * Create the instance buffer and its VAO for the loaded particle shader
+ */
+static bool particle_create_buffers(void) {
+    Shader shader = g_particles.shader;
+    int position_loc = GetShaderLocationAttrib(shader, "instancePosition");
+    int tex_rect_loc = GetShaderLocationAttrib(shader, "instanceTexRect");
+    int color_loc = GetShaderLocationAttrib(shader, "instanceColor");
+    if (position_loc < 0 || tex_rect_loc < 0 || color_loc < 0) return false;
+
+    g_particles.vao_id = rlLoadVertexArray();
+    if (g_particles.vao_id == 0) return false;
+
+    rlEnableVertexArray(g_particles.vao_id);
+    g_particles.instance_vbo = rlLoadVertexBuffer(NULL, (int)sizeof(g_particles.instances), true);
+
+    int stride = (int)sizeof(ParticleInstance);
+    rlSetVertexAttribute(position_loc, 4, RL_FLOAT, false, stride, 0);
+    rlEnableVertexAttribute(position_loc);
+    rlSetVertexAttributeDivisor(position_loc, 1);
+    rlSetVertexAttribute(tex_rect_loc, 4, RL_FLOAT, false, stride, 4 * sizeof(float));
+    rlEnableVertexAttribute(tex_rect_loc);
+    rlSetVertexAttributeDivisor(tex_rect_loc, 1);
+    rlSetVertexAttribute(color_loc, 4, RL_UNSIGNED_BYTE, true, stride, 8 * sizeof(float));
+    rlEnableVertexAttribute(color_loc);
+    rlSetVertexAttributeDivisor(color_loc, 1);
+
+    rlDisableVertexArray();
+    return g_particles.instance_vbo != 0;
 }
 
 void particle_system_init(void) {
@@ -34,18 +84,24 @@ void particle_system_init(void) {
     // Load particle shader
     g_particles.shader = LoadShader("shaders/particle.vs", "shaders/particle.fs");
 
-    if (g_particles.shader.id == 0) {
-        printf("[PARTICLE] Warning: Failed to load particle shaders, using default\n");
-        g_particles.shader = LoadShaderFromMemory(NULL, NULL);
+    if (g_particles.shader.id == 0 || g_particles.shader.id == rlGetShaderIdDefault() ||
+        !particle_create_buffers()) {
+        printf("[PARTICLE] Warning: Failed to load particle shaders, drawing quads through rlgl\n");
+    } else {
+        frame_uniforms_bind_shader(g_particles.shader);
+        g_particles.instanced = true;
     }
 
     g_particles.initialized = true;
-    printf("[PARTICLE] System initialized (max %d particles)\n", MAX_PARTICLES);
+    printf("[PARTICLE] System initialized (max %d particles, %s)\n", MAX_PARTICLES,
+           g_particles.instanced ? "instanced" : "immediate");
 }
 
 void particle_system_destroy(void) {
     if (!g_particles.initialized) return;
 
+    if (g_particles.instance_vbo != 0) rlUnloadVertexBuffer(g_particles.instance_vbo);
+    if (g_particles.vao_id != 0) rlUnloadVertexArray(g_particles.vao_id);
     UnloadShader(g_particles.shader);
     memset(&g_particles, 0, sizeof(ParticleSystem));
 
@@ -55,85 +111,136 @@ void particle_system_destroy(void) {
 void particle_system_update(float dt) {
     if (!g_particles.initialized) return;
 
-    for (int i = 0; i < MAX_PARTICLES; i++) {
-        Particle* p = &g_particles.particles[i];
-        if (!p->active) continue;
+    // Air resistance on horizontal velocity
+    float damping = 0.98f;
 
-        // Apply gravity
-        p->velocity.y -= PARTICLE_GRAVITY * dt;
+    // Walk backwards so a swapped-in particle has already been updated
+    for (int i = g_particles.active_count - 1; i >= 0; i--) {
+        Vector3* velocity = &g_particles.velocity[i];
+        Vector3* position = &g_particles.position[i];
 
-        // Apply velocity damping (air resistance)
-        float damping = 0.98f;
-        p->velocity.x *= damping;
-        p->velocity.z *= damping;
+        velocity->y -= PARTICLE_GRAVITY * dt;
+        velocity->x *= damping;
+        velocity->z *= damping;
 
-        // Update position
-        p->position.x += p->velocity.x * dt;
-        p->position.y += p->velocity.y * dt;
-        p->position.z += p->velocity.z * dt;
+        position->x += velocity->x * dt;
+        position->y += velocity->y * dt;
+        position->z += velocity->z * dt;
 
-        // Update lifetime
-        p->life -= dt;
+        g_particles.life[i] -= dt;
 
-        // Deactivate expired or underground particles
-        if (p->life <= 0.0f || p->position.y < 0.0f) {
-            p->active = false;
-            g_particles.active_count--;
+        // Remove expired or underground particles
+        if (g_particles.life[i] <= 0.0f || position->y < 0.0f) {
+            particle_remove(i);
         }
     }
 }
 
+/**
+ * Fill the instance array from the live particles (fade and shrink with age)
+ */
+static void particle_build_instances(void) {
+    for (int i = 0; i < g_particles.active_count; i++) {
+        ParticleInstance* inst = &g_particles.instances[i];
+
+        // Calculate alpha based on remaining life
+        float alpha = g_particles.life[i] / g_particles.max_life[i];
+        alpha = alpha * alpha;  // Ease out
+
+        Vector3 p = g_particles.position[i];
+        Rectangle uv = g_particles.uv[i];
+        Color c = g_particles.color[i];
+
+        inst->x = p.x;
+        inst->y = p.y;
+        inst->z = p.z;
+        inst->size = g_particles.size[i] * (0.5f + 0.5f * alpha);  // Shrink slightly as it ages
+        inst->u_min = uv.x;
+        inst->v_min = uv.y;
+        inst->u_max = uv.x + uv.width;
+        inst->v_max = uv.y + uv.height;
+        inst->color[0] = c.r;
+        inst->color[1] = c.g;
+        inst->color[2] = c.b;
+        inst->color[3] = (unsigned char)(alpha * 255.0f);
+    }
+}
+
+/**
+ * Fallback without the particle shader: CPU billboards through rlgl
+ */
+static void particle_render_immediate(Vector3 camera_right, Vector3 camera_up) {
+    rlBegin(RL_QUADS);
+    for (int i = 0; i < g_particles.active_count; i++) {
+        const ParticleInstance* inst = &g_particles.instances[i];
+        Vector3 center = {inst->x, inst->y, inst->z};
+
+        // Calculate billboard corners
+        Vector3 right = Vector3Scale(camera_right, inst->size * 0.5f);
+        Vector3 up = Vector3Scale(camera_up, inst->size * 0.5f);
+
+        Vector3 bl = Vector3Subtract(Vector3Subtract(center, right), up);
+        Vector3 br = Vector3Subtract(Vector3Add(center, right), up);
+        Vector3 tr = Vector3Add(Vector3Add(center, right), up);
+        Vector3 tl = Vector3Add(Vector3Subtract(center, right), up);
+
+        rlColor4ub(inst->color[0], inst->color[1], inst->color[2], inst->color[3]);
+
+        // Draw quad (counter-clockwise)
+        rlTexCoord2f(inst->u_min, inst->v_max); rlVertex3f(bl.x, bl.y, bl.z);
+        rlTexCoord2f(inst->u_max, inst->v_max); rlVertex3f(br.x, br.y, br.z);
+        rlTexCoord2f(inst->u_max, inst->v_min); rlVertex3f(tr.x, tr.y, tr.z);
+        rlTexCoord2f(inst->u_min, inst->v_min); rlVertex3f(tl.x, tl.y, tl.z);
+    }
+    rlEnd();
+}
+
 void particle_system_render(Camera3D camera) {
     if (!g_particles.initialized || g_particles.active_count == 0) return;
 
-    // Get camera vectors for billboarding
-    Vector3 camera_forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
-    Vector3 camera_right = Vector3Normalize(Vector3CrossProduct(camera_forward, camera.up));
-    Vector3 camera_up = Vector3CrossProduct(camera_right, camera_forward);
-
     // Get texture atlas
     Texture2D atlas = texture_atlas_get_texture();
 
+    particle_build_instances();
+
     // Enable blending for transparent particles
     rlSetBlendMode(RL_BLEND_ALPHA);
-    rlSetTexture(atlas.id);
-
-    rlBegin(RL_QUADS);
 
-    for (int i = 0; i < MAX_PARTICLES; i++) {
-        Particle* p = &g_particles.particles[i];
-        if (!p->active) continue;
+    if (!g_particles.instanced) {
+        // Get camera vectors for billboarding (the instanced shader reads them from FrameUniforms)
+        Vector3 camera_forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+        Vector3 camera_right = Vector3Normalize(Vector3CrossProduct(camera_forward, camera.up));
+        Vector3 camera_up = Vector3CrossProduct(camera_right, camera_forward);
 
-        // Calculate alpha based on remaining life
-        float alpha = p->life / p->max_life;
-        alpha = alpha * alpha;  // Ease out
-
-        // Scale size slightly as particle ages
-        float size = p->size * (0.5f + 0.5f * alpha);
-        float half_size = size * 0.5f;
+        rlSetTexture(atlas.id);
+        particle_render_immediate(camera_right, camera_up);
+        rlSetTexture(0);
+        return;
+    }
 
-        // Calculate billboard corners
-        Vector3 right = Vector3Scale(camera_right, half_size);
-        Vector3 up = Vector3Scale(camera_up, half_size);
+    // Anything rlgl batched so far must land before our own draw call
+    rlDrawRenderBatchActive();
 
-        Vector3 bl = Vector3Subtract(Vector3Subtract(p->position, right), up);
-        Vector3 br = Vector3Subtract(Vector3Add(p->position, right), up);
-        Vector3 tr = Vector3Add(Vector3Add(p->position, right), up);
-        Vector3 tl = Vector3Add(Vector3Subtract(p->position, right), up);
+    int count = g_particles.active_count;
+    rlUpdateVertexBuffer(g_particles.instance_vbo, g_particles.instances,
+                         count * (int)sizeof(ParticleInstance), 0);
 
-        // Set color with alpha fade
-        unsigned char a = (unsigned char)(alpha * 255.0f);
-        rlColor4ub(p->color.r, p->color.g, p->color.b, a);
+    Shader shader = g_particles.shader;
+    rlEnableShader(shader.id);
 
-        // Draw quad (counter-clockwise)
-        rlTexCoord2f(p->u_min, p->v_max); rlVertex3f(bl.x, bl.y, bl.z);
-        rlTexCoord2f(p->u_max, p->v_max); rlVertex3f(br.x, br.y, br.z);
-        rlTexCoord2f(p->u_max, p->v_min); rlVertex3f(tr.x, tr.y, tr.z);
-        rlTexCoord2f(p->u_min, p->v_min); rlVertex3f(tl.x, tl.y, tl.z);
+    int texture_slot = 0;
+    rlActiveTextureSlot(texture_slot);
+    rlEnableTexture(atlas.id);
+    if (shader.locs[SHADER_LOC_MAP_DIFFUSE] != -1) {
+        rlSetUniform(shader.locs[SHADER_LOC_MAP_DIFFUSE], &texture_slot, RL_SHADER_UNIFORM_INT, 1);
     }
 
-    rlEnd();
-    rlSetTexture(0);
+    rlEnableVertexArray(g_particles.vao_id);
+    rlDrawVertexArrayInstanced(0, PARTICLE_QUAD_VERTICES, count);
+    rlDisableVertexArray();
+
+    rlDisableTexture();
+    rlDisableShader();
 }
 
 void particle_spawn_block_break(Vector3 position, BlockType block_type, int count) {
@@ -149,36 +256,30 @@ void particle_spawn_block_break(Vector3 position, BlockType block_type, int coun
     float u_size = (tex.u_max - tex.u_min) * tex_margin;
     float v_size = (tex.v_max - tex.v_min) * tex_margin;
 
-    for (int i = 0; i < count && g_particles.active_count < MAX_PARTICLES; i++) {
-        Particle* p = find_inactive_particle();
-        if (!p) break;
-
-        p->active = true;
-        p->type = PARTICLE_TYPE_BLOCK_BREAK;
+    for (int n = 0; n < count; n++) {
+        int i = particle_alloc(PARTICLE_TYPE_BLOCK_BREAK);
+        if (i < 0) break;
+        Vector3* pos = &g_particles.position[i];
+        Vector3* vel = &g_particles.velocity[i];
 
         // Random position within the block
-        p->position.x = position.x + 0.5f + ((float)(rand() % 100) / 100.0f - 0.5f) * 0.8f;
-        p->position.y = position.y + 0.5f + ((float)(rand() % 100) / 100.0f - 0.5f) * 0.8f;
-        p->position.z = position.z + 0.5f + ((float)(rand() % 100) / 100.0f - 0.5f) * 0.8f;
+        pos->x = position.x + 0.5f + ((float)(rand() % 100) / 100.0f - 0.5f) * 0.8f;
+        pos->y = position.y + 0.5f + ((float)(rand() % 100) / 100.0f - 0.5f) * 0.8f;
+        pos->z = position.z + 0.5f + ((float)(rand() % 100) / 100.0f - 0.5f) * 0.8f;
 
         // Random velocity - mostly upward and outward
-        p->velocity.x = ((float)(rand() % 100) / 100.0f - 0.5f) * 4.0f;
-        p->velocity.y = ((float)(rand() % 100) / 100.0f) * 5.0f + 2.0f;
-        p->velocity.z = ((float)(rand() % 100) / 100.0f - 0.5f) * 4.0f;
+        vel->x = ((float)(rand() % 100) / 100.0f - 0.5f) * 4.0f;
+        vel->y = ((float)(rand() % 100) / 100.0f) * 5.0f + 2.0f;
+        vel->z = ((float)(rand() % 100) / 100.0f - 0.5f) * 4.0f;
 
         // Particle properties
-        p->size = 0.15f + ((float)(rand() % 100) / 1000.0f);
-        p->life = 0.5f + ((float)(rand() % 100) / 200.0f);
-        p->max_life = p->life;
-        p->color = WHITE;
+        g_particles.size[i] = 0.15f + ((float)(rand() % 100) / 1000.0f);
+        g_particles.life[i] = 0.5f + ((float)(rand() % 100) / 200.0f);
+        g_particles.max_life[i] = g_particles.life[i];
+        g_particles.color[i] = WHITE;
 
         // Texture coordinates (small piece of block texture)
-        p->u_min = u_center - u_size;
-        p->u_max = u_center + u_size;
-        p->v_min = v_center - v_size;
-        p->v_max = v_center + v_size;
-
-        g_particles.active_count++;
+        g_particles.uv[i] = (Rectangle){u_center - u_size, v_center - v_size, 2.0f * u_size, 2.0f * v_size};
     }
 }
 
@@ -188,46 +289,40 @@ void particle_spawn_water_splash(Vector3 position, int count, bool upward) {
     // Get water texture for splash particles
     TextureCoords tex = texture_atlas_get_coords(BLOCK_WATER, FACE_TOP);
 
-    for (int i = 0; i < count && g_particles.active_count < MAX_PARTICLES; i++) {
-        Particle* p = find_inactive_particle();
-        if (!p) break;
-
-        p->active = true;
-        p->type = PARTICLE_TYPE_WATER_SPLASH;
+    for (int n = 0; n < count; n++) {
+        int i = particle_alloc(PARTICLE_TYPE_WATER_SPLASH);
+        if (i < 0) break;
+        Vector3* pos = &g_particles.position[i];
+        Vector3* vel = &g_particles.velocity[i];
 
         // Position at water surface
-        p->position.x = position.x + ((float)(rand() % 100) / 100.0f - 0.5f) * 0.5f;
-        p->position.y = position.y;
-        p->position.z = position.z + ((float)(rand() % 100) / 100.0f - 0.5f) * 0.5f;
+        pos->x = position.x + ((float)(rand() % 100) / 100.0f - 0.5f) * 0.5f;
+        pos->y = position.y;
+        pos->z = position.z + ((float)(rand() % 100) / 100.0f - 0.5f) * 0.5f;
 
         // Velocity depends on direction
         float speed = 3.0f + ((float)(rand() % 100) / 100.0f) * 2.0f;
         float angle = ((float)(rand() % 360)) * DEG2RAD;
 
-        p->velocity.x = cosf(angle) * speed * 0.5f;
-        p->velocity.z = sinf(angle) * speed * 0.5f;
+        vel->x = cosf(angle) * speed * 0.5f;
+        vel->z = sinf(angle) * speed * 0.5f;
 
         if (upward) {
             // Exiting water - spray upward
-            p->velocity.y = speed;
+            vel->y = speed;
         } else {
             // Entering water - smaller splash
-            p->velocity.y = speed * 0.3f;
+            vel->y = speed * 0.3f;
         }
 
         // Particle properties
-        p->size = 0.1f + ((float)(rand() % 50) / 500.0f);
-        p->life = 0.3f + ((float)(rand() % 100) / 300.0f);
-        p->max_life = p->life;
-        p->color = (Color){100, 150, 255, 200};  // Light blue
+        g_particles.size[i] = 0.1f + ((float)(rand() % 50) / 500.0f);
+        g_particles.life[i] = 0.3f + ((float)(rand() % 100) / 300.0f);
+        g_particles.max_life[i] = g_particles.life[i];
+        g_particles.color[i] = (Color){100, 150, 255, 200};  // Light blue
 
         // Texture coordinates
-        p->u_min = tex.u_min;
-        p->u_max = tex.u_max;
-        p->v_min = tex.v_min;
-        p->v_max = tex.v_max;
-
-        g_particles.active_count++;
+        g_particles.uv[i] = (Rectangle){tex.u_min, tex.v_min, tex.u_max - tex.u_min, tex.v_max - tex.v_min};
     }
 }
 
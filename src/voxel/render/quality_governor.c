@@ -0,0 +1,151 @@
+/**
+ * Quality Governor Implementation
+ */
+
+#include "voxel/render/quality_governor.h"
+#include "voxel/world/world.h"
+#include "voxel/world/chunk_worker.h"
+#include "voxel/core/memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GOVERNOR_GPU_SMOOTHING 0.1f
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+static int compare_floats(const void* a, const void* b) {
+    float fa = *(const float*)a;
+    float fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+/**
+ * Value below which GOVERNOR_PERCENTILE of the window falls
+ */
+static float window_percentile(const float* samples, int count) {
+    float sorted[GOVERNOR_WINDOW];
+    memcpy(sorted, samples, (size_t)count * sizeof(float));
+    qsort(sorted, (size_t)count, sizeof(float), compare_floats);
+    int index = (int)(GOVERNOR_PERCENTILE * (float)(count - 1) + 0.5f);
+    return sorted[index];
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+void quality_governor_init(QualityGovernor* governor) {
+    if (!governor) return;
+
+    memset(governor, 0, sizeof(QualityGovernor));
+    governor->wait = GOVERNOR_COOLDOWN;  // Startup streaming
+    if (!gpu_timer_init(&governor->gpu_timer)) {
+        printf("[GOVERNOR] Timer queries unavailable, governing by CPU time only\n");
+    }
+}
+
+void quality_governor_destroy(QualityGovernor* governor) {
+    if (!governor) return;
+    gpu_timer_destroy(&governor->gpu_timer);
+}
+
+void quality_governor_begin_gpu(QualityGovernor* governor) {
+    if (!governor) return;
+    gpu_timer_begin(&governor->gpu_timer);
+}
+
+void quality_governor_end_gpu(QualityGovernor* governor) {
+    if (!governor) return;
+    gpu_timer_end(&governor->gpu_timer, 0);
+}
+
+void quality_governor_reset(QualityGovernor* governor) {
+    if (!governor) return;
+
+    governor->sample_count = 0;
+    governor->sample_next = 0;
+    governor->wait = GOVERNOR_INTERVAL;
+}
+
+void quality_governor_update(QualityGovernor* governor, World* world, float frame_ms, float busy_ms,
+                             int max_view_distance, int max_lod_distance, bool frame_rate) {
+    if (!governor || !world) return;
+
+    double gpu_ms;
+    while (gpu_timer_poll(&governor->gpu_timer, &gpu_ms, NULL)) {
+        governor->gpu_ms = governor->gpu_ms > 0.0f
+            ? governor->gpu_ms + ((float)gpu_ms - governor->gpu_ms) * GOVERNOR_GPU_SMOOTHING
+            : (float)gpu_ms;
+    }
+
+    governor->frame_ms[governor->sample_next] = frame_ms;
+    governor->busy_ms[governor->sample_next] = busy_ms;
+    governor->sample_next = (governor->sample_next + 1) % GOVERNOR_WINDOW;
+    if (governor->sample_count < GOVERNOR_WINDOW) governor->sample_count++;
+
+    governor->wait -= frame_ms / 1000.0f;
+    if (governor->wait > 0.0f || governor->sample_count < GOVERNOR_WINDOW / 2) return;
+    governor->wait = GOVERNOR_INTERVAL;
+
+    int view = world_get_view_distance(world);
+    int lod = world_get_lod_distance(world);
+    int min_view = max_view_distance < GOVERNOR_MIN_VIEW_DISTANCE ? max_view_distance : GOVERNOR_MIN_VIEW_DISTANCE;
+    int min_lod = max_lod_distance < GOVERNOR_MIN_LOD_DISTANCE ? max_lod_distance : GOVERNOR_MIN_LOD_DISTANCE;
+    int new_view = view > max_view_distance ? max_view_distance : view;
+    int new_lod = lod > max_lod_distance ? max_lod_distance : lod;
+
+    // Frame time catches missed frames; busy and GPU time show the headroom
+    // the frame cap hides
+    float target = GOVERNOR_TARGET_FRAME_MS;
+    float frame_p = window_percentile(governor->frame_ms, governor->sample_count);
+    float busy_p = window_percentile(governor->busy_ms, governor->sample_count);
+    bool slow = frame_p > target * GOVERNOR_SLOW_FACTOR || governor->gpu_ms > target * GOVERNOR_SLOW_FACTOR;
+    bool fast = busy_p < target * GOVERNOR_FAST_FACTOR && governor->gpu_ms < target * GOVERNOR_FAST_FACTOR;
+    if (!frame_rate) {
+        slow = false;
+        fast = true;
+    }
+
+    // Over a memory budget always steps down; nearing one holds quality
+    MemoryPressure heap = memory_get_pressure(MEMORY_HEAP);
+    MemoryPressure gpu = memory_get_pressure(MEMORY_GPU);
+    MemoryPressure pressure = heap > gpu ? heap : gpu;
+    bool heap_only = heap == MEMORY_PRESSURE_OVER && gpu != MEMORY_PRESSURE_OVER;
+    if (pressure == MEMORY_PRESSURE_OVER) slow = true;
+    if (pressure >= (frame_rate ? MEMORY_PRESSURE_HIGH : MEMORY_PRESSURE_MODERATE)) fast = false;
+    fast = fast && chunk_worker_pending_count(world->worker) <= GOVERNOR_MAX_PENDING;
+
+    if (new_view == view && new_lod == lod) {
+        if (slow && heap_only) {
+            // Loaded chunks scale with the view area; LOD rings barely matter
+            if (new_view > min_view) new_view--;
+            else if (new_lod > min_lod) new_lod--;
+        } else if (slow) {
+            // The full-detail ring first: it keeps the horizon
+            if (new_lod > min_lod) new_lod--;
+            else if (new_view > min_view) new_view--;
+        } else if (fast) {
+            if (new_view < max_view_distance) new_view++;
+            else if (new_lod < max_lod_distance) new_lod++;
+        }
+    }
+    if (new_view == view && new_lod == lod) return;
+
+    if (pressure == MEMORY_PRESSURE_OVER) {
+        printf("[GOVERNOR] Heap %zu/%zu MB, GPU %zu/%zu MB: view %d -> %d, LOD %d -> %d\n",
+               memory_get_total(MEMORY_HEAP) / (1024 * 1024), memory_get_budget(MEMORY_HEAP) / (1024 * 1024),
+               memory_get_total(MEMORY_GPU) / (1024 * 1024), memory_get_budget(MEMORY_GPU) / (1024 * 1024),
+               view, new_view, lod, new_lod);
+    } else {
+        printf("[GOVERNOR] p%d frame %.1f ms, busy %.1f ms, GPU %.1f ms: view %d -> %d, LOD %d -> %d\n",
+               (int)(GOVERNOR_PERCENTILE * 100.0f), frame_p, busy_p, governor->gpu_ms, view, new_view, lod, new_lod);
+    }
+    world_set_view_distance(world, new_view);
+    world_set_lod_distance(world, new_lod);
+    governor->sample_count = 0;
+    governor->sample_next = 0;
+    governor->wait = GOVERNOR_COOLDOWN;
+}
@@ -0,0 +1,315 @@
+/**
+ * Headless Render Stub
+ *
+ * Linked in place of the GL render modules and raylib by headless builds
+ * (server, benchmark, load test). A headless world creates no pool, batcher,
+ * culler, LOD or upload budget and never meshes, so world code only reaches
+ * these with NULL objects; each stub returns what the real function returns
+ * then. The drawing calls (entity models, name tags, world rendering) are
+ * never reached and do nothing.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "voxel/render/chunk_batcher.h"
+#include "voxel/render/chunk_culler.h"
+#include "voxel/render/chunk_lod.h"
+#include "voxel/render/chunk_mesh.h"
+#include "voxel/render/chunk_pool.h"
+#include "voxel/render/chunk_water.h"
+#include "voxel/render/entity_renderer.h"
+#include "voxel/render/frame_uniforms.h"
+#include "voxel/render/upload_budget.h"
+#include "voxel/core/texture_atlas.h"
+#include <string.h>
+#include <time.h>
+#include <raylib.h>
+#include <rlgl.h>
+
+// ============================================================================
+// CHUNK RENDERING
+// ============================================================================
+
+ChunkPool* chunk_pool_create(void) {
+    return NULL;
+}
+
+void chunk_pool_destroy(ChunkPool* pool) {
+    (void)pool;
+}
+
+void chunk_pool_write_chunk(ChunkPool* pool, Chunk* chunk) {
+    (void)pool; (void)chunk;
+}
+
+bool chunk_pool_splice_chunk(ChunkPool* pool, Chunk* chunk) {
+    (void)pool; (void)chunk;
+    return false;
+}
+
+void chunk_pool_release_chunk(ChunkPool* pool, Chunk* chunk) {
+    (void)pool; (void)chunk;
+}
+
+void chunk_pool_update(ChunkPool* pool) {
+    (void)pool;
+}
+
+void chunk_pool_render_opaque(ChunkPool* pool, World* world, Material material, Vector3 camera_pos) {
+    (void)pool; (void)world; (void)material; (void)camera_pos;
+}
+
+void chunk_pool_render_transparent(ChunkPool* pool, World* world, Material material, Vector3 camera_pos) {
+    (void)pool; (void)world; (void)material; (void)camera_pos;
+}
+
+ChunkBatcher* chunk_batcher_create(void) {
+    return NULL;
+}
+
+void chunk_batcher_destroy(ChunkBatcher* batcher) {
+    (void)batcher;
+}
+
+void chunk_batcher_register_chunk(ChunkBatcher* batcher, Chunk* chunk) {
+    (void)batcher; (void)chunk;
+}
+
+void chunk_batcher_unregister_chunk(ChunkBatcher* batcher, Chunk* chunk) {
+    (void)batcher; (void)chunk;
+}
+
+bool chunk_batcher_splice_chunk(ChunkBatcher* batcher, Chunk* chunk) {
+    (void)batcher; (void)chunk;
+    return false;
+}
+
+void chunk_batcher_invalidate(ChunkBatcher* batcher, int chunk_x, int chunk_z) {
+    (void)batcher; (void)chunk_x; (void)chunk_z;
+}
+
+int chunk_batcher_update(ChunkBatcher* batcher, World* world, int max_rebuilds, UploadBudget* budget) {
+    (void)batcher; (void)world; (void)max_rebuilds; (void)budget;
+    return 0;
+}
+
+void chunk_batcher_render_opaque(ChunkBatcher* batcher, World* world, Material material, Vector3 camera_pos) {
+    (void)batcher; (void)world; (void)material; (void)camera_pos;
+}
+
+void chunk_batcher_render_transparent(ChunkBatcher* batcher, World* world, Material material, Vector3 camera_pos) {
+    (void)batcher; (void)world; (void)material; (void)camera_pos;
+}
+
+ChunkCuller* chunk_culler_create(void) {
+    return NULL;
+}
+
+void chunk_culler_destroy(ChunkCuller* culler) {
+    (void)culler;
+}
+
+void chunk_culler_update(ChunkCuller* culler, World* world, Vector3 camera_pos) {
+    (void)culler; (void)world; (void)camera_pos;
+}
+
+// Without LOD every chunk is full detail and none is covered
+ChunkLod* chunk_lod_create(int lod_distance) {
+    (void)lod_distance;
+    return NULL;
+}
+
+void chunk_lod_destroy(ChunkLod* lod) {
+    (void)lod;
+}
+
+void chunk_lod_set_distance(ChunkLod* lod, int lod_distance) {
+    (void)lod; (void)lod_distance;
+}
+
+bool chunk_lod_full_detail(const ChunkLod* lod, int center_x, int center_z,
+                           int chunk_x, int chunk_z, int margin) {
+    (void)lod; (void)center_x; (void)center_z; (void)chunk_x; (void)chunk_z; (void)margin;
+    return true;
+}
+
+bool chunk_lod_covers(const ChunkLod* lod, int chunk_x, int chunk_z) {
+    (void)lod; (void)chunk_x; (void)chunk_z;
+    return false;
+}
+
+void chunk_lod_update(ChunkLod* lod, World* world) {
+    (void)lod; (void)world;
+}
+
+void chunk_lod_hide_covered(const ChunkLod* lod, ChunkCuller* culler) {
+    (void)lod; (void)culler;
+}
+
+void chunk_lod_render_opaque(ChunkLod* lod, World* world, Material material) {
+    (void)lod; (void)world; (void)material;
+}
+
+void chunk_lod_render_transparent(ChunkLod* lod, World* world, Material material, Vector3 camera_pos) {
+    (void)lod; (void)world; (void)material; (void)camera_pos;
+}
+
+void chunk_water_build(World* world, Chunk* chunk) {
+    (void)world; (void)chunk;
+}
+
+void chunk_water_destroy(ChunkWater* water) {
+    (void)water;
+}
+
+void chunk_water_render(World* world, Material material, Vector3 camera_pos) {
+    (void)world; (void)material; (void)camera_pos;
+}
+
+bool chunk_water_refresh_block(World* world, Chunk* chunk, int local_x, int y, int local_z) {
+    (void)world; (void)chunk; (void)local_x; (void)y; (void)local_z;
+    return true;
+}
+
+// ============================================================================
+// MESHES AND UPLOADS
+// ============================================================================
+
+bool chunk_mesh_upload(ChunkMesh* mesh, const ChunkVertex* vertices, int vertex_count, bool dynamic,
+                       MemoryCategory category) {
+    (void)mesh; (void)vertices; (void)vertex_count; (void)dynamic; (void)category;
+    return false;
+}
+
+void chunk_mesh_write(ChunkMesh* mesh, int first, const ChunkVertex* vertices, int count) {
+    (void)mesh; (void)first; (void)vertices; (void)count;
+}
+
+void chunk_mesh_copy(unsigned int dst_buffer, int dst_first, const ChunkMesh* src, int src_first, int count) {
+    (void)dst_buffer; (void)dst_first; (void)src; (void)src_first; (void)count;
+}
+
+void chunk_mesh_unload(ChunkMesh* mesh) {
+    if (mesh) memset(mesh, 0, sizeof(ChunkMesh));
+}
+
+void chunk_mesh_release_shared(void) {
+}
+
+// Without a budget every upload is allowed
+UploadBudget* upload_budget_create(void) {
+    return NULL;
+}
+
+void upload_budget_destroy(UploadBudget* budget) {
+    (void)budget;
+}
+
+void upload_budget_begin(UploadBudget* budget) {
+    (void)budget;
+}
+
+bool upload_budget_allows(UploadBudget* budget, size_t bytes) {
+    (void)budget; (void)bytes;
+    return true;
+}
+
+void upload_budget_spend(UploadBudget* budget, size_t bytes) {
+    (void)budget; (void)bytes;
+}
+
+void upload_budget_end(UploadBudget* budget) {
+    (void)budget;
+}
+
+void frame_uniforms_set_camera(FrameUniformData* data, Camera3D camera) {
+    (void)data; (void)camera;
+}
+
+void frame_uniforms_upload(const FrameUniformData* data) {
+    (void)data;
+}
+
+Material texture_atlas_get_material(void) {
+    return (Material){0};
+}
+
+Material texture_atlas_get_water_material(void) {
+    return (Material){0};
+}
+
+// ============================================================================
+// ENTITY DRAWING
+// ============================================================================
+
+void entity_renderer_begin(void) {
+}
+
+void entity_renderer_end(void) {
+}
+
+bool entity_renderer_box_visible(Vector3 min, Vector3 max) {
+    (void)min; (void)max;
+    return false;
+}
+
+void entity_renderer_cube(Vector3 position, float width, float height, float length, Color color) {
+    (void)position; (void)width; (void)height; (void)length; (void)color;
+}
+
+void entity_renderer_sphere(Vector3 center, float radius, Color color) {
+    (void)center; (void)radius; (void)color;
+}
+
+// ============================================================================
+// RAYLIB
+// ============================================================================
+
+double GetTime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int GetScreenWidth(void) {
+    return 0;
+}
+
+int GetScreenHeight(void) {
+    return 0;
+}
+
+Vector2 GetWorldToScreen(Vector3 position, Camera camera) {
+    (void)position; (void)camera;
+    return (Vector2){0};
+}
+
+int MeasureText(const char* text, int fontSize) {
+    (void)text; (void)fontSize;
+    return 0;
+}
+
+void DrawText(const char* text, int posX, int posY, int fontSize, Color color) {
+    (void)text; (void)posX; (void)posY; (void)fontSize; (void)color;
+}
+
+void DrawRectangle(int posX, int posY, int width, int height, Color color) {
+    (void)posX; (void)posY; (void)width; (void)height; (void)color;
+}
+
+void rlPushMatrix(void) {
+}
+
+void rlPopMatrix(void) {
+}
+
+void rlTranslatef(float x, float y, float z) {
+    (void)x; (void)y; (void)z;
+}
+
+void rlRotatef(float angle, float x, float y, float z) {
+    (void)angle; (void)x; (void)y; (void)z;
+}
+
+void rlSetBlendMode(int mode) {
+    (void)mode;
+}
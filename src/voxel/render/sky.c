@@ -1,9 +1,16 @@
 /**
  * Sky Rendering System
  * Implements atmospheric scattering for realistic sky colors
+ *
+ * The expensive part (gradient, sun/moon glow, fbm clouds) is baked into a
+ * small latitude-longitude LUT by sky_bake.fs and re-baked only when
+ * time_of_day moves by SKY_REBAKE_HOURS; the star field is baked once.
+ * The full-screen pass (sky.fs) samples them, so its cost per pixel is a
+ * couple of texture reads no matter the resolution.
  */
 
 #include "voxel/render/sky.h"
+#include "voxel/render/frame_uniforms.h"
 #include <raylib.h>
 #include <raymath.h>
 #include <rlgl.h>
@@ -11,32 +18,122 @@
 #include <math.h>
 
 static Shader sky_shader;
+static Shader bake_shader;
+static Shader stars_shader;
+static RenderTexture2D sky_lut;
+static RenderTexture2D star_map;
 static bool initialized = false;
+static bool lut_baked = false;
+static float baked_time = 0.0f;
+
 static int sun_loc = -1;
+static int sun_color_loc = -1;
+static int moon_visibility_loc = -1;
+static int star_visibility_loc = -1;
 static int time_loc = -1;
-static int cam_forward_loc = -1;
-static int cam_right_loc = -1;
-static int cam_up_loc = -1;
+static int sky_lut_loc = -1;
+static int star_map_loc = -1;
+static int bake_sun_loc = -1;
+static int bake_time_loc = -1;
+
+// ============================================================================
+// BAKING
+// ============================================================================
+
+/**
+ * Quad covering (0,0)-(width,height) with texture coords (0,0)-(1,1),
+ * v = 0 at the bottom row
+ */
+static void draw_quad(int width, int height) {
+    rlSetTexture(rlGetTextureIdDefault());  // Use default white texture
+
+    rlBegin(RL_QUADS);
+        // Bottom-left
+        rlTexCoord2f(0.0f, 0.0f);
+        rlVertex2f(0, height);
+
+        // Bottom-right
+        rlTexCoord2f(1.0f, 0.0f);
+        rlVertex2f(width, height);
+
+        // Top-right
+        rlTexCoord2f(1.0f, 1.0f);
+        rlVertex2f(width, 0);
+
+        // Top-left
+        rlTexCoord2f(0.0f, 1.0f);
+        rlVertex2f(0, 0);
+    rlEnd();
+
+    rlSetTexture(0);
+}
+
+/**
+ * Run a bake shader over every texel of target (blending off: the star map
+ * keeps the twinkle phase in alpha)
+ */
+static void bake_pass(RenderTexture2D target, Shader shader) {
+    BeginTextureMode(target);
+    ClearBackground(BLANK);
+    rlDisableColorBlend();
+
+    BeginShaderMode(shader);
+    draw_quad(target.texture.width, target.texture.height);
+    EndShaderMode();
+
+    rlDrawRenderBatchActive();
+    rlEnableColorBlend();
+    EndTextureMode();
+}
+
+static RenderTexture2D load_lut(int width, int height) {
+    RenderTexture2D target = LoadRenderTexture(width, height);
+    SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR);
+    SetTextureWrap(target.texture, TEXTURE_WRAP_REPEAT);  // Longitude wraps
+    return target;
+}
+
+// ============================================================================
+// API
+// ============================================================================
 
 void sky_init(void) {
-    // Load sky shader
+    // Load sky shaders
     sky_shader = LoadShader("shaders/sky.vs", "shaders/sky.fs");
+    bake_shader = LoadShader("shaders/sky.vs", "shaders/sky_bake.fs");
+    stars_shader = LoadShader("shaders/sky.vs", "shaders/sky_stars.fs");
 
-    if (sky_shader.id > 0) {
+    if (sky_shader.id > 0 && bake_shader.id > 0 && stars_shader.id > 0) {
         printf("[SKY] Sky shader loaded (ID: %d)\n", sky_shader.id);
         sun_loc = GetShaderLocation(sky_shader, "u_sun_direction");
+        sun_color_loc = GetShaderLocation(sky_shader, "u_sun_color");
+        moon_visibility_loc = GetShaderLocation(sky_shader, "u_moon_visibility");
+        star_visibility_loc = GetShaderLocation(sky_shader, "u_star_visibility");
         time_loc = GetShaderLocation(sky_shader, "u_time_of_day");
-        cam_forward_loc = GetShaderLocation(sky_shader, "u_cam_forward");
-        cam_right_loc = GetShaderLocation(sky_shader, "u_cam_right");
-        cam_up_loc = GetShaderLocation(sky_shader, "u_cam_up");
+        sky_lut_loc = GetShaderLocation(sky_shader, "u_sky_lut");
+        star_map_loc = GetShaderLocation(sky_shader, "u_star_map");
+        bake_sun_loc = GetShaderLocation(bake_shader, "u_sun_direction");
+        bake_time_loc = GetShaderLocation(bake_shader, "u_time_of_day");
+
+        Vector2 lut_texel = { 0.5f / SKY_LUT_WIDTH, 0.5f / SKY_LUT_HEIGHT };
+        SetShaderValue(sky_shader, GetShaderLocation(sky_shader, "u_lut_texel"), &lut_texel, SHADER_UNIFORM_VEC2);
+        frame_uniforms_bind_shader(sky_shader);  // Camera basis
+
+        sky_lut = load_lut(SKY_LUT_WIDTH, SKY_LUT_HEIGHT);
+        star_map = load_lut(SKY_STAR_MAP_WIDTH, SKY_STAR_MAP_HEIGHT);
+        bake_pass(star_map, stars_shader);
+        printf("[SKY] Baked %dx%d star map, sky LUT %dx%d\n",
+               SKY_STAR_MAP_WIDTH, SKY_STAR_MAP_HEIGHT, SKY_LUT_WIDTH, SKY_LUT_HEIGHT);
     } else {
         printf("[SKY] WARNING: Sky shader failed to load\n");
+        sky_shader.id = 0;
     }
 
+    lut_baked = false;
     initialized = true;
 }
 
-void sky_render(Camera3D camera, float time_of_day) {
+void sky_render(float time_of_day) {
     if (!initialized || sky_shader.id == 0) return;
 
     // Calculate sun direction from time
@@ -48,56 +145,60 @@ void sky_render(Camera3D camera, float time_of_day) {
         cosf(sun_angle)
     };
 
-    // Calculate camera basis vectors
-    Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
-    Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, camera.up));
-    Vector3 up = Vector3CrossProduct(right, forward);
+    // Re-bake the LUT once the sun has moved far enough (time wraps at 24)
+    float elapsed = fabsf(time_of_day - baked_time);
+    if (elapsed > 12.0f) elapsed = 24.0f - elapsed;
+    if (!lut_baked || elapsed >= SKY_REBAKE_HOURS) {
+        SetShaderValue(bake_shader, bake_sun_loc, &sun_direction, SHADER_UNIFORM_VEC3);
+        SetShaderValue(bake_shader, bake_time_loc, &time_of_day, SHADER_UNIFORM_FLOAT);
+        bake_pass(sky_lut, bake_shader);
+        baked_time = time_of_day;
+        lut_baked = true;
+    }
+
+    // Sun disc: white/yellow, more orange near the horizon
+    Vector4 sun_color = { 1.0f, 0.95f, 0.8f, 0.0f };
+    if (sun_direction.y > -0.1f) {
+        if (sun_direction.y < 0.3f) {
+            float horizon_factor = (1.0f - sun_direction.y / 0.3f) * 0.7f;
+            sun_color.x = Lerp(sun_color.x, 1.0f, horizon_factor);
+            sun_color.y = Lerp(sun_color.y, 0.6f, horizon_factor);
+            sun_color.z = Lerp(sun_color.z, 0.2f, horizon_factor);
+        }
+        sun_color.w = sun_direction.y + 0.1f;
+    }
+
+    // Moon visibility increases as sun goes down (smoothstep 0.2 -> -0.1)
+    float moon_t = Clamp((0.2f - sun_direction.y) / 0.3f, 0.0f, 1.0f);
+    float moon_visibility = moon_t * moon_t * (3.0f - 2.0f * moon_t);
+
+    // Star visibility increases as sun goes down (ease in)
+    float sun_height = sun_direction.y * 0.5f + 0.5f;
+    float star_visibility = sun_height < 0.4f ? 1.0f - sun_height / 0.4f : 0.0f;
+    star_visibility *= star_visibility;
 
     // Set shader uniforms
     SetShaderValue(sky_shader, sun_loc, &sun_direction, SHADER_UNIFORM_VEC3);
+    SetShaderValue(sky_shader, sun_color_loc, &sun_color, SHADER_UNIFORM_VEC4);
+    SetShaderValue(sky_shader, moon_visibility_loc, &moon_visibility, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(sky_shader, star_visibility_loc, &star_visibility, SHADER_UNIFORM_FLOAT);
     SetShaderValue(sky_shader, time_loc, &time_of_day, SHADER_UNIFORM_FLOAT);
-    SetShaderValue(sky_shader, cam_forward_loc, &forward, SHADER_UNIFORM_VEC3);
-    SetShaderValue(sky_shader, cam_right_loc, &right, SHADER_UNIFORM_VEC3);
-    SetShaderValue(sky_shader, cam_up_loc, &up, SHADER_UNIFORM_VEC3);
 
     // Draw fullscreen quad with sky shader
     BeginShaderMode(sky_shader);
-
-    // Use Raylib's 2D drawing to create a fullscreen quad
-    // The texture coords will go from (0,0) to (1,1)
-    int screenWidth = GetScreenWidth();
-    int screenHeight = GetScreenHeight();
-
-    // Draw a textured rectangle covering the whole screen
-    // We use DrawTexturePro with a 1x1 white texture to get proper UV mapping
-    rlSetTexture(rlGetTextureIdDefault());  // Use default white texture
-
-    rlBegin(RL_QUADS);
-        // Bottom-left
-        rlTexCoord2f(0.0f, 0.0f);
-        rlVertex2f(0, screenHeight);
-
-        // Bottom-right
-        rlTexCoord2f(1.0f, 0.0f);
-        rlVertex2f(screenWidth, screenHeight);
-
-        // Top-right
-        rlTexCoord2f(1.0f, 1.0f);
-        rlVertex2f(screenWidth, 0);
-
-        // Top-left
-        rlTexCoord2f(0.0f, 1.0f);
-        rlVertex2f(0, 0);
-    rlEnd();
-
-    rlSetTexture(0);
-
+    SetShaderValueTexture(sky_shader, sky_lut_loc, sky_lut.texture);
+    SetShaderValueTexture(sky_shader, star_map_loc, star_map.texture);
+    draw_quad(GetScreenWidth(), GetScreenHeight());
     EndShaderMode();
 }
 
 void sky_destroy(void) {
     if (initialized && sky_shader.id > 0) {
         UnloadShader(sky_shader);
+        UnloadShader(bake_shader);
+        UnloadShader(stars_shader);
+        UnloadRenderTexture(sky_lut);
+        UnloadRenderTexture(star_map);
     }
     initialized = false;
 }
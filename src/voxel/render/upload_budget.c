@@ -0,0 +1,117 @@
+/**
+ * Upload Budget Implementation
+ */
+
+#include "voxel/render/upload_budget.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <raylib.h>
+
+#define UPLOAD_MIN_SAMPLE_BYTES (64 * 1024)  // Smaller frames say little about the cost per byte
+#define UPLOAD_COST_SMOOTHING 0.2f
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+static void fold_cost(float* ms_per_mb, double ms, size_t bytes) {
+    if (bytes < UPLOAD_MIN_SAMPLE_BYTES) return;
+
+    float sample = (float)(ms / ((double)bytes / (1024.0 * 1024.0)));
+    *ms_per_mb = *ms_per_mb > 0.0f ? *ms_per_mb + (sample - *ms_per_mb) * UPLOAD_COST_SMOOTHING : sample;
+}
+
+/**
+ * Bytes this frame may take: the adapted budget, capped by what the
+ * measured cost allows within the frame share
+ */
+static size_t frame_limit(const UploadBudget* budget) {
+    float cost = budget->cpu_ms_per_mb > budget->gpu_ms_per_mb ? budget->cpu_ms_per_mb : budget->gpu_ms_per_mb;
+    if (cost <= 0.0f) return budget->frame_bytes;
+
+    double affordable = UPLOAD_TARGET_FRAME_MS * UPLOAD_FRAME_SHARE / cost * 1024.0 * 1024.0;
+    if (affordable < UPLOAD_BUDGET_MIN_BYTES) affordable = UPLOAD_BUDGET_MIN_BYTES;
+    return affordable < (double)budget->frame_bytes ? (size_t)affordable : budget->frame_bytes;
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+UploadBudget* upload_budget_create(void) {
+    UploadBudget* budget = (UploadBudget*)calloc(1, sizeof(UploadBudget));
+    if (!budget) {
+        printf("[UPLOAD] Failed to allocate upload budget\n");
+        return NULL;
+    }
+    budget->frame_bytes = UPLOAD_BUDGET_INITIAL_BYTES;
+    if (!gpu_timer_init(&budget->gpu_timer)) {
+        printf("[UPLOAD] Timer queries unavailable, budgeting by CPU time only\n");
+    }
+    return budget;
+}
+
+void upload_budget_destroy(UploadBudget* budget) {
+    if (!budget) return;
+
+    gpu_timer_destroy(&budget->gpu_timer);
+    free(budget);
+}
+
+void upload_budget_begin(UploadBudget* budget) {
+    if (!budget) return;
+
+    double now = GetTime();
+    if (budget->frame_start > 0.0) {
+        budget->frame_ms = (float)((now - budget->frame_start) * 1000.0);
+    }
+    double gpu_ms;
+    size_t gpu_bytes;
+    while (gpu_timer_poll(&budget->gpu_timer, &gpu_ms, &gpu_bytes)) {
+        fold_cost(&budget->gpu_ms_per_mb, gpu_ms, gpu_bytes);
+    }
+
+    // Back off fast when the last frame ran long with uploads in it, grow
+    // slowly while work waits and frames are on time
+    if (budget->frame_ms > UPLOAD_TARGET_FRAME_MS * 1.1f && budget->used_bytes > 0) {
+        budget->frame_bytes = budget->frame_bytes / 4 * 3;
+    } else if (budget->saturated && budget->frame_ms <= UPLOAD_TARGET_FRAME_MS) {
+        budget->frame_bytes += UPLOAD_BUDGET_STEP_BYTES;
+    }
+    if (budget->frame_bytes < UPLOAD_BUDGET_MIN_BYTES) budget->frame_bytes = UPLOAD_BUDGET_MIN_BYTES;
+    if (budget->frame_bytes > UPLOAD_BUDGET_MAX_BYTES) budget->frame_bytes = UPLOAD_BUDGET_MAX_BYTES;
+
+    budget->used_bytes = 0;
+    budget->used_ms = 0.0;
+    budget->saturated = false;
+    budget->frame_start = now;
+    gpu_timer_begin(&budget->gpu_timer);
+}
+
+bool upload_budget_allows(UploadBudget* budget, size_t bytes) {
+    if (!budget) return true;
+
+    bool fits = budget->used_bytes == 0 ||
+                (budget->used_bytes + bytes <= frame_limit(budget) &&
+                 budget->used_ms < UPLOAD_TARGET_FRAME_MS * UPLOAD_FRAME_SHARE);
+    if (!fits) {
+        budget->saturated = true;
+        return false;
+    }
+    budget->op_start = GetTime();
+    return true;
+}
+
+void upload_budget_spend(UploadBudget* budget, size_t bytes) {
+    if (!budget) return;
+
+    budget->used_bytes += bytes;
+    budget->used_ms += (GetTime() - budget->op_start) * 1000.0;
+}
+
+void upload_budget_end(UploadBudget* budget) {
+    if (!budget) return;
+
+    fold_cost(&budget->cpu_ms_per_mb, budget->used_ms, budget->used_bytes);
+    gpu_timer_end(&budget->gpu_timer, budget->used_bytes);
+}
@@ -8,6 +8,8 @@
 #include "voxel/network/network.h"
 #include "voxel/core/block.h"
 #include "voxel/world/chunk.h"
+#include "voxel/world/column_cache.h"
+#include "voxel/world/biome.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
@@ -16,12 +18,33 @@
 // MINIMAP STRUCTURE
 // ============================================================================
 
+/**
+ * The terrain texture holds one pixel per block column and wraps around:
+ * world column (x, z) lives at pixel (x & 255, z & 255), so chunk (cx, cz)
+ * owns the 16x16 tile at slot (cx & 15, cz & 15). Walking only rebuilds the
+ * tiles that scroll into view; the draw source rect just moves.
+ */
+#define MINIMAP_TILES 16                                   // Tile slots per axis
+#define MINIMAP_TEXTURE_SIZE (MINIMAP_TILES * CHUNK_SIZE)  // Texture pixels per axis
+#define MINIMAP_TILE_UPDATES 24                            // Tiles rebuilt per update at most
+
+static const Color MINIMAP_UNLOADED_COLOR = {20, 20, 30, 255};  // Dark blue-gray for unloaded areas
+
+/**
+ * What a tile slot currently shows
+ */
+typedef struct MinimapTile {
+    int chunk_x, chunk_z;
+    const Chunk* chunk;          // Chunk the surface came from (NULL = preview or unloaded)
+    uint32_t version;            // chunk->surface_version when built
+    bool filled;                 // Slot holds chunk_x/chunk_z at all
+} MinimapTile;
+
 struct Minimap {
-    RenderTexture2D texture;     // Render target for minimap
+    Texture2D texture;           // Wrapping terrain texture, one pixel per block
+    MinimapTile tiles[MINIMAP_TILES][MINIMAP_TILES];  // [slot z][slot x]
     int size;                    // Pixel size
     int radius;                  // Block radius to display
-    int last_player_x;           // Last player position for dirty check
-    int last_player_z;
     bool initialized;            // Has been initialized
 };
 
@@ -86,22 +109,16 @@ static Color get_block_color(BlockType type, int height) {
 // ============================================================================
 
 Minimap* minimap_create(void) {
-    Minimap* minimap = (Minimap*)malloc(sizeof(Minimap));
+    Minimap* minimap = (Minimap*)calloc(1, sizeof(Minimap));
     if (!minimap) return NULL;
 
     minimap->size = MINIMAP_SIZE;
     minimap->radius = MINIMAP_RADIUS;
-    minimap->last_player_x = -9999;  // Force initial update
-    minimap->last_player_z = -9999;
-    minimap->initialized = false;
 
-    // Create render texture
-    minimap->texture = LoadRenderTexture(MINIMAP_SIZE, MINIMAP_SIZE);
-
-    // Clear it initially
-    BeginTextureMode(minimap->texture);
-    ClearBackground(BLACK);
-    EndTextureMode();
+    Image image = GenImageColor(MINIMAP_TEXTURE_SIZE, MINIMAP_TEXTURE_SIZE, MINIMAP_UNLOADED_COLOR);
+    minimap->texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+    SetTextureWrap(minimap->texture, TEXTURE_WRAP_REPEAT);  // View may straddle the texture edge
 
     minimap->initialized = true;
     printf("[MINIMAP] Created (%dx%d, radius=%d blocks)\n",
@@ -114,7 +131,7 @@ void minimap_destroy(Minimap* minimap) {
     if (!minimap) return;
 
     if (minimap->initialized) {
-        UnloadRenderTexture(minimap->texture);
+        UnloadTexture(minimap->texture);
     }
 
     free(minimap);
@@ -125,70 +142,73 @@ void minimap_destroy(Minimap* minimap) {
 // MINIMAP UPDATE
 // ============================================================================
 
+/**
+ * Fill the pixels of one chunk tile and upload them
+ * Generated chunks use their surface map; others preview the natural
+ * surface from the column cache
+ */
+static void minimap_build_tile(Minimap* minimap, World* world, MinimapTile* tile,
+                               int chunk_x, int chunk_z, const Chunk* chunk) {
+    Color pixels[CHUNK_SIZE * CHUNK_SIZE];
+
+    if (chunk) {
+        for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; i++) {
+            pixels[i] = get_block_color((BlockType)chunk->surface_type[i], chunk->surface_height[i]);
+        }
+    } else if (world->columns) {
+        ColumnMap columns;
+        column_cache_get_map(world->columns, chunk_x, chunk_z, &columns);
+        for (int z = 0; z < CHUNK_SIZE; z++) {
+            for (int x = 0; x < CHUNK_SIZE; x++) {
+                BlockType type = biome_get_properties((BiomeType)columns.biomes[z][x])->surface_block;
+                pixels[(z << 4) | x] = get_block_color(type, columns.heights[z][x]);
+            }
+        }
+    } else {
+        for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; i++) pixels[i] = MINIMAP_UNLOADED_COLOR;
+    }
+
+    Rectangle rect = {
+        (float)((chunk_x & (MINIMAP_TILES - 1)) * CHUNK_SIZE),
+        (float)((chunk_z & (MINIMAP_TILES - 1)) * CHUNK_SIZE),
+        CHUNK_SIZE, CHUNK_SIZE
+    };
+    UpdateTextureRec(minimap->texture, rect, pixels);
+
+    tile->chunk_x = chunk_x;
+    tile->chunk_z = chunk_z;
+    tile->chunk = chunk;
+    tile->version = chunk ? chunk->surface_version : 0;
+    tile->filled = true;
+}
+
 void minimap_update(Minimap* minimap, World* world, Player* player) {
     if (!minimap || !world || !player) return;
 
     int player_x = (int)player->position.x;
     int player_z = (int)player->position.z;
 
-    // Only update if player moved at least 4 blocks (performance optimization)
-    int dx = player_x - minimap->last_player_x;
-    int dz = player_z - minimap->last_player_z;
-    if (dx * dx + dz * dz < 16) {
-        return;  // No significant movement
-    }
+    int min_cx, min_cz, max_cx, max_cz;
+    world_to_chunk_coords(player_x - minimap->radius, player_z - minimap->radius, &min_cx, &min_cz);
+    world_to_chunk_coords(player_x + minimap->radius - 1, player_z + minimap->radius - 1, &max_cx, &max_cz);
 
-    minimap->last_player_x = player_x;
-    minimap->last_player_z = player_z;
+    // Tiles scrolled in or whose surface changed, at most a fixed number per frame
+    int budget = MINIMAP_TILE_UPDATES;
+    for (int cz = min_cz; cz <= max_cz && budget > 0; cz++) {
+        for (int cx = min_cx; cx <= max_cx && budget > 0; cx++) {
+            MinimapTile* tile = &minimap->tiles[cz & (MINIMAP_TILES - 1)][cx & (MINIMAP_TILES - 1)];
 
-    // Begin drawing to render texture
-    BeginTextureMode(minimap->texture);
-    ClearBackground((Color){20, 20, 30, 255});  // Dark blue-gray for unloaded areas
+            Chunk* chunk = world_get_chunk(world, cx, cz);
+            if (chunk && !(CHUNK_STATE_HAS_BLOCKS(chunk_get_state(chunk)) && chunk->surface_valid)) chunk = NULL;
 
-    // Calculate scale (pixels per block)
-    float scale = (float)minimap->size / (minimap->radius * 2.0f);
-    int half_size = minimap->size / 2;
-
-    // Draw terrain centered on player
-    for (int dz_block = -minimap->radius; dz_block < minimap->radius; dz_block++) {
-        for (int dx_block = -minimap->radius; dx_block < minimap->radius; dx_block++) {
-            int world_x = player_x + dx_block;
-            int world_z = player_z + dz_block;
-
-            // Find surface block (scan from top down)
-            // Start from 200 to cover terrain surface at y=160
-            int surface_y = 0;
-            BlockType surface_type = BLOCK_AIR;
-
-            for (int y = 200; y >= 0; y--) {
-                Block block = world_get_block(world, world_x, y, world_z);
-                if (block.type != BLOCK_AIR) {
-                    surface_y = y;
-                    surface_type = (BlockType)block.type;
-                    break;
-                }
-            }
-
-            // Map to pixel position
-            int px = half_size + (int)(dx_block * scale);
-            int py = half_size + (int)(dz_block * scale);
-
-            // Only draw if within bounds
-            if (px >= 0 && px < minimap->size && py >= 0 && py < minimap->size) {
-                Color color = get_block_color(surface_type, surface_y);
-
-                // Draw a small rectangle if scale > 1 for smoother look
-                if (scale >= 1.0f) {
-                    int rect_size = (int)ceilf(scale);
-                    DrawRectangle(px, py, rect_size, rect_size, color);
-                } else {
-                    DrawPixel(px, py, color);
-                }
+            if (tile->filled && tile->chunk_x == cx && tile->chunk_z == cz && tile->chunk == chunk &&
+                (!chunk || tile->version == chunk->surface_version)) {
+                continue;
             }
+            minimap_build_tile(minimap, world, tile, cx, cz, chunk);
+            budget--;
         }
     }
-
-    EndTextureMode();
 }
 
 // ============================================================================
@@ -205,18 +225,22 @@ void minimap_draw(Minimap* minimap, Player* player, NetworkContext* network) {
     // Draw dark background/border
     DrawRectangle(x - 3, y - 3, minimap->size + 6, minimap->size + 6, (Color){0, 0, 0, 200});
 
-    // Draw minimap texture
-    // Note: RenderTexture is flipped vertically, so we use negative height in source rect
-    Rectangle src = {0, 0, (float)minimap->size, -(float)minimap->size};
+    int player_x = (int)player->position.x;
+    int player_z = (int)player->position.z;
+
+    // Draw the terrain window around the player (the texture wraps)
+    Rectangle src = {
+        (float)((player_x - minimap->radius) & (MINIMAP_TEXTURE_SIZE - 1)),
+        (float)((player_z - minimap->radius) & (MINIMAP_TEXTURE_SIZE - 1)),
+        (float)(minimap->radius * 2), (float)(minimap->radius * 2)
+    };
     Rectangle dst = {(float)x, (float)y, (float)minimap->size, (float)minimap->size};
-    DrawTexturePro(minimap->texture.texture, src, dst, (Vector2){0, 0}, 0.0f, WHITE);
+    DrawTexturePro(minimap->texture, src, dst, (Vector2){0, 0}, 0.0f, WHITE);
 
     // Calculate scale for position mapping
     float scale = (float)minimap->size / (minimap->radius * 2.0f);
     int center_x = x + minimap->size / 2;
     int center_y = y + minimap->size / 2;
-    int player_x = (int)player->position.x;
-    int player_z = (int)player->position.z;
 
     // Draw remote players as colored dots
     if (network) {
@@ -225,8 +249,9 @@ void minimap_draw(Minimap* minimap, Player* player, NetworkContext* network) {
         if (mode == NET_MODE_HOST && network->server) {
             // Draw connected clients
             for (int i = 0; i < NET_MAX_CLIENTS; i++) {
-                if (network->server->clients[i].connected) {
-                    NetPlayerState* state = &network->server->clients[i].last_state;
+                NetClientSlot* slot = network->server->clients[i];
+                if (slot && slot->connected) {
+                    NetPlayerState* state = &slot->last_state;
                     int dx = (int)state->pos_x - player_x;
                     int dz = (int)state->pos_z - player_z;
 
@@ -244,7 +269,7 @@ void minimap_draw(Minimap* minimap, Player* player, NetworkContext* network) {
         } else if (mode == NET_MODE_CLIENT && network->client) {
             // Draw other remote players
             for (int i = 0; i < NET_MAX_CLIENTS; i++) {
-                if (network->client->player_active[i] &&
+                if (network->client->player_in_view[i] &&
                     i != network->client->my_client_id) {
                     NetPlayerState* state = &network->client->remote_players[i];
                     int dx = (int)state->pos_x - player_x;
@@ -263,7 +288,7 @@ void minimap_draw(Minimap* minimap, Player* player, NetworkContext* network) {
             }
 
             // Draw host player
-            if (network->client->player_active[0]) {
+            if (network->client->player_in_view[0]) {
                 NetPlayerState* state = &network->client->remote_players[0];
                 int dx = (int)state->pos_x - player_x;
                 int dz = (int)state->pos_z - player_z;
@@ -7,6 +7,7 @@
 
 #include "voxel/ui/pause_menu.h"
 #include "voxel/ui/settings_menu.h"
+#include "voxel/ui/ui_cache.h"
 #include "voxel/network/network.h"
 #include <raylib.h>
 #include <stdlib.h>
@@ -70,6 +71,19 @@ static void generate_random_name(char* buffer, size_t size) {
 #define COLOR_STATUS_ERROR ((Color){200, 100, 100, 255})
 #define COLOR_LABEL ((Color){180, 180, 180, 255})
 
+// Buttons remembered from the last panel redraw (hover tracking)
+#define MAX_PANEL_BUTTONS 8
+
+// ============================================================================
+// PANEL CACHE
+// ============================================================================
+
+// The panel is redrawn only when its signature changes: menu state, inputs,
+// status, hovered button or an animation step
+static UiCache g_panel_cache;
+static Rectangle g_panel_buttons[MAX_PANEL_BUTTONS];
+static int g_panel_button_count = 0;
+
 // ============================================================================
 // HELPER FUNCTIONS
 // ============================================================================
@@ -79,6 +93,10 @@ static bool is_point_in_rect(int px, int py, int rx, int ry, int rw, int rh) {
 }
 
 static void draw_button(int x, int y, int w, int h, const char* text, bool is_hovered) {
+    if (g_panel_button_count < MAX_PANEL_BUTTONS) {
+        g_panel_buttons[g_panel_button_count++] = (Rectangle){(float)x, (float)y, (float)w, (float)h};
+    }
+
     Color bg_color = is_hovered ? COLOR_BUTTON_HOVER : COLOR_BUTTON_NORMAL;
     DrawRectangle(x, y, w, h, bg_color);
     DrawRectangleLines(x, y, w, h, COLOR_BUTTON_BORDER);
@@ -432,6 +450,49 @@ static void draw_connected(PauseMenu* menu, int panel_x, int panel_y, int mouse_
     draw_button(button_x, y, BUTTON_WIDTH, BUTTON_HEIGHT, "Disconnect", hovered);
 }
 
+/**
+ * Hash everything the current panel shows
+ */
+static uint32_t panel_signature(PauseMenu* menu, int mouse_x, int mouse_y) {
+    uint32_t hash = ui_hash_int(UI_HASH_SEED, (int)menu->state);
+    hash = ui_hash_str(hash, menu->ip_input);
+    hash = ui_hash_str(hash, menu->port_input);
+    hash = ui_hash_int(hash, (int)menu->active_input);
+    hash = ui_hash_str(hash, menu->status_message);
+    hash = ui_hash_int(hash, menu->status_is_error);
+
+    // Hover, tested against the buttons of the last redraw (a state change
+    // redraws anyway and records the new buttons)
+    uint32_t hovered = 0;
+    for (int i = 0; i < g_panel_button_count; i++) {
+        Rectangle b = g_panel_buttons[i];
+        if (is_point_in_rect(mouse_x, mouse_y, (int)b.x, (int)b.y, (int)b.width, (int)b.height)) {
+            hovered |= 1u << i;
+        }
+    }
+    hash = ui_hash(hash, &hovered, sizeof(hovered));
+
+    // Animation steps: input cursor blink, connecting dots
+    if (menu->active_input != INPUT_FIELD_NONE) {
+        hash = ui_hash_int(hash, (int)(GetTime() * 2) % 2);
+    }
+    if (menu->state == MENU_STATE_CONNECTING) {
+        hash = ui_hash_int(hash, (int)(GetTime() * 3) % 4);
+    }
+
+    // Player lists
+    if ((menu->state == MENU_STATE_HOSTING || menu->state == MENU_STATE_CONNECTED) && menu->network) {
+        for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+            if (network_is_player_active(menu->network, i)) {
+                hash = ui_hash_int(hash, i);
+                hash = ui_hash_str(hash, network_get_player_name(menu->network, i));
+            }
+        }
+    }
+
+    return hash;
+}
+
 // ============================================================================
 // INPUT HANDLING FOR EACH STATE
 // ============================================================================
@@ -643,6 +704,7 @@ void pause_menu_destroy(PauseMenu* menu) {
     if (menu) {
         free(menu);
     }
+    ui_cache_unload(&g_panel_cache);
 }
 
 void pause_menu_open(PauseMenu* menu) {
@@ -744,7 +806,7 @@ void pause_menu_draw(PauseMenu* menu) {
     // Draw semi-transparent overlay
     DrawRectangle(0, 0, screen_width, screen_height, COLOR_OVERLAY);
 
-    // Settings menu draws its own panel, skip for that state
+    // Settings menu draws (and caches) its own panel, skip for that state
     if (menu->state == MENU_STATE_SETTINGS) {
         if (menu->settings_menu) {
             settings_menu_draw(menu->settings_menu);
@@ -752,42 +814,49 @@ void pause_menu_draw(PauseMenu* menu) {
         return;
     }
 
-    int panel_x = (screen_width - PANEL_WIDTH) / 2;
-    int panel_y = (screen_height - PANEL_HEIGHT) / 2;
-
-    // Draw panel background
-    DrawRectangle(panel_x, panel_y, PANEL_WIDTH, PANEL_HEIGHT, COLOR_PANEL);
-    DrawRectangleLines(panel_x, panel_y, PANEL_WIDTH, PANEL_HEIGHT, COLOR_BUTTON_BORDER);
-
     // Get mouse position
     Vector2 mouse_pos = GetMousePosition();
     int mouse_x = (int)mouse_pos.x;
     int mouse_y = (int)mouse_pos.y;
 
-    // Draw appropriate state
-    switch (menu->state) {
-        case MENU_STATE_MAIN:
-            draw_main_menu(menu, panel_x, panel_y, mouse_x, mouse_y);
-            break;
-        case MENU_STATE_HOST_SETUP:
-            draw_host_setup(menu, panel_x, panel_y, mouse_x, mouse_y);
-            break;
-        case MENU_STATE_JOIN_SETUP:
-            draw_join_setup(menu, panel_x, panel_y, mouse_x, mouse_y);
-            break;
-        case MENU_STATE_CONNECTING:
-            draw_connecting(menu, panel_x, panel_y, mouse_x, mouse_y);
-            break;
-        case MENU_STATE_HOSTING:
-            draw_hosting(menu, panel_x, panel_y, mouse_x, mouse_y);
-            break;
-        case MENU_STATE_CONNECTED:
-            draw_connected(menu, panel_x, panel_y, mouse_x, mouse_y);
-            break;
-        case MENU_STATE_SETTINGS:
-            // Handled above, should never reach here
-            break;
+    if (ui_cache_begin(&g_panel_cache, panel_signature(menu, mouse_x, mouse_y))) {
+        g_panel_button_count = 0;
+
+        int panel_x = (screen_width - PANEL_WIDTH) / 2;
+        int panel_y = (screen_height - PANEL_HEIGHT) / 2;
+
+        // Draw panel background
+        DrawRectangle(panel_x, panel_y, PANEL_WIDTH, PANEL_HEIGHT, COLOR_PANEL);
+        DrawRectangleLines(panel_x, panel_y, PANEL_WIDTH, PANEL_HEIGHT, COLOR_BUTTON_BORDER);
+
+        // Draw appropriate state
+        switch (menu->state) {
+            case MENU_STATE_MAIN:
+                draw_main_menu(menu, panel_x, panel_y, mouse_x, mouse_y);
+                break;
+            case MENU_STATE_HOST_SETUP:
+                draw_host_setup(menu, panel_x, panel_y, mouse_x, mouse_y);
+                break;
+            case MENU_STATE_JOIN_SETUP:
+                draw_join_setup(menu, panel_x, panel_y, mouse_x, mouse_y);
+                break;
+            case MENU_STATE_CONNECTING:
+                draw_connecting(menu, panel_x, panel_y, mouse_x, mouse_y);
+                break;
+            case MENU_STATE_HOSTING:
+                draw_hosting(menu, panel_x, panel_y, mouse_x, mouse_y);
+                break;
+            case MENU_STATE_CONNECTED:
+                draw_connected(menu, panel_x, panel_y, mouse_x, mouse_y);
+                break;
+            case MENU_STATE_SETTINGS:
+                // Handled above, should never reach here
+                break;
+        }
+
+        ui_cache_end(&g_panel_cache);
     }
+    ui_cache_draw(&g_panel_cache);
 }
 
 void pause_menu_set_network(PauseMenu* menu, NetworkContext* network) {
@@ -0,0 +1,186 @@
+/**
+ * Profiler Overlay Implementation
+ */
+
+#include "voxel/ui/profiler_overlay.h"
+#include "voxel/core/profiler.h"
+#include "voxel/core/memory.h"
+#include <raylib.h>
+#include <stdio.h>
+
+#define OVERLAY_FONT_SIZE 10
+#define OVERLAY_LINE_HEIGHT 12
+#define OVERLAY_TARGET_MS (1000.0f / 60.0f)
+
+// Stacked in the frame graph, bottom up
+static const ProfileZone g_graph_zones[] = { PROFILE_GAME_UPDATE, PROFILE_GAME_TICK, PROFILE_GAME_DRAW };
+static const Color g_graph_colors[] = { {80, 140, 230, 255}, {90, 200, 110, 255}, {230, 150, 60, 255} };
+#define GRAPH_ZONE_COUNT (int)(sizeof(g_graph_zones) / sizeof(g_graph_zones[0]))
+
+static float graph_height(float ms, float scale_ms, int height) {
+    float h = ms / scale_ms * (float)height;
+    return h > (float)height ? (float)height : h;
+}
+
+/**
+ * Frame time (grey) with the main thread's top-level zones stacked on it
+ */
+static void draw_frame_graph(int x, int y) {
+    int width = PROFILER_HISTORY;
+    int height = PROFILER_OVERLAY_GRAPH_HEIGHT;
+    DrawRectangle(x, y, width, height, (Color){0, 0, 0, 160});
+
+    for (int age = 0; age < PROFILER_HISTORY; age++) {
+        const ProfileFrame* frame = profiler_get_frame(age);
+        if (!frame) break;
+
+        int column = x + width - 1 - age;
+        int bottom = y + height;
+        int frame_h = (int)graph_height(frame->frame_ms, PROFILER_OVERLAY_GRAPH_MS, height);
+        DrawLine(column, bottom, column, bottom - frame_h, (Color){110, 110, 110, 255});
+
+        float stacked = 0.0f;
+        for (int i = 0; i < GRAPH_ZONE_COUNT; i++) {
+            float from = graph_height(stacked, PROFILER_OVERLAY_GRAPH_MS, height);
+            stacked += frame->zone_ms[g_graph_zones[i]];
+            float to = graph_height(stacked, PROFILER_OVERLAY_GRAPH_MS, height);
+            if (to > from) DrawLine(column, bottom - (int)from, column, bottom - (int)to, g_graph_colors[i]);
+        }
+    }
+
+    // 60 and 30 FPS lines
+    for (int i = 1; i <= 2; i++) {
+        int line_y = y + height - (int)graph_height(OVERLAY_TARGET_MS * (float)i, PROFILER_OVERLAY_GRAPH_MS, height);
+        DrawLine(x, line_y, x + width, line_y, (Color){255, 255, 255, 90});
+    }
+}
+
+/**
+ * Summed worker time per frame
+ */
+static void draw_worker_graph(int x, int y) {
+    int width = PROFILER_HISTORY;
+    int height = PROFILER_OVERLAY_WORKER_HEIGHT;
+    DrawRectangle(x, y, width, height, (Color){0, 0, 0, 160});
+
+    for (int age = 0; age < PROFILER_HISTORY; age++) {
+        const ProfileFrame* frame = profiler_get_frame(age);
+        if (!frame) break;
+
+        float ms = 0.0f;
+        for (int z = PROFILE_WORKER_TERRAIN; z <= PROFILE_WORKER_REMESH; z++) {
+            ms += frame->zone_ms[z];
+        }
+        int column = x + width - 1 - age;
+        int h = (int)graph_height(ms, PROFILER_OVERLAY_WORKER_MS, height);
+        DrawLine(column, y + height, column, y + height - h, (Color){190, 110, 220, 255});
+    }
+}
+
+#define MEMORY_TABLE_LINES (MEMORY_CATEGORY_COUNT + 4)  // Header, categories, two totals, resident
+#define OVERLAY_MB(bytes) ((float)(bytes) / (1024.0f * 1024.0f))
+
+/**
+ * Tracked bytes per category, the totals against their budgets and the
+ * process's resident set
+ */
+static void draw_memory_table(int x, int y) {
+    static long rss_kb = 0;
+    static int rss_age = PROFILER_OVERLAY_RSS_FRAMES;
+    if (++rss_age >= PROFILER_OVERLAY_RSS_FRAMES) {
+        rss_kb = memory_get_resident_kb();
+        rss_age = 0;
+    }
+
+    char line[96];
+    DrawText("memory                  MB  peak MB", x, y, OVERLAY_FONT_SIZE, (Color){200, 200, 200, 255});
+    y += OVERLAY_LINE_HEIGHT;
+    for (int c = 0; c < MEMORY_CATEGORY_COUNT; c++) {
+        MemoryCategory category = (MemoryCategory)c;
+        DrawText(memory_category_name(category), x, y, OVERLAY_FONT_SIZE, WHITE);
+        snprintf(line, sizeof(line), "%7.1f  %7.1f", OVERLAY_MB(memory_get_bytes(category)),
+                 OVERLAY_MB(memory_get_peak(category)));
+        DrawText(line, x + 120, y, OVERLAY_FONT_SIZE, WHITE);
+        y += OVERLAY_LINE_HEIGHT;
+    }
+
+    for (int k = 0; k < MEMORY_KIND_COUNT; k++) {
+        MemoryKind kind = (MemoryKind)k;
+        size_t budget = memory_get_budget(kind);
+        if (budget > 0) {
+            snprintf(line, sizeof(line), "%s %.1f / %.0f MB", kind == MEMORY_GPU ? "GPU" : "heap",
+                     OVERLAY_MB(memory_get_total(kind)), OVERLAY_MB(budget));
+        } else {
+            snprintf(line, sizeof(line), "%s %.1f MB (no budget)", kind == MEMORY_GPU ? "GPU" : "heap",
+                     OVERLAY_MB(memory_get_total(kind)));
+        }
+        MemoryPressure pressure = memory_get_pressure(kind);
+        Color color = pressure == MEMORY_PRESSURE_OVER ? RED : (pressure == MEMORY_PRESSURE_HIGH ? ORANGE : WHITE);
+        DrawText(line, x, y, OVERLAY_FONT_SIZE, color);
+        y += OVERLAY_LINE_HEIGHT;
+    }
+
+    snprintf(line, sizeof(line), "resident %.1f MB", (float)rss_kb / 1024.0f);
+    DrawText(line, x, y, OVERLAY_FONT_SIZE, (Color){200, 200, 200, 255});
+}
+
+void profiler_overlay_draw(void) {
+    int x = PROFILER_OVERLAY_MARGIN;
+    int y = PROFILER_OVERLAY_MARGIN;
+    int width = PROFILER_HISTORY;
+    int table_height = (PROFILE_ZONE_COUNT + 2) * OVERLAY_LINE_HEIGHT;
+    int panel_height = 2 * OVERLAY_LINE_HEIGHT + PROFILER_OVERLAY_GRAPH_HEIGHT + 4 +
+                       PROFILER_OVERLAY_WORKER_HEIGHT + 4 + table_height +
+                       (1 + MEMORY_TABLE_LINES) * OVERLAY_LINE_HEIGHT;
+    DrawRectangle(x - 4, y - 4, width + 8, panel_height + 8, (Color){0, 0, 0, 120});
+
+    char line[96];
+    const ProfileFrame* last = profiler_get_frame(0);
+    snprintf(line, sizeof(line), "Frame %.2f ms  F3: hide  F4: %s", last ? last->frame_ms : 0.0f,
+             profiler_is_capturing() ? "capturing..." : "capture trace");
+    DrawText(line, x, y, OVERLAY_FONT_SIZE, WHITE);
+    y += OVERLAY_LINE_HEIGHT;
+
+    // Legend
+    int legend_x = x;
+    for (int i = 0; i < GRAPH_ZONE_COUNT; i++) {
+        const char* name = profiler_zone_name(g_graph_zones[i]);
+        DrawRectangle(legend_x, y + 2, 6, 6, g_graph_colors[i]);
+        DrawText(name, legend_x + 9, y, OVERLAY_FONT_SIZE, (Color){200, 200, 200, 255});
+        legend_x += 9 + MeasureText(name, OVERLAY_FONT_SIZE) + 10;
+    }
+    y += OVERLAY_LINE_HEIGHT;
+
+    draw_frame_graph(x, y);
+    y += PROFILER_OVERLAY_GRAPH_HEIGHT + 4;
+    draw_worker_graph(x, y);
+    y += PROFILER_OVERLAY_WORKER_HEIGHT + 4;
+
+    // Zone table: average over recent frames, worst over the history
+    DrawText("zone                avg ms   max ms  calls", x, y, OVERLAY_FONT_SIZE, (Color){200, 200, 200, 255});
+    y += OVERLAY_LINE_HEIGHT;
+    for (int z = 0; z < PROFILE_ZONE_COUNT; z++) {
+        float sum = 0.0f, max = 0.0f;
+        int frames = 0;
+        for (int age = 0; age < PROFILER_HISTORY; age++) {
+            const ProfileFrame* frame = profiler_get_frame(age);
+            if (!frame) break;
+            if (age < PROFILER_OVERLAY_AVERAGE_FRAMES) {
+                sum += frame->zone_ms[z];
+                frames++;
+            }
+            if (frame->zone_ms[z] > max) max = frame->zone_ms[z];
+        }
+        float avg = frames > 0 ? sum / (float)frames : 0.0f;
+        int calls = last ? last->zone_calls[z] : 0;
+
+        int indent = profiler_zone_depth((ProfileZone)z) * 8;
+        DrawText(profiler_zone_name((ProfileZone)z), x + indent, y, OVERLAY_FONT_SIZE, WHITE);
+        snprintf(line, sizeof(line), "%7.2f  %7.2f  %5d", avg, max, calls);
+        DrawText(line, x + 120, y, OVERLAY_FONT_SIZE, avg > OVERLAY_TARGET_MS * 0.25f ? ORANGE : WHITE);
+        y += OVERLAY_LINE_HEIGHT;
+    }
+
+    y += OVERLAY_LINE_HEIGHT;
+    draw_memory_table(x, y);
+}
@@ -7,6 +7,7 @@
 #include "voxel/ui/settings_menu.h"
 #include "voxel/core/settings_constants.h"
 #include "voxel/world/world.h"
+#include "voxel/ui/ui_cache.h"
 #include <raylib.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -37,6 +38,13 @@
 #define COLOR_TEXT WHITE
 #define COLOR_TEXT_DIM (Color){180, 180, 180, 255}
 
+// ============================================================================
+// PANEL CACHE
+// ============================================================================
+
+// Redrawn only when the selection or a working value changes
+static UiCache g_panel_cache;
+
 // ============================================================================
 // CATEGORY ITEM DEFINITIONS
 // ============================================================================
@@ -56,9 +64,11 @@ static const char* world_items[] = {
 
 static const char* performance_items[] = {
     "Max Uploads/Frame",
-    "Show Debug Info"
+    "Show Debug Info",
+    "Greedy Meshing",
+    "Adaptive Quality"
 };
-#define PERFORMANCE_ITEM_COUNT 2
+#define PERFORMANCE_ITEM_COUNT 4
 
 static const char* category_names[] = {
     "Graphics",
@@ -148,6 +158,7 @@ void settings_menu_destroy(SettingsMenu* menu) {
     if (menu) {
         free(menu);
     }
+    ui_cache_unload(&g_panel_cache);
 }
 
 void settings_menu_open(SettingsMenu* menu) {
@@ -280,6 +291,10 @@ int settings_menu_handle_input(SettingsMenu* menu) {
                     if (s->max_uploads_per_frame > SETTING_MAX_UPLOADS_MAX) s->max_uploads_per_frame = SETTING_MAX_UPLOADS_MAX;
                 } else if (menu->selected_item == 1) {  // Show Debug
                     s->show_debug_info = !s->show_debug_info;
+                } else if (menu->selected_item == 2) {  // Greedy Meshing
+                    s->greedy_meshing = !s->greedy_meshing;
+                } else if (menu->selected_item == 3) {  // Adaptive Quality
+                    s->adaptive_quality = !s->adaptive_quality;
                 }
                 break;
 
@@ -291,9 +306,30 @@ int settings_menu_handle_input(SettingsMenu* menu) {
     return 0;
 }
 
-void settings_menu_draw(SettingsMenu* menu) {
-    if (!menu || !menu->is_open) return;
+/**
+ * Hash everything the panel shows (field by field: the struct has padding)
+ */
+static uint32_t panel_signature(const SettingsMenu* menu) {
+    const GameSettings* s = &menu->working_copy;
+    uint32_t hash = ui_hash_int(UI_HASH_SEED, (int)menu->selected_category);
+    hash = ui_hash_int(hash, menu->selected_item);
+    hash = ui_hash_int(hash, menu->editing_value);
+    hash = ui_hash_int(hash, s->view_distance);
+    hash = ui_hash_int(hash, s->lod_distance);
+    hash = ui_hash_int(hash, s->batch_rebuilds);
+    hash = ui_hash(hash, &s->day_speed, sizeof(s->day_speed));
+    hash = ui_hash_int(hash, s->time_paused);
+    hash = ui_hash_int(hash, s->max_uploads_per_frame);
+    hash = ui_hash_int(hash, s->show_debug_info);
+    hash = ui_hash_int(hash, s->greedy_meshing);
+    hash = ui_hash_int(hash, s->adaptive_quality);
+    return hash;
+}
 
+/**
+ * Draw the menu panel (into the panel cache)
+ */
+static void draw_panel(SettingsMenu* menu) {
     int screen_w = GetScreenWidth();
     int screen_h = GetScreenHeight();
 
@@ -375,6 +411,10 @@ void settings_menu_draw(SettingsMenu* menu) {
                     draw_spinner_value(ctrl_x, ctrl_y, CONTROL_WIDTH, s->max_uploads_per_frame, selected);
                 } else if (i == 1) {  // Show Debug
                     draw_toggle(ctrl_x, ctrl_y, s->show_debug_info, selected);
+                } else if (i == 2) {  // Greedy Meshing
+                    draw_toggle(ctrl_x, ctrl_y, s->greedy_meshing, selected);
+                } else if (i == 3) {  // Adaptive Quality
+                    draw_toggle(ctrl_x, ctrl_y, s->adaptive_quality, selected);
                 }
                 break;
 
@@ -389,6 +429,16 @@ void settings_menu_draw(SettingsMenu* menu) {
     DrawText(help, menu_x + (MENU_WIDTH - help_w) / 2, menu_y + MENU_HEIGHT - 25, 12, COLOR_TEXT_DIM);
 }
 
+void settings_menu_draw(SettingsMenu* menu) {
+    if (!menu || !menu->is_open) return;
+
+    if (ui_cache_begin(&g_panel_cache, panel_signature(menu))) {
+        draw_panel(menu);
+        ui_cache_end(&g_panel_cache);
+    }
+    ui_cache_draw(&g_panel_cache);
+}
+
 void settings_menu_apply(SettingsMenu* menu, World* world) {
     if (!menu || !menu->live_settings) return;
 
@@ -398,10 +448,14 @@ void settings_menu_apply(SettingsMenu* menu, World* world) {
     // Apply settings to world
     if (world) {
         world_set_view_distance(world, menu->working_copy.view_distance);
+        world_set_lod_distance(world, menu->working_copy.lod_distance);
         world_set_batch_rebuilds(world, menu->working_copy.batch_rebuilds);
         world_set_max_uploads(world, menu->working_copy.max_uploads_per_frame);
     }
 
+    // Mesher change applies to chunks meshed from now on
+    chunk_set_mesher(menu->working_copy.greedy_meshing ? CHUNK_MESHER_GREEDY : CHUNK_MESHER_SIMPLE);
+
     printf("[SETTINGS] Applied: view=%d, lod=%d, batch=%d, uploads=%d, day_speed=%.2f\n",
            menu->working_copy.view_distance,
            menu->working_copy.lod_distance,
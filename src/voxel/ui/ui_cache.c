@@ -0,0 +1,72 @@
+/**
+ * UI Cache Implementation
+ */
+
+#include "voxel/ui/ui_cache.h"
+#include <rlgl.h>
+#include <stdio.h>
+
+bool ui_cache_begin(UiCache* cache, uint32_t signature) {
+    int width = GetScreenWidth();
+    int height = GetScreenHeight();
+
+    if (cache->valid && cache->signature == signature &&
+        cache->width == width && cache->height == height) {
+        return false;
+    }
+
+    // A failed target is only retried after a resize
+    if (cache->width != width || cache->height != height) {
+        if (cache->target.id != 0) UnloadRenderTexture(cache->target);
+        cache->target = LoadRenderTexture(width, height);
+        cache->width = width;
+        cache->height = height;
+        if (cache->target.id == 0) {
+            printf("[UI] Failed to create %dx%d panel cache, drawing directly\n", width, height);
+        }
+    }
+
+    cache->signature = signature;
+    cache->valid = cache->target.id != 0;
+    if (!cache->valid) return true;
+
+    BeginTextureMode(cache->target);
+    ClearBackground(BLANK);
+
+    // Color is blended as usual, alpha accumulates coverage: the target ends
+    // up premultiplied, which is what compositing it later needs
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                              RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    return true;
+}
+
+void ui_cache_end(UiCache* cache) {
+    if (!cache->valid) return;
+    EndBlendMode();
+    EndTextureMode();
+}
+
+void ui_cache_draw(const UiCache* cache) {
+    if (!cache->valid) return;
+
+    // Render textures are stored bottom-up: flip the source rectangle
+    Rectangle source = {0, 0, (float)cache->width, (float)-cache->height};
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTextureRec(cache->target.texture, source, (Vector2){0, 0}, WHITE);
+    EndBlendMode();
+}
+
+void ui_cache_invalidate(UiCache* cache) {
+    cache->valid = false;
+}
+
+void ui_cache_unload(UiCache* cache) {
+    if (cache->target.id != 0) {
+        UnloadRenderTexture(cache->target);
+    }
+    cache->target = (RenderTexture2D){0};
+    // Zero size: the next ui_cache_begin creates a new target
+    cache->width = cache->height = 0;
+    cache->valid = false;
+}
@@ -16,6 +16,7 @@
 #define BIOME_FREQUENCY 0.003f    // Low frequency = large biome regions
 #define BIOME_OCTAVES 2           // Few octaves for smooth regions
 #define BIOME_OFFSET 10000.0f     // Offset from terrain noise
+#define BIOME_GRID_ROW_MAX 64     // Points per batch in biome_get_grid
 
 // ============================================================================
 // BIOME PROPERTIES TABLE
@@ -80,6 +81,22 @@ void biome_init(void) {
     printf("[BIOME] Biome system initialized with %d biome types\n", BIOME_COUNT);
 }
 
+/**
+ * Map biome noise (-1 to 1) to a biome type
+ */
+static BiomeType biome_from_noise(float noise) {
+    // Distribution roughly: 20% desert, 30% plains, 30% forest, 20% tundra
+    if (noise < -0.3f) {
+        return BIOME_DESERT;
+    } else if (noise < 0.1f) {
+        return BIOME_PLAINS;
+    } else if (noise < 0.5f) {
+        return BIOME_FOREST;
+    } else {
+        return BIOME_TUNDRA;
+    }
+}
+
 BiomeType biome_get_at(int world_x, int world_z) {
     // Use 2D fBm noise for biome selection
     // Offset ensures independence from terrain height noise
@@ -92,17 +109,23 @@ BiomeType biome_get_at(int world_x, int world_z) {
         2.0f,       // lacunarity
         0.5f        // persistence
     );
+    return biome_from_noise(noise);
+}
 
-    // Map noise value (-1 to 1) to biome types
-    // Distribution roughly: 20% desert, 30% plains, 30% forest, 20% tundra
-    if (noise < -0.3f) {
-        return BIOME_DESERT;
-    } else if (noise < 0.1f) {
-        return BIOME_PLAINS;
-    } else if (noise < 0.5f) {
-        return BIOME_FOREST;
-    } else {
-        return BIOME_TUNDRA;
+void biome_get_grid(BiomeType* out, int x0, int z0, int size_x, int size_z) {
+    float xs[BIOME_GRID_ROW_MAX], zs[BIOME_GRID_ROW_MAX], noise[BIOME_GRID_ROW_MAX];
+    for (int z = 0; z < size_z; z++) {
+        for (int x = 0; x < size_x; x += BIOME_GRID_ROW_MAX) {
+            int n = size_x - x < BIOME_GRID_ROW_MAX ? size_x - x : BIOME_GRID_ROW_MAX;
+            for (int i = 0; i < n; i++) {
+                xs[i] = (float)(x0 + x + i) + BIOME_OFFSET;
+                zs[i] = (float)(z0 + z) + BIOME_OFFSET;
+            }
+            noise_fbm_2d_batch(xs, zs, noise, n, BIOME_OCTAVES, BIOME_FREQUENCY, 1.0f, 2.0f, 0.5f);
+            for (int i = 0; i < n; i++) {
+                out[z * size_x + x + i] = biome_from_noise(noise[i]);
+            }
+        }
     }
 }
 
@@ -0,0 +1,570 @@
+/**
+ * Cave Carver Implementation
+ */
+
+#include "voxel/world/cave.h"
+#include "voxel/world/noise.h"
+#include "voxel/world/random.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+_Static_assert(CHUNK_SIZE == 16, "cave rows are 16-bit masks");
+
+#define BRANCH_MAX_SEGMENTS (CAVE_BRANCH_MIN_SEGMENTS + CAVE_BRANCH_EXTRA_SEGMENTS)
+
+// ============================================================================
+// ROW KERNELS
+// ============================================================================
+
+/**
+ * Capsule (segment a..b swept by a radius going from ra to ra + dr)
+ */
+typedef struct {
+    float ax, ay, az;
+    float dx, dy, dz;               // b - a
+    float inv_len2;                 // 0 for a sphere
+    float ra, dr;
+} Capsule;
+
+/*
+ * One call tests all CHUNK_SIZE blocks of a row (fixed y and z) and returns
+ * the inside ones as a bitmask, CAVE_LANES blocks at a time. GCC/Clang
+ * vector extensions compile this to SSE2 (AVX2 with -mavx2) on x86-64 and
+ * NEON on ARM64, like the noise batches.
+ */
+#if defined(__GNUC__)
+
+#if defined(__AVX2__)
+#define CAVE_LANES 8
+#else
+#define CAVE_LANES 4
+#endif
+
+typedef float cfloat __attribute__((vector_size(CAVE_LANES * sizeof(float))));
+typedef int32_t cint __attribute__((vector_size(CAVE_LANES * sizeof(int32_t))));
+
+#define CAVE_GROUPS (CHUNK_SIZE / CAVE_LANES)
+
+// x of each lane, and the mask bit it sets
+#if CAVE_LANES == 8
+static const cfloat LANE_X[CAVE_GROUPS] = {
+    {0, 1, 2, 3, 4, 5, 6, 7}, {8, 9, 10, 11, 12, 13, 14, 15}
+};
+static const cint LANE_BIT[CAVE_GROUPS] = {
+    {1 << 0, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6, 1 << 7},
+    {1 << 8, 1 << 9, 1 << 10, 1 << 11, 1 << 12, 1 << 13, 1 << 14, 1 << 15}
+};
+#else
+static const cfloat LANE_X[CAVE_GROUPS] = {
+    {0, 1, 2, 3}, {4, 5, 6, 7}, {8, 9, 10, 11}, {12, 13, 14, 15}
+};
+static const cint LANE_BIT[CAVE_GROUPS] = {
+    {1 << 0, 1 << 1, 1 << 2, 1 << 3}, {1 << 4, 1 << 5, 1 << 6, 1 << 7},
+    {1 << 8, 1 << 9, 1 << 10, 1 << 11}, {1 << 12, 1 << 13, 1 << 14, 1 << 15}
+};
+#endif
+
+static inline cfloat cselect(cint mask, cfloat a, cfloat b) {
+    return (cfloat)(((cint)a & mask) | ((cint)b & ~mask));
+}
+
+/**
+ * Sum of the lanes' bits, kept in vector registers until the last step
+ */
+static inline uint16_t lane_bits(cint acc) {
+    int32_t bits = 0;
+    for (int i = 0; i < CAVE_LANES; i++) bits |= acc[i];
+    return (uint16_t)bits;
+}
+
+static uint16_t capsule_row(const Capsule* c, float py, float pz) {
+    cfloat zero = {0};
+    float along = py * c->dy + pz * c->dz;
+    cint acc = {0};
+    for (int g = 0; g < CAVE_GROUPS; g++) {
+        cfloat px = LANE_X[g] - c->ax;
+        cfloat t = (px * c->dx + along) * c->inv_len2;
+        t = cselect(t < 0.0f, zero, t);
+        t = cselect(t > 1.0f, zero + 1.0f, t);
+
+        cfloat ex = px - t * c->dx;
+        cfloat ey = py - t * c->dy;
+        cfloat ez = pz - t * c->dz;
+        cfloat r = c->ra + t * c->dr;
+        acc |= (ex * ex + ey * ey + ez * ez <= r * r) & LANE_BIT[g];
+    }
+    return lane_bits(acc);
+}
+
+static uint16_t ellipsoid_row(float cx, float rx, float rest) {
+    cint acc = {0};
+    for (int g = 0; g < CAVE_GROUPS; g++) {
+        cfloat ex = (LANE_X[g] - cx) / rx;
+        acc |= (ex * ex + rest <= 1.0f) & LANE_BIT[g];
+    }
+    return lane_bits(acc);
+}
+
+#else
+
+static uint16_t capsule_row(const Capsule* c, float py, float pz) {
+    float along = py * c->dy + pz * c->dz;
+    uint16_t bits = 0;
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        float px = (float)x - c->ax;
+        float t = (px * c->dx + along) * c->inv_len2;
+        if (t < 0.0f) t = 0.0f;
+        if (t > 1.0f) t = 1.0f;
+
+        float ex = px - t * c->dx;
+        float ey = py - t * c->dy;
+        float ez = pz - t * c->dz;
+        float r = c->ra + t * c->dr;
+        if (ex * ex + ey * ey + ez * ez <= r * r) bits |= (uint16_t)(1u << x);
+    }
+    return bits;
+}
+
+static uint16_t ellipsoid_row(float cx, float rx, float rest) {
+    uint16_t bits = 0;
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        float ex = ((float)x - cx) / rx;
+        if (ex * ex + rest <= 1.0f) bits |= (uint16_t)(1u << x);
+    }
+    return bits;
+}
+
+#endif
+
+// ============================================================================
+// MASK
+// ============================================================================
+
+/**
+ * Shared state of one cave_build_mask call
+ */
+typedef struct {
+    CaveMask* mask;
+    TerrainParams params;
+    const ColumnMap* columns;
+    int chunk_x, chunk_z;
+    uint32_t world_seed;
+    int y_lo, y_hi;                 // Rows any column may carve
+    const float* wobble;            // [segment][3] main tunnel wobble
+    const float* branch_wobble;     // [branch slot][segment][3]
+    float tunnel_reach;             // Farthest a tunnel gets from its start
+} CaveContext;
+
+/**
+ * Clip a box to the chunk; false if it misses
+ */
+static bool clip_box(const CaveContext* ctx, float min_x, float max_x, float min_y, float max_y,
+                     float min_z, float max_z, int* y0, int* z0, int* y1, int* z1) {
+    if (max_x < 0.0f || min_x > (float)(CHUNK_SIZE - 1)) return false;
+    if (max_z < 0.0f || min_z > (float)(CHUNK_SIZE - 1)) return false;
+
+    int lo_y = (int)floorf(min_y);
+    int hi_y = (int)ceilf(max_y);
+    *y0 = lo_y > ctx->y_lo ? lo_y : ctx->y_lo;
+    *y1 = hi_y < ctx->y_hi ? hi_y : ctx->y_hi;
+    if (*y0 > *y1) return false;
+
+    int lo_z = (int)floorf(min_z);
+    int hi_z = (int)ceilf(max_z);
+    *z0 = lo_z > 0 ? lo_z : 0;
+    *z1 = hi_z < CHUNK_SIZE - 1 ? hi_z : CHUNK_SIZE - 1;
+    return true;  // Rows are tested whole, x needs no clipping
+}
+
+static void mask_add_row(CaveMask* mask, int y, int z, uint16_t bits) {
+    if (!bits) return;
+    mask->rows[y][z] |= bits;
+    if (y < mask->min_y) mask->min_y = y;
+    if (y > mask->max_y) mask->max_y = y;
+}
+
+/**
+ * Carve a capsule from (ax, ay, az) radius ra to (bx, by, bz) radius rb
+ * Chunk-local coordinates
+ */
+static void carve_capsule(const CaveContext* ctx, float ax, float ay, float az, float ra,
+                          float bx, float by, float bz, float rb) {
+    float r = ra > rb ? ra : rb;
+    float min_x = ax < bx ? ax : bx, max_x = ax < bx ? bx : ax;
+    float min_z = az < bz ? az : bz, max_z = az < bz ? bz : az;
+    if (max_x + r < 0.0f || min_x - r > (float)(CHUNK_SIZE - 1) ||
+        max_z + r < 0.0f || min_z - r > (float)(CHUNK_SIZE - 1)) {
+        return;  // Most segments of a replayed tunnel miss the chunk
+    }
+
+    int y0, z0, y1, z1;
+    float min_y = ay < by ? ay : by, max_y = ay < by ? by : ay;
+    if (!clip_box(ctx, min_x - r, max_x + r, min_y - r, max_y + r, min_z - r, max_z + r,
+                  &y0, &z0, &y1, &z1)) {
+        return;
+    }
+
+    Capsule c = {ax, ay, az, bx - ax, by - ay, bz - az, 0.0f, ra, rb - ra};
+    float len2 = c.dx * c.dx + c.dy * c.dy + c.dz * c.dz;
+    if (len2 > 1e-6f) c.inv_len2 = 1.0f / len2;
+
+    for (int y = y0; y <= y1; y++) {
+        for (int z = z0; z <= z1; z++) {
+            mask_add_row(ctx->mask, y, z, capsule_row(&c, (float)y - ay, (float)z - az));
+        }
+    }
+}
+
+static void carve_ellipsoid(const CaveContext* ctx, float cx, float cy, float cz,
+                            float rx, float ry, float rz) {
+    int y0, z0, y1, z1;
+    if (!clip_box(ctx, cx - rx, cx + rx, cy - ry, cy + ry, cz - rz, cz + rz, &y0, &z0, &y1, &z1)) {
+        return;
+    }
+
+    for (int y = y0; y <= y1; y++) {
+        float dy = ((float)y - cy) / ry;
+        for (int z = z0; z <= z1; z++) {
+            float dz = ((float)z - cz) / rz;
+            mask_add_row(ctx->mask, y, z, ellipsoid_row(cx, rx, dy * dy + dz * dz));
+        }
+    }
+}
+
+// ============================================================================
+// ORIGIN CHUNKS
+// ============================================================================
+
+typedef struct {
+    int chunk_x, chunk_z;
+    uint32_t seed;
+    int height;
+    bool valid;
+} OriginHeight;
+
+// Neighboring chunks replay mostly the same origins: keep their heights
+static _Thread_local OriginHeight g_origin_heights[CAVE_ORIGIN_CACHE_SIZE];
+
+/**
+ * Terrain height at an origin chunk's center (what its caves are planned from)
+ */
+static int origin_height(const CaveContext* ctx, int origin_x, int origin_z) {
+    if (origin_x == ctx->chunk_x && origin_z == ctx->chunk_z) {
+        return ctx->columns->heights[CHUNK_SIZE / 2][CHUNK_SIZE / 2];
+    }
+
+    OriginHeight* entry = &g_origin_heights[random_hash_2d(origin_x, origin_z, 0) % CAVE_ORIGIN_CACHE_SIZE];
+    if (!entry->valid || entry->chunk_x != origin_x || entry->chunk_z != origin_z ||
+        entry->seed != ctx->world_seed) {
+        entry->chunk_x = origin_x;
+        entry->chunk_z = origin_z;
+        entry->seed = ctx->world_seed;
+        entry->height = terrain_get_height_at(origin_x * CHUNK_SIZE + CHUNK_SIZE / 2,
+                                              origin_z * CHUNK_SIZE + CHUNK_SIZE / 2, ctx->params);
+        entry->valid = true;
+    }
+    return entry->height;
+}
+
+static uint32_t origin_seed(const CaveContext* ctx, int origin_x, int origin_z, RandomFeature feature) {
+    return random_hash_2d(origin_x, origin_z, random_feature_seed(ctx->world_seed, feature));
+}
+
+// ============================================================================
+// TUNNELS
+// ============================================================================
+
+static void normalize(float* x, float* y, float* z) {
+    float len = sqrtf(*x * *x + *y * *y + *z * *z);
+    if (len > 0.01f) {
+        *x /= len;
+        *y /= len;
+        *z /= len;
+    }
+}
+
+/**
+ * Replay the worm tunnels of one origin chunk and carve what crosses ours
+ * The walk depends on the origin alone; only the carving is clipped
+ */
+static void carve_origin_tunnels(const CaveContext* ctx, int origin_x, int origin_z) {
+    const TerrainParams* params = &ctx->params;
+    uint32_t seed = origin_seed(ctx, origin_x, origin_z, RANDOM_FEATURE_TUNNELS);
+    int terrain_height = -1;
+
+    // Walk in the origin's local coordinates, carve in ours
+    float off_x = (float)((origin_x - ctx->chunk_x) * CHUNK_SIZE);
+    float off_z = (float)((origin_z - ctx->chunk_z) * CHUNK_SIZE);
+
+    // Number of tunnels varies per chunk
+    int num_tunnels = params->tunnels_per_chunk + (seed % 3) - 1;
+    if (num_tunnels < 1) num_tunnels = 1;
+
+    for (int t = 0; t < num_tunnels; t++) {
+        // One stream per tunnel, so tunnels out of reach can be skipped
+        RandomStream rng = random_stream(random_hash((uint32_t)t, seed));
+
+        // Random starting position within the origin chunk
+        float x = random_next_float(&rng) * CHUNK_SIZE;
+        float z = random_next_float(&rng) * CHUNK_SIZE;
+
+        float gap_x = fmaxf(fmaxf(-(off_x + x), off_x + x - CHUNK_SIZE), 0.0f);
+        float gap_z = fmaxf(fmaxf(-(off_z + z), off_z + z - CHUNK_SIZE), 0.0f);
+        if (gap_x * gap_x + gap_z * gap_z > ctx->tunnel_reach * ctx->tunnel_reach) continue;
+        if (terrain_height < 0) terrain_height = origin_height(ctx, origin_x, origin_z);
+
+        // Y range: caves in upper 150 blocks below surface
+        int min_cave_y = terrain_height - 150;
+        if (min_cave_y < 20) min_cave_y = 20;
+        int max_cave_y = terrain_height - params->cave_min_depth - 10;
+        if (max_cave_y < min_cave_y + 20) max_cave_y = min_cave_y + 20;
+        float y = min_cave_y + random_next_float(&rng) * (max_cave_y - min_cave_y);
+
+        // Random direction (mostly horizontal)
+        float dir_x = random_next_float(&rng) * 2.0f - 1.0f;
+        float dir_y = random_next_float(&rng) * 0.4f - 0.2f;  // Slight vertical
+        float dir_z = random_next_float(&rng) * 2.0f - 1.0f;
+        normalize(&dir_x, &dir_y, &dir_z);
+
+        // Starting radius
+        float radius = params->tunnel_radius_min +
+                       random_next_float(&rng) * (params->tunnel_radius_max - params->tunnel_radius_min);
+
+        // Each segment joins the previous position to this one
+        float prev_x = x, prev_y = y, prev_z = z, prev_radius = radius;
+        for (int seg = 0; seg < params->tunnel_segments; seg++) {
+            carve_capsule(ctx, off_x + prev_x, prev_y, off_z + prev_z, prev_radius,
+                          off_x + x, y, off_z + z, radius);
+            prev_x = x;
+            prev_y = y;
+            prev_z = z;
+            prev_radius = radius;
+
+            // Move along direction with noise wobble
+            const float* wobble = &ctx->wobble[seg * 3];
+            x += dir_x + wobble[0];
+            y += dir_y + wobble[1];
+            z += dir_z + wobble[2];
+
+            // Occasionally change direction
+            if (seg % 12 == 0) {
+                dir_x += random_next_float(&rng) * 0.5f - 0.25f;
+                dir_y += random_next_float(&rng) * 0.2f - 0.1f;
+                dir_z += random_next_float(&rng) * 0.5f - 0.25f;
+                normalize(&dir_x, &dir_y, &dir_z);
+            }
+
+            // Vary radius slightly
+            radius += random_next_float(&rng) * 0.4f - 0.2f;
+            if (radius < params->tunnel_radius_min) radius = params->tunnel_radius_min;
+            if (radius > params->tunnel_radius_max) radius = params->tunnel_radius_max;
+
+            // Keep Y within valid range
+            if (y < params->bedrock_start + 20) {
+                dir_y = fabsf(dir_y);  // Go up
+            }
+            if (y > terrain_height - params->cave_min_depth - 30) {
+                dir_y = -fabsf(dir_y);  // Go down
+            }
+
+            // Branching tunnels - 25% chance every 20 segments
+            if (seg % 20 == 10 && random_next_float(&rng) < 0.25f) {
+                // Create a branch in a perpendicular direction
+                float branch_x = x;
+                float branch_y = y;
+                float branch_z = z;
+
+                float branch_dir_x = -dir_z + (random_next_float(&rng) * 0.4f - 0.2f);
+                float branch_dir_y = random_next_float(&rng) * 0.3f - 0.15f;
+                float branch_dir_z = dir_x + (random_next_float(&rng) * 0.4f - 0.2f);
+                normalize(&branch_dir_x, &branch_dir_y, &branch_dir_z);
+
+                // Branch is smaller and shorter
+                float branch_radius = radius * 0.7f;
+                int branch_segments = CAVE_BRANCH_MIN_SEGMENTS +
+                                      (int)(random_next_float(&rng) * CAVE_BRANCH_EXTRA_SEGMENTS);
+                const float* branch_wobble = &ctx->branch_wobble[(seg / 20) * BRANCH_MAX_SEGMENTS * 3];
+
+                float bprev_x = branch_x, bprev_y = branch_y, bprev_z = branch_z;
+                float bprev_radius = branch_radius;
+                for (int b = 0; b < branch_segments; b++) {
+                    carve_capsule(ctx, off_x + bprev_x, bprev_y, off_z + bprev_z, bprev_radius,
+                                  off_x + branch_x, branch_y, off_z + branch_z, branch_radius);
+                    bprev_x = branch_x;
+                    bprev_y = branch_y;
+                    bprev_z = branch_z;
+                    bprev_radius = branch_radius;
+
+                    // Move branch forward with slight wobble
+                    branch_x += branch_dir_x + branch_wobble[b * 3 + 0];
+                    branch_y += branch_dir_y + branch_wobble[b * 3 + 1];
+                    branch_z += branch_dir_z + branch_wobble[b * 3 + 2];
+
+                    // Taper the branch
+                    branch_radius *= 0.97f;
+                    if (branch_radius < 1.5f) break;
+
+                    // Keep branch in valid Y range
+                    if (branch_y < params->bedrock_start + 10 ||
+                        branch_y > terrain_height - params->cave_min_depth - 20) {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ============================================================================
+// ROOMS
+// ============================================================================
+
+static void carve_origin_rooms(const CaveContext* ctx, int origin_x, int origin_z) {
+    const TerrainParams* params = &ctx->params;
+    uint32_t seed = origin_seed(ctx, origin_x, origin_z, RANDOM_FEATURE_ROOMS);
+    RandomStream rng = random_stream(seed);
+    int terrain_height = origin_height(ctx, origin_x, origin_z);
+
+    float off_x = (float)((origin_x - ctx->chunk_x) * CHUNK_SIZE);
+    float off_z = (float)((origin_z - ctx->chunk_z) * CHUNK_SIZE);
+
+    // Number of rooms varies
+    int num_rooms = 1 + (seed % (params->rooms_per_chunk + 1));
+
+    for (int r = 0; r < num_rooms; r++) {
+        // Random position within the origin chunk
+        float x = random_next_float(&rng) * CHUNK_SIZE;
+        float z = random_next_float(&rng) * CHUNK_SIZE;
+
+        // Y range: rooms in upper 120 blocks below surface
+        int min_room_y = terrain_height - 120;
+        if (min_room_y < 30) min_room_y = 30;
+        int max_room_y = terrain_height - params->cave_min_depth - 20;
+        if (max_room_y < min_room_y + 20) max_room_y = min_room_y + 20;
+        float y = min_room_y + random_next_float(&rng) * (max_room_y - min_room_y);
+
+        // Random ellipsoid dimensions
+        float rx = params->room_radius_min +
+                   random_next_float(&rng) * (params->room_radius_max - params->room_radius_min);
+        float ry = (params->room_radius_min * 0.6f) +
+                   random_next_float(&rng) * ((params->room_radius_max * 0.6f) - (params->room_radius_min * 0.6f));
+        float rz = params->room_radius_min +
+                   random_next_float(&rng) * (params->room_radius_max - params->room_radius_min);
+
+        carve_ellipsoid(ctx, off_x + x, y, off_z + z, rx, ry, rz);
+    }
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+bool cave_build_mask(CaveMask* mask, int chunk_x, int chunk_z,
+                     TerrainParams params, const ColumnMap* columns) {
+    memset(mask->rows, 0, sizeof(mask->rows));
+    mask->min_y = CHUNK_HEIGHT;
+    mask->max_y = -1;
+
+    int max_height = 0;
+    for (int z = 0; z < CHUNK_SIZE; z++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            if (columns->heights[z][x] > max_height) max_height = columns->heights[z][x];
+        }
+    }
+
+    CaveContext ctx = {
+        .mask = mask,
+        .params = params,
+        .columns = columns,
+        .chunk_x = chunk_x,
+        .chunk_z = chunk_z,
+        .world_seed = noise_get_seed(),
+        .y_lo = params.bedrock_start,
+        .y_hi = max_height - params.cave_min_depth,
+    };
+    if (ctx.y_hi > CHUNK_HEIGHT - 1) ctx.y_hi = CHUNK_HEIGHT - 1;
+    if (ctx.y_lo < 0) ctx.y_lo = 0;
+    if (ctx.y_hi < ctx.y_lo) return false;
+
+    if (params.generate_cave_tunnels && params.tunnel_segments > 0) {
+        // The wobble depends on the segment index alone: same for every tunnel
+        int segments = params.tunnel_segments;
+        int branch_slots = (segments + 9) / 20;
+        float* wobble = (float*)malloc(((size_t)segments + (size_t)branch_slots * BRANCH_MAX_SEGMENTS) *
+                                       3 * sizeof(float));
+        if (!wobble) {
+            printf("[CAVE] Failed to allocate tunnel wobble, skipping tunnels\n");
+        } else {
+            for (int seg = 0; seg < segments; seg++) {
+                wobble[seg * 3 + 0] = noise_3d((float)seg * 0.1f, 0, 0) * 0.5f;
+                wobble[seg * 3 + 1] = noise_3d((float)seg * 0.1f + 100.0f, 0, 0) * 0.3f;
+                wobble[seg * 3 + 2] = noise_3d((float)seg * 0.1f + 200.0f, 0, 0) * 0.5f;
+            }
+            float* branch_wobble = wobble + segments * 3;
+            for (int slot = 0; slot < branch_slots; slot++) {
+                int seg = slot * 20 + 10;
+                for (int b = 0; b < BRANCH_MAX_SEGMENTS; b++) {
+                    float* w = &branch_wobble[(slot * BRANCH_MAX_SEGMENTS + b) * 3];
+                    w[0] = noise_3d((float)(seg * 10 + b) * 0.1f, 0, 0) * 0.3f;
+                    w[1] = noise_3d((float)(seg * 10 + b) * 0.1f + 50.0f, 0, 0) * 0.2f;
+                    w[2] = noise_3d((float)(seg * 10 + b) * 0.1f + 100.0f, 0, 0) * 0.3f;
+                }
+            }
+            ctx.wobble = wobble;
+            ctx.branch_wobble = branch_wobble;
+
+            // Farthest a walk can get: each step moves one block along its
+            // direction plus that step's wobble. Branches leave the main
+            // tunnel after slot * 20 + 11 steps
+            float main_reach = 0.0f, reach = 0.0f;
+            for (int seg = 0; seg < segments; seg++) {
+                if (seg % 20 == 10) {
+                    float branch_reach = main_reach;
+                    const float* w = &branch_wobble[(seg / 20) * BRANCH_MAX_SEGMENTS * 3];
+                    branch_reach += 1.0f + hypotf(wobble[seg * 3 + 0], wobble[seg * 3 + 2]);
+                    for (int b = 0; b < BRANCH_MAX_SEGMENTS - 1; b++) {
+                        branch_reach += 1.0f + hypotf(w[b * 3 + 0], w[b * 3 + 2]);
+                    }
+                    reach = fmaxf(reach, branch_reach);
+                }
+                if (seg < segments - 1) main_reach += 1.0f + hypotf(wobble[seg * 3 + 0], wobble[seg * 3 + 2]);
+            }
+            reach = fmaxf(reach, main_reach) + params.tunnel_radius_max + 1.0f;
+            ctx.tunnel_reach = reach;
+
+            // Every origin whose tunnels can reach this chunk
+            int reach_chunks = (int)ceilf(reach / CHUNK_SIZE);
+            for (int dz = -reach_chunks; dz <= reach_chunks; dz++) {
+                for (int dx = -reach_chunks; dx <= reach_chunks; dx++) {
+                    carve_origin_tunnels(&ctx, chunk_x + dx, chunk_z + dz);
+                }
+            }
+            free(wobble);
+        }
+    }
+
+    if (params.generate_cave_rooms) {
+        int reach_chunks = (int)ceilf(params.room_radius_max / CHUNK_SIZE);
+        for (int dz = -reach_chunks; dz <= reach_chunks; dz++) {
+            for (int dx = -reach_chunks; dx <= reach_chunks; dx++) {
+                carve_origin_rooms(&ctx, chunk_x + dx, chunk_z + dz);
+            }
+        }
+    }
+
+    if (mask->min_y > mask->max_y) return false;
+
+    // Keep cave_min_depth of rock under each column's own surface
+    for (int z = 0; z < CHUNK_SIZE; z++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            uint16_t keep = (uint16_t)~(1u << x);
+            int top = columns->heights[z][x] - params.cave_min_depth;
+            for (int y = top + 1 > mask->min_y ? top + 1 : mask->min_y; y <= mask->max_y; y++) {
+                mask->rows[y][z] &= keep;
+            }
+        }
+    }
+    return true;
+}
@@ -3,6 +3,10 @@
  */
 
 #include "voxel/world/chest.h"
+#include "voxel/world/chunk.h"
+#include "voxel/world/random.h"
+#include "voxel/world/noise.h"
+#include "voxel/core/memory.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -38,70 +42,29 @@ static const LootEntry DUNGEON_LOOT[] = {
 #define DUNGEON_LOOT_COUNT (sizeof(DUNGEON_LOOT) / sizeof(LootEntry))
 
 // ============================================================================
-// HELPER FUNCTIONS
+// PER-CHUNK STORAGE
 // ============================================================================
 
-/**
- * Simple hash function for chest positions
- */
-static unsigned int chest_hash(int x, int y, int z) {
-    unsigned int h = 2166136261u;
-    h = (h ^ (unsigned int)x) * 16777619u;
-    h = (h ^ (unsigned int)y) * 16777619u;
-    h = (h ^ (unsigned int)z) * 16777619u;
-    return h % CHEST_REGISTRY_SIZE;
-}
-
-/**
- * Simple deterministic random from seed
- */
-static float random_from_seed(unsigned int* seed) {
-    *seed = (*seed * 1103515245 + 12345) & 0x7FFFFFFF;
-    return (float)*seed / (float)0x7FFFFFFF;
-}
-
-// ============================================================================
-// REGISTRY MANAGEMENT
-// ============================================================================
-
-ChestRegistry* chest_registry_create(void) {
-    ChestRegistry* registry = (ChestRegistry*)malloc(sizeof(ChestRegistry));
-    if (!registry) return NULL;
-
-    memset(registry->buckets, 0, sizeof(registry->buckets));
-    registry->count = 0;
-
-    printf("[CHEST] Registry created\n");
-    return registry;
-}
-
-void chest_registry_destroy(ChestRegistry* registry) {
-    if (!registry) return;
-
-    // Free all chest data
-    for (int i = 0; i < CHEST_REGISTRY_SIZE; i++) {
-        ChestData* chest = registry->buckets[i];
-        while (chest) {
-            ChestData* next = chest->next;
-            free(chest);
-            chest = next;
-        }
+void chest_list_free(ChestData* chests) {
+    while (chests) {
+        ChestData* next = chests->next;
+        memory_track(MEMORY_CHESTS, -(ptrdiff_t)sizeof(ChestData));
+        free(chests);
+        chests = next;
     }
-
-    free(registry);
-    printf("[CHEST] Registry destroyed\n");
 }
 
-ChestData* chest_create(ChestRegistry* registry, int x, int y, int z) {
-    if (!registry) return NULL;
+ChestData* chest_create(Chunk* chunk, int x, int y, int z) {
+    if (!chunk) return NULL;
 
     // Check if chest already exists
-    ChestData* existing = chest_get(registry, x, y, z);
+    ChestData* existing = chest_get(chunk, x, y, z);
     if (existing) return existing;
 
     // Create new chest
     ChestData* chest = (ChestData*)malloc(sizeof(ChestData));
     if (!chest) return NULL;
+    memory_track(MEMORY_CHESTS, (ptrdiff_t)sizeof(ChestData));
 
     chest->x = x;
     chest->y = y;
@@ -113,51 +76,49 @@ ChestData* chest_create(ChestRegistry* registry, int x, int y, int z) {
         chest->slots[i] = (ItemStack){ITEM_NONE, 0, 0, 0};
     }
 
-    // Insert into hash table
-    unsigned int hash = chest_hash(x, y, z);
-    chest->next = registry->buckets[hash];
-    registry->buckets[hash] = chest;
-    registry->count++;
+    chest->next = chunk->chests;
+    chunk->chests = chest;
+    chunk->needs_save = true;
 
     return chest;
 }
 
-ChestData* chest_get(ChestRegistry* registry, int x, int y, int z) {
-    if (!registry) return NULL;
+ChestData* chest_open(Chunk* chunk, int x, int y, int z) {
+    ChestData* chest = chest_get(chunk, x, y, z);
+    if (chest) return chest;
 
-    unsigned int hash = chest_hash(x, y, z);
-    ChestData* chest = registry->buckets[hash];
+    chest = chest_create(chunk, x, y, z);
+    if (chest) {
+        uint32_t loot_seed = random_hash_3d(x, y, z, random_feature_seed(noise_get_seed(), RANDOM_FEATURE_LOOT));
+        chest_generate_dungeon_loot(chest, loot_seed);
+    }
+    return chest;
+}
 
-    while (chest) {
+ChestData* chest_get(Chunk* chunk, int x, int y, int z) {
+    if (!chunk) return NULL;
+
+    for (ChestData* chest = chunk->chests; chest; chest = chest->next) {
         if (chest->x == x && chest->y == y && chest->z == z) {
             return chest;
         }
-        chest = chest->next;
     }
 
     return NULL;
 }
 
-void chest_remove(ChestRegistry* registry, int x, int y, int z) {
-    if (!registry) return;
-
-    unsigned int hash = chest_hash(x, y, z);
-    ChestData* chest = registry->buckets[hash];
-    ChestData* prev = NULL;
+void chest_remove(Chunk* chunk, int x, int y, int z) {
+    if (!chunk) return;
 
-    while (chest) {
+    for (ChestData** link = &chunk->chests; *link; link = &(*link)->next) {
+        ChestData* chest = *link;
         if (chest->x == x && chest->y == y && chest->z == z) {
-            if (prev) {
-                prev->next = chest->next;
-            } else {
-                registry->buckets[hash] = chest->next;
-            }
+            *link = chest->next;
+            memory_track(MEMORY_CHESTS, -(ptrdiff_t)sizeof(ChestData));
             free(chest);
-            registry->count--;
+            chunk->needs_save = true;
             return;
         }
-        prev = chest;
-        chest = chest->next;
     }
 }
 
@@ -170,6 +131,7 @@ void chest_generate_dungeon_loot(ChestData* chest, unsigned int seed) {
 
     chest->loot_generated = true;
 
+    RandomStream rng = random_stream(seed);
     int slot = 0;
 
     // Roll for each loot entry
@@ -177,12 +139,12 @@ void chest_generate_dungeon_loot(ChestData* chest, unsigned int seed) {
         const LootEntry* entry = &DUNGEON_LOOT[i];
 
         // Check if this item appears
-        if (random_from_seed(&seed) < entry->chance) {
+        if (random_next_float(&rng) < entry->chance) {
             // Determine count
             int range = entry->max_count - entry->min_count + 1;
             int count = entry->min_count;
             if (range > 1) {
-                count += (int)(random_from_seed(&seed) * range);
+                count += (int)(random_next_float(&rng) * range);
             }
 
             // Get item properties
@@ -207,7 +169,7 @@ void chest_generate_dungeon_loot(ChestData* chest, unsigned int seed) {
 
     // Shuffle slots for more natural distribution
     for (int i = slot - 1; i > 0; i--) {
-        int j = (int)(random_from_seed(&seed) * (i + 1));
+        int j = (int)(random_next_float(&rng) * (i + 1));
         ItemStack temp = chest->slots[i];
         chest->slots[i] = chest->slots[j];
         chest->slots[j] = temp;
@@ -4,8 +4,13 @@
 
 #include "voxel/world/chunk.h"
 #include "voxel/world/chunk_worker.h"
+#include "voxel/world/mesh_arena.h"
+#include "voxel/world/chest.h"
 #include "voxel/core/texture_atlas.h"
+#include "voxel/core/memory.h"
 #include "voxel/render/light.h"
+#include "voxel/render/chunk_water.h"
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -25,6 +30,958 @@ bool chunk_in_bounds(int x, int y, int z) {
             z >= 0 && z < CHUNK_SIZE);
 }
 
+// ============================================================================
+// SECTION STORAGE
+// ============================================================================
+
+static inline int section_local_index(int x, int y, int z) {
+    return ((y & (CHUNK_SECTION_HEIGHT - 1)) << 8) | (z << 4) | x;
+}
+
+static inline uint8_t packed_read(const uint8_t* indices, int bits, int i) {
+    int bit = i * bits;
+    return (uint8_t)((indices[bit >> 3] >> (bit & 7)) & ((1 << bits) - 1));
+}
+
+static inline void packed_write(uint8_t* indices, int bits, int i, uint8_t value) {
+    int bit = i * bits;
+    uint8_t mask = (uint8_t)(((1 << bits) - 1) << (bit & 7));
+    uint8_t* byte = &indices[bit >> 3];
+    *byte = (uint8_t)((*byte & ~mask) | ((value << (bit & 7)) & mask));
+}
+
+static inline uint8_t nibble_read(const uint8_t* arr, int i) {
+    return (uint8_t)((arr[i >> 1] >> ((i & 1) << 2)) & 0x0F);
+}
+
+static inline void nibble_write(uint8_t* arr, int i, uint8_t value) {
+    int shift = (i & 1) << 2;
+    arr[i >> 1] = (uint8_t)((arr[i >> 1] & ~(0x0F << shift)) | ((value & 0x0F) << shift));
+}
+
+/**
+ * Heap blocks owned by chunks, counted as MEMORY_CHUNK_STORAGE
+ */
+static void* storage_alloc(size_t bytes, bool zeroed) {
+    void* ptr = zeroed ? calloc(bytes, 1) : malloc(bytes);
+    if (ptr) memory_track(MEMORY_CHUNK_STORAGE, (ptrdiff_t)bytes);
+    return ptr;
+}
+
+static void storage_free(void* ptr, size_t bytes) {
+    if (!ptr) return;
+    memory_track(MEMORY_CHUNK_STORAGE, -(ptrdiff_t)bytes);
+    free(ptr);
+}
+
+static inline size_t section_index_bytes(int bits) {
+    return (size_t)CHUNK_SECTION_VOLUME * bits / 8;
+}
+
+static inline size_t section_palette_bytes(int bits) {
+    return bits ? ((size_t)1 << bits) : 0;
+}
+
+static inline uint8_t section_get_type(const ChunkSection* s, int i) {
+    return s->bits ? s->palette[packed_read(s->indices, s->bits, i)] : s->uniform_type;
+}
+
+/**
+ * Set a nibble, allocating the array the first time a value differs from uniform
+ */
+static void section_set_nibble(uint8_t** arr, uint8_t uniform, int i, uint8_t value) {
+    value &= 0x0F;
+    if (!*arr) {
+        if (value == uniform) return;
+        *arr = (uint8_t*)storage_alloc(CHUNK_NIBBLE_BYTES, false);
+        if (!*arr) {
+            printf("[CHUNK] Failed to allocate nibble array\n");
+            return;
+        }
+        memset(*arr, uniform | (uniform << 4), CHUNK_NIBBLE_BYTES);
+    }
+    nibble_write(*arr, i, value);
+}
+
+/**
+ * Free a nibble array if every entry holds the same value
+ */
+static void section_compact_nibbles(uint8_t** arr, uint8_t* uniform) {
+    if (!*arr) return;
+    uint8_t first = (*arr)[0];
+    if ((first & 0x0F) != (first >> 4)) return;
+    for (int j = 1; j < CHUNK_NIBBLE_BYTES; j++) {
+        if ((*arr)[j] != first) return;
+    }
+    *uniform = first & 0x0F;
+    storage_free(*arr, CHUNK_NIBBLE_BYTES);
+    *arr = NULL;
+}
+
+/**
+ * Repack indices at a new bit width (palette capacity 1 << new_bits)
+ */
+static bool section_resize(ChunkSection* s, int new_bits) {
+    uint8_t* indices = (uint8_t*)storage_alloc(section_index_bytes(new_bits), true);
+    uint8_t* palette = (uint8_t*)storage_alloc(section_palette_bytes(new_bits), false);
+    if (!indices || !palette) {
+        printf("[CHUNK] Failed to grow section palette\n");
+        storage_free(indices, section_index_bytes(new_bits));
+        storage_free(palette, section_palette_bytes(new_bits));
+        return false;
+    }
+
+    if (s->bits == 0) {
+        // Uniform section becomes index 0 everywhere (calloc)
+        palette[0] = s->uniform_type;
+        s->palette_size = 1;
+    } else {
+        memcpy(palette, s->palette, s->palette_size);
+        for (int i = 0; i < CHUNK_SECTION_VOLUME; i++) {
+            packed_write(indices, new_bits, i, packed_read(s->indices, s->bits, i));
+        }
+        storage_free(s->indices, section_index_bytes(s->bits));
+        storage_free(s->palette, section_palette_bytes(s->bits));
+    }
+
+    s->indices = indices;
+    s->palette = palette;
+    s->bits = (uint8_t)new_bits;
+    return true;
+}
+
+/**
+ * Drop type arrays and make the section a single block type
+ */
+static void section_make_uniform(ChunkSection* s, uint8_t type) {
+    storage_free(s->indices, section_index_bytes(s->bits));
+    storage_free(s->palette, section_palette_bytes(s->bits));
+    s->indices = NULL;
+    s->palette = NULL;
+    s->bits = 0;
+    s->palette_size = 0;
+    s->uniform_type = type;
+}
+
+static void section_set_type(ChunkSection* s, int i, uint8_t type) {
+    if (s->bits == 0) {
+        if (type == s->uniform_type) return;
+        if (!section_resize(s, 1)) return;
+    }
+
+    int entry = -1;
+    for (int p = 0; p < s->palette_size; p++) {
+        if (s->palette[p] == type) {
+            entry = p;
+            break;
+        }
+    }
+
+    if (entry < 0) {
+        if (s->palette_size == (1 << s->bits)) {
+            // 1 -> 2 -> 4 -> 8 bits so entries never straddle a byte
+            if (!section_resize(s, s->bits * 2)) return;
+        }
+        entry = s->palette_size++;
+        s->palette[entry] = type;
+    }
+
+    packed_write(s->indices, s->bits, i, (uint8_t)entry);
+}
+
+static void section_free(ChunkSection* s) {
+    storage_free(s->indices, section_index_bytes(s->bits));
+    storage_free(s->palette, section_palette_bytes(s->bits));
+    storage_free(s->light, CHUNK_NIBBLE_BYTES);
+    storage_free(s->metadata, CHUNK_NIBBLE_BYTES);
+    memset(s, 0, sizeof(ChunkSection));
+}
+
+/**
+ * Rebuild palette with only the entries in use, at the smallest bit width
+ */
+static void section_compact(ChunkSection* s) {
+    section_compact_nibbles(&s->light, &s->uniform_light);
+    section_compact_nibbles(&s->metadata, &s->uniform_metadata);
+
+    if (s->bits == 0) return;
+
+    bool used[256] = {false};
+    for (int i = 0; i < CHUNK_SECTION_VOLUME; i++) {
+        used[packed_read(s->indices, s->bits, i)] = true;
+    }
+
+    uint8_t remap[256];
+    uint8_t palette[256];
+    int count = 0;
+    for (int p = 0; p < s->palette_size; p++) {
+        if (used[p]) {
+            remap[p] = (uint8_t)count;
+            palette[count++] = s->palette[p];
+        }
+    }
+
+    if (count <= 1) {
+        section_make_uniform(s, count == 1 ? palette[0] : BLOCK_AIR);
+        return;
+    }
+
+    int bits = 1;
+    while ((1 << bits) < count) bits *= 2;
+    if (bits == s->bits && count == s->palette_size) return;
+
+    uint8_t* indices = (uint8_t*)storage_alloc(section_index_bytes(bits), true);
+    uint8_t* new_palette = (uint8_t*)storage_alloc(section_palette_bytes(bits), false);
+    if (!indices || !new_palette) {
+        storage_free(indices, section_index_bytes(bits));
+        storage_free(new_palette, section_palette_bytes(bits));
+        return;  // Keep the larger but valid layout
+    }
+    for (int i = 0; i < CHUNK_SECTION_VOLUME; i++) {
+        packed_write(indices, bits, i, remap[packed_read(s->indices, s->bits, i)]);
+    }
+    memcpy(new_palette, palette, count);
+
+    storage_free(s->indices, section_index_bytes(s->bits));
+    storage_free(s->palette, section_palette_bytes(s->bits));
+    s->indices = indices;
+    s->palette = new_palette;
+    s->palette_size = (uint16_t)count;
+    s->bits = (uint8_t)bits;
+}
+
+void chunk_decode_types(Chunk* chunk, uint8_t* out_types) {
+    if (!chunk || !out_types) return;
+    chunk_ensure_warm(chunk);
+
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        const ChunkSection* s = &chunk->sections[sy];
+        uint8_t* out = out_types + sy * CHUNK_SECTION_VOLUME;
+        if (s->bits == 0) {
+            memset(out, s->uniform_type, CHUNK_SECTION_VOLUME);
+            continue;
+        }
+        for (int i = 0; i < CHUNK_SECTION_VOLUME; i++) {
+            out[i] = s->palette[packed_read(s->indices, s->bits, i)];
+        }
+    }
+}
+
+static uint64_t hash_words(uint64_t hash, const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        hash = ((hash << 5) | (hash >> 59)) ^ word;
+        hash *= 0x9E3779B97F4A7C15ull;
+    }
+    return hash;
+}
+
+static uint64_t hash_nibbles(uint64_t hash, const uint8_t* nibbles, uint8_t uniform) {
+    uint8_t expanded[CHUNK_SECTION_VOLUME / 2];
+    if (!nibbles) {
+        memset(expanded, uniform | (uniform << 4), sizeof(expanded));
+        nibbles = expanded;
+    }
+    return hash_words(hash, nibbles, CHUNK_SECTION_VOLUME / 2);
+}
+
+uint64_t chunk_content_hash(Chunk* chunk) {
+    if (!chunk) return 0;
+    chunk_ensure_warm(chunk);
+
+    uint64_t hash = 14695981039346656037ull;
+    uint8_t types[CHUNK_SECTION_VOLUME];
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        const ChunkSection* s = &chunk->sections[sy];
+        if (s->bits == 0) {
+            memset(types, s->uniform_type, sizeof(types));
+        } else {
+            for (int i = 0; i < CHUNK_SECTION_VOLUME; i++) {
+                types[i] = s->palette[packed_read(s->indices, s->bits, i)];
+            }
+        }
+        hash = hash_words(hash, types, sizeof(types));
+        hash = hash_nibbles(hash, s->light, s->uniform_light);
+        hash = hash_nibbles(hash, s->metadata, s->uniform_metadata);
+    }
+    return hash;
+}
+
+ChunkBorder* chunk_border_alloc(void) {
+    ChunkBorder* border = (ChunkBorder*)malloc(sizeof(ChunkBorder));
+    if (border) memory_track(MEMORY_WORKER, (ptrdiff_t)sizeof(ChunkBorder));
+    return border;
+}
+
+void chunk_border_free(ChunkBorder* border) {
+    if (!border) return;
+    memory_track(MEMORY_WORKER, -(ptrdiff_t)sizeof(ChunkBorder));
+    free(border);
+}
+
+void chunk_border_capture(ChunkBorder* border, Chunk* neighbor, int dx, int dz) {
+    if (!border) return;
+    if (neighbor) chunk_ensure_warm(neighbor);
+
+    // Ring cells owned by this neighbor, in the meshed chunk's local coordinates
+    int x0 = dx < 0 ? -1 : (dx > 0 ? CHUNK_SIZE : 0);
+    int x1 = dx == 0 ? CHUNK_SIZE - 1 : x0;
+    int z0 = dz < 0 ? -1 : (dz > 0 ? CHUNK_SIZE : 0);
+    int z1 = dz == 0 ? CHUNK_SIZE - 1 : z0;
+
+    for (int z = z0; z <= z1; z++) {
+        for (int x = x0; x <= x1; x++) {
+            int cell = chunk_border_index(x, z);
+            if (!neighbor) {
+                for (int y = 0; y < CHUNK_HEIGHT; y++) {
+                    border->types[y][cell] = BLOCK_AIR;
+                    border->light[y][cell] = 8;  // get_block_light's edge guess
+                }
+                continue;
+            }
+
+            int nx = x - dx * CHUNK_SIZE;
+            int nz = z - dz * CHUNK_SIZE;
+            for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+                const ChunkSection* s = &neighbor->sections[sy];
+                int y0 = sy * CHUNK_SECTION_HEIGHT;
+
+                // Sky and buried stone sections copy without decoding
+                if (s->bits == 0 && !s->light) {
+                    for (int y = y0; y < y0 + CHUNK_SECTION_HEIGHT; y++) {
+                        border->types[y][cell] = s->uniform_type;
+                        border->light[y][cell] = s->uniform_light;
+                    }
+                    continue;
+                }
+                for (int y = y0; y < y0 + CHUNK_SECTION_HEIGHT; y++) {
+                    int i = section_local_index(nx, y, nz);
+                    border->types[y][cell] = section_get_type(s, i);
+                    border->light[y][cell] = s->light ? nibble_read(s->light, i) : s->uniform_light;
+                }
+            }
+        }
+    }
+}
+
+void chunk_store_light(Chunk* chunk, const uint8_t* light) {
+    if (!chunk || !light) return;
+    chunk_ensure_warm(chunk);
+
+    uint16_t changed = 0;
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        ChunkSection* s = &chunk->sections[sy];
+        const uint8_t* in = light + sy * CHUNK_SECTION_VOLUME;
+
+        bool uniform = true;
+        for (int i = 1; i < CHUNK_SECTION_VOLUME; i++) {
+            if (in[i] != in[0]) {
+                uniform = false;
+                break;
+            }
+        }
+
+        if (uniform) {
+            if (s->light || s->uniform_light != (in[0] & 0x0F)) changed |= (uint16_t)(1u << sy);
+            storage_free(s->light, CHUNK_NIBBLE_BYTES);
+            s->light = NULL;
+            s->uniform_light = in[0] & 0x0F;
+            continue;
+        }
+
+        if (!s->light) {
+            s->light = (uint8_t*)storage_alloc(CHUNK_NIBBLE_BYTES, false);
+            if (!s->light) {
+                printf("[CHUNK] Failed to allocate light array\n");
+                continue;
+            }
+            changed |= (uint16_t)(1u << sy);
+        }
+        for (int j = 0; j < CHUNK_NIBBLE_BYTES; j++) {
+            uint8_t packed = (uint8_t)((in[j * 2] & 0x0F) | ((in[j * 2 + 1] & 0x0F) << 4));
+            if (s->light[j] != packed) {
+                s->light[j] = packed;
+                changed |= (uint16_t)(1u << sy);
+            }
+        }
+    }
+
+    // Face light samples one block across section borders
+    uint16_t spread = (uint16_t)(changed | (changed << 1) | (changed >> 1));
+    if (spread) chunk_mark_sections_dirty(chunk, spread);
+}
+
+void chunk_store_types(Chunk* chunk, const uint8_t* types) {
+    if (!chunk || !types) return;
+    chunk_ensure_warm(chunk);
+
+    int count = 0;
+    uint8_t min_y = 255;  // Start with invalid range
+    uint8_t max_y = 0;
+
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        ChunkSection* s = &chunk->sections[sy];
+        const uint8_t* in = types + sy * CHUNK_SECTION_VOLUME;
+
+        // One pass collects the palette, the block count and the Y bounds
+        uint16_t entry[256];
+        memset(entry, 0xFF, sizeof(entry));
+        uint8_t palette[256];
+        int palette_size = 0;
+        int solid = 0;
+        for (int row = 0; row < CHUNK_SECTION_HEIGHT; row++) {
+            int row_solid = 0;
+            for (int i = row << 8; i < (row + 1) << 8; i++) {
+                uint8_t type = in[i];
+                if (entry[type] == 0xFFFF) {
+                    entry[type] = (uint16_t)palette_size;
+                    palette[palette_size++] = type;
+                }
+                row_solid += type != BLOCK_AIR;
+            }
+            if (row_solid > 0) {
+                int y = sy * CHUNK_SECTION_HEIGHT + row;
+                if (y < min_y) min_y = (uint8_t)y;
+                max_y = (uint8_t)y;
+            }
+            solid += row_solid;
+        }
+
+        section_make_uniform(s, palette[0]);
+        s->block_count = (uint16_t)solid;
+        if (palette_size > 1) {
+            int bits = 1;
+            while ((1 << bits) < palette_size) bits *= 2;
+            uint8_t* indices = (uint8_t*)storage_alloc(section_index_bytes(bits), true);
+            uint8_t* new_palette = (uint8_t*)storage_alloc(section_palette_bytes(bits), false);
+            if (!indices || !new_palette) {
+                printf("[CHUNK] Failed to allocate section arrays\n");
+                storage_free(indices, section_index_bytes(bits));
+                storage_free(new_palette, section_palette_bytes(bits));
+                s->block_count = palette[0] != BLOCK_AIR ? CHUNK_SECTION_VOLUME : 0;
+                count += s->block_count;
+                continue;
+            }
+            for (int i = 0; i < CHUNK_SECTION_VOLUME; i++) {
+                packed_write(indices, bits, i, (uint8_t)entry[in[i]]);
+            }
+            memcpy(new_palette, palette, palette_size);
+            s->indices = indices;
+            s->palette = new_palette;
+            s->palette_size = (uint16_t)palette_size;
+            s->bits = (uint8_t)bits;
+        }
+        count += s->block_count;
+    }
+
+    chunk->solid_block_count = count;
+    chunk->is_empty = (count == 0);
+    chunk->min_block_y = min_y;
+    chunk->max_block_y = max_y;
+    chunk_mark_sections_dirty(chunk, CHUNK_SECTIONS_ALL);
+    if (chunk->surface_valid) chunk_update_surface(chunk);
+    if (chunk->lod_cells) chunk->lod_stale = true;
+}
+
+void chunk_compact_storage(Chunk* chunk) {
+    if (!chunk) return;
+    chunk_ensure_warm(chunk);
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        section_compact(&chunk->sections[sy]);
+    }
+}
+
+/**
+ * Duplicate a heap array (NULL stays NULL). Returns false on OOM
+ */
+static bool dup_array(uint8_t** dst, const uint8_t* src, size_t size) {
+    *dst = NULL;
+    if (!src) return true;
+    *dst = (uint8_t*)storage_alloc(size, false);
+    if (!*dst) return false;
+    memcpy(*dst, src, size);
+    return true;
+}
+
+Chunk* chunk_snapshot(Chunk* chunk) {
+    if (!chunk) return NULL;
+    chunk_ensure_warm(chunk);
+
+    Chunk* copy = (Chunk*)storage_alloc(sizeof(Chunk), false);
+    if (!copy) {
+        printf("[CHUNK] Failed to allocate chunk snapshot\n");
+        return NULL;
+    }
+
+    // Copy scalar fields, then detach everything the snapshot must not own
+    *copy = *chunk;
+    memset(&copy->mesh, 0, sizeof(ChunkMesh));
+    memset(&copy->transparent_mesh, 0, sizeof(ChunkMesh));
+    copy->mesh_generated = false;
+    copy->transparent_mesh_generated = false;
+    copy->lod_cells = NULL;
+    copy->chests = NULL;
+    copy->dirty_next = NULL;
+    copy->in_dirty_list = false;
+    copy->remesh_pending = false;
+    copy->border = NULL;
+    copy->retired_next = NULL;
+    copy->stream_next = NULL;
+    copy->in_stream_list = false;
+    copy->spawn_next = NULL;
+    copy->in_spawn_list = false;
+    copy->water = NULL;
+    copy->water_next = NULL;
+    copy->in_water_list = false;
+    atomic_init(&copy->refs, 0);
+    atomic_init(&copy->detached, false);
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        ChunkSection* dst = &copy->sections[sy];
+        dst->indices = dst->palette = dst->light = dst->metadata = NULL;
+    }
+
+    bool ok = true;
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT && ok; sy++) {
+        const ChunkSection* src = &chunk->sections[sy];
+        ChunkSection* dst = &copy->sections[sy];
+        ok &= dup_array(&dst->indices, src->indices, section_index_bytes(src->bits));
+        ok &= dup_array(&dst->palette, src->palette, section_palette_bytes(src->bits));
+        ok &= dup_array(&dst->light, src->light, CHUNK_NIBBLE_BYTES);
+        ok &= dup_array(&dst->metadata, src->metadata, CHUNK_NIBBLE_BYTES);
+    }
+
+    if (!ok) {
+        printf("[CHUNK] Failed to copy sections for snapshot of (%d, %d)\n", chunk->x, chunk->z);
+        chunk_destroy(copy);
+        return NULL;
+    }
+    return copy;
+}
+
+size_t chunk_storage_bytes(const Chunk* chunk) {
+    if (!chunk) return 0;
+
+    size_t bytes = sizeof(Chunk);
+    if (atomic_load_explicit(&((Chunk*)chunk)->cold_data, memory_order_acquire)) bytes += chunk->cold_size;
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        const ChunkSection* s = &chunk->sections[sy];
+        if (s->indices) bytes += section_index_bytes(s->bits);
+        bytes += section_palette_bytes(s->bits);
+        if (s->light) bytes += CHUNK_NIBBLE_BYTES;
+        if (s->metadata) bytes += CHUNK_NIBBLE_BYTES;
+    }
+    return bytes;
+}
+
+// ============================================================================
+// COLD STORAGE
+// ============================================================================
+
+// Arrays present in a frozen section (one header byte per section)
+#define COLD_INDICES  0x01
+#define COLD_LIGHT    0x02
+#define COLD_METADATA 0x04
+
+#define COLD_MAX_LITERAL 128
+#define COLD_MIN_RUN 3
+#define COLD_MAX_RUN (COLD_MIN_RUN + 127)
+
+// Serializes thaws; freezing only happens while no other thread reads
+static pthread_mutex_t g_cold_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Run-length encode (PackBits style): a control byte below 128 precedes
+ * that many plus one literal bytes, one at or above it repeats the next
+ * byte control - 125 times. dst must hold size + size / 128 + 1 bytes
+ */
+static size_t cold_encode(const uint8_t* src, size_t size, uint8_t* dst) {
+    size_t in = 0, out = 0;
+    while (in < size) {
+        size_t run = 1;
+        while (in + run < size && run < COLD_MAX_RUN && src[in + run] == src[in]) run++;
+        if (run >= COLD_MIN_RUN) {
+            dst[out++] = (uint8_t)(run - COLD_MIN_RUN + 128);
+            dst[out++] = src[in];
+            in += run;
+            continue;
+        }
+
+        size_t start = in;
+        while (in < size && in - start < COLD_MAX_LITERAL) {
+            if (in + 2 < size && src[in] == src[in + 1] && src[in] == src[in + 2]) break;
+            in++;
+        }
+        dst[out++] = (uint8_t)(in - start - 1);
+        memcpy(dst + out, src + start, in - start);
+        out += in - start;
+    }
+    return out;
+}
+
+/**
+ * Decode exactly size bytes; returns the input consumed (0 = corrupt)
+ */
+static size_t cold_decode(const uint8_t* src, size_t available, uint8_t* dst, size_t size) {
+    size_t in = 0, out = 0;
+    while (out < size) {
+        if (in >= available) return 0;
+        uint8_t control = src[in++];
+        if (control >= 128) {
+            size_t run = (size_t)control - 128 + COLD_MIN_RUN;
+            if (in >= available || out + run > size) return 0;
+            memset(dst + out, src[in++], run);
+            out += run;
+        } else {
+            size_t count = (size_t)control + 1;
+            if (in + count > available || out + count > size) return 0;
+            memcpy(dst + out, src + in, count);
+            in += count;
+            out += count;
+        }
+    }
+    return in;
+}
+
+bool chunk_freeze(Chunk* chunk) {
+    if (!chunk || chunk_is_cold(chunk)) return false;
+
+    size_t raw = 0;
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        const ChunkSection* s = &chunk->sections[sy];
+        if (s->indices) raw += section_index_bytes(s->bits);
+        if (s->light) raw += CHUNK_NIBBLE_BYTES;
+        if (s->metadata) raw += CHUNK_NIBBLE_BYTES;
+    }
+    if (raw == 0) return false;  // Uniform sections hold no arrays
+
+    uint8_t* scratch = (uint8_t*)malloc(CHUNK_SECTION_COUNT + raw + raw / COLD_MAX_LITERAL + CHUNK_SECTION_COUNT * 3);
+    if (!scratch) return false;
+
+    size_t size = CHUNK_SECTION_COUNT;
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        const ChunkSection* s = &chunk->sections[sy];
+        scratch[sy] = (uint8_t)((s->indices ? COLD_INDICES : 0) | (s->light ? COLD_LIGHT : 0) |
+                                (s->metadata ? COLD_METADATA : 0));
+        if (s->indices) size += cold_encode(s->indices, section_index_bytes(s->bits), scratch + size);
+        if (s->light) size += cold_encode(s->light, CHUNK_NIBBLE_BYTES, scratch + size);
+        if (s->metadata) size += cold_encode(s->metadata, CHUNK_NIBBLE_BYTES, scratch + size);
+    }
+
+    uint8_t* cold = size < raw ? (uint8_t*)storage_alloc(size, false) : NULL;
+    if (!cold) {
+        free(scratch);
+        return false;
+    }
+    memcpy(cold, scratch, size);
+    free(scratch);
+
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        ChunkSection* s = &chunk->sections[sy];
+        storage_free(s->indices, section_index_bytes(s->bits));
+        storage_free(s->light, CHUNK_NIBBLE_BYTES);
+        storage_free(s->metadata, CHUNK_NIBBLE_BYTES);
+        s->indices = s->light = s->metadata = NULL;
+    }
+    chunk->cold_size = (uint32_t)size;
+    atomic_store_explicit(&chunk->cold_data, cold, memory_order_release);
+    return true;
+}
+
+/**
+ * Allocate and decode one array of a frozen section (NULL on failure)
+ */
+static uint8_t* cold_restore(const uint8_t* cold, size_t cold_size, size_t* offset, size_t bytes) {
+    uint8_t* array = (uint8_t*)storage_alloc(bytes, false);
+    if (!array) return NULL;
+    size_t used = cold_decode(cold + *offset, cold_size - *offset, array, bytes);
+    if (used == 0) {
+        storage_free(array, bytes);
+        return NULL;
+    }
+    *offset += used;
+    return array;
+}
+
+void chunk_thaw(Chunk* chunk) {
+    if (!chunk) return;
+
+    pthread_mutex_lock(&g_cold_mutex);
+    uint8_t* cold = atomic_load_explicit(&chunk->cold_data, memory_order_acquire);
+    if (cold) {
+        size_t offset = CHUNK_SECTION_COUNT;
+        bool ok = true;
+        for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+            ChunkSection* s = &chunk->sections[sy];
+            uint8_t present = cold[sy];
+            if (ok && (present & COLD_INDICES)) {
+                s->indices = cold_restore(cold, chunk->cold_size, &offset, section_index_bytes(s->bits));
+                ok = s->indices != NULL;
+            }
+            if (ok && (present & COLD_LIGHT)) {
+                s->light = cold_restore(cold, chunk->cold_size, &offset, CHUNK_NIBBLE_BYTES);
+                ok = s->light != NULL;
+            }
+            if (ok && (present & COLD_METADATA)) {
+                s->metadata = cold_restore(cold, chunk->cold_size, &offset, CHUNK_NIBBLE_BYTES);
+                ok = s->metadata != NULL;
+            }
+            if (!ok && s->bits && !s->indices) {
+                // Out of memory: a readable section beats a crash
+                section_make_uniform(s, s->palette[0]);
+            }
+        }
+        if (!ok) printf("[CHUNK] Failed to thaw chunk (%d, %d), blocks lost\n", chunk->x, chunk->z);
+
+        storage_free(cold, chunk->cold_size);
+        chunk->cold_size = 0;
+        chunk->cold_skip = CHUNK_COLD_THAW_SKIP;
+        atomic_store_explicit(&chunk->cold_data, NULL, memory_order_release);
+    }
+    pthread_mutex_unlock(&g_cold_mutex);
+}
+
+// ============================================================================
+// SURFACE MAP
+// ============================================================================
+
+/**
+ * Store the topmost non-air block of column (x, z) at or below top
+ * Uniform air sections are skipped whole
+ */
+static void surface_scan_column(Chunk* chunk, int x, int z, int top) {
+    int column = (z << 4) | x;
+    for (int y = top; y >= 0; y--) {
+        const ChunkSection* s = &chunk->sections[y >> 4];
+        if (s->bits == 0 && s->uniform_type == BLOCK_AIR) {
+            y &= ~(CHUNK_SECTION_HEIGHT - 1);
+            continue;
+        }
+        uint8_t type = section_get_type(s, section_local_index(x, y, z));
+        if (type != BLOCK_AIR) {
+            chunk->surface_height[column] = (uint8_t)y;
+            chunk->surface_type[column] = type;
+            return;
+        }
+    }
+    chunk->surface_height[column] = 0;
+    chunk->surface_type[column] = BLOCK_AIR;
+}
+
+/**
+ * Patch the surface map after one block changed type
+ */
+static void surface_block_changed(Chunk* chunk, int x, int y, int z, BlockType new_type) {
+    int column = (z << 4) | x;
+    int height = chunk->surface_height[column];
+    bool column_empty = chunk->surface_type[column] == BLOCK_AIR;
+
+    if (new_type != BLOCK_AIR) {
+        if (y < height && !column_empty) return;  // Buried under the surface
+        chunk->surface_height[column] = (uint8_t)y;
+        chunk->surface_type[column] = (uint8_t)new_type;
+    } else {
+        if (y != height || column_empty) return;  // Surface block untouched
+        surface_scan_column(chunk, x, z, y - 1);
+    }
+    chunk->surface_version++;
+}
+
+// ============================================================================
+// NAV HEIGHTFIELD
+// ============================================================================
+
+/**
+ * Tree canopies mobs walk under rather than on
+ */
+static bool nav_is_canopy(uint8_t type) {
+    return type == BLOCK_LEAVES || type == BLOCK_BIRCH_LEAVES ||
+           type == BLOCK_SPRUCE_LEAVES || type == BLOCK_ACACIA_LEAVES;
+}
+
+static uint8_t nav_type_at(const Chunk* chunk, int x, int y, int z) {
+    if (y >= CHUNK_HEIGHT) return BLOCK_AIR;
+    return section_get_type(&chunk->sections[y >> 4], section_local_index(x, y, z));
+}
+
+/**
+ * Find the ground of column (x, z) below its surface block
+ * Canopies and non-solid blocks are passed through; the first water or
+ * solid block is the ground, walkable if CHUNK_NAV_CLEARANCE blocks above
+ * it hold nothing solid. Returns whether the entry changed.
+ */
+static bool nav_scan_column(Chunk* chunk, int x, int z) {
+    int column = (z << 4) | x;
+    uint8_t height = 0;
+    uint8_t flags = 0;
+
+    if (chunk->surface_type[column] != BLOCK_AIR) {
+        for (int y = chunk->surface_height[column]; y >= 0; y--) {
+            uint8_t type = nav_type_at(chunk, x, y, z);
+            if (g_block_flags[type] & BLOCK_FLAG_FLUID) {
+                height = (uint8_t)(y + 1 < CHUNK_HEIGHT ? y + 1 : y);
+                flags = CHUNK_NAV_WATER;
+                break;
+            }
+            if (!(g_block_flags[type] & BLOCK_FLAG_SOLID) || nav_is_canopy(type)) continue;
+
+            if (y + CHUNK_NAV_CLEARANCE < CHUNK_HEIGHT) {
+                height = (uint8_t)(y + 1);
+                flags = CHUNK_NAV_WALK;
+                for (int k = 1; k <= CHUNK_NAV_CLEARANCE; k++) {
+                    if (g_block_flags[nav_type_at(chunk, x, y + k, z)] & BLOCK_FLAG_SOLID) {
+                        flags = 0;
+                        break;
+                    }
+                }
+            }
+            break;
+        }
+    }
+
+    if (chunk->nav_height[column] == height && chunk->nav_flags[column] == flags) return false;
+    chunk->nav_height[column] = height;
+    chunk->nav_flags[column] = flags;
+    return true;
+}
+
+/**
+ * Patch the nav entry of a column after one of its blocks changed type
+ * (the surface map is already patched)
+ */
+static void nav_block_changed(Chunk* chunk, int x, int y, int z) {
+    int column = (z << 4) | x;
+    if (chunk->nav_flags[column] != 0 && y + 1 < chunk->nav_height[column]) return;  // Under the ground
+    if (nav_scan_column(chunk, x, z)) chunk->nav_version++;
+}
+
+void chunk_update_surface(Chunk* chunk) {
+    if (!chunk) return;
+    chunk_ensure_warm(chunk);
+
+    int top = chunk->solid_block_count > 0 ? chunk->max_block_y : -1;
+    for (int z = 0; z < CHUNK_SIZE; z++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            surface_scan_column(chunk, x, z, top);
+            nav_scan_column(chunk, x, z);
+        }
+    }
+    chunk->surface_valid = true;
+    chunk->surface_version++;
+    chunk->nav_version++;
+}
+
+// ============================================================================
+// LOD CELLS
+// ============================================================================
+
+/**
+ * Merge 8 child cells into one, children ordered upper layer first
+ */
+static void lod_merge_cell(const uint8_t* types, const uint8_t* light, uint8_t* out_type, uint8_t* out_light) {
+    int solid = 0;
+    uint8_t type = BLOCK_AIR;
+    uint8_t max_light = 0;
+    for (int i = 0; i < 8; i++) {
+        // Plants and other non-solid blocks never fill a cell
+        if (types[i] != BLOCK_AIR && block_is_solid((Block){ types[i], 0, 0 })) {
+            if (solid++ == 0) type = types[i];
+        }
+        if (light[i] > max_light) max_light = light[i];
+    }
+    *out_type = solid >= CHUNK_LOD_SOLID_CHILDREN ? type : BLOCK_AIR;
+    *out_light = max_light;
+}
+
+/**
+ * Level 1 cells from the blocks; single-type sections fill their cells directly
+ */
+static void lod_build_level1(Chunk* chunk, ChunkLodCells* cells) {
+    int side = chunk_lod_side(1);
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        const ChunkSection* s = &chunk->sections[sy];
+        int row0 = sy * CHUNK_SECTION_HEIGHT / 2;
+
+        if (s->bits == 0 && !s->light) {
+            uint8_t type = s->uniform_type;
+            for (int y = row0; y < row0 + CHUNK_SECTION_HEIGHT / 2; y++) {
+                int i = chunk_lod_index(1, 0, y, 0);
+                memset(cells->types + i, type, (size_t)(side * side));
+                memset(cells->light + i, s->uniform_light, (size_t)(side * side));
+            }
+            continue;
+        }
+
+        for (int y = row0; y < row0 + CHUNK_SECTION_HEIGHT / 2; y++) {
+            for (int z = 0; z < side; z++) {
+                for (int x = 0; x < side; x++) {
+                    uint8_t types[8], light[8];
+                    int n = 0;
+                    for (int dy = 1; dy >= 0; dy--) {
+                        for (int dz = 0; dz < 2; dz++) {
+                            for (int dx = 0; dx < 2; dx++) {
+                                Block b = chunk_get_block(chunk, x * 2 + dx, y * 2 + dy, z * 2 + dz);
+                                types[n] = b.type;
+                                light[n] = b.light_level;
+                                n++;
+                            }
+                        }
+                    }
+                    int i = chunk_lod_index(1, x, y, z);
+                    lod_merge_cell(types, light, &cells->types[i], &cells->light[i]);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Cells of level (2-3) from the level below
+ */
+static void lod_build_level(ChunkLodCells* cells, int level) {
+    int side = chunk_lod_side(level);
+    for (int y = 0; y < chunk_lod_height(level); y++) {
+        for (int z = 0; z < side; z++) {
+            for (int x = 0; x < side; x++) {
+                uint8_t types[8], light[8];
+                int n = 0;
+                for (int dy = 1; dy >= 0; dy--) {
+                    for (int dz = 0; dz < 2; dz++) {
+                        for (int dx = 0; dx < 2; dx++) {
+                            int c = chunk_lod_index(level - 1, x * 2 + dx, y * 2 + dy, z * 2 + dz);
+                            types[n] = cells->types[c];
+                            light[n] = cells->light[c];
+                            n++;
+                        }
+                    }
+                }
+                int i = chunk_lod_index(level, x, y, z);
+                lod_merge_cell(types, light, &cells->types[i], &cells->light[i]);
+            }
+        }
+    }
+}
+
+void chunk_build_lod_cells(Chunk* chunk) {
+    if (!chunk) return;
+    chunk_ensure_warm(chunk);
+
+    if (!chunk->lod_cells) {
+        chunk->lod_cells = (ChunkLodCells*)storage_alloc(sizeof(ChunkLodCells), false);
+        if (!chunk->lod_cells) {
+            printf("[CHUNK] Failed to allocate LOD cells for chunk (%d, %d)\n", chunk->x, chunk->z);
+            return;
+        }
+    }
+
+    lod_build_level1(chunk, chunk->lod_cells);
+    for (int level = 2; level <= CHUNK_LOD_LEVELS; level++) {
+        lod_build_level(chunk->lod_cells, level);
+    }
+    chunk->lod_stale = false;
+    chunk->lod_version++;
+}
+
 // ============================================================================
 // CHUNK MANAGEMENT
 // ============================================================================
@@ -33,7 +990,7 @@ bool chunk_in_bounds(int x, int y, int z) {
  * Create a new chunk
  */
 Chunk* chunk_create(int x, int z) {
-    Chunk* chunk = (Chunk*)malloc(sizeof(Chunk));
+    Chunk* chunk = (Chunk*)storage_alloc(sizeof(Chunk), false);
     if (!chunk) {
         printf("[CHUNK] Failed to allocate chunk\n");
         return NULL;
@@ -45,23 +1002,60 @@ Chunk* chunk_create(int x, int z) {
     chunk->is_empty = true;
     chunk->mesh_generated = false;
     chunk->transparent_mesh_generated = false;
-    chunk->lod_generated = false;
     chunk->has_spawned = false;
+    chunk->spawn_count = 0;
+    chunk->spawn_placed = 0;
+    chunk->needs_save = false;
+    chunk->remesh_pending = false;
+    chunk->dirty_sections = CHUNK_SECTIONS_ALL;
+    memset(&chunk->mesh_ranges, 0, sizeof(ChunkMeshRanges));
+    memset(&chunk->transparent_ranges, 0, sizeof(ChunkMeshRanges));
+    memset(chunk->sort_origin, 0, sizeof(chunk->sort_origin));
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        chunk->section_visibility[sy] = SECTION_VISIBILITY_ALL;  // See-through until computed
+    }
+    chunk->border = NULL;
+    chunk->chests = NULL;
+    chunk->remote_data = NULL;
+    chunk->remote_size = 0;
+    atomic_init(&chunk->cold_data, NULL);
+    chunk->cold_size = 0;
+    chunk->cold_skip = 0;
+    chunk->remote_wait = 0;
+    chunk->remote_local = false;
     chunk->solid_block_count = 0;
-    chunk->state = CHUNK_STATE_EMPTY;
+    atomic_init(&chunk->state, CHUNK_STATE_EMPTY);
+    atomic_init(&chunk->refs, 0);
+    atomic_init(&chunk->detached, false);
     chunk->min_block_y = 255;  // No blocks yet (invalid range: min > max)
     chunk->max_block_y = 0;
+    memset(chunk->surface_height, 0, sizeof(chunk->surface_height));
+    memset(chunk->surface_type, BLOCK_AIR, sizeof(chunk->surface_type));
+    chunk->surface_valid = false;
+    chunk->surface_version = 0;
+    memset(chunk->nav_height, 0, sizeof(chunk->nav_height));
+    memset(chunk->nav_flags, 0, sizeof(chunk->nav_flags));
+    chunk->nav_version = 0;
+    chunk->lod_cells = NULL;
+    chunk->lod_version = 0;
+    chunk->lod_stale = false;
     chunk->dirty_next = NULL;
     chunk->in_dirty_list = false;
-
-    // Initialize all blocks to air
-    memset(chunk->blocks, 0, sizeof(chunk->blocks));
+    chunk->retired_next = NULL;
+    chunk->stream_next = NULL;
+    chunk->in_stream_list = false;
+    chunk->spawn_next = NULL;
+    chunk->in_spawn_list = false;
+    chunk->water = NULL;
+    chunk->water_next = NULL;
+    chunk->in_water_list = false;
+
+    // All sections start as uniform air with no light (no allocations)
+    memset(chunk->sections, 0, sizeof(chunk->sections));
 
     // Initialize meshes to zero
-    memset(&chunk->mesh, 0, sizeof(Mesh));
-    memset(&chunk->transparent_mesh, 0, sizeof(Mesh));
-    memset(&chunk->mesh_lod, 0, sizeof(Mesh));
-    memset(&chunk->transparent_mesh_lod, 0, sizeof(Mesh));
+    memset(&chunk->mesh, 0, sizeof(ChunkMesh));
+    memset(&chunk->transparent_mesh, 0, sizeof(ChunkMesh));
 
     return chunk;
 }
@@ -72,134 +1066,484 @@ Chunk* chunk_create(int x, int z) {
 void chunk_destroy(Chunk* chunk) {
     if (!chunk) return;
 
-    // Unload opaque mesh from GPU if it was generated
-    if (chunk->mesh_generated && chunk->mesh.vboId != NULL) {
-        UnloadMesh(chunk->mesh);
+    // Release GPU buffers and CPU vertex copies of all meshes
+    chunk_mesh_unload(&chunk->mesh);
+    chunk_mesh_unload(&chunk->transparent_mesh);
+    chunk_water_destroy(chunk->water);
+
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        section_free(&chunk->sections[sy]);
     }
 
-    // Unload transparent mesh from GPU if it was generated
-    if (chunk->transparent_mesh_generated && chunk->transparent_mesh.vboId != NULL) {
-        UnloadMesh(chunk->transparent_mesh);
+    uint8_t* cold = atomic_load_explicit(&chunk->cold_data, memory_order_acquire);
+    storage_free(cold, chunk->cold_size);
+    chunk_border_free(chunk->border);
+    free(chunk->remote_data);
+    storage_free(chunk->lod_cells, sizeof(ChunkLodCells));
+    chest_list_free(chunk->chests);
+    storage_free(chunk, sizeof(Chunk));
+}
+
+/**
+ * Set block at local coordinates
+ */
+void chunk_set_block(Chunk* chunk, int x, int y, int z, Block block) {
+    if (!chunk || !chunk_in_bounds(x, y, z)) {
+        return;
     }
+    chunk_ensure_warm(chunk);
+
+    ChunkSection* s = &chunk->sections[y >> 4];
+    int i = section_local_index(x, y, z);
+
+    // Get old block type for counter update
+    BlockType old_type = section_get_type(s, i);
+    BlockType new_type = block.type;
+
+    section_set_type(s, i, block.type);
+    section_set_nibble(&s->light, s->uniform_light, i, block.light_level);
+    section_set_nibble(&s->metadata, s->uniform_metadata, i, block.metadata);
+    chunk_mark_sections_dirty(chunk, chunk_section_mask_for_y(y));
 
-    // Unload LOD meshes from GPU if generated
-    if (chunk->lod_generated) {
-        if (chunk->mesh_lod.vboId != NULL) {
-            UnloadMesh(chunk->mesh_lod);
+    // Update solid block counter (O(1) instead of O(n) scan)
+    if (old_type == BLOCK_AIR && new_type != BLOCK_AIR) {
+        chunk->solid_block_count++;
+        s->block_count++;
+        // Update Y bounds when adding solid block
+        if ((uint8_t)y < chunk->min_block_y) chunk->min_block_y = (uint8_t)y;
+        if ((uint8_t)y > chunk->max_block_y) chunk->max_block_y = (uint8_t)y;
+    } else if (old_type != BLOCK_AIR && new_type == BLOCK_AIR) {
+        chunk->solid_block_count--;
+        s->block_count--;
+        // Fully dug-out section goes back to zero-storage air
+        if (s->block_count == 0) {
+            section_make_uniform(s, BLOCK_AIR);
         }
-        if (chunk->transparent_mesh_lod.vboId != NULL) {
-            UnloadMesh(chunk->transparent_mesh_lod);
+        // Note: Y bounds may become stale when removing blocks,
+        // but they're recalculated in chunk_update_empty_status()
+    }
+
+    chunk->is_empty = (chunk->solid_block_count == 0);
+
+    if (chunk->surface_valid && old_type != new_type) {
+        surface_block_changed(chunk, x, y, z, new_type);
+        nav_block_changed(chunk, x, y, z);
+    }
+    if (chunk->lod_cells) chunk->lod_stale = true;
+}
+
+/**
+ * Get block at local coordinates
+ */
+Block chunk_get_block(Chunk* chunk, int x, int y, int z) {
+    if (!chunk || !chunk_in_bounds(x, y, z)) {
+        return (Block){BLOCK_AIR, 0, 0};
+    }
+    chunk_ensure_warm(chunk);
+
+    const ChunkSection* s = &chunk->sections[y >> 4];
+    int i = section_local_index(x, y, z);
+
+    Block block;
+    block.type = section_get_type(s, i);
+    block.light_level = s->light ? nibble_read(s->light, i) : s->uniform_light;
+    block.metadata = s->metadata ? nibble_read(s->metadata, i) : s->uniform_metadata;
+    return block;
+}
+
+uint8_t chunk_get_light(Chunk* chunk, int x, int y, int z) {
+    if (!chunk || !chunk_in_bounds(x, y, z)) return 0;
+    chunk_ensure_warm(chunk);
+
+    const ChunkSection* s = &chunk->sections[y >> 4];
+    return s->light ? nibble_read(s->light, section_local_index(x, y, z)) : s->uniform_light;
+}
+
+void chunk_set_light(Chunk* chunk, int x, int y, int z, uint8_t light) {
+    if (!chunk || !chunk_in_bounds(x, y, z)) return;
+    chunk_ensure_warm(chunk);
+
+    ChunkSection* s = &chunk->sections[y >> 4];
+    int i = section_local_index(x, y, z);
+    uint8_t old = s->light ? nibble_read(s->light, i) : s->uniform_light;
+    if (old == (light & 0x0F)) return;
+
+    section_set_nibble(&s->light, s->uniform_light, i, light);
+    chunk_mark_sections_dirty(chunk, chunk_section_mask_for_y(y));
+}
+
+/**
+ * Fill chunk with specific block type
+ */
+void chunk_fill(Chunk* chunk, BlockType type) {
+    if (!chunk) return;
+    chunk_ensure_warm(chunk);
+
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        ChunkSection* s = &chunk->sections[sy];
+        section_free(s);
+        s->uniform_type = (uint8_t)type;
+        s->block_count = (type == BLOCK_AIR) ? 0 : CHUNK_SECTION_VOLUME;
+    }
+
+    // Every chest block is gone
+    chest_list_free(chunk->chests);
+    chunk->chests = NULL;
+
+    // Update counter and Y bounds based on fill type
+    if (type == BLOCK_AIR) {
+        chunk->solid_block_count = 0;
+        chunk->is_empty = true;
+        chunk->min_block_y = 255;  // Invalid range
+        chunk->max_block_y = 0;
+    } else {
+        chunk->solid_block_count = CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE;
+        chunk->is_empty = false;
+        chunk->min_block_y = 0;
+        chunk->max_block_y = CHUNK_HEIGHT - 1;
+    }
+    chunk_mark_sections_dirty(chunk, CHUNK_SECTIONS_ALL);
+}
+
+bool chunk_section_uniform(Chunk* chunk, int sy, Block* out) {
+    if (!chunk || sy < 0 || sy >= CHUNK_SECTION_COUNT) return false;
+    chunk_ensure_warm(chunk);
+
+    const ChunkSection* s = &chunk->sections[sy];
+    if (s->bits || s->light || s->metadata) return false;
+    *out = (Block){s->uniform_type, s->uniform_light, s->uniform_metadata};
+    return true;
+}
+
+void chunk_fill_section(Chunk* chunk, int sy, Block block) {
+    if (!chunk || sy < 0 || sy >= CHUNK_SECTION_COUNT) return;
+    chunk_ensure_warm(chunk);
+
+    ChunkSection* s = &chunk->sections[sy];
+    chunk->solid_block_count -= s->block_count;
+    section_free(s);
+    s->uniform_type = block.type;
+    s->uniform_light = block.light_level & 0x0F;
+    s->uniform_metadata = block.metadata & 0x0F;
+
+    if (block.type != BLOCK_AIR) {
+        int base_y = sy * CHUNK_SECTION_HEIGHT;
+        s->block_count = CHUNK_SECTION_VOLUME;
+        chunk->solid_block_count += CHUNK_SECTION_VOLUME;
+        if (base_y < chunk->min_block_y) chunk->min_block_y = (uint8_t)base_y;
+        if (base_y + CHUNK_SECTION_HEIGHT - 1 > chunk->max_block_y) {
+            chunk->max_block_y = (uint8_t)(base_y + CHUNK_SECTION_HEIGHT - 1);
+        }
+    }
+    chunk->is_empty = (chunk->solid_block_count == 0);
+
+    // The section and the ones sampling across its top and bottom faces
+    chunk_mark_sections_dirty(chunk, (uint16_t)((7u << sy) >> 1));
+    if (chunk->surface_valid) chunk_update_surface(chunk);
+    if (chunk->lod_cells) chunk->lod_stale = true;
+}
+
+/**
+ * Check if chunk is empty
+ */
+bool chunk_is_empty(Chunk* chunk) {
+    if (!chunk) return true;
+    return chunk->is_empty;
+}
+
+/**
+ * Update the is_empty flag, solid_block_count, and Y bounds by scanning the chunk
+ * Call this after bulk terrain generation
+ */
+void chunk_update_empty_status(Chunk* chunk) {
+    if (!chunk) return;
+    chunk_ensure_warm(chunk);
+
+    int count = 0;
+    uint8_t min_y = 255;  // Start with invalid range
+    uint8_t max_y = 0;
+
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        ChunkSection* s = &chunk->sections[sy];
+        int base_y = sy * CHUNK_SECTION_HEIGHT;
+        int section_count = 0;
+
+        if (s->bits == 0) {
+            // Uniform section: all or nothing
+            if (s->uniform_type != BLOCK_AIR) {
+                section_count = CHUNK_SECTION_VOLUME;
+                if (base_y < min_y) min_y = (uint8_t)base_y;
+                max_y = (uint8_t)(base_y + CHUNK_SECTION_HEIGHT - 1);
+            }
+        } else {
+            for (int i = 0; i < CHUNK_SECTION_VOLUME; i++) {
+                if (section_get_type(s, i) != BLOCK_AIR) {
+                    int y = base_y + (i >> 8);
+                    section_count++;
+                    if ((uint8_t)y < min_y) min_y = (uint8_t)y;
+                    if ((uint8_t)y > max_y) max_y = (uint8_t)y;
+                }
+            }
+        }
+
+        s->block_count = (uint16_t)section_count;
+        count += section_count;
+    }
+
+    chunk->solid_block_count = count;
+    chunk->is_empty = (count == 0);
+    chunk->min_block_y = min_y;
+    chunk->max_block_y = max_y;
+}
+
+// ============================================================================
+// SECTION VISIBILITY (Cave Culling)
+// ============================================================================
+
+/**
+ * Faces of the section boundary touched by a local cell (BlockFace bits)
+ */
+static inline uint8_t section_cell_faces(int x, int y, int z) {
+    uint8_t faces = 0;
+    if (y == CHUNK_SECTION_HEIGHT - 1) faces |= 1 << FACE_TOP;
+    if (y == 0) faces |= 1 << FACE_BOTTOM;
+    if (z == 0) faces |= 1 << FACE_FRONT;
+    if (z == CHUNK_SIZE - 1) faces |= 1 << FACE_BACK;
+    if (x == 0) faces |= 1 << FACE_LEFT;
+    if (x == CHUNK_SIZE - 1) faces |= 1 << FACE_RIGHT;
+    return faces;
+}
+
+static uint64_t connect_faces(uint8_t faces) {
+    uint64_t visibility = 0;
+    for (int a = 0; a < 6; a++) {
+        if (!(faces & (1 << a))) continue;
+        for (int b = 0; b < 6; b++) {
+            if (faces & (1 << b)) visibility |= 1ull << (a * 6 + b);
+        }
+    }
+    return visibility;
+}
+
+/**
+ * Flood fill one section; every open region links all faces it touches
+ */
+static uint64_t section_compute_visibility(const ChunkSection* s, const bool* opaque) {
+    if (s->bits == 0) {
+        return opaque[s->uniform_type] ? 0 : SECTION_VISIBILITY_ALL;
+    }
+
+    uint8_t visited[CHUNK_SECTION_VOLUME / 8];
+    uint16_t stack[CHUNK_SECTION_VOLUME];
+    memset(visited, 0, sizeof(visited));
+
+    uint64_t visibility = 0;
+    for (int start = 0; start < CHUNK_SECTION_VOLUME; start++) {
+        if (visited[start >> 3] & (1 << (start & 7))) continue;
+        visited[start >> 3] |= (uint8_t)(1 << (start & 7));
+        if (opaque[section_get_type(s, start)]) continue;
+
+        uint8_t faces = 0;
+        int top = 0;
+        stack[top++] = (uint16_t)start;
+        while (top > 0) {
+            int i = stack[--top];
+            int x = i & 15, z = (i >> 4) & 15, y = i >> 8;
+            faces |= section_cell_faces(x, y, z);
+
+            // Neighbours in BlockFace order (+Y, -Y, -Z, +Z, -X, +X)
+            int neighbours[6] = {
+                y < CHUNK_SECTION_HEIGHT - 1 ? i + 256 : -1, y > 0 ? i - 256 : -1,
+                z > 0 ? i - 16 : -1, z < CHUNK_SIZE - 1 ? i + 16 : -1,
+                x > 0 ? i - 1 : -1, x < CHUNK_SIZE - 1 ? i + 1 : -1
+            };
+            for (int n = 0; n < 6; n++) {
+                int j = neighbours[n];
+                if (j < 0 || (visited[j >> 3] & (1 << (j & 7)))) continue;
+                visited[j >> 3] |= (uint8_t)(1 << (j & 7));
+                if (!opaque[section_get_type(s, j)]) stack[top++] = (uint16_t)j;
+            }
+        }
+
+        visibility |= connect_faces(faces);
+        if (visibility == SECTION_VISIBILITY_ALL) break;
+    }
+    return visibility;
+}
+
+void chunk_compute_visibility(Chunk* chunk, uint16_t section_mask, uint64_t* out) {
+    if (!chunk || !out) return;
+    chunk_ensure_warm(chunk);
+
+    // Same opacity rule as face culling
+    bool opaque[256];
+    for (int t = 0; t < 256; t++) {
+        opaque[t] = (g_block_flags[t] & BLOCK_FLAG_OPAQUE) != 0;
+    }
+
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        if (section_mask & (1u << sy)) {
+            out[sy] = section_compute_visibility(&chunk->sections[sy], opaque);
         }
     }
-
-    free(chunk);
 }
 
-/**
- * Set block at local coordinates
- */
-void chunk_set_block(Chunk* chunk, int x, int y, int z, Block block) {
-    if (!chunk || !chunk_in_bounds(x, y, z)) {
-        return;
-    }
-
-    // Get old block type for counter update
-    BlockType old_type = chunk->blocks[x][y][z].type;
-    BlockType new_type = block.type;
+// ============================================================================
+// OCCUPANCY MASKS
+// ============================================================================
 
-    chunk->blocks[x][y][z] = block;
-    chunk->needs_remesh = true;
+#define MESH_COLUMN_WORDS (CHUNK_HEIGHT / 64)   // 64-bit words per block column
+#define MESH_PADDED (CHUNK_SIZE + 2)            // Columns per side with the neighbor ring
 
-    // Update solid block counter (O(1) instead of O(n) scan)
-    if (old_type == BLOCK_AIR && new_type != BLOCK_AIR) {
-        chunk->solid_block_count++;
-        // Update Y bounds when adding solid block
-        if ((uint8_t)y < chunk->min_block_y) chunk->min_block_y = (uint8_t)y;
-        if ((uint8_t)y > chunk->max_block_y) chunk->max_block_y = (uint8_t)y;
-    } else if (old_type != BLOCK_AIR && new_type == BLOCK_AIR) {
-        chunk->solid_block_count--;
-        // Note: Y bounds may become stale when removing blocks,
-        // but they're recalculated in chunk_update_empty_status()
-    }
+_Static_assert(CHUNK_HEIGHT % 64 == 0 && 64 % CHUNK_SECTION_HEIGHT == 0,
+               "Sections must not straddle occupancy words");
 
-    chunk->is_empty = (chunk->solid_block_count == 0);
-}
+#define MESH_BIT_OPAQUE 0x01                    // Hides the faces next to it, occludes AO
+#define MESH_BIT_SOLID 0x02                     // Has faces in the opaque pass
+#define MESH_BIT_TRANSPARENT 0x04               // Has faces in the transparent pass
 
 /**
- * Get block at local coordinates
+ * Bit columns of a chunk for meshing, built once per mesh job: bit y of
+ * word y / 64 covers block y. The opaque columns include the one-block
+ * neighbor ring (from chunk->border), so face culling is an AND of a
+ * column with its neighbor's (or its own shifted by one for up and down)
+ * and AO reads single bits instead of decoding blocks
  */
-Block chunk_get_block(Chunk* chunk, int x, int y, int z) {
-    if (!chunk || !chunk_in_bounds(x, y, z)) {
-        return (Block){BLOCK_AIR, 0, 0};
+typedef struct MeshOccupancy {
+    uint64_t opaque[MESH_PADDED][MESH_PADDED][MESH_COLUMN_WORDS];   // [z + 1][x + 1]
+    uint64_t drawn[2][CHUNK_SIZE][CHUNK_SIZE][MESH_COLUMN_WORDS];   // [transparent pass][z][x]
+} MeshOccupancy;
+
+static inline uint8_t mesh_type_bits(uint8_t type) {
+    Block block = {type, 0, 0};
+    uint8_t bits = block_is_opaque(block) ? MESH_BIT_OPAQUE : 0;
+    if (block_is_solid(block)) {
+        bits |= block_is_transparent(block) ? MESH_BIT_TRANSPARENT : MESH_BIT_SOLID;
     }
+    return bits;
+}
 
-    return chunk->blocks[x][y][z];
+static inline void mesh_occupancy_set(MeshOccupancy* occ, int x, int z, int word, uint64_t run, uint8_t bits) {
+    if (bits & MESH_BIT_OPAQUE) occ->opaque[z + 1][x + 1][word] |= run;
+    if (bits & MESH_BIT_SOLID) occ->drawn[0][z][x][word] |= run;
+    if (bits & MESH_BIT_TRANSPARENT) occ->drawn[1][z][x][word] |= run;
 }
 
 /**
- * Fill chunk with specific block type
+ * Fill the occupancy of the sections in section_mask and the sections
+ * either side of them (faces and AO look one block up and down). Palette
+ * entries are classified once; uniform sections set whole runs
  */
-void chunk_fill(Chunk* chunk, BlockType type) {
-    if (!chunk) return;
+static void mesh_occupancy_build(const Chunk* chunk, uint16_t section_mask, MeshOccupancy* occ) {
+    memset(occ, 0, sizeof(MeshOccupancy));
+    uint16_t build = (uint16_t)(section_mask | (section_mask << 1) | (section_mask >> 1));
+
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        if (!(build & (1u << sy))) continue;
+
+        const ChunkSection* s = &chunk->sections[sy];
+        int y0 = sy * CHUNK_SECTION_HEIGHT;
+        int word = y0 >> 6;
+        int shift = y0 & 63;
+
+        // Neighbor ring; without a border it reads as air
+        for (int y = y0; chunk->border && y < y0 + CHUNK_SECTION_HEIGHT; y++) {
+            uint64_t bit = (uint64_t)1 << (y & 63);
+            for (int z = -1; z <= CHUNK_SIZE; z++) {
+                int step = (z < 0 || z == CHUNK_SIZE) ? 1 : CHUNK_SIZE + 1;  // Inner rows: both ends only
+                for (int x = -1; x <= CHUNK_SIZE; x += step) {
+                    uint8_t type = chunk->border->types[y][chunk_border_index(x, z)];
+                    if (mesh_type_bits(type) & MESH_BIT_OPAQUE) occ->opaque[z + 1][x + 1][word] |= bit;
+                }
+            }
+        }
 
-    for (int x = 0; x < CHUNK_SIZE; x++) {
-        for (int y = 0; y < CHUNK_HEIGHT; y++) {
+        if (s->bits == 0) {
+            uint8_t bits = mesh_type_bits(s->uniform_type);
+            if (!bits) continue;
+            uint64_t run = (((uint64_t)1 << CHUNK_SECTION_HEIGHT) - 1) << shift;
             for (int z = 0; z < CHUNK_SIZE; z++) {
-                chunk->blocks[x][y][z].type = type;
+                for (int x = 0; x < CHUNK_SIZE; x++) mesh_occupancy_set(occ, x, z, word, run, bits);
             }
+            continue;
         }
-    }
 
-    // Update counter and Y bounds based on fill type
-    if (type == BLOCK_AIR) {
-        chunk->solid_block_count = 0;
-        chunk->is_empty = true;
-        chunk->min_block_y = 255;  // Invalid range
-        chunk->max_block_y = 0;
-    } else {
-        chunk->solid_block_count = CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE;
-        chunk->is_empty = false;
-        chunk->min_block_y = 0;
-        chunk->max_block_y = CHUNK_HEIGHT - 1;
+        uint8_t palette_bits[256];
+        for (int p = 0; p < s->palette_size; p++) palette_bits[p] = mesh_type_bits(s->palette[p]);
+
+        int i = 0;  // section_local_index order: y, then z, then x
+        for (int y = 0; y < CHUNK_SECTION_HEIGHT; y++) {
+            uint64_t bit = (uint64_t)1 << (shift + y);
+            for (int z = 0; z < CHUNK_SIZE; z++) {
+                for (int x = 0; x < CHUNK_SIZE; x++, i++) {
+                    uint8_t bits = palette_bits[packed_read(s->indices, s->bits, i)];
+                    if (bits) mesh_occupancy_set(occ, x, z, word, bit, bits);
+                }
+            }
+        }
     }
-    chunk->needs_remesh = true;
 }
 
 /**
- * Check if chunk is empty
+ * Whether the block at local coordinates up to one block outside the chunk is opaque
  */
-bool chunk_is_empty(Chunk* chunk) {
-    if (!chunk) return true;
-    return chunk->is_empty;
+static inline bool mesh_opaque_at(const MeshOccupancy* occ, int x, int y, int z) {
+    if (y < 0 || y >= CHUNK_HEIGHT || x < -1 || x > CHUNK_SIZE || z < -1 || z > CHUNK_SIZE) return false;
+    return (occ->opaque[z + 1][x + 1][y >> 6] >> (y & 63)) & 1;
 }
 
 /**
- * Update the is_empty flag, solid_block_count, and Y bounds by scanning the chunk
- * Call this after bulk terrain generation
+ * Visible faces of one section's blocks in a pass: faces[face][z][x] has
+ * bit y - section_y0 set when block (x, y, z) is drawn in the pass and its
+ * neighbor on that side is not opaque (BlockFace order)
+ * Returns false when no face is visible (a section enclosed in solid blocks)
  */
-void chunk_update_empty_status(Chunk* chunk) {
-    if (!chunk) return;
-
-    int count = 0;
-    uint8_t min_y = 255;  // Start with invalid range
-    uint8_t max_y = 0;
-
-    for (int x = 0; x < CHUNK_SIZE; x++) {
-        for (int y = 0; y < CHUNK_HEIGHT; y++) {
-            for (int z = 0; z < CHUNK_SIZE; z++) {
-                if (chunk->blocks[x][y][z].type != BLOCK_AIR) {
-                    count++;
-                    if ((uint8_t)y < min_y) min_y = (uint8_t)y;
-                    if ((uint8_t)y > max_y) max_y = (uint8_t)y;
-                }
+static bool mesh_section_faces(const MeshOccupancy* occ, bool transparent_pass, int sy,
+                               uint16_t faces[6][CHUNK_SIZE][CHUNK_SIZE]) {
+    int y0 = sy * CHUNK_SECTION_HEIGHT;
+    int word = y0 >> 6;
+    int shift = y0 & 63;
+    unsigned visible = 0;
+
+    for (int z = 0; z < CHUNK_SIZE; z++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            uint64_t drawn = occ->drawn[transparent_pass][z][x][word];
+            if (!((drawn >> shift) & 0xFFFF)) {
+                for (int f = 0; f < 6; f++) faces[f][z][x] = 0;
+                continue;
             }
+
+            // Up and down carry across words; past the chunk is air
+            const uint64_t* self = occ->opaque[z + 1][x + 1];
+            uint64_t above = (self[word] >> 1) | (word + 1 < MESH_COLUMN_WORDS ? self[word + 1] << 63 : 0);
+            uint64_t below = (self[word] << 1) | (word > 0 ? self[word - 1] >> 63 : 0);
+
+            faces[FACE_TOP][z][x] = (uint16_t)((drawn & ~above) >> shift);
+            faces[FACE_BOTTOM][z][x] = (uint16_t)((drawn & ~below) >> shift);
+            faces[FACE_FRONT][z][x] = (uint16_t)((drawn & ~occ->opaque[z][x + 1][word]) >> shift);
+            faces[FACE_BACK][z][x] = (uint16_t)((drawn & ~occ->opaque[z + 2][x + 1][word]) >> shift);
+            faces[FACE_LEFT][z][x] = (uint16_t)((drawn & ~occ->opaque[z + 1][x][word]) >> shift);
+            faces[FACE_RIGHT][z][x] = (uint16_t)((drawn & ~occ->opaque[z + 1][x + 2][word]) >> shift);
+            for (int f = 0; f < 6; f++) visible |= faces[f][z][x];
         }
     }
+    return visible != 0;
+}
 
-    chunk->solid_block_count = count;
-    chunk->is_empty = (count == 0);
-    chunk->min_block_y = min_y;
-    chunk->max_block_y = max_y;
+/**
+ * Occupancy of the sections in section_mask, in the thread's mesh arena
+ * (malloc without one, release with mesh_occupancy_release). NULL on OOM
+ */
+static MeshOccupancy* mesh_occupancy_acquire(const Chunk* chunk, uint16_t section_mask) {
+    MeshArena* arena = mesh_arena_current();
+    MeshOccupancy* occ = arena ? (MeshOccupancy*)mesh_arena_scratch(arena, MESH_SCRATCH_OCCUPANCY, sizeof(MeshOccupancy))
+                               : (MeshOccupancy*)malloc(sizeof(MeshOccupancy));
+    if (occ) mesh_occupancy_build(chunk, section_mask, occ);
+    return occ;
+}
+
+static void mesh_occupancy_release(MeshOccupancy* occ) {
+    if (!mesh_arena_current()) free(occ);
 }
 
 // ============================================================================
@@ -207,44 +1551,42 @@ void chunk_update_empty_status(Chunk* chunk) {
 // ============================================================================
 
 /**
- * Check if there's a solid block at position (used for face culling and AO)
+ * Block at local coordinates up to one block outside the chunk
+ * Horizontal neighbors come from chunk->border; without one they are air
  */
-static bool has_solid_block_at(Chunk* chunk, int x, int y, int z) {
-    if (!chunk_in_bounds(x, y, z)) {
-        return false;  // Out of bounds = air
+static Block mesh_get_block(Chunk* chunk, int x, int y, int z) {
+    if (y < 0 || y >= CHUNK_HEIGHT) return (Block){BLOCK_AIR, 0, 0};
+    if (x >= 0 && x < CHUNK_SIZE && z >= 0 && z < CHUNK_SIZE) {
+        return chunk_get_block(chunk, x, y, z);
     }
-
-    Block block = chunk_get_block(chunk, x, y, z);
-    return block_is_solid(block) && !block_is_transparent(block);
+    if (!chunk->border || x < -1 || x > CHUNK_SIZE || z < -1 || z > CHUNK_SIZE) {
+        return (Block){BLOCK_AIR, 0, 0};
+    }
+    int cell = chunk_border_index(x, z);
+    return (Block){chunk->border->types[y][cell], chunk->border->light[y][cell], 0};
 }
 
 /**
- * Calculate ambient occlusion for a single vertex.
+ * Calculate ambient occlusion level for a single vertex.
  * Checks the 3 blocks adjacent to the vertex corner (2 sides + 1 corner).
- * Returns a brightness multiplier (0.3 to 1.0).
+ * Returns 0 (full occlusion) to 3 (no occlusion).
  */
-static float calculate_vertex_ao(Chunk* chunk, int bx, int by, int bz,
-                                  int side1_dx, int side1_dy, int side1_dz,
-                                  int side2_dx, int side2_dy, int side2_dz) {
+static int calculate_vertex_ao_level(const MeshOccupancy* occ, int bx, int by, int bz,
+                                     int side1_dx, int side1_dy, int side1_dz,
+                                     int side2_dx, int side2_dy, int side2_dz) {
     // Check if the two side blocks and corner block are solid
-    bool side1 = has_solid_block_at(chunk, bx + side1_dx, by + side1_dy, bz + side1_dz);
-    bool side2 = has_solid_block_at(chunk, bx + side2_dx, by + side2_dy, bz + side2_dz);
-    bool corner = has_solid_block_at(chunk,
+    bool side1 = mesh_opaque_at(occ, bx + side1_dx, by + side1_dy, bz + side1_dz);
+    bool side2 = mesh_opaque_at(occ, bx + side2_dx, by + side2_dy, bz + side2_dz);
+    bool corner = mesh_opaque_at(occ,
         bx + side1_dx + side2_dx,
         by + side1_dy + side2_dy,
         bz + side1_dz + side2_dz);
 
     // Calculate AO level (0 = full occlusion, 3 = no occlusion)
-    int ao_level;
     if (side1 && side2) {
-        ao_level = 0;  // Both sides solid = maximum occlusion
-    } else {
-        ao_level = 3 - (side1 + side2 + corner);
+        return 0;  // Both sides solid = maximum occlusion
     }
-
-    // Convert to brightness multiplier
-    static const float ao_values[] = {0.4f, 0.6f, 0.8f, 1.0f};
-    return ao_values[ao_level];
+    return 3 - (side1 + side2 + corner);
 }
 
 /**
@@ -260,100 +1602,26 @@ static BlockFace get_face_from_normal(Vector3 normal) {
 }
 
 /**
- * Calculate lighting brightness based on face normal
- */
-static float calculate_face_brightness(Vector3 normal) {
-    // Simple directional lighting - brighter values for better visibility
-    // All faces should be clearly visible, not black
-
-    if (normal.y > 0.5f) return 1.0f;      // Top - full brightness
-    if (normal.y < -0.5f) return 0.8f;     // Bottom - much brighter now
-
-    // Side faces - all very bright
-    if (normal.x > 0.5f) return 0.95f;     // Right (+X)
-    if (normal.x < -0.5f) return 0.95f;    // Left (-X)
-    if (normal.z > 0.5f) return 0.9f;      // Back (+Z)
-    if (normal.z < -0.5f) return 0.9f;     // Front (-Z)
-
-    return 0.9f;  // Fallback
-}
-
-/**
- * Add a quad face to the mesh buffers with per-vertex ambient occlusion
- * ao1-ao4 are ambient occlusion values for each vertex (0.0-1.0)
+ * Add a quad face to the mesh buffer with per-vertex ambient occlusion
+ * ao1-ao4 are AO levels for each vertex (0 = full occlusion, 3 = none);
+ * face shading, light falloff and AO are applied in block.vs
  */
-static void add_quad(float* vertices, float* texcoords, float* normals, unsigned char* colors, int* vertex_count,
+static void add_quad(ChunkVertex* vertices, int* vertex_count,
                      Vector3 v1, Vector3 v2, Vector3 v3, Vector3 v4, Vector3 normal,
-                     BlockType block_type, float width, float height, uint8_t block_light_level,
-                     float ao1, float ao2, float ao3, float ao4) {
-    (void)width;  // Unused but kept for API compatibility
-    (void)height;
-
-    int idx = *vertex_count;
-
-    // Get face type from normal
+                     BlockType block_type, uint8_t block_light_level,
+                     int ao1, int ao2, int ao3, int ao4) {
     BlockFace face = get_face_from_normal(normal);
+    AtlasTile tile = texture_atlas_get_tile(block_type, face);
 
-    // Get texture coordinates from atlas
-    TextureCoords tex = texture_atlas_get_coords(block_type, face);
-
-    // Calculate face brightness based on normal direction
-    float face_brightness = calculate_face_brightness(normal);
-
-    // Apply block's light level (0-15 -> 0.0-1.0)
-    float light_factor = (float)block_light_level / 15.0f;
-
-    // Minimum ambient so caves aren't pitch black (10% ambient)
-    float min_ambient = 0.10f;
-    light_factor = min_ambient + light_factor * (1.0f - min_ambient);
-
-    // Base brightness combines face direction and block light level
-    float base_brightness = face_brightness * light_factor;
-
-    // Per-vertex brightness with AO applied
-    unsigned char light1 = (unsigned char)(base_brightness * ao1 * 255.0f);
-    unsigned char light2 = (unsigned char)(base_brightness * ao2 * 255.0f);
-    unsigned char light3 = (unsigned char)(base_brightness * ao3 * 255.0f);
-    unsigned char light4 = (unsigned char)(base_brightness * ao4 * 255.0f);
-
-    // Triangle 1 (v1, v2, v3)
-    vertices[idx * 3 + 0] = v1.x; vertices[idx * 3 + 1] = v1.y; vertices[idx * 3 + 2] = v1.z;
-    texcoords[idx * 2 + 0] = tex.u_min; texcoords[idx * 2 + 1] = tex.v_min;
-    normals[idx * 3 + 0] = normal.x; normals[idx * 3 + 1] = normal.y; normals[idx * 3 + 2] = normal.z;
-    colors[idx * 4 + 0] = light1; colors[idx * 4 + 1] = light1; colors[idx * 4 + 2] = light1; colors[idx * 4 + 3] = 255;
-    idx++;
-
-    vertices[idx * 3 + 0] = v2.x; vertices[idx * 3 + 1] = v2.y; vertices[idx * 3 + 2] = v2.z;
-    texcoords[idx * 2 + 0] = tex.u_max; texcoords[idx * 2 + 1] = tex.v_min;
-    normals[idx * 3 + 0] = normal.x; normals[idx * 3 + 1] = normal.y; normals[idx * 3 + 2] = normal.z;
-    colors[idx * 4 + 0] = light2; colors[idx * 4 + 1] = light2; colors[idx * 4 + 2] = light2; colors[idx * 4 + 3] = 255;
-    idx++;
-
-    vertices[idx * 3 + 0] = v3.x; vertices[idx * 3 + 1] = v3.y; vertices[idx * 3 + 2] = v3.z;
-    texcoords[idx * 2 + 0] = tex.u_max; texcoords[idx * 2 + 1] = tex.v_max;
-    normals[idx * 3 + 0] = normal.x; normals[idx * 3 + 1] = normal.y; normals[idx * 3 + 2] = normal.z;
-    colors[idx * 4 + 0] = light3; colors[idx * 4 + 1] = light3; colors[idx * 4 + 2] = light3; colors[idx * 4 + 3] = 255;
-    idx++;
-
-    // Triangle 2 (v1, v3, v4)
-    vertices[idx * 3 + 0] = v1.x; vertices[idx * 3 + 1] = v1.y; vertices[idx * 3 + 2] = v1.z;
-    texcoords[idx * 2 + 0] = tex.u_min; texcoords[idx * 2 + 1] = tex.v_min;
-    normals[idx * 3 + 0] = normal.x; normals[idx * 3 + 1] = normal.y; normals[idx * 3 + 2] = normal.z;
-    colors[idx * 4 + 0] = light1; colors[idx * 4 + 1] = light1; colors[idx * 4 + 2] = light1; colors[idx * 4 + 3] = 255;
-    idx++;
-
-    vertices[idx * 3 + 0] = v3.x; vertices[idx * 3 + 1] = v3.y; vertices[idx * 3 + 2] = v3.z;
-    texcoords[idx * 2 + 0] = tex.u_max; texcoords[idx * 2 + 1] = tex.v_max;
-    normals[idx * 3 + 0] = normal.x; normals[idx * 3 + 1] = normal.y; normals[idx * 3 + 2] = normal.z;
-    colors[idx * 4 + 0] = light3; colors[idx * 4 + 1] = light3; colors[idx * 4 + 2] = light3; colors[idx * 4 + 3] = 255;
-    idx++;
-
-    vertices[idx * 3 + 0] = v4.x; vertices[idx * 3 + 1] = v4.y; vertices[idx * 3 + 2] = v4.z;
-    texcoords[idx * 2 + 0] = tex.u_min; texcoords[idx * 2 + 1] = tex.v_max;
-    normals[idx * 3 + 0] = normal.x; normals[idx * 3 + 1] = normal.y; normals[idx * 3 + 2] = normal.z;
-    colors[idx * 4 + 0] = light4; colors[idx * 4 + 1] = light4; colors[idx * 4 + 2] = light4; colors[idx * 4 + 3] = 255;
-    idx++;
+    const Vector3 corners[4] = {v1, v2, v3, v4};
+    const int ao[4] = {ao1, ao2, ao3, ao4};
 
+    // Corners only; the shared quad index buffer forms (v1, v2, v3), (v1, v3, v4)
+    int idx = *vertex_count;
+    for (int c = 0; c < CHUNK_QUAD_VERTICES; c++) {
+        vertices[idx++] = chunk_vertex_pack((int)corners[c].x, (int)corners[c].y, (int)corners[c].z,
+                                            face, tile, block_light_level, (uint8_t)ao[c]);
+    }
     *vertex_count = idx;
 }
 
@@ -377,9 +1645,9 @@ static uint8_t get_block_light(Chunk* chunk, int x, int y, int z) {
         int ny = y + offsets[i][1];
         int nz = z + offsets[i][2];
 
-        // Handle chunk boundaries - assume some light at edges
-        if (nx < 0 || nx >= CHUNK_SIZE || nz < 0 || nz >= CHUNK_SIZE) {
-            // At chunk edge, assume moderate light
+        // Without neighbor data, assume moderate light at chunk edges
+        bool outside = nx < 0 || nx >= CHUNK_SIZE || nz < 0 || nz >= CHUNK_SIZE;
+        if (outside && !chunk->border) {
             if (max_light < 8) max_light = 8;
             continue;
         }
@@ -390,8 +1658,8 @@ static uint8_t get_block_light(Chunk* chunk, int x, int y, int z) {
             continue;
         }
 
-        Block neighbor = chunk->blocks[nx][ny][nz];
-        if (neighbor.type == BLOCK_AIR || block_is_transparent(neighbor)) {
+        Block neighbor = mesh_get_block(chunk, nx, ny, nz);
+        if (block_type_passes_light(neighbor.type)) {
             if (neighbor.light_level > max_light) {
                 max_light = neighbor.light_level;
             }
@@ -409,411 +1677,623 @@ static uint8_t get_block_light(Chunk* chunk, int x, int y, int z) {
 /**
  * Simple meshing algorithm - each block face is independent (Luanti-style)
  * Does not merge adjacent faces, rendering each block separately
+ * Only sections in section_mask are meshed; section_start (CHUNK_SECTION_COUNT + 1
+ * entries) receives the vertex range of every section, empty for skipped ones
  */
-static void chunk_generate_mesh_simple(Chunk* chunk, float** vertices, float** texcoords,
-                                       float** normals, unsigned char** colors, int* vertex_count,
-                                       bool transparent_pass) {
+static void chunk_generate_mesh_simple(Chunk* chunk, const MeshOccupancy* occ, ChunkVertex* vertices,
+                                       int* vertex_count, bool transparent_pass, uint16_t section_mask,
+                                       int* section_start) {
     *vertex_count = 0;
 
-    // Use Y bounds to skip empty regions (optimization)
-    // Add 1 block margin to handle face culling at boundaries
-    int y_start = (chunk->min_block_y > 0) ? chunk->min_block_y - 1 : 0;
-    int y_end = (chunk->max_block_y < CHUNK_HEIGHT - 1) ? chunk->max_block_y + 2 : CHUNK_HEIGHT;
+    uint16_t faces[6][CHUNK_SIZE][CHUNK_SIZE];
+
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        section_start[sy] = *vertex_count;
+        if (!(section_mask & (1u << sy))) continue;
+        if (chunk->sections[sy].block_count == 0) continue;  // Faces belong to solid blocks
+
+        int section_y0 = sy * CHUNK_SECTION_HEIGHT;
+        if (!mesh_section_faces(occ, transparent_pass, sy, faces)) continue;
 
-    // Iterate through blocks in the relevant Y range only
-    for (int y = y_start; y < y_end; y++) {
         for (int z = 0; z < CHUNK_SIZE; z++) {
             for (int x = 0; x < CHUNK_SIZE; x++) {
-                Block block = chunk_get_block(chunk, x, y, z);
+                // Only blocks of this pass with a visible face have bits set
+                unsigned visible = 0;
+                for (int f = 0; f < 6; f++) visible |= faces[f][z][x];
+
+                while (visible) {
+                    int bit = __builtin_ctz(visible);
+                    visible &= visible - 1;
+                    int y = section_y0 + bit;
+                    Block block = chunk_get_block(chunk, x, y, z);
+
+                    // Local position of this block within the chunk
+                    // (chunk offset will be applied via transform matrix during rendering)
+                    float wx = (float)x;
+                    float wy = (float)y;
+                    float wz = (float)z;
+
+                    // Get consistent light for this block (same for all faces)
+                    uint8_t block_light = get_block_light(chunk, x, y, z);
+
+                    // Only render faces adjacent to air/transparent blocks (culling)
+                    // For transparent blocks like leaves, we can see through them so render adjacent faces
+
+                    // Face: Top (+Y) - render if neighbor is air or transparent
+                    if (faces[FACE_TOP][z][x] & (1u << bit)) {
+                        Vector3 v1 = {wx, wy + 1, wz};
+                        Vector3 v2 = {wx + 1, wy + 1, wz};
+                        Vector3 v3 = {wx + 1, wy + 1, wz + 1};
+                        Vector3 v4 = {wx, wy + 1, wz + 1};
+                        Vector3 normal = {0, 1, 0};
+                        // Calculate AO for top face vertices (y+1 plane)
+                        int ao1 = calculate_vertex_ao_level(occ, x, y+1, z, -1,0,0, 0,0,-1);  // v1: corner (-X, -Z)
+                        int ao2 = calculate_vertex_ao_level(occ, x, y+1, z, 1,0,0, 0,0,-1);   // v2: corner (+X, -Z)
+                        int ao3 = calculate_vertex_ao_level(occ, x, y+1, z, 1,0,0, 0,0,1);    // v3: corner (+X, +Z)
+                        int ao4 = calculate_vertex_ao_level(occ, x, y+1, z, -1,0,0, 0,0,1);   // v4: corner (-X, +Z)
+                        add_quad(vertices, vertex_count,
+                                v1, v2, v3, v4, normal, block.type, block_light, ao1, ao2, ao3, ao4);
+                    }
 
-                // Skip air blocks
-                if (!block_is_solid(block)) {
-                    continue;
-                }
+                    // Face: Bottom (-Y) - render if neighbor is air or transparent
+                    if (faces[FACE_BOTTOM][z][x] & (1u << bit)) {
+                        Vector3 v1 = {wx, wy, wz + 1};
+                        Vector3 v2 = {wx + 1, wy, wz + 1};
+                        Vector3 v3 = {wx + 1, wy, wz};
+                        Vector3 v4 = {wx, wy, wz};
+                        Vector3 normal = {0, -1, 0};
+                        // Calculate AO for bottom face vertices (y-1 plane)
+                        int ao1 = calculate_vertex_ao_level(occ, x, y-1, z, -1,0,0, 0,0,1);   // v1: corner (-X, +Z)
+                        int ao2 = calculate_vertex_ao_level(occ, x, y-1, z, 1,0,0, 0,0,1);    // v2: corner (+X, +Z)
+                        int ao3 = calculate_vertex_ao_level(occ, x, y-1, z, 1,0,0, 0,0,-1);   // v3: corner (+X, -Z)
+                        int ao4 = calculate_vertex_ao_level(occ, x, y-1, z, -1,0,0, 0,0,-1);  // v4: corner (-X, -Z)
+                        add_quad(vertices, vertex_count,
+                                v1, v2, v3, v4, normal, block.type, block_light, ao1, ao2, ao3, ao4);
+                    }
 
-                // Two-pass rendering: separate opaque and transparent blocks
-                bool is_transparent = block_is_transparent(block);
-                if (transparent_pass != is_transparent) {
-                    continue;  // Skip blocks not matching this pass
-                }
+                    // Face: Front (-Z) - render if neighbor is air or transparent
+                    if (faces[FACE_FRONT][z][x] & (1u << bit)) {
+                        Vector3 v1 = {wx, wy, wz};
+                        Vector3 v2 = {wx + 1, wy, wz};
+                        Vector3 v3 = {wx + 1, wy + 1, wz};
+                        Vector3 v4 = {wx, wy + 1, wz};
+                        Vector3 normal = {0, 0, -1};
+                        // Calculate AO for front face vertices (z-1 plane)
+                        int ao1 = calculate_vertex_ao_level(occ, x, y, z-1, -1,0,0, 0,-1,0);  // v1: corner (-X, -Y)
+                        int ao2 = calculate_vertex_ao_level(occ, x, y, z-1, 1,0,0, 0,-1,0);   // v2: corner (+X, -Y)
+                        int ao3 = calculate_vertex_ao_level(occ, x, y, z-1, 1,0,0, 0,1,0);    // v3: corner (+X, +Y)
+                        int ao4 = calculate_vertex_ao_level(occ, x, y, z-1, -1,0,0, 0,1,0);   // v4: corner (-X, +Y)
+                        add_quad(vertices, vertex_count,
+                                v1, v2, v3, v4, normal, block.type, block_light, ao1, ao2, ao3, ao4);
+                    }
 
-                // Local position of this block within the chunk
-                // (chunk offset will be applied via transform matrix during rendering)
-                float wx = (float)x;
-                float wy = (float)y;
-                float wz = (float)z;
-
-                // Get consistent light for this block (same for all faces)
-                uint8_t block_light = get_block_light(chunk, x, y, z);
-
-                // Only render faces adjacent to air/transparent blocks (culling)
-                // For transparent blocks like leaves, we can see through them so render adjacent faces
-
-                // Face: Top (+Y) - render if neighbor is air or transparent
-                Block neighbor_top = (y + 1 < CHUNK_HEIGHT) ? chunk_get_block(chunk, x, y + 1, z) : (Block){BLOCK_AIR, 0, 0};
-                if (!block_is_solid(neighbor_top) || block_is_transparent(neighbor_top)) {
-                    Vector3 v1 = {wx, wy + 1, wz};
-                    Vector3 v2 = {wx + 1, wy + 1, wz};
-                    Vector3 v3 = {wx + 1, wy + 1, wz + 1};
-                    Vector3 v4 = {wx, wy + 1, wz + 1};
-                    Vector3 normal = {0, 1, 0};
-                    // Calculate AO for top face vertices (y+1 plane)
-                    float ao1 = calculate_vertex_ao(chunk, x, y+1, z, -1,0,0, 0,0,-1);  // v1: corner (-X, -Z)
-                    float ao2 = calculate_vertex_ao(chunk, x, y+1, z, 1,0,0, 0,0,-1);   // v2: corner (+X, -Z)
-                    float ao3 = calculate_vertex_ao(chunk, x, y+1, z, 1,0,0, 0,0,1);    // v3: corner (+X, +Z)
-                    float ao4 = calculate_vertex_ao(chunk, x, y+1, z, -1,0,0, 0,0,1);   // v4: corner (-X, +Z)
-                    add_quad(*vertices, *texcoords, *normals, *colors, vertex_count,
-                            v1, v2, v3, v4, normal, block.type, 1, 1, block_light, ao1, ao2, ao3, ao4);
-                }
+                    // Face: Back (+Z) - render if neighbor is air or transparent
+                    if (faces[FACE_BACK][z][x] & (1u << bit)) {
+                        Vector3 v1 = {wx + 1, wy, wz + 1};
+                        Vector3 v2 = {wx, wy, wz + 1};
+                        Vector3 v3 = {wx, wy + 1, wz + 1};
+                        Vector3 v4 = {wx + 1, wy + 1, wz + 1};
+                        Vector3 normal = {0, 0, 1};
+                        // Calculate AO for back face vertices (z+1 plane)
+                        int ao1 = calculate_vertex_ao_level(occ, x, y, z+1, 1,0,0, 0,-1,0);   // v1: corner (+X, -Y)
+                        int ao2 = calculate_vertex_ao_level(occ, x, y, z+1, -1,0,0, 0,-1,0);  // v2: corner (-X, -Y)
+                        int ao3 = calculate_vertex_ao_level(occ, x, y, z+1, -1,0,0, 0,1,0);   // v3: corner (-X, +Y)
+                        int ao4 = calculate_vertex_ao_level(occ, x, y, z+1, 1,0,0, 0,1,0);    // v4: corner (+X, +Y)
+                        add_quad(vertices, vertex_count,
+                                v1, v2, v3, v4, normal, block.type, block_light, ao1, ao2, ao3, ao4);
+                    }
 
-                // Face: Bottom (-Y) - render if neighbor is air or transparent
-                Block neighbor_bottom = (y - 1 >= 0) ? chunk_get_block(chunk, x, y - 1, z) : (Block){BLOCK_AIR, 0, 0};
-                if (!block_is_solid(neighbor_bottom) || block_is_transparent(neighbor_bottom)) {
-                    Vector3 v1 = {wx, wy, wz + 1};
-                    Vector3 v2 = {wx + 1, wy, wz + 1};
-                    Vector3 v3 = {wx + 1, wy, wz};
-                    Vector3 v4 = {wx, wy, wz};
-                    Vector3 normal = {0, -1, 0};
-                    // Calculate AO for bottom face vertices (y-1 plane)
-                    float ao1 = calculate_vertex_ao(chunk, x, y-1, z, -1,0,0, 0,0,1);   // v1: corner (-X, +Z)
-                    float ao2 = calculate_vertex_ao(chunk, x, y-1, z, 1,0,0, 0,0,1);    // v2: corner (+X, +Z)
-                    float ao3 = calculate_vertex_ao(chunk, x, y-1, z, 1,0,0, 0,0,-1);   // v3: corner (+X, -Z)
-                    float ao4 = calculate_vertex_ao(chunk, x, y-1, z, -1,0,0, 0,0,-1);  // v4: corner (-X, -Z)
-                    add_quad(*vertices, *texcoords, *normals, *colors, vertex_count,
-                            v1, v2, v3, v4, normal, block.type, 1, 1, block_light, ao1, ao2, ao3, ao4);
-                }
+                    // Face: Left (-X) - render if neighbor is air or transparent
+                    if (faces[FACE_LEFT][z][x] & (1u << bit)) {
+                        Vector3 v1 = {wx, wy, wz + 1};
+                        Vector3 v2 = {wx, wy, wz};
+                        Vector3 v3 = {wx, wy + 1, wz};
+                        Vector3 v4 = {wx, wy + 1, wz + 1};
+                        Vector3 normal = {-1, 0, 0};
+                        // Calculate AO for left face vertices (x-1 plane)
+                        int ao1 = calculate_vertex_ao_level(occ, x-1, y, z, 0,0,1, 0,-1,0);   // v1: corner (+Z, -Y)
+                        int ao2 = calculate_vertex_ao_level(occ, x-1, y, z, 0,0,-1, 0,-1,0);  // v2: corner (-Z, -Y)
+                        int ao3 = calculate_vertex_ao_level(occ, x-1, y, z, 0,0,-1, 0,1,0);   // v3: corner (-Z, +Y)
+                        int ao4 = calculate_vertex_ao_level(occ, x-1, y, z, 0,0,1, 0,1,0);    // v4: corner (+Z, +Y)
+                        add_quad(vertices, vertex_count,
+                                v1, v2, v3, v4, normal, block.type, block_light, ao1, ao2, ao3, ao4);
+                    }
 
-                // Face: Front (-Z) - render if neighbor is air or transparent
-                Block neighbor_front = (z - 1 >= 0) ? chunk_get_block(chunk, x, y, z - 1) : (Block){BLOCK_AIR, 0, 0};
-                if (!block_is_solid(neighbor_front) || block_is_transparent(neighbor_front)) {
-                    Vector3 v1 = {wx, wy, wz};
-                    Vector3 v2 = {wx + 1, wy, wz};
-                    Vector3 v3 = {wx + 1, wy + 1, wz};
-                    Vector3 v4 = {wx, wy + 1, wz};
-                    Vector3 normal = {0, 0, -1};
-                    // Calculate AO for front face vertices (z-1 plane)
-                    float ao1 = calculate_vertex_ao(chunk, x, y, z-1, -1,0,0, 0,-1,0);  // v1: corner (-X, -Y)
-                    float ao2 = calculate_vertex_ao(chunk, x, y, z-1, 1,0,0, 0,-1,0);   // v2: corner (+X, -Y)
-                    float ao3 = calculate_vertex_ao(chunk, x, y, z-1, 1,0,0, 0,1,0);    // v3: corner (+X, +Y)
-                    float ao4 = calculate_vertex_ao(chunk, x, y, z-1, -1,0,0, 0,1,0);   // v4: corner (-X, +Y)
-                    add_quad(*vertices, *texcoords, *normals, *colors, vertex_count,
-                            v1, v2, v3, v4, normal, block.type, 1, 1, block_light, ao1, ao2, ao3, ao4);
+                    // Face: Right (+X) - render if neighbor is air or transparent
+                    if (faces[FACE_RIGHT][z][x] & (1u << bit)) {
+                        Vector3 v1 = {wx + 1, wy, wz};
+                        Vector3 v2 = {wx + 1, wy, wz + 1};
+                        Vector3 v3 = {wx + 1, wy + 1, wz + 1};
+                        Vector3 v4 = {wx + 1, wy + 1, wz};
+                        Vector3 normal = {1, 0, 0};
+                        // Calculate AO for right face vertices (x+1 plane)
+                        int ao1 = calculate_vertex_ao_level(occ, x+1, y, z, 0,0,-1, 0,-1,0);  // v1: corner (-Z, -Y)
+                        int ao2 = calculate_vertex_ao_level(occ, x+1, y, z, 0,0,1, 0,-1,0);   // v2: corner (+Z, -Y)
+                        int ao3 = calculate_vertex_ao_level(occ, x+1, y, z, 0,0,1, 0,1,0);    // v3: corner (+Z, +Y)
+                        int ao4 = calculate_vertex_ao_level(occ, x+1, y, z, 0,0,-1, 0,1,0);   // v4: corner (-Z, +Y)
+                        add_quad(vertices, vertex_count,
+                                v1, v2, v3, v4, normal, block.type, block_light, ao1, ao2, ao3, ao4);
+                    }
                 }
+            }
+        }
+    }
+    section_start[CHUNK_SECTION_COUNT] = *vertex_count;
+}
 
-                // Face: Back (+Z) - render if neighbor is air or transparent
-                Block neighbor_back = (z + 1 < CHUNK_SIZE) ? chunk_get_block(chunk, x, y, z + 1) : (Block){BLOCK_AIR, 0, 0};
-                if (!block_is_solid(neighbor_back) || block_is_transparent(neighbor_back)) {
-                    Vector3 v1 = {wx + 1, wy, wz + 1};
-                    Vector3 v2 = {wx, wy, wz + 1};
-                    Vector3 v3 = {wx, wy + 1, wz + 1};
-                    Vector3 v4 = {wx + 1, wy + 1, wz + 1};
-                    Vector3 normal = {0, 0, 1};
-                    // Calculate AO for back face vertices (z+1 plane)
-                    float ao1 = calculate_vertex_ao(chunk, x, y, z+1, 1,0,0, 0,-1,0);   // v1: corner (+X, -Y)
-                    float ao2 = calculate_vertex_ao(chunk, x, y, z+1, -1,0,0, 0,-1,0);  // v2: corner (-X, -Y)
-                    float ao3 = calculate_vertex_ao(chunk, x, y, z+1, -1,0,0, 0,1,0);   // v3: corner (-X, +Y)
-                    float ao4 = calculate_vertex_ao(chunk, x, y, z+1, 1,0,0, 0,1,0);    // v4: corner (+X, +Y)
-                    add_quad(*vertices, *texcoords, *normals, *colors, vertex_count,
-                            v1, v2, v3, v4, normal, block.type, 1, 1, block_light, ao1, ao2, ao3, ao4);
-                }
+// ============================================================================
+// GREEDY MESHING
+// ============================================================================
 
-                // Face: Left (-X) - render if neighbor is air or transparent
-                Block neighbor_left = (x - 1 >= 0) ? chunk_get_block(chunk, x - 1, y, z) : (Block){BLOCK_AIR, 0, 0};
-                if (!block_is_solid(neighbor_left) || block_is_transparent(neighbor_left)) {
-                    Vector3 v1 = {wx, wy, wz + 1};
-                    Vector3 v2 = {wx, wy, wz};
-                    Vector3 v3 = {wx, wy + 1, wz};
-                    Vector3 v4 = {wx, wy + 1, wz + 1};
-                    Vector3 normal = {-1, 0, 0};
-                    // Calculate AO for left face vertices (x-1 plane)
-                    float ao1 = calculate_vertex_ao(chunk, x-1, y, z, 0,0,1, 0,-1,0);   // v1: corner (+Z, -Y)
-                    float ao2 = calculate_vertex_ao(chunk, x-1, y, z, 0,0,-1, 0,-1,0);  // v2: corner (-Z, -Y)
-                    float ao3 = calculate_vertex_ao(chunk, x-1, y, z, 0,0,-1, 0,1,0);   // v3: corner (-Z, +Y)
-                    float ao4 = calculate_vertex_ao(chunk, x-1, y, z, 0,0,1, 0,1,0);    // v4: corner (+Z, +Y)
-                    add_quad(*vertices, *texcoords, *normals, *colors, vertex_count,
-                            v1, v2, v3, v4, normal, block.type, 1, 1, block_light, ao1, ao2, ao3, ao4);
-                }
+/**
+ * Face layout for the greedy mesher. Each face direction is meshed slice by
+ * slice: the layer axis runs along the normal, i/j span the slice and match
+ * the quad's texture U/V directions (sign = which edge is the v1 corner).
+ */
+typedef struct GreedyFaceDesc {
+    int normal[3];        // Neighbor offset / face normal
+    int layer_axis;       // 0 = x, 1 = y, 2 = z
+    int i_axis, i_sign;   // Texture U direction
+    int j_axis, j_sign;   // Texture V direction
+    int ao[4][6];         // calculate_vertex_ao_level side vectors for v1..v4 (same as simple mesher)
+} GreedyFaceDesc;
+
+static const GreedyFaceDesc greedy_faces[6] = {  // Indexed by BlockFace
+    // Top (+Y)
+    {{0, 1, 0}, 1, 0, 1, 2, 1,
+     {{-1,0,0, 0,0,-1}, {1,0,0, 0,0,-1}, {1,0,0, 0,0,1}, {-1,0,0, 0,0,1}}},
+    // Bottom (-Y)
+    {{0, -1, 0}, 1, 0, 1, 2, -1,
+     {{-1,0,0, 0,0,1}, {1,0,0, 0,0,1}, {1,0,0, 0,0,-1}, {-1,0,0, 0,0,-1}}},
+    // Front (-Z)
+    {{0, 0, -1}, 2, 0, 1, 1, 1,
+     {{-1,0,0, 0,-1,0}, {1,0,0, 0,-1,0}, {1,0,0, 0,1,0}, {-1,0,0, 0,1,0}}},
+    // Back (+Z)
+    {{0, 0, 1}, 2, 0, -1, 1, 1,
+     {{1,0,0, 0,-1,0}, {-1,0,0, 0,-1,0}, {-1,0,0, 0,1,0}, {1,0,0, 0,1,0}}},
+    // Left (-X)
+    {{-1, 0, 0}, 0, 2, -1, 1, 1,
+     {{0,0,1, 0,-1,0}, {0,0,-1, 0,-1,0}, {0,0,-1, 0,1,0}, {0,0,1, 0,1,0}}},
+    // Right (+X)
+    {{1, 0, 0}, 0, 2, 1, 1, 1,
+     {{0,0,-1, 0,-1,0}, {0,0,1, 0,-1,0}, {0,0,1, 0,1,0}, {0,0,-1, 0,1,0}}},
+};
 
-                // Face: Right (+X) - render if neighbor is air or transparent
-                Block neighbor_right = (x + 1 < CHUNK_SIZE) ? chunk_get_block(chunk, x + 1, y, z) : (Block){BLOCK_AIR, 0, 0};
-                if (!block_is_solid(neighbor_right) || block_is_transparent(neighbor_right)) {
-                    Vector3 v1 = {wx + 1, wy, wz};
-                    Vector3 v2 = {wx + 1, wy, wz + 1};
-                    Vector3 v3 = {wx + 1, wy + 1, wz + 1};
-                    Vector3 v4 = {wx + 1, wy + 1, wz};
-                    Vector3 normal = {1, 0, 0};
-                    // Calculate AO for right face vertices (x+1 plane)
-                    float ao1 = calculate_vertex_ao(chunk, x+1, y, z, 0,0,-1, 0,-1,0);  // v1: corner (-Z, -Y)
-                    float ao2 = calculate_vertex_ao(chunk, x+1, y, z, 0,0,1, 0,-1,0);   // v2: corner (+Z, -Y)
-                    float ao3 = calculate_vertex_ao(chunk, x+1, y, z, 0,0,1, 0,1,0);    // v3: corner (+Z, +Y)
-                    float ao4 = calculate_vertex_ao(chunk, x+1, y, z, 0,0,-1, 0,1,0);   // v4: corner (-Z, +Y)
-                    add_quad(*vertices, *texcoords, *normals, *colors, vertex_count,
-                            v1, v2, v3, v4, normal, block.type, 1, 1, block_light, ao1, ao2, ao3, ao4);
-                }
+/**
+ * Type and light of a block with a visible face, looked up once for all its faces
+ */
+typedef struct GreedyBlock {
+    uint8_t type;
+    uint8_t light;
+} GreedyBlock;
+
+/**
+ * Visible face in a slice, packed so faces merge on one compare:
+ * bits 0-7 type, 8-15 light, 16-23 AO level of corners v1..v4 (2 bits each)
+ * AO stays in the key: a merged quad only interpolates its own four corners,
+ * so faces with different corner AO would shade wrong
+ */
+typedef uint32_t GreedyCell;
+
+#define GREEDY_CELL_TYPE(cell) ((BlockType)((cell) & 0xFF))
+#define GREEDY_CELL_LIGHT(cell) ((uint8_t)(((cell) >> 8) & 0xFF))
+#define GREEDY_CELL_AO(cell, corner) ((uint8_t)(((cell) >> (16 + 2 * (corner))) & 3))
+
+static ChunkMesher g_chunk_mesher = CHUNK_MESHER_GREEDY;
+
+void chunk_set_mesher(ChunkMesher mesher) {
+    g_chunk_mesher = mesher;
+    printf("[CHUNK] Using %s mesher\n", mesher == CHUNK_MESHER_GREEDY ? "greedy" : "simple");
+}
+
+ChunkMesher chunk_get_mesher(void) {
+    return g_chunk_mesher;
+}
+
+/**
+ * Emit a merged quad. Tile coordinates are derived from the position in
+ * block.vs and repeated with fract(), so one quad can span many blocks of
+ * the atlas tile
+ */
+static void add_greedy_quad(ChunkVertex* vertices, int* vertex_count,
+                            const Vector3 corners[4], BlockFace face, GreedyCell cell) {
+    AtlasTile tile = texture_atlas_get_tile(GREEDY_CELL_TYPE(cell), face);
+
+    int idx = *vertex_count;
+    for (int c = 0; c < CHUNK_QUAD_VERTICES; c++) {
+        vertices[idx++] = chunk_vertex_pack((int)corners[c].x, (int)corners[c].y, (int)corners[c].z,
+                                            face, tile, GREEDY_CELL_LIGHT(cell), GREEDY_CELL_AO(cell, c));
+    }
+    *vertex_count = idx;
+}
+
+/**
+ * Type and light of every block of the section with at least one visible face
+ * ([z][x][y within the section]; other entries are left untouched), and the
+ * layers of each face direction that have a visible face (bit per layer)
+ */
+static void greedy_fill_blocks(Chunk* chunk, int section_y0, const uint16_t faces[6][CHUNK_SIZE][CHUNK_SIZE],
+                               GreedyBlock blocks[CHUNK_SIZE][CHUNK_SIZE][CHUNK_SECTION_HEIGHT],
+                               unsigned layers[6]) {
+    for (int f = 0; f < 6; f++) layers[f] = 0;
+
+    for (int z = 0; z < CHUNK_SIZE; z++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            unsigned visible = 0;
+            for (int f = 0; f < 6; f++) {
+                unsigned mask = faces[f][z][x];
+                if (!mask) continue;
+                visible |= mask;
+                int axis = greedy_faces[f].layer_axis;
+                layers[f] |= axis == 0 ? 1u << x : axis == 1 ? mask : 1u << z;
+            }
+
+            while (visible) {
+                int bit = __builtin_ctz(visible);
+                visible &= visible - 1;
+                int y = section_y0 + bit;
+                blocks[z][x][bit].type = chunk_get_block(chunk, x, y, z).type;
+                blocks[z][x][bit].light = get_block_light(chunk, x, y, z);
             }
         }
     }
 }
 
 /**
- * LOD mesh generation - samples every 2nd block for distant chunks
- * Creates 2x2 block faces instead of 1x1, reducing vertices by ~75%
+ * Cell of the visible face of section block (x, local_y, z)
  */
-static void chunk_generate_mesh_lod(Chunk* chunk, float** vertices, float** texcoords,
-                                    float** normals, unsigned char** colors, int* vertex_count,
-                                    bool transparent_pass) {
-    *vertex_count = 0;
+static GreedyCell greedy_face_cell(const MeshOccupancy* occ, const GreedyFaceDesc* f,
+                                   const GreedyBlock blocks[CHUNK_SIZE][CHUNK_SIZE][CHUNK_SECTION_HEIGHT],
+                                   int x, int local_y, int z, int section_y0) {
+    const GreedyBlock* block = &blocks[z][x][local_y];
+    int nx = x + f->normal[0];
+    int ny = section_y0 + local_y + f->normal[1];
+    int nz = z + f->normal[2];
+
+    GreedyCell cell = (GreedyCell)block->type | (GreedyCell)block->light << 8;
+    for (int c = 0; c < 4; c++) {
+        const int* a = f->ao[c];
+        int ao = calculate_vertex_ao_level(occ, nx, ny, nz, a[0], a[1], a[2], a[3], a[4], a[5]);
+        cell |= (GreedyCell)ao << (16 + 2 * c);
+    }
+    return cell;
+}
 
-    // Use Y bounds to skip empty regions
-    int y_start = (chunk->min_block_y > 0) ? chunk->min_block_y - 1 : 0;
-    int y_end = (chunk->max_block_y < CHUNK_HEIGHT - 1) ? chunk->max_block_y + 2 : CHUNK_HEIGHT;
-
-    // Sample every 2nd block in X and Z
-    for (int y = y_start; y < y_end; y++) {
-        for (int z = 0; z < CHUNK_SIZE; z += 2) {
-            for (int x = 0; x < CHUNK_SIZE; x += 2) {
-                // Find dominant block in 2x2 area
-                Block block = {BLOCK_AIR, 0, 0};
-                for (int dz = 0; dz < 2 && block.type == BLOCK_AIR; dz++) {
-                    for (int dx = 0; dx < 2 && block.type == BLOCK_AIR; dx++) {
-                        int bx = x + dx;
-                        int bz = z + dz;
-                        if (bx < CHUNK_SIZE && bz < CHUNK_SIZE) {
-                            Block b = chunk_get_block(chunk, bx, y, bz);
-                            if (block_is_solid(b)) {
-                                block = b;
-                            }
-                        }
-                    }
-                }
+/**
+ * Build the cells of one slice (16x16, i/j per face desc) from the section's
+ * face mask. rows[j] gets bit i set for every visible face; cells are only
+ * written (and AO computed) there
+ */
+static void greedy_fill_slice(const MeshOccupancy* occ, const GreedyFaceDesc* f, int layer, int section_y0,
+                              const uint16_t face_mask[CHUNK_SIZE][CHUNK_SIZE],
+                              const GreedyBlock blocks[CHUNK_SIZE][CHUNK_SIZE][CHUNK_SECTION_HEIGHT],
+                              GreedyCell cells[CHUNK_SIZE][CHUNK_SIZE], uint16_t rows[CHUNK_SIZE]) {
+    for (int j = 0; j < CHUNK_SIZE; j++) rows[j] = 0;
+
+    if (f->layer_axis == 1) {
+        // Top/bottom: i = x, j = z, layer = y
+        for (int z = 0; z < CHUNK_SIZE; z++) {
+            for (int x = 0; x < CHUNK_SIZE; x++) {
+                if (!(face_mask[z][x] & (1u << layer))) continue;
+                rows[z] |= (uint16_t)(1u << x);
+                cells[z][x] = greedy_face_cell(occ, f, blocks, x, layer, z, section_y0);
+            }
+        }
+        return;
+    }
 
-                // Skip if no solid blocks in 2x2 area
-                if (!block_is_solid(block)) {
-                    continue;
-                }
+    // Sides: j = y, i = the horizontal axis that is not the layer
+    for (int i = 0; i < CHUNK_SIZE; i++) {
+        int x = f->layer_axis == 0 ? layer : i;
+        int z = f->layer_axis == 0 ? i : layer;
+        unsigned mask = face_mask[z][x];
+        while (mask) {
+            int y = __builtin_ctz(mask);
+            mask &= mask - 1;
+            rows[y] |= (uint16_t)(1u << i);
+            cells[y][i] = greedy_face_cell(occ, f, blocks, x, y, z, section_y0);
+        }
+    }
+}
 
-                // Two-pass rendering
-                bool is_transparent = block_is_transparent(block);
-                if (transparent_pass != is_transparent) {
-                    continue;
-                }
+/**
+ * Greedy meshing - merges coplanar faces with identical type, light and AO
+ * into larger quads. Same section_mask/section_start contract as
+ * chunk_generate_mesh_simple; quads never cross a section boundary so
+ * partial remeshes can splice them
+ */
+static void chunk_generate_mesh_greedy(Chunk* chunk, const MeshOccupancy* occ, ChunkVertex* vertices,
+                                       int* vertex_count, bool transparent_pass, uint16_t section_mask,
+                                       int* section_start) {
+    *vertex_count = 0;
 
-                // Position (2x2 block area)
-                float wx = (float)x;
-                float wy = (float)y;
-                float wz = (float)z;
-                float block_size = 2.0f;  // LOD uses 2x2 blocks
-
-                // Get light for this position
-                uint8_t block_light = get_block_light(chunk, x, y, z);
-
-                // No AO for LOD (simplified)
-                float ao = 1.0f;
-
-                // Top face
-                bool has_top_neighbor = false;
-                if (y + 1 < CHUNK_HEIGHT) {
-                    for (int dz = 0; dz < 2 && !has_top_neighbor; dz++) {
-                        for (int dx = 0; dx < 2 && !has_top_neighbor; dx++) {
-                            int bx = x + dx, bz = z + dz;
-                            if (bx < CHUNK_SIZE && bz < CHUNK_SIZE) {
-                                Block n = chunk_get_block(chunk, bx, y + 1, bz);
-                                if (block_is_solid(n) && !block_is_transparent(n)) {
-                                    has_top_neighbor = true;
-                                }
+    GreedyCell cells[CHUNK_SIZE][CHUNK_SIZE];
+    uint16_t rows[CHUNK_SIZE];
+    uint16_t faces[6][CHUNK_SIZE][CHUNK_SIZE];
+    GreedyBlock blocks[CHUNK_SIZE][CHUNK_SIZE][CHUNK_SECTION_HEIGHT];
+    unsigned layers[6];
+
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        section_start[sy] = *vertex_count;
+        if (!(section_mask & (1u << sy))) continue;
+        if (chunk->sections[sy].block_count == 0) continue;  // Faces belong to solid blocks
+
+        int section_y0 = sy * CHUNK_SECTION_HEIGHT;
+        if (!mesh_section_faces(occ, transparent_pass, sy, faces)) continue;
+        greedy_fill_blocks(chunk, section_y0, faces, blocks, layers);
+
+        for (int fi = 0; fi < 6; fi++) {
+            const GreedyFaceDesc* f = &greedy_faces[fi];
+            BlockFace face = (BlockFace)fi;  // greedy_faces follows BlockFace order
+            bool positive = (f->normal[0] + f->normal[1] + f->normal[2]) > 0;
+
+            unsigned pending = layers[fi];
+            while (pending) {
+                int layer = __builtin_ctz(pending);
+                pending &= pending - 1;
+                greedy_fill_slice(occ, f, layer, section_y0, faces[fi], blocks, cells, rows);
+
+                for (int j = 0; j < CHUNK_SIZE; j++) {
+                    while (rows[j]) {
+                        int i = __builtin_ctz(rows[j]);
+                        GreedyCell cell = cells[j][i];
+
+                        // Grow along i, then along j while whole rows match
+                        int w = 1;
+                        while (i + w < CHUNK_SIZE && (rows[j] & (1u << (i + w))) && cells[j][i + w] == cell) w++;
+                        unsigned span = ((1u << w) - 1) << i;
+                        int h = 1;
+                        while (j + h < CHUNK_SIZE && (rows[j + h] & span) == span) {
+                            bool row_ok = true;
+                            for (int k = 0; k < w && row_ok; k++) {
+                                row_ok = cells[j + h][i + k] == cell;
                             }
+                            if (!row_ok) break;
+                            h++;
                         }
-                    }
-                }
-                if (!has_top_neighbor) {
-                    Vector3 v1 = {wx, wy + 1, wz};
-                    Vector3 v2 = {wx + block_size, wy + 1, wz};
-                    Vector3 v3 = {wx + block_size, wy + 1, wz + block_size};
-                    Vector3 v4 = {wx, wy + 1, wz + block_size};
-                    Vector3 normal = {0, 1, 0};
-                    add_quad(*vertices, *texcoords, *normals, *colors, vertex_count,
-                            v1, v2, v3, v4, normal, block.type, 1, 1, block_light, ao, ao, ao, ao);
-                }
-
-                // Bottom face
-                bool has_bottom_neighbor = false;
-                if (y - 1 >= 0) {
-                    for (int dz = 0; dz < 2 && !has_bottom_neighbor; dz++) {
-                        for (int dx = 0; dx < 2 && !has_bottom_neighbor; dx++) {
-                            int bx = x + dx, bz = z + dz;
-                            if (bx < CHUNK_SIZE && bz < CHUNK_SIZE) {
-                                Block n = chunk_get_block(chunk, bx, y - 1, bz);
-                                if (block_is_solid(n) && !block_is_transparent(n)) {
-                                    has_bottom_neighbor = true;
-                                }
-                            }
+                        for (int dj = 0; dj < h; dj++) rows[j + dj] &= (uint16_t)~span;
+
+                        // Corners v1..v4 in chunk space (layer plane on the face side)
+                        float plane = (float)(layer + (positive ? 1 : 0));
+                        float i_start = (float)(f->i_sign > 0 ? i : i + w);
+                        float i_end = (float)(f->i_sign > 0 ? i + w : i);
+                        float j_start = (float)(f->j_sign > 0 ? j : j + h);
+                        float j_end = (float)(f->j_sign > 0 ? j + h : j);
+                        float ij[4][2] = {{i_start, j_start}, {i_end, j_start}, {i_end, j_end}, {i_start, j_end}};
+
+                        Vector3 corners[4];
+                        for (int c = 0; c < 4; c++) {
+                            float p[3];
+                            p[f->layer_axis] = plane;
+                            p[f->i_axis] = ij[c][0];
+                            p[f->j_axis] = ij[c][1];
+                            p[1] += (float)section_y0;
+                            corners[c] = (Vector3){p[0], p[1], p[2]};
                         }
+
+                        add_greedy_quad(vertices, vertex_count, corners, face, cell);
                     }
                 }
-                if (!has_bottom_neighbor) {
-                    Vector3 v1 = {wx, wy, wz + block_size};
-                    Vector3 v2 = {wx + block_size, wy, wz + block_size};
-                    Vector3 v3 = {wx + block_size, wy, wz};
-                    Vector3 v4 = {wx, wy, wz};
-                    Vector3 normal = {0, -1, 0};
-                    add_quad(*vertices, *texcoords, *normals, *colors, vertex_count,
-                            v1, v2, v3, v4, normal, block.type, 1, 1, block_light, ao, ao, ao, ao);
-                }
+            }
+        }
+    }
+    section_start[CHUNK_SECTION_COUNT] = *vertex_count;
+}
 
-                // Front face (-Z) - only if at z=0 edge of 2x2 area
-                if (z == 0 || !block_is_solid(chunk_get_block(chunk, x, y, z - 1))) {
-                    Vector3 v1 = {wx, wy, wz};
-                    Vector3 v2 = {wx + block_size, wy, wz};
-                    Vector3 v3 = {wx + block_size, wy + 1, wz};
-                    Vector3 v4 = {wx, wy + 1, wz};
-                    Vector3 normal = {0, 0, -1};
-                    add_quad(*vertices, *texcoords, *normals, *colors, vertex_count,
-                            v1, v2, v3, v4, normal, block.type, 1, 1, block_light, ao, ao, ao, ao);
-                }
+/**
+ * Run the given mesher for one pass
+ */
+static void chunk_generate_mesh_pass(Chunk* chunk, const MeshOccupancy* occ, ChunkMesher mesher,
+                                     ChunkVertex* vertices, int* vertex_count,
+                                     bool transparent_pass, uint16_t section_mask, int* section_start) {
+    if (mesher == CHUNK_MESHER_GREEDY) {
+        chunk_generate_mesh_greedy(chunk, occ, vertices, vertex_count, transparent_pass, section_mask, section_start);
+    } else {
+        chunk_generate_mesh_simple(chunk, occ, vertices, vertex_count, transparent_pass, section_mask, section_start);
+    }
+}
 
-                // Back face (+Z) - only if at z+2 edge or neighbor is not solid
-                int back_z = z + 2;
-                bool show_back = (back_z >= CHUNK_SIZE) || !block_is_solid(chunk_get_block(chunk, x, y, back_z));
-                if (show_back) {
-                    Vector3 v1 = {wx + block_size, wy, wz + block_size};
-                    Vector3 v2 = {wx, wy, wz + block_size};
-                    Vector3 v3 = {wx, wy + 1, wz + block_size};
-                    Vector3 v4 = {wx + block_size, wy + 1, wz + block_size};
-                    Vector3 normal = {0, 0, 1};
-                    add_quad(*vertices, *texcoords, *normals, *colors, vertex_count,
-                            v1, v2, v3, v4, normal, block.type, 1, 1, block_light, ao, ao, ao, ao);
-                }
+/**
+ * Worst case vertex count for a mesh pass over the given number of sections
+ * (every block visible on all 6 sides, one quad per face)
+ */
+static int max_pass_vertices(int sections) {
+    return sections * CHUNK_SECTION_VOLUME * 6 * CHUNK_QUAD_VERTICES;
+}
 
-                // Left face (-X) - only if at x=0 edge
-                if (x == 0 || !block_is_solid(chunk_get_block(chunk, x - 1, y, z))) {
-                    Vector3 v1 = {wx, wy, wz + block_size};
-                    Vector3 v2 = {wx, wy, wz};
-                    Vector3 v3 = {wx, wy + 1, wz};
-                    Vector3 v4 = {wx, wy + 1, wz + block_size};
-                    Vector3 normal = {-1, 0, 0};
-                    add_quad(*vertices, *texcoords, *normals, *colors, vertex_count,
-                            v1, v2, v3, v4, normal, block.type, 1, 1, block_light, ao, ao, ao, ao);
-                }
+/**
+ * Quad and its squared distance from the sort origin (in 1/8 blocks)
+ */
+typedef struct QuadSortKey {
+    int64_t dist_sq;
+    int quad;
+} QuadSortKey;
+
+static int compare_quad_keys(const void* a, const void* b) {
+    const QuadSortKey* ka = (const QuadSortKey*)a;
+    const QuadSortKey* kb = (const QuadSortKey*)b;
+    // Farthest first for back-to-front blending
+    if (kb->dist_sq > ka->dist_sq) return 1;
+    if (kb->dist_sq < ka->dist_sq) return -1;
+    return 0;
+}
 
-                // Right face (+X) - only if at x+2 edge or neighbor is not solid
-                int right_x = x + 2;
-                bool show_right = (right_x >= CHUNK_SIZE) || !block_is_solid(chunk_get_block(chunk, right_x, y, z));
-                if (show_right) {
-                    Vector3 v1 = {wx + block_size, wy, wz};
-                    Vector3 v2 = {wx + block_size, wy, wz + block_size};
-                    Vector3 v3 = {wx + block_size, wy + 1, wz + block_size};
-                    Vector3 v4 = {wx + block_size, wy + 1, wz};
-                    Vector3 normal = {1, 0, 0};
-                    add_quad(*vertices, *texcoords, *normals, *colors, vertex_count,
-                            v1, v2, v3, v4, normal, block.type, 1, 1, block_light, ao, ao, ao, ao);
-                }
+/**
+ * Copy every section's transparent quads from src to dst back-to-front from sort_origin
+ * Sections stay in place, so section ranges and splices are unaffected;
+ * water and leaf faces inside a section then blend in the right order
+ * keys holds one entry per quad; offset_x/z is where vertex x/z 0 lies in
+ * the chunk (cell-space vertices sit at the chunk's cell offset)
+ */
+static void sort_transparent_quads(const Chunk* chunk, const ChunkVertex* src, ChunkVertex* dst,
+                                   int vertex_count, const int* section_start, QuadSortKey* keys,
+                                   int offset_x, int offset_z) {
+    memcpy(dst, src, (size_t)vertex_count * sizeof(ChunkVertex));
+    if (!keys) return;  // Unsorted is still a valid mesh
+
+    // Origin at the center of its block, in the same 1/8 units as twice a corner sum
+    int64_t ox = (int64_t)(chunk->sort_origin[0] - chunk->x * CHUNK_SIZE + offset_x) * 8 + 4;
+    int64_t oy = (int64_t)chunk->sort_origin[1] * 8 + 4;
+    int64_t oz = (int64_t)(chunk->sort_origin[2] - chunk->z * CHUNK_SIZE + offset_z) * 8 + 4;
+
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        int first = section_start[sy] / CHUNK_QUAD_VERTICES;
+        int count = section_start[sy + 1] / CHUNK_QUAD_VERTICES - first;
+        if (count < 2) continue;
+
+        for (int q = 0; q < count; q++) {
+            const ChunkVertex* v = &src[(first + q) * CHUNK_QUAD_VERTICES];
+            int64_t sum_x = 0, sum_y = 0, sum_z = 0;
+            for (int c = 0; c < CHUNK_QUAD_VERTICES; c++) {
+                sum_x += v[c].x;
+                sum_y += v[c].y | ((v[c].face & CHUNK_VERTEX_Y_HIGH_BIT) ? 256 : 0);
+                sum_z += v[c].z;
             }
+            int64_t dx = sum_x * 2 - ox, dy = sum_y * 2 - oy, dz = sum_z * 2 - oz;
+            keys[q].dist_sq = dx * dx + dy * dy + dz * dz;
+            keys[q].quad = first + q;
+        }
+        qsort(keys, (size_t)count, sizeof(QuadSortKey), compare_quad_keys);
+
+        for (int q = 0; q < count; q++) {
+            memcpy(&dst[(first + q) * CHUNK_QUAD_VERTICES], &src[keys[q].quad * CHUNK_QUAD_VERTICES],
+                   CHUNK_QUAD_VERTICES * sizeof(ChunkVertex));
         }
     }
 }
 
+void chunk_sort_transparent(const Chunk* chunk, ChunkVertex* vertices, int vertex_count, const int* section_start) {
+    if (!chunk || !vertices || vertex_count <= 0) return;
+
+    MeshArena* arena = mesh_arena_current();
+    size_t vertex_bytes = (size_t)vertex_count * sizeof(ChunkVertex);
+    size_t key_bytes = (size_t)(vertex_count / CHUNK_QUAD_VERTICES) * sizeof(QuadSortKey);
+    ChunkVertex* src = arena ? (ChunkVertex*)mesh_arena_scratch(arena, MESH_SCRATCH_VERTICES, vertex_bytes)
+                             : (ChunkVertex*)malloc(vertex_bytes);
+    QuadSortKey* keys = arena ? (QuadSortKey*)mesh_arena_scratch(arena, MESH_SCRATCH_SORT, key_bytes)
+                              : (QuadSortKey*)malloc(key_bytes);
+    if (src && keys) {
+        memcpy(src, vertices, vertex_bytes);
+        sort_transparent_quads(chunk, src, vertices, vertex_count, section_start, keys,
+                               chunk_mesh_cell_offset(chunk->x), chunk_mesh_cell_offset(chunk->z));
+    }
+    if (!arena) {
+        free(src);
+        free(keys);
+    }
+}
+
 /**
- * Generate mesh for chunk using simple per-face algorithm
+ * Mesh one pass into a worst-case buffer, then copy it into a block that fits
+ * On worker threads both come from the thread's mesh arena, so streaming
+ * allocates nothing once the arena is warm
+ * Returns false on OOM; *out is NULL when the pass produced no vertices,
+ * otherwise the caller releases it with mesh_block_free
  */
-void chunk_generate_mesh(Chunk* chunk) {
-    if (!chunk) return;
+static bool generate_pass(Chunk* chunk, const MeshOccupancy* occ, ChunkMesher mesher, bool transparent_pass, uint16_t mask,
+                          int max_vertices, ChunkVertex** out, int* vertex_count, int* section_start) {
+    *out = NULL;
+    *vertex_count = 0;
 
-    // Unload old opaque mesh if it exists
-    if (chunk->mesh_generated && chunk->mesh.vboId != NULL) {
-        UnloadMesh(chunk->mesh);
-        chunk->mesh_generated = false;
-        memset(&chunk->mesh, 0, sizeof(Mesh));
+    MeshArena* arena = mesh_arena_current();
+    size_t scratch_bytes = (size_t)max_vertices * sizeof(ChunkVertex);
+    ChunkVertex* scratch = arena ? (ChunkVertex*)mesh_arena_scratch(arena, MESH_SCRATCH_VERTICES, scratch_bytes)
+                                 : (ChunkVertex*)malloc(scratch_bytes);
+    if (!scratch) return false;
+
+    chunk_generate_mesh_pass(chunk, occ, mesher, scratch, vertex_count, transparent_pass, mask, section_start);
+
+    ChunkVertex* vertices = NULL;
+    if (*vertex_count > 0) {
+        vertices = mesh_block_alloc(arena, *vertex_count);
+        if (!vertices) {
+            if (!arena) free(scratch);
+            *vertex_count = 0;
+            return false;
+        }
     }
 
-    // Unload old transparent mesh if it exists
-    if (chunk->transparent_mesh_generated && chunk->transparent_mesh.vboId != NULL) {
-        UnloadMesh(chunk->transparent_mesh);
-        chunk->transparent_mesh_generated = false;
-        memset(&chunk->transparent_mesh, 0, sizeof(Mesh));
+    if (vertices && transparent_pass) {
+        size_t key_bytes = (size_t)(*vertex_count / CHUNK_QUAD_VERTICES) * sizeof(QuadSortKey);
+        QuadSortKey* keys = arena ? (QuadSortKey*)mesh_arena_scratch(arena, MESH_SCRATCH_SORT, key_bytes)
+                                  : (QuadSortKey*)malloc(key_bytes);
+        sort_transparent_quads(chunk, scratch, vertices, *vertex_count, section_start, keys, 0, 0);
+        if (!arena) free(keys);
+    } else if (vertices) {
+        memcpy(vertices, scratch, (size_t)*vertex_count * sizeof(ChunkVertex));
     }
+    if (!arena) free(scratch);
+
+    // Move into cell space, so batches are built with plain buffer copies
+    uint8_t offset_x = (uint8_t)chunk_mesh_cell_offset(chunk->x);
+    uint8_t offset_z = (uint8_t)chunk_mesh_cell_offset(chunk->z);
+    if (offset_x != 0 || offset_z != 0) {
+        for (int i = 0; i < *vertex_count; i++) {
+            vertices[i].x += offset_x;
+            vertices[i].z += offset_z;
+        }
+    }
+
+    *out = vertices;
+    return true;
+}
+
+/**
+ * Generate mesh for chunk using the selected mesher
+ */
+void chunk_generate_mesh(Chunk* chunk) {
+    if (!chunk) return;
+    chunk_ensure_warm(chunk);
+
+    // Unload old meshes if they exist
+    chunk_mesh_unload(&chunk->mesh);
+    chunk_mesh_unload(&chunk->transparent_mesh);
+    chunk->mesh_generated = false;
+    chunk->transparent_mesh_generated = false;
+
+    chunk_compute_visibility(chunk, CHUNK_SECTIONS_ALL, chunk->section_visibility);
 
     // Skip empty chunks
     if (chunk->is_empty) {
         return;
     }
 
-    // Allocate maximum possible buffer size (worst case: all blocks visible on all 6 sides)
-    int max_blocks = CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE;
-    int max_vertices = max_blocks * 6 * 6;  // 6 faces * 6 vertices per face
+    ChunkMesher mesher = chunk_get_mesher();
+    int max_vertices = max_pass_vertices(CHUNK_SECTION_COUNT);
 
-    // === PASS 1: Generate OPAQUE mesh ===
-    float* vertices = (float*)malloc(max_vertices * 3 * sizeof(float));
-    float* texcoords = (float*)malloc(max_vertices * 2 * sizeof(float));
-    float* normals = (float*)malloc(max_vertices * 3 * sizeof(float));
-    unsigned char* colors = (unsigned char*)malloc(max_vertices * 4 * sizeof(unsigned char));
-
-    if (!vertices || !texcoords || !normals || !colors) {
-        // Clean up partial allocations
-        free(vertices);    // free(NULL) is safe
-        free(texcoords);
-        free(normals);
-        free(colors);
-        // Leave needs_remesh = true so chunk can retry when memory is available
+    // Leave needs_remesh = true on OOM so chunk can retry when memory is available
+    MeshOccupancy* occ = mesh_occupancy_acquire(chunk, CHUNK_SECTIONS_ALL);
+    if (!occ) {
         printf("[CHUNK] Warning: OOM during mesh generation for chunk (%d, %d)\n", chunk->x, chunk->z);
         return;
     }
 
-    int vertex_count = 0;
-    chunk_generate_mesh_simple(chunk, &vertices, &texcoords, &normals, &colors, &vertex_count, false);
-
-    if (vertex_count > 0) {
-        chunk->mesh.vertexCount = vertex_count;
-        chunk->mesh.triangleCount = vertex_count / 3;
-        chunk->mesh.vertices = vertices;
-        chunk->mesh.texcoords = texcoords;
-        chunk->mesh.normals = normals;
-        chunk->mesh.colors = colors;
-        UploadMesh(&chunk->mesh, false);
-        chunk->mesh_generated = true;
-    } else {
-        free(vertices);
-        free(texcoords);
-        free(normals);
-        free(colors);
+    // === PASS 1: Generate OPAQUE mesh ===
+    ChunkVertex* vertices;
+    int vertex_count;
+    if (!generate_pass(chunk, occ, mesher, false, CHUNK_SECTIONS_ALL, max_vertices,
+                       &vertices, &vertex_count, chunk->mesh_ranges.start)) {
+        printf("[CHUNK] Warning: OOM during mesh generation for chunk (%d, %d)\n", chunk->x, chunk->z);
+        mesh_occupancy_release(occ);
+        return;
     }
+    chunk->mesh_generated = chunk_mesh_upload(&chunk->mesh, vertices, vertex_count, false, MEMORY_GPU_CHUNK);
+    mesh_block_free(vertices);
 
     // === PASS 2: Generate TRANSPARENT mesh ===
-    float* trans_vertices = (float*)malloc(max_vertices * 3 * sizeof(float));
-    float* trans_texcoords = (float*)malloc(max_vertices * 2 * sizeof(float));
-    float* trans_normals = (float*)malloc(max_vertices * 3 * sizeof(float));
-    unsigned char* trans_colors = (unsigned char*)malloc(max_vertices * 4 * sizeof(unsigned char));
-
-    if (!trans_vertices || !trans_texcoords || !trans_normals || !trans_colors) {
-        // Clean up partial allocations
-        free(trans_vertices);
-        free(trans_texcoords);
-        free(trans_normals);
-        free(trans_colors);
-        // Leave needs_remesh = true so chunk can retry when memory is available
+    bool transparent_ok = generate_pass(chunk, occ, mesher, true, CHUNK_SECTIONS_ALL, max_vertices,
+                                        &vertices, &vertex_count, chunk->transparent_ranges.start);
+    mesh_occupancy_release(occ);
+    if (!transparent_ok) {
         printf("[CHUNK] Warning: OOM during transparent mesh generation for chunk (%d, %d)\n", chunk->x, chunk->z);
         return;
     }
-
-    int trans_vertex_count = 0;
-    chunk_generate_mesh_simple(chunk, &trans_vertices, &trans_texcoords, &trans_normals, &trans_colors, &trans_vertex_count, true);
-
-    if (trans_vertex_count > 0) {
-        chunk->transparent_mesh.vertexCount = trans_vertex_count;
-        chunk->transparent_mesh.triangleCount = trans_vertex_count / 3;
-        chunk->transparent_mesh.vertices = trans_vertices;
-        chunk->transparent_mesh.texcoords = trans_texcoords;
-        chunk->transparent_mesh.normals = trans_normals;
-        chunk->transparent_mesh.colors = trans_colors;
-        UploadMesh(&chunk->transparent_mesh, false);
-        chunk->transparent_mesh_generated = true;
-    } else {
-        free(trans_vertices);
-        free(trans_texcoords);
-        free(trans_normals);
-        free(trans_colors);
-    }
+    chunk->transparent_mesh_generated = chunk_mesh_upload(&chunk->transparent_mesh, vertices, vertex_count, false,
+                                                          MEMORY_GPU_CHUNK);
+    mesh_block_free(vertices);
 
     chunk->needs_remesh = false;
+    chunk->dirty_sections = 0;
 }
 
 /**
@@ -833,29 +2313,10 @@ void chunk_update_mesh(Chunk* chunk) {
  */
 void chunk_generate_mesh_staged(Chunk* chunk, StagedMesh* out) {
     if (!chunk || !out) return;
+    chunk_ensure_warm(chunk);
 
-    // Initialize output (including LOD fields)
-    out->vertices = NULL;
-    out->texcoords = NULL;
-    out->normals = NULL;
-    out->colors = NULL;
-    out->vertex_count = 0;
-    out->trans_vertices = NULL;
-    out->trans_texcoords = NULL;
-    out->trans_normals = NULL;
-    out->trans_colors = NULL;
-    out->trans_vertex_count = 0;
-    out->lod_vertices = NULL;
-    out->lod_texcoords = NULL;
-    out->lod_normals = NULL;
-    out->lod_colors = NULL;
-    out->lod_vertex_count = 0;
-    out->lod_trans_vertices = NULL;
-    out->lod_trans_texcoords = NULL;
-    out->lod_trans_normals = NULL;
-    out->lod_trans_colors = NULL;
-    out->lod_trans_vertex_count = 0;
-    out->valid = false;
+    memset(out, 0, sizeof(StagedMesh));
+    chunk_compute_visibility(chunk, CHUNK_SECTIONS_ALL, out->visibility);
 
     // Skip empty chunks
     if (chunk->is_empty) {
@@ -863,129 +2324,56 @@ void chunk_generate_mesh_staged(Chunk* chunk, StagedMesh* out) {
         return;
     }
 
-    // Allocate maximum possible buffer size
-    int max_blocks = CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE;
-    int max_vertices = max_blocks * 6 * 6;  // 6 faces * 6 vertices per face
+    ChunkMesher mesher = chunk_get_mesher();
+    int max_vertices = max_pass_vertices(CHUNK_SECTION_COUNT);
+
+    MeshOccupancy* occ = mesh_occupancy_acquire(chunk, CHUNK_SECTIONS_ALL);
+    if (!occ) return;
 
     // === PASS 1: Generate OPAQUE mesh ===
-    float* vertices = (float*)malloc(max_vertices * 3 * sizeof(float));
-    float* texcoords = (float*)malloc(max_vertices * 2 * sizeof(float));
-    float* normals = (float*)malloc(max_vertices * 3 * sizeof(float));
-    unsigned char* colors = (unsigned char*)malloc(max_vertices * 4 * sizeof(unsigned char));
-
-    if (!vertices || !texcoords || !normals || !colors) {
-        if (vertices) free(vertices);
-        if (texcoords) free(texcoords);
-        if (normals) free(normals);
-        if (colors) free(colors);
+    if (!generate_pass(chunk, occ, mesher, false, CHUNK_SECTIONS_ALL, max_vertices,
+                       &out->vertices, &out->vertex_count, out->section_start)) {
+        mesh_occupancy_release(occ);
         return;
     }
 
-    int vertex_count = 0;
-    chunk_generate_mesh_simple(chunk, &vertices, &texcoords, &normals, &colors, &vertex_count, false);
-
-    if (vertex_count > 0) {
-        out->vertices = vertices;
-        out->texcoords = texcoords;
-        out->normals = normals;
-        out->colors = colors;
-        out->vertex_count = vertex_count;
-    } else {
-        free(vertices);
-        free(texcoords);
-        free(normals);
-        free(colors);
-    }
-
     // === PASS 2: Generate TRANSPARENT mesh ===
-    float* trans_vertices = (float*)malloc(max_vertices * 3 * sizeof(float));
-    float* trans_texcoords = (float*)malloc(max_vertices * 2 * sizeof(float));
-    float* trans_normals = (float*)malloc(max_vertices * 3 * sizeof(float));
-    unsigned char* trans_colors = (unsigned char*)malloc(max_vertices * 4 * sizeof(unsigned char));
-
-    if (!trans_vertices || !trans_texcoords || !trans_normals || !trans_colors) {
-        if (trans_vertices) free(trans_vertices);
-        if (trans_texcoords) free(trans_texcoords);
-        if (trans_normals) free(trans_normals);
-        if (trans_colors) free(trans_colors);
-        out->valid = true;  // Opaque mesh may still be valid
-        return;
-    }
+    // On OOM the opaque mesh may still be valid
+    generate_pass(chunk, occ, mesher, true, CHUNK_SECTIONS_ALL, max_vertices,
+                  &out->trans_vertices, &out->trans_vertex_count, out->trans_section_start);
+    mesh_occupancy_release(occ);
 
-    int trans_vertex_count = 0;
-    chunk_generate_mesh_simple(chunk, &trans_vertices, &trans_texcoords, &trans_normals, &trans_colors, &trans_vertex_count, true);
+    out->valid = true;
+}
 
-    if (trans_vertex_count > 0) {
-        out->trans_vertices = trans_vertices;
-        out->trans_texcoords = trans_texcoords;
-        out->trans_normals = trans_normals;
-        out->trans_colors = trans_colors;
-        out->trans_vertex_count = trans_vertex_count;
-    } else {
-        free(trans_vertices);
-        free(trans_texcoords);
-        free(trans_normals);
-        free(trans_colors);
-    }
-
-    // === PASS 3: Generate LOD OPAQUE mesh ===
-    // LOD uses smaller buffers since it samples every 2nd block
-    int lod_max_vertices = max_vertices / 4;  // ~25% of full detail
-    float* lod_vertices = (float*)malloc(lod_max_vertices * 3 * sizeof(float));
-    float* lod_texcoords = (float*)malloc(lod_max_vertices * 2 * sizeof(float));
-    float* lod_normals = (float*)malloc(lod_max_vertices * 3 * sizeof(float));
-    unsigned char* lod_colors = (unsigned char*)malloc(lod_max_vertices * 4 * sizeof(unsigned char));
-
-    if (lod_vertices && lod_texcoords && lod_normals && lod_colors) {
-        int lod_vertex_count = 0;
-        chunk_generate_mesh_lod(chunk, &lod_vertices, &lod_texcoords, &lod_normals, &lod_colors, &lod_vertex_count, false);
-
-        if (lod_vertex_count > 0) {
-            out->lod_vertices = lod_vertices;
-            out->lod_texcoords = lod_texcoords;
-            out->lod_normals = lod_normals;
-            out->lod_colors = lod_colors;
-            out->lod_vertex_count = lod_vertex_count;
-        } else {
-            free(lod_vertices);
-            free(lod_texcoords);
-            free(lod_normals);
-            free(lod_colors);
-        }
-    } else {
-        if (lod_vertices) free(lod_vertices);
-        if (lod_texcoords) free(lod_texcoords);
-        if (lod_normals) free(lod_normals);
-        if (lod_colors) free(lod_colors);
-    }
-
-    // === PASS 4: Generate LOD TRANSPARENT mesh ===
-    float* lod_trans_vertices = (float*)malloc(lod_max_vertices * 3 * sizeof(float));
-    float* lod_trans_texcoords = (float*)malloc(lod_max_vertices * 2 * sizeof(float));
-    float* lod_trans_normals = (float*)malloc(lod_max_vertices * 3 * sizeof(float));
-    unsigned char* lod_trans_colors = (unsigned char*)malloc(lod_max_vertices * 4 * sizeof(unsigned char));
-
-    if (lod_trans_vertices && lod_trans_texcoords && lod_trans_normals && lod_trans_colors) {
-        int lod_trans_vertex_count = 0;
-        chunk_generate_mesh_lod(chunk, &lod_trans_vertices, &lod_trans_texcoords, &lod_trans_normals, &lod_trans_colors, &lod_trans_vertex_count, true);
-
-        if (lod_trans_vertex_count > 0) {
-            out->lod_trans_vertices = lod_trans_vertices;
-            out->lod_trans_texcoords = lod_trans_texcoords;
-            out->lod_trans_normals = lod_trans_normals;
-            out->lod_trans_colors = lod_trans_colors;
-            out->lod_trans_vertex_count = lod_trans_vertex_count;
-        } else {
-            free(lod_trans_vertices);
-            free(lod_trans_texcoords);
-            free(lod_trans_normals);
-            free(lod_trans_colors);
-        }
-    } else {
-        if (lod_trans_vertices) free(lod_trans_vertices);
-        if (lod_trans_texcoords) free(lod_trans_texcoords);
-        if (lod_trans_normals) free(lod_trans_normals);
-        if (lod_trans_colors) free(lod_trans_colors);
+/**
+ * Generate only the sections in section_mask (for edits, on worker threads)
+ * The staged mesh holds just those sections; chunk_worker_upload_mesh splices
+ * them into the chunk's existing mesh.
+ */
+void chunk_generate_sections_staged(Chunk* chunk, uint16_t section_mask, StagedMesh* out) {
+    if (!chunk || !out) return;
+    chunk_ensure_warm(chunk);
+
+    memset(out, 0, sizeof(StagedMesh));
+    out->section_mask = section_mask;
+    chunk_compute_visibility(chunk, section_mask, out->visibility);
+
+    ChunkMesher mesher = chunk_get_mesher();
+    int max_vertices = max_pass_vertices(__builtin_popcount(section_mask));
+
+    MeshOccupancy* occ = mesh_occupancy_acquire(chunk, section_mask);
+    bool ok = occ && generate_pass(chunk, occ, mesher, false, section_mask, max_vertices,
+                                   &out->vertices, &out->vertex_count, out->section_start);
+    if (ok && !generate_pass(chunk, occ, mesher, true, section_mask, max_vertices,
+                             &out->trans_vertices, &out->trans_vertex_count, out->trans_section_start)) {
+        staged_mesh_free(out);
+        ok = false;
+    }
+    if (occ) mesh_occupancy_release(occ);
+    if (!ok) {
+        printf("[CHUNK] Warning: OOM during section remesh for chunk (%d, %d)\n", chunk->x, chunk->z);
+        return;
     }
 
     out->valid = true;
@@ -0,0 +1,196 @@
+/**
+ * Chunk Codec Implementation
+ *
+ * Layout: version (u8), palette size (u16), palette entries (type, metadata),
+ * then runs of (palette index, varint length). Indices are one byte while
+ * the palette has at most 256 entries, two bytes otherwise.
+ */
+
+#include "voxel/world/chunk_codec.h"
+#include "voxel/core/block.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define CODEC_METADATA_VALUES 16                          // Metadata is stored in 4 bits
+#define CODEC_MAX_PALETTE (256 * CODEC_METADATA_VALUES)
+#define CODEC_HEADER_BYTES 3
+#define CODEC_NO_ENTRY 0xFFFF
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+static uint8_t* put_varint(uint8_t* p, uint32_t v) {
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static bool get_varint(const uint8_t** p, const uint8_t* end, uint32_t* out) {
+    uint32_t v = 0;
+    for (int shift = 0; shift < 28; shift += 7) {
+        if (*p >= end) return false;
+        uint8_t byte = *(*p)++;
+        v |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *out = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+static Block block_at_index(Chunk* chunk, int index) {
+    int y = index / (CHUNK_SIZE * CHUNK_SIZE);
+    int x = (index / CHUNK_SIZE) % CHUNK_SIZE;
+    int z = index % CHUNK_SIZE;
+    return chunk_get_block(chunk, x, y, z);
+}
+
+/**
+ * Walk the runs of an encoded chunk, writing them into chunk (NULL = only validate)
+ */
+static bool decode_runs(Chunk* chunk, const uint8_t* data, uint32_t size) {
+    if (size < CODEC_HEADER_BYTES || data[0] != CHUNK_CODEC_VERSION) return false;
+
+    int palette_count = data[1] | (data[2] << 8);
+    if (palette_count == 0 || palette_count > CODEC_MAX_PALETTE) return false;
+    if (size < CODEC_HEADER_BYTES + (uint32_t)palette_count * 2) return false;
+
+    const uint8_t* palette = data + CODEC_HEADER_BYTES;
+    const uint8_t* p = palette + palette_count * 2;
+    const uint8_t* end = data + size;
+    int index_bytes = palette_count > 256 ? 2 : 1;
+
+    int index = 0;
+    while (index < CHUNK_VOLUME) {
+        if (end - p < index_bytes) return false;
+        int entry = *p++;
+        if (index_bytes == 2) entry |= *p++ << 8;
+        uint32_t length;
+        if (entry >= palette_count || !get_varint(&p, end, &length)) return false;
+        if (length == 0 || length > (uint32_t)(CHUNK_VOLUME - index)) return false;
+
+        if (!chunk) {
+            index += (int)length;
+            continue;
+        }
+
+        Block b = {palette[entry * 2], 0, palette[entry * 2 + 1]};
+        bool air = b.type == BLOCK_AIR && b.metadata == 0;
+        int end = index + (int)length;
+        while (index < end) {
+            // Whole sections inside the run are filled without arrays
+            if (index % CHUNK_SECTION_VOLUME == 0 && end - index >= CHUNK_SECTION_VOLUME) {
+                chunk_fill_section(chunk, index / CHUNK_SECTION_VOLUME, b);
+                index += CHUNK_SECTION_VOLUME;
+                continue;
+            }
+            int y = index / (CHUNK_SIZE * CHUNK_SIZE);
+            int x = (index / CHUNK_SIZE) % CHUNK_SIZE;
+            int z = index % CHUNK_SIZE;
+            // Air over air leaves empty sections unallocated
+            if (air) {
+                Block old = chunk_get_block(chunk, x, y, z);
+                if (old.type == BLOCK_AIR && old.metadata == 0) {
+                    index++;
+                    continue;
+                }
+            }
+            chunk_set_block(chunk, x, y, z, b);
+            index++;
+        }
+    }
+    return p == end;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+uint8_t* chunk_codec_encode(Chunk* chunk, uint32_t* out_size) {
+    if (!chunk || !out_size) return NULL;
+
+    // Palette pass: the index width depends on the palette size
+    uint16_t lookup[256][CODEC_METADATA_VALUES];
+    memset(lookup, 0xFF, sizeof(lookup));
+    uint8_t palette[CODEC_MAX_PALETTE][2];
+    int palette_count = 0;
+
+    for (int i = 0; i < CHUNK_VOLUME; i++) {
+        // A uniform section needs one palette lookup, not 4096
+        Block b;
+        bool uniform = i % CHUNK_SECTION_VOLUME == 0 && chunk_section_uniform(chunk, i / CHUNK_SECTION_VOLUME, &b);
+        if (uniform) {
+            i += CHUNK_SECTION_VOLUME - 1;
+        } else {
+            b = block_at_index(chunk, i);
+        }
+        uint8_t meta = b.metadata & (CODEC_METADATA_VALUES - 1);
+        if (lookup[b.type][meta] == CODEC_NO_ENTRY) {
+            lookup[b.type][meta] = (uint16_t)palette_count;
+            palette[palette_count][0] = b.type;
+            palette[palette_count][1] = meta;
+            palette_count++;
+        }
+    }
+    int index_bytes = palette_count > 256 ? 2 : 1;
+
+    // Worst case: every block is its own run
+    size_t capacity = CODEC_HEADER_BYTES + (size_t)palette_count * 2 +
+                      (size_t)CHUNK_VOLUME * (index_bytes + 1);
+    uint8_t* data = (uint8_t*)malloc(capacity);
+    if (!data) return NULL;
+
+    uint8_t* p = data;
+    *p++ = CHUNK_CODEC_VERSION;
+    *p++ = (uint8_t)(palette_count & 0xFF);
+    *p++ = (uint8_t)(palette_count >> 8);
+    memcpy(p, palette, (size_t)palette_count * 2);
+    p += palette_count * 2;
+
+    uint16_t current = CODEC_NO_ENTRY;
+    uint32_t length = 0;
+    for (int i = 0; i <= CHUNK_VOLUME; i++) {
+        uint16_t entry = CODEC_NO_ENTRY;
+        uint32_t count = 1;
+        if (i < CHUNK_VOLUME) {
+            Block b;
+            if (i % CHUNK_SECTION_VOLUME == 0 && chunk_section_uniform(chunk, i / CHUNK_SECTION_VOLUME, &b)) {
+                count = CHUNK_SECTION_VOLUME;
+                i += CHUNK_SECTION_VOLUME - 1;
+            } else {
+                b = block_at_index(chunk, i);
+            }
+            entry = lookup[b.type][b.metadata & (CODEC_METADATA_VALUES - 1)];
+            if (entry == current) {
+                length += count;
+                continue;
+            }
+        }
+        if (length > 0) {
+            *p++ = (uint8_t)(current & 0xFF);
+            if (index_bytes == 2) *p++ = (uint8_t)(current >> 8);
+            p = put_varint(p, length);
+        }
+        current = entry;
+        length = count;
+    }
+
+    *out_size = (uint32_t)(p - data);
+    return data;
+}
+
+bool chunk_codec_decode(Chunk* chunk, const uint8_t* data, uint32_t size) {
+    if (!chunk || !data) return false;
+
+    // Validate first so bad data never leaves a half-written chunk
+    if (!decode_runs(NULL, data, size)) return false;
+    decode_runs(chunk, data, size);
+
+    chunk_compact_storage(chunk);
+    return true;
+}
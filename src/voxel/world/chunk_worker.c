@@ -8,7 +8,16 @@
 #include <time.h>
 #include <unistd.h>
 #include "voxel/world/chunk_worker.h"
+#include "voxel/core/profiler.h"
+#include "voxel/core/memory.h"
 #include "voxel/world/terrain.h"
+#include "voxel/world/region.h"
+#include "voxel/world/column_cache.h"
+#include "voxel/world/structure.h"
+#include "voxel/world/terrain_cache.h"
+#include "voxel/world/mesh_cache.h"
+#include "voxel/world/chunk_codec.h"
+#include "voxel/world/spawn.h"
 #include "voxel/entity/tree.h"
 #include "voxel/render/light.h"
 #include <stdio.h>
@@ -16,6 +25,9 @@
 #include <string.h>
 #include <raylib.h>
 
+_Static_assert(PROFILE_WORKER_MESH - PROFILE_WORKER_TERRAIN == CHUNK_STAGE_MESH,
+               "Worker profile zones follow ChunkStage");
+
 // ============================================================================
 // DYNAMIC THREAD COUNT
 // ============================================================================
@@ -30,85 +42,199 @@ static int get_optimal_thread_count(void) {
     return threads;
 }
 
-// ============================================================================
-// FORWARD DECLARATIONS
-// ============================================================================
-
-// Defined in chunk.c - generates mesh data without GPU upload
-void chunk_generate_mesh_staged(Chunk* chunk, StagedMesh* out);
-
 // ============================================================================
 // TASK QUEUE OPERATIONS
 // ============================================================================
 
 static void task_queue_init(TaskQueue* q) {
-    q->head = 0;
-    q->tail = 0;
+    q->tasks = NULL;
     q->count = 0;
+    q->capacity = 0;
     pthread_mutex_init(&q->mutex, NULL);
-    pthread_cond_init(&q->not_empty, NULL);
-    pthread_cond_init(&q->not_full, NULL);
 }
 
 static void task_queue_destroy(TaskQueue* q) {
+    // Remesh snapshots, border copies and a chunk reference are owned by their task
+    for (int i = 0; i < q->count; i++) {
+        if (q->tasks[i].snapshot) chunk_destroy(q->tasks[i].snapshot);
+        chunk_border_free(q->tasks[i].border);
+        chunk_release(q->tasks[i].chunk);
+    }
+    memory_track(MEMORY_WORKER, -(ptrdiff_t)((size_t)q->capacity * sizeof(ChunkTask)));
+    free(q->tasks);
+    q->tasks = NULL;
+    q->count = 0;
     pthread_mutex_destroy(&q->mutex);
-    pthread_cond_destroy(&q->not_empty);
-    pthread_cond_destroy(&q->not_full);
 }
 
 static bool task_queue_push(TaskQueue* q, ChunkTask task) {
     pthread_mutex_lock(&q->mutex);
 
-    // Return false if queue is full (non-blocking)
-    if (q->count >= TASK_QUEUE_SIZE) {
+    if (q->count == q->capacity) {
+        int capacity = q->capacity > 0 ? q->capacity * 2 : TASK_QUEUE_INITIAL;
+        ChunkTask* tasks = (ChunkTask*)realloc(q->tasks, (size_t)capacity * sizeof(ChunkTask));
+        if (!tasks) {
+            pthread_mutex_unlock(&q->mutex);
+            return false;
+        }
+        memory_track(MEMORY_WORKER, (ptrdiff_t)((size_t)(capacity - q->capacity) * sizeof(ChunkTask)));
+        q->tasks = tasks;
+        q->capacity = capacity;
+    }
+    q->tasks[q->count++] = task;
+
+    pthread_mutex_unlock(&q->mutex);
+    return true;
+}
+
+/**
+ * Lower value = run sooner: edits first, then distance² to the nearest focus
+ */
+static int task_priority(const ChunkTask* task, const WorkerFocus* focus, int focus_count) {
+    if (task->snapshot) return REMESH_TASK_PRIORITY;
+
+    int best = 0;
+    for (int i = 0; i < focus_count; i++) {
+        int dx = task->chunk_x - focus[i].chunk_x;
+        int dz = task->chunk_z - focus[i].chunk_z;
+        int dist = dx * dx + dz * dz;
+        if (i == 0 || dist < best) best = dist;
+    }
+    return best;
+}
+
+/**
+ * Remove and return the most urgent task, scored against the current focus
+ */
+static bool task_queue_take(TaskQueue* q, const WorkerFocus* focus, int focus_count, ChunkTask* out) {
+    pthread_mutex_lock(&q->mutex);
+    if (q->count == 0) {
         pthread_mutex_unlock(&q->mutex);
         return false;
     }
 
-    // Priority-sorted insertion: find position to insert
-    // Lower priority value = higher priority (closer to player)
-    // Tasks are stored so head has highest priority (lowest value)
-    int insert_pos = q->head;
-    int items_checked = 0;
-
-    // Find first task with lower priority (higher value) than new task
-    while (items_checked < q->count) {
-        int idx = (q->head + items_checked) % TASK_QUEUE_SIZE;
-        if (q->tasks[idx].priority > task.priority) {
-            insert_pos = idx;
-            break;
+    int best = 0;
+    int best_priority = task_priority(&q->tasks[0], focus, focus_count);
+    for (int i = 1; i < q->count && best_priority > REMESH_TASK_PRIORITY; i++) {
+        int priority = task_priority(&q->tasks[i], focus, focus_count);
+        if (priority < best_priority) {
+            best = i;
+            best_priority = priority;
         }
-        items_checked++;
     }
 
-    // If we checked all items, insert at tail
-    if (items_checked == q->count) {
-        q->tasks[q->tail] = task;
-    } else {
-        // Shift tasks from insert_pos to tail to make room
-        int shift_count = q->count - items_checked;
-        for (int i = shift_count - 1; i >= 0; i--) {
-            int src = (insert_pos + i) % TASK_QUEUE_SIZE;
-            int dst = (insert_pos + i + 1) % TASK_QUEUE_SIZE;
-            q->tasks[dst] = q->tasks[src];
+    *out = q->tasks[best];
+    q->tasks[best] = q->tasks[--q->count];  // Order is irrelevant, fill the hole from the end
+
+    pthread_mutex_unlock(&q->mutex);
+    return true;
+}
+
+/**
+ * Task's chunk lies in one of the windows
+ */
+static bool task_in_windows(const ChunkTask* task, const WorkerFocus* windows, int count) {
+    for (int i = 0; i < count; i++) {
+        if (abs(task->chunk_x - windows[i].chunk_x) <= windows[i].radius &&
+            abs(task->chunk_z - windows[i].chunk_z) <= windows[i].radius) {
+            return true;
         }
-        q->tasks[insert_pos] = task;
     }
+    return false;
+}
 
-    q->tail = (q->tail + 1) % TASK_QUEUE_SIZE;
-    q->count++;
+/**
+ * Remove generation tasks matching the filter; their chunks go back to EMPTY,
+ * or to GENERATED when only the mesh stage was pending
+ * chunk != NULL: only that chunk, otherwise everything outside the windows
+ */
+static int task_queue_cancel(TaskQueue* q, const Chunk* chunk, const WorkerFocus* windows, int count) {
+    int cancelled = 0;
+    pthread_mutex_lock(&q->mutex);
+    for (int i = 0; i < q->count; ) {
+        ChunkTask* task = &q->tasks[i];
+        bool match;
+        if (task->snapshot) {
+            match = false;  // Remeshes belong to loaded chunks, unloading waits for them
+        } else if (chunk) {
+            match = task->chunk == chunk;
+        } else {
+            match = !task_in_windows(task, windows, count);
+        }
 
-    pthread_cond_signal(&q->not_empty);
+        if (match) {
+            if (task->stage == CHUNK_STAGE_MESH) {
+                chunk_border_free(task->border);
+                chunk_set_state(task->chunk, CHUNK_STATE_GENERATED);
+            } else {
+                chunk_set_state(task->chunk, CHUNK_STATE_EMPTY);  // Terrain restarts from scratch
+            }
+            chunk_release(task->chunk);
+            *task = q->tasks[--q->count];
+            cancelled++;
+        } else {
+            i++;
+        }
+    }
     pthread_mutex_unlock(&q->mutex);
+    return cancelled;
+}
+
+/**
+ * Queue a task on thread index's queue and wake a sleeping worker
+ */
+static bool worker_submit_to(ChunkWorker* worker, int index, ChunkTask task) {
+    if (!task_queue_push(&worker->queues[index], task)) return false;
+
+    pthread_mutex_lock(&worker->sleep_mutex);
+    worker->pending_count++;
+    pthread_cond_signal(&worker->work_available);
+    pthread_mutex_unlock(&worker->sleep_mutex);
     return true;
 }
 
-static bool task_queue_pop(TaskQueue* q, ChunkTask* out, bool* running) {
-    pthread_mutex_lock(&q->mutex);
+/**
+ * Queue a task from the main thread, spreading tasks round-robin
+ */
+static bool worker_submit(ChunkWorker* worker, ChunkTask task) {
+    int index = worker->next_queue;
+    worker->next_queue = (worker->next_queue + 1) % worker->thread_count;
+    return worker_submit_to(worker, index, task);
+}
+
+static void worker_tasks_removed(ChunkWorker* worker, int count) {
+    if (count == 0) return;
+    pthread_mutex_lock(&worker->sleep_mutex);
+    worker->pending_count -= count;
+    pthread_mutex_unlock(&worker->sleep_mutex);
+}
+
+/**
+ * Next task for thread self: its own queue first, then steal from the others
+ */
+static bool worker_next_task(ChunkWorker* worker, int self, ChunkTask* out) {
+    WorkerFocus focus[WORKER_MAX_FOCUS];
+    pthread_mutex_lock(&worker->focus_mutex);
+    int focus_count = worker->focus_count;
+    memcpy(focus, worker->focus, (size_t)focus_count * sizeof(WorkerFocus));
+    pthread_mutex_unlock(&worker->focus_mutex);
 
-    // Wait for task or shutdown
-    while (q->count == 0 && *running) {
-        // Use timed wait to periodically check running flag
+    for (int i = 0; i < worker->thread_count; i++) {
+        TaskQueue* q = &worker->queues[(self + i) % worker->thread_count];
+        if (task_queue_take(q, focus, focus_count, out)) {
+            worker_tasks_removed(worker, 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Sleep until work is submitted (timed, so shutdown is noticed)
+ */
+static void worker_wait_for_work(ChunkWorker* worker) {
+    pthread_mutex_lock(&worker->sleep_mutex);
+    if (worker->pending_count == 0 && worker->running) {
         struct timespec ts;
         clock_gettime(CLOCK_REALTIME, &ts);
         ts.tv_nsec += 100000000;  // 100ms timeout
@@ -116,80 +242,261 @@ static bool task_queue_pop(TaskQueue* q, ChunkTask* out, bool* running) {
             ts.tv_sec++;
             ts.tv_nsec -= 1000000000;
         }
-        pthread_cond_timedwait(&q->not_empty, &q->mutex, &ts);
+        pthread_cond_timedwait(&worker->work_available, &worker->sleep_mutex, &ts);
     }
+    pthread_mutex_unlock(&worker->sleep_mutex);
+}
 
-    if (q->count == 0) {
-        pthread_mutex_unlock(&q->mutex);
-        return false;
+// ============================================================================
+// WORKER THREAD
+// ============================================================================
+
+/**
+ * Take a completed node from the thread's pool, allocating only when it is empty
+ */
+static CompletedChunk* completed_node_acquire(WorkerThread* thread) {
+    if (!thread->free_nodes) {
+        // Whole list at once: the main thread only pushes, so no ABA
+        thread->free_nodes = atomic_exchange_explicit(&thread->returned_nodes, NULL, memory_order_acquire);
+    }
+    CompletedChunk* node = thread->free_nodes;
+    if (node) {
+        thread->free_nodes = node->pool_next;
+        return node;
     }
+    node = (CompletedChunk*)malloc(sizeof(CompletedChunk));
+    if (node) {
+        node->owner = thread;
+        memory_track(MEMORY_WORKER, (ptrdiff_t)sizeof(CompletedChunk));
+    }
+    return node;
+}
 
-    *out = q->tasks[q->head];
-    q->head = (q->head + 1) % TASK_QUEUE_SIZE;
-    q->count--;
+/**
+ * Push onto the completed queue (any worker thread)
+ * The exchange orders producers; the consumer sees the link once prev->next is stored
+ */
+static void completed_queue_push(ChunkWorker* worker, CompletedChunk* node) {
+    atomic_store_explicit(&node->next, NULL, memory_order_relaxed);
+    CompletedChunk* prev = atomic_exchange_explicit(&worker->completed_head, node, memory_order_acq_rel);
+    atomic_store_explicit(&prev->next, node, memory_order_release);
+}
 
-    pthread_cond_signal(&q->not_full);
-    pthread_mutex_unlock(&q->mutex);
-    return true;
+/**
+ * Append a finished mesh to the completed queue for the main thread
+ * The task's chunk reference moves to the entry
+ */
+static void worker_publish(ChunkWorker* worker, int self, Chunk* chunk, StagedMesh mesh, bool remesh) {
+    CompletedChunk* completed = completed_node_acquire(&worker->thread_args[self]);
+    if (!completed) {
+        printf("[WORKER] Failed to allocate completed entry for chunk (%d, %d)\n", chunk->x, chunk->z);
+        staged_mesh_free(&mesh);
+        chunk_release(chunk);
+        return;
+    }
+    completed->chunk = chunk;
+    completed->mesh = mesh;
+    completed->remesh = remesh;
+    completed->pool_next = NULL;
+    completed_queue_push(worker, completed);
 }
 
-// ============================================================================
-// WORKER THREAD
-// ============================================================================
+static double worker_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+}
 
-static void* worker_thread_func(void* arg) {
-    ChunkWorker* worker = (ChunkWorker*)arg;
+static void worker_record_stage(ChunkWorker* worker, ChunkStage stage, double elapsed_ms) {
+    pthread_mutex_lock(&worker->stats_mutex);
+    ChunkStageStats* stats = &worker->stage_stats[stage];
+    stats->runs++;
+    stats->total_ms += elapsed_ms;
+    if (elapsed_ms > stats->max_ms) stats->max_ms = elapsed_ms;
+    pthread_mutex_unlock(&worker->stats_mutex);
+}
 
-    printf("[WORKER] Thread started\n");
+/**
+ * Mesh a remesh snapshot; the live chunk is never touched here
+ */
+static void worker_run_remesh(ChunkWorker* worker, int self, ChunkTask* task) {
+    Chunk* snapshot = task->snapshot;
+    snapshot->border = task->border;  // Freed with the snapshot
+    if (chunk_is_detached(task->chunk)) {
+        chunk_destroy(snapshot);  // Unloaded meanwhile, nothing to upload to
+        chunk_release(task->chunk);
+        return;
+    }
 
-    while (worker->running) {
-        ChunkTask task;
-        if (!task_queue_pop(&worker->pending, &task, &worker->running)) {
-            continue;  // Timeout or shutdown
-        }
+    StagedMesh mesh = {0};
+    uint16_t mask = snapshot->dirty_sections;
+    if (mask == CHUNK_SECTIONS_ALL) {
+        chunk_generate_mesh_staged(snapshot, &mesh);
+    } else {
+        chunk_generate_sections_staged(snapshot, mask, &mesh);
+    }
+    chunk_destroy(snapshot);
+    worker_publish(worker, self, task->chunk, mesh, true);
+}
 
-        if (!task.valid || !task.chunk) {
-            continue;
-        }
+/**
+ * Plan the animals of a chunk whose blocks just became final
+ * Saved chunks that already spawned keep the animals they had.
+ */
+static void worker_plan_spawns(ChunkWorker* worker, Chunk* chunk) {
+    chunk->spawn_count = 0;
+    chunk->spawn_placed = 0;
+    if (chunk->has_spawned || !worker->columns) return;
+    chunk->spawn_count = (uint8_t)spawn_plan_chunk(worker->columns, chunk->x, chunk->z,
+                                                   chunk->spawns, CHUNK_SPAWN_MAX);
+}
+
+/**
+ * Run one pipeline stage of a generation task
+ * Chunk-local stages queue their successor on this thread's own queue, so
+ * the chunk usually stays in this core's cache. The task's chunk reference
+ * travels with it and is dropped by the stage that ends the chain
+ */
+static void worker_run_stage(ChunkWorker* worker, int self, ChunkTask* task) {
+    Chunk* chunk = task->chunk;
+    ColumnMap columns;
+
+    // The world let go of the chunk: stop at the stage boundary
+    if (chunk_is_detached(chunk)) {
+        chunk_border_free(task->border);
+        chunk_release(chunk);
+        return;
+    }
+
+    switch (task->stage) {
+        case CHUNK_STAGE_TERRAIN:
+            chunk_set_state(chunk, CHUNK_STATE_GENERATING);
+
+            // Chunks streamed from a host arrive decorated but unlit
+            if (chunk->remote_data) {
+                bool decoded = chunk_codec_decode(chunk, chunk->remote_data, chunk->remote_size);
+                free(chunk->remote_data);
+                chunk->remote_data = NULL;
+                if (decoded) {
+                    // The host's chunk already holds its neighbors' trees
+                    StructureFragment* dropped;
+                    structure_store_claim(worker->structures, chunk->x, chunk->z, &dropped);
+                    free(dropped);
+
+                    light_calculate_chunk(chunk);
+                    chunk_update_empty_status(chunk);
+                    chunk_update_surface(chunk);
+                    chunk_set_state(chunk, CHUNK_STATE_GENERATED);
+                    chunk_release(chunk);
+                    return;
+                }
+                printf("[WORKER] Bad streamed chunk (%d, %d), generating locally\n", chunk->x, chunk->z);
+            }
+
+            // Saved chunks already hold their decoration and light levels
+            if (worker->storage && region_storage_load_chunk(worker->storage, chunk)) {
+                // Trees generated next to it since it was saved
+                if (tree_apply_pending(chunk, worker->structures) > 0) {
+                    light_calculate_chunk(chunk);
+                    chunk->needs_save = true;
+                }
+                chunk_update_empty_status(chunk);
+                chunk_update_surface(chunk);
+                worker_plan_spawns(worker, chunk);
+                chunk_set_state(chunk, CHUNK_STATE_GENERATED);
+                chunk_release(chunk);
+                return;
+            }
+            if (!terrain_cache_load(worker->terrain_cache, chunk)) {
+                if (worker->columns) column_cache_get_map(worker->columns, chunk->x, chunk->z, &columns);
+                terrain_generate_chunk(chunk, task->terrain_params, worker->columns ? &columns : NULL);
+                terrain_cache_store(worker->terrain_cache, chunk);
+            }
+            chunk->needs_save = true;
+            break;
+
+        case CHUNK_STAGE_DECORATE:
+            if (worker->columns) column_cache_get_map(worker->columns, chunk->x, chunk->z, &columns);
+            tree_generate_for_chunk(chunk, worker->columns ? &columns : NULL, worker->structures);
+            break;
 
-        Chunk* chunk = task.chunk;
+        case CHUNK_STAGE_LIGHT:
+            // Must run after all blocks are placed
+            light_calculate_chunk(chunk);
+            chunk_update_empty_status(chunk);
+            chunk_update_surface(chunk);
+            worker_plan_spawns(worker, chunk);
+            chunk_set_state(chunk, CHUNK_STATE_GENERATED);  // World submits the mesh stage once neighbors are ready
+            chunk_release(chunk);
+            return;
+
+        case CHUNK_STAGE_MESH: {
+            // Generate mesh data (CPU only, no GPU upload), or read the
+            // mesh an earlier run made from the same blocks
+            chunk->border = task->border;
+            StagedMesh mesh = {0};
+            uint64_t key = worker->mesh_cache ? mesh_cache_key(chunk, task->border) : 0;
+            if (!mesh_cache_load(worker->mesh_cache, chunk, key, &mesh)) {
+                chunk_generate_mesh_staged(chunk, &mesh);
+                mesh_cache_store(worker->mesh_cache, chunk, key, &mesh);
+            }
+            chunk->border = NULL;
+            chunk_border_free(task->border);
+            chunk->dirty_sections = 0;
+
+            // Mark chunk as ready for upload before publishing it, so the main
+            // thread can never observe COMPLETE and have it overwritten afterwards
+            chunk_set_state(chunk, CHUNK_STATE_READY);
+            worker_publish(worker, self, chunk, mesh, false);
+            return;
+        }
 
-        // Mark chunk as generating
-        chunk->state = CHUNK_STATE_GENERATING;
+        default:
+            return;
+    }
 
-        // Generate terrain
-        terrain_generate_chunk(chunk, task.terrain_params);
+    task->stage = (ChunkStage)(task->stage + 1);
+    if (!worker_submit_to(worker, self, *task)) {
+        chunk_set_state(chunk, CHUNK_STATE_EMPTY);  // Out of memory, the world restarts it next frame
+        chunk_release(chunk);
+    }
+}
 
-        // Update empty status
-        chunk_update_empty_status(chunk);
+static void* worker_thread_func(void* arg) {
+    WorkerThread* self = (WorkerThread*)arg;
+    ChunkWorker* worker = self->worker;
 
-        // Calculate lighting
-        light_calculate_chunk(chunk);
+    printf("[WORKER] Thread %d started\n", self->index);
+    mesh_arena_bind(&self->arena);
+    char thread_name[32];
+    snprintf(thread_name, sizeof(thread_name), "worker %d", self->index);
+    profiler_set_thread_name(thread_name);
 
-        // Generate mesh data (CPU only, no GPU upload)
-        StagedMesh mesh = {0};
-        chunk_generate_mesh_staged(chunk, &mesh);
+    while (atomic_load_explicit(&worker->running, memory_order_relaxed)) {
+        ChunkTask task;
+        if (!worker_next_task(worker, self->index, &task)) {
+            worker_wait_for_work(worker);
+            continue;  // Timeout, new work or shutdown
+        }
 
-        // Add to completed list
-        CompletedChunk* completed = (CompletedChunk*)malloc(sizeof(CompletedChunk));
-        completed->chunk = chunk;
-        completed->mesh = mesh;
-        completed->next = NULL;
+        if (!task.chunk) {
+            continue;
+        }
 
-        pthread_mutex_lock(&worker->completed_mutex);
-        if (worker->completed_tail) {
-            worker->completed_tail->next = completed;
-            worker->completed_tail = completed;
+        ChunkStage stage = task.stage;  // worker_run_stage advances it when chaining
+        double start = worker_now_ms();
+        uint64_t profile_start = profiler_begin();
+        ProfileZone zone = task.snapshot ? PROFILE_WORKER_REMESH : (ProfileZone)(PROFILE_WORKER_TERRAIN + stage);
+        if (task.snapshot) {
+            worker_run_remesh(worker, self->index, &task);
         } else {
-            worker->completed_head = completed;
-            worker->completed_tail = completed;
+            worker_run_stage(worker, self->index, &task);
         }
-        pthread_mutex_unlock(&worker->completed_mutex);
-
-        // Mark chunk as ready for upload
-        chunk->state = CHUNK_STATE_READY;
+        profiler_end(zone, profile_start);
+        worker_record_stage(worker, stage, worker_now_ms() - start);
     }
 
+    mesh_arena_bind(NULL);
     printf("[WORKER] Thread exiting\n");
     return NULL;
 }
@@ -208,23 +515,41 @@ ChunkWorker* chunk_worker_create(void) {
     // Determine optimal thread count based on CPU cores
     worker->thread_count = get_optimal_thread_count();
 
-    // Allocate thread array
+    // Allocate thread array and one queue per thread
     worker->threads = (pthread_t*)malloc(worker->thread_count * sizeof(pthread_t));
-    if (!worker->threads) {
+    worker->thread_args = (WorkerThread*)malloc(worker->thread_count * sizeof(WorkerThread));
+    worker->queues = (TaskQueue*)malloc(worker->thread_count * sizeof(TaskQueue));
+    if (!worker->threads || !worker->thread_args || !worker->queues) {
         printf("[WORKER] Failed to allocate thread array\n");
+        free(worker->threads);
+        free(worker->thread_args);
+        free(worker->queues);
         free(worker);
         return NULL;
     }
 
-    task_queue_init(&worker->pending);
-    worker->completed_head = NULL;
-    worker->completed_tail = NULL;
-    pthread_mutex_init(&worker->completed_mutex, NULL);
-    worker->running = true;
+    for (int i = 0; i < worker->thread_count; i++) {
+        task_queue_init(&worker->queues[i]);
+    }
+    pthread_mutex_init(&worker->sleep_mutex, NULL);
+    pthread_cond_init(&worker->work_available, NULL);
+    pthread_mutex_init(&worker->focus_mutex, NULL);
+    pthread_mutex_init(&worker->stats_mutex, NULL);
+    atomic_init(&worker->completed_stub.next, NULL);
+    worker->completed_stub.owner = NULL;
+    atomic_init(&worker->completed_head, &worker->completed_stub);
+    worker->completed_tail = &worker->completed_stub;
+    atomic_init(&worker->running, true);
 
     // Start worker threads
     for (int i = 0; i < worker->thread_count; i++) {
-        if (pthread_create(&worker->threads[i], NULL, worker_thread_func, worker) != 0) {
+        WorkerThread* thread = &worker->thread_args[i];
+        thread->worker = worker;
+        thread->index = i;
+        mesh_arena_init(&thread->arena);
+        thread->free_nodes = NULL;
+        atomic_init(&thread->returned_nodes, NULL);
+        if (pthread_create(&worker->threads[i], NULL, worker_thread_func, &worker->thread_args[i]) != 0) {
             printf("[WORKER] Failed to create thread %d\n", i);
         }
     }
@@ -240,12 +565,12 @@ void chunk_worker_destroy(ChunkWorker* worker) {
     printf("[WORKER] Shutting down %d threads...\n", worker->thread_count);
 
     // Signal threads to stop
-    worker->running = false;
+    atomic_store(&worker->running, false);
 
     // Wake up all waiting threads
-    pthread_mutex_lock(&worker->pending.mutex);
-    pthread_cond_broadcast(&worker->pending.not_empty);
-    pthread_mutex_unlock(&worker->pending.mutex);
+    pthread_mutex_lock(&worker->sleep_mutex);
+    pthread_cond_broadcast(&worker->work_available);
+    pthread_mutex_unlock(&worker->sleep_mutex);
 
     // Wait for threads to finish
     for (int i = 0; i < worker->thread_count; i++) {
@@ -253,225 +578,376 @@ void chunk_worker_destroy(ChunkWorker* worker) {
     }
 
     // Clean up pending tasks
-    task_queue_destroy(&worker->pending);
+    for (int i = 0; i < worker->thread_count; i++) {
+        task_queue_destroy(&worker->queues[i]);
+    }
+    pthread_mutex_destroy(&worker->sleep_mutex);
+    pthread_cond_destroy(&worker->work_available);
+    pthread_mutex_destroy(&worker->focus_mutex);
+
+    // Per-stage timing summary
+    static const char* stage_names[CHUNK_STAGE_COUNT] = { "terrain", "decorate", "light", "mesh" };
+    for (int i = 0; i < CHUNK_STAGE_COUNT; i++) {
+        const ChunkStageStats* stats = &worker->stage_stats[i];
+        if (stats->runs == 0) continue;
+        printf("[WORKER] Stage %-8s %6d runs, avg %.2f ms, max %.2f ms\n", stage_names[i],
+               stats->runs, stats->total_ms / stats->runs, stats->max_ms);
+    }
+    pthread_mutex_destroy(&worker->stats_mutex);
 
-    // Clean up completed list
-    pthread_mutex_lock(&worker->completed_mutex);
-    CompletedChunk* node = worker->completed_head;
-    while (node) {
-        CompletedChunk* next = node->next;
-        staged_mesh_free(&node->mesh);
-        free(node);
-        node = next;
+    // Clean up completed queue, then the pools its nodes and blocks return to
+    CompletedChunk* node;
+    while ((node = chunk_worker_poll_completed(worker)) != NULL) {
+        chunk_worker_release_completed(node);
+    }
+    for (int i = 0; i < worker->thread_count; i++) {
+        WorkerThread* thread = &worker->thread_args[i];
+        for (int pass = 0; pass < 2; pass++) {
+            node = pass == 0 ? thread->free_nodes : atomic_load(&thread->returned_nodes);
+            while (node) {
+                CompletedChunk* next = node->pool_next;
+                memory_track(MEMORY_WORKER, -(ptrdiff_t)sizeof(CompletedChunk));
+                free(node);
+                node = next;
+            }
+        }
+        mesh_arena_destroy(&thread->arena);
     }
-    pthread_mutex_unlock(&worker->completed_mutex);
-    pthread_mutex_destroy(&worker->completed_mutex);
 
-    // Free thread array
+    // Free thread arrays
     free(worker->threads);
+    free(worker->thread_args);
+    free(worker->queues);
     free(worker);
     printf("[WORKER] Shutdown complete\n");
 }
 
-bool chunk_worker_enqueue(ChunkWorker* worker, Chunk* chunk, TerrainParams params,
-                          int center_chunk_x, int center_chunk_z) {
+void chunk_worker_set_storage(ChunkWorker* worker, RegionStorage* storage) {
+    if (!worker) return;
+    worker->storage = storage;
+}
+
+void chunk_worker_set_columns(ChunkWorker* worker, ColumnCache* columns) {
+    if (!worker) return;
+    worker->columns = columns;
+}
+
+void chunk_worker_set_structures(ChunkWorker* worker, StructureStore* structures) {
+    if (!worker) return;
+    worker->structures = structures;
+}
+
+void chunk_worker_set_terrain_cache(ChunkWorker* worker, TerrainCache* cache) {
+    if (!worker) return;
+    worker->terrain_cache = cache;
+}
+
+void chunk_worker_set_mesh_cache(ChunkWorker* worker, MeshCache* cache) {
+    if (!worker) return;
+    worker->mesh_cache = cache;
+}
+
+bool chunk_worker_enqueue(ChunkWorker* worker, Chunk* chunk, TerrainParams params) {
     if (!worker || !chunk) return false;
 
     // Don't enqueue if already generating or complete
-    if (chunk->state != CHUNK_STATE_EMPTY) {
+    if (chunk_get_state(chunk) != CHUNK_STATE_EMPTY) {
         return false;
     }
 
-    // Calculate priority based on distance² from center (lower = higher priority)
-    int dx = chunk->x - center_chunk_x;
-    int dz = chunk->z - center_chunk_z;
-    int priority = dx * dx + dz * dz;
-
+    // Priority is not fixed here: workers score tasks against the focus when they pick one
     ChunkTask task = {
         .chunk = chunk,
+        .snapshot = NULL,
+        .border = NULL,
         .terrain_params = params,
-        .valid = true,
-        .priority = priority
+        .stage = CHUNK_STAGE_TERRAIN,
+        .chunk_x = chunk->x,
+        .chunk_z = chunk->z
     };
 
-    return task_queue_push(&worker->pending, task);
+    // Set before pushing: a worker may pop the task and mark it GENERATING immediately
+    chunk_set_state(chunk, CHUNK_STATE_QUEUED);
+    chunk_retain(chunk);
+    if (!worker_submit(worker, task)) {
+        chunk_release(chunk);
+        chunk_set_state(chunk, CHUNK_STATE_EMPTY);  // Out of memory, retried next frame
+        return false;
+    }
+    return true;
+}
+
+void chunk_worker_set_focus(ChunkWorker* worker, const WorkerFocus* focus, int count) {
+    if (!worker) return;
+    if (count < 0) count = 0;
+    if (count > WORKER_MAX_FOCUS) count = WORKER_MAX_FOCUS;
+
+    pthread_mutex_lock(&worker->focus_mutex);
+    memcpy(worker->focus, focus, (size_t)count * sizeof(WorkerFocus));
+    worker->focus_count = count;
+    pthread_mutex_unlock(&worker->focus_mutex);
+}
+
+int chunk_worker_cancel_outside(ChunkWorker* worker, const WorkerFocus* windows, int count) {
+    if (!worker) return 0;
+
+    int cancelled = 0;
+    for (int i = 0; i < worker->thread_count; i++) {
+        cancelled += task_queue_cancel(&worker->queues[i], NULL, windows, count);
+    }
+    worker_tasks_removed(worker, cancelled);
+    return cancelled;
+}
+
+bool chunk_worker_enqueue_mesh(ChunkWorker* worker, Chunk* chunk, ChunkBorder* border) {
+    if (!worker || !chunk || chunk_get_state(chunk) != CHUNK_STATE_GENERATED) {
+        chunk_border_free(border);
+        return false;
+    }
+
+    ChunkTask task = {
+        .chunk = chunk,
+        .snapshot = NULL,
+        .border = border,
+        .stage = CHUNK_STAGE_MESH,
+        .chunk_x = chunk->x,
+        .chunk_z = chunk->z
+    };
+
+    chunk_set_state(chunk, CHUNK_STATE_MESHING);
+    chunk_retain(chunk);
+    if (!worker_submit(worker, task)) {
+        chunk_border_free(border);
+        chunk_release(chunk);
+        chunk_set_state(chunk, CHUNK_STATE_GENERATED);  // Out of memory, retried next frame
+        return false;
+    }
+    return true;
+}
+
+bool chunk_worker_enqueue_remesh(ChunkWorker* worker, Chunk* chunk, ChunkBorder* border) {
+    if (!worker || !chunk || chunk->remesh_pending) {
+        chunk_border_free(border);
+        return false;
+    }
+
+    Chunk* snapshot = chunk_snapshot(chunk);
+    if (!snapshot) {
+        chunk_border_free(border);
+        return false;
+    }
+
+    // Few dirty sections are meshed alone and spliced in; otherwise remesh all
+    uint16_t mask = chunk->dirty_sections;
+    if (mask == 0 || __builtin_popcount(mask) > REMESH_PARTIAL_MAX_SECTIONS) {
+        mask = CHUNK_SECTIONS_ALL;
+    }
+    snapshot->dirty_sections = mask;
+
+    ChunkTask task = {
+        .chunk = chunk,
+        .snapshot = snapshot,
+        .border = border,
+        .stage = CHUNK_STAGE_MESH,
+        .chunk_x = chunk->x,
+        .chunk_z = chunk->z
+    };
+
+    chunk_retain(chunk);
+    if (!worker_submit(worker, task)) {
+        chunk_destroy(snapshot);
+        chunk_border_free(border);
+        chunk_release(chunk);
+        return false;  // Out of memory, stays dirty and is retried next frame
+    }
+
+    chunk->remesh_pending = true;
+    chunk->dirty_sections = 0;  // Edits from now on belong to the next remesh
+    return true;
+}
+
+bool chunk_worker_cancel(ChunkWorker* worker, Chunk* chunk) {
+    if (!worker || !chunk) return false;
+
+    int cancelled = 0;
+    for (int i = 0; i < worker->thread_count; i++) {
+        cancelled += task_queue_cancel(&worker->queues[i], chunk, NULL, 0);
+    }
+    worker_tasks_removed(worker, cancelled);
+    return cancelled > 0;
 }
 
 CompletedChunk* chunk_worker_poll_completed(ChunkWorker* worker) {
     if (!worker) return NULL;
 
-    pthread_mutex_lock(&worker->completed_mutex);
+    // Intrusive MPSC queue (Vyukov): the stub node stands in whenever the queue runs dry
+    CompletedChunk* tail = worker->completed_tail;
+    CompletedChunk* next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    if (tail == &worker->completed_stub) {
+        if (!next) return NULL;
+        worker->completed_tail = next;
+        tail = next;
+        next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    }
+    if (next) {
+        worker->completed_tail = next;
+        return tail;
+    }
 
-    CompletedChunk* result = worker->completed_head;
-    if (result) {
-        worker->completed_head = result->next;
-        if (!worker->completed_head) {
-            worker->completed_tail = NULL;
+    // tail is the last node: a push in progress has swapped the head but not linked yet
+    if (tail != atomic_load_explicit(&worker->completed_head, memory_order_acquire)) {
+        return NULL;  // Picked up next frame
+    }
+    completed_queue_push(worker, &worker->completed_stub);
+    next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    if (next) {
+        worker->completed_tail = next;
+        return tail;
+    }
+    return NULL;
+}
+
+void chunk_worker_release_completed(CompletedChunk* completed) {
+    if (!completed) return;
+
+    staged_mesh_free(&completed->mesh);
+    chunk_release(completed->chunk);
+    WorkerThread* owner = completed->owner;
+    CompletedChunk* head = atomic_load_explicit(&owner->returned_nodes, memory_order_relaxed);
+    do {
+        completed->pool_next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&owner->returned_nodes, &head, completed,
+                                                    memory_order_release, memory_order_relaxed));
+}
+
+/**
+ * Replace the dirty sections of one chunk mesh with freshly meshed ones
+ * Unchanged sections are copied from the previous buffer on the GPU
+ */
+static void splice_section_mesh(Chunk* chunk, ChunkMesh* target, bool* generated, ChunkMeshRanges* ranges,
+                                uint16_t mask, const ChunkVertex* vertices, const int* new_start) {
+    int lengths[CHUNK_SECTION_COUNT];
+    int total = 0;
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        lengths[sy] = (mask & (1u << sy)) ? new_start[sy + 1] - new_start[sy]
+                                          : ranges->start[sy + 1] - ranges->start[sy];
+        total += lengths[sy];
+    }
+
+    ChunkMesh spliced = {0};
+    bool uploaded = chunk_mesh_upload(&spliced, NULL, total, false, MEMORY_GPU_CHUNK);
+    if (!uploaded && total > 0) {
+        printf("[WORKER] Failed to allocate spliced mesh of chunk (%d, %d)\n", chunk->x, chunk->z);
+        chunk_mark_sections_dirty(chunk, mask);
+        return;
+    }
+
+    int first = -1;
+    int end = 0;
+    int offset = 0;
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        bool dirty = (mask & (1u << sy)) != 0;
+        int len = lengths[sy];
+
+        if (len > 0) {
+            if (dirty) {
+                chunk_mesh_write(&spliced, offset, vertices + new_start[sy], len);
+            } else {
+                chunk_mesh_copy(spliced.vbo_id, offset, target, ranges->start[sy], len);
+            }
+        }
+        if (dirty) {
+            if (first < 0) first = offset;
+            end = offset + len;
         }
-        result->next = NULL;
+        ranges->start[sy] = offset;
+        offset += len;
     }
+    ranges->start[CHUNK_SECTION_COUNT] = total;
+    ranges->splice_first = first < 0 ? 0 : first;
+    ranges->splice_end = end;
 
-    pthread_mutex_unlock(&worker->completed_mutex);
-    return result;
+    chunk_mesh_unload(target);
+    *target = spliced;
+    *generated = uploaded;
+}
+
+/**
+ * Give a staged pass its own GPU buffers; the staged vertices go back to their arena
+ */
+static bool upload_staged_mesh(ChunkMesh* target, ChunkVertex** vertices, int vertex_count) {
+    chunk_mesh_unload(target);
+    bool uploaded = chunk_mesh_upload(target, *vertices, vertex_count, false, MEMORY_GPU_CHUNK);
+    mesh_block_free(*vertices);
+    *vertices = NULL;
+    return uploaded;
 }
 
 void chunk_worker_upload_mesh(Chunk* chunk, StagedMesh* mesh) {
     if (!chunk || !mesh || !mesh->valid) return;
 
-    // === Upload OPAQUE mesh ===
-    if (chunk->mesh_generated && chunk->mesh.vboId != NULL) {
-        UnloadMesh(chunk->mesh);
-        chunk->mesh_generated = false;
-        memset(&chunk->mesh, 0, sizeof(Mesh));
-    }
-
-    if (mesh->vertex_count > 0) {
-        chunk->mesh.vertexCount = mesh->vertex_count;
-        chunk->mesh.triangleCount = mesh->vertex_count / 3;
-        chunk->mesh.vertices = mesh->vertices;
-        chunk->mesh.texcoords = mesh->texcoords;
-        chunk->mesh.normals = mesh->normals;
-        chunk->mesh.colors = mesh->colors;
-        UploadMesh(&chunk->mesh, false);
-        chunk->mesh_generated = true;
-
-        // Don't free buffers - they're now owned by the mesh
-        mesh->vertices = NULL;
-        mesh->texcoords = NULL;
-        mesh->normals = NULL;
-        mesh->colors = NULL;
-    }
-
-    // === Upload TRANSPARENT mesh ===
-    if (chunk->transparent_mesh_generated && chunk->transparent_mesh.vboId != NULL) {
-        UnloadMesh(chunk->transparent_mesh);
-        chunk->transparent_mesh_generated = false;
-        memset(&chunk->transparent_mesh, 0, sizeof(Mesh));
-    }
-
-    if (mesh->trans_vertex_count > 0) {
-        chunk->transparent_mesh.vertexCount = mesh->trans_vertex_count;
-        chunk->transparent_mesh.triangleCount = mesh->trans_vertex_count / 3;
-        chunk->transparent_mesh.vertices = mesh->trans_vertices;
-        chunk->transparent_mesh.texcoords = mesh->trans_texcoords;
-        chunk->transparent_mesh.normals = mesh->trans_normals;
-        chunk->transparent_mesh.colors = mesh->trans_colors;
-        UploadMesh(&chunk->transparent_mesh, false);
-        chunk->transparent_mesh_generated = true;
-
-        // Don't free buffers - they're now owned by the mesh
-        mesh->trans_vertices = NULL;
-        mesh->trans_texcoords = NULL;
-        mesh->trans_normals = NULL;
-        mesh->trans_colors = NULL;
-    }
-
-    // === Upload LOD OPAQUE mesh ===
-    if (chunk->lod_generated && chunk->mesh_lod.vboId != NULL) {
-        UnloadMesh(chunk->mesh_lod);
-        memset(&chunk->mesh_lod, 0, sizeof(Mesh));
-    }
-
-    if (mesh->lod_vertex_count > 0) {
-        chunk->mesh_lod.vertexCount = mesh->lod_vertex_count;
-        chunk->mesh_lod.triangleCount = mesh->lod_vertex_count / 3;
-        chunk->mesh_lod.vertices = mesh->lod_vertices;
-        chunk->mesh_lod.texcoords = mesh->lod_texcoords;
-        chunk->mesh_lod.normals = mesh->lod_normals;
-        chunk->mesh_lod.colors = mesh->lod_colors;
-        UploadMesh(&chunk->mesh_lod, false);
-
-        mesh->lod_vertices = NULL;
-        mesh->lod_texcoords = NULL;
-        mesh->lod_normals = NULL;
-        mesh->lod_colors = NULL;
-    }
-
-    // === Upload LOD TRANSPARENT mesh ===
-    if (chunk->lod_generated && chunk->transparent_mesh_lod.vboId != NULL) {
-        UnloadMesh(chunk->transparent_mesh_lod);
-        memset(&chunk->transparent_mesh_lod, 0, sizeof(Mesh));
-    }
-
-    if (mesh->lod_trans_vertex_count > 0) {
-        chunk->transparent_mesh_lod.vertexCount = mesh->lod_trans_vertex_count;
-        chunk->transparent_mesh_lod.triangleCount = mesh->lod_trans_vertex_count / 3;
-        chunk->transparent_mesh_lod.vertices = mesh->lod_trans_vertices;
-        chunk->transparent_mesh_lod.texcoords = mesh->lod_trans_texcoords;
-        chunk->transparent_mesh_lod.normals = mesh->lod_trans_normals;
-        chunk->transparent_mesh_lod.colors = mesh->lod_trans_colors;
-        UploadMesh(&chunk->transparent_mesh_lod, false);
-
-        mesh->lod_trans_vertices = NULL;
-        mesh->lod_trans_texcoords = NULL;
-        mesh->lod_trans_normals = NULL;
-        mesh->lod_trans_colors = NULL;
-    }
-
-    // Mark LOD as generated if any LOD mesh was uploaded
-    chunk->lod_generated = (mesh->lod_vertex_count > 0 || mesh->lod_trans_vertex_count > 0);
+    // Block edits change which faces of a section see each other
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        if (mesh->section_mask == 0 || (mesh->section_mask & (1u << sy))) {
+            chunk->section_visibility[sy] = mesh->visibility[sy];
+        }
+    }
+
+    // === Partial remesh: splice dirty sections into the current meshes ===
+    if (mesh->section_mask != 0) {
+        splice_section_mesh(chunk, &chunk->mesh, &chunk->mesh_generated, &chunk->mesh_ranges,
+                            mesh->section_mask, mesh->vertices, mesh->section_start);
+        splice_section_mesh(chunk, &chunk->transparent_mesh, &chunk->transparent_mesh_generated,
+                            &chunk->transparent_ranges, mesh->section_mask, mesh->trans_vertices,
+                            mesh->trans_section_start);
+        staged_mesh_free(mesh);
+        chunk->needs_remesh = false;
+        return;
+    }
+
+    memcpy(chunk->mesh_ranges.start, mesh->section_start, sizeof(chunk->mesh_ranges.start));
+    memcpy(chunk->transparent_ranges.start, mesh->trans_section_start, sizeof(chunk->transparent_ranges.start));
+    chunk->mesh_ranges.splice_first = 0;
+    chunk->mesh_ranges.splice_end = mesh->vertex_count;
+    chunk->transparent_ranges.splice_first = 0;
+    chunk->transparent_ranges.splice_end = mesh->trans_vertex_count;
+
+    chunk->mesh_generated = upload_staged_mesh(&chunk->mesh, &mesh->vertices, mesh->vertex_count);
+    chunk->transparent_mesh_generated = upload_staged_mesh(&chunk->transparent_mesh, &mesh->trans_vertices,
+                                                           mesh->trans_vertex_count);
 
     chunk->needs_remesh = false;
-    chunk->state = CHUNK_STATE_COMPLETE;
+    chunk_set_state(chunk, CHUNK_STATE_COMPLETE);
     mesh->valid = false;
 }
 
 void staged_mesh_free(StagedMesh* mesh) {
     if (!mesh) return;
 
-    // Free opaque mesh buffers
-    if (mesh->vertices) free(mesh->vertices);
-    if (mesh->texcoords) free(mesh->texcoords);
-    if (mesh->normals) free(mesh->normals);
-    if (mesh->colors) free(mesh->colors);
-
-    // Free transparent mesh buffers
-    if (mesh->trans_vertices) free(mesh->trans_vertices);
-    if (mesh->trans_texcoords) free(mesh->trans_texcoords);
-    if (mesh->trans_normals) free(mesh->trans_normals);
-    if (mesh->trans_colors) free(mesh->trans_colors);
-
-    // Free LOD opaque mesh buffers
-    if (mesh->lod_vertices) free(mesh->lod_vertices);
-    if (mesh->lod_texcoords) free(mesh->lod_texcoords);
-    if (mesh->lod_normals) free(mesh->lod_normals);
-    if (mesh->lod_colors) free(mesh->lod_colors);
-
-    // Free LOD transparent mesh buffers
-    if (mesh->lod_trans_vertices) free(mesh->lod_trans_vertices);
-    if (mesh->lod_trans_texcoords) free(mesh->lod_trans_texcoords);
-    if (mesh->lod_trans_normals) free(mesh->lod_trans_normals);
-    if (mesh->lod_trans_colors) free(mesh->lod_trans_colors);
+    mesh_block_free(mesh->vertices);
+    mesh_block_free(mesh->trans_vertices);
 
     mesh->vertices = NULL;
-    mesh->texcoords = NULL;
-    mesh->normals = NULL;
-    mesh->colors = NULL;
     mesh->vertex_count = 0;
     mesh->trans_vertices = NULL;
-    mesh->trans_texcoords = NULL;
-    mesh->trans_normals = NULL;
-    mesh->trans_colors = NULL;
     mesh->trans_vertex_count = 0;
-    mesh->lod_vertices = NULL;
-    mesh->lod_texcoords = NULL;
-    mesh->lod_normals = NULL;
-    mesh->lod_colors = NULL;
-    mesh->lod_vertex_count = 0;
-    mesh->lod_trans_vertices = NULL;
-    mesh->lod_trans_texcoords = NULL;
-    mesh->lod_trans_normals = NULL;
-    mesh->lod_trans_colors = NULL;
-    mesh->lod_trans_vertex_count = 0;
     mesh->valid = false;
 }
 
 int chunk_worker_pending_count(ChunkWorker* worker) {
     if (!worker) return 0;
 
-    pthread_mutex_lock(&worker->pending.mutex);
-    int count = worker->pending.count;
-    pthread_mutex_unlock(&worker->pending.mutex);
+    pthread_mutex_lock(&worker->sleep_mutex);
+    int count = worker->pending_count;
+    pthread_mutex_unlock(&worker->sleep_mutex);
 
     return count;
 }
+
+void chunk_worker_get_stage_stats(ChunkWorker* worker, ChunkStageStats out[CHUNK_STAGE_COUNT]) {
+    if (!worker || !out) return;
+
+    pthread_mutex_lock(&worker->stats_mutex);
+    memcpy(out, worker->stage_stats, sizeof(worker->stage_stats));
+    pthread_mutex_unlock(&worker->stats_mutex);
+}
@@ -0,0 +1,170 @@
+/**
+ * Column Cache Implementation
+ *
+ * Regions are computed outside the lock; if two threads miss the same
+ * region at once, the first insert wins and the other copy is dropped.
+ */
+
+#include "voxel/world/column_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+static uint32_t hash_region_coords(int x, int z) {
+    uint32_t h = 2166136261u;
+    h = (h ^ (uint32_t)x) * 16777619u;
+    h = (h ^ (uint32_t)z) * 16777619u;
+    return h % COLUMN_CACHE_BUCKETS;
+}
+
+/**
+ * Find a region (mutex held)
+ */
+static ColumnRegion* region_find(ColumnCache* cache, int region_x, int region_z) {
+    ColumnRegion* region = cache->buckets[hash_region_coords(region_x, region_z)];
+    while (region) {
+        if (region->region_x == region_x && region->region_z == region_z) return region;
+        region = region->next;
+    }
+    return NULL;
+}
+
+/**
+ * Drop the least recently used region (mutex held)
+ */
+static void region_evict_oldest(ColumnCache* cache) {
+    ColumnRegion** oldest = NULL;
+    for (int b = 0; b < COLUMN_CACHE_BUCKETS; b++) {
+        for (ColumnRegion** link = &cache->buckets[b]; *link; link = &(*link)->next) {
+            // Unsigned difference keeps the order right across clock wraparound
+            if (!oldest || cache->clock - (*link)->last_used > cache->clock - (*oldest)->last_used) {
+                oldest = link;
+            }
+        }
+    }
+    if (!oldest) return;
+
+    ColumnRegion* victim = *oldest;
+    *oldest = victim->next;
+    free(victim);
+    cache->region_count--;
+}
+
+/**
+ * Find a region, computing it on a miss
+ * Returns with the mutex held; the map stays valid until the caller unlocks.
+ * scratch receives the computed map and is returned if it can't be cached.
+ */
+static const ColumnMap* region_acquire(ColumnCache* cache, int region_x, int region_z, ColumnMap* scratch) {
+    pthread_mutex_lock(&cache->mutex);
+    cache->clock++;
+    ColumnRegion* region = region_find(cache, region_x, region_z);
+    if (region) {
+        region->last_used = cache->clock;
+        cache->hits++;
+        return &region->map;
+    }
+    cache->misses++;
+    pthread_mutex_unlock(&cache->mutex);
+
+    // Noise runs unlocked so other threads keep hitting the cache
+    terrain_compute_column_map(scratch, region_x, region_z, cache->params);
+    ColumnRegion* fresh = (ColumnRegion*)malloc(sizeof(ColumnRegion));
+
+    pthread_mutex_lock(&cache->mutex);
+    region = region_find(cache, region_x, region_z);
+    if (region) {
+        free(fresh);  // Another thread got there first
+        return &region->map;
+    }
+    if (!fresh) return scratch;  // Still answered, just not cached
+
+    if (cache->region_count >= COLUMN_CACHE_MAX_REGIONS) region_evict_oldest(cache);
+    fresh->region_x = region_x;
+    fresh->region_z = region_z;
+    memcpy(&fresh->map, scratch, sizeof(ColumnMap));
+    fresh->last_used = cache->clock;
+
+    uint32_t bucket = hash_region_coords(region_x, region_z);
+    fresh->next = cache->buckets[bucket];
+    cache->buckets[bucket] = fresh;
+    cache->region_count++;
+    return &fresh->map;
+}
+
+/**
+ * Split world column coordinates into region and local coordinates
+ */
+static void column_to_region(int world_x, int world_z, int* region_x, int* region_z, int* local_x, int* local_z) {
+    *region_x = world_x >= 0 ? world_x / CHUNK_SIZE : (world_x - CHUNK_SIZE + 1) / CHUNK_SIZE;
+    *region_z = world_z >= 0 ? world_z / CHUNK_SIZE : (world_z - CHUNK_SIZE + 1) / CHUNK_SIZE;
+    *local_x = world_x - *region_x * CHUNK_SIZE;
+    *local_z = world_z - *region_z * CHUNK_SIZE;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+ColumnCache* column_cache_create(TerrainParams params) {
+    ColumnCache* cache = (ColumnCache*)calloc(1, sizeof(ColumnCache));
+    if (!cache) {
+        printf("[COLUMNS] Failed to allocate column cache\n");
+        return NULL;
+    }
+    cache->params = params;
+    pthread_mutex_init(&cache->mutex, NULL);
+    return cache;
+}
+
+void column_cache_destroy(ColumnCache* cache) {
+    if (!cache) return;
+
+    uint64_t lookups = cache->hits + cache->misses;
+    printf("[COLUMNS] %d regions cached, %llu lookups, %.1f%% hits\n",
+           cache->region_count, (unsigned long long)lookups,
+           lookups > 0 ? 100.0 * (double)cache->hits / (double)lookups : 0.0);
+
+    for (int b = 0; b < COLUMN_CACHE_BUCKETS; b++) {
+        ColumnRegion* region = cache->buckets[b];
+        while (region) {
+            ColumnRegion* next = region->next;
+            free(region);
+            region = next;
+        }
+    }
+    pthread_mutex_destroy(&cache->mutex);
+    free(cache);
+}
+
+void column_cache_get_map(ColumnCache* cache, int chunk_x, int chunk_z, ColumnMap* map) {
+    const ColumnMap* cached = region_acquire(cache, chunk_x, chunk_z, map);
+    if (cached != map) memcpy(map, cached, sizeof(ColumnMap));
+    pthread_mutex_unlock(&cache->mutex);
+}
+
+int column_cache_get_height(ColumnCache* cache, int world_x, int world_z) {
+    int region_x, region_z, local_x, local_z;
+    column_to_region(world_x, world_z, &region_x, &region_z, &local_x, &local_z);
+
+    ColumnMap scratch;
+    const ColumnMap* map = region_acquire(cache, region_x, region_z, &scratch);
+    int height = map->heights[local_z][local_x];
+    pthread_mutex_unlock(&cache->mutex);
+    return height;
+}
+
+BiomeType column_cache_get_biome(ColumnCache* cache, int world_x, int world_z) {
+    int region_x, region_z, local_x, local_z;
+    column_to_region(world_x, world_z, &region_x, &region_z, &local_x, &local_z);
+
+    ColumnMap scratch;
+    const ColumnMap* map = region_acquire(cache, region_x, region_z, &scratch);
+    BiomeType biome = (BiomeType)map->biomes[local_z][local_x];
+    pthread_mutex_unlock(&cache->mutex);
+    return biome;
+}
@@ -0,0 +1,187 @@
+/**
+ * Mesh Arena Implementation
+ */
+
+#include "voxel/world/mesh_arena.h"
+#include "voxel/core/memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static _Thread_local MeshArena* g_thread_arena = NULL;
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+static size_t class_vertices(int size_class) {
+    return (size_t)1 << (MESH_ARENA_MIN_SHIFT + size_class);
+}
+
+static size_t class_bytes(int size_class) {
+    return sizeof(MeshBlock) + class_vertices(size_class) * sizeof(ChunkVertex);
+}
+
+/**
+ * Smallest class holding count vertices, or -1 when larger than all classes
+ */
+static int size_class_for(int count) {
+    for (int c = 0; c < MESH_ARENA_CLASSES; c++) {
+        if ((size_t)count <= class_vertices(c)) return c;
+    }
+    return -1;
+}
+
+/**
+ * Blocks, cached or in use, and scratch count as MEMORY_CPU_MESH
+ */
+static void* arena_malloc(size_t bytes) {
+    void* ptr = malloc(bytes);
+    if (ptr) memory_track(MEMORY_CPU_MESH, (ptrdiff_t)bytes);
+    return ptr;
+}
+
+static void arena_free(void* ptr, size_t bytes) {
+    if (!ptr) return;
+    memory_track(MEMORY_CPU_MESH, -(ptrdiff_t)bytes);
+    free(ptr);
+}
+
+static ChunkVertex* block_vertices(MeshBlock* block) {
+    return (ChunkVertex*)(block + 1);
+}
+
+/**
+ * Move blocks the main thread handed back onto the free lists (owner thread)
+ * Taking the whole list at once leaves no room for ABA
+ */
+static void arena_drain_returned(MeshArena* arena) {
+    MeshBlock* block = atomic_exchange_explicit(&arena->returned, NULL, memory_order_acquire);
+    while (block) {
+        MeshBlock* next = block->next;
+        size_t bytes = class_bytes(block->size_class);
+        if (arena->cached_bytes + bytes > MESH_ARENA_MAX_CACHED_BYTES) {
+            arena_free(block, bytes);
+            arena->blocks_created--;
+        } else {
+            block->next = arena->free_blocks[block->size_class];
+            arena->free_blocks[block->size_class] = block;
+            arena->cached_bytes += bytes;
+        }
+        block = next;
+    }
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+void mesh_arena_init(MeshArena* arena) {
+    if (!arena) return;
+
+    for (int c = 0; c < MESH_ARENA_CLASSES; c++) {
+        arena->free_blocks[c] = NULL;
+    }
+    arena->cached_bytes = 0;
+    atomic_init(&arena->returned, NULL);
+    for (int i = 0; i < MESH_SCRATCH_COUNT; i++) {
+        arena->scratch[i] = NULL;
+        arena->scratch_bytes[i] = 0;
+    }
+    arena->blocks_created = 0;
+}
+
+void mesh_arena_destroy(MeshArena* arena) {
+    if (!arena) return;
+
+    arena_drain_returned(arena);
+    for (int c = 0; c < MESH_ARENA_CLASSES; c++) {
+        MeshBlock* block = arena->free_blocks[c];
+        while (block) {
+            MeshBlock* next = block->next;
+            arena_free(block, class_bytes(c));
+            arena->blocks_created--;
+            block = next;
+        }
+        arena->free_blocks[c] = NULL;
+    }
+    if (arena->blocks_created > 0) {
+        printf("[MESH] Arena destroyed with %d blocks still in use\n", arena->blocks_created);
+    }
+    arena->cached_bytes = 0;
+
+    for (int i = 0; i < MESH_SCRATCH_COUNT; i++) {
+        arena_free(arena->scratch[i], arena->scratch_bytes[i]);
+        arena->scratch[i] = NULL;
+        arena->scratch_bytes[i] = 0;
+    }
+}
+
+void mesh_arena_bind(MeshArena* arena) {
+    g_thread_arena = arena;
+}
+
+MeshArena* mesh_arena_current(void) {
+    return g_thread_arena;
+}
+
+void* mesh_arena_scratch(MeshArena* arena, MeshScratch kind, size_t bytes) {
+    if (!arena) return NULL;
+
+    if (arena->scratch_bytes[kind] < bytes) {
+        // Contents need not survive, so no realloc copy
+        arena_free(arena->scratch[kind], arena->scratch_bytes[kind]);
+        arena->scratch[kind] = arena_malloc(bytes);
+        arena->scratch_bytes[kind] = arena->scratch[kind] ? bytes : 0;
+    }
+    return arena->scratch[kind];
+}
+
+ChunkVertex* mesh_block_alloc(MeshArena* arena, int count) {
+    if (count <= 0) return NULL;
+
+    int size_class = size_class_for(count);
+    if (!arena || size_class < 0) {
+        MeshBlock* block = (MeshBlock*)arena_malloc(sizeof(MeshBlock) + (size_t)count * sizeof(ChunkVertex));
+        if (!block) return NULL;
+        block->owner = NULL;
+        block->next = NULL;
+        block->size_class = -1;
+        block->count = count;
+        return block_vertices(block);
+    }
+
+    if (!arena->free_blocks[size_class]) {
+        arena_drain_returned(arena);
+    }
+
+    MeshBlock* block = arena->free_blocks[size_class];
+    if (block) {
+        arena->free_blocks[size_class] = block->next;
+        arena->cached_bytes -= class_bytes(size_class);
+    } else {
+        block = (MeshBlock*)arena_malloc(class_bytes(size_class));
+        if (!block) return NULL;
+        block->owner = arena;
+        block->size_class = size_class;
+        arena->blocks_created++;
+    }
+    block->next = NULL;
+    return block_vertices(block);
+}
+
+void mesh_block_free(ChunkVertex* vertices) {
+    if (!vertices) return;
+
+    MeshBlock* block = (MeshBlock*)vertices - 1;
+    MeshArena* arena = block->owner;
+    if (!arena) {
+        arena_free(block, sizeof(MeshBlock) + (size_t)block->count * sizeof(ChunkVertex));
+        return;
+    }
+
+    MeshBlock* head = atomic_load_explicit(&arena->returned, memory_order_relaxed);
+    do {
+        block->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&arena->returned, &head, block,
+                                                    memory_order_release, memory_order_relaxed));
+}
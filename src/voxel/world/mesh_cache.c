@@ -0,0 +1,228 @@
+/**
+ * Mesh Cache Implementation
+ *
+ * Entry layout (little endian):
+ *   magic, version, key (u64), opaque and transparent vertex counts,
+ *   opaque and transparent section starts (17 x u32 each), section
+ *   visibility (16 x u64), checksum, then the packed vertices as uploaded
+ */
+
+#include "voxel/world/mesh_cache.h"
+#include "voxel/world/mesh_arena.h"
+#include "voxel/world/region.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MESH_ENTRY_MAGIC 0x314D5856u   // "VXM1"
+#define MESH_ENTRY_STARTS (CHUNK_SECTION_COUNT + 1)
+#define MESH_ENTRY_HEADER_BYTES (4 + 4 + 8 + 4 + 4 + 2 * MESH_ENTRY_STARTS * 4 + CHUNK_SECTION_COUNT * 8 + 4)
+
+// ============================================================================
+// BYTE HELPERS
+// ============================================================================
+
+static uint8_t* put_u32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v & 0xFF);
+    p[1] = (uint8_t)((v >> 8) & 0xFF);
+    p[2] = (uint8_t)((v >> 16) & 0xFF);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+static uint8_t* put_u64(uint8_t* p, uint64_t v) {
+    p = put_u32(p, (uint32_t)v);
+    return put_u32(p, (uint32_t)(v >> 32));
+}
+
+static uint32_t get_u32(const uint8_t** p) {
+    const uint8_t* b = *p;
+    *p += 4;
+    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+static uint64_t get_u64(const uint8_t** p) {
+    uint64_t low = get_u32(p);
+    return low | ((uint64_t)get_u32(p) << 32);
+}
+
+static uint32_t checksum(const uint8_t* data, size_t size) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        h = (h ^ data[i]) * 16777619u;
+    }
+    return h;
+}
+
+static uint64_t hash_bytes(uint64_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;  // FNV-1a 64
+    }
+    return hash;
+}
+
+/**
+ * Section starts must rise from 0 to the vertex count in whole quads
+ */
+static bool starts_valid(const int* start, int vertex_count) {
+    if (start[0] != 0 || start[CHUNK_SECTION_COUNT] != vertex_count) return false;
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        if (start[sy + 1] < start[sy] || start[sy] % CHUNK_QUAD_VERTICES != 0) return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+MeshCache* mesh_cache_create(const char* save_directory) {
+    if (!save_directory) return NULL;
+
+    MeshCache* cache = (MeshCache*)calloc(1, sizeof(MeshCache));
+    if (!cache) {
+        printf("[MESH CACHE] Failed to allocate mesh cache\n");
+        return NULL;
+    }
+
+    char directory[MESH_CACHE_PATH_MAX];
+    snprintf(directory, sizeof(directory), "%s/%s", save_directory, MESH_CACHE_SUBDIRECTORY);
+    cache->storage = region_storage_create(directory);
+    if (!cache->storage) {
+        free(cache);
+        return NULL;
+    }
+    pthread_mutex_init(&cache->stats_mutex, NULL);
+    return cache;
+}
+
+void mesh_cache_destroy(MeshCache* cache) {
+    if (!cache) return;
+
+    uint64_t lookups = cache->hits + cache->misses;
+    printf("[MESH CACHE] %llu hits, %llu misses (%.1f%% hit rate), %llu meshes stored\n",
+           (unsigned long long)cache->hits, (unsigned long long)cache->misses,
+           lookups ? 100.0 * (double)cache->hits / (double)lookups : 0.0, (unsigned long long)cache->stores);
+
+    region_storage_destroy(cache->storage);
+    pthread_mutex_destroy(&cache->stats_mutex);
+    free(cache);
+}
+
+uint64_t mesh_cache_key(Chunk* chunk, const ChunkBorder* border) {
+    uint64_t hash = chunk_content_hash(chunk);
+    uint32_t version = MESH_CACHE_VERSION;
+    uint32_t mesher = (uint32_t)chunk_get_mesher();
+    hash = hash_bytes(hash, &version, sizeof(version));
+    hash = hash_bytes(hash, &mesher, sizeof(mesher));
+    if (border) {
+        hash = hash_bytes(hash, border, sizeof(ChunkBorder));
+    }
+    return hash;
+}
+
+/**
+ * Decode an entry into out; false if it is damaged or made for another key
+ */
+static bool decode_entry(Chunk* chunk, uint64_t key, const uint8_t* data, uint32_t size, StagedMesh* out) {
+    if (size < MESH_ENTRY_HEADER_BYTES) return false;
+
+    const uint8_t* p = data;
+    if (get_u32(&p) != MESH_ENTRY_MAGIC || get_u32(&p) != MESH_CACHE_VERSION) return false;
+    if (get_u64(&p) != key) return false;  // Blocks changed since: stale
+
+    uint32_t vertex_count = get_u32(&p);
+    uint32_t trans_vertex_count = get_u32(&p);
+    uint64_t vertex_bytes = ((uint64_t)vertex_count + trans_vertex_count) * sizeof(ChunkVertex);
+    if (vertex_bytes != size - MESH_ENTRY_HEADER_BYTES) return false;
+
+    for (int i = 0; i < MESH_ENTRY_STARTS; i++) out->section_start[i] = (int)get_u32(&p);
+    for (int i = 0; i < MESH_ENTRY_STARTS; i++) out->trans_section_start[i] = (int)get_u32(&p);
+    for (int i = 0; i < CHUNK_SECTION_COUNT; i++) out->visibility[i] = get_u64(&p);
+    uint32_t sum = get_u32(&p);
+    if (sum != checksum(p, (size_t)vertex_bytes)) return false;
+    if (!starts_valid(out->section_start, (int)vertex_count) ||
+        !starts_valid(out->trans_section_start, (int)trans_vertex_count)) {
+        return false;
+    }
+
+    // Into blocks of the worker's arena, like a freshly meshed chunk
+    MeshArena* arena = mesh_arena_current();
+    if (vertex_count > 0) {
+        out->vertices = mesh_block_alloc(arena, (int)vertex_count);
+        if (!out->vertices) return false;
+        memcpy(out->vertices, p, (size_t)vertex_count * sizeof(ChunkVertex));
+        out->vertex_count = (int)vertex_count;
+        p += (size_t)vertex_count * sizeof(ChunkVertex);
+    }
+    if (trans_vertex_count > 0) {
+        out->trans_vertices = mesh_block_alloc(arena, (int)trans_vertex_count);
+        if (!out->trans_vertices) {
+            staged_mesh_free(out);
+            return false;
+        }
+        memcpy(out->trans_vertices, p, (size_t)trans_vertex_count * sizeof(ChunkVertex));
+        out->trans_vertex_count = (int)trans_vertex_count;
+
+        // Stored in the order of the camera that built it
+        chunk_sort_transparent(chunk, out->trans_vertices, out->trans_vertex_count, out->trans_section_start);
+    }
+    out->valid = true;
+    return true;
+}
+
+bool mesh_cache_load(MeshCache* cache, Chunk* chunk, uint64_t key, StagedMesh* out) {
+    if (!cache || !chunk || !out) return false;
+
+    memset(out, 0, sizeof(StagedMesh));
+    uint32_t size;
+    uint8_t* data = region_storage_read_raw(cache->storage, chunk->x, chunk->z, &size);
+    bool hit = data && decode_entry(chunk, key, data, size, out);
+    free(data);
+    if (!hit) memset(out, 0, sizeof(StagedMesh));
+
+    pthread_mutex_lock(&cache->stats_mutex);
+    if (hit) {
+        cache->hits++;
+    } else {
+        cache->misses++;
+    }
+    pthread_mutex_unlock(&cache->stats_mutex);
+    return hit;
+}
+
+void mesh_cache_store(MeshCache* cache, Chunk* chunk, uint64_t key, const StagedMesh* mesh) {
+    if (!cache || !chunk || !mesh || !mesh->valid || mesh->section_mask != 0) return;
+
+    size_t vertex_bytes = (size_t)(mesh->vertex_count + mesh->trans_vertex_count) * sizeof(ChunkVertex);
+    uint32_t size = (uint32_t)(MESH_ENTRY_HEADER_BYTES + vertex_bytes);
+    uint8_t* data = (uint8_t*)malloc(size);
+    if (!data) return;
+
+    uint8_t* vertices = data + MESH_ENTRY_HEADER_BYTES;
+    if (mesh->vertex_count > 0) {
+        memcpy(vertices, mesh->vertices, (size_t)mesh->vertex_count * sizeof(ChunkVertex));
+    }
+    if (mesh->trans_vertex_count > 0) {
+        memcpy(vertices + (size_t)mesh->vertex_count * sizeof(ChunkVertex), mesh->trans_vertices,
+               (size_t)mesh->trans_vertex_count * sizeof(ChunkVertex));
+    }
+
+    uint8_t* p = data;
+    p = put_u32(p, MESH_ENTRY_MAGIC);
+    p = put_u32(p, MESH_CACHE_VERSION);
+    p = put_u64(p, key);
+    p = put_u32(p, (uint32_t)mesh->vertex_count);
+    p = put_u32(p, (uint32_t)mesh->trans_vertex_count);
+    for (int i = 0; i < MESH_ENTRY_STARTS; i++) p = put_u32(p, (uint32_t)mesh->section_start[i]);
+    for (int i = 0; i < MESH_ENTRY_STARTS; i++) p = put_u32(p, (uint32_t)mesh->trans_section_start[i]);
+    for (int i = 0; i < CHUNK_SECTION_COUNT; i++) p = put_u64(p, mesh->visibility[i]);
+    put_u32(p, checksum(vertices, vertex_bytes));
+
+    if (!region_storage_write_raw(cache->storage, chunk->x, chunk->z, data, size)) return;
+
+    pthread_mutex_lock(&cache->stats_mutex);
+    cache->stores++;
+    pthread_mutex_unlock(&cache->stats_mutex);
+}
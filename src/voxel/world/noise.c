@@ -5,6 +5,7 @@
  */
 
 #include "voxel/world/noise.h"
+#include "voxel/world/random.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -16,6 +17,7 @@
 
 static int permutation[512];
 static int p[512];
+static uint32_t g_seed = 0;
 
 /**
  * Initialize permutation table with seed
@@ -26,10 +28,10 @@ void noise_init(uint32_t seed) {
         permutation[i] = i;
     }
 
-    // Fisher-Yates shuffle with seed
-    srand(seed);
+    // Fisher-Yates shuffle with seed (not rand(): same table on every platform)
+    RandomStream rng = random_stream(random_feature_seed(seed, RANDOM_FEATURE_NOISE));
     for (int i = 255; i > 0; i--) {
-        int j = rand() % (i + 1);
+        int j = random_next_int(&rng, i + 1);
         int temp = permutation[i];
         permutation[i] = permutation[j];
         permutation[j] = temp;
@@ -40,10 +42,15 @@ void noise_init(uint32_t seed) {
         p[i] = permutation[i];
         p[256 + i] = permutation[i];
     }
+    g_seed = seed;
 
     printf("[NOISE] Initialized with seed %u\n", seed);
 }
 
+uint32_t noise_get_seed(void) {
+    return g_seed;
+}
+
 // ============================================================================
 // HELPER FUNCTIONS
 // ============================================================================
@@ -184,3 +191,304 @@ float noise_fbm_3d(float x, float y, float z, int octaves, float frequency,
 
     return sum;
 }
+
+// ============================================================================
+// BATCHED EVALUATION
+// ============================================================================
+
+/*
+ * The batch kernels run NOISE_LANES points at a time through the same math
+ * as noise_2d/noise_3d using GCC/Clang vector extensions, which compile to
+ * SSE2 (or AVX2 with -mavx2) on x86-64 and NEON on ARM64. Permutation
+ * lookups stay scalar per lane; everything else is vector arithmetic.
+ */
+#if defined(__GNUC__)
+
+#if defined(__AVX2__)
+#define NOISE_LANES 8
+#else
+#define NOISE_LANES 4
+#endif
+
+typedef float vfloat __attribute__((vector_size(NOISE_LANES * sizeof(float))));
+typedef int32_t vint __attribute__((vector_size(NOISE_LANES * sizeof(int32_t))));
+
+static inline vfloat vselect(vint mask, vfloat a, vfloat b) {
+    return (vfloat)(((vint)a & mask) | ((vint)b & ~mask));
+}
+
+static inline vfloat vnegate_if(vint mask, vfloat a) {
+    return (vfloat)((vint)a ^ (mask & INT32_MIN));  // Flip the sign bit
+}
+
+static inline vfloat vfloor(vfloat v) {
+    // Truncation rounds negatives up; step those back by one
+    vfloat t = __builtin_convertvector(__builtin_convertvector(v, vint), vfloat);
+    return t + __builtin_convertvector(t > v, vfloat);
+}
+
+static inline vfloat vfade(vfloat t) {
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+static inline vfloat vlerp(vfloat t, vfloat a, vfloat b) {
+    return a + t * (b - a);
+}
+
+static inline vfloat vgrad_2d(vint hash, vfloat x, vfloat y) {
+    vint h = hash & 7;
+    vint u_is_x = h < 4;
+    vfloat u = vselect(u_is_x, x, y);
+    vfloat v = vselect(u_is_x, y, x);
+    return vnegate_if((h & 1) != 0, u) + vnegate_if((h & 2) != 0, 2.0f * v);
+}
+
+static inline vfloat vgrad_3d(vint hash, vfloat x, vfloat y, vfloat z) {
+    vint h = hash & 15;
+    vfloat u = vselect(h < 8, x, y);
+    vfloat v = vselect(h < 4, y, vselect((h == 12) | (h == 14), x, z));
+    return vnegate_if((h & 1) != 0, u) + vnegate_if((h & 2) != 0, v);
+}
+
+static vfloat noise_2d_lanes(vfloat x, vfloat y) {
+    vfloat fx = vfloor(x);
+    vfloat fy = vfloor(y);
+    vint X = __builtin_convertvector(fx, vint) & 255;
+    vint Y = __builtin_convertvector(fy, vint) & 255;
+    x -= fx;
+    y -= fy;
+
+    vint haa, hba, hab, hbb;
+    for (int i = 0; i < NOISE_LANES; i++) {
+        int a = p[X[i]] + Y[i];
+        int b = p[X[i] + 1] + Y[i];
+        haa[i] = p[a];
+        hba[i] = p[b];
+        hab[i] = p[a + 1];
+        hbb[i] = p[b + 1];
+    }
+
+    vfloat u = vfade(x);
+    vfloat v = vfade(y);
+    return vlerp(v,
+        vlerp(u, vgrad_2d(haa, x, y), vgrad_2d(hba, x - 1.0f, y)),
+        vlerp(u, vgrad_2d(hab, x, y - 1.0f), vgrad_2d(hbb, x - 1.0f, y - 1.0f))
+    );
+}
+
+static vfloat noise_3d_lanes(vfloat x, vfloat y, vfloat z) {
+    vfloat fx = vfloor(x);
+    vfloat fy = vfloor(y);
+    vfloat fz = vfloor(z);
+    vint X = __builtin_convertvector(fx, vint) & 255;
+    vint Y = __builtin_convertvector(fy, vint) & 255;
+    vint Z = __builtin_convertvector(fz, vint) & 255;
+    x -= fx;
+    y -= fy;
+    z -= fz;
+
+    // Corner hashes, same lookups as noise_3d
+    vint h000, h100, h010, h110, h001, h101, h011, h111;
+    for (int i = 0; i < NOISE_LANES; i++) {
+        int a = p[X[i]] + Y[i];
+        int aa = p[a] + Z[i];
+        int ab = p[a + 1] + Z[i];
+        int b = p[X[i] + 1] + Y[i];
+        int ba = p[b] + Z[i];
+        int bb = p[b + 1] + Z[i];
+        h000[i] = p[aa];
+        h100[i] = p[ba];
+        h010[i] = p[ab];
+        h110[i] = p[bb];
+        h001[i] = p[aa + 1];
+        h101[i] = p[ba + 1];
+        h011[i] = p[ab + 1];
+        h111[i] = p[bb + 1];
+    }
+
+    vfloat u = vfade(x);
+    vfloat v = vfade(y);
+    vfloat w = vfade(z);
+    return vlerp(w,
+        vlerp(v,
+            vlerp(u, vgrad_3d(h000, x, y, z), vgrad_3d(h100, x - 1.0f, y, z)),
+            vlerp(u, vgrad_3d(h010, x, y - 1.0f, z), vgrad_3d(h110, x - 1.0f, y - 1.0f, z))
+        ),
+        vlerp(v,
+            vlerp(u, vgrad_3d(h001, x, y, z - 1.0f), vgrad_3d(h101, x - 1.0f, y, z - 1.0f)),
+            vlerp(u, vgrad_3d(h011, x, y - 1.0f, z - 1.0f), vgrad_3d(h111, x - 1.0f, y - 1.0f, z - 1.0f))
+        )
+    );
+}
+
+/**
+ * Load up to NOISE_LANES floats (a partial tail repeats the last one)
+ */
+static inline vfloat vload(const float* src, int n) {
+    vfloat v;
+    for (int i = 0; i < NOISE_LANES; i++) v[i] = src[i < n ? i : n - 1];
+    return v;
+}
+
+static inline void vstore(float* dst, vfloat v, int n) {
+    for (int i = 0; i < n; i++) dst[i] = v[i];
+}
+
+void noise_fbm_2d_batch(const float* x, const float* y, float* out, int count,
+                        int octaves, float frequency, float amplitude,
+                        float lacunarity, float persistence) {
+    for (int i = 0; i < count; i += NOISE_LANES) {
+        int n = count - i < NOISE_LANES ? count - i : NOISE_LANES;
+        vfloat vx = vload(x + i, n);
+        vfloat vy = vload(y + i, n);
+
+        vfloat sum = (vfloat){0};
+        float freq = frequency;
+        float amp = amplitude;
+        for (int o = 0; o < octaves; o++) {
+            sum += noise_2d_lanes(vx * freq, vy * freq) * amp;
+            freq *= lacunarity;
+            amp *= persistence;
+        }
+        vstore(out + i, sum, n);
+    }
+}
+
+void noise_fbm_3d_batch(const float* x, const float* y, const float* z, float* out, int count,
+                        int octaves, float frequency, float amplitude,
+                        float lacunarity, float persistence) {
+    for (int i = 0; i < count; i += NOISE_LANES) {
+        int n = count - i < NOISE_LANES ? count - i : NOISE_LANES;
+        vfloat vx = vload(x + i, n);
+        vfloat vy = vload(y + i, n);
+        vfloat vz = vload(z + i, n);
+
+        vfloat sum = (vfloat){0};
+        float freq = frequency;
+        float amp = amplitude;
+        for (int o = 0; o < octaves; o++) {
+            sum += noise_3d_lanes(vx * freq, vy * freq, vz * freq) * amp;
+            freq *= lacunarity;
+            amp *= persistence;
+        }
+        vstore(out + i, sum, n);
+    }
+}
+
+#else  // No vector extensions: scalar loops with identical results
+
+void noise_fbm_2d_batch(const float* x, const float* y, float* out, int count,
+                        int octaves, float frequency, float amplitude,
+                        float lacunarity, float persistence) {
+    for (int i = 0; i < count; i++) {
+        out[i] = noise_fbm_2d(x[i], y[i], octaves, frequency, amplitude, lacunarity, persistence);
+    }
+}
+
+void noise_fbm_3d_batch(const float* x, const float* y, const float* z, float* out, int count,
+                        int octaves, float frequency, float amplitude,
+                        float lacunarity, float persistence) {
+    for (int i = 0; i < count; i++) {
+        out[i] = noise_fbm_3d(x[i], y[i], z[i], octaves, frequency, amplitude, lacunarity, persistence);
+    }
+}
+
+#endif
+
+void noise_3d_batch(const float* x, const float* y, const float* z, float* out, int count) {
+    noise_fbm_3d_batch(x, y, z, out, count, 1, 1.0f, 1.0f, 1.0f, 1.0f);
+}
+
+// ============================================================================
+// GRIDS
+// ============================================================================
+
+#define NOISE_ROW_MAX 256  // Points per batch call in the grid helpers
+
+void noise_fbm_2d_grid(float* out, int x0, int z0, int size_x, int size_z,
+                       int octaves, float frequency, float amplitude,
+                       float lacunarity, float persistence) {
+    float xs[NOISE_ROW_MAX], zs[NOISE_ROW_MAX];
+    for (int z = 0; z < size_z; z++) {
+        for (int x = 0; x < size_x; x += NOISE_ROW_MAX) {
+            int n = size_x - x < NOISE_ROW_MAX ? size_x - x : NOISE_ROW_MAX;
+            for (int i = 0; i < n; i++) {
+                xs[i] = (float)(x0 + x + i);
+                zs[i] = (float)(z0 + z);
+            }
+            noise_fbm_2d_batch(xs, zs, out + z * size_x + x, n,
+                               octaves, frequency, amplitude, lacunarity, persistence);
+        }
+    }
+}
+
+/**
+ * Exact grid: every block sampled, one row of x per batch
+ */
+static void fbm_3d_grid_exact(float* out, int x0, int y0, int z0, int size_x, int size_y, int size_z,
+                              int cell, int octaves, float frequency, float amplitude,
+                              float lacunarity, float persistence) {
+    float xs[NOISE_ROW_MAX], ys[NOISE_ROW_MAX], zs[NOISE_ROW_MAX];
+    for (int y = 0; y < size_y; y++) {
+        for (int z = 0; z < size_z; z++) {
+            for (int x = 0; x < size_x; x += NOISE_ROW_MAX) {
+                int n = size_x - x < NOISE_ROW_MAX ? size_x - x : NOISE_ROW_MAX;
+                for (int i = 0; i < n; i++) {
+                    xs[i] = (float)(x0 + (x + i) * cell);
+                    ys[i] = (float)(y0 + y * cell);
+                    zs[i] = (float)(z0 + z * cell);
+                }
+                noise_fbm_3d_batch(xs, ys, zs, out + (y * size_z + z) * size_x + x, n,
+                                   octaves, frequency, amplitude, lacunarity, persistence);
+            }
+        }
+    }
+}
+
+void noise_fbm_3d_grid(float* out, int x0, int y0, int z0, int size_x, int size_y, int size_z,
+                       int cell, int octaves, float frequency, float amplitude,
+                       float lacunarity, float persistence) {
+    if (size_x <= 0 || size_y <= 0 || size_z <= 0) return;
+
+    // Lattice covering the grid, one point past the last block where needed
+    int lx = cell > 1 ? (size_x - 1 + cell - 1) / cell + 1 : 0;
+    int ly = cell > 1 ? (size_y - 1 + cell - 1) / cell + 1 : 0;
+    int lz = cell > 1 ? (size_z - 1 + cell - 1) / cell + 1 : 0;
+    float* lattice = cell > 1 ? (float*)malloc((size_t)lx * ly * lz * sizeof(float)) : NULL;
+    if (!lattice) {
+        fbm_3d_grid_exact(out, x0, y0, z0, size_x, size_y, size_z, 1,
+                          octaves, frequency, amplitude, lacunarity, persistence);
+        return;
+    }
+    fbm_3d_grid_exact(lattice, x0, y0, z0, lx, ly, lz, cell,
+                      octaves, frequency, amplitude, lacunarity, persistence);
+
+    // Trilinear interpolation between lattice points
+    float inv_cell = 1.0f / (float)cell;
+    for (int y = 0; y < size_y; y++) {
+        int iy = y / cell;
+        int iy1 = iy + 1 < ly ? iy + 1 : iy;
+        float ty = (float)(y - iy * cell) * inv_cell;
+        for (int z = 0; z < size_z; z++) {
+            int iz = z / cell;
+            int iz1 = iz + 1 < lz ? iz + 1 : iz;
+            float tz = (float)(z - iz * cell) * inv_cell;
+            const float* r00 = lattice + (iy * lz + iz) * lx;
+            const float* r01 = lattice + (iy * lz + iz1) * lx;
+            const float* r10 = lattice + (iy1 * lz + iz) * lx;
+            const float* r11 = lattice + (iy1 * lz + iz1) * lx;
+            float* row = out + (y * size_z + z) * size_x;
+            for (int x = 0; x < size_x; x++) {
+                int ix = x / cell;
+                int ix1 = ix + 1 < lx ? ix + 1 : ix;
+                float tx = (float)(x - ix * cell) * inv_cell;
+                float c00 = lerp(tx, r00[ix], r00[ix1]);
+                float c01 = lerp(tx, r01[ix], r01[ix1]);
+                float c10 = lerp(tx, r10[ix], r10[ix1]);
+                float c11 = lerp(tx, r11[ix], r11[ix1]);
+                row[x] = lerp(ty, lerp(tz, c00, c01), lerp(tz, c10, c11));
+            }
+        }
+    }
+    free(lattice);
+}
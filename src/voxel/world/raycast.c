@@ -11,94 +11,221 @@
 #include <raymath.h>
 #include <math.h>
 #include <float.h>
+#include <limits.h>
 #include <stddef.h>  // For NULL
 
+// ============================================================================
+// BLOCK TRAVERSAL
+// ============================================================================
+
 /**
- * Raycast to find the block the player is looking at
- * Uses DDA (Digital Differential Analyzer) algorithm for voxel traversal
+ * DDA state of one ray (per-axis arrays: 0 = x, 1 = y, 2 = z)
  */
-bool raycast_block(World* world, Vector3 origin, Vector3 direction,
-                   float max_distance, Vector3* hit_block, BlockFace* hit_face) {
-    // Normalize direction
-    direction = Vector3Normalize(direction);
-
-    // Current voxel position
-    int x = (int)floorf(origin.x);
-    int y = (int)floorf(origin.y);
-    int z = (int)floorf(origin.z);
+typedef struct RayWalk {
+    float origin[3];
+    float dir[3];
+    int cell[3];
+    int step[3];
+    float t_max[3];     // Ray distance to the next cell boundary on each axis
+    float t_delta[3];   // Ray distance between boundaries on each axis
+    float t;            // Distance at which the current cell was entered
+    int axis;           // Axis crossed to enter the current cell (-1 = start cell)
+} RayWalk;
 
-    // Direction to step in each axis (-1, 0, or 1)
-    int step_x = (direction.x > 0) ? 1 : -1;
-    int step_y = (direction.y > 0) ? 1 : -1;
-    int step_z = (direction.z > 0) ? 1 : -1;
+/**
+ * Distance to the far boundary of the cell on an axis
+ */
+static float ray_walk_boundary(const RayWalk* walk, int axis) {
+    if (walk->dir[axis] == 0.0f) return FLT_MAX;
+    float edge = (float)(walk->cell[axis] + (walk->step[axis] > 0 ? 1 : 0));
+    return (edge - walk->origin[axis]) / walk->dir[axis];
+}
 
-    // Distance to next voxel boundary in each axis
-    float t_delta_x = (direction.x != 0) ? fabsf(1.0f / direction.x) : FLT_MAX;
-    float t_delta_y = (direction.y != 0) ? fabsf(1.0f / direction.y) : FLT_MAX;
-    float t_delta_z = (direction.z != 0) ? fabsf(1.0f / direction.z) : FLT_MAX;
+static void ray_walk_init(RayWalk* walk, Vector3 origin, Vector3 direction) {
+    walk->origin[0] = origin.x;
+    walk->origin[1] = origin.y;
+    walk->origin[2] = origin.z;
+    walk->dir[0] = direction.x;
+    walk->dir[1] = direction.y;
+    walk->dir[2] = direction.z;
 
-    // Calculate initial t_max values
-    float t_max_x, t_max_y, t_max_z;
+    for (int i = 0; i < 3; i++) {
+        walk->cell[i] = (int)floorf(walk->origin[i]);
+        walk->step[i] = (walk->dir[i] > 0) ? 1 : -1;
+        walk->t_delta[i] = (walk->dir[i] != 0) ? fabsf(1.0f / walk->dir[i]) : FLT_MAX;
+        walk->t_max[i] = ray_walk_boundary(walk, i);
+    }
+    walk->t = 0.0f;
+    walk->axis = -1;
+}
 
-    if (direction.x > 0) {
-        t_max_x = ((float)(x + 1) - origin.x) / direction.x;
-    } else if (direction.x < 0) {
-        t_max_x = (origin.x - (float)x) / -direction.x;
+/**
+ * Step into the next cell along the ray
+ */
+static void ray_walk_step(RayWalk* walk) {
+    int axis;
+    if (walk->t_max[0] < walk->t_max[1] && walk->t_max[0] < walk->t_max[2]) {
+        axis = 0;
+    } else if (walk->t_max[1] < walk->t_max[2]) {
+        axis = 1;
     } else {
-        t_max_x = FLT_MAX;
+        axis = 2;
     }
+    walk->cell[axis] += walk->step[axis];
+    walk->t = walk->t_max[axis];
+    walk->t_max[axis] += walk->t_delta[axis];
+    walk->axis = axis;
+}
 
-    if (direction.y > 0) {
-        t_max_y = ((float)(y + 1) - origin.y) / direction.y;
-    } else if (direction.y < 0) {
-        t_max_y = (origin.y - (float)y) / -direction.y;
-    } else {
-        t_max_y = FLT_MAX;
+/**
+ * Jump to the first cell outside an all-air box of cells containing the
+ * current cell (bounds inclusive, INT_MIN/INT_MAX = unbounded)
+ * Lands exactly where single steps would: the exit axis moves one cell past
+ * the box, the other axes are taken from the exit point
+ */
+static void ray_walk_leap(RayWalk* walk, const int box_min[3], const int box_max[3]) {
+    int axis = -1;
+    float t_exit = FLT_MAX;
+    for (int i = 0; i < 3; i++) {
+        if (walk->dir[i] == 0.0f) continue;
+        int bound = walk->step[i] > 0 ? box_max[i] : box_min[i];
+        if (bound == INT_MAX || bound == INT_MIN) continue;
+        float edge = (float)(walk->step[i] > 0 ? bound + 1 : bound);
+        float t = (edge - walk->origin[i]) / walk->dir[i];
+        if (t < t_exit) {
+            t_exit = t;
+            axis = i;
+        }
+    }
+    if (axis < 0) {
+        walk->t = FLT_MAX;  // Never leaves the box
+        return;
     }
 
-    if (direction.z > 0) {
-        t_max_z = ((float)(z + 1) - origin.z) / direction.z;
-    } else if (direction.z < 0) {
-        t_max_z = (origin.z - (float)z) / -direction.z;
-    } else {
-        t_max_z = FLT_MAX;
+    for (int i = 0; i < 3; i++) {
+        if (i == axis) {
+            walk->cell[i] = walk->step[i] > 0 ? box_max[i] + 1 : box_min[i] - 1;
+        } else if (walk->dir[i] != 0.0f) {
+            // Clamp so rounding at the exit point cannot leave the box sideways
+            int c = (int)floorf(walk->origin[i] + walk->dir[i] * t_exit);
+            if (c < box_min[i]) c = box_min[i];
+            if (c > box_max[i]) c = box_max[i];
+            walk->cell[i] = c;
+        }
+        walk->t_max[i] = ray_walk_boundary(walk, i);
+    }
+    walk->t = t_exit;
+    walk->axis = axis;
+}
+
+/**
+ * Face of the current cell the ray entered through
+ */
+static BlockFace ray_walk_face(const RayWalk* walk) {
+    switch (walk->axis) {
+        case 0: return (walk->step[0] > 0) ? FACE_LEFT : FACE_RIGHT;    // LEFT=-X, RIGHT=+X
+        case 1: return (walk->step[1] > 0) ? FACE_BOTTOM : FACE_TOP;
+        case 2: return (walk->step[2] > 0) ? FACE_BACK : FACE_FRONT;    // BACK=-Z, FRONT=+Z
+        default: return FACE_TOP;  // Started inside the block
+    }
+}
+
+/**
+ * Find the all-air box of cells around the current cell, if there is one:
+ * an unloaded or empty chunk column, the air above a chunk's highest block,
+ * an empty section, or the space above/below the world
+ * Returns false when the cell itself has to be tested
+ */
+static bool ray_walk_air_box(RayWalk* walk, WorldCursor* cursor, int box_min[3], int box_max[3]) {
+    int x = walk->cell[0], y = walk->cell[1], z = walk->cell[2];
+
+    if (y < 0 || y >= CHUNK_HEIGHT) {
+        box_min[0] = INT_MIN; box_max[0] = INT_MAX;
+        box_min[2] = INT_MIN; box_max[2] = INT_MAX;
+        box_min[1] = (y < 0) ? INT_MIN : CHUNK_HEIGHT;
+        box_max[1] = (y < 0) ? -1 : INT_MAX;
+        return true;
+    }
+
+    int chunk_x, chunk_z;
+    world_to_chunk_coords(x, z, &chunk_x, &chunk_z);
+    box_min[0] = chunk_x * CHUNK_SIZE;
+    box_max[0] = box_min[0] + CHUNK_SIZE - 1;
+    box_min[2] = chunk_z * CHUNK_SIZE;
+    box_max[2] = box_min[2] + CHUNK_SIZE - 1;
+
+    Chunk* chunk = world_cursor_get_chunk(cursor, x, z);
+    if (!chunk || chunk->solid_block_count == 0) {
+        box_min[1] = INT_MIN;
+        box_max[1] = INT_MAX;
+        return true;
+    }
+    if (y > chunk->max_block_y) {
+        box_min[1] = chunk->max_block_y + 1;
+        box_max[1] = INT_MAX;
+        return true;
     }
+    int section = y / CHUNK_SECTION_HEIGHT;
+    if (chunk->sections[section].block_count == 0) {
+        box_min[1] = section * CHUNK_SECTION_HEIGHT;
+        box_max[1] = box_min[1] + CHUNK_SECTION_HEIGHT - 1;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Walk one ray to the first solid block within max_distance
+ * Air regions are crossed in one jump; consecutive rays sharing the cursor
+ * reuse its cached chunk
+ */
+static bool ray_walk_blocks(WorldCursor* cursor, Vector3 origin, Vector3 direction,
+                            float max_distance, RaycastHit* hit) {
+    RayWalk walk;
+    ray_walk_init(&walk, origin, direction);
 
-    // DDA traversal
-    float t = 0.0f;
-    BlockFace face = FACE_TOP;  // Default
+    int box_min[3], box_max[3];
+    while (walk.t < max_distance) {
+        if (ray_walk_air_box(&walk, cursor, box_min, box_max)) {
+            ray_walk_leap(&walk, box_min, box_max);
+            continue;
+        }
 
-    while (t < max_distance) {
-        // Check current block
-        Block block = world_get_block(world, x, y, z);
+        Block block = world_cursor_get_block(cursor, walk.cell[0], walk.cell[1], walk.cell[2]);
         if (block_is_solid(block)) {
-            hit_block->x = (float)x;
-            hit_block->y = (float)y;
-            hit_block->z = (float)z;
-            if (hit_face) *hit_face = face;
+            hit->hit = true;
+            hit->block_x = walk.cell[0];
+            hit->block_y = walk.cell[1];
+            hit->block_z = walk.cell[2];
+            hit->face = ray_walk_face(&walk);
+            hit->distance = walk.t;
             return true;
         }
+        ray_walk_step(&walk);
+    }
+    return false;
+}
 
-        // Step to next voxel and track which face we crossed
-        if (t_max_x < t_max_y && t_max_x < t_max_z) {
-            x += step_x;
-            t = t_max_x;
-            t_max_x += t_delta_x;
-            face = (step_x > 0) ? FACE_LEFT : FACE_RIGHT;  // LEFT=-X, RIGHT=+X
-        } else if (t_max_y < t_max_z) {
-            y += step_y;
-            t = t_max_y;
-            t_max_y += t_delta_y;
-            face = (step_y > 0) ? FACE_BOTTOM : FACE_TOP;
-        } else {
-            z += step_z;
-            t = t_max_z;
-            t_max_z += t_delta_z;
-            face = (step_z > 0) ? FACE_BACK : FACE_FRONT;  // BACK=-Z, FRONT=+Z
-        }
+/**
+ * Raycast to find the block the player is looking at
+ * Uses DDA (Digital Differential Analyzer) algorithm for voxel traversal
+ */
+bool raycast_block(World* world, Vector3 origin, Vector3 direction,
+                   float max_distance, Vector3* hit_block, BlockFace* hit_face) {
+    direction = Vector3Normalize(direction);
+
+    WorldCursor cursor;
+    world_cursor_init(&cursor, world);
+    RaycastHit hit = { 0 };
+    if (!ray_walk_blocks(&cursor, origin, direction, max_distance, &hit)) {
+        return false;
     }
 
-    return false;
+    hit_block->x = (float)hit.block_x;
+    hit_block->y = (float)hit.block_y;
+    hit_block->z = (float)hit.block_z;
+    if (hit_face) *hit_face = hit.face;
+    return true;
 }
 
 /**
@@ -140,32 +267,79 @@ static bool ray_intersects_aabb(Vector3 origin, Vector3 dir, Vector3 box_min,
     return true;
 }
 
+#define RAYCAST_MAX_ENTITY_CANDIDATES 64
+
 /**
- * Raycast against all entities to find the closest hit
+ * Raycast against the entities near the ray to find the closest hit
  */
 Entity* raycast_entity(EntityManager* manager, Vector3 origin, Vector3 dir,
                        float max_dist) {
     if (!manager) return NULL;
 
+    // Only entities overlapping the box around the ray segment can be hit
+    Vector3 end = Vector3Add(origin, Vector3Scale(dir, max_dist));
+    Vector3 seg_min = Vector3Min(origin, end);
+    Vector3 seg_max = Vector3Max(origin, end);
+
+    Entity* candidates[RAYCAST_MAX_ENTITY_CANDIDATES];
+    int count = entity_manager_query_box(manager, seg_min, seg_max,
+                                         candidates, RAYCAST_MAX_ENTITY_CANDIDATES);
+    if (count > RAYCAST_MAX_ENTITY_CANDIDATES) {
+        count = RAYCAST_MAX_ENTITY_CANDIDATES;  // Crowd: test the first ones found
+    }
+
     Entity* closest = NULL;
     float closest_t = max_dist;
 
-    Entity* e = manager->entities;
-    while (e) {
-        if (e->active) {
-            // Calculate world-space bounding box
-            Vector3 box_min = Vector3Add(e->position, e->bbox_min);
-            Vector3 box_max = Vector3Add(e->position, e->bbox_max);
-
-            float t;
-            if (ray_intersects_aabb(origin, dir, box_min, box_max, &t) &&
-                t < closest_t && t >= 0) {
-                closest_t = t;
-                closest = e;
-            }
+    for (int i = 0; i < count; i++) {
+        Entity* e = candidates[i];
+
+        // Calculate world-space bounding box
+        Vector3 box_min = Vector3Add(e->position, e->bbox_min);
+        Vector3 box_max = Vector3Add(e->position, e->bbox_max);
+
+        float t;
+        if (ray_intersects_aabb(origin, dir, box_min, box_max, &t) &&
+            t < closest_t && t >= 0) {
+            closest_t = t;
+            closest = e;
         }
-        e = e->next;
     }
 
     return closest;
 }
+
+// ============================================================================
+// BATCH
+// ============================================================================
+
+/**
+ * Cast many rays against blocks and, with a manager, entities
+ * Rays walk in order through one cursor, so rays starting near each other
+ * (AI sight checks, a spread of samples) reuse the cached chunk
+ */
+void raycast_batch(World* world, EntityManager* manager, const RaycastRay* rays,
+                   int count, RaycastHit* hits) {
+    WorldCursor cursor;
+    world_cursor_init(&cursor, world);
+
+    for (int i = 0; i < count; i++) {
+        const RaycastRay* ray = &rays[i];
+        RaycastHit* hit = &hits[i];
+        *hit = (RaycastHit){ .face = FACE_TOP, .distance = ray->max_distance };
+
+        Vector3 direction = Vector3Normalize(ray->direction);
+        ray_walk_blocks(&cursor, ray->origin, direction, ray->max_distance, hit);
+
+        // Entities only count in front of the block hit; the shorter segment
+        // also shrinks the grid query
+        if (manager) {
+            hit->entity = raycast_entity(manager, ray->origin, direction, hit->distance);
+            if (hit->entity) {
+                Vector3 box_min = Vector3Add(hit->entity->position, hit->entity->bbox_min);
+                Vector3 box_max = Vector3Add(hit->entity->position, hit->entity->bbox_max);
+                ray_intersects_aabb(ray->origin, direction, box_min, box_max, &hit->entity_distance);
+            }
+        }
+    }
+}
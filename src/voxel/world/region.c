@@ -0,0 +1,766 @@
+/**
+ * Region Storage Implementation
+ *
+ * File layout:
+ *   [offset table: REGION_CHUNKS x {u32 sector offset, u32 byte length}]
+ *   [sector 2..N: chunk payloads, each in whole sectors; unused sectors are free]
+ * Chunk payload:
+ *   magic, version, flags, run count, checksum, then runs of
+ *   {u16 length, u8 type, u8 light_level, u8 metadata} in Y-major order,
+ *   then (version 2) u16 chest count and per chest
+ *   {u8 local x, u8 y, u8 local z, u8 flags, CHEST_SLOTS x item}
+ *   with item = {u16 type, u8 count, u16 durability, u16 max durability}
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include "voxel/world/region.h"
+#include "voxel/world/chest.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_MAGIC 0x31435856u   // "VXC1"
+#define CHUNK_VERSION 2
+#define CHUNK_VERSION_NO_CHESTS 1  // Still read: no chest section
+#define CHUNK_HEADER_BYTES 16
+#define CHUNK_RUN_BYTES 5
+#define CHUNK_FLAG_SPAWNED 0x0001
+#define CHUNK_ITEM_BYTES 7
+#define CHUNK_CHEST_BYTES (4 + CHEST_SLOTS * CHUNK_ITEM_BYTES)
+#define CHUNK_CHEST_LOOTED 0x01
+
+// ============================================================================
+// BYTE HELPERS
+// ============================================================================
+
+static void put_u16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)(v & 0xFF);
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_u32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v & 0xFF);
+    p[1] = (uint8_t)((v >> 8) & 0xFF);
+    p[2] = (uint8_t)((v >> 16) & 0xFF);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint16_t get_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t checksum(const uint8_t* data, uint32_t size) {
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < size; i++) {
+        h = (h ^ data[i]) * 16777619u;
+    }
+    return h;
+}
+
+/**
+ * Floor division for region coordinates
+ */
+static int region_coord(int chunk_coord) {
+    return chunk_coord >= 0 ? chunk_coord / REGION_SIZE : (chunk_coord - REGION_SIZE + 1) / REGION_SIZE;
+}
+
+static int region_index(int chunk_x, int chunk_z) {
+    int lx = chunk_x - region_coord(chunk_x) * REGION_SIZE;
+    int lz = chunk_z - region_coord(chunk_z) * REGION_SIZE;
+    return lz * REGION_SIZE + lx;
+}
+
+static bool pread_full(int fd, void* buf, size_t size, off_t offset) {
+    uint8_t* p = (uint8_t*)buf;
+    while (size > 0) {
+        ssize_t n = pread(fd, p, size, offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= (size_t)n;
+        offset += n;
+    }
+    return true;
+}
+
+static bool pwrite_full(int fd, const void* buf, size_t size, off_t offset) {
+    const uint8_t* p = (const uint8_t*)buf;
+    while (size > 0) {
+        ssize_t n = pwrite(fd, p, size, offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= (size_t)n;
+        offset += n;
+    }
+    return true;
+}
+
+// ============================================================================
+// CHUNK SERIALIZATION
+// ============================================================================
+
+/**
+ * Run being extended while encoding
+ */
+typedef struct {
+    uint8_t* runs;
+    uint32_t count;
+    Block current;
+    uint32_t length;
+} RunWriter;
+
+static void run_flush(RunWriter* w) {
+    if (w->length == 0) return;
+    uint8_t* r = w->runs + w->count * CHUNK_RUN_BYTES;
+    put_u16(r, (uint16_t)w->length);
+    r[2] = w->current.type;
+    r[3] = w->current.light_level;
+    r[4] = w->current.metadata;
+    w->count++;
+    w->length = 0;
+}
+
+/**
+ * Append length copies of b, splitting runs at the u16 length limit
+ */
+static void run_append(RunWriter* w, Block b, uint32_t length) {
+    bool same = w->length > 0 && b.type == w->current.type &&
+                b.light_level == w->current.light_level && b.metadata == w->current.metadata;
+    if (!same) {
+        run_flush(w);
+        w->current = b;
+    }
+    while (length > 0) {
+        uint32_t take = 0xFFFF - w->length;
+        if (take > length) take = length;
+        w->length += take;
+        length -= take;
+        if (length > 0) run_flush(w);
+    }
+}
+
+/**
+ * Encode chunk blocks as runs. Caller frees *out_data
+ */
+static bool serialize_chunk(Chunk* chunk, uint8_t** out_data, uint32_t* out_size) {
+    int chest_count = 0;
+    for (ChestData* chest = chunk->chests; chest; chest = chest->next) chest_count++;
+
+    // Worst case: every block is its own run
+    size_t capacity = CHUNK_HEADER_BYTES + (size_t)CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE * CHUNK_RUN_BYTES +
+                      2 + (size_t)chest_count * CHUNK_CHEST_BYTES;
+    uint8_t* data = (uint8_t*)malloc(capacity);
+    if (!data) return false;
+
+    uint8_t* runs = data + CHUNK_HEADER_BYTES;
+    RunWriter writer = {runs, 0, {0}, 0};
+
+    for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+        // Sky and buried stone sections are one run, written without reading blocks
+        Block uniform;
+        if (chunk_section_uniform(chunk, sy, &uniform)) {
+            run_append(&writer, uniform, CHUNK_SECTION_VOLUME);
+            continue;
+        }
+        for (int y = sy * CHUNK_SECTION_HEIGHT; y < (sy + 1) * CHUNK_SECTION_HEIGHT; y++) {
+            for (int x = 0; x < CHUNK_SIZE; x++) {
+                for (int z = 0; z < CHUNK_SIZE; z++) {
+                    run_append(&writer, chunk_get_block(chunk, x, y, z), 1);
+                }
+            }
+        }
+    }
+    run_flush(&writer);
+    uint32_t run_count = writer.count;
+
+    uint8_t* p = runs + run_count * CHUNK_RUN_BYTES;
+    put_u16(p, (uint16_t)chest_count);
+    p += 2;
+    for (ChestData* chest = chunk->chests; chest; chest = chest->next) {
+        p[0] = (uint8_t)(chest->x - chunk->x * CHUNK_SIZE);
+        p[1] = (uint8_t)chest->y;
+        p[2] = (uint8_t)(chest->z - chunk->z * CHUNK_SIZE);
+        p[3] = chest->loot_generated ? CHUNK_CHEST_LOOTED : 0;
+        p += 4;
+        for (int i = 0; i < CHEST_SLOTS; i++) {
+            const ItemStack* item = &chest->slots[i];
+            put_u16(p, (uint16_t)item->type);
+            p[2] = item->count;
+            put_u16(p + 3, item->durability);
+            put_u16(p + 5, item->max_durability);
+            p += CHUNK_ITEM_BYTES;
+        }
+    }
+
+    uint32_t payload = (uint32_t)(p - runs);
+    uint16_t flags = chunk->has_spawned ? CHUNK_FLAG_SPAWNED : 0;
+    put_u32(data + 0, CHUNK_MAGIC);
+    put_u16(data + 4, CHUNK_VERSION);
+    put_u16(data + 6, flags);
+    put_u32(data + 8, run_count);
+    put_u32(data + 12, checksum(runs, payload));  // Runs and chests
+
+    // Shrink to actual size (typically a few KB)
+    uint32_t size = CHUNK_HEADER_BYTES + payload;
+    uint8_t* shrunk = (uint8_t*)realloc(data, size);
+    *out_data = shrunk ? shrunk : data;
+    *out_size = size;
+    return true;
+}
+
+/**
+ * Decode the chest section into chunk->chests
+ */
+static bool deserialize_chests(Chunk* chunk, const uint8_t* p, const uint8_t* end) {
+    int chest_count = get_u16(p);
+    p += 2;
+    if ((size_t)(end - p) != (size_t)chest_count * CHUNK_CHEST_BYTES) return false;
+
+    for (int c = 0; c < chest_count; c++) {
+        ChestData* chest = chest_create(chunk, chunk->x * CHUNK_SIZE + p[0], p[1], chunk->z * CHUNK_SIZE + p[2]);
+        if (!chest) return false;
+        chest->loot_generated = (p[3] & CHUNK_CHEST_LOOTED) != 0;
+        p += 4;
+        for (int i = 0; i < CHEST_SLOTS; i++) {
+            chest->slots[i] = (ItemStack){
+                .type = (ItemType)get_u16(p),
+                .count = p[2],
+                .durability = get_u16(p + 3),
+                .max_durability = get_u16(p + 5)
+            };
+            p += CHUNK_ITEM_BYTES;
+        }
+    }
+    return true;
+}
+
+/**
+ * Decode runs into a freshly created (all-air) chunk
+ */
+static bool deserialize_chunk(Chunk* chunk, const uint8_t* data, uint32_t size) {
+    if (size < CHUNK_HEADER_BYTES) return false;
+    uint16_t version = get_u16(data + 4);
+    if (get_u32(data) != CHUNK_MAGIC) return false;
+    if (version != CHUNK_VERSION && version != CHUNK_VERSION_NO_CHESTS) return false;
+
+    uint16_t flags = get_u16(data + 6);
+    uint32_t run_count = get_u32(data + 8);
+    const uint8_t* runs = data + CHUNK_HEADER_BYTES;
+    uint64_t run_bytes = (uint64_t)run_count * CHUNK_RUN_BYTES;
+    if (version == CHUNK_VERSION_NO_CHESTS ? run_bytes != size - CHUNK_HEADER_BYTES
+                                           : run_bytes + 2 > size - CHUNK_HEADER_BYTES) {
+        return false;
+    }
+    if (checksum(runs, size - CHUNK_HEADER_BYTES) != get_u32(data + 12)) return false;
+
+    const int total = CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE;
+    int index = 0;
+    for (uint32_t i = 0; i < run_count; i++) {
+        const uint8_t* r = runs + i * CHUNK_RUN_BYTES;
+        int length = get_u16(r);
+        Block b = {r[2], r[3], r[4]};
+        if (index + length > total) return false;
+
+        // Air with no light is the chunk_create default - skip it
+        if (b.type == BLOCK_AIR && b.light_level == 0 && b.metadata == 0) {
+            index += length;
+            continue;
+        }
+        int end = index + length;
+        while (index < end) {
+            // Whole sections inside the run are filled without arrays
+            if (index % CHUNK_SECTION_VOLUME == 0 && end - index >= CHUNK_SECTION_VOLUME) {
+                chunk_fill_section(chunk, index / CHUNK_SECTION_VOLUME, b);
+                index += CHUNK_SECTION_VOLUME;
+                continue;
+            }
+            int y = index / (CHUNK_SIZE * CHUNK_SIZE);
+            int x = (index / CHUNK_SIZE) % CHUNK_SIZE;
+            int z = index % CHUNK_SIZE;
+            chunk_set_block(chunk, x, y, z, b);
+            index++;
+        }
+    }
+    if (index != total) return false;
+
+    if (version != CHUNK_VERSION_NO_CHESTS && !deserialize_chests(chunk, runs + run_bytes, data + size)) {
+        return false;
+    }
+
+    chunk_compact_storage(chunk);
+    chunk->has_spawned = (flags & CHUNK_FLAG_SPAWNED) != 0;
+    return true;
+}
+
+// ============================================================================
+// REGION FILES (call with file_mutex held)
+// ============================================================================
+
+static void region_file_close(RegionFile* region) {
+    if (region->fd >= 0) close(region->fd);
+    free(region->sector_map);
+    free(region);
+}
+
+/**
+ * Sectors a payload occupies (at least one, so a stored chunk has an offset)
+ */
+static uint32_t region_sectors(uint32_t byte_length) {
+    uint32_t sectors = (byte_length + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE;
+    return sectors > 0 ? sectors : 1;
+}
+
+static bool region_sector_used(const RegionFile* region, uint32_t sector) {
+    return sector < region->sector_capacity && (region->sector_map[sector >> 3] >> (sector & 7)) & 1;
+}
+
+/**
+ * Mark sectors [first, first + count) used or free, growing the map and the
+ * file's sector count as needed. Returns false if the map cannot grow
+ */
+static bool region_mark_sectors(RegionFile* region, uint32_t first, uint32_t count, bool used) {
+    uint32_t end = first + count;
+    if (end > region->sector_capacity) {
+        uint32_t capacity = region->sector_capacity > 0 ? region->sector_capacity : 64;
+        while (capacity < end) capacity *= 2;
+        uint8_t* map = (uint8_t*)realloc(region->sector_map, capacity / 8);
+        if (!map) return false;
+        memset(map + region->sector_capacity / 8, 0, (capacity - region->sector_capacity) / 8);
+        region->sector_map = map;
+        region->sector_capacity = capacity;
+    }
+
+    for (uint32_t sector = first; sector < end; sector++) {
+        if (used) {
+            region->sector_map[sector >> 3] |= (uint8_t)(1u << (sector & 7));
+        } else {
+            region->sector_map[sector >> 3] &= (uint8_t)~(1u << (sector & 7));
+        }
+    }
+    if (used && end > region->sector_count) region->sector_count = end;
+    return true;
+}
+
+/**
+ * First run of count free sectors; past the last used sector if none fits
+ */
+static uint32_t region_find_free(const RegionFile* region, uint32_t count) {
+    uint32_t run = 0;
+    for (uint32_t sector = REGION_HEADER_SECTORS; sector < region->sector_count; sector++) {
+        run = region_sector_used(region, sector) ? 0 : run + 1;
+        if (run == count) return sector + 1 - count;
+    }
+    return region->sector_count - run;
+}
+
+/**
+ * Build the sector map from the offset table. Entries outside the file or
+ * overlapping an earlier one are dropped (their chunk regenerates)
+ */
+static bool region_build_sector_map(RegionFile* region) {
+    if (!region_mark_sectors(region, 0, REGION_HEADER_SECTORS, true)) return false;
+
+    uint32_t file_sectors = region->sector_count;
+    int dropped = 0;
+    for (int i = 0; i < REGION_CHUNKS; i++) {
+        RegionEntry* entry = &region->table[i];
+        if (entry->sector_offset == 0) continue;
+
+        entry->sectors = region_sectors(entry->byte_length);
+        bool valid = entry->sector_offset >= REGION_HEADER_SECTORS && entry->sector_offset <= file_sectors &&
+                     entry->sectors <= file_sectors - entry->sector_offset;
+        for (uint32_t s = 0; valid && s < entry->sectors; s++) {
+            valid = !region_sector_used(region, entry->sector_offset + s);
+        }
+        if (!valid) {
+            memset(entry, 0, sizeof(*entry));
+            dropped++;
+            continue;
+        }
+        if (!region_mark_sectors(region, entry->sector_offset, entry->sectors, true)) return false;
+    }
+
+    if (dropped > 0) {
+        printf("[REGION] Region (%d, %d): dropped %d chunks with invalid sectors\n",
+               region->region_x, region->region_z, dropped);
+    }
+    return true;
+}
+
+/**
+ * Find or open a region file, moving it to the front of the MRU list
+ * create=false returns NULL for regions that don't exist on disk
+ */
+static RegionFile* region_file_get(RegionStorage* storage, int region_x, int region_z, bool create) {
+    RegionFile** pp = &storage->open_files;
+    while (*pp) {
+        RegionFile* region = *pp;
+        if (region->region_x == region_x && region->region_z == region_z) {
+            *pp = region->next;
+            region->next = storage->open_files;
+            storage->open_files = region;
+            return region;
+        }
+        pp = &region->next;
+    }
+
+    char path[REGION_PATH_MAX + 32];
+    snprintf(path, sizeof(path), "%s/r.%d.%d.vxr", storage->directory, region_x, region_z);
+
+    int fd = open(path, create ? (O_RDWR | O_CREAT) : O_RDWR, 0644);
+    if (fd < 0) return NULL;
+
+    RegionFile* region = (RegionFile*)calloc(1, sizeof(RegionFile));
+    if (!region) {
+        close(fd);
+        return NULL;
+    }
+    region->region_x = region_x;
+    region->region_z = region_z;
+    region->fd = fd;
+
+    // Read offset table, or write an empty one for new files
+    uint8_t header[REGION_CHUNKS * 8];
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(header) &&
+        pread_full(fd, header, sizeof(header), 0)) {
+        for (int i = 0; i < REGION_CHUNKS; i++) {
+            region->table[i].sector_offset = get_u32(header + i * 8);
+            region->table[i].byte_length = get_u32(header + i * 8 + 4);
+        }
+        region->sector_count = (uint32_t)((st.st_size + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE);
+    } else {
+        memset(header, 0, sizeof(header));
+        pwrite_full(fd, header, sizeof(header), 0);
+        region->sector_count = REGION_HEADER_SECTORS;
+    }
+    if (region->sector_count < REGION_HEADER_SECTORS) {
+        region->sector_count = REGION_HEADER_SECTORS;
+    }
+    if (!region_build_sector_map(region)) {
+        region_file_close(region);
+        return NULL;
+    }
+
+    region->next = storage->open_files;
+    storage->open_files = region;
+    storage->open_count++;
+
+    // Close least recently used region when over the limit
+    if (storage->open_count > REGION_MAX_OPEN) {
+        RegionFile* prev = storage->open_files;
+        while (prev->next && prev->next->next) prev = prev->next;
+        region_file_close(prev->next);
+        prev->next = NULL;
+        storage->open_count--;
+    }
+
+    return region;
+}
+
+static void region_file_write_chunk(RegionStorage* storage, RegionWrite* write) {
+    RegionFile* region = region_file_get(storage, region_coord(write->chunk_x),
+                                         region_coord(write->chunk_z), true);
+    if (!region) {
+        printf("[REGION] Failed to open region for chunk (%d, %d)\n", write->chunk_x, write->chunk_z);
+        return;
+    }
+
+    int index = region_index(write->chunk_x, write->chunk_z);
+    RegionEntry* entry = &region->table[index];
+    uint32_t needed = region_sectors(write->size);
+
+    // Write to free sectors: the old copy stays whole until the table
+    // points at the new one, so a crash mid-write loses no chunk
+    uint32_t sector = region_find_free(region, needed);
+    if (!region_mark_sectors(region, sector, needed, true)) {
+        printf("[REGION] Out of memory for chunk (%d, %d)\n", write->chunk_x, write->chunk_z);
+        return;
+    }
+    if (!pwrite_full(region->fd, write->data, write->size, (off_t)sector * REGION_SECTOR_SIZE)) {
+        printf("[REGION] Write failed for chunk (%d, %d)\n", write->chunk_x, write->chunk_z);
+        region_mark_sectors(region, sector, needed, false);
+        return;
+    }
+
+    // Update table entry after data is on disk, then free the old sectors
+    uint8_t raw[8];
+    put_u32(raw, sector);
+    put_u32(raw + 4, write->size);
+    if (!pwrite_full(region->fd, raw, sizeof(raw), (off_t)index * 8)) {
+        printf("[REGION] Table update failed for chunk (%d, %d)\n", write->chunk_x, write->chunk_z);
+        region_mark_sectors(region, sector, needed, false);
+        return;
+    }
+    if (entry->sector_offset != 0) {
+        region_mark_sectors(region, entry->sector_offset, entry->sectors, false);
+    }
+    entry->sector_offset = sector;
+    entry->byte_length = write->size;
+    entry->sectors = needed;
+}
+
+// ============================================================================
+// I/O THREAD
+// ============================================================================
+
+static void* region_io_thread_func(void* arg) {
+    RegionStorage* storage = (RegionStorage*)arg;
+
+    pthread_mutex_lock(&storage->write_mutex);
+    while (storage->running || storage->write_head) {
+        if (!storage->write_head) {
+            pthread_cond_wait(&storage->write_cond, &storage->write_mutex);
+            continue;
+        }
+
+        // Peek only - the entry stays visible to readers until it's on disk
+        RegionWrite* write = storage->write_head;
+        pthread_mutex_unlock(&storage->write_mutex);
+
+        pthread_mutex_lock(&storage->file_mutex);
+        region_file_write_chunk(storage, write);
+        pthread_mutex_unlock(&storage->file_mutex);
+
+        pthread_mutex_lock(&storage->write_mutex);
+        storage->write_head = write->next;
+        if (!storage->write_head) storage->write_tail = NULL;
+        storage->write_count--;
+        free(write->data);
+        free(write);
+    }
+    pthread_mutex_unlock(&storage->write_mutex);
+    return NULL;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+RegionStorage* region_storage_create(const char* directory) {
+    if (!directory) return NULL;
+
+    // Create each path component (mkdir -p)
+    char path[REGION_PATH_MAX];
+    snprintf(path, sizeof(path), "%s", directory);
+    for (char* p = path + 1; *p; p++) {
+        if (*p == '/') {
+            *p = '\0';
+            mkdir(path, 0755);
+            *p = '/';
+        }
+    }
+    if (mkdir(path, 0755) != 0 && errno != EEXIST) {
+        printf("[REGION] Failed to create save directory '%s'\n", path);
+        return NULL;
+    }
+
+    RegionStorage* storage = (RegionStorage*)calloc(1, sizeof(RegionStorage));
+    if (!storage) {
+        printf("[REGION] Failed to allocate region storage\n");
+        return NULL;
+    }
+
+    snprintf(storage->directory, sizeof(storage->directory), "%s", path);
+    pthread_mutex_init(&storage->file_mutex, NULL);
+    pthread_mutex_init(&storage->write_mutex, NULL);
+    pthread_cond_init(&storage->write_cond, NULL);
+    storage->running = true;
+
+    if (pthread_create(&storage->io_thread, NULL, region_io_thread_func, storage) != 0) {
+        printf("[REGION] Failed to create I/O thread\n");
+        pthread_mutex_destroy(&storage->file_mutex);
+        pthread_mutex_destroy(&storage->write_mutex);
+        pthread_cond_destroy(&storage->write_cond);
+        free(storage);
+        return NULL;
+    }
+
+    printf("[REGION] Opened save directory '%s'\n", storage->directory);
+    return storage;
+}
+
+void region_storage_destroy(RegionStorage* storage) {
+    if (!storage) return;
+
+    int pending = region_storage_pending_writes(storage);
+    if (pending > 0) {
+        printf("[REGION] Flushing %d pending chunk writes...\n", pending);
+    }
+
+    // I/O thread drains the queue before exiting
+    pthread_mutex_lock(&storage->write_mutex);
+    storage->running = false;
+    pthread_cond_signal(&storage->write_cond);
+    pthread_mutex_unlock(&storage->write_mutex);
+    pthread_join(storage->io_thread, NULL);
+
+    RegionFile* region = storage->open_files;
+    while (region) {
+        RegionFile* next = region->next;
+        fsync(region->fd);
+        region_file_close(region);
+        region = next;
+    }
+
+    pthread_mutex_destroy(&storage->file_mutex);
+    pthread_mutex_destroy(&storage->write_mutex);
+    pthread_cond_destroy(&storage->write_cond);
+    free(storage);
+    printf("[REGION] Closed region storage\n");
+}
+
+bool region_storage_save_chunk(RegionStorage* storage, Chunk* chunk) {
+    if (!storage || !chunk) return false;
+
+    uint8_t* data;
+    uint32_t size;
+    if (!serialize_chunk(chunk, &data, &size)) return false;
+    if (!region_storage_write_raw(storage, chunk->x, chunk->z, data, size)) return false;
+
+    chunk->needs_save = false;
+    return true;
+}
+
+bool region_storage_write_raw(RegionStorage* storage, int chunk_x, int chunk_z, uint8_t* data, uint32_t size) {
+    if (!storage || !data) {
+        free(data);
+        return false;
+    }
+
+    RegionWrite* write = (RegionWrite*)malloc(sizeof(RegionWrite));
+    if (!write) {
+        free(data);
+        return false;
+    }
+    write->chunk_x = chunk_x;
+    write->chunk_z = chunk_z;
+    write->data = data;
+    write->size = size;
+    write->next = NULL;
+
+    pthread_mutex_lock(&storage->write_mutex);
+    if (storage->write_tail) {
+        storage->write_tail->next = write;
+    } else {
+        storage->write_head = write;
+    }
+    storage->write_tail = write;
+    storage->write_count++;
+    pthread_cond_signal(&storage->write_cond);
+    pthread_mutex_unlock(&storage->write_mutex);
+    return true;
+}
+
+uint8_t* region_storage_read_raw(RegionStorage* storage, int chunk_x, int chunk_z, uint32_t* out_size) {
+    *out_size = 0;
+    if (!storage) return NULL;
+
+    uint8_t* data = NULL;
+    uint32_t size = 0;
+
+    // Newest queued write wins over what's on disk
+    pthread_mutex_lock(&storage->write_mutex);
+    RegionWrite* latest = NULL;
+    for (RegionWrite* w = storage->write_head; w; w = w->next) {
+        if (w->chunk_x == chunk_x && w->chunk_z == chunk_z) latest = w;
+    }
+    if (latest) {
+        data = (uint8_t*)malloc(latest->size);
+        if (data) {
+            memcpy(data, latest->data, latest->size);
+            size = latest->size;
+        }
+    }
+    pthread_mutex_unlock(&storage->write_mutex);
+
+    if (!data) {
+        pthread_mutex_lock(&storage->file_mutex);
+        RegionFile* region = region_file_get(storage, region_coord(chunk_x),
+                                             region_coord(chunk_z), false);
+        if (region) {
+            RegionEntry entry = region->table[region_index(chunk_x, chunk_z)];
+            if (entry.sector_offset != 0 && entry.byte_length > 0) {
+                data = (uint8_t*)malloc(entry.byte_length);
+                if (data && pread_full(region->fd, data, entry.byte_length,
+                                       (off_t)entry.sector_offset * REGION_SECTOR_SIZE)) {
+                    size = entry.byte_length;
+                } else {
+                    free(data);
+                    data = NULL;
+                }
+            }
+        }
+        pthread_mutex_unlock(&storage->file_mutex);
+    }
+
+    *out_size = size;
+    return data;
+}
+
+bool region_storage_load_chunk(RegionStorage* storage, Chunk* chunk) {
+    if (!storage || !chunk) return false;
+
+    uint32_t size;
+    uint8_t* data = region_storage_read_raw(storage, chunk->x, chunk->z, &size);
+    if (!data) return false;
+
+    bool ok = deserialize_chunk(chunk, data, size);
+    free(data);
+
+    if (!ok) {
+        printf("[REGION] Corrupt data for chunk (%d, %d), regenerating\n", chunk->x, chunk->z);
+        chunk_fill(chunk, BLOCK_AIR);
+        return false;
+    }
+
+    chunk->needs_save = false;
+    return true;
+}
+
+bool region_storage_read_seed(RegionStorage* storage, uint32_t* seed) {
+    if (!storage || !seed) return false;
+
+    char path[REGION_PATH_MAX + 32];
+    snprintf(path, sizeof(path), "%s/level.dat", storage->directory);
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+
+    unsigned int value = 0;
+    bool ok = fscanf(f, "seed=%u", &value) == 1;
+    fclose(f);
+    if (ok) *seed = value;
+    return ok;
+}
+
+bool region_storage_write_seed(RegionStorage* storage, uint32_t seed) {
+    if (!storage) return false;
+
+    char path[REGION_PATH_MAX + 32];
+    snprintf(path, sizeof(path), "%s/level.dat", storage->directory);
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        printf("[REGION] Failed to write '%s'\n", path);
+        return false;
+    }
+    fprintf(f, "seed=%u\n", (unsigned int)seed);
+    fclose(f);
+    return true;
+}
+
+int region_storage_pending_writes(RegionStorage* storage) {
+    if (!storage) return 0;
+    pthread_mutex_lock(&storage->write_mutex);
+    int count = storage->write_count;
+    pthread_mutex_unlock(&storage->write_mutex);
+    return count;
+}
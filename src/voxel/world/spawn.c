@@ -8,6 +8,10 @@
 #include "voxel/entity/sheep.h"
 #include "voxel/entity/pig.h"
 #include "voxel/world/chunk.h"
+#include "voxel/world/world.h"
+#include "voxel/world/column_cache.h"
+#include "voxel/world/noise.h"
+#include "voxel/world/random.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
@@ -61,125 +65,156 @@ void spawn_system_init(void) {
 // RANDOM HELPERS
 // ============================================================================
 
-// Simple deterministic hash for chunk coordinates
-static unsigned int hash_chunk_coords(int x, int z) {
-    unsigned int h = (unsigned int)(x * 374761393 + z * 668265263);
-    h = (h ^ (h >> 13)) * 1274126177;
-    return h ^ (h >> 16);
-}
-
-// Random float [0, 1) using current rand state
-static float random_float(void) {
-    return (float)rand() / (float)RAND_MAX;
-}
-
 // Gaussian-ish distribution using Box-Muller (simplified)
 // Returns value roughly in [-2, 2] with most values near 0
-static float random_gaussian(void) {
+static float random_gaussian(RandomStream* rng) {
     // Use sum of uniform randoms for approximate gaussian
     float sum = 0.0f;
     for (int i = 0; i < 3; i++) {
-        sum += random_float();
+        sum += random_next_float(rng);
     }
     return (sum / 3.0f - 0.5f) * 4.0f;  // Center around 0, scale
 }
 
 // ============================================================================
-// HERD SPAWNING
+// SPAWN PLANNING
 // ============================================================================
 
-void spawn_herd(EntityManager* manager, EntityType type, Vector3 center,
-                int count, float radius, TerrainParams params) {
-    if (!manager) return;
+static const Color wool_colors[] = {
+    {245, 245, 245, 255},  // White (most common)
+    {180, 180, 180, 255},  // Light Gray
+    {100, 100, 100, 255},  // Gray
+    {30, 30, 30, 255},     // Black
+    {200, 50, 50, 255},    // Red
+    {50, 150, 50, 255},    // Green
+    {50, 50, 200, 255},    // Blue
+};
 
+#define WOOL_COLOR_COUNT ((int)(sizeof(wool_colors) / sizeof(wool_colors[0])))
+
+/**
+ * Plan the members of one herd around its center
+ * Every member draws from the stream even when out is full, so a chunk's
+ * plan never depends on how much room it had.
+ */
+static int spawn_plan_herd(ChunkSpawn* out, int max, EntityType type, float center_x, float center_z,
+                           int count, float radius, ColumnCache* columns, RandomStream* rng) {
+    int planned = 0;
     for (int i = 0; i < count; i++) {
         // Spread animals around herd center using gaussian distribution
         // This clusters animals near the center for natural herding
-        float angle = random_float() * 2.0f * 3.14159f;
-        float dist = fabsf(random_gaussian()) * radius * 0.4f;
-
-        float x = center.x + cosf(angle) * dist;
-        float z = center.z + sinf(angle) * dist;
-        float y = (float)terrain_get_height_at((int)x, (int)z, params) + 1.0f;
+        float angle = random_next_float(rng) * 2.0f * 3.14159f;
+        float dist = fabsf(random_gaussian(rng)) * radius * 0.4f;
 
-        Vector3 pos = { x + 0.5f, y, z + 0.5f };
+        float x = center_x + cosf(angle) * dist;
+        float z = center_z + sinf(angle) * dist;
+        float y = (float)column_cache_get_height(columns, (int)x, (int)z) + 1.0f;
 
-        Entity* entity = NULL;
+        uint8_t variant = 0;
         if (type == ENTITY_TYPE_SHEEP) {
-            // Random wool color for variety
-            Color wool_colors[] = {
-                {245, 245, 245, 255},  // White (most common)
-                {180, 180, 180, 255},  // Light Gray
-                {100, 100, 100, 255},  // Gray
-                {30, 30, 30, 255},     // Black
-                {200, 50, 50, 255},    // Red
-                {50, 150, 50, 255},    // Green
-                {50, 50, 200, 255},    // Blue
-            };
-            int color_idx = rand() % 7;  // Weight towards white (will be adjusted)
-            // Bias towards white (50% chance of white)
-            if (rand() % 2 == 0) color_idx = 0;
-
-            entity = sheep_spawn_colored(manager, pos, wool_colors[color_idx]);
-        } else if (type == ENTITY_TYPE_PIG) {
-            entity = pig_spawn(manager, pos);
+            // Random wool color for variety, half of them white
+            variant = (uint8_t)random_next_int(rng, WOOL_COLOR_COUNT);
+            if (random_next_int(rng, 2) == 0) variant = 0;
         }
 
-        if (entity && i == 0) {
-            // First animal of herd spawned successfully
+        if (planned < max) {
+            out[planned++] = (ChunkSpawn){ x + 0.5f, y, z + 0.5f, (uint8_t)type, variant };
         }
     }
+    return planned;
 }
 
-// ============================================================================
-// PER-CHUNK SPAWNING
-// ============================================================================
-
-void spawn_animals_for_chunk(struct World* world, int chunk_x, int chunk_z, TerrainParams params) {
-    if (!world) return;
-
-    // Get entity manager from world
-    // Note: World needs to expose entity_manager or we need a getter
-    extern EntityManager* world_get_entity_manager(struct World* world);
-    EntityManager* manager = world_get_entity_manager(world);
-    if (!manager) return;
+int spawn_plan_chunk(ColumnCache* columns, int chunk_x, int chunk_z, ChunkSpawn* out, int max) {
+    if (!columns || !out) return 0;
 
     // Get chunk center in world coordinates
     int world_x = chunk_x * CHUNK_SIZE + CHUNK_SIZE / 2;
     int world_z = chunk_z * CHUNK_SIZE + CHUNK_SIZE / 2;
 
     // Determine biome at chunk center
-    BiomeType biome = biome_get_at(world_x, world_z);
+    BiomeType biome = column_cache_get_biome(columns, world_x, world_z);
     const BiomeSpawnRules* rules = &biome_spawn_rules[biome];
 
     // No animals in this biome?
-    if (rules->herd_rule_count == 0) return;
+    if (rules->herd_rule_count == 0) return 0;
 
-    // Use deterministic seed for this chunk (reproducible world)
-    unsigned int seed = hash_chunk_coords(chunk_x, chunk_z);
-    srand(seed);
+    // Per-chunk stream of this world (reproducible, leaves rand() alone)
+    RandomStream rng = random_stream(random_hash_2d(chunk_x, chunk_z,
+                                                    random_feature_seed(noise_get_seed(), RANDOM_FEATURE_ANIMALS)));
 
     // Try spawning each herd type
+    int planned = 0;
     for (int i = 0; i < rules->herd_rule_count; i++) {
         const HerdSpawnRule* herd = &rules->herd_rules[i];
 
         // Roll for spawn chance
-        if (random_float() < herd->spawn_chance) {
+        if (random_next_float(&rng) < herd->spawn_chance) {
             // Pick random position within chunk
-            float herd_x = (float)world_x + (random_float() - 0.5f) * CHUNK_SIZE;
-            float herd_z = (float)world_z + (random_float() - 0.5f) * CHUNK_SIZE;
-            float herd_y = (float)terrain_get_height_at((int)herd_x, (int)herd_z, params) + 1.0f;
-
-            Vector3 center = { herd_x, herd_y, herd_z };
+            float herd_x = (float)world_x + (random_next_float(&rng) - 0.5f) * CHUNK_SIZE;
+            float herd_z = (float)world_z + (random_next_float(&rng) - 0.5f) * CHUNK_SIZE;
 
             // Determine herd size
             int size_range = herd->max_herd_size - herd->min_herd_size + 1;
-            int count = herd->min_herd_size + (rand() % size_range);
+            int count = herd->min_herd_size + random_next_int(&rng, size_range);
 
-            // Spawn the herd
-            spawn_herd(manager, herd->animal_type, center, count, herd->herd_radius, params);
+            planned += spawn_plan_herd(out + planned, max - planned, herd->animal_type, herd_x, herd_z,
+                                       count, herd->herd_radius, columns, &rng);
+        }
+    }
+    return planned;
+}
+
+// ============================================================================
+// SPAWN PLACEMENT
+// ============================================================================
+
+Entity* spawn_place(EntityManager* manager, const ChunkSpawn* spawn) {
+    if (!manager || !spawn) return NULL;
+
+    Vector3 pos = { spawn->x, spawn->y, spawn->z };
+    switch ((EntityType)spawn->type) {
+        case ENTITY_TYPE_SHEEP: {
+            int color = spawn->variant < WOOL_COLOR_COUNT ? spawn->variant : 0;
+            return sheep_spawn_colored(manager, pos, wool_colors[color]);
+        }
+        case ENTITY_TYPE_PIG:
+            return pig_spawn(manager, pos);
+        default:
+            return NULL;
+    }
+}
+
+int despawn_animals_for_chunk(struct World* world, int chunk_x, int chunk_z) {
+    if (!world) return 0;
+
+    extern EntityManager* world_get_entity_manager(struct World* world);
+    EntityManager* manager = world_get_entity_manager(world);
+    if (!manager) return 0;
+
+    Vector3 min = { (float)(chunk_x * CHUNK_SIZE), 0.0f, (float)(chunk_z * CHUNK_SIZE) };
+    Vector3 max = { min.x + CHUNK_SIZE, (float)CHUNK_HEIGHT, min.z + CHUNK_SIZE };
+
+    // Boxes straddling the border belong to the chunk holding their position
+    Entity* found[64];
+    int removed = 0;
+    for (;;) {
+        int total = entity_manager_query_box(manager, min, max, found, 64);
+        int count = total < 64 ? total : 64;
+
+        int batch = 0;
+        for (int i = 0; i < count; i++) {
+            Entity* entity = found[i];
+            if (entity->type != ENTITY_TYPE_PIG && entity->type != ENTITY_TYPE_SHEEP) continue;
+            if (entity->position.x < min.x || entity->position.x >= max.x ||
+                entity->position.z < min.z || entity->position.z >= max.z) continue;
+            entity_manager_remove(manager, entity);
+            entity_destroy(entity);
+            batch++;
         }
+        removed += batch;
+        if (total <= 64 || batch == 0) break;  // Everything seen, or only non-animals in view
     }
+    return removed;
 }
 
 const BiomeSpawnRules* spawn_get_biome_rules(BiomeType biome) {
@@ -0,0 +1,176 @@
+/**
+ * Structure Store Implementation
+ */
+
+#include "voxel/world/structure.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+static uint32_t hash_chunk_coords(int x, int z) {
+    uint32_t h = 2166136261u;
+    h = (h ^ (uint32_t)x) * 16777619u;
+    h = (h ^ (uint32_t)z) * 16777619u;
+    return h % STRUCTURE_BUCKETS;
+}
+
+/**
+ * Find a chunk's entry, optionally creating it (mutex held)
+ */
+static StructureEntry* entry_find(StructureStore* store, int chunk_x, int chunk_z, bool create) {
+    uint32_t bucket = hash_chunk_coords(chunk_x, chunk_z);
+    for (StructureEntry* entry = store->buckets[bucket]; entry; entry = entry->next) {
+        if (entry->chunk_x == chunk_x && entry->chunk_z == chunk_z) return entry;
+    }
+    if (!create) return NULL;
+
+    StructureEntry* entry = (StructureEntry*)calloc(1, sizeof(StructureEntry));
+    if (!entry) return NULL;
+    entry->chunk_x = chunk_x;
+    entry->chunk_z = chunk_z;
+    entry->next = store->buckets[bucket];
+    store->buckets[bucket] = entry;
+    store->entry_count++;
+    return entry;
+}
+
+/**
+ * Unlink and free a chunk's entry (mutex held)
+ */
+static void entry_remove(StructureStore* store, int chunk_x, int chunk_z) {
+    StructureEntry** link = &store->buckets[hash_chunk_coords(chunk_x, chunk_z)];
+    while (*link) {
+        StructureEntry* entry = *link;
+        if (entry->chunk_x == chunk_x && entry->chunk_z == chunk_z) {
+            *link = entry->next;
+            store->fragment_count -= entry->count;
+            free(entry->fragments);
+            free(entry);
+            store->entry_count--;
+            return;
+        }
+        link = &entry->next;
+    }
+}
+
+/**
+ * Append to a growable fragment array
+ */
+static bool fragments_push(StructureFragment** array, int* count, int* capacity,
+                           const StructureFragment* fragment) {
+    if (*count == *capacity) {
+        int new_capacity = *capacity ? *capacity * 2 : 8;
+        StructureFragment* grown = (StructureFragment*)realloc(*array, new_capacity * sizeof(StructureFragment));
+        if (!grown) return false;
+        *array = grown;
+        *capacity = new_capacity;
+    }
+    (*array)[(*count)++] = *fragment;
+    return true;
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+StructureStore* structure_store_create(void) {
+    StructureStore* store = (StructureStore*)calloc(1, sizeof(StructureStore));
+    if (!store) {
+        printf("[STRUCTURE] Failed to allocate structure store\n");
+        return NULL;
+    }
+    pthread_mutex_init(&store->mutex, NULL);
+    return store;
+}
+
+void structure_store_destroy(StructureStore* store) {
+    if (!store) return;
+
+    for (int b = 0; b < STRUCTURE_BUCKETS; b++) {
+        StructureEntry* entry = store->buckets[b];
+        while (entry) {
+            StructureEntry* next = entry->next;
+            free(entry->fragments);
+            free(entry);
+            entry = next;
+        }
+    }
+    free(store->late);
+    pthread_mutex_destroy(&store->mutex);
+    free(store);
+}
+
+void structure_store_add(StructureStore* store, const StructureFragment* fragment) {
+    if (!store || !fragment) return;
+
+    pthread_mutex_lock(&store->mutex);
+    if (store->fragment_count >= STRUCTURE_MAX_FRAGMENTS) {
+        if (!store->overflow_logged) {
+            printf("[STRUCTURE] %d fragments pending, clipping new structures at chunk borders\n",
+                   store->fragment_count);
+            store->overflow_logged = true;
+        }
+        pthread_mutex_unlock(&store->mutex);
+        return;
+    }
+
+    StructureEntry* entry = entry_find(store, fragment->chunk_x, fragment->chunk_z, true);
+    bool added = false;
+    if (entry && entry->sealed) {
+        added = fragments_push(&store->late, &store->late_count, &store->late_capacity, fragment);
+    } else if (entry) {
+        added = fragments_push(&entry->fragments, &entry->count, &entry->capacity, fragment);
+    }
+    if (added) store->fragment_count++;
+    pthread_mutex_unlock(&store->mutex);
+}
+
+int structure_store_claim(StructureStore* store, int chunk_x, int chunk_z, StructureFragment** out) {
+    *out = NULL;
+    if (!store) return 0;
+
+    pthread_mutex_lock(&store->mutex);
+    int count = 0;
+    StructureEntry* entry = entry_find(store, chunk_x, chunk_z, true);
+    if (entry) {
+        *out = entry->fragments;
+        count = entry->count;
+        store->fragment_count -= count;
+        entry->fragments = NULL;
+        entry->count = 0;
+        entry->capacity = 0;
+        entry->sealed = true;
+    }
+    pthread_mutex_unlock(&store->mutex);
+    return count;
+}
+
+void structure_store_release(StructureStore* store, int chunk_x, int chunk_z) {
+    if (!store) return;
+
+    pthread_mutex_lock(&store->mutex);
+    StructureEntry* entry = entry_find(store, chunk_x, chunk_z, false);
+    if (entry && entry->sealed) {
+        entry_remove(store, chunk_x, chunk_z);  // Sealed entries hold no pending fragments
+    }
+    pthread_mutex_unlock(&store->mutex);
+}
+
+int structure_store_take_late(StructureStore* store, StructureFragment* out, int max) {
+    if (!store) return 0;
+
+    pthread_mutex_lock(&store->mutex);
+    int count = store->late_count < max ? store->late_count : max;
+    if (count > 0) {
+        memcpy(out, store->late, count * sizeof(StructureFragment));
+        memmove(store->late, store->late + count, (store->late_count - count) * sizeof(StructureFragment));
+        store->late_count -= count;
+        store->fragment_count -= count;
+    }
+    pthread_mutex_unlock(&store->mutex);
+    return count;
+}
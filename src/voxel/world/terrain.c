@@ -4,11 +4,13 @@
 
 #include "voxel/world/terrain.h"
 #include "voxel/world/noise.h"
+#include "voxel/world/random.h"
+#include "voxel/world/cave.h"
 #include "voxel/core/block.h"
 #include "voxel/world/biome.h"
-#include "voxel/entity/tree.h"
-#include "voxel/render/light.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 // ============================================================================
@@ -120,9 +122,9 @@ TerrainParams terrain_default_params(void) {
  * Samples nearby biomes and blends their height_scale values
  * to create smooth transitions instead of abrupt cliffs
  */
-static float terrain_get_blended_height_scale(int world_x, int world_z) {
-    #define BLEND_RADIUS 8
+#define BLEND_RADIUS 8
 
+static float terrain_get_blended_height_scale(int world_x, int world_z) {
     float total_scale = 0.0f;
     float total_weight = 0.0f;
 
@@ -146,10 +148,42 @@ static float terrain_get_blended_height_scale(int world_x, int world_z) {
         }
     }
 
-    #undef BLEND_RADIUS
     return total_scale / total_weight;
 }
 
+/**
+ * Same blend as terrain_get_blended_height_scale, reading biomes from a grid
+ * that extends BLEND_RADIUS past the sampled column on every side
+ */
+static float blended_height_scale_from_grid(const BiomeType* grid, int stride, int gx, int gz) {
+    float total_scale = 0.0f;
+    float total_weight = 0.0f;
+    int offsets[] = {0, -BLEND_RADIUS, BLEND_RADIUS};
+
+    for (int dx = 0; dx < 3; dx++) {
+        for (int dz = 0; dz < 3; dz++) {
+            BiomeType biome = grid[(gz + offsets[dz]) * stride + gx + offsets[dx]];
+            const BiomeProperties* bp = biome_get_properties(biome);
+
+            float dist_sq = (float)(offsets[dx] * offsets[dx] + offsets[dz] * offsets[dz]);
+            float weight = 1.0f / (1.0f + dist_sq * 0.01f);
+
+            total_scale += bp->height_scale * weight;
+            total_weight += weight;
+        }
+    }
+    return total_scale / total_weight;
+}
+
+/**
+ * Turn a height noise sample and blended biome scale into a terrain height
+ */
+static int terrain_height_from_noise(float noise_value, float biome_scale, TerrainParams params) {
+    // Convert noise (-1 to 1) to height with biome scaling
+    float height = params.height_offset + (noise_value * params.height_scale * biome_scale);
+    return (int)height;
+}
+
 /**
  * Get terrain height at world coordinates
  * Applies biome-specific height scaling for varied terrain
@@ -167,211 +201,287 @@ int terrain_get_height_at(int world_x, int world_z, TerrainParams params) {
 
     // Apply blended biome height scaling for smooth transitions
     float biome_scale = terrain_get_blended_height_scale(world_x, world_z);
+    return terrain_height_from_noise(noise_value, biome_scale, params);
+}
 
-    // Convert noise (-1 to 1) to height with biome scaling
-    float height = params.height_offset + (noise_value * params.height_scale * biome_scale);
-    return (int)height;
+void terrain_compute_column_map(ColumnMap* map, int chunk_x, int chunk_z, TerrainParams params) {
+    #define BLEND_GRID (CHUNK_SIZE + 2 * BLEND_RADIUS)
+
+    int base_x = chunk_x * CHUNK_SIZE;
+    int base_z = chunk_z * CHUNK_SIZE;
+
+    // Height noise for the whole chunk in one batch
+    float height_noise[CHUNK_SIZE * CHUNK_SIZE];
+    noise_fbm_2d_grid(height_noise, base_x, base_z, CHUNK_SIZE, CHUNK_SIZE,
+                      params.height_octaves, params.height_frequency, 1.0f,
+                      params.height_lacunarity, params.height_persistence);
+
+    // Biomes once per column of the chunk plus its blend margin, instead of
+    // nine biome_get_at calls for every column
+    BiomeType biomes[BLEND_GRID * BLEND_GRID];
+    biome_get_grid(biomes, base_x - BLEND_RADIUS, base_z - BLEND_RADIUS, BLEND_GRID, BLEND_GRID);
+
+    for (int z = 0; z < CHUNK_SIZE; z++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            int gx = x + BLEND_RADIUS;
+            int gz = z + BLEND_RADIUS;
+            float biome_scale = blended_height_scale_from_grid(biomes, BLEND_GRID, gx, gz);
+            map->heights[z][x] = (int16_t)terrain_height_from_noise(height_noise[z * CHUNK_SIZE + x], biome_scale, params);
+            map->biomes[z][x] = (uint8_t)biomes[gz * BLEND_GRID + gx];
+        }
+    }
+
+    #undef BLEND_GRID
 }
 
+// ============================================================================
+// BATCHED COLUMN NOISE
+// ============================================================================
+
+#define TERRAIN_CAVE_CELL 2         // Cave noise lattice spacing in blocks (trilinear in between)
+#define TERRAIN_CAVE_MAX_DEPTH 150  // Noise caves only in the upper 150 blocks below the surface
+
 /**
- * Check if position should be cave (air)
- * Caves only form at least cave_min_depth blocks below the terrain surface
+ * Noise values of one column, batch evaluated up front over the y ranges
+ * where column_fill consults them (indexed by world y)
  */
-static bool is_cave(int world_x, int world_y, int world_z, int terrain_height, TerrainParams params) {
-    if (!params.generate_caves) return false;
-    if (world_y < params.bedrock_start) return false;  // No caves in bedrock layer
-
-    // KEY: Caves must be at least cave_min_depth blocks below the surface
-    // This prevents surface holes and makes underground feel deep
-    int depth_below_surface = terrain_height - world_y;
-    if (depth_below_surface < params.cave_min_depth) return false;
-
-    // Limit noise caves to upper 150 blocks below surface
-    if (depth_below_surface > 150) return false;
-
-    float cave_noise = noise_fbm_3d(
-        (float)world_x, (float)world_y, (float)world_z,
-        params.cave_octaves,
-        params.cave_frequency,
-        1.0f,
-        2.0f,
-        0.5f
-    );
+typedef struct TerrainColumnNoise {
+    int world_x, world_z;
+    float mix[CHUNK_HEIGHT];        // Subsoil clay/gravel and mixed bedrock
+    float diamond[CHUNK_HEIGHT];
+    float gold[CHUNK_HEIGHT];
+    float gravel[CHUNK_HEIGHT];
+    float clay[CHUNK_HEIGHT];
+    float iron[CHUNK_HEIGHT];
+    float coal[CHUNK_HEIGHT];
+    const float* cave;              // Column of the chunk's cave field (stride CHUNK_SIZE^2)
+    int cave_min_y, cave_max_y;     // World y range covered by cave
+} TerrainColumnNoise;
 
-    // Caves get more likely deeper down (gradual increase)
-    float depth_factor = (float)depth_below_surface / 100.0f;
-    if (depth_factor > 1.0f) depth_factor = 1.0f;
-    float adjusted_threshold = params.cave_threshold + (1.0f - depth_factor) * 0.15f;
-
-    return cave_noise > adjusted_threshold;
+/**
+ * Fill out[y] = noise_3d(x * scale + offset_x, y * scale, z * scale) for y in [y_min, y_max]
+ */
+static void column_noise_fill(float* out, int y_min, int y_max, int world_x, int world_z,
+                              float scale, float offset_x) {
+    if (y_min < 0) y_min = 0;
+    if (y_max > CHUNK_HEIGHT - 1) y_max = CHUNK_HEIGHT - 1;
+    if (y_max < y_min) return;
+
+    float xs[CHUNK_HEIGHT], ys[CHUNK_HEIGHT], zs[CHUNK_HEIGHT];
+    int count = y_max - y_min + 1;
+    for (int i = 0; i < count; i++) {
+        xs[i] = (float)world_x * scale + offset_x;
+        ys[i] = (float)(y_min + i) * scale;
+        zs[i] = (float)world_z * scale;
+    }
+    noise_3d_batch(xs, ys, zs, out + y_min, count);
 }
 
+static int max_int(int a, int b) { return a > b ? a : b; }
+static int min_int(int a, int b) { return a < b ? a : b; }
+
 /**
- * Get block type at world coordinates
- * Uses biome-specific surface and subsurface blocks
+ * Evaluate every ore/layer field a column of height terrain_height can reach
  */
-static BlockType get_terrain_block(int world_x, int world_y, int world_z, int terrain_height, TerrainParams params, BiomeType biome) {
-    const BiomeProperties* bp = biome_get_properties(biome);
+static void column_noise_prepare(TerrainColumnNoise* n, int world_x, int world_z,
+                                 int terrain_height, TerrainParams params) {
+    n->world_x = world_x;
+    n->world_z = world_z;
+
+    int subsoil_top = terrain_height - params.dirt_depth;
+    int subsoil_bottom = subsoil_top - params.subsoil_depth;
+
+    // Subsoil and the mixed bedrock layer share one field
+    column_noise_fill(n->mix, subsoil_bottom + 1, subsoil_top, world_x, world_z, 0.1f, 0.0f);
+    column_noise_fill(n->mix, params.bedrock_solid + 1, min_int(params.bedrock_start, subsoil_bottom),
+                      world_x, world_z, 0.1f, 0.0f);
+
+    // Deep stone ores
+    int deep_min = params.bedrock_solid + 1;
+    int deep_max = min_int(params.deep_stone_start, subsoil_bottom);
+    column_noise_fill(n->diamond, max_int(params.diamond_min_y, deep_min), min_int(params.diamond_max_y, deep_max),
+                      world_x, world_z, 0.2f, 0.0f);
+    column_noise_fill(n->gold, max_int(params.gold_min_y, deep_min), min_int(params.gold_max_y, deep_max),
+                      world_x, world_z, 0.2f, 1000.0f);
+
+    // Stone layer pockets and ores
+    int stone_min = params.deep_stone_start + 1;
+    int stone_max = subsoil_bottom;
+    column_noise_fill(n->gravel, max_int(params.gravel_min_y, stone_min), min_int(params.gravel_max_y, stone_max),
+                      world_x, world_z, 0.15f, 0.0f);
+    column_noise_fill(n->clay, max_int(params.clay_min_y, stone_min), min_int(params.clay_max_y, stone_max),
+                      world_x, world_z, 0.12f, 500.0f);
+    column_noise_fill(n->iron, max_int(params.iron_min_y, stone_min), min_int(params.iron_max_y, stone_max),
+                      world_x, world_z, 0.2f, 2000.0f);
+    column_noise_fill(n->coal, max_int(params.coal_min_y, stone_min), min_int(params.coal_max_y, stone_max),
+                      world_x, world_z, 0.2f, 3000.0f);
+}
 
-    // 1. Air above terrain
-    if (world_y > terrain_height) {
-        return BLOCK_AIR;
-    }
+// ============================================================================
+// COLUMN FILL
+// ============================================================================
 
-    // 2. Surface block (biome-specific: grass, sand, snow)
-    if (world_y == terrain_height) {
-        return bp->surface_block;
-    }
+/*
+ * A column is filled in spans: the layer boundaries (surface, subsurface,
+ * subsoil, stone, deep stone, bedrock) follow from the terrain height, so
+ * each layer is one memset. Ores, pockets and caves are then masked into
+ * their own y ranges from the batched noise, lowest priority first so a
+ * later mask wins where two overlap. The masks compare TERRAIN_LANES
+ * values at a time with GCC/Clang vector extensions, like the noise batches.
+ */
+#if defined(__GNUC__)
 
-    // 3. Subsurface (biome-specific: dirt, sand)
-    if (world_y > terrain_height - params.dirt_depth) {
-        return bp->subsurface_block;
-    }
+#if defined(__AVX2__)
+#define TERRAIN_LANES 8
+#else
+#define TERRAIN_LANES 4
+#endif
 
-    // 4. Subsoil layer - mixed clay and gravel (6 blocks)
-    int subsoil_bottom = terrain_height - params.dirt_depth - params.subsoil_depth;
-    if (world_y > subsoil_bottom) {
-        // Mix of clay and gravel in subsoil
-        float subsoil_noise = noise_3d(
-            (float)world_x * 0.1f,
-            (float)world_y * 0.1f,
-            (float)world_z * 0.1f
-        );
-        if (subsoil_noise > 0.3f) {
-            return BLOCK_CLAY;
-        } else if (subsoil_noise < -0.3f) {
-            return BLOCK_GRAVEL;
-        }
-        return BLOCK_DIRT;  // Transitional dirt
-    }
+typedef float tfloat __attribute__((vector_size(TERRAIN_LANES * sizeof(float))));
+typedef int8_t tbyte __attribute__((vector_size(TERRAIN_LANES)));
 
-    // 5. Solid bedrock foundation (y=0-4)
-    if (world_y <= params.bedrock_solid) {
-        return BLOCK_BEDROCK;
-    }
+#endif
 
-    // 6. Mixed bedrock layer (y=5-8) with gradient
-    if (world_y <= params.bedrock_start) {
-        float bedrock_noise = noise_3d(
-            (float)world_x * 0.1f,
-            (float)world_y * 0.1f,
-            (float)world_z * 0.1f
-        );
-        // More bedrock closer to y=0
-        float bedrock_chance = (float)(params.bedrock_start - world_y) / 4.0f;
-        if (bedrock_noise < bedrock_chance) {
-            return BLOCK_BEDROCK;
-        }
-    }
+/**
+ * Set types[y] = type for y in [y_min, y_max], clipped to the chunk
+ */
+static void column_span(uint8_t* types, int y_min, int y_max, BlockType type) {
+    if (y_min < 0) y_min = 0;
+    if (y_max > CHUNK_HEIGHT - 1) y_max = CHUNK_HEIGHT - 1;
+    if (y_max < y_min) return;
+    memset(types + y_min, (int)type, (size_t)(y_max - y_min + 1));
+}
 
-    // 7. Deep stone layer (y=9-32)
-    if (world_y <= params.deep_stone_start) {
-        // Check for diamond ore (very rare, very deep)
-        if (world_y >= params.diamond_min_y && world_y <= params.diamond_max_y) {
-            float ore_noise = noise_3d(
-                (float)world_x * 0.2f,
-                (float)world_y * 0.2f,
-                (float)world_z * 0.2f
-            );
-            if (ore_noise > (1.0f - params.diamond_frequency)) {
-                return BLOCK_DIAMOND_ORE;
-            }
-        }
+/**
+ * Set types[y] = type where values[y] > threshold, y in [y_min, y_max]
+ */
+static void column_mask(uint8_t* types, const float* values, int y_min, int y_max,
+                        float threshold, BlockType type) {
+    if (y_min < 0) y_min = 0;
+    if (y_max > CHUNK_HEIGHT - 1) y_max = CHUNK_HEIGHT - 1;
+
+    int y = y_min;
+#if defined(__GNUC__)
+    tbyte fill = (tbyte){0} + (int8_t)type;
+    for (; y + TERRAIN_LANES - 1 <= y_max; y += TERRAIN_LANES) {
+        tfloat v;
+        tbyte current;
+        memcpy(&v, values + y, sizeof(v));
+        memcpy(&current, types + y, sizeof(current));
+        tbyte hit = __builtin_convertvector(v > threshold, tbyte);
+        current = (current & ~hit) | (fill & hit);
+        memcpy(types + y, &current, sizeof(current));
+    }
+#endif
+    for (; y <= y_max; y++) {
+        if (values[y] > threshold) types[y] = (uint8_t)type;
+    }
+}
 
-        // Check for gold ore (rare)
-        if (world_y >= params.gold_min_y && world_y <= params.gold_max_y) {
-            float ore_noise = noise_3d(
-                (float)world_x * 0.2f + 1000.0f,
-                (float)world_y * 0.2f,
-                (float)world_z * 0.2f
-            );
-            if (ore_noise > (1.0f - params.gold_frequency)) {
-                return BLOCK_GOLD_ORE;
-            }
+/**
+ * Noise caves of one column as air, over the y range they can occupy:
+ * at least cave_min_depth and at most TERRAIN_CAVE_MAX_DEPTH below the
+ * surface, in the stone layer and above the bedrock layers
+ */
+static void column_caves(uint8_t* types, int terrain_height, int stone_min, int stone_max,
+                         const TerrainColumnNoise* n, TerrainParams params) {
+    int y_min = max_int(max_int(stone_min, params.bedrock_start), terrain_height - TERRAIN_CAVE_MAX_DEPTH);
+    int y_max = min_int(min_int(stone_max, terrain_height - params.cave_min_depth), CHUNK_HEIGHT - 1);
+    if (y_min < 0) y_min = 0;
+    if (y_max < y_min) return;
+
+    // Cave noise minus the threshold at each depth, so one mask pass applies it
+    float excess[CHUNK_HEIGHT];
+    for (int y = y_min; y <= y_max; y++) {
+        // Low-frequency field: sampled from the chunk's interpolated grid when available
+        float cave_noise;
+        if (n->cave && y >= n->cave_min_y && y <= n->cave_max_y) {
+            cave_noise = n->cave[(y - n->cave_min_y) * CHUNK_SIZE * CHUNK_SIZE];
+        } else {
+            cave_noise = noise_fbm_3d((float)n->world_x, (float)y, (float)n->world_z,
+                                      params.cave_octaves, params.cave_frequency, 1.0f, 2.0f, 0.5f);
         }
 
-        return BLOCK_DEEP_STONE;
+        // Caves get more likely deeper down (gradual increase)
+        float depth_factor = (float)(terrain_height - y) / 100.0f;
+        if (depth_factor > 1.0f) depth_factor = 1.0f;
+        excess[y] = cave_noise - (params.cave_threshold + (1.0f - depth_factor) * 0.15f);
     }
+    column_mask(types, excess, y_min, y_max, 0.0f, BLOCK_AIR);
+}
 
-    // 8. Gravel pockets
-    if (world_y >= params.gravel_min_y && world_y <= params.gravel_max_y) {
-        float gravel_noise = noise_3d(
-            (float)world_x * 0.15f,
-            (float)world_y * 0.15f,
-            (float)world_z * 0.15f
-        );
-        if (gravel_noise > (1.0f - params.gravel_frequency)) {
-            return BLOCK_GRAVEL;
-        }
-    }
+/**
+ * Fill types[0..CHUNK_HEIGHT) with the natural blocks of one column (air above
+ * the surface, biome surface and subsurface, subsoil, stone with ores, pockets
+ * and caves, deep stone with rare ores, bedrock)
+ * Noise comes from the column's precomputed fields (column_noise_prepare)
+ */
+static void column_fill(uint8_t* types, int terrain_height, const TerrainColumnNoise* n,
+                        TerrainParams params, BiomeType biome) {
+    const BiomeProperties* bp = biome_get_properties(biome);
+    int subsoil_top = terrain_height - params.dirt_depth;
+    int subsoil_bottom = subsoil_top - params.subsoil_depth;
 
-    // 9. Clay deposits in mid-levels
-    if (world_y >= params.clay_min_y && world_y <= params.clay_max_y) {
-        float clay_noise = noise_3d(
-            (float)world_x * 0.12f + 500.0f,
-            (float)world_y * 0.12f,
-            (float)world_z * 0.12f
-        );
-        if (clay_noise > (1.0f - params.clay_frequency)) {
-            return BLOCK_CLAY;
-        }
-    }
+    memset(types, BLOCK_AIR, CHUNK_HEIGHT);
 
-    // 10. Standard stone with ores
-    // Check for iron ore
-    if (world_y >= params.iron_min_y && world_y <= params.iron_max_y) {
-        float ore_noise = noise_3d(
-            (float)world_x * 0.2f + 2000.0f,
-            (float)world_y * 0.2f,
-            (float)world_z * 0.2f
-        );
-        if (ore_noise > (1.0f - params.iron_frequency)) {
-            return BLOCK_IRON_ORE;
-        }
-    }
+    // Surface and subsurface (biome-specific: grass, sand, snow over dirt, sand)
+    column_span(types, terrain_height, terrain_height, bp->surface_block);
+    column_span(types, subsoil_top + 1, terrain_height - 1, bp->subsurface_block);
 
-    // Check for coal ore
-    if (world_y >= params.coal_min_y && world_y <= params.coal_max_y) {
-        float ore_noise = noise_3d(
-            (float)world_x * 0.2f + 3000.0f,
-            (float)world_y * 0.2f,
-            (float)world_z * 0.2f
-        );
-        if (ore_noise > (1.0f - params.coal_frequency)) {
-            return BLOCK_COAL_ORE;
-        }
+    // Subsoil: mixed clay and gravel in transitional dirt
+    for (int y = max_int(subsoil_bottom + 1, 0); y <= min_int(subsoil_top, CHUNK_HEIGHT - 1); y++) {
+        float subsoil_noise = n->mix[y];
+        types[y] = subsoil_noise > 0.3f ? BLOCK_CLAY : (subsoil_noise < -0.3f ? BLOCK_GRAVEL : BLOCK_DIRT);
     }
 
-    // 11. Check for caves (after all solid blocks determined)
-    // Pass terrain_height so caves only form deep underground
-    if (is_cave(world_x, world_y, world_z, terrain_height, params)) {
-        return BLOCK_AIR;
+    // Everything below belongs to the layers under the subsoil
+    // Stone: caves first, then ores and pockets over them (gravel wins, then clay, iron, coal)
+    int stone_min = params.deep_stone_start + 1;
+    column_span(types, stone_min, subsoil_bottom, BLOCK_STONE);
+    if (params.generate_caves) {
+        column_caves(types, terrain_height, stone_min, subsoil_bottom, n, params);
     }
-
-    // Default: standard stone
-    return BLOCK_STONE;
+    column_mask(types, n->coal, max_int(params.coal_min_y, stone_min), min_int(params.coal_max_y, subsoil_bottom),
+                1.0f - params.coal_frequency, BLOCK_COAL_ORE);
+    column_mask(types, n->iron, max_int(params.iron_min_y, stone_min), min_int(params.iron_max_y, subsoil_bottom),
+                1.0f - params.iron_frequency, BLOCK_IRON_ORE);
+    column_mask(types, n->clay, max_int(params.clay_min_y, stone_min), min_int(params.clay_max_y, subsoil_bottom),
+                1.0f - params.clay_frequency, BLOCK_CLAY);
+    column_mask(types, n->gravel, max_int(params.gravel_min_y, stone_min), min_int(params.gravel_max_y, subsoil_bottom),
+                1.0f - params.gravel_frequency, BLOCK_GRAVEL);
+
+    // Deep stone with gold, and diamond over it (very rare, very deep)
+    int deep_min = params.bedrock_solid + 1;
+    int deep_max = min_int(params.deep_stone_start, subsoil_bottom);
+    column_span(types, deep_min, deep_max, BLOCK_DEEP_STONE);
+    column_mask(types, n->gold, max_int(params.gold_min_y, deep_min), min_int(params.gold_max_y, deep_max),
+                1.0f - params.gold_frequency, BLOCK_GOLD_ORE);
+    column_mask(types, n->diamond, max_int(params.diamond_min_y, deep_min), min_int(params.diamond_max_y, deep_max),
+                1.0f - params.diamond_frequency, BLOCK_DIAMOND_ORE);
+
+    // Mixed bedrock layer, more bedrock closer to the solid foundation
+    for (int y = max_int(deep_min, 0); y <= min_int(min_int(params.bedrock_start, subsoil_bottom), CHUNK_HEIGHT - 1); y++) {
+        float bedrock_chance = (float)(params.bedrock_start - y) / 4.0f;
+        if (n->mix[y] < bedrock_chance) types[y] = BLOCK_BEDROCK;
+    }
+    column_span(types, 0, min_int(params.bedrock_solid, subsoil_bottom), BLOCK_BEDROCK);
 }
 
 /**
- * Simple hash function for deterministic dungeon placement
+ * Deterministic per-chunk seed of a generation feature in this world
  */
-static unsigned int chunk_hash(int chunk_x, int chunk_z) {
-    unsigned int h = 2166136261u;
-    h ^= (unsigned int)chunk_x;
-    h *= 16777619u;
-    h ^= (unsigned int)chunk_z;
-    h *= 16777619u;
-    return h;
+static uint32_t chunk_hash(const Chunk* chunk, RandomFeature feature) {
+    return random_hash_2d(chunk->x, chunk->z, random_feature_seed(noise_get_seed(), feature));
 }
 
 /**
  * Generate a dungeon room in the chunk
  */
-static void generate_dungeon(Chunk* chunk, TerrainParams params) {
+static void generate_dungeon(Chunk* chunk, TerrainParams params, const ColumnMap* columns) {
     if (!params.generate_dungeons) return;
 
     // Use chunk coordinates to deterministically decide if this chunk has a dungeon
-    unsigned int hash = chunk_hash(chunk->x, chunk->z);
+    uint32_t hash = chunk_hash(chunk, RANDOM_FEATURE_DUNGEON);
     float dungeon_roll = (float)(hash % 1000) / 1000.0f;
 
     if (dungeon_roll > params.dungeon_frequency) return;
@@ -387,9 +497,7 @@ static void generate_dungeon(Chunk* chunk, TerrainParams params) {
     int start_y = params.dungeon_min_y + ((hash >> 4) % (params.dungeon_max_y - params.dungeon_min_y));
 
     // Make sure we're underground
-    int world_x = chunk->x * CHUNK_SIZE + start_x + size_x / 2;
-    int world_z = chunk->z * CHUNK_SIZE + start_z + size_z / 2;
-    int terrain_height = terrain_get_height_at(world_x, world_z, params);
+    int terrain_height = columns->heights[start_z + size_z / 2][start_x + size_x / 2];
 
     if (start_y + size_y >= terrain_height - 5) {
         // Too close to surface, move it down
@@ -495,15 +603,13 @@ static void generate_dungeon(Chunk* chunk, TerrainParams params) {
     }
 
     // Place 1-2 chests in the dungeon
-    unsigned int chest_seed = hash * 31337;
-    int num_chests = 1 + (chest_seed % 2);  // 1 or 2 chests
+    RandomStream chest_rng = random_stream(hash);
+    int num_chests = 1 + random_next_int(&chest_rng, 2);  // 1 or 2 chests
 
     for (int c = 0; c < num_chests; c++) {
         // Place chest somewhere in the interior (not on walls)
-        int chest_x = start_x + 1 + (chest_seed % (size_x - 2));
-        chest_seed = chest_seed * 1103515245 + 12345;
-        int chest_z = start_z + 1 + (chest_seed % (size_z - 2));
-        chest_seed = chest_seed * 1103515245 + 12345;
+        int chest_x = start_x + 1 + random_next_int(&chest_rng, size_x - 2);
+        int chest_z = start_z + 1 + random_next_int(&chest_rng, size_z - 2);
         int chest_y = start_y + 1;  // On the floor (y=1 is first interior layer)
 
         // Check bounds
@@ -520,263 +626,6 @@ static void generate_dungeon(Chunk* chunk, TerrainParams params) {
     }
 }
 
-// ============================================================================
-// CAVE TUNNEL (WORM) GENERATION
-// ============================================================================
-
-/**
- * Simple deterministic random from seed
- */
-static float random_from_seed(unsigned int* seed) {
-    *seed = (*seed * 1103515245 + 12345) & 0x7FFFFFFF;
-    return (float)*seed / (float)0x7FFFFFFF;
-}
-
-/**
- * Carve a sphere of air at the given position
- */
-static void carve_sphere(Chunk* chunk, float cx, float cy, float cz, float radius, int terrain_height, TerrainParams params) {
-    int min_x = (int)(cx - radius) - 1;
-    int max_x = (int)(cx + radius) + 1;
-    int min_y = (int)(cy - radius) - 1;
-    int max_y = (int)(cy + radius) + 1;
-    int min_z = (int)(cz - radius) - 1;
-    int max_z = (int)(cz + radius) + 1;
-
-    for (int x = min_x; x <= max_x; x++) {
-        if (x < 0 || x >= CHUNK_SIZE) continue;
-        for (int z = min_z; z <= max_z; z++) {
-            if (z < 0 || z >= CHUNK_SIZE) continue;
-            for (int y = min_y; y <= max_y; y++) {
-                if (y < params.bedrock_start || y >= CHUNK_HEIGHT) continue;
-                // Don't carve near surface
-                if (y > terrain_height - params.cave_min_depth) continue;
-
-                float dx = (float)x - cx;
-                float dy = (float)y - cy;
-                float dz = (float)z - cz;
-                float dist = sqrtf(dx*dx + dy*dy + dz*dz);
-
-                if (dist <= radius) {
-                    Block block = {BLOCK_AIR, 0, 0};
-                    chunk_set_block(chunk, x, y, z, block);
-                }
-            }
-        }
-    }
-}
-
-/**
- * Generate worm-style cave tunnels
- * Creates connected, explorable cave networks
- */
-static void generate_cave_tunnels(Chunk* chunk, TerrainParams params, int terrain_height) {
-    if (!params.generate_cave_tunnels) return;
-
-    unsigned int seed = chunk_hash(chunk->x * 7, chunk->z * 13);
-
-    // Number of tunnels varies per chunk
-    int num_tunnels = params.tunnels_per_chunk + (seed % 3) - 1;
-    if (num_tunnels < 1) num_tunnels = 1;
-
-    for (int t = 0; t < num_tunnels; t++) {
-        // Random starting position within chunk
-        float x = random_from_seed(&seed) * CHUNK_SIZE;
-        float z = random_from_seed(&seed) * CHUNK_SIZE;
-
-        // Y range: caves in upper 150 blocks below surface
-        int min_cave_y = terrain_height - 150;
-        if (min_cave_y < 20) min_cave_y = 20;
-        int max_cave_y = terrain_height - params.cave_min_depth - 10;
-        if (max_cave_y < min_cave_y + 20) max_cave_y = min_cave_y + 20;
-        float y = min_cave_y + random_from_seed(&seed) * (max_cave_y - min_cave_y);
-
-        // Random direction (mostly horizontal)
-        float dir_x = random_from_seed(&seed) * 2.0f - 1.0f;
-        float dir_y = random_from_seed(&seed) * 0.4f - 0.2f;  // Slight vertical
-        float dir_z = random_from_seed(&seed) * 2.0f - 1.0f;
-
-        // Normalize direction
-        float len = sqrtf(dir_x*dir_x + dir_y*dir_y + dir_z*dir_z);
-        if (len > 0.01f) {
-            dir_x /= len;
-            dir_y /= len;
-            dir_z /= len;
-        }
-
-        // Starting radius
-        float radius = params.tunnel_radius_min +
-                       random_from_seed(&seed) * (params.tunnel_radius_max - params.tunnel_radius_min);
-
-        // Carve the tunnel segment by segment
-        for (int seg = 0; seg < params.tunnel_segments; seg++) {
-            // Only carve if within chunk bounds
-            if (x >= -radius && x < CHUNK_SIZE + radius &&
-                z >= -radius && z < CHUNK_SIZE + radius) {
-                carve_sphere(chunk, x, y, z, radius, terrain_height, params);
-            }
-
-            // Move along direction with noise wobble
-            float wobble_x = noise_3d((float)seg * 0.1f, 0, 0) * 0.5f;
-            float wobble_y = noise_3d((float)seg * 0.1f + 100.0f, 0, 0) * 0.3f;
-            float wobble_z = noise_3d((float)seg * 0.1f + 200.0f, 0, 0) * 0.5f;
-
-            x += dir_x + wobble_x;
-            y += dir_y + wobble_y;
-            z += dir_z + wobble_z;
-
-            // Occasionally change direction
-            if (seg % 12 == 0) {
-                dir_x += random_from_seed(&seed) * 0.5f - 0.25f;
-                dir_y += random_from_seed(&seed) * 0.2f - 0.1f;
-                dir_z += random_from_seed(&seed) * 0.5f - 0.25f;
-
-                // Renormalize
-                len = sqrtf(dir_x*dir_x + dir_y*dir_y + dir_z*dir_z);
-                if (len > 0.01f) {
-                    dir_x /= len;
-                    dir_y /= len;
-                    dir_z /= len;
-                }
-            }
-
-            // Vary radius slightly
-            radius += random_from_seed(&seed) * 0.4f - 0.2f;
-            if (radius < params.tunnel_radius_min) radius = params.tunnel_radius_min;
-            if (radius > params.tunnel_radius_max) radius = params.tunnel_radius_max;
-
-            // Keep Y within valid range
-            if (y < params.bedrock_start + 20) {
-                dir_y = fabsf(dir_y);  // Go up
-            }
-            if (y > terrain_height - params.cave_min_depth - 30) {
-                dir_y = -fabsf(dir_y);  // Go down
-            }
-
-            // Branching tunnels - 25% chance every 20 segments
-            if (seg % 20 == 10 && random_from_seed(&seed) < 0.25f) {
-                // Create a branch in a perpendicular direction
-                float branch_x = x;
-                float branch_y = y;
-                float branch_z = z;
-
-                // Branch direction - perpendicular to main tunnel
-                float branch_dir_x = -dir_z + (random_from_seed(&seed) * 0.4f - 0.2f);
-                float branch_dir_y = random_from_seed(&seed) * 0.3f - 0.15f;
-                float branch_dir_z = dir_x + (random_from_seed(&seed) * 0.4f - 0.2f);
-
-                // Normalize branch direction
-                float branch_len = sqrtf(branch_dir_x*branch_dir_x + branch_dir_y*branch_dir_y + branch_dir_z*branch_dir_z);
-                if (branch_len > 0.01f) {
-                    branch_dir_x /= branch_len;
-                    branch_dir_y /= branch_len;
-                    branch_dir_z /= branch_len;
-                }
-
-                // Branch is smaller and shorter
-                float branch_radius = radius * 0.7f;
-                int branch_segments = 15 + (int)(random_from_seed(&seed) * 20);
-
-                // Carve the branch
-                for (int b = 0; b < branch_segments; b++) {
-                    if (branch_x >= -branch_radius && branch_x < CHUNK_SIZE + branch_radius &&
-                        branch_z >= -branch_radius && branch_z < CHUNK_SIZE + branch_radius) {
-                        carve_sphere(chunk, branch_x, branch_y, branch_z, branch_radius, terrain_height, params);
-                    }
-
-                    // Move branch forward with slight wobble
-                    branch_x += branch_dir_x + noise_3d((float)(seg * 10 + b) * 0.1f, 0, 0) * 0.3f;
-                    branch_y += branch_dir_y + noise_3d((float)(seg * 10 + b) * 0.1f + 50.0f, 0, 0) * 0.2f;
-                    branch_z += branch_dir_z + noise_3d((float)(seg * 10 + b) * 0.1f + 100.0f, 0, 0) * 0.3f;
-
-                    // Taper the branch
-                    branch_radius *= 0.97f;
-                    if (branch_radius < 1.5f) break;
-
-                    // Keep branch in valid Y range
-                    if (branch_y < params.bedrock_start + 10 || branch_y > terrain_height - params.cave_min_depth - 20) {
-                        break;
-                    }
-                }
-            }
-        }
-    }
-}
-
-// ============================================================================
-// CAVE ROOM GENERATION
-// ============================================================================
-
-/**
- * Carve an ellipsoid-shaped room
- */
-static void carve_ellipsoid(Chunk* chunk, float cx, float cy, float cz,
-                            float rx, float ry, float rz,
-                            int terrain_height, TerrainParams params) {
-    int min_x = (int)(cx - rx) - 1;
-    int max_x = (int)(cx + rx) + 1;
-    int min_y = (int)(cy - ry) - 1;
-    int max_y = (int)(cy + ry) + 1;
-    int min_z = (int)(cz - rz) - 1;
-    int max_z = (int)(cz + rz) + 1;
-
-    for (int x = min_x; x <= max_x; x++) {
-        if (x < 0 || x >= CHUNK_SIZE) continue;
-        for (int z = min_z; z <= max_z; z++) {
-            if (z < 0 || z >= CHUNK_SIZE) continue;
-            for (int y = min_y; y <= max_y; y++) {
-                if (y < params.bedrock_start || y >= CHUNK_HEIGHT) continue;
-                if (y > terrain_height - params.cave_min_depth) continue;
-
-                float dx = ((float)x - cx) / rx;
-                float dy = ((float)y - cy) / ry;
-                float dz = ((float)z - cz) / rz;
-                float dist = dx*dx + dy*dy + dz*dz;
-
-                if (dist <= 1.0f) {
-                    Block block = {BLOCK_AIR, 0, 0};
-                    chunk_set_block(chunk, x, y, z, block);
-                }
-            }
-        }
-    }
-}
-
-/**
- * Generate large cave rooms underground
- */
-static void generate_cave_rooms(Chunk* chunk, TerrainParams params, int terrain_height) {
-    if (!params.generate_cave_rooms) return;
-
-    unsigned int seed = chunk_hash(chunk->x * 31, chunk->z * 17);
-
-    // Number of rooms varies
-    int num_rooms = 1 + (seed % (params.rooms_per_chunk + 1));
-
-    for (int r = 0; r < num_rooms; r++) {
-        // Random position within chunk
-        float x = random_from_seed(&seed) * CHUNK_SIZE;
-        float z = random_from_seed(&seed) * CHUNK_SIZE;
-
-        // Y range: rooms in upper 120 blocks below surface
-        int min_room_y = terrain_height - 120;
-        if (min_room_y < 30) min_room_y = 30;
-        int max_room_y = terrain_height - params.cave_min_depth - 20;
-        if (max_room_y < min_room_y + 20) max_room_y = min_room_y + 20;
-        float y = min_room_y + random_from_seed(&seed) * (max_room_y - min_room_y);
-
-        // Random ellipsoid dimensions
-        float rx = params.room_radius_min +
-                   random_from_seed(&seed) * (params.room_radius_max - params.room_radius_min);
-        float ry = (params.room_radius_min * 0.6f) +
-                   random_from_seed(&seed) * ((params.room_radius_max * 0.6f) - (params.room_radius_min * 0.6f));
-        float rz = params.room_radius_min +
-                   random_from_seed(&seed) * (params.room_radius_max - params.room_radius_min);
-
-        carve_ellipsoid(chunk, x, y, z, rx, ry, rz, terrain_height, params);
-    }
-}
-
 // ============================================================================
 // CAVE FORMATIONS (Stalactites & Stalagmites)
 // ============================================================================
@@ -819,7 +668,7 @@ static void place_stalagmite(Chunk* chunk, int x, int y, int z, int height) {
 static void generate_cave_formations(Chunk* chunk, TerrainParams params, int terrain_height) {
     if (!params.generate_formations) return;
 
-    unsigned int seed = chunk_hash(chunk->x * 41, chunk->z * 37);
+    RandomStream rng = random_stream(chunk_hash(chunk, RANDOM_FEATURE_FORMATIONS));
 
     // Scan all air blocks in cave range
     int min_y = params.bedrock_start + 1;
@@ -835,8 +684,8 @@ static void generate_cave_formations(Chunk* chunk, TerrainParams params, int ter
                 // Check for stalactite (stone ceiling above)
                 Block above = chunk_get_block(chunk, x, y + 1, z);
                 if (above.type == BLOCK_STONE || above.type == BLOCK_DEEP_STONE) {
-                    if (random_from_seed(&seed) < params.formation_density) {
-                        int height = 1 + ((int)(random_from_seed(&seed) * 1000) % params.formation_max_height);
+                    if (random_next_float(&rng) < params.formation_density) {
+                        int height = 1 + ((int)(random_next_float(&rng) * 1000) % params.formation_max_height);
                         place_stalactite(chunk, x, y, z, height);
                         continue;  // Don't also place a stalagmite here
                     }
@@ -845,8 +694,8 @@ static void generate_cave_formations(Chunk* chunk, TerrainParams params, int ter
                 // Check for stalagmite (stone floor below)
                 Block below = chunk_get_block(chunk, x, y - 1, z);
                 if (below.type == BLOCK_STONE || below.type == BLOCK_DEEP_STONE) {
-                    if (random_from_seed(&seed) < params.formation_density) {
-                        int height = 1 + ((int)(random_from_seed(&seed) * 1000) % params.formation_max_height);
+                    if (random_next_float(&rng) < params.formation_density) {
+                        int height = 1 + ((int)(random_next_float(&rng) * 1000) % params.formation_max_height);
                         place_stalagmite(chunk, x, y, z, height);
                     }
                 }
@@ -996,7 +845,7 @@ static void flood_fill_water(Chunk* chunk, int start_x, int start_y, int start_z
 static void generate_cave_water(Chunk* chunk, TerrainParams params, int terrain_height) {
     if (!params.generate_water_pools) return;
 
-    unsigned int seed = chunk_hash(chunk->x * 53, chunk->z * 59);
+    RandomStream rng = random_stream(chunk_hash(chunk, RANDOM_FEATURE_WATER_POOLS));
 
     // Scan for potential pool locations
     int min_y = params.bedrock_start + 5;  // Not too close to bedrock
@@ -1024,9 +873,9 @@ static void generate_cave_water(Chunk* chunk, TerrainParams params, int terrain_
                     // Check if it's a good candidate
                     if (is_pool_candidate(chunk, x, y, z)) {
                         // Random chance to create pool
-                        if (random_from_seed(&seed) < params.water_pool_frequency) {
+                        if (random_next_float(&rng) < params.water_pool_frequency) {
                             // Determine pool depth (1-3 blocks)
-                            int depth = 1 + ((int)(random_from_seed(&seed) * 1000) % 3);
+                            int depth = 1 + ((int)(random_next_float(&rng) * 1000) % 3);
 
                             flood_fill_water(chunk, x, y, z, depth, params);
                             pools_created++;
@@ -1043,47 +892,99 @@ static void generate_cave_water(Chunk* chunk, TerrainParams params, int terrain_
 /**
  * Generate terrain for chunk
  */
-void terrain_generate_chunk(Chunk* chunk, TerrainParams params) {
+void terrain_generate_chunk(Chunk* chunk, TerrainParams params, const ColumnMap* columns) {
     if (!chunk) return;
 
-    // Calculate average terrain height for this chunk (for cave bounds)
-    int center_x = chunk->x * CHUNK_SIZE + CHUNK_SIZE / 2;
-    int center_z = chunk->z * CHUNK_SIZE + CHUNK_SIZE / 2;
-    int avg_terrain_height = terrain_get_height_at(center_x, center_z, params);
+    int base_x = chunk->x * CHUNK_SIZE;
+    int base_z = chunk->z * CHUNK_SIZE;
 
-    // For each column in the chunk
-    for (int x = 0; x < CHUNK_SIZE; x++) {
-        for (int z = 0; z < CHUNK_SIZE; z++) {
-            // Calculate world coordinates
-            int world_x = chunk->x * CHUNK_SIZE + x;
-            int world_z = chunk->z * CHUNK_SIZE + z;
+    ColumnMap local_columns;
+    if (!columns) {
+        terrain_compute_column_map(&local_columns, chunk->x, chunk->z, params);
+        columns = &local_columns;
+    }
+
+    int min_height = CHUNK_HEIGHT, max_height = 0;
+    for (int z = 0; z < CHUNK_SIZE; z++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            int h = columns->heights[z][x];
+            if (h < min_height) min_height = h;
+            if (h > max_height) max_height = h;
+        }
+    }
+
+    // Chunk-center terrain height (for cave bounds)
+    int avg_terrain_height = columns->heights[CHUNK_SIZE / 2][CHUNK_SIZE / 2];
+
+    // Cave density over the only y range noise caves can occupy, on a coarse lattice
+    float* cave_field = NULL;
+    int cave_min_y = max_int(max_int(params.deep_stone_start + 1, params.bedrock_start),
+                             min_height - TERRAIN_CAVE_MAX_DEPTH);
+    int cave_max_y = min_int(max_height - params.cave_min_depth, CHUNK_HEIGHT - 1);
+    if (params.generate_caves && cave_max_y >= cave_min_y) {
+        int layers = cave_max_y - cave_min_y + 1;
+        cave_field = (float*)malloc((size_t)layers * CHUNK_SIZE * CHUNK_SIZE * sizeof(float));
+        if (cave_field) {
+            noise_fbm_3d_grid(cave_field, base_x, cave_min_y, base_z, CHUNK_SIZE, layers, CHUNK_SIZE,
+                              TERRAIN_CAVE_CELL, params.cave_octaves, params.cave_frequency,
+                              1.0f, 2.0f, 0.5f);
+        }
+    }
 
-            // Get biome and terrain height at this column
-            BiomeType biome = biome_get_at(world_x, world_z);
-            int terrain_height = terrain_get_height_at(world_x, world_z, params);
+    // Worm tunnels and rooms, written as air while filling
+    CaveMask* carved = NULL;
+    if (params.generate_cave_tunnels || params.generate_cave_rooms) {
+        carved = (CaveMask*)malloc(sizeof(CaveMask));
+        if (carved && !cave_build_mask(carved, chunk->x, chunk->z, params, columns)) {
+            free(carved);
+            carved = NULL;
+        }
+    }
 
-            // Fill vertical column
-            for (int y = 0; y < CHUNK_HEIGHT; y++) {
-                int world_y = y;
+    // Column by column into a dense array, stored into the sections at once
+    uint8_t* types = (uint8_t*)calloc(CHUNK_VOLUME, 1);
+    if (!types) {
+        printf("[TERRAIN] Failed to allocate column fill for chunk (%d, %d)\n", chunk->x, chunk->z);
+        free(cave_field);
+        free(carved);
+        return;
+    }
 
-                // Determine block type (biome-aware)
-                BlockType block_type = get_terrain_block(world_x, world_y, world_z, terrain_height, params, biome);
+    TerrainColumnNoise column;
+    uint8_t column_types[CHUNK_HEIGHT];
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        for (int z = 0; z < CHUNK_SIZE; z++) {
+            // Get biome, terrain height and this column's noise fields
+            BiomeType biome = (BiomeType)columns->biomes[z][x];
+            int terrain_height = columns->heights[z][x];
+            column_noise_prepare(&column, base_x + x, base_z + z, terrain_height, params);
+            column.cave = cave_field ? cave_field + z * CHUNK_SIZE + x : NULL;
+            column.cave_min_y = cave_min_y;
+            column.cave_max_y = cave_max_y;
+            column_fill(column_types, terrain_height, &column, params, biome);
+
+            // Tunnels and rooms cut through every layer
+            if (carved) {
+                for (int y = carved->min_y; y <= carved->max_y; y++) {
+                    if (cave_mask_test(carved, x, y, z)) column_types[y] = BLOCK_AIR;
+                }
+            }
 
-                // Set block
-                Block block = {block_type, 0, 0};
-                chunk_set_block(chunk, x, y, z, block);
+            // Above the surface stays air from calloc
+            int top = min_int(terrain_height, CHUNK_HEIGHT - 1);
+            for (int y = 0; y <= top; y++) {
+                types[chunk_block_index(x, y, z)] = column_types[y];
             }
         }
     }
+    free(cave_field);
+    free(carved);
 
-    // Generate cave tunnels (worm caves) - main cave system
-    generate_cave_tunnels(chunk, params, avg_terrain_height);
-
-    // Generate large cave rooms
-    generate_cave_rooms(chunk, params, avg_terrain_height);
+    chunk_store_types(chunk, types);
+    free(types);
 
     // Generate dungeons underground
-    generate_dungeon(chunk, params);
+    generate_dungeon(chunk, params, columns);
 
     // Generate cave formations (stalactites & stalagmites)
     generate_cave_formations(chunk, params, avg_terrain_height);
@@ -1091,11 +992,11 @@ void terrain_generate_chunk(Chunk* chunk, TerrainParams params) {
     // Generate underground water pools in caves
     generate_cave_water(chunk, params, avg_terrain_height);
 
-    // Generate trees on the terrain
-    tree_generate_for_chunk(chunk);
+    // Trees and lighting are separate pipeline stages (tree_generate_for_chunk,
+    // light_calculate_chunk), run by the caller afterwards
 
-    // Calculate skylight propagation (must be after all blocks are placed)
-    light_calculate_chunk(chunk);
+    // Drop palette entries left over from carving passes
+    chunk_compact_storage(chunk);
 
     // Mark chunk as needing mesh regeneration
     chunk->needs_remesh = true;
@@ -0,0 +1,186 @@
+/**
+ * Terrain Cache Implementation
+ */
+
+#include "voxel/world/terrain_cache.h"
+#include "voxel/world/chunk_codec.h"
+#include "voxel/world/region.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// KEY
+// ============================================================================
+
+static uint64_t hash_bytes(uint64_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;  // FNV-1a 64
+    }
+    return hash;
+}
+
+static uint64_t hash_int(uint64_t hash, uint32_t value) {
+    return hash_bytes(hash, &value, sizeof(value));
+}
+
+static uint64_t hash_float(uint64_t hash, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return hash_int(hash, bits);
+}
+
+/**
+ * Everything terrain_generate_chunk output depends on, besides coordinates
+ */
+static uint64_t cache_key(uint32_t seed, const TerrainParams* params) {
+    uint64_t hash = 14695981039346656037ull;
+    hash = hash_int(hash, TERRAIN_CACHE_VERSION);
+    hash = hash_int(hash, CHUNK_CODEC_VERSION);
+    hash = hash_int(hash, CHUNK_SIZE);
+    hash = hash_int(hash, CHUNK_HEIGHT);
+    hash = hash_int(hash, seed);
+
+    // Field by field, so struct padding never reaches the key
+    hash = hash_float(hash, params->height_scale);
+    hash = hash_float(hash, params->height_offset);
+    hash = hash_int(hash, (uint32_t)params->height_octaves);
+    hash = hash_float(hash, params->height_frequency);
+    hash = hash_float(hash, params->height_lacunarity);
+    hash = hash_float(hash, params->height_persistence);
+
+    hash = hash_int(hash, params->generate_caves);
+    hash = hash_float(hash, params->cave_threshold);
+    hash = hash_float(hash, params->cave_frequency);
+    hash = hash_int(hash, (uint32_t)params->cave_octaves);
+    hash = hash_int(hash, (uint32_t)params->cave_min_depth);
+
+    hash = hash_int(hash, params->generate_biomes);
+    hash = hash_float(hash, params->biome_frequency);
+
+    hash = hash_int(hash, (uint32_t)params->dirt_depth);
+    hash = hash_int(hash, (uint32_t)params->subsoil_depth);
+    hash = hash_int(hash, (uint32_t)params->stone_depth);
+    hash = hash_int(hash, (uint32_t)params->deep_stone_start);
+    hash = hash_int(hash, (uint32_t)params->bedrock_start);
+    hash = hash_int(hash, (uint32_t)params->bedrock_solid);
+
+    hash = hash_float(hash, params->coal_frequency);
+    hash = hash_int(hash, (uint32_t)params->coal_min_y);
+    hash = hash_int(hash, (uint32_t)params->coal_max_y);
+    hash = hash_float(hash, params->iron_frequency);
+    hash = hash_int(hash, (uint32_t)params->iron_min_y);
+    hash = hash_int(hash, (uint32_t)params->iron_max_y);
+    hash = hash_float(hash, params->gold_frequency);
+    hash = hash_int(hash, (uint32_t)params->gold_min_y);
+    hash = hash_int(hash, (uint32_t)params->gold_max_y);
+    hash = hash_float(hash, params->diamond_frequency);
+    hash = hash_int(hash, (uint32_t)params->diamond_min_y);
+    hash = hash_int(hash, (uint32_t)params->diamond_max_y);
+
+    hash = hash_float(hash, params->gravel_frequency);
+    hash = hash_int(hash, (uint32_t)params->gravel_min_y);
+    hash = hash_int(hash, (uint32_t)params->gravel_max_y);
+    hash = hash_float(hash, params->clay_frequency);
+    hash = hash_int(hash, (uint32_t)params->clay_min_y);
+    hash = hash_int(hash, (uint32_t)params->clay_max_y);
+
+    hash = hash_int(hash, params->generate_dungeons);
+    hash = hash_float(hash, params->dungeon_frequency);
+    hash = hash_int(hash, (uint32_t)params->dungeon_min_y);
+    hash = hash_int(hash, (uint32_t)params->dungeon_max_y);
+    hash = hash_int(hash, (uint32_t)params->dungeon_min_size);
+    hash = hash_int(hash, (uint32_t)params->dungeon_max_size);
+
+    hash = hash_int(hash, params->generate_cave_tunnels);
+    hash = hash_float(hash, params->tunnel_radius_min);
+    hash = hash_float(hash, params->tunnel_radius_max);
+    hash = hash_int(hash, (uint32_t)params->tunnel_segments);
+    hash = hash_int(hash, (uint32_t)params->tunnels_per_chunk);
+
+    hash = hash_int(hash, params->generate_cave_rooms);
+    hash = hash_int(hash, (uint32_t)params->rooms_per_chunk);
+    hash = hash_float(hash, params->room_radius_min);
+    hash = hash_float(hash, params->room_radius_max);
+
+    hash = hash_int(hash, params->generate_formations);
+    hash = hash_float(hash, params->formation_density);
+    hash = hash_int(hash, (uint32_t)params->formation_max_height);
+
+    hash = hash_int(hash, params->generate_water_pools);
+    hash = hash_int(hash, (uint32_t)params->water_pool_max_y);
+    hash = hash_float(hash, params->water_pool_frequency);
+    return hash;
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+TerrainCache* terrain_cache_create(const char* root, uint32_t seed, TerrainParams params) {
+    if (!root) return NULL;
+
+    TerrainCache* cache = (TerrainCache*)calloc(1, sizeof(TerrainCache));
+    if (!cache) {
+        printf("[TERRAIN CACHE] Failed to allocate terrain cache\n");
+        return NULL;
+    }
+    cache->key = cache_key(seed, &params);
+
+    char directory[TERRAIN_CACHE_PATH_MAX];
+    snprintf(directory, sizeof(directory), "%s/%016llx", root, (unsigned long long)cache->key);
+    cache->storage = region_storage_create(directory);
+    if (!cache->storage) {
+        free(cache);
+        return NULL;
+    }
+    region_storage_write_seed(cache->storage, seed);  // For whoever browses the cache
+    pthread_mutex_init(&cache->stats_mutex, NULL);
+
+    printf("[TERRAIN CACHE] Seed %u, key %016llx\n", seed, (unsigned long long)cache->key);
+    return cache;
+}
+
+void terrain_cache_destroy(TerrainCache* cache) {
+    if (!cache) return;
+
+    uint64_t lookups = cache->hits + cache->misses;
+    printf("[TERRAIN CACHE] %llu hits, %llu misses (%.1f%% hit rate)\n",
+           (unsigned long long)cache->hits, (unsigned long long)cache->misses,
+           lookups ? 100.0 * (double)cache->hits / (double)lookups : 0.0);
+
+    region_storage_destroy(cache->storage);
+    pthread_mutex_destroy(&cache->stats_mutex);
+    free(cache);
+}
+
+bool terrain_cache_load(TerrainCache* cache, Chunk* chunk) {
+    if (!cache || !chunk) return false;
+
+    uint32_t size;
+    uint8_t* data = region_storage_read_raw(cache->storage, chunk->x, chunk->z, &size);
+    bool hit = data && chunk_codec_decode(chunk, data, size);
+    if (data && !hit) {
+        printf("[TERRAIN CACHE] Corrupt entry for chunk (%d, %d), regenerating\n", chunk->x, chunk->z);
+    }
+    free(data);
+
+    pthread_mutex_lock(&cache->stats_mutex);
+    if (hit) {
+        cache->hits++;
+    } else {
+        cache->misses++;
+    }
+    pthread_mutex_unlock(&cache->stats_mutex);
+    return hit;
+}
+
+void terrain_cache_store(TerrainCache* cache, Chunk* chunk) {
+    if (!cache || !chunk) return;
+
+    uint32_t size;
+    uint8_t* data = chunk_codec_encode(chunk, &size);
+    if (!data) return;
+    region_storage_write_raw(cache->storage, chunk->x, chunk->z, data, size);
+}
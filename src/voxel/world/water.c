@@ -2,52 +2,82 @@
  * Water Flow System Implementation
  */
 
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
 #include "voxel/world/water.h"
 #include "voxel/world/world.h"
 #include "voxel/core/block.h"
+#include "voxel/core/profiler.h"
+#include "voxel/core/memory.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+
+#define WATER_BUDGET_CHECK_MASK 31  // Read the clock every 32 updates
 
 // ============================================================================
 // QUEUE MANAGEMENT
 // ============================================================================
 
+static void clear_edits(WaterUpdateQueue* queue) {
+    queue->edit_count = 0;
+    memset(queue->edit_buckets, 0xFF, sizeof(queue->edit_buckets));  // All -1
+}
+
 WaterUpdateQueue* water_queue_create(void) {
-    WaterUpdateQueue* queue = (WaterUpdateQueue*)malloc(sizeof(WaterUpdateQueue));
+    WaterUpdateQueue* queue = (WaterUpdateQueue*)calloc(1, sizeof(WaterUpdateQueue));
     if (!queue) return NULL;
 
-    queue->pending = NULL;
-    queue->free_list = NULL;
-    queue->count = 0;
-    queue->current_tick = 0;
+    queue->budget_us = WATER_BUDGET_US;
+    clear_edits(queue);
 
     printf("[WATER] Update queue created\n");
     return queue;
 }
 
-void water_queue_destroy(WaterUpdateQueue* queue) {
-    if (!queue) return;
-
-    // Free pending updates
-    WaterUpdate* node = queue->pending;
+static void free_update_list(WaterUpdate* node) {
     while (node) {
         WaterUpdate* next = node->next;
+        memory_track(MEMORY_WATER, -(ptrdiff_t)sizeof(WaterUpdate));
         free(node);
         node = next;
     }
+}
 
-    // Free reusable pool
-    node = queue->free_list;
-    while (node) {
-        WaterUpdate* next = node->next;
-        free(node);
-        node = next;
+void water_queue_destroy(WaterUpdateQueue* queue) {
+    if (!queue) return;
+
+    // Stop the simulation thread (it finishes its current tick first)
+    if (queue->threaded) {
+        pthread_mutex_lock(&queue->mutex);
+        queue->running = false;
+        pthread_cond_signal(&queue->wake);
+        pthread_mutex_unlock(&queue->mutex);
+        pthread_join(queue->thread, NULL);
+        pthread_mutex_destroy(&queue->mutex);
+        pthread_cond_destroy(&queue->wake);
+        pthread_cond_destroy(&queue->done);
+    }
+
+    // Free pending updates, then the reusable pool
+    for (int slot = 0; slot < WATER_WHEEL_SLOTS; slot++) {
+        free_update_list(queue->wheel[slot]);
     }
+    free_update_list(queue->ready_head);
+    free_update_list(queue->free_list);
 
+    memory_track(MEMORY_WATER, -(ptrdiff_t)((size_t)queue->edit_capacity * (sizeof(WorldEdit) + sizeof(int))));
+    free(queue->edits);
+    free(queue->edit_next);
     free(queue);
     printf("[WATER] Update queue destroyed\n");
 }
 
+void water_queue_set_budget(WaterUpdateQueue* queue, int budget_us) {
+    if (!queue) return;
+    queue->budget_us = budget_us > 0 ? budget_us : WATER_BUDGET_US;
+}
+
 /**
  * Get a node from free list or allocate new one
  */
@@ -58,6 +88,7 @@ static WaterUpdate* get_node(WaterUpdateQueue* queue) {
         queue->free_list = node->next;
     } else {
         node = (WaterUpdate*)malloc(sizeof(WaterUpdate));
+        if (node) memory_track(MEMORY_WATER, (ptrdiff_t)sizeof(WaterUpdate));
     }
     return node;
 }
@@ -70,21 +101,97 @@ static void release_node(WaterUpdateQueue* queue, WaterUpdate* node) {
     queue->free_list = node;
 }
 
-void water_schedule_update(WaterUpdateQueue* queue, int x, int y, int z, int delay) {
-    if (!queue) return;
+static uint32_t hash_position(int x, int y, int z) {
+    uint32_t h = (uint32_t)x * 73856093u ^ (uint32_t)y * 19349663u ^ (uint32_t)z * 83492791u;
+    return h ^ (h >> 13);
+}
+
+// ============================================================================
+// TIMING WHEEL AND POSITION SET
+// ============================================================================
 
-    // Check if this position is already scheduled
-    WaterUpdate* node = queue->pending;
+static WaterUpdate* find_update(WaterUpdateQueue* queue, int x, int y, int z) {
+    WaterUpdate* node = queue->positions[hash_position(x, y, z) & (WATER_SET_BUCKETS - 1)];
+    while (node && (node->x != x || node->y != y || node->z != z)) {
+        node = node->hash_next;
+    }
+    return node;
+}
+
+static void unlink_position(WaterUpdateQueue* queue, WaterUpdate* node) {
+    WaterUpdate** link = &queue->positions[hash_position(node->x, node->y, node->z) & (WATER_SET_BUCKETS - 1)];
+    while (*link && *link != node) {
+        link = &(*link)->hash_next;
+    }
+    if (*link) *link = node->hash_next;
+}
+
+static void ready_append(WaterUpdateQueue* queue, WaterUpdate* node) {
+    node->ready = true;
+    node->next = NULL;
+    node->prev = NULL;
+    if (queue->ready_tail) {
+        queue->ready_tail->next = node;
+    } else {
+        queue->ready_head = node;
+    }
+    queue->ready_tail = node;
+}
+
+/**
+ * Put a node on the wheel, or straight on the ready list if already due
+ */
+static void wheel_insert(WaterUpdateQueue* queue, WaterUpdate* node) {
+    if (node->scheduled_tick <= queue->current_tick) {
+        ready_append(queue, node);  // Its slot was drained this tick
+        return;
+    }
+    WaterUpdate** slot = &queue->wheel[node->scheduled_tick & (WATER_WHEEL_SLOTS - 1)];
+    node->ready = false;
+    node->prev = NULL;
+    node->next = *slot;
+    if (*slot) (*slot)->prev = node;
+    *slot = node;
+}
+
+static void wheel_remove(WaterUpdateQueue* queue, WaterUpdate* node) {
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        queue->wheel[node->scheduled_tick & (WATER_WHEEL_SLOTS - 1)] = node->next;
+    }
+    if (node->next) node->next->prev = node->prev;
+}
+
+/**
+ * Move the updates of the current tick's slot to the ready list
+ * Nodes a full wheel turn (or more) away stay in the slot
+ */
+static void wheel_advance(WaterUpdateQueue* queue) {
+    WaterUpdate* node = queue->wheel[queue->current_tick & (WATER_WHEEL_SLOTS - 1)];
     while (node) {
-        if (node->x == x && node->y == y && node->z == z) {
-            // Already scheduled, update to earlier time if needed
-            int target_tick = queue->current_tick + delay;
-            if (target_tick < node->scheduled_tick) {
-                node->scheduled_tick = target_tick;
-            }
-            return;
+        WaterUpdate* next = node->next;
+        if (node->scheduled_tick <= queue->current_tick) {
+            wheel_remove(queue, node);
+            ready_append(queue, node);
+        }
+        node = next;
+    }
+}
+
+void water_schedule_update(WaterUpdateQueue* queue, int x, int y, int z, int delay) {
+    if (!queue) return;
+    int target_tick = queue->current_tick + delay;
+
+    // Already scheduled: move it to the earlier time if needed
+    WaterUpdate* node = find_update(queue, x, y, z);
+    if (node) {
+        if (!node->ready && target_tick < node->scheduled_tick) {
+            wheel_remove(queue, node);
+            node->scheduled_tick = target_tick;
+            wheel_insert(queue, node);
         }
-        node = node->next;
+        return;
     }
 
     // Create new update
@@ -94,14 +201,98 @@ void water_schedule_update(WaterUpdateQueue* queue, int x, int y, int z, int del
     node->x = x;
     node->y = y;
     node->z = z;
-    node->scheduled_tick = queue->current_tick + delay;
+    node->scheduled_tick = target_tick;
 
-    // Insert at head (simple list)
-    node->next = queue->pending;
-    queue->pending = node;
+    uint32_t bucket = hash_position(x, y, z) & (WATER_SET_BUCKETS - 1);
+    node->hash_next = queue->positions[bucket];
+    queue->positions[bucket] = node;
+    wheel_insert(queue, node);
     queue->count++;
 }
 
+// ============================================================================
+// BUFFERED EDITS
+// ============================================================================
+
+static int find_edit(WaterUpdateQueue* queue, int x, int y, int z) {
+    int e = queue->edit_buckets[hash_position(x, y, z) & (WATER_EDIT_BUCKETS - 1)];
+    while (e >= 0) {
+        const WorldEdit* edit = &queue->edits[e];
+        if (edit->x == x && edit->y == y && edit->z == z) return e;
+        e = queue->edit_next[e];
+    }
+    return -1;
+}
+
+/**
+ * Block as this tick sees it: its own changes first, then the world
+ */
+static Block water_get_block(WaterUpdateQueue* queue, WorldCursor* cursor, int x, int y, int z) {
+    int e = find_edit(queue, x, y, z);
+    if (e >= 0) return queue->edits[e].block;
+    return world_cursor_get_block(cursor, x, y, z);
+}
+
+/**
+ * Schedule updates for the water around a changed block
+ */
+static void schedule_neighbors(WaterUpdateQueue* queue, WorldCursor* cursor, int x, int y, int z) {
+    int dx[] = {0, 0, 0, 1, -1, 0, 0};
+    int dy[] = {1, -1, 0, 0, 0, 0, 0};
+    int dz[] = {0, 0, 0, 0, 0, 1, -1};
+
+    for (int i = 0; i < 7; i++) {
+        int nx = x + dx[i];
+        int ny = y + dy[i];
+        int nz = z + dz[i];
+
+        Block neighbor = water_get_block(queue, cursor, nx, ny, nz);
+        if (neighbor.type == BLOCK_WATER) {
+            water_schedule_update(queue, nx, ny, nz, 1);  // Update next tick
+        }
+    }
+
+    // Also check if the changed block itself could receive water
+    Block block = water_get_block(queue, cursor, x, y, z);
+    if (block.type == BLOCK_AIR) {
+        // Check if there's water above that could fall
+        Block above = water_get_block(queue, cursor, x, y + 1, z);
+        if (above.type == BLOCK_WATER) {
+            water_schedule_update(queue, x, y + 1, z, 1);
+        }
+    }
+}
+
+/**
+ * Buffer a block change for water_sync and wake the water around it
+ */
+static void water_set_block(WaterUpdateQueue* queue, WorldCursor* cursor, int x, int y, int z, Block block) {
+    int e = find_edit(queue, x, y, z);
+    if (e < 0) {
+        if (queue->edit_count == queue->edit_capacity) {
+            int capacity = queue->edit_capacity > 0 ? queue->edit_capacity * 2 : 256;
+            WorldEdit* edits = (WorldEdit*)realloc(queue->edits, (size_t)capacity * sizeof(WorldEdit));
+            if (!edits) return;
+            queue->edits = edits;
+            int* next = (int*)realloc(queue->edit_next, (size_t)capacity * sizeof(int));
+            if (!next) return;
+            queue->edit_next = next;
+            memory_track(MEMORY_WATER, (ptrdiff_t)((size_t)(capacity - queue->edit_capacity) *
+                                                   (sizeof(WorldEdit) + sizeof(int))));
+            queue->edit_capacity = capacity;
+        }
+        e = queue->edit_count++;
+        uint32_t bucket = hash_position(x, y, z) & (WATER_EDIT_BUCKETS - 1);
+        queue->edits[e] = (WorldEdit){ x, y, z, block };
+        queue->edit_next[e] = queue->edit_buckets[bucket];
+        queue->edit_buckets[bucket] = e;
+    } else {
+        queue->edits[e].block = block;
+    }
+
+    schedule_neighbors(queue, cursor, x, y, z);
+}
+
 // ============================================================================
 // WATER FLOW LOGIC
 // ============================================================================
@@ -110,9 +301,9 @@ void water_schedule_update(WaterUpdateQueue* queue, int x, int y, int z, int del
  * Try to flow water to a position
  * Returns true if water was placed
  */
-static bool water_flow_to(WaterUpdateQueue* queue, World* world,
+static bool water_flow_to(WaterUpdateQueue* queue, WorldCursor* cursor,
                           int x, int y, int z, int source_level, bool falling) {
-    Block current = world_get_block(world, x, y, z);
+    Block current = water_get_block(queue, cursor, x, y, z);
 
     // Can only flow into air
     if (current.type != BLOCK_AIR) {
@@ -124,7 +315,7 @@ static bool water_flow_to(WaterUpdateQueue* queue, World* world,
             // Only replace if we would be stronger (lower level = stronger)
             if (new_level < current_level) {
                 Block water = {BLOCK_WATER, current.light_level, water_make_metadata(new_level, falling)};
-                world_set_block(world, x, y, z, water);
+                water_set_block(queue, cursor, x, y, z, water);
                 water_schedule_update(queue, x, y, z, WATER_FLOW_DELAY);
                 return true;
             }
@@ -140,7 +331,7 @@ static bool water_flow_to(WaterUpdateQueue* queue, World* world,
 
     // Place water block
     Block water = {BLOCK_WATER, 0, water_make_metadata(new_level, falling)};
-    world_set_block(world, x, y, z, water);
+    water_set_block(queue, cursor, x, y, z, water);
 
     // Schedule this new water block to flow
     water_schedule_update(queue, x, y, z, WATER_FLOW_DELAY);
@@ -151,8 +342,8 @@ static bool water_flow_to(WaterUpdateQueue* queue, World* world,
 /**
  * Process a single water block update
  */
-static void water_update_block(WaterUpdateQueue* queue, World* world, int x, int y, int z) {
-    Block block = world_get_block(world, x, y, z);
+static void water_update_block(WaterUpdateQueue* queue, WorldCursor* cursor, int x, int y, int z) {
+    Block block = water_get_block(queue, cursor, x, y, z);
 
     // Only process water blocks
     if (block.type != BLOCK_WATER) return;
@@ -166,7 +357,7 @@ static void water_update_block(WaterUpdateQueue* queue, World* world, int x, int
         bool has_source = false;
 
         // Check above
-        Block above = world_get_block(world, x, y + 1, z);
+        Block above = water_get_block(queue, cursor, x, y + 1, z);
         if (above.type == BLOCK_WATER) {
             has_source = true;
         }
@@ -176,7 +367,7 @@ static void water_update_block(WaterUpdateQueue* queue, World* world, int x, int
             int dx[] = {1, -1, 0, 0};
             int dz[] = {0, 0, 1, -1};
             for (int i = 0; i < 4; i++) {
-                Block neighbor = world_get_block(world, x + dx[i], y, z + dz[i]);
+                Block neighbor = water_get_block(queue, cursor, x + dx[i], y, z + dz[i]);
                 if (neighbor.type == BLOCK_WATER) {
                     int neighbor_level = water_get_level(neighbor.metadata);
                     if (neighbor_level < level - 1) {
@@ -187,22 +378,18 @@ static void water_update_block(WaterUpdateQueue* queue, World* world, int x, int
             }
         }
 
-        // If no source found, decay the water
+        // If no source found, decay the water (neighbors are scheduled with the change)
         if (!has_source) {
-            // Remove the water
             Block air = {BLOCK_AIR, 0, 0};
-            world_set_block(world, x, y, z, air);
-
-            // Schedule neighbor updates
-            water_on_block_change(queue, world, x, y, z);
+            water_set_block(queue, cursor, x, y, z, air);
             return;
         }
     }
 
     // Try to flow down first (priority)
-    Block below = world_get_block(world, x, y - 1, z);
+    Block below = water_get_block(queue, cursor, x, y - 1, z);
     if (below.type == BLOCK_AIR) {
-        water_flow_to(queue, world, x, y - 1, z, level, true);  // Falling water
+        water_flow_to(queue, cursor, x, y - 1, z, level, true);  // Falling water
         return;  // Water fell, don't spread horizontally yet
     }
 
@@ -210,7 +397,7 @@ static void water_update_block(WaterUpdateQueue* queue, World* world, int x, int
     if (below.type == BLOCK_WATER && !falling) {
         // Update to falling
         block.metadata = water_make_metadata(level, true);
-        world_set_block(world, x, y, z, block);
+        water_set_block(queue, cursor, x, y, z, block);
     }
 
     // Spread horizontally (only if not source or if on solid ground)
@@ -225,71 +412,142 @@ static void water_update_block(WaterUpdateQueue* queue, World* world, int x, int
                 int nz = z + dz[i];
 
                 // Flow horizontally
-                water_flow_to(queue, world, nx, y, nz, level, false);
+                water_flow_to(queue, cursor, nx, y, nz, level, false);
             }
         }
     }
 }
 
-void water_process_tick(WaterUpdateQueue* queue, World* world) {
-    if (!queue || !world) return;
+// ============================================================================
+// TICK PROCESSING
+// ============================================================================
 
-    queue->current_tick++;
+static int64_t water_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
 
-    // Process all updates scheduled for this tick
-    WaterUpdate** prev = &queue->pending;
-    WaterUpdate* node = queue->pending;
+/**
+ * Run due updates until the budget is spent, buffering their block changes
+ * Reads the world only; safe on the simulation thread
+ */
+static void water_simulate_tick(WaterUpdateQueue* queue, World* world) {
+    PROFILE_BEGIN(PROFILE_WATER_TICK);
+    queue->current_tick++;
+    wheel_advance(queue);
 
+    WorldCursor cursor;
+    world_cursor_init(&cursor, world);
+    int64_t deadline = water_now_us() + queue->budget_us;
     int processed = 0;
-    const int MAX_UPDATES_PER_TICK = 100;  // Limit for performance
 
-    while (node && processed < MAX_UPDATES_PER_TICK) {
-        if (node->scheduled_tick <= queue->current_tick) {
-            // Remove from list
-            *prev = node->next;
+    while (queue->ready_head) {
+        // Leftovers stay ready and run first next tick
+        if ((processed & WATER_BUDGET_CHECK_MASK) == WATER_BUDGET_CHECK_MASK && water_now_us() >= deadline) break;
 
-            // Process the update
-            water_update_block(queue, world, node->x, node->y, node->z);
+        WaterUpdate* node = queue->ready_head;
+        queue->ready_head = node->next;
+        if (!queue->ready_head) queue->ready_tail = NULL;
 
-            // Release node
-            release_node(queue, node);
-            queue->count--;
-            processed++;
+        // Leave the set first, so the update can schedule its own position again
+        unlink_position(queue, node);
+        int x = node->x, y = node->y, z = node->z;
+        release_node(queue, node);
+        queue->count--;
 
-            node = *prev;
-        } else {
-            prev = &node->next;
-            node = node->next;
-        }
+        water_update_block(queue, &cursor, x, y, z);
+        processed++;
     }
+    PROFILE_END(PROFILE_WATER_TICK);
 }
 
-void water_on_block_change(WaterUpdateQueue* queue, World* world, int x, int y, int z) {
-    if (!queue || !world) return;
+static void* water_thread_main(void* arg) {
+    WaterUpdateQueue* queue = (WaterUpdateQueue*)arg;
+    profiler_set_thread_name("water");
 
-    // Schedule updates for all neighboring water blocks
-    int dx[] = {0, 0, 0, 1, -1, 0, 0};
-    int dy[] = {1, -1, 0, 0, 0, 0, 0};
-    int dz[] = {0, 0, 0, 0, 0, 1, -1};
+    pthread_mutex_lock(&queue->mutex);
+    while (queue->running) {
+        if (!queue->busy) {
+            pthread_cond_wait(&queue->wake, &queue->mutex);
+            continue;
+        }
+        pthread_mutex_unlock(&queue->mutex);
 
-    for (int i = 0; i < 7; i++) {
-        int nx = x + dx[i];
-        int ny = y + dy[i];
-        int nz = z + dz[i];
+        water_simulate_tick(queue, queue->world);
 
-        Block neighbor = world_get_block(world, nx, ny, nz);
-        if (neighbor.type == BLOCK_WATER) {
-            water_schedule_update(queue, nx, ny, nz, 1);  // Update next tick
-        }
+        pthread_mutex_lock(&queue->mutex);
+        queue->busy = false;
+        pthread_cond_signal(&queue->done);
     }
+    pthread_mutex_unlock(&queue->mutex);
+    return NULL;
+}
 
-    // Also check if the changed block itself could receive water
-    Block block = world_get_block(world, x, y, z);
-    if (block.type == BLOCK_AIR) {
-        // Check if there's water above that could fall
-        Block above = world_get_block(world, x, y + 1, z);
-        if (above.type == BLOCK_WATER) {
-            water_schedule_update(queue, x, y + 1, z, 1);
+bool water_queue_start_thread(WaterUpdateQueue* queue, World* world) {
+    if (!queue || queue->threaded) return queue != NULL;
+
+    pthread_mutex_init(&queue->mutex, NULL);
+    pthread_cond_init(&queue->wake, NULL);
+    pthread_cond_init(&queue->done, NULL);
+    queue->world = world;
+    queue->running = true;
+    queue->busy = false;
+
+    if (pthread_create(&queue->thread, NULL, water_thread_main, queue) != 0) {
+        printf("[WATER] Failed to start simulation thread, simulating on the main thread\n");
+        queue->running = false;
+        pthread_mutex_destroy(&queue->mutex);
+        pthread_cond_destroy(&queue->wake);
+        pthread_cond_destroy(&queue->done);
+        return false;
+    }
+    queue->threaded = true;
+    printf("[WATER] Simulation thread started\n");
+    return true;
+}
+
+void water_sync(WaterUpdateQueue* queue, World* world) {
+    if (!queue || !world) return;
+
+    if (queue->threaded) {
+        pthread_mutex_lock(&queue->mutex);
+        while (queue->busy) {
+            pthread_cond_wait(&queue->done, &queue->mutex);
         }
+        pthread_mutex_unlock(&queue->mutex);
+    }
+
+    // One batch per tick: each touched chunk is looked up and dirtied once
+    if (queue->edit_count > 0) {
+        world_set_blocks(world, queue->edits, queue->edit_count);
+        clear_edits(queue);
     }
 }
+
+void water_process_tick(WaterUpdateQueue* queue, World* world) {
+    if (!queue || !world) return;
+
+    // The previous tick's changes land before the next one reads the world
+    water_sync(queue, world);
+
+    if (queue->threaded) {
+        pthread_mutex_lock(&queue->mutex);
+        queue->world = world;
+        queue->busy = true;
+        pthread_cond_signal(&queue->wake);
+        pthread_mutex_unlock(&queue->mutex);
+        return;
+    }
+
+    water_simulate_tick(queue, world);
+    water_sync(queue, world);
+}
+
+void water_on_block_change(WaterUpdateQueue* queue, World* world, int x, int y, int z) {
+    if (!queue || !world) return;
+
+    WorldCursor cursor;
+    world_cursor_init(&cursor, world);
+    schedule_neighbors(queue, &cursor, x, y, z);
+}
@@ -2,56 +2,42 @@
  * World System Implementation
  */
 
+#define _POSIX_C_SOURCE 200112L
+
 #include "voxel/world/world.h"
+#include "voxel/core/profiler.h"
+#include "voxel/core/memory.h"
 #include "voxel/world/chunk_worker.h"
 #include "voxel/world/spawn.h"
 #include "voxel/world/water.h"
-#include "voxel/world/chest.h"
+#include "voxel/world/region.h"
+#include "voxel/world/column_cache.h"
+#include "voxel/world/structure.h"
+#include "voxel/world/terrain_cache.h"
+#include "voxel/world/mesh_cache.h"
+#include "voxel/world/chunk_codec.h"
 #include "voxel/core/texture_atlas.h"
 #include "voxel/world/terrain.h"
 #include "voxel/render/light.h"
 #include "voxel/render/chunk_batcher.h"
+#include "voxel/render/chunk_pool.h"
+#include "voxel/render/chunk_culler.h"
+#include "voxel/render/chunk_lod.h"
+#include "voxel/render/chunk_water.h"
+#include "voxel/render/frame_uniforms.h"
+#include "voxel/render/upload_budget.h"
 #include "voxel/entity/entity.h"
+#include "voxel/entity/tree.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <raylib.h>
 #include <raymath.h>
 #include <rlgl.h>
 
-// ============================================================================
-// CACHED SHADER UNIFORM LOCATIONS
-// ============================================================================
-
-static struct {
-    int ambient;
-    int camera_pos;
-    int fog_start;
-    int fog_end;
-    int fog_color;
-    int underwater;
-    int time;
-    bool initialized;
-} g_shader_locs = {0};
-
-/**
- * Initialize shader uniform location cache (call once after shader is loaded)
- */
-static void init_shader_loc_cache(Shader shader) {
-    if (g_shader_locs.initialized) return;
-
-    g_shader_locs.ambient = GetShaderLocation(shader, "u_ambient_light");
-    g_shader_locs.camera_pos = GetShaderLocation(shader, "u_camera_pos");
-    g_shader_locs.fog_start = GetShaderLocation(shader, "u_fog_start");
-    g_shader_locs.fog_end = GetShaderLocation(shader, "u_fog_end");
-    g_shader_locs.fog_color = GetShaderLocation(shader, "u_fog_color");
-    g_shader_locs.underwater = GetShaderLocation(shader, "u_underwater");
-    g_shader_locs.time = GetShaderLocation(shader, "u_time");
-    g_shader_locs.initialized = true;
-}
-
-// Note: Frustum culling functions were moved to chunk_batcher.c
-// The batcher now handles batch-level culling
+// Note: Frustum and cave culling live in chunk_culler.c
+// world_render_opaque refreshes world->culler for both passes
 
 // ============================================================================
 // DIRTY CHUNK LIST HELPERS
@@ -89,317 +75,1764 @@ static void world_remove_from_dirty_list(World* world, Chunk* chunk) {
     }
 }
 
-// ============================================================================
-// HASH MAP HELPERS
-// ============================================================================
-
+// ============================================================================
+// SPAWN LIST HELPERS
+// ============================================================================
+
+/**
+ * Add a chunk to the spawn list: world_update places its planned animals
+ * a few per frame
+ */
+static void world_add_to_spawn_list(World* world, Chunk* chunk) {
+    if (chunk->in_spawn_list) return;
+
+    chunk->spawn_next = world->spawn_head;
+    world->spawn_head = chunk;
+    chunk->in_spawn_list = true;
+}
+
+/**
+ * Remove a chunk from the spawn list (all placed, or unload)
+ */
+static void world_remove_from_spawn_list(World* world, Chunk* chunk) {
+    if (!chunk->in_spawn_list) return;
+
+    Chunk** pp = &world->spawn_head;
+    while (*pp) {
+        if (*pp == chunk) {
+            *pp = chunk->spawn_next;
+            chunk->spawn_next = NULL;
+            chunk->in_spawn_list = false;
+            return;
+        }
+        pp = &(*pp)->spawn_next;
+    }
+}
+
+// ============================================================================
+// WATER LIST HELPERS
+// ============================================================================
+
+/**
+ * Add a meshed chunk to the water list: world_update rebuilds its water
+ * mesh a few chunks per frame. Headless worlds draw no water
+ */
+static void world_add_to_water_list(World* world, Chunk* chunk) {
+    if (!chunk || chunk->in_water_list || world->headless) return;
+    if (chunk_get_state(chunk) != CHUNK_STATE_COMPLETE) return;  // Listed when its mesh is uploaded
+
+    chunk->water_next = world->water_head;
+    world->water_head = chunk;
+    chunk->in_water_list = true;
+}
+
+/**
+ * Remove a chunk from the water list (built, mesh released, or unload)
+ */
+static void world_remove_from_water_list(World* world, Chunk* chunk) {
+    if (!chunk->in_water_list) return;
+
+    Chunk** pp = &world->water_head;
+    while (*pp) {
+        if (*pp == chunk) {
+            *pp = chunk->water_next;
+            chunk->water_next = NULL;
+            chunk->in_water_list = false;
+            return;
+        }
+        pp = &(*pp)->water_next;
+    }
+}
+
+// ============================================================================
+// STREAM LIST HELPERS
+// ============================================================================
+
+/**
+ * Add a chunk to the stream list: world_update visits it every frame until
+ * its streaming work is done (generated, meshed or handed to its LOD region)
+ */
+static void world_add_to_stream_list(World* world, Chunk* chunk) {
+    if (!chunk || chunk->in_stream_list) return;
+
+    chunk->stream_next = world->stream_head;
+    world->stream_head = chunk;
+    chunk->in_stream_list = true;
+    world->stream_count++;
+}
+
+/**
+ * Remove a chunk from the stream list (unload)
+ */
+static void world_remove_from_stream_list(World* world, Chunk* chunk) {
+    if (!chunk->in_stream_list) return;
+
+    Chunk** pp = &world->stream_head;
+    while (*pp) {
+        if (*pp == chunk) {
+            *pp = chunk->stream_next;
+            chunk->stream_next = NULL;
+            chunk->in_stream_list = false;
+            world->stream_count--;
+            return;
+        }
+        pp = &(*pp)->stream_next;
+    }
+}
+
+/**
+ * List the chunks of the square of radius around (center_x, center_z) that
+ * the old square did not cover (every chunk when has_old is false), creating
+ * them. Covered spans are skipped, so a window that moved one chunk costs
+ * one ring, not the whole square
+ */
+static void world_stream_window(World* world, int center_x, int center_z, int radius,
+                                bool has_old, int old_x, int old_z, int old_radius) {
+    for (int z = center_z - radius; z <= center_z + radius; z++) {
+        bool row_covered = has_old && abs(z - old_z) <= old_radius;
+        for (int x = center_x - radius; x <= center_x + radius; x++) {
+            if (row_covered && abs(x - old_x) <= old_radius) {
+                x = old_x + old_radius;  // Jump past the covered span
+                continue;
+            }
+            world_add_to_stream_list(world, world_get_or_create_chunk(world, x, z));
+        }
+    }
+}
+
+// ============================================================================
+// CHUNK INDEX HELPERS
+// ============================================================================
+
+static inline int chunk_index_slot(int chunk_x, int chunk_z) {
+    return (chunk_z & WORLD_INDEX_MASK) * WORLD_INDEX_SIZE + (chunk_x & WORLD_INDEX_MASK);
+}
+
+/**
+ * Create an empty chunk index
+ */
+static ChunkIndex* chunk_index_create(void) {
+    ChunkIndex* index = (ChunkIndex*)calloc(1, sizeof(ChunkIndex));
+    if (!index) printf("[WORLD] Failed to allocate chunk index\n");
+    return index;
+}
+
+/**
+ * Slots plus overflow entries, for iteration with chunk_index_at
+ */
+static int chunk_index_span(const ChunkIndex* index) {
+    return WORLD_INDEX_SIZE * WORLD_INDEX_SIZE + index->overflow_count;
+}
+
+/**
+ * Chunk at iteration position i (NULL for empty slots)
+ */
+static Chunk* chunk_index_at(const ChunkIndex* index, int i) {
+    if (i < WORLD_INDEX_SIZE * WORLD_INDEX_SIZE) return index->slots[i];
+    return index->overflow[i - WORLD_INDEX_SIZE * WORLD_INDEX_SIZE];
+}
+
+/**
+ * Destroy chunk index and every chunk in it
+ */
+static void chunk_index_destroy(ChunkIndex* index) {
+    if (!index) return;
+
+    for (int i = 0; i < chunk_index_span(index); i++) {
+        Chunk* chunk = chunk_index_at(index, i);
+        if (chunk) chunk_destroy(chunk);
+    }
+    free(index->overflow);
+    free(index);
+}
+
+/**
+ * Insert chunk into the index
+ * The newest chunk takes the slot; a chunk one index width away moves to overflow
+ */
+static bool chunk_index_insert(ChunkIndex* index, Chunk* chunk) {
+    int slot = chunk_index_slot(chunk->x, chunk->z);
+    Chunk* occupant = index->slots[slot];
+
+    if (occupant) {
+        if (index->overflow_count >= index->overflow_capacity) {
+            int capacity = index->overflow_capacity > 0 ? index->overflow_capacity * 2 : 16;
+            Chunk** overflow = (Chunk**)realloc(index->overflow, (size_t)capacity * sizeof(Chunk*));
+            if (!overflow) return false;
+            index->overflow = overflow;
+            index->overflow_capacity = capacity;
+        }
+        index->overflow[index->overflow_count++] = occupant;
+    }
+    index->slots[slot] = chunk;
+    index->chunk_count++;
+    return true;
+}
+
+/**
+ * Get chunk from the index
+ */
+static inline Chunk* chunk_index_get(const ChunkIndex* index, int chunk_x, int chunk_z) {
+    Chunk* chunk = index->slots[chunk_index_slot(chunk_x, chunk_z)];
+    if (chunk && chunk->x == chunk_x && chunk->z == chunk_z) return chunk;
+
+    for (int i = 0; i < index->overflow_count; i++) {
+        chunk = index->overflow[i];
+        if (chunk->x == chunk_x && chunk->z == chunk_z) return chunk;
+    }
+    return NULL;
+}
+
+/**
+ * Remove chunk from the index (does not destroy it)
+ * Returns the removed chunk, or NULL if not present
+ */
+static Chunk* chunk_index_remove(ChunkIndex* index, int chunk_x, int chunk_z) {
+    int slot = chunk_index_slot(chunk_x, chunk_z);
+    Chunk* chunk = index->slots[slot];
+
+    if (chunk && chunk->x == chunk_x && chunk->z == chunk_z) {
+        index->slots[slot] = NULL;
+
+        // Promote an overflowed chunk that maps to the freed slot
+        for (int i = 0; i < index->overflow_count; i++) {
+            Chunk* waiting = index->overflow[i];
+            if (chunk_index_slot(waiting->x, waiting->z) == slot) {
+                index->slots[slot] = waiting;
+                index->overflow[i] = index->overflow[--index->overflow_count];
+                break;
+            }
+        }
+        index->chunk_count--;
+        return chunk;
+    }
+
+    for (int i = 0; i < index->overflow_count; i++) {
+        chunk = index->overflow[i];
+        if (chunk->x == chunk_x && chunk->z == chunk_z) {
+            index->overflow[i] = index->overflow[--index->overflow_count];
+            index->chunk_count--;
+            return chunk;
+        }
+    }
+    return NULL;
+}
+
+// ============================================================================
+// CHUNK RECLAMATION
+// ============================================================================
+
+/**
+ * Write back and free a chunk that left the world once no worker holds it
+ * (main thread, its GPU buffers go with it)
+ */
+static void world_free_chunk(World* world, Chunk* chunk) {
+    // Only fully generated chunks are written - partial data would shadow terrain
+    bool generated = CHUNK_STATE_HAS_BLOCKS(chunk_get_state(chunk));
+    if (world->storage && chunk->needs_save && generated) {
+        region_storage_save_chunk(world->storage, chunk);
+    }
+    // Unsealed only now: a stage that was still running may have claimed fragments
+    structure_store_release(world->structures, chunk->x, chunk->z);
+    chunk_destroy(chunk);
+}
+
+/**
+ * Free the retired chunks whose last worker reference is gone
+ */
+static void world_reap_retired(World* world) {
+    Chunk** link = &world->retired_head;
+    while (*link) {
+        Chunk* chunk = *link;
+        if (chunk_in_use(chunk)) {
+            link = &chunk->retired_next;
+            continue;
+        }
+        *link = chunk->retired_next;
+        world->retired_count--;
+        world_free_chunk(world, chunk);
+    }
+}
+
+/**
+ * A retired chunk still owns its position: a new chunk there is not
+ * generated until it is freed, so both never claim the same fragments
+ */
+static bool world_chunk_retiring(const World* world, int chunk_x, int chunk_z) {
+    for (const Chunk* chunk = world->retired_head; chunk; chunk = chunk->retired_next) {
+        if (chunk->x == chunk_x && chunk->z == chunk_z) return true;
+    }
+    return false;
+}
+
+// ============================================================================
+// COORDINATE CONVERSION
+// ============================================================================
+
+void world_to_chunk_coords(int world_x, int world_z, int* chunk_x, int* chunk_z) {
+    *chunk_x = world_x >= 0 ? world_x / CHUNK_SIZE : (world_x - CHUNK_SIZE + 1) / CHUNK_SIZE;
+    *chunk_z = world_z >= 0 ? world_z / CHUNK_SIZE : (world_z - CHUNK_SIZE + 1) / CHUNK_SIZE;
+}
+
+void world_to_local_coords(int world_x, int world_y, int world_z,
+                           int* chunk_x, int* chunk_z,
+                           int* local_x, int* local_y, int* local_z) {
+    world_to_chunk_coords(world_x, world_z, chunk_x, chunk_z);
+
+    *local_x = world_x - (*chunk_x * CHUNK_SIZE);
+    *local_y = world_y;
+    *local_z = world_z - (*chunk_z * CHUNK_SIZE);
+
+    // Handle negative coordinates
+    if (*local_x < 0) *local_x += CHUNK_SIZE;
+    if (*local_z < 0) *local_z += CHUNK_SIZE;
+}
+
+// ============================================================================
+// WORLD MANAGEMENT
+// ============================================================================
+
+static World* world_create_internal(TerrainParams terrain_params, bool headless) {
+    World* world = (World*)malloc(sizeof(World));
+    world->chunks = chunk_index_create();
+    world->worker = chunk_worker_create();
+    world->headless = headless;
+    world->pool = headless ? NULL : chunk_pool_create();
+    world->batcher = headless || world->pool ? NULL : chunk_batcher_create();
+    world->culler = headless ? NULL : chunk_culler_create();
+    world->lod = headless ? NULL : chunk_lod_create(LOD_DISTANCE_THRESHOLD);
+    world->storage = NULL;
+    world->terrain_cache = NULL;
+    world->mesh_cache = NULL;
+    world->center_chunk_x = 0;
+    world->center_chunk_z = 0;
+    world->view_distance = WORLD_VIEW_DISTANCE;
+    world->terrain_params = terrain_params;
+    world->columns = column_cache_create(terrain_params);
+    chunk_worker_set_columns(world->worker, world->columns);
+    world->structures = structure_store_create();
+    chunk_worker_set_structures(world->worker, world->structures);
+    world->player = NULL;  // Set by game after player creation
+    world->entity_manager = NULL;  // Set by game after entity manager creation
+    world->time_of_day = 12.0f;  // Default to noon
+    world->water_queue = water_queue_create();
+    if (world->water_queue) {
+        water_queue_start_thread(world->water_queue, world);
+    }
+    world->game_tick = 0;
+    world->dirty_head = NULL;
+    world->dirty_count = 0;
+    world->batch_rebuilds_per_frame = 16;  // Default from BATCH_REBUILDS_PER_FRAME
+    world->max_uploads_per_frame = MAX_UPLOADS_PER_FRAME;
+    world->upload_budget = headless ? NULL : upload_budget_create();
+    world->memory_budget_bytes = (size_t)WORLD_MEMORY_BUDGET_MB * 1024 * 1024;
+    world->resident_bytes = 0;
+    world->last_evict_tick = 0;
+    world->retired_head = NULL;
+    world->retired_count = 0;
+    world->cold_distance = WORLD_COLD_DISTANCE;
+    world->cold_cursor = 0;
+    memset(world->tickets, 0, sizeof(world->tickets));
+    world->tickets_moved = false;
+    world->stream_head = NULL;
+    world->stream_count = 0;
+    world->stream_valid = false;
+    world->stream_center_x = 0;
+    world->stream_center_z = 0;
+    world->stream_view_distance = 0;
+    world->stream_lod_distance = 0;
+    world->spawn_head = NULL;
+    world->water_head = NULL;
+    world->velocity_x = 0.0f;
+    world->velocity_z = 0.0f;
+    world->prefetch_active = false;
+    world->prefetch_x = 0;
+    world->prefetch_z = 0;
+    memset(&world->frame_stats, 0, sizeof(WorldFrameStats));
+    world->chunk_request = NULL;
+    world->chunk_request_user = NULL;
+    memset(world->camera_block, 0, sizeof(world->camera_block));
+    memset(world->sorted_block, 0, sizeof(world->sorted_block));
+
+    // Initialize spawn system
+    spawn_system_init();
+
+    printf("[WORLD] Created %sworld with view distance %d\n", headless ? "headless " : "", world->view_distance);
+    return world;
+}
+
+World* world_create(TerrainParams terrain_params) {
+    return world_create_internal(terrain_params, false);
+}
+
+World* world_create_headless(TerrainParams terrain_params) {
+    return world_create_internal(terrain_params, true);
+}
+
+void world_destroy(World* world) {
+    if (!world) return;
+
+    // Stop worker threads first (the water thread reads chunks too)
+    if (world->water_queue) {
+        water_queue_destroy(world->water_queue);
+        world->water_queue = NULL;
+    }
+    if (world->worker) {
+        chunk_worker_destroy(world->worker);
+    }
+    world_reap_retired(world);  // No references are left with the workers gone
+
+    // Write back unsaved chunks, then flush the I/O thread
+    if (world->storage) {
+        world_save_all(world);
+        region_storage_destroy(world->storage);
+    }
+    terrain_cache_destroy(world->terrain_cache);
+    mesh_cache_destroy(world->mesh_cache);
+
+    // Destroy batcher and pool before chunks (have references to chunks)
+    if (world->batcher) {
+        chunk_batcher_destroy(world->batcher);
+    }
+    if (world->pool) {
+        chunk_pool_destroy(world->pool);
+    }
+    chunk_culler_destroy(world->culler);
+    chunk_lod_destroy(world->lod);
+    upload_budget_destroy(world->upload_budget);
+    column_cache_destroy(world->columns);  // Workers are stopped
+    structure_store_destroy(world->structures);
+
+    chunk_index_destroy(world->chunks);
+    chunk_mesh_release_shared();  // After every chunk and batch mesh is gone
+    free(world);
+
+    printf("[WORLD] Destroyed world\n");
+}
+
+Chunk* world_get_chunk(World* world, int chunk_x, int chunk_z) {
+    if (!world) return NULL;
+    return chunk_index_get(world->chunks, chunk_x, chunk_z);
+}
+
+Chunk* world_get_or_create_chunk(World* world, int chunk_x, int chunk_z) {
+    if (!world) return NULL;
+
+    Chunk* chunk = world_get_chunk(world, chunk_x, chunk_z);
+    if (chunk) return chunk;
+
+    // Create new chunk
+    chunk = chunk_create(chunk_x, chunk_z);
+    if (chunk && !chunk_index_insert(world->chunks, chunk)) {
+        chunk_destroy(chunk);
+        return NULL;
+    }
+
+    return chunk;
+}
+
+/**
+ * Upload a finished worker remesh and refresh the chunk's batch
+ * Edits made after the snapshot keep needs_remesh set for the next pass
+ */
+static void world_finish_remesh(World* world, CompletedChunk* completed) {
+    Chunk* chunk = completed->chunk;
+    bool edited_since = chunk->needs_remesh;
+    bool uploaded = completed->mesh.valid;
+    uint16_t sections = completed->mesh.section_mask;
+
+    chunk->remesh_pending = false;
+    if (!uploaded) {
+        chunk_mark_sections_dirty(chunk, sections ? sections : CHUNK_SECTIONS_ALL);
+    }
+    chunk_worker_upload_mesh(chunk, &completed->mesh);
+    staged_mesh_free(&completed->mesh);
+    chunk->needs_remesh = edited_since || chunk->dirty_sections != 0;
+
+    if (chunk->needs_remesh) {
+        world_add_to_dirty_list(world, chunk);
+    }
+    if (uploaded && world->batcher) {
+        // Section edits patch the batch in place; whole-chunk remeshes rebuild it
+        if (sections == 0 || !chunk_batcher_splice_chunk(world->batcher, chunk)) {
+            chunk_batcher_invalidate(world->batcher, chunk->x, chunk->z);
+        }
+    }
+    if (uploaded && world->pool) {
+        if (sections == 0 || !chunk_pool_splice_chunk(world->pool, chunk)) {
+            chunk_pool_write_chunk(world->pool, chunk);
+        }
+    }
+}
+
+/**
+ * Section storage may be reallocated while a worker fills the chunk,
+ * so the main thread must not touch blocks of queued/generating chunks
+ */
+static bool world_chunk_in_worker(Chunk* chunk) {
+    ChunkState state = chunk_get_state(chunk);
+    return state == CHUNK_STATE_QUEUED || state == CHUNK_STATE_GENERATING;
+}
+
+/**
+ * Blocks may be read from any thread: the acquire load of a state with
+ * final blocks orders the reads after the worker's writes, and only the
+ * main thread (with the readers synced) takes a chunk back from there
+ */
+static bool world_chunk_readable(Chunk* chunk) {
+    return chunk && CHUNK_STATE_HAS_BLOCKS(chunk_get_state(chunk));
+}
+
+ChunkBorder* world_capture_border(World* world, Chunk* chunk) {
+    if (!world || !chunk) return NULL;
+
+    ChunkBorder* border = chunk_border_alloc();
+    if (!border) return NULL;
+
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if (dx == 0 && dz == 0) continue;
+            Chunk* neighbor = world_get_chunk(world, chunk->x + dx, chunk->z + dz);
+            if (neighbor && !CHUNK_STATE_HAS_BLOCKS(chunk_get_state(neighbor))) neighbor = NULL;
+            chunk_border_capture(border, neighbor, dx, dz);
+        }
+    }
+    return border;
+}
+
+void world_build_chunk_mesh(World* world, Chunk* chunk) {
+    if (!world || !chunk) return;
+
+    chunk->border = world_capture_border(world, chunk);
+    chunk_generate_mesh(chunk);
+    chunk_border_free(chunk->border);
+    chunk->border = NULL;
+}
+
+/**
+ * All 8 neighbors have final blocks, so the chunk's border faces can be meshed
+ */
+static bool world_neighbors_generated(World* world, int chunk_x, int chunk_z) {
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if (dx == 0 && dz == 0) continue;
+            Chunk* neighbor = world_get_chunk(world, chunk_x + dx, chunk_z + dz);
+            if (!neighbor || !CHUNK_STATE_HAS_BLOCKS(chunk_get_state(neighbor))) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * A block on a chunk edge is part of its neighbors' meshes: dirty them too
+ */
+static void world_mark_neighbors_dirty(World* world, int chunk_x, int chunk_z,
+                                       int local_x, int local_y, int local_z) {
+    int dx = local_x == 0 ? -1 : (local_x == CHUNK_SIZE - 1 ? 1 : 0);
+    int dz = local_z == 0 ? -1 : (local_z == CHUNK_SIZE - 1 ? 1 : 0);
+    if (dx == 0 && dz == 0) return;
+
+    uint16_t mask = chunk_section_mask_for_y(local_y);
+    for (int oz = -1; oz <= 1; oz++) {
+        for (int ox = -1; ox <= 1; ox++) {
+            // The edge neighbors, plus the diagonal one at corners (AO)
+            if (ox == 0 && oz == 0) continue;
+            if ((ox != 0 && ox != dx) || (oz != 0 && oz != dz)) continue;
+
+            Chunk* neighbor = world_get_chunk(world, chunk_x + ox, chunk_z + oz);
+            if (!neighbor || chunk_get_state(neighbor) != CHUNK_STATE_COMPLETE) continue;  // Not meshed yet
+            chunk_mark_sections_dirty(neighbor, mask);
+            world_add_to_dirty_list(world, neighbor);
+        }
+    }
+}
+
+void world_mark_block_dirty(World* world, int x, int y, int z) {
+    int chunk_x, chunk_z;
+    int local_x, local_y, local_z;
+    world_to_local_coords(x, y, z, &chunk_x, &chunk_z, &local_x, &local_y, &local_z);
+
+    Chunk* chunk = world_get_chunk(world, chunk_x, chunk_z);
+    if (!chunk) return;
+    if (chunk->water && !chunk->in_water_list &&
+        !chunk_water_refresh_block(world, chunk, local_x, local_y, local_z)) {
+        world_add_to_water_list(world, chunk);  // Light of a water block changed
+    }
+    chunk_mark_sections_dirty(chunk, chunk_section_mask_for_y(local_y));
+    if (chunk_get_state(chunk) == CHUNK_STATE_COMPLETE) {
+        world_add_to_dirty_list(world, chunk);  // Not meshed yet: the first mesh includes it
+    }
+    world_mark_neighbors_dirty(world, chunk_x, chunk_z, local_x, local_y, local_z);
+}
+
+Block world_get_block(World* world, int x, int y, int z) {
+    int chunk_x, chunk_z;
+    int local_x, local_y, local_z;
+    world_to_local_coords(x, y, z, &chunk_x, &chunk_z, &local_x, &local_y, &local_z);
+
+    Chunk* chunk = world_get_chunk(world, chunk_x, chunk_z);
+    if (!world_chunk_readable(chunk)) {
+        return (Block){BLOCK_AIR, 0, 0};
+    }
+
+    return chunk_get_block(chunk, local_x, local_y, local_z);
+}
+
+void world_cursor_init(WorldCursor* cursor, World* world) {
+    cursor->world = world;
+    cursor->chunk = NULL;
+    cursor->chunk_x = 0;
+    cursor->chunk_z = 0;
+    cursor->has_chunk = false;
+}
+
+Chunk* world_cursor_get_chunk(WorldCursor* cursor, int x, int z) {
+    int chunk_x, chunk_z;
+    world_to_chunk_coords(x, z, &chunk_x, &chunk_z);
+
+    if (!cursor->has_chunk || chunk_x != cursor->chunk_x || chunk_z != cursor->chunk_z) {
+        cursor->chunk = world_get_chunk(cursor->world, chunk_x, chunk_z);
+        cursor->chunk_x = chunk_x;
+        cursor->chunk_z = chunk_z;
+        cursor->has_chunk = true;
+    }
+
+    // State is checked per query: a worker may finish the chunk between them
+    Chunk* chunk = cursor->chunk;
+    if (!world_chunk_readable(chunk)) return NULL;
+    return chunk;
+}
+
+Block world_cursor_get_block(WorldCursor* cursor, int x, int y, int z) {
+    Chunk* chunk = world_cursor_get_chunk(cursor, x, z);
+    if (!chunk) {
+        return (Block){BLOCK_AIR, 0, 0};
+    }
+    return chunk_get_block(chunk, x - chunk->x * CHUNK_SIZE, y, z - chunk->z * CHUNK_SIZE);
+}
+
+/**
+ * Rewrite the water vertices of the blocks at y around (x, z) in place
+ * A chunk whose water faces changed is listed for a rebuild instead
+ */
+static void world_refresh_water_around(World* world, int x, int y, int z) {
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            int chunk_x, chunk_z;
+            world_to_chunk_coords(x + dx, z + dz, &chunk_x, &chunk_z);
+            Chunk* chunk = world_get_chunk(world, chunk_x, chunk_z);
+            if (!chunk || chunk->in_water_list || chunk_get_state(chunk) != CHUNK_STATE_COMPLETE) continue;
+
+            int local_x = x + dx - chunk_x * CHUNK_SIZE;
+            int local_z = z + dz - chunk_z * CHUNK_SIZE;
+            if (!chunk->water || !chunk_water_refresh_block(world, chunk, local_x, y, local_z)) {
+                world_add_to_water_list(world, chunk);
+            }
+        }
+    }
+}
+
+/**
+ * List the chunks holding the blocks around (x, z) for a water rebuild
+ */
+static void world_rebuild_water_around(World* world, int x, int z) {
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            int chunk_x, chunk_z;
+            world_to_chunk_coords(x + dx, z + dz, &chunk_x, &chunk_z);
+            world_add_to_water_list(world, world_get_chunk(world, chunk_x, chunk_z));
+        }
+    }
+}
+
+/**
+ * Keep the water meshes around an edited block current
+ * A level change rewrites vertices; water coming or going, or a block
+ * turning see-through next to water, changes faces and rebuilds
+ */
+static void world_update_water_meshes(World* world, int x, int y, int z, Block old, Block block) {
+    if (world->headless) return;
+
+    if (old.type == BLOCK_WATER && block.type == BLOCK_WATER) {
+        world_refresh_water_around(world, x, y, z);
+        return;
+    }
+    bool water = old.type == BLOCK_WATER || block.type == BLOCK_WATER;
+    if (!water && chunk_water_hides_face(old) != chunk_water_hides_face(block)) {
+        static const int dirs[6][3] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+        for (int d = 0; d < 6 && !water; d++) {
+            int ny = y + dirs[d][1];
+            if (ny < 0 || ny >= CHUNK_HEIGHT) continue;
+            water = world_get_block(world, x + dirs[d][0], ny, z + dirs[d][2]).type == BLOCK_WATER;
+        }
+    }
+    if (water) world_rebuild_water_around(world, x, z);
+}
+
+/**
+ * Write one block into a chunk that may be edited, relighting around it
+ * Returns whether the block meshes changed: the caller then queues the
+ * chunk for remesh (and always for save). Water and air are not part of
+ * the block meshes, so flowing water only touches the water meshes
+ */
+static bool world_apply_edit(World* world, Chunk* chunk, int x, int y, int z, Block block) {
+    int local_x = x - chunk->x * CHUNK_SIZE;
+    int local_z = z - chunk->z * CHUNK_SIZE;
+
+    Block old = chunk_get_block(chunk, local_x, y, local_z);
+    uint16_t dirty_sections = chunk->dirty_sections;
+    bool needs_remesh = chunk->needs_remesh;
+    bool lod_stale = chunk->lod_stale;
+    chunk_set_block(chunk, local_x, y, local_z, block);
+
+    bool meshed = block_is_solid(old) || block_is_opaque(old) || block_is_solid(block) || block_is_opaque(block);
+    if (meshed) {
+        world_mark_neighbors_dirty(world, chunk->x, chunk->z, local_x, y, local_z);
+    } else {
+        chunk->dirty_sections = dirty_sections;
+        chunk->needs_remesh = needs_remesh;
+        chunk->lod_stale = lod_stale;  // LOD cells keep solid blocks only
+    }
+    world_update_water_meshes(world, x, y, z, old, block);
+
+    // Relight only the cells that depend on this block, across chunk borders
+    // (light that changes still remeshes the sections it reaches)
+    light_update_block(world, x, y, z, old);
+    return meshed;
+}
+
+void world_set_block(World* world, int x, int y, int z, Block block) {
+    // The water thread must not read chunks while blocks change
+    if (world->water_queue) {
+        water_sync(world->water_queue, world);
+    }
+
+    int chunk_x, chunk_z;
+    int local_x, local_y, local_z;
+    world_to_local_coords(x, y, z, &chunk_x, &chunk_z, &local_x, &local_y, &local_z);
+    if (local_y < 0 || local_y >= CHUNK_HEIGHT) return;
+
+    Chunk* chunk = world_get_or_create_chunk(world, chunk_x, chunk_z);
+    if (!chunk || world_chunk_in_worker(chunk)) {
+        return;  // Worker is writing this chunk; terrain generation would overwrite the edit anyway
+    }
+    if (chunk_get_state(chunk) == CHUNK_STATE_MESHING) {
+        return;  // Worker is reading the blocks; the palette must not be reallocated under it
+    }
+    // Add chunk to dirty list for remeshing
+    if (world_apply_edit(world, chunk, x, y, z, block)) {
+        world_add_to_dirty_list(world, chunk);
+    }
+    chunk->needs_save = true;
+
+    // Notify water system of block change
+    if (world->water_queue) {
+        water_on_block_change(world->water_queue, world, x, y, z);
+    }
+
+    // The batch is patched once the worker remesh of the dirty sections lands
+}
+
+bool world_set_block_metadata(World* world, int x, int y, int z, uint8_t metadata) {
+    if (y < 0 || y >= CHUNK_HEIGHT) return false;
+
+    // The metadata nibbles may be reallocated, same rules as world_set_block
+    if (world->water_queue) {
+        water_sync(world->water_queue, world);
+    }
+    int chunk_x, chunk_z;
+    world_to_chunk_coords(x, z, &chunk_x, &chunk_z);
+    Chunk* chunk = world_get_chunk(world, chunk_x, chunk_z);
+    if (!chunk || world_chunk_in_worker(chunk) || chunk_get_state(chunk) == CHUNK_STATE_MESHING) {
+        return false;
+    }
+
+    int local_x = x - chunk_x * CHUNK_SIZE;
+    int local_z = z - chunk_z * CHUNK_SIZE;
+    Block block = chunk_get_block(chunk, local_x, y, local_z);
+    if (block.metadata == metadata) return true;
+
+    uint16_t dirty = chunk->dirty_sections;
+    block.metadata = metadata;
+    chunk_set_block(chunk, local_x, y, local_z, block);
+    chunk->dirty_sections = dirty;  // Not meshed
+    chunk->needs_save = true;
+    return true;
+}
+
+void world_set_blocks(World* world, const WorldEdit* edits, int count) {
+    if (!world || !edits) return;
+
+    WorldCursor cursor;
+    world_cursor_init(&cursor, world);
+    Chunk* last = NULL;
+    for (int i = 0; i < count; i++) {
+        const WorldEdit* edit = &edits[i];
+        if (edit->y < 0 || edit->y >= CHUNK_HEIGHT) continue;
+
+        // Same rules as world_set_block, but unloaded chunks are not created
+        Chunk* chunk = world_cursor_get_chunk(&cursor, edit->x, edit->z);
+        if (!chunk || chunk_get_state(chunk) == CHUNK_STATE_MESHING) continue;
+        if (world_apply_edit(world, chunk, edit->x, edit->y, edit->z, edit->block)) {
+            world_add_to_dirty_list(world, chunk);
+        }
+        if (chunk != last) {
+            chunk->needs_save = true;
+            last = chunk;
+        }
+    }
+}
+
+/**
+ * Hold back generation of a chunk requested from the host
+ * Returns false once the chunk should be enqueued: its data arrived, the
+ * host has none, the request failed or timed out, or there is no host.
+ */
+static bool world_wait_for_host(World* world, Chunk* chunk) {
+    if (!world->chunk_request || chunk->remote_data || chunk->remote_local) return false;
+
+    if (chunk->remote_wait == 0 &&
+        !world->chunk_request(world->chunk_request_user, chunk->x, chunk->z)) {
+        chunk->remote_local = true;
+        return false;
+    }
+    if (++chunk->remote_wait >= WORLD_REMOTE_CHUNK_TIMEOUT) {
+        printf("[WORLD] Host did not send chunk (%d, %d), generating it\n", chunk->x, chunk->z);
+        chunk->remote_local = true;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Spawn animals once for a newly completed chunk (biome-aware herds)
+ * Its worker planned them; they are placed over the next frames by
+ * world_place_spawns. A world streaming chunks from a host gets its animals
+ * from the host too.
+ */
+static void world_spawn_for_chunk(World* world, Chunk* chunk) {
+    if (world->entity_manager && !chunk->has_spawned && !world->chunk_request) {
+        if (chunk->spawn_placed < chunk->spawn_count) world_add_to_spawn_list(world, chunk);
+        chunk->has_spawned = true;
+    }
+}
+
+/**
+ * Place up to WORLD_SPAWNS_PER_FRAME planned animals of listed chunks
+ * Returns the number placed
+ */
+static int world_place_spawns(World* world) {
+    if (!world->entity_manager) return 0;
+
+    int placed = 0;
+    while (world->spawn_head && placed < WORLD_SPAWNS_PER_FRAME) {
+        Chunk* chunk = world->spawn_head;
+        while (chunk->spawn_placed < chunk->spawn_count && placed < WORLD_SPAWNS_PER_FRAME) {
+            spawn_place(world->entity_manager, &chunk->spawns[chunk->spawn_placed++]);
+            placed++;
+        }
+        if (chunk->spawn_placed == chunk->spawn_count) {
+            world_remove_from_spawn_list(world, chunk);  // Head: O(1)
+        }
+    }
+    return placed;
+}
+
+/**
+ * (Re)build the water meshes of up to WORLD_WATER_BUILDS_PER_FRAME listed
+ * chunks. Chunks that lost their mesh meanwhile are dropped
+ * Returns the number built
+ */
+static int world_build_water(World* world) {
+    int built = 0;
+    while (world->water_head && built < WORLD_WATER_BUILDS_PER_FRAME) {
+        Chunk* chunk = world->water_head;
+        world_remove_from_water_list(world, chunk);  // Head: O(1)
+        if (chunk_get_state(chunk) != CHUNK_STATE_COMPLETE) continue;
+        chunk_water_build(world, chunk);
+        built++;
+    }
+    return built;
+}
+
+/**
+ * Order the chunk's next transparent mesh from the current camera block
+ */
+static void world_stamp_sort_origin(World* world, Chunk* chunk) {
+    memcpy(chunk->sort_origin, world->camera_block, sizeof(chunk->sort_origin));
+}
+
+/**
+ * The camera entered a new block: remesh the transparent sections of the
+ * chunks around it so the workers re-sort their faces from there
+ */
+static void world_resort_transparent(World* world) {
+    if (memcmp(world->camera_block, world->sorted_block, sizeof(world->camera_block)) == 0) return;
+    memcpy(world->sorted_block, world->camera_block, sizeof(world->sorted_block));
+
+    int camera_cx, camera_cz;
+    world_to_chunk_coords(world->camera_block[0], world->camera_block[2], &camera_cx, &camera_cz);
+    for (int dz = -WORLD_SORT_RADIUS; dz <= WORLD_SORT_RADIUS; dz++) {
+        for (int dx = -WORLD_SORT_RADIUS; dx <= WORLD_SORT_RADIUS; dx++) {
+            Chunk* chunk = world_get_chunk(world, camera_cx + dx, camera_cz + dz);
+            if (!chunk || chunk_get_state(chunk) != CHUNK_STATE_COMPLETE || !chunk->transparent_mesh_generated) continue;
+
+            uint16_t mask = 0;
+            for (int sy = 0; sy < CHUNK_SECTION_COUNT; sy++) {
+                if (chunk->transparent_ranges.start[sy + 1] - chunk->transparent_ranges.start[sy] >
+                    CHUNK_QUAD_VERTICES) {
+                    mask |= (uint16_t)(1u << sy);
+                }
+            }
+            if (mask == 0) continue;
+            chunk_mark_sections_dirty(chunk, mask);
+            world_add_to_dirty_list(world, chunk);
+        }
+    }
+}
+
+/**
+ * Drop a far chunk's full-detail mesh once an LOD region draws it
+ * The chunk goes back to GENERATED and is meshed again when it comes near
+ */
+static void world_release_mesh(World* world, Chunk* chunk) {
+    if (world->batcher) {
+        chunk_batcher_unregister_chunk(world->batcher, chunk);
+    }
+    if (world->pool) {
+        chunk_pool_release_chunk(world->pool, chunk);
+    }
+    world_remove_from_dirty_list(world, chunk);
+    world_remove_from_water_list(world, chunk);
+    chunk_mesh_unload(&chunk->mesh);
+    chunk_mesh_unload(&chunk->transparent_mesh);
+    chunk_water_destroy(chunk->water);
+    chunk->water = NULL;
+    chunk->mesh_generated = false;
+    chunk->transparent_mesh_generated = false;
+    chunk->needs_remesh = true;
+    chunk->dirty_sections = CHUNK_SECTIONS_ALL;
+    memset(&chunk->mesh_ranges, 0, sizeof(ChunkMeshRanges));
+    memset(&chunk->transparent_ranges, 0, sizeof(ChunkMeshRanges));
+    chunk_set_state(chunk, CHUNK_STATE_GENERATED);
+}
+
+/**
+ * Place tree parts that reached chunks after they were decorated, as
+ * ordinary edits (relit and remeshed). Chunks a worker owns get them on a
+ * later frame; unloaded chunks get them back as pending for their reload.
+ * Water is synced by the caller
+ */
+static void world_apply_late_structures(World* world) {
+    StructureFragment fragments[WORLD_LATE_STRUCTURES_PER_FRAME];
+    int count = structure_store_take_late(world->structures, fragments, WORLD_LATE_STRUCTURES_PER_FRAME);
+
+    for (int i = 0; i < count; i++) {
+        Chunk* chunk = world_get_chunk(world, fragments[i].chunk_x, fragments[i].chunk_z);
+        ChunkState state = chunk ? chunk_get_state(chunk) : CHUNK_STATE_EMPTY;
+        if (!CHUNK_STATE_HAS_BLOCKS(state) || state == CHUNK_STATE_MESHING) {
+            structure_store_add(world->structures, &fragments[i]);
+            continue;
+        }
+
+        WorldEdit edits[TREE_MAX_BLOCKS];
+        int edit_count = tree_fragment_edits(chunk, &fragments[i], edits, TREE_MAX_BLOCKS);
+        if (edit_count > 0) {
+            world_set_blocks(world, edits, edit_count);
+        }
+    }
+}
+
+// ============================================================================
+// LOAD TICKETS
+// ============================================================================
+
+_Static_assert(WORLD_MAX_TICKETS + 2 <= WORKER_MAX_FOCUS,
+               "The center, the prefetch window and every ticket are worker focus points");
+
+int world_add_ticket(World* world, int chunk_x, int chunk_z, int radius) {
+    if (!world || radius < 0) return -1;
+
+    for (int i = 0; i < WORLD_MAX_TICKETS; i++) {
+        WorldTicket* ticket = &world->tickets[i];
+        if (ticket->active) continue;
+        ticket->chunk_x = chunk_x;
+        ticket->chunk_z = chunk_z;
+        ticket->radius = radius;
+        ticket->active = true;
+        world->tickets_moved = true;
+        world_stream_window(world, chunk_x, chunk_z, radius + WORLD_BORDER_RING, false, 0, 0, 0);
+        return i;
+    }
+    printf("[WORLD] All %d load tickets taken, (%d, %d) is not kept loaded\n", WORLD_MAX_TICKETS, chunk_x, chunk_z);
+    return -1;
+}
+
+void world_move_ticket(World* world, int ticket, int chunk_x, int chunk_z) {
+    if (!world || ticket < 0 || ticket >= WORLD_MAX_TICKETS) return;
+
+    WorldTicket* t = &world->tickets[ticket];
+    if (!t->active || (t->chunk_x == chunk_x && t->chunk_z == chunk_z)) return;
+
+    // The uncovered ring, and border chunks that now need simulating
+    int reach = t->radius + WORLD_BORDER_RING;
+    world_stream_window(world, chunk_x, chunk_z, reach, true, t->chunk_x, t->chunk_z, reach);
+    world_stream_window(world, chunk_x, chunk_z, t->radius, true, t->chunk_x, t->chunk_z, t->radius);
+    t->chunk_x = chunk_x;
+    t->chunk_z = chunk_z;
+    world->tickets_moved = true;
+}
+
+void world_remove_ticket(World* world, int ticket) {
+    if (!world || ticket < 0 || ticket >= WORLD_MAX_TICKETS) return;
+    world->tickets[ticket].active = false;
+    world->tickets_moved = true;  // Its queued generation is dropped
+}
+
+/**
+ * Chebyshev distance from the chunk to the nearest anchor (center or ticket)
+ */
+static int world_anchor_distance(const World* world, int chunk_x, int chunk_z) {
+    int dx = abs(chunk_x - world->center_chunk_x);
+    int dz = abs(chunk_z - world->center_chunk_z);
+    int best = dx > dz ? dx : dz;
+    for (int i = 0; i < WORLD_MAX_TICKETS; i++) {
+        const WorldTicket* ticket = &world->tickets[i];
+        if (!ticket->active) continue;
+        dx = abs(chunk_x - ticket->chunk_x);
+        dz = abs(chunk_z - ticket->chunk_z);
+        int dist = dx > dz ? dx : dz;
+        if (dist < best) best = dist;
+    }
+    return best;
+}
+
+/**
+ * How many rings the chunk lies past the nearest load window: the center's
+ * view (or its prefetch copy ahead of the motion) or a ticket's radius
+ * (<= 0 = inside one)
+ */
+static int world_window_excess(const World* world, int chunk_x, int chunk_z) {
+    int dx = abs(chunk_x - world->center_chunk_x);
+    int dz = abs(chunk_z - world->center_chunk_z);
+    int best = (dx > dz ? dx : dz) - world->view_distance;
+    if (world->prefetch_active) {
+        dx = abs(chunk_x - world->prefetch_x);
+        dz = abs(chunk_z - world->prefetch_z);
+        int excess = (dx > dz ? dx : dz) - world->view_distance;
+        if (excess < best) best = excess;
+    }
+    for (int i = 0; i < WORLD_MAX_TICKETS; i++) {
+        const WorldTicket* ticket = &world->tickets[i];
+        if (!ticket->active) continue;
+        dx = abs(chunk_x - ticket->chunk_x);
+        dz = abs(chunk_z - ticket->chunk_z);
+        int excess = (dx > dz ? dx : dz) - ticket->radius;
+        if (excess < best) best = excess;
+    }
+    return best;
+}
+
+/**
+ * Point the workers at every anchor: tasks run nearest anchor first, and
+ * queued ones outside all generated windows are dropped. The prefetch
+ * window counts as an anchor, so the leading edge of a moving view comes
+ * before the trailing one
+ */
+static void world_focus_workers(World* world) {
+    WorkerFocus focus[WORKER_MAX_FOCUS];
+    int count = 0;
+    focus[count++] = (WorkerFocus){ world->center_chunk_x, world->center_chunk_z,
+                                    world->view_distance + WORLD_BORDER_RING };
+    if (world->prefetch_active) {
+        focus[count++] = (WorkerFocus){ world->prefetch_x, world->prefetch_z, world->view_distance + WORLD_BORDER_RING };
+    }
+    for (int i = 0; i < WORLD_MAX_TICKETS; i++) {
+        const WorldTicket* ticket = &world->tickets[i];
+        if (!ticket->active) continue;
+        focus[count++] = (WorkerFocus){ ticket->chunk_x, ticket->chunk_z, ticket->radius + WORLD_BORDER_RING };
+    }
+    chunk_worker_set_focus(world->worker, focus, count);
+    chunk_worker_cancel_outside(world->worker, focus, count);
+    world->tickets_moved = false;
+}
+
 /**
- * Hash function for chunk coordinates
+ * Whether the chunk lies inside a ticket's simulated radius
  */
-static uint32_t hash_chunk_coords(int x, int z) {
-    // Simple hash combining x and z
-    uint32_t h = 2166136261u;
-    h = (h ^ (uint32_t)x) * 16777619u;
-    h = (h ^ (uint32_t)z) * 16777619u;
-    return h % WORLD_MAX_CHUNKS;
+static bool world_in_ticket_radius(const World* world, int chunk_x, int chunk_z) {
+    for (int i = 0; i < WORLD_MAX_TICKETS; i++) {
+        const WorldTicket* ticket = &world->tickets[i];
+        if (ticket->active && abs(chunk_x - ticket->chunk_x) <= ticket->radius &&
+            abs(chunk_z - ticket->chunk_z) <= ticket->radius) {
+            return true;
+        }
+    }
+    return false;
 }
 
 /**
- * Create chunk hash map
+ * Move the prefetch window to where the center's motion leads it; the
+ * chunks it newly covers join the stream list. Returns true if it moved
  */
-static ChunkHashMap* chunk_hashmap_create(void) {
-    ChunkHashMap* map = (ChunkHashMap*)malloc(sizeof(ChunkHashMap));
-    memset(map->buckets, 0, sizeof(map->buckets));
-    map->chunk_count = 0;
-    return map;
+static bool world_update_prefetch(World* world) {
+    float lead = WORLD_PREFETCH_SECONDS / (float)CHUNK_SIZE;
+    int lead_x = (int)lroundf(world->velocity_x * lead);
+    int lead_z = (int)lroundf(world->velocity_z * lead);
+    if (lead_x > WORLD_PREFETCH_MAX) lead_x = WORLD_PREFETCH_MAX;
+    if (lead_x < -WORLD_PREFETCH_MAX) lead_x = -WORLD_PREFETCH_MAX;
+    if (lead_z > WORLD_PREFETCH_MAX) lead_z = WORLD_PREFETCH_MAX;
+    if (lead_z < -WORLD_PREFETCH_MAX) lead_z = -WORLD_PREFETCH_MAX;
+
+    bool active = lead_x != 0 || lead_z != 0;
+    int x = world->center_chunk_x + lead_x;
+    int z = world->center_chunk_z + lead_z;
+    if (active == world->prefetch_active && (!active || (x == world->prefetch_x && z == world->prefetch_z))) {
+        return false;
+    }
+
+    // Compared with the old prefetch window, or with the center's own
+    if (active) {
+        int reach = world->view_distance + WORLD_BORDER_RING;
+        int old_x = world->prefetch_active ? world->prefetch_x : world->center_chunk_x;
+        int old_z = world->prefetch_active ? world->prefetch_z : world->center_chunk_z;
+        world_stream_window(world, x, z, reach, true, old_x, old_z, reach);
+    }
+    world->prefetch_active = active;
+    world->prefetch_x = x;
+    world->prefetch_z = z;
+    return true;
 }
 
 /**
- * Destroy chunk hash map
+ * Streaming work for one listed chunk, by the window it lies in:
+ * - center view: generated, then meshed once its neighbors' blocks are
+ *   final (complete without a mesh when headless); past the full-detail
+ *   ring its mesh is dropped once an LOD region draws it
+ * - ticket radius: generated and handed to simulation once its neighbors
+ *   are final (animals spawned, completed when headless), never meshed
+ * - border rings and the prefetch window: generated only
+ * Returns true when nothing is left to do and the chunk leaves the list
  */
-static void chunk_hashmap_destroy(ChunkHashMap* map) {
-    if (!map) return;
+static bool world_stream_chunk(World* world, Chunk* chunk) {
+    int cx = chunk->x, cz = chunk->z;
+    bool in_view = abs(cx - world->center_chunk_x) <= world->view_distance &&
+                   abs(cz - world->center_chunk_z) <= world->view_distance;
+    bool in_ticket = !in_view && world_in_ticket_radius(world, cx, cz);
+    if (!in_view && !in_ticket && world_window_excess(world, cx, cz) > WORLD_BORDER_RING) {
+        return true;  // Left every window: eviction takes it from here
+    }
 
-    // Free all chunks and nodes
-    for (int i = 0; i < WORLD_MAX_CHUNKS; i++) {
-        ChunkNode* node = map->buckets[i];
-        while (node) {
-            ChunkNode* next = node->next;
-            chunk_destroy(node->chunk);
-            free(node);
-            node = next;
+    ChunkState state = chunk_get_state(chunk);
+    if (state == CHUNK_STATE_EMPTY) {
+        // Also picks up cancelled tasks and failed submits
+        if (!world_chunk_retiring(world, cx, cz) && !world_wait_for_host(world, chunk)) {
+            chunk_worker_enqueue(world->worker, chunk, world->terrain_params);
         }
+        return false;
+    }
+    if (state == CHUNK_STATE_QUEUED || state == CHUNK_STATE_GENERATING) return false;
+
+    if (in_view) {
+        int center_x = world->center_chunk_x, center_z = world->center_chunk_z;
+        if (chunk_lod_full_detail(world->lod, center_x, center_z, cx, cz, 0)) {
+            if (state != CHUNK_STATE_GENERATED) return state == CHUNK_STATE_COMPLETE;
+            if (!world_neighbors_generated(world, cx, cz)) return false;
+
+            light_stitch_chunk(world, chunk);
+            if (world->headless) {
+                chunk_set_state(chunk, CHUNK_STATE_COMPLETE);  // Nothing to mesh
+                world_spawn_for_chunk(world, chunk);
+                return true;
+            }
+            world_stamp_sort_origin(world, chunk);
+            chunk_worker_enqueue_mesh(world->worker, chunk, world_capture_border(world, chunk));
+            return false;  // Settles when uploaded (or is retried if the submit failed)
+        }
+
+        // LOD ring: a full mesh left from nearer is dropped once covered
+        if (state != CHUNK_STATE_COMPLETE) return state == CHUNK_STATE_GENERATED;
+        if (chunk->remesh_pending) return false;
+        if (chunk_lod_full_detail(world->lod, center_x, center_z, cx, cz, LOD_DEMOTE_MARGIN)) return true;
+        if (!chunk_lod_covers(world->lod, cx, cz)) return false;
+        world_release_mesh(world, chunk);
+        return true;
     }
 
-    free(map);
+    if (in_ticket && state == CHUNK_STATE_GENERATED) {
+        if (!world_neighbors_generated(world, cx, cz)) return false;
+        if (world->headless) {
+            light_stitch_chunk(world, chunk);
+            chunk_set_state(chunk, CHUNK_STATE_COMPLETE);
+        }
+        world_spawn_for_chunk(world, chunk);  // Meshed once it enters the view
+    }
+    return true;
 }
 
 /**
- * Insert chunk into hash map
+ * Bring the stream list up to date with the center's window, then work
+ * through it. A moved center lists the ring it uncovered, the border chunks
+ * that entered the view and the band around the full-detail ring whose
+ * meshes come and go; a changed view or LOD distance relists the window
  */
-static void chunk_hashmap_insert(ChunkHashMap* map, int chunk_x, int chunk_z, Chunk* chunk) {
-    uint32_t hash = hash_chunk_coords(chunk_x, chunk_z);
+static void world_stream(World* world) {
+    int center_x = world->center_chunk_x, center_z = world->center_chunk_z;
+    int view = world->view_distance;
+    int reach = view + WORLD_BORDER_RING;
+    int lod_distance = world->lod ? world->lod->distance : 0;
+
+    if (!world->stream_valid || world->stream_view_distance != view || world->stream_lod_distance != lod_distance) {
+        world_stream_window(world, center_x, center_z, reach, false, 0, 0, 0);
+    } else if (center_x != world->stream_center_x || center_z != world->stream_center_z) {
+        int old_x = world->stream_center_x, old_z = world->stream_center_z;
+        world_stream_window(world, center_x, center_z, reach, true, old_x, old_z, reach);
+        world_stream_window(world, center_x, center_z, view, true, old_x, old_z, view);
+        if (world->lod) {
+            // Level 1 regions are two chunks wide: a region's distance is
+            // its chunks' distance or one less
+            int dx = abs(center_x - old_x), dz = abs(center_z - old_z);
+            int moved = dx > dz ? dx : dz;
+            int inner = lod_distance - moved;
+            int outer = lod_distance + LOD_DEMOTE_MARGIN + 1 + moved;
+            if (outer > view) outer = view;
+            world_stream_window(world, center_x, center_z, outer, inner > 0, center_x, center_z, inner - 1);
+        }
+    }
+    world->stream_valid = true;
+    world->stream_center_x = center_x;
+    world->stream_center_z = center_z;
+    world->stream_view_distance = view;
+    world->stream_lod_distance = lod_distance;
 
-    ChunkNode* node = (ChunkNode*)malloc(sizeof(ChunkNode));
-    node->chunk_x = chunk_x;
-    node->chunk_z = chunk_z;
-    node->chunk = chunk;
-    node->next = map->buckets[hash];
-    map->buckets[hash] = node;
-    map->chunk_count++;
+    Chunk** pp = &world->stream_head;
+    while (*pp) {
+        Chunk* chunk = *pp;
+        if (world_stream_chunk(world, chunk)) {
+            *pp = chunk->stream_next;
+            chunk->stream_next = NULL;
+            chunk->in_stream_list = false;
+            world->stream_count--;
+        } else {
+            pp = &chunk->stream_next;
+        }
+    }
 }
 
 /**
- * Get chunk from hash map
+ * Freeze a few idle chunks past the cold ring, walking the index a slice
+ * per frame. Chunks with work in flight are left warm; thawed ones sit out
+ * a few passes so a chunk in use does not bounce
  */
-static Chunk* chunk_hashmap_get(ChunkHashMap* map, int chunk_x, int chunk_z) {
-    uint32_t hash = hash_chunk_coords(chunk_x, chunk_z);
-    ChunkNode* node = map->buckets[hash];
-
-    while (node) {
-        if (node->chunk_x == chunk_x && node->chunk_z == chunk_z) {
-            return node->chunk;
+static void world_freeze_distant(World* world) {
+    if (world->cold_distance <= 0 || world->chunks->chunk_count == 0) return;
+
+    int span = chunk_index_span(world->chunks);
+    int frozen = 0;
+    for (int n = 0; n < WORLD_COLD_SCAN_PER_FRAME && frozen < WORLD_COLD_PER_FRAME; n++) {
+        world->cold_cursor = (world->cold_cursor + 1) % span;
+        Chunk* chunk = chunk_index_at(world->chunks, world->cold_cursor);
+        if (!chunk || chunk_is_cold(chunk)) continue;
+
+        if (world_anchor_distance(world, chunk->x, chunk->z) <= world->cold_distance) continue;
+
+        ChunkState state = chunk_get_state(chunk);
+        bool idle = (state == CHUNK_STATE_GENERATED || state == CHUNK_STATE_COMPLETE) &&
+                    !chunk->remesh_pending && !chunk->in_dirty_list && !chunk->in_water_list && !chunk->lod_stale;
+        if (!idle) continue;
+        if (chunk->cold_skip > 0) {
+            chunk->cold_skip--;
+            continue;
         }
-        node = node->next;
+        if (chunk_freeze(chunk)) frozen++;
     }
-
-    return NULL;
 }
 
-// ============================================================================
-// COORDINATE CONVERSION
-// ============================================================================
+void world_update(World* world, int center_chunk_x, int center_chunk_z) {
+    if (!world) return;
+    PROFILE_BEGIN(PROFILE_WORLD_UPDATE);
 
-void world_to_chunk_coords(int world_x, int world_z, int* chunk_x, int* chunk_z) {
-    *chunk_x = world_x >= 0 ? world_x / CHUNK_SIZE : (world_x - CHUNK_SIZE + 1) / CHUNK_SIZE;
-    *chunk_z = world_z >= 0 ? world_z / CHUNK_SIZE : (world_z - CHUNK_SIZE + 1) / CHUNK_SIZE;
-}
+    // Finish the water tick in flight: chunks are loaded, unloaded and
+    // relit below, which the water thread must not see halfway
+    if (world->water_queue) {
+        water_sync(world->water_queue, world);
+    }
 
-void world_to_local_coords(int world_x, int world_y, int world_z,
-                           int* chunk_x, int* chunk_z,
-                           int* local_x, int* local_y, int* local_z) {
-    world_to_chunk_coords(world_x, world_z, chunk_x, chunk_z);
+    bool center_moved = !world->stream_valid || world->stream_center_x != center_chunk_x ||
+                        world->stream_center_z != center_chunk_z;
+    world->center_chunk_x = center_chunk_x;
+    world->center_chunk_z = center_chunk_z;
 
-    *local_x = world_x - (*chunk_x * CHUNK_SIZE);
-    *local_y = world_y;
-    *local_z = world_z - (*chunk_z * CHUNK_SIZE);
+    bool prefetch_moved = world_update_prefetch(world);
+    if (center_moved || prefetch_moved || world->tickets_moved) {
+        // Reprioritize queued generation around the anchors and drop tasks
+        // that left every window before a worker spends time on them
+        world_focus_workers(world);
+    }
 
-    // Handle negative coordinates
-    if (*local_x < 0) *local_x += CHUNK_SIZE;
-    if (*local_z < 0) *local_z += CHUNK_SIZE;
-}
+    // Poll for completed chunks from worker threads, within the frame's
+    // upload budget (the count cap stays configurable via settings)
+    PROFILE_BEGIN(PROFILE_WORLD_UPLOADS);
+    upload_budget_begin(world->upload_budget);
+    int max_uploads = world->max_uploads_per_frame > 0 ? world->max_uploads_per_frame : MAX_UPLOADS_PER_FRAME;
+    int uploaded = 0;
+    size_t uploaded_bytes = 0;
+    for (int i = 0; i < max_uploads && upload_budget_allows(world->upload_budget, 0); i++) {
+        CompletedChunk* completed = chunk_worker_poll_completed(world->worker);
+        if (!completed) break;
+        size_t bytes = (size_t)(completed->mesh.vertex_count + completed->mesh.trans_vertex_count) *
+                       sizeof(ChunkVertex);
 
-// ============================================================================
-// WORLD MANAGEMENT
-// ============================================================================
+        // Unloaded while the worker meshed it: the result has nowhere to go
+        if (chunk_is_detached(completed->chunk)) {
+            chunk_worker_release_completed(completed);
+            continue;
+        }
 
-World* world_create(TerrainParams terrain_params) {
-    World* world = (World*)malloc(sizeof(World));
-    world->chunks = chunk_hashmap_create();
-    world->worker = chunk_worker_create();
-    world->batcher = chunk_batcher_create();
-    world->center_chunk_x = 0;
-    world->center_chunk_z = 0;
-    world->view_distance = WORLD_VIEW_DISTANCE;
-    world->terrain_params = terrain_params;
-    world->player = NULL;  // Set by game after player creation
-    world->entity_manager = NULL;  // Set by game after entity manager creation
-    world->time_of_day = 12.0f;  // Default to noon
-    world->water_queue = water_queue_create();
-    world->game_tick = 0;
-    world->chest_registry = chest_registry_create();
-    world->dirty_head = NULL;
-    world->dirty_count = 0;
-    world->batch_rebuilds_per_frame = 16;  // Default from BATCH_REBUILDS_PER_FRAME
-    world->max_uploads_per_frame = MAX_UPLOADS_PER_FRAME;
+        if (completed->remesh) {
+            world_finish_remesh(world, completed);
+            chunk_worker_release_completed(completed);
+            upload_budget_spend(world->upload_budget, bytes);
+            uploaded++;
+            uploaded_bytes += bytes;
+            continue;
+        }
 
-    // Initialize spawn system
-    spawn_system_init();
+        // Upload mesh to GPU (must be on main thread)
+        chunk_worker_upload_mesh(completed->chunk, &completed->mesh);
 
-    printf("[WORLD] Created world with view distance %d\n", world->view_distance);
-    return world;
-}
+        // Neighbors that were meshing at submit time missed the light seam
+        light_stitch_chunk(world, completed->chunk);
 
-void world_destroy(World* world) {
-    if (!world) return;
+        // Register chunk with batcher or pool for batched rendering
+        if (world->batcher) {
+            chunk_batcher_register_chunk(world->batcher, completed->chunk);
+        }
+        if (world->pool) {
+            chunk_pool_write_chunk(world->pool, completed->chunk);
+        }
 
-    // Stop worker threads first
-    if (world->worker) {
-        chunk_worker_destroy(world->worker);
+        world_add_to_water_list(world, completed->chunk);
+        world_spawn_for_chunk(world, completed->chunk);
+        chunk_worker_release_completed(completed);
+        upload_budget_spend(world->upload_budget, bytes);
+        uploaded++;
+        uploaded_bytes += bytes;
+    }
+    world->frame_stats.uploads = uploaded;
+    world_reap_retired(world);
+    world->frame_stats.upload_bytes = uploaded_bytes;
+    PROFILE_END(PROFILE_WORLD_UPLOADS);
+
+    world_apply_late_structures(world);
+    world->frame_stats.spawns = world_place_spawns(world);
+    world->frame_stats.water_builds = world_build_water(world);
+
+    // Unload far chunks before loading new ones (the periodic sweep also
+    // catches budget overruns while the center stays put)
+    if (center_moved || world->game_tick - world->last_evict_tick >= WORLD_EVICT_INTERVAL) {
+        PROFILE_BEGIN(PROFILE_WORLD_EVICT);
+        world_evict_chunks(world);
+        world->last_evict_tick = world->game_tick;
+        PROFILE_END(PROFILE_WORLD_EVICT);
     }
 
-    // Destroy batcher before chunks (has references to chunks)
-    if (world->batcher) {
-        chunk_batcher_destroy(world->batcher);
+    // Water is synced and entities are idle, so nothing else reads blocks now
+    PROFILE_BEGIN(PROFILE_WORLD_COLD);
+    world_freeze_distant(world);
+    PROFILE_END(PROFILE_WORLD_COLD);
+
+    // Load chunks in view distance if not already loaded. One extra ring is
+    // generated but never meshed, so every meshed chunk has all its neighbors
+    PROFILE_BEGIN(PROFILE_WORLD_STREAMING);
+    world_stream(world);
+    PROFILE_END(PROFILE_WORLD_STREAMING);
+
+    PROFILE_BEGIN(PROFILE_WORLD_REMESH);
+    if (!world->headless) {
+        world_resort_transparent(world);
     }
 
-    // Destroy water system
-    if (world->water_queue) {
-        water_queue_destroy(world->water_queue);
+    // Process pending mesh regenerations using dirty list (O(dirty) instead of O(all_chunks))
+    // Meshing runs on the worker threads against a block snapshot, so edits
+    // cost only the snapshot copy here. Chunks with a remesh in flight stay
+    // listed and are resubmitted once their previous result is uploaded
+    Chunk* chunk = world->dirty_head;
+    while (chunk) {
+        Chunk* next = (Chunk*)chunk->dirty_next;  // Save next before removing from list
+        if (world->headless) {
+            chunk->needs_remesh = false;
+            chunk->dirty_sections = 0;
+            world_remove_from_dirty_list(world, chunk);
+        }
+        // Only remesh if chunk is complete and needs it
+        else if (chunk_get_state(chunk) == CHUNK_STATE_COMPLETE && chunk->needs_remesh && !chunk->remesh_pending) {
+            // Snapshot covers every edit so far; later edits set the flag again
+            chunk->needs_remesh = false;
+            world_stamp_sort_origin(world, chunk);
+            if (chunk_worker_enqueue_remesh(world->worker, chunk, world_capture_border(world, chunk))) {
+                world_remove_from_dirty_list(world, chunk);
+            } else {
+                chunk->needs_remesh = true;  // Snapshot failed, retry next frame
+            }
+        }
+        chunk = next;
     }
+    PROFILE_END(PROFILE_WORLD_REMESH);
 
-    // Destroy chest registry
-    if (world->chest_registry) {
-        chest_registry_destroy(world->chest_registry);
+    // Update batched meshes (rebuild dirty batches)
+    PROFILE_BEGIN(PROFILE_BATCH_REBUILD);
+    world->frame_stats.batch_rebuilds = 0;
+    if (world->batcher) {
+        world->frame_stats.batch_rebuilds =
+            chunk_batcher_update(world->batcher, world, world->batch_rebuilds_per_frame, world->upload_budget);
     }
+    if (world->pool) {
+        chunk_pool_update(world->pool);
+    }
+    upload_budget_end(world->upload_budget);
+    PROFILE_END(PROFILE_BATCH_REBUILD);
+
+    // Select and build the LOD regions past the full-detail ring
+    PROFILE_BEGIN(PROFILE_LOD_UPDATE);
+    chunk_lod_update(world->lod, world);
+    PROFILE_END(PROFILE_LOD_UPDATE);
+    PROFILE_END(PROFILE_WORLD_UPDATE);
+}
 
-    chunk_hashmap_destroy(world->chunks);
-    free(world);
+void world_tick(World* world) {
+    if (!world) return;
 
-    printf("[WORLD] Destroyed world\n");
+    world->game_tick++;
+
+    // Water flow; with the water thread this tick runs while the frame renders
+    if (world->water_queue) {
+        water_process_tick(world->water_queue, world);
+    }
 }
 
-Chunk* world_get_chunk(World* world, int chunk_x, int chunk_z) {
-    if (!world) return NULL;
-    return chunk_hashmap_get(world->chunks, chunk_x, chunk_z);
+#define WORLD_PREPARE_SLEEP_NS 1000000L   // Between updates while waiting on workers
+
+/**
+ * Chunks within radius of the center that are complete (meshed or headless)
+ */
+static int world_count_complete(World* world, int center_chunk_x, int center_chunk_z, int radius) {
+    int ready = 0;
+    for (int x = -radius; x <= radius; x++) {
+        for (int z = -radius; z <= radius; z++) {
+            Chunk* chunk = world_get_chunk(world, center_chunk_x + x, center_chunk_z + z);
+            if (chunk && chunk_get_state(chunk) == CHUNK_STATE_COMPLETE) ready++;
+        }
+    }
+    return ready;
 }
 
-Chunk* world_get_or_create_chunk(World* world, int chunk_x, int chunk_z) {
-    if (!world) return NULL;
+void world_prepare_spawn(World* world, int center_chunk_x, int center_chunk_z, int ready_radius,
+                         WorldProgressFunc progress, void* user) {
+    if (!world) return;
+    if (ready_radius > world->view_distance) ready_radius = world->view_distance;
+    if (world->lod && ready_radius > world->lod->distance) ready_radius = world->lod->distance;  // Never meshed past it
+    int total = (2 * ready_radius + 1) * (2 * ready_radius + 1);
+
+    // world_update enqueues the whole view on the workers, nearest first,
+    // and uploads and stitches what they finish
+    for (;;) {
+        world_update(world, center_chunk_x, center_chunk_z);
+        int ready = world_count_complete(world, center_chunk_x, center_chunk_z, ready_radius);
+        if (progress) progress(user, ready, total);
+        if (ready >= total) break;
+
+        struct timespec pause = {0, WORLD_PREPARE_SLEEP_NS};
+        nanosleep(&pause, NULL);
+    }
+}
 
-    Chunk* chunk = world_get_chunk(world, chunk_x, chunk_z);
-    if (chunk) return chunk;
+// ============================================================================
+// CHUNK EVICTION
+// ============================================================================
 
-    // Create new chunk
-    chunk = chunk_create(chunk_x, chunk_z);
-    chunk_hashmap_insert(world->chunks, chunk_x, chunk_z, chunk);
+typedef struct {
+    Chunk* chunk;
+    int dist;       // Rings past the nearest load window (square, like the windows)
+} EvictCandidate;
 
-    return chunk;
+/**
+ * Estimate memory held by a chunk: section storage and LOD cells
+ * (mesh vertices live on the GPU only). Sections a worker is still
+ * filling are resized under it, so those chunks count their struct only
+ */
+static size_t estimate_chunk_bytes(Chunk* chunk) {
+    size_t lod = chunk->lod_cells ? sizeof(ChunkLodCells) : 0;
+    if (!world_chunk_readable(chunk)) return sizeof(Chunk) + lod;
+    return chunk_storage_bytes(chunk) + lod;
 }
 
-Block world_get_block(World* world, int x, int y, int z) {
-    int chunk_x, chunk_z;
-    int local_x, local_y, local_z;
-    world_to_local_coords(x, y, z, &chunk_x, &chunk_z, &local_x, &local_y, &local_z);
+/**
+ * Sort farthest first
+ */
+static int compare_evict_candidates(const void* a, const void* b) {
+    const EvictCandidate* ea = (const EvictCandidate*)a;
+    const EvictCandidate* eb = (const EvictCandidate*)b;
+    return eb->dist - ea->dist;
+}
 
-    Chunk* chunk = world_get_chunk(world, chunk_x, chunk_z);
-    if (!chunk) {
-        return (Block){BLOCK_AIR, 0, 0};
+/**
+ * Unlink chunk from all world systems and free it (CPU + GPU)
+ * Queued work is cancelled first. A chunk a worker still holds is detached
+ * instead: the worker drops it at the next stage boundary (a finished mesh
+ * is discarded on poll) and world_reap_retired frees it afterwards
+ */
+static void world_unload_chunk(World* world, Chunk* chunk) {
+    ChunkState state = chunk_get_state(chunk);
+    if (state == CHUNK_STATE_QUEUED || state == CHUNK_STATE_GENERATING || state == CHUNK_STATE_MESHING) {
+        chunk_worker_cancel(world->worker, chunk);  // Between stages the next one may still be queued
+    }
+    if (world->batcher) {
+        chunk_batcher_unregister_chunk(world->batcher, chunk);
+    }
+    if (world->pool) {
+        chunk_pool_release_chunk(world->pool, chunk);
+    }
+    world_remove_from_dirty_list(world, chunk);
+    world_remove_from_stream_list(world, chunk);
+    world_remove_from_spawn_list(world, chunk);
+    world_remove_from_water_list(world, chunk);
+    chunk_index_remove(world->chunks, chunk->x, chunk->z);
+    if (world->entity_manager && chunk->has_spawned && !world->chunk_request) {
+        despawn_animals_for_chunk(world, chunk->x, chunk->z);  // Its herds come back with it
     }
 
-    return chunk_get_block(chunk, local_x, local_y, local_z);
+    // Workers take no new references: only the main thread submits tasks
+    atomic_store_explicit(&chunk->detached, true, memory_order_relaxed);
+    if (chunk_in_use(chunk)) {
+        chunk->retired_next = world->retired_head;
+        world->retired_head = chunk;
+        world->retired_count++;
+        return;
+    }
+    world_free_chunk(world, chunk);
 }
 
-void world_set_block(World* world, int x, int y, int z, Block block) {
-    int chunk_x, chunk_z;
-    int local_x, local_y, local_z;
-    world_to_local_coords(x, y, z, &chunk_x, &chunk_z, &local_x, &local_y, &local_z);
+int world_evict_chunks(World* world) {
+    if (!world || world->chunks->chunk_count == 0) return 0;
 
-    Chunk* chunk = world_get_or_create_chunk(world, chunk_x, chunk_z);
-    chunk_set_block(chunk, local_x, local_y, local_z, block);
+    int view = world->view_distance;
 
-    // Add chunk to dirty list for remeshing
-    world_add_to_dirty_list(world, chunk);
+    EvictCandidate* candidates = (EvictCandidate*)malloc(
+        world->chunks->chunk_count * sizeof(EvictCandidate));
+    if (!candidates) return 0;
 
-    // Recalculate lighting for this chunk when a block changes
-    light_calculate_chunk(chunk);
+    // Gather chunks outside every generated window, tally resident memory
+    int count = 0;
+    size_t resident = 0;
+    for (int i = 0; i < chunk_index_span(world->chunks); i++) {
+        Chunk* chunk = chunk_index_at(world->chunks, i);
+        if (chunk) {
+            resident += estimate_chunk_bytes(chunk);
 
-    // Notify water system of block change
-    if (world->water_queue) {
-        water_on_block_change(world->water_queue, world, x, y, z);
+            int dist = world_window_excess(world, chunk->x, chunk->z);
+            if (dist > WORLD_BORDER_RING) {
+                candidates[count].chunk = chunk;
+                candidates[count].dist = dist;
+                count++;
+            }
+        }
     }
 
-    // Invalidate batch containing this chunk
-    if (world->batcher) {
-        chunk_batcher_invalidate(world->batcher, chunk_x, chunk_z);
+    qsort(candidates, count, sizeof(EvictCandidate), compare_evict_candidates);
+
+    // Past the hysteresis ring: always unload. Inside it: only while over the
+    // world's budget or the process heap/GPU budget (memory.h)
+    int evicted = 0;
+    for (int i = 0; i < count; i++) {
+        Chunk* chunk = candidates[i].chunk;
+        bool over_budget = resident > world->memory_budget_bytes ||
+                           memory_get_max_pressure() == MEMORY_PRESSURE_OVER;
+        if (candidates[i].dist <= WORLD_UNLOAD_MARGIN && !over_budget) break;
+
+        size_t bytes = estimate_chunk_bytes(chunk);
+        world_unload_chunk(world, chunk);
+        resident = resident > bytes ? resident - bytes : 0;
+        evicted++;
     }
-}
 
-void world_update(World* world, int center_chunk_x, int center_chunk_z) {
-    if (!world) return;
+    free(candidates);
+    world->resident_bytes = resident;
 
-    // Process water flow updates (every 2 frames for performance)
-    world->game_tick++;
-    if (world->water_queue && (world->game_tick % 2 == 0)) {
-        water_process_tick(world->water_queue, world);
+    // View window alone exceeds budget - warn once per change of state
+    static bool warned = false;
+    if (resident > world->memory_budget_bytes) {
+        if (!warned) {
+            printf("[WORLD] Resident chunks (%zu MB) exceed budget (%zu MB) at view distance %d\n",
+                   resident / (1024 * 1024), world->memory_budget_bytes / (1024 * 1024), view);
+            warned = true;
+        }
+    } else {
+        warned = false;
     }
 
-    static bool first_update = true;
-    static int last_center_x = 0;
-    static int last_center_z = 0;
+    return evicted;
+}
 
-    world->center_chunk_x = center_chunk_x;
-    world->center_chunk_z = center_chunk_z;
+void world_set_storage(World* world, RegionStorage* storage) {
+    if (!world) return;
+    world->storage = storage;
+    chunk_worker_set_storage(world->worker, storage);
+}
 
-    if (first_update || last_center_x != center_chunk_x || last_center_z != center_chunk_z) {
-        // Center chunk changed
-        last_center_x = center_chunk_x;
-        last_center_z = center_chunk_z;
-    }
+void world_set_terrain_cache(World* world, TerrainCache* cache) {
+    if (!world) return;
+    world->terrain_cache = cache;
+    chunk_worker_set_terrain_cache(world->worker, cache);
+}
 
-    // Poll for completed chunks from worker threads (configurable via settings)
-    int max_uploads = world->max_uploads_per_frame > 0 ? world->max_uploads_per_frame : MAX_UPLOADS_PER_FRAME;
-    int uploaded = 0;
-    for (int i = 0; i < max_uploads; i++) {
-        CompletedChunk* completed = chunk_worker_poll_completed(world->worker);
-        if (!completed) break;
+void world_set_mesh_cache(World* world, MeshCache* cache) {
+    if (!world) return;
+    world->mesh_cache = cache;
+    chunk_worker_set_mesh_cache(world->worker, cache);
+}
 
-        // Upload mesh to GPU (must be on main thread)
-        chunk_worker_upload_mesh(completed->chunk, &completed->mesh);
+void world_set_chunk_source(World* world, WorldChunkRequestFunc request, void* user) {
+    if (!world) return;
+    world->chunk_request = request;
+    world->chunk_request_user = user;
+}
 
-        // Register chunk with batcher for batched rendering
-        if (world->batcher) {
-            chunk_batcher_register_chunk(world->batcher, completed->chunk);
+void world_request_loaded_chunks(World* world) {
+    if (!world || !world->chunk_request) return;
+
+    int requested = 0;
+    for (int i = 0; i < chunk_index_span(world->chunks); i++) {
+        Chunk* chunk = chunk_index_at(world->chunks, i);
+        if (!chunk) continue;
+        chunk->remote_local = false;
+        chunk->remote_wait = 0;
+        // Empty chunks ask from world_update; the rest are replaced on arrival
+        if (chunk_get_state(chunk) != CHUNK_STATE_EMPTY &&
+            world->chunk_request(world->chunk_request_user, chunk->x, chunk->z)) {
+            requested++;
         }
+    }
+    printf("[WORLD] Requested %d loaded chunks from host\n", requested);
+}
+
+/**
+ * Replace the blocks of a generated chunk with streamed data (main thread)
+ */
+static bool world_replace_chunk(World* world, Chunk* chunk, const uint8_t* data, uint32_t size) {
+    // The water thread must not read blocks while they change
+    if (world->water_queue) water_sync(world->water_queue, world);
 
-        // Spawn animals for newly completed chunks (biome-aware herds)
-        if (world->entity_manager && !completed->chunk->has_spawned) {
-            spawn_animals_for_chunk(world, completed->chunk->x, completed->chunk->z, world->terrain_params);
-            completed->chunk->has_spawned = true;
+    if (!chunk_codec_decode(chunk, data, size)) return false;
+    light_calculate_chunk(chunk);
+    chunk_update_empty_status(chunk);
+    chunk_update_surface(chunk);
+    light_stitch_chunk(world, chunk);
+
+    // Every section changed, and the neighbors' border faces with them
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            Chunk* c = world_get_chunk(world, chunk->x + dx, chunk->z + dz);
+            if (!c || !CHUNK_STATE_HAS_BLOCKS(chunk_get_state(c))) continue;
+            chunk_mark_sections_dirty(c, CHUNK_SECTIONS_ALL);
+            if (chunk_get_state(c) == CHUNK_STATE_COMPLETE) world_add_to_dirty_list(world, c);
         }
+    }
+    return true;
+}
 
-        free(completed);
-        uploaded++;
+bool world_receive_chunk(World* world, int chunk_x, int chunk_z, const uint8_t* data, uint32_t size) {
+    if (!world) return false;
+
+    Chunk* chunk = world_get_chunk(world, chunk_x, chunk_z);
+    if (!chunk) return false;  // Left the view meanwhile
+
+    if (!data || size == 0) {
+        chunk->remote_local = true;  // Host has nothing: generate it
+        return true;
     }
 
+    // Generation that started before the data arrived is dropped if still queued
+    if (chunk_get_state(chunk) == CHUNK_STATE_QUEUED) chunk_worker_cancel(world->worker, chunk);
+
+    if (chunk_get_state(chunk) == CHUNK_STATE_EMPTY) {
+        uint8_t* copy = (uint8_t*)malloc(size);
+        if (!copy) return false;
+        memcpy(copy, data, size);
+        free(chunk->remote_data);
+        chunk->remote_data = copy;
+        chunk->remote_size = size;
+        return true;  // Decoded and lit by the terrain stage
+    }
 
-    // Load chunks in view distance if not already loaded
-    for (int x = -world->view_distance; x <= world->view_distance; x++) {
-        for (int z = -world->view_distance; z <= world->view_distance; z++) {
-            int cx = center_chunk_x + x;
-            int cz = center_chunk_z + z;
+    if (world_chunk_in_worker(chunk) || chunk_get_state(chunk) == CHUNK_STATE_MESHING) return false;
+    return world_replace_chunk(world, chunk, data, size);
+}
 
-            Chunk* chunk = world_get_chunk(world, cx, cz);
-            if (!chunk) {
-                // Chunk not loaded, create it
-                chunk = world_get_or_create_chunk(world, cx, cz);
-            }
+uint8_t* world_encode_chunk(World* world, int chunk_x, int chunk_z, uint32_t* out_size, bool* pending) {
+    *pending = false;
+    if (!world) return NULL;
 
-            // Enqueue for async generation if still empty (handles queue-full retry)
-            // Priority is based on distance from center_chunk position
-            if (chunk->state == CHUNK_STATE_EMPTY) {
-                chunk_worker_enqueue(world->worker, chunk, world->terrain_params,
-                                     center_chunk_x, center_chunk_z);
-            }
+    Chunk* chunk = world_get_chunk(world, chunk_x, chunk_z);
+    if (chunk) {
+        // Workers only read blocks while meshing, so those can be encoded too
+        if (!CHUNK_STATE_HAS_BLOCKS(chunk_get_state(chunk))) {
+            *pending = true;
+            return NULL;
         }
+        return chunk_codec_encode(chunk, out_size);
     }
 
-    if (first_update) {
-        first_update = false;
+    // Inside a load window it is created by the next update
+    if (world_window_excess(world, chunk_x, chunk_z) <= WORLD_BORDER_RING) {
+        *pending = true;
+        return NULL;
     }
 
-    // Process pending mesh regenerations using dirty list (O(dirty) instead of O(all_chunks))
-    // This eliminates the lag spike when placing/breaking blocks
-    Chunk* chunk = world->dirty_head;
-    while (chunk) {
-        Chunk* next = (Chunk*)chunk->dirty_next;  // Save next before removing from list
-        // Only remesh if chunk is complete and needs it
-        if (chunk->state == CHUNK_STATE_COMPLETE && chunk->needs_remesh) {
-            chunk_generate_mesh(chunk);
-            // Invalidate batch when chunk mesh changes
-            if (world->batcher) {
-                chunk_batcher_invalidate(world->batcher, chunk->x, chunk->z);
+    // Not loaded: saved chunks carry every edit made to them
+    if (!world->storage) return NULL;
+    Chunk* saved = chunk_create(chunk_x, chunk_z);
+    if (!saved) return NULL;
+    uint8_t* data = NULL;
+    if (region_storage_load_chunk(world->storage, saved)) {
+        data = chunk_codec_encode(saved, out_size);
+    }
+    chunk_destroy(saved);
+    return data;
+}
+
+int world_save_all(World* world) {
+    if (!world || !world->storage) return 0;
+
+    int saved = 0;
+    for (int i = 0; i < chunk_index_span(world->chunks); i++) {
+        Chunk* chunk = chunk_index_at(world->chunks, i);
+        if (chunk) {
+            ChunkState state = chunk_get_state(chunk);
+            bool generated = state == CHUNK_STATE_GENERATED || state == CHUNK_STATE_COMPLETE;
+            if (chunk->needs_save && generated && region_storage_save_chunk(world->storage, chunk)) {
+                saved++;
             }
-            // Remove from dirty list after successful remesh
-            world_remove_from_dirty_list(world, chunk);
         }
-        chunk = next;
     }
 
-    // Update batched meshes (rebuild dirty batches)
-    if (world->batcher) {
-        chunk_batcher_update(world->batcher, world->batch_rebuilds_per_frame);
+    if (saved > 0) {
+        printf("[WORLD] Queued %d chunks for saving\n", saved);
     }
+    return saved;
+}
+
+void world_set_cold_distance(World* world, int distance) {
+    if (!world) return;
+    world->cold_distance = distance > 0 ? distance : 0;
+}
+
+void world_set_memory_budget(World* world, int budget_mb) {
+    if (!world) return;
+    // Clamp to reasonable range (64-8192 MB)
+    if (budget_mb < 64) budget_mb = 64;
+    if (budget_mb > 8192) budget_mb = 8192;
+    world->memory_budget_bytes = (size_t)budget_mb * 1024 * 1024;
 }
 
 // ============================================================================
@@ -492,6 +1925,26 @@ void world_set_view_distance(World* world, int distance) {
     }
 }
 
+void world_set_velocity(World* world, float velocity_x, float velocity_z) {
+    if (!world) return;
+    world->velocity_x = velocity_x;
+    world->velocity_z = velocity_z;
+}
+
+void world_set_lod_distance(World* world, int distance) {
+    if (!world || !world->lod) return;
+
+    if (distance != world->lod->distance) {
+        chunk_lod_set_distance(world->lod, distance);
+        printf("[WORLD] LOD distance set to %d chunks\n", world->lod->distance);
+    }
+}
+
+int world_get_lod_distance(World* world) {
+    if (!world || !world->lod) return LOD_DISTANCE_THRESHOLD;
+    return world->lod->distance;
+}
+
 void world_set_batch_rebuilds(World* world, int max_rebuilds) {
     if (!world) return;
     // Clamp to reasonable range (4-64)
@@ -543,34 +1996,32 @@ static Vector3 get_fog_color(float time_of_day) {
     };
 }
 
-/**
- * Apply common shader uniforms for world rendering
- * Used by both opaque and transparent passes
- */
-static void apply_world_shader_uniforms(Material material, World* world,
-                                         float time_of_day, Vector3 camera_pos, bool underwater) {
+void world_update_frame_uniforms(World* world, Camera3D camera, float time_of_day, bool underwater) {
+    if (!world) return;
+
+    FrameUniformData data = {0};
+    frame_uniforms_set_camera(&data, camera);
+
     // Ambient light based on time of day
     Vector3 ambient_light = get_ambient_color(time_of_day);
-    SetShaderValue(material.shader, g_shader_locs.ambient, &ambient_light, SHADER_UNIFORM_VEC3);
+    data.ambient_light[0] = ambient_light.x;
+    data.ambient_light[1] = ambient_light.y;
+    data.ambient_light[2] = ambient_light.z;
 
     // Fog settings - start further out for better visibility
-    float fog_start = world->view_distance * CHUNK_SIZE * 0.8f;
-    float fog_end = world->view_distance * CHUNK_SIZE * 1.2f;
     Vector3 fog_color = get_fog_color(time_of_day);
-    int underwater_flag = underwater ? 1 : 0;
-
-    // Water animation time
-    float shader_time = (float)GetTime();
-    SetShaderValue(material.shader, g_shader_locs.time, &shader_time, SHADER_UNIFORM_FLOAT);
-
-    SetShaderValue(material.shader, g_shader_locs.camera_pos, &camera_pos, SHADER_UNIFORM_VEC3);
-    SetShaderValue(material.shader, g_shader_locs.fog_start, &fog_start, SHADER_UNIFORM_FLOAT);
-    SetShaderValue(material.shader, g_shader_locs.fog_end, &fog_end, SHADER_UNIFORM_FLOAT);
-    SetShaderValue(material.shader, g_shader_locs.fog_color, &fog_color, SHADER_UNIFORM_VEC3);
-    SetShaderValue(material.shader, g_shader_locs.underwater, &underwater_flag, SHADER_UNIFORM_INT);
+    data.fog_color[0] = fog_color.x;
+    data.fog_color[1] = fog_color.y;
+    data.fog_color[2] = fog_color.z;
+    data.fog[0] = world->view_distance * CHUNK_SIZE * 0.8f;
+    data.fog[1] = world->view_distance * CHUNK_SIZE * 1.2f;
+    data.fog[2] = underwater ? 1.0f : 0.0f;
+    data.fog[3] = (float)GetTime();  // Water animation time
+
+    frame_uniforms_upload(&data);
 }
 
-void world_render_with_time(World* world, float time_of_day, Vector3 camera_pos, bool underwater) {
+void world_render_opaque(World* world, Vector3 camera_pos) {
     if (!world) return;
 
     // Enable alpha blending for transparent blocks (leaves, water, etc.)
@@ -578,37 +2029,51 @@ void world_render_with_time(World* world, float time_of_day, Vector3 camera_pos,
 
     Material material = texture_atlas_get_material();
 
-    // Initialize shader location cache on first call
-    init_shader_loc_cache(material.shader);
-
-    // Apply common shader uniforms
-    apply_world_shader_uniforms(material, world, time_of_day, camera_pos, underwater);
+    // Frustum and cave culling shared by the opaque and transparent passes
+    chunk_culler_update(world->culler, world, camera_pos);
+    chunk_lod_hide_covered(world->lod, world->culler);  // Full meshes kept in the demote margin
 
     // Use batched rendering for reduced draw calls
-    if (world->batcher) {
+    if (world->pool) {
+        chunk_pool_render_opaque(world->pool, world, material, camera_pos);
+    } else if (world->batcher) {
         chunk_batcher_render_opaque(world->batcher, world, material, camera_pos);
     }
+    chunk_lod_render_opaque(world->lod, world, material);
 }
 
 void world_render(World* world) {
-    // Fallback to noon lighting if time not specified
-    Vector3 default_camera = {0, 64, 0};
-    world_render_with_time(world, 12.0f, default_camera, false);
+    // Fallback to noon lighting from a default camera
+    Camera3D camera = {
+        .position = {0, 64, 0},
+        .target = {0, 64, 1},
+        .up = {0, 1, 0},
+        .fovy = 70.0f,
+        .projection = CAMERA_PERSPECTIVE
+    };
+    world_update_frame_uniforms(world, camera, 12.0f, false);
+    world_render_opaque(world, camera.position);
 }
 
-void world_render_transparent_with_time(World* world, float time_of_day, Vector3 camera_pos, bool underwater) {
+void world_render_transparent(World* world, Vector3 camera_pos) {
     if (!world) return;
 
     Material material = texture_atlas_get_material();
 
-    // Initialize shader location cache on first call (may already be initialized by opaque pass)
-    init_shader_loc_cache(material.shader);
+    world->camera_block[0] = (int)floorf(camera_pos.x);
+    world->camera_block[1] = (int)floorf(camera_pos.y);
+    world->camera_block[2] = (int)floorf(camera_pos.z);
 
-    // Apply common shader uniforms
-    apply_world_shader_uniforms(material, world, time_of_day, camera_pos, underwater);
+    // LOD regions are all farther than the full-detail chunks: draw them first
+    chunk_lod_render_transparent(world->lod, world, material, camera_pos);
 
     // Use batched rendering for reduced draw calls (handles back-to-front sorting internally)
-    if (world->batcher) {
+    if (world->pool) {
+        chunk_pool_render_transparent(world->pool, world, material, camera_pos);
+    } else if (world->batcher) {
         chunk_batcher_render_transparent(world->batcher, world, material, camera_pos);
     }
+
+    // Water surfaces last: they are drawn over the glass and leaves behind them
+    chunk_water_render(world, texture_atlas_get_water_material(), camera_pos);
 }